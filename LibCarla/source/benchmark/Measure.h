@@ -0,0 +1,33 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/// Run @a func repeatedly until it accumulates enough wall time for a stable
+/// measurement and return the average nanoseconds per call.
+template <typename FuncT>
+static double MeasureNsPerOp(FuncT &&func) {
+  using clock = std::chrono::steady_clock;
+  constexpr int64_t min_measure_time = 100000000; // 0.1s.
+  constexpr size_t max_iterations = 1u << 18;
+  func(); // warm-up.
+  size_t iterations = 1u;
+  for (;;) {
+    const auto start = clock::now();
+    for (size_t i = 0u; i < iterations; ++i) {
+      func();
+    }
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    if ((elapsed >= min_measure_time) || (iterations >= max_iterations)) {
+      return static_cast<double>(elapsed) / static_cast<double>(iterations);
+    }
+    iterations *= 4u;
+  }
+}
@@ -0,0 +1,244 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+/// Measures road::Map construction and query performance plus the geom::Math
+/// distance kernels they sit on. Pass the OpenDRIVE files of the shipped
+/// towns on the command line:
+///
+///    benchmark_road_map Town01.xodr Town02.xodr ...
+///
+/// The output is one CSV row per case with a stable set of columns
+///
+///    benchmark,map,ns_per_op
+///
+/// so that runs from different commits can be diffed or tracked by the
+/// continuous integration scripts. Query benchmarks use locations jittered
+/// around the lane centers, which is where the vehicles that issue these
+/// queries actually are.
+
+#include "Measure.h"
+
+#include "carla/geom/Location.h"
+#include "carla/geom/Math.h"
+#include "carla/opendrive/OpenDriveParser.h"
+#include "carla/road/Map.h"
+#include "carla/road/RoutePlanner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace carla;
+
+static void Report(const char *benchmark, const std::string &map, double ns_per_op) {
+  std::printf("%s,%s,%.1f\n", benchmark, map.c_str(), ns_per_op);
+}
+
+static std::string ReadFile(const std::string &path) {
+  std::ifstream file(path);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// "path/to/Town01.xodr" -> "Town01".
+static std::string BaseName(const std::string &path) {
+  const auto slash = path.find_last_of("/\\");
+  const auto begin = (slash == std::string::npos) ? 0u : slash + 1u;
+  const auto dot = path.find_last_of('.');
+  const auto end = ((dot == std::string::npos) || (dot < begin)) ? path.size() : dot;
+  return path.substr(begin, end - begin);
+}
+
+// Keeps the optimizer from deleting the measured kernels.
+static volatile float benchmark_sink = 0.0f;
+
+// =============================================================================
+// -- Geometry kernels ---------------------------------------------------------
+// =============================================================================
+
+static void BenchmarkGeomMath() {
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+  std::vector<geom::Vector3D> points(1024u);
+  for (auto &point : points) {
+    point = {coord(rng), coord(rng), coord(rng)};
+  }
+
+  size_t i = 0u;
+  float acc = 0.0f;
+  Report("math_distance", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::Distance(points[i % points.size()], points[(i + 7u) % points.size()]);
+    ++i;
+  }));
+  Report("math_distance_2d", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::Distance2D(points[i % points.size()], points[(i + 7u) % points.size()]);
+    ++i;
+  }));
+  Report("math_distance_segment", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::DistanceSegmentToPoint(
+        points[i % points.size()],
+        points[(i + 7u) % points.size()],
+        points[(i + 13u) % points.size()]).second;
+    ++i;
+  }));
+  Report("math_distance_arc", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::DistanceArcToPoint(
+        points[i % points.size()],
+        points[(i + 7u) % points.size()],
+        50.0f,
+        0.5f,
+        0.01f).second;
+    ++i;
+  }));
+
+  // Point against a batch of segments, the shape of the road::Map and
+  // traffic manager localization loops; the batch kernel is the fused,
+  // square-root-free form of the naive loop above it.
+  std::vector<std::pair<geom::Vector3D, geom::Vector3D>> segments(64u);
+  for (auto &segment : segments) {
+    segment = {{coord(rng), coord(rng), 0.0f}, {coord(rng), coord(rng), 0.0f}};
+  }
+  Report("math_nearest_segment_naive_64", "-", MeasureNsPerOp([&]() {
+    float best = std::numeric_limits<float>::max();
+    for (const auto &segment : segments) {
+      best = std::min(best, geom::Math::DistanceSegmentToPoint(
+          points[i % points.size()], segment.first, segment.second).second);
+    }
+    acc += best;
+    ++i;
+  }));
+  Report("math_nearest_segment_batch_64", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::NearestSegmentToPoint2D(
+        points[i % points.size()], segments.data(), segments.size()).second;
+    ++i;
+  }));
+  Report("math_distance_along_segment", "-", MeasureNsPerOp([&]() {
+    acc += geom::Math::DistanceAlongSegment2D(
+        points[i % points.size()],
+        points[(i + 7u) % points.size()],
+        points[(i + 13u) % points.size()]);
+    ++i;
+  }));
+  benchmark_sink = acc;
+}
+
+// =============================================================================
+// -- Per-map benchmarks -------------------------------------------------------
+// =============================================================================
+
+static void BenchmarkMap(const std::string &path) {
+  const auto name = BaseName(path);
+  const auto opendrive = ReadFile(path);
+  if (opendrive.empty()) {
+    std::fprintf(stderr, "cannot read %s, skipped\n", path.c_str());
+    return;
+  }
+  auto map = opendrive::OpenDriveParser::Load(opendrive);
+  if (!map) {
+    std::fprintf(stderr, "cannot parse %s, skipped\n", path.c_str());
+    return;
+  }
+
+  Report("parse", name, MeasureNsPerOp([&]() {
+    auto parsed = opendrive::OpenDriveParser::Load(opendrive);
+    (void) parsed;
+  }));
+
+  Report("generate_waypoints_2m", name, MeasureNsPerOp([&]() {
+    auto waypoints = map->GenerateWaypoints(2.0);
+    (void) waypoints;
+  }));
+
+  const auto waypoints = map->GenerateWaypoints(2.0);
+  if (waypoints.empty()) {
+    std::fprintf(stderr, "%s has no driving lanes, queries skipped\n", name.c_str());
+    return;
+  }
+
+  {
+    size_t i = 0u;
+    Report("compute_transform", name, MeasureNsPerOp([&]() {
+      const auto transform = map->ComputeTransform(waypoints[i % waypoints.size()]);
+      benchmark_sink = transform.location.x;
+      ++i;
+    }));
+  }
+
+  // Queries come from vehicles, i.e. from locations on or close to a lane.
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+  std::vector<geom::Location> locations;
+  locations.reserve(waypoints.size());
+  for (const auto &waypoint : waypoints) {
+    auto location = map->ComputeTransform(waypoint).location;
+    location.x += jitter(rng);
+    location.y += jitter(rng);
+    locations.push_back(location);
+  }
+
+  {
+    size_t i = 0u;
+    Report("closest_waypoint", name, MeasureNsPerOp([&]() {
+      const auto waypoint = map->GetClosestWaypointOnRoad(locations[i % locations.size()]);
+      benchmark_sink = static_cast<float>(waypoint.has_value());
+      ++i;
+    }));
+  }
+
+  {
+    // The hinted batch is how the traffic manager localizes its vehicles
+    // every tick: same locations, hints from the previous tick.
+    const size_t batch_size = std::min<size_t>(256u, locations.size());
+    const std::vector<geom::Location> batch(locations.begin(), locations.begin() + static_cast<long>(batch_size));
+    auto hints = map->GetClosestWaypointsOnRoad(batch);
+    const auto ns = MeasureNsPerOp([&]() {
+      hints = map->GetClosestWaypointsOnRoad(batch, hints);
+    });
+    Report("closest_waypoints_hinted", name, ns / static_cast<double>(batch_size));
+  }
+
+  Report("route_planner_build", name, MeasureNsPerOp([&]() {
+    const road::RoutePlanner planner(*map);
+    benchmark_sink = static_cast<float>(planner.GetNodeCount());
+  }));
+
+  {
+    // Route endpoints come from spawn-like locations all over the map, the
+    // same queries a scenario issues when routing its background traffic.
+    const road::RoutePlanner planner(*map);
+    size_t i = 0u;
+    Report("trace_route_2m", name, MeasureNsPerOp([&]() {
+      const auto route = planner.TraceRoute(
+          locations[i % locations.size()],
+          locations[(i + locations.size() / 2u) % locations.size()]);
+      benchmark_sink = static_cast<float>(route.size());
+      ++i;
+    }));
+  }
+}
+
+// =============================================================================
+// -- Entry point --------------------------------------------------------------
+// =============================================================================
+
+int main(int argc, const char *argv[]) {
+  std::printf("benchmark,map,ns_per_op\n");
+  BenchmarkGeomMath();
+  if (argc < 2) {
+    std::fprintf(stderr, "no .xodr files given, map benchmarks skipped\n");
+    std::fprintf(stderr, "usage: %s <town.xodr> [<town.xodr> ...]\n", argv[0]);
+  }
+  for (int i = 1; i < argc; ++i) {
+    BenchmarkMap(argv[i]);
+  }
+  return 0;
+}
@@ -0,0 +1,309 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+/// Measures Serialize/Deserialize throughput for every serializer registered
+/// in the SensorRegistry across several payload sizes.
+///
+/// The output is one CSV row per case with a stable set of columns
+///
+///    serializer,direction,payload_bytes,ns_per_op,mb_per_s
+///
+/// so that runs from different commits can be diffed or tracked by the
+/// continuous integration scripts. Deserialize rows exclude the cost of
+/// rebuilding the input message, which is measured separately and
+/// subtracted.
+
+#include "Measure.h"
+
+#include "carla/Buffer.h"
+#include "carla/geom/GeoLocation.h"
+#include "carla/rpc/Actor.h"
+#include "carla/rpc/Transform.h"
+#include "carla/sensor/SensorRegistry.h"
+#include "carla/sensor/data/ActorDynamicState.h"
+#include "carla/sensor/data/LidarData.h"
+#include "carla/sensor/data/RadarData.h"
+#include "carla/sensor/data/SemanticLidarData.h"
+#include "carla/sensor/s11n/EpisodeStateSerializer.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace carla;
+using namespace carla::sensor;
+
+// =============================================================================
+// -- Timing harness -----------------------------------------------------------
+// =============================================================================
+
+static void Report(
+    const std::string &serializer,
+    const char *direction,
+    size_t payload_bytes,
+    double ns_per_op) {
+  const double mb_per_s = (ns_per_op > 0.0)
+      ? (static_cast<double>(payload_bytes) * 1e9) / (ns_per_op * 1024.0 * 1024.0)
+      : 0.0;
+  std::printf(
+      "%s,%s,%zu,%.1f,%.2f\n",
+      serializer.c_str(),
+      direction,
+      payload_bytes,
+      ns_per_op,
+      mb_per_s);
+}
+
+// =============================================================================
+// -- Message composition ------------------------------------------------------
+// =============================================================================
+
+/// Compose a full sensor message (header plus payload) the way the server
+/// does before sending it down a stream.
+static std::vector<unsigned char> MakeMessage(size_t index, const Buffer &payload) {
+  const auto header =
+      s11n::SensorHeaderSerializer::Serialize(index, 0u, 0.0, rpc::Transform{});
+  std::vector<unsigned char> message(header.size() + payload.size());
+  std::memcpy(message.data(), header.data(), header.size());
+  std::memcpy(message.data() + header.size(), payload.data(), payload.size());
+  return message;
+}
+
+/// Measure SensorRegistry::Deserialize on @a payload tagged with the
+/// registry @a index, net of the cost of rebuilding the input buffer.
+static void BenchmarkDeserialize(
+    const std::string &serializer,
+    size_t index,
+    const Buffer &payload) {
+  const auto message = MakeMessage(index, payload);
+  const auto copy_ns = MeasureNsPerOp([&message]() {
+    Buffer data{message.data(), static_cast<Buffer::size_type>(message.size())};
+    (void) data;
+  });
+  const auto total_ns = MeasureNsPerOp([&message]() {
+    Buffer data{message.data(), static_cast<Buffer::size_type>(message.size())};
+    auto result = SensorRegistry::Deserialize(std::move(data));
+    (void) result;
+  });
+  Report(serializer, "deserialize", payload.size(),
+      std::max(total_ns - copy_ns, 0.0));
+}
+
+// =============================================================================
+// -- Mock sensors -------------------------------------------------------------
+// =============================================================================
+
+struct MockSensor {};
+
+struct MockCamera {
+  uint32_t width;
+  uint32_t height;
+  uint32_t GetImageWidth() const { return width; }
+  uint32_t GetImageHeight() const { return height; }
+  float GetFOVAngle() const { return 90.0f; }
+};
+
+// =============================================================================
+// -- Per-serializer benchmarks ------------------------------------------------
+// =============================================================================
+
+static void BenchmarkImage(uint32_t width, uint32_t height) {
+  const MockCamera camera{width, height};
+  Buffer bitmap(sizeof(s11n::ImageSerializer::ImageHeader) + width * height * 4u);
+  const auto ns = MeasureNsPerOp([&]() {
+    bitmap = s11n::ImageSerializer::Serialize(camera, std::move(bitmap));
+  });
+  Report("image", "serialize", bitmap.size(), ns);
+  BenchmarkDeserialize("image", SensorRegistry::get<ASceneCaptureCamera *>::index, bitmap);
+}
+
+static void BenchmarkLidar(uint32_t num_points, bool quantized) {
+  constexpr uint32_t channels = 32u;
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> coord(-10000.0f, 10000.0f);
+  std::uniform_real_distribution<float> intensity(0.0f, 1.0f);
+  std::vector<data::LidarDetection> detections;
+  detections.reserve(num_points);
+  for (auto i = 0u; i < num_points; ++i) {
+    detections.emplace_back(coord(rng), coord(rng), coord(rng), intensity(rng));
+  }
+  const std::string name = quantized ? "lidar_quantized" : "lidar";
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    auto writer = s11n::LidarSerializer::MakeWriter(std::move(output), channels, quantized);
+    writer.Reserve(num_points);
+    for (auto i = 0u; i < num_points; ++i) {
+      writer.WritePoint(i % channels, detections[i]);
+    }
+    output = writer.Finish();
+  });
+  Report(name, "serialize", output.size(), ns);
+  BenchmarkDeserialize(name, SensorRegistry::get<ARayCastLidar *>::index, output);
+}
+
+static void BenchmarkSemanticLidar(uint32_t num_points) {
+  constexpr uint32_t channels = 32u;
+  data::SemanticLidarData measurement(channels);
+  measurement.ResetSerPoints(std::vector<uint32_t>(channels, num_points / channels));
+  for (auto i = 0u; i < num_points; ++i) {
+    data::SemanticLidarDetection detection(1.0f, 2.0f, 3.0f, 0.5f, i, i % 23u);
+    measurement.WritePointSync(detection);
+  }
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::SemanticLidarSerializer::Serialize(MockSensor{}, measurement, std::move(output));
+  });
+  Report("semantic_lidar", "serialize", output.size(), ns);
+  BenchmarkDeserialize("semantic_lidar", SensorRegistry::get<ARayCastSemanticLidar *>::index, output);
+}
+
+static void BenchmarkRadar(uint32_t num_detections) {
+  data::RadarData measurement;
+  measurement.SetResolution(num_detections);
+  for (auto i = 0u; i < num_detections; ++i) {
+    measurement.WriteDetection({1.0f, 2.0f, 3.0f, 4.0f});
+  }
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::RadarSerializer::Serialize(MockSensor{}, measurement, std::move(output));
+  });
+  Report("radar", "serialize", output.size(), ns);
+  BenchmarkDeserialize("radar", SensorRegistry::get<ARadar *>::index, output);
+}
+
+static void BenchmarkDVS(uint32_t num_events) {
+  std::mt19937 rng(7u);
+  std::vector<data::DVSEvent> events;
+  events.reserve(num_events);
+  int64_t t = 0;
+  for (auto i = 0u; i < num_events; ++i) {
+    t += rng() % 20000u;
+    events.emplace_back(
+        static_cast<uint16_t>(rng() % 1280u),
+        static_cast<uint16_t>(rng() % 720u),
+        t,
+        (rng() & 1u) != 0u);
+  }
+  const MockCamera camera{1280u, 720u};
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::DVSEventArraySerializer::Serialize(camera, std::move(events), std::move(output));
+  });
+  Report("dvs", "serialize", output.size(), ns);
+  BenchmarkDeserialize("dvs", SensorRegistry::get<ADVSCamera *>::index, output);
+}
+
+static void BenchmarkGnss() {
+  const geom::GeoLocation location{1.0, 2.0, 3.0};
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::GnssSerializer::Serialize(MockSensor{}, location);
+  });
+  Report("gnss", "serialize", output.size(), ns);
+  BenchmarkDeserialize("gnss", SensorRegistry::get<AGnssSensor *>::index, output);
+}
+
+static void BenchmarkIMU() {
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::IMUSerializer::Serialize(
+        MockSensor{}, geom::Vector3D{1.0f, 2.0f, 3.0f}, geom::Vector3D{4.0f, 5.0f, 6.0f}, 7.0f);
+  });
+  Report("imu", "serialize", output.size(), ns);
+  BenchmarkDeserialize("imu", SensorRegistry::get<AInertialMeasurementUnit *>::index, output);
+}
+
+static rpc::Actor MakeMockActor(rpc::ActorId id) {
+  rpc::Actor actor;
+  actor.id = id;
+  actor.description.uid = id;
+  actor.description.id = "vehicle.mock.mock";
+  return actor;
+}
+
+static void BenchmarkCollision() {
+  const auto self_actor = MakeMockActor(1u);
+  const auto other_actor = MakeMockActor(2u);
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::CollisionEventSerializer::Serialize(
+        MockSensor{}, self_actor, other_actor, geom::Vector3D{1.0f, 2.0f, 3.0f});
+  });
+  Report("collision", "serialize", output.size(), ns);
+  BenchmarkDeserialize("collision", SensorRegistry::get<ACollisionSensor *>::index, output);
+}
+
+static void BenchmarkObstacleDetection() {
+  const auto self_actor = MakeMockActor(1u);
+  const auto other_actor = MakeMockActor(2u);
+  Buffer output;
+  const auto ns = MeasureNsPerOp([&]() {
+    output = s11n::ObstacleDetectionEventSerializer::Serialize(
+        MockSensor{}, self_actor, other_actor, 10.0f);
+  });
+  Report("obstacle_detection", "serialize", output.size(), ns);
+  BenchmarkDeserialize("obstacle_detection", SensorRegistry::get<AObstacleDetectionSensor *>::index, output);
+}
+
+static void BenchmarkEpisodeState(uint32_t num_actors) {
+  // The world observer packs the payload itself, the serializer is a
+  // pass-through; the interesting figure here is the deserialization.
+  s11n::EpisodeStateSerializer::Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.episode_id = 42u;
+  Buffer payload(static_cast<Buffer::size_type>(
+      sizeof(header) + num_actors * sizeof(data::ActorDynamicState)));
+  std::memcpy(payload.data(), &header, sizeof(header));
+  auto *records = payload.data() + sizeof(header);
+  for (auto i = 0u; i < num_actors; ++i) {
+    data::ActorDynamicState state;
+    std::memset(&state, 0, sizeof(state));
+    state.id = i;
+    std::memcpy(records + i * sizeof(state), &state, sizeof(state));
+  }
+  BenchmarkDeserialize("episode_state", SensorRegistry::get<FWorldObserver *>::index, payload);
+}
+
+// =============================================================================
+// -- Entry point --------------------------------------------------------------
+// =============================================================================
+
+int main() {
+  std::printf("serializer,direction,payload_bytes,ns_per_op,mb_per_s\n");
+
+  BenchmarkImage(800u, 600u);
+  BenchmarkImage(1920u, 1080u);
+
+  BenchmarkLidar(10000u, false);
+  BenchmarkLidar(100000u, false);
+  BenchmarkLidar(10000u, true);
+  BenchmarkLidar(100000u, true);
+
+  BenchmarkSemanticLidar(10000u);
+  BenchmarkSemanticLidar(100000u);
+
+  BenchmarkRadar(64u);
+  BenchmarkRadar(4096u);
+
+  BenchmarkDVS(10000u);
+  BenchmarkDVS(1000000u);
+
+  BenchmarkGnss();
+  BenchmarkIMU();
+  BenchmarkCollision();
+  BenchmarkObstacleDetection();
+
+  BenchmarkEpisodeState(10u);
+  BenchmarkEpisodeState(100u);
+  BenchmarkEpisodeState(1000u);
+
+  return 0;
+}
@@ -0,0 +1,405 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+/// Synthetic load generator for the streaming stack, for qualifying network
+/// hardware and kernel settings without booting the simulator.
+///
+/// By default it runs server and clients in-process over loopback:
+///
+///    benchmark_streaming --streams 8 --subscribers 2 --size 2457600 \
+///        --rate 30 --messages 300
+///
+/// For a two-machine run, start the publisher side with --serve (it prints
+/// one hex token per stream) and feed those tokens to --subscribe on the
+/// other end:
+///
+///    benchmark_streaming --serve --address 10.0.0.1 --port 8090 > tokens
+///    benchmark_streaming --subscribe tokens --duration 30
+///
+/// Transport options mirror the server knobs: --compression and --shm.
+/// Messages carry their send time in the first eight bytes; the subscriber
+/// side reports latency percentiles from them, which across machines include
+/// whatever clock skew exists between the two.
+///
+/// The summary is one CSV row
+///
+///    streams,subscribers,message_bytes,sent,received,mb_per_s,p50_us,p90_us,p99_us,max_us
+///
+/// so that runs can be diffed or tracked by the continuous integration
+/// scripts.
+
+#include "carla/Buffer.h"
+#include "carla/streaming/Client.h"
+#include "carla/streaming/Server.h"
+#include "carla/streaming/Stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace carla;
+using namespace std::chrono_literals;
+
+// =============================================================================
+// -- Options ------------------------------------------------------------------
+// =============================================================================
+
+struct Options {
+  size_t streams = 1u;
+  size_t subscribers = 1u;
+  size_t message_size = 4u * 800u * 600u;
+  size_t messages = 300u;
+  double rate_hz = 30.0;
+  double duration_s = 10.0;
+  uint16_t port = 8090u;
+  std::string address = "127.0.0.1";
+  bool serve = false;
+  bool compression = false;
+  bool shared_memory = false;
+  std::string subscribe_path;
+};
+
+static void PrintUsageAndExit(const char *name) {
+  std::fprintf(stderr,
+      "usage: %s [options]\n"
+      "  --streams N      number of streams (default 1)\n"
+      "  --subscribers N  clients subscribed to each stream (default 1)\n"
+      "  --size BYTES     message payload size (default 1920000)\n"
+      "  --messages N     messages per stream (default 300)\n"
+      "  --rate HZ        publish rate per stream (default 30)\n"
+      "  --port PORT      server port (default 8090)\n"
+      "  --address ADDR   server bind/advertise address (default 127.0.0.1)\n"
+      "  --compression    deflate frames before the wire\n"
+      "  --shm            also export streams through shared memory\n"
+      "  --serve          publisher only; print one hex token per stream\n"
+      "  --subscribe F    subscriber only; read hex tokens from file F\n"
+      "  --duration S     subscriber-only run time in seconds (default 10)\n",
+      name);
+  std::exit(1);
+}
+
+static Options ParseOptions(int argc, const char *argv[]) {
+  Options options;
+  auto next_value = [&](int &i) -> std::string {
+    if (i + 1 >= argc) {
+      PrintUsageAndExit(argv[0]);
+    }
+    return argv[++i];
+  };
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--streams") {
+      options.streams = std::stoul(next_value(i));
+    } else if (arg == "--subscribers") {
+      options.subscribers = std::stoul(next_value(i));
+    } else if (arg == "--size") {
+      options.message_size = std::stoul(next_value(i));
+    } else if (arg == "--messages") {
+      options.messages = std::stoul(next_value(i));
+    } else if (arg == "--rate") {
+      options.rate_hz = std::stod(next_value(i));
+    } else if (arg == "--duration") {
+      options.duration_s = std::stod(next_value(i));
+    } else if (arg == "--port") {
+      options.port = static_cast<uint16_t>(std::stoul(next_value(i)));
+    } else if (arg == "--address") {
+      options.address = next_value(i);
+    } else if (arg == "--compression") {
+      options.compression = true;
+    } else if (arg == "--shm") {
+      options.shared_memory = true;
+    } else if (arg == "--serve") {
+      options.serve = true;
+    } else if (arg == "--subscribe") {
+      options.subscribe_path = next_value(i);
+    } else {
+      PrintUsageAndExit(argv[0]);
+    }
+  }
+  return options;
+}
+
+// =============================================================================
+// -- Helpers ------------------------------------------------------------------
+// =============================================================================
+
+static uint64_t NowEpochUs() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+static std::string TokenToHex(const streaming::Token &token) {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2u * token.data.size());
+  for (const auto byte : token.data) {
+    hex.push_back(digits[byte >> 4u]);
+    hex.push_back(digits[byte & 0x0fu]);
+  }
+  return hex;
+}
+
+static bool TokenFromHex(const std::string &hex, streaming::Token &token) {
+  if (hex.size() != 2u * token.data.size()) {
+    return false;
+  }
+  auto nibble = [](char c) -> int {
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return 10 + c - 'a';
+    if ((c >= 'A') && (c <= 'F')) return 10 + c - 'A';
+    return -1;
+  };
+  for (auto i = 0u; i < token.data.size(); ++i) {
+    const int hi = nibble(hex[2u * i]);
+    const int lo = nibble(hex[2u * i + 1u]);
+    if ((hi < 0) || (lo < 0)) {
+      return false;
+    }
+    token.data[i] = static_cast<unsigned char>((hi << 4) | lo);
+  }
+  return true;
+}
+
+/// Collects one-way latency samples from any thread and reports percentiles.
+class LatencyCollector {
+public:
+
+  void Add(uint64_t micros) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _samples.push_back(micros);
+  }
+
+  uint64_t Percentile(double fraction) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_samples.empty()) {
+      return 0u;
+    }
+    std::sort(_samples.begin(), _samples.end());
+    const auto index = std::min(
+        _samples.size() - 1u,
+        static_cast<size_t>(fraction * static_cast<double>(_samples.size())));
+    return _samples[index];
+  }
+
+private:
+
+  std::mutex _mutex;
+
+  std::vector<uint64_t> _samples;
+};
+
+/// Payload with the send time in the first eight bytes, rest is filler.
+static Buffer MakeMessage(size_t size) {
+  size = std::max(size, sizeof(uint64_t));
+  Buffer message(static_cast<Buffer::size_type>(size));
+  std::memset(message.data(), 42, message.size());
+  return message;
+}
+
+static void StampMessage(Buffer &message) {
+  const auto now = NowEpochUs();
+  std::memcpy(message.data(), &now, sizeof(now));
+}
+
+static uint64_t ReadStamp(const Buffer &message) {
+  uint64_t stamp = 0u;
+  std::memcpy(&stamp, message.data(), sizeof(stamp));
+  return stamp;
+}
+
+// =============================================================================
+// -- Roles --------------------------------------------------------------------
+// =============================================================================
+
+struct Counters {
+  std::atomic_size_t received{0u};
+  std::atomic_size_t bytes{0u};
+};
+
+static void Subscribe(
+    streaming::Client &client,
+    const streaming::Token &token,
+    Counters &counters,
+    LatencyCollector &latency) {
+  client.Subscribe(token, [&counters, &latency](Buffer message) {
+    const auto now = NowEpochUs();
+    const auto sent = ReadStamp(message);
+    latency.Add(now > sent ? now - sent : 0u);
+    ++counters.received;
+    counters.bytes += message.size();
+  });
+}
+
+static void Publish(std::vector<streaming::Stream> &streams, const Options &options) {
+  std::vector<std::thread> publishers;
+  for (auto &stream : streams) {
+    publishers.emplace_back([&stream, &options]() {
+      auto message = MakeMessage(options.message_size);
+      const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / options.rate_hz));
+      auto next = std::chrono::steady_clock::now();
+      for (auto i = 0u; i < options.messages; ++i) {
+        std::this_thread::sleep_until(next);
+        next += period;
+        StampMessage(message);
+        stream << message;
+      }
+    });
+  }
+  for (auto &publisher : publishers) {
+    publisher.join();
+  }
+}
+
+static void ReportSummary(
+    const Options &options,
+    size_t sent,
+    Counters &counters,
+    LatencyCollector &latency,
+    double elapsed_s) {
+  const double mb_per_s = (elapsed_s > 0.0)
+      ? static_cast<double>(counters.bytes) / (elapsed_s * 1024.0 * 1024.0)
+      : 0.0;
+  std::printf("streams,subscribers,message_bytes,sent,received,mb_per_s,p50_us,p90_us,p99_us,max_us\n");
+  std::printf("%zu,%zu,%zu,%zu,%zu,%.2f,%llu,%llu,%llu,%llu\n",
+      options.streams,
+      options.subscribers,
+      options.message_size,
+      sent,
+      counters.received.load(),
+      mb_per_s,
+      static_cast<unsigned long long>(latency.Percentile(0.50)),
+      static_cast<unsigned long long>(latency.Percentile(0.90)),
+      static_cast<unsigned long long>(latency.Percentile(0.99)),
+      static_cast<unsigned long long>(latency.Percentile(1.0)));
+}
+
+/// Publisher and subscribers in one process, over loopback.
+static int RunLoopback(const Options &options) {
+  streaming::Server server(options.address, options.port);
+  if (options.compression) {
+    server.EnableCompression();
+  }
+  if (options.shared_memory) {
+    server.EnableSharedMemory();
+  }
+
+  std::vector<streaming::Stream> streams;
+  for (auto i = 0u; i < options.streams; ++i) {
+    streams.push_back(server.MakeStream());
+  }
+
+  Counters counters;
+  LatencyCollector latency;
+  std::vector<std::unique_ptr<streaming::Client>> clients;
+  for (auto i = 0u; i < options.subscribers; ++i) {
+    clients.push_back(std::make_unique<streaming::Client>());
+    for (auto &stream : streams) {
+      Subscribe(*clients.back(), stream.token(), counters, latency);
+    }
+    clients.back()->AsyncRun(std::max<size_t>(2u, options.streams));
+  }
+  server.AsyncRun(std::max<size_t>(2u, options.streams));
+  std::this_thread::sleep_for(1s); // let the subscriptions settle.
+
+  const auto start = std::chrono::steady_clock::now();
+  Publish(streams, options);
+
+  const auto expected = options.streams * options.messages * options.subscribers;
+  for (auto i = 0u; (i < 10u) && (counters.received < expected); ++i) {
+    std::this_thread::sleep_for(1s);
+  }
+  const auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  ReportSummary(options, options.streams * options.messages, counters, latency, elapsed);
+  return 0;
+}
+
+/// Publisher only; tokens go to stdout, the summary row to stderr is not
+/// needed so only counts are printed there.
+static int RunServe(const Options &options) {
+  streaming::Server server(options.address, options.port, options.address, options.port);
+  if (options.compression) {
+    server.EnableCompression();
+  }
+  if (options.shared_memory) {
+    server.EnableSharedMemory();
+  }
+
+  std::vector<streaming::Stream> streams;
+  for (auto i = 0u; i < options.streams; ++i) {
+    streams.push_back(server.MakeStream());
+    std::cout << TokenToHex(streams.back().token()) << std::endl;
+  }
+  server.AsyncRun(std::max<size_t>(2u, options.streams));
+
+  std::fprintf(stderr, "serving %zu streams on %s:%u, waiting for subscribers...\n",
+      options.streams, options.address.c_str(), unsigned(options.port));
+  std::this_thread::sleep_for(std::chrono::duration<double>(options.duration_s));
+
+  Publish(streams, options);
+  std::this_thread::sleep_for(1s); // drain the write queues.
+  std::fprintf(stderr, "sent %zu messages\n", options.streams * options.messages);
+  return 0;
+}
+
+/// Subscriber only; reads hex tokens (one per line) from the given file.
+static int RunSubscribe(const Options &options) {
+  std::ifstream file(options.subscribe_path);
+  std::vector<streaming::Token> tokens;
+  std::string line;
+  while (std::getline(file, line)) {
+    streaming::Token token;
+    if (TokenFromHex(line, token)) {
+      tokens.push_back(token);
+    } else if (!line.empty()) {
+      std::fprintf(stderr, "skipping malformed token: %s\n", line.c_str());
+    }
+  }
+  if (tokens.empty()) {
+    std::fprintf(stderr, "no tokens in %s\n", options.subscribe_path.c_str());
+    return 1;
+  }
+
+  Counters counters;
+  LatencyCollector latency;
+  streaming::Client client;
+  for (const auto &token : tokens) {
+    Subscribe(client, token, counters, latency);
+  }
+  client.AsyncRun(std::max<size_t>(2u, tokens.size()));
+
+  const auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(options.duration_s));
+  const auto elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  Options reported = options;
+  reported.streams = tokens.size();
+  reported.subscribers = 1u;
+  ReportSummary(reported, 0u, counters, latency, elapsed);
+  return 0;
+}
+
+int main(int argc, const char *argv[]) {
+  const auto options = ParseOptions(argc, argv);
+  if (options.serve) {
+    return RunServe(options);
+  }
+  if (!options.subscribe_path.empty()) {
+    return RunSubscribe(options);
+  }
+  return RunLoopback(options);
+}
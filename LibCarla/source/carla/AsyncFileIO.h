@@ -0,0 +1,99 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/FileSystem.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadPool.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+
+namespace carla {
+
+  /// Shared pool of file writer threads with a bounded backlog.
+  ///
+  /// Disk writes issued from sensor callbacks stall the callback thread
+  /// whenever the disk (or worse, a network file system) hiccups; funnelling
+  /// them through here keeps the stall on a writer thread instead. The
+  /// backlog bound keeps memory in check when the disk cannot keep up, past
+  /// it the caller blocks until a writer frees up.
+  ///
+  /// @warning Using this file requires linking against boost_filesystem.
+  class AsyncFileIO : private NonCopyable {
+  public:
+
+    /// Jobs waiting in the pool before Post blocks the caller.
+    static constexpr size_t max_pending_writes = 64u;
+
+    static AsyncFileIO &GetInstance() {
+      static AsyncFileIO instance;
+      return instance;
+    }
+
+    /// Run @a functor, typically opening and writing one file, on a writer
+    /// thread. The future delivers its result or rethrows its exception.
+    template <typename FunctorT, typename ResultT = typename std::result_of<FunctorT()>::type>
+    std::future<ResultT> Post(FunctorT &&functor) {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_full.wait(lock, [this]() { return _pending < max_pending_writes; });
+        ++_pending;
+      }
+      return _pool.Post([this, functor = std::forward<FunctorT>(functor)]() mutable {
+        try {
+          auto result = functor();
+          ReleaseSlot();
+          return result;
+        } catch (...) {
+          ReleaseSlot();
+          throw;
+        }
+      });
+    }
+
+    /// Write @a contents to @a path on a writer thread, creating missing
+    /// parent directories. The future delivers the final path.
+    std::future<std::string> Write(std::string path, std::string contents) {
+      return Post([path = std::move(path), contents = std::move(contents)]() mutable {
+        FileSystem::ValidateFilePath(path);
+        std::ofstream out(path, std::ios_base::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        return path;
+      });
+    }
+
+  private:
+
+    AsyncFileIO() {
+      // Few threads on purpose, the point is overlapping I/O stalls with the
+      // simulation, not parallel throughput; writer count scales nothing on
+      // one spindle.
+      auto config = ThreadConfig::ProcessDefault();
+      config.name = "carla-file-io";
+      _pool.AsyncRun(2u, config);
+    }
+
+    void ReleaseSlot() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      --_pending;
+      _not_full.notify_one();
+    }
+
+    ThreadPool _pool;
+
+    std::mutex _mutex;
+
+    std::condition_variable _not_full;
+
+    size_t _pending = 0u;
+  };
+
+} // namespace carla
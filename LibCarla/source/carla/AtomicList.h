@@ -19,6 +19,10 @@ namespace detail {
 
   /// Holds an atomic pointer to a list.
   ///
+  /// Load goes through the epoch-reclaimed AtomicSharedPtr, so readers
+  /// iterating the list (e.g. CallbackList on every sensor frame) are
+  /// wait-free.
+  ///
   /// @warning Only Load method is atomic, modifications to the list are locked
   /// with a mutex.
   template <typename T>
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace carla {
+
+  /// A thread-safe map sharded by key hash.
+  ///
+  /// Each shard has its own mutex and hash map, so lookups of different keys
+  /// mostly take different locks. This keeps many reader threads (one per
+  /// traffic manager stage, one per vehicle batch) from contending on a single
+  /// mutex the way a fully locked map does.
+  ///
+  /// @warning As with the older single-lock map, the reference returned by
+  /// GetValue is only guaranteed to be valid until the entry is removed.
+  template <typename Key, typename Value, size_t SHARDS = 16u>
+  class AtomicMap : private NonCopyable {
+
+    static_assert(SHARDS > 0u, "need at least one shard");
+
+  public:
+
+    AtomicMap() {}
+
+    void AddEntry(const std::pair<Key, Value> &entry) {
+      auto &shard = ShardFor(entry.first);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto result = shard.map.emplace(entry);
+      if (!result.second) {
+        result.first->second = entry.second;
+      }
+    }
+
+    bool Contains(const Key &key) const {
+      auto &shard = ShardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      return shard.map.find(key) != shard.map.end();
+    }
+
+    const Value &GetValue(const Key &key) const {
+      auto &shard = ShardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      return shard.map.at(key);
+    }
+
+    /// Copy the value for @a key into @a value. Returns false and leaves @a
+    /// value untouched if the key is missing; a single lookup where
+    /// Contains-then-GetValue would take the shard lock twice.
+    bool GetValueIfPresent(const Key &key, Value &value) const {
+      auto &shard = ShardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.map.find(key);
+      if (it == shard.map.end()) {
+        return false;
+      }
+      value = it->second;
+      return true;
+    }
+
+    void RemoveEntry(const Key &key) {
+      auto &shard = ShardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.map.erase(key);
+    }
+
+  private:
+
+    struct Shard {
+      mutable std::mutex mutex;
+      std::unordered_map<Key, Value> map;
+    };
+
+    Shard &ShardFor(const Key &key) const {
+      return _shards[std::hash<Key>()(key) % SHARDS];
+    }
+
+    mutable std::array<Shard, SHARDS> _shards;
+  };
+
+} // namespace carla
@@ -6,26 +6,48 @@
 
 #pragma once
 
+#include "carla/EpochReclaimer.h"
+
+#include <atomic>
 #include <memory>
 
 namespace carla {
 
-  /// A very simple atomic shared ptr with release-acquire memory order.
+  /// A very simple atomic shared ptr.
+  ///
+  /// The shared_ptr lives behind an atomic raw pointer and retired holders
+  /// are reclaimed through EpochReclaimer, so load never touches the
+  /// standard library's shared_ptr spinlock pool: readers are wait-free and
+  /// only pay the reference count increment.
+  ///
+  /// All pointer operations are sequentially consistent: the reclaimer's
+  /// epoch protocol needs the reader's pin-publish and pointer load to fall
+  /// in a single total order with the writer's exchange and epoch scan;
+  /// acquire-release alone lets them interleave on weakly ordered targets.
   template <typename T>
   class AtomicSharedPtr {
   public:
 
     template <typename... Args>
     explicit AtomicSharedPtr(Args &&... args)
-      : _ptr(std::forward<Args>(args)...) {}
+      : _holder(new std::shared_ptr<T>(std::forward<Args>(args)...)) {}
 
     AtomicSharedPtr(const AtomicSharedPtr &rhs)
-      : _ptr(rhs.load()) {}
+      : _holder(new std::shared_ptr<T>(rhs.load())) {}
 
     AtomicSharedPtr(AtomicSharedPtr &&) = delete;
 
+    ~AtomicSharedPtr() {
+      // A reader may still be copying the last value, let the reclaimer
+      // delete it once every guard in flight has been released.
+      EpochReclaimer::GetInstance().Retire(
+          _holder.exchange(nullptr, std::memory_order_seq_cst));
+    }
+
     void store(std::shared_ptr<T> ptr) noexcept {
-      std::atomic_store_explicit(&_ptr, ptr, std::memory_order_release);
+      auto *holder = new std::shared_ptr<T>(std::move(ptr));
+      auto *old = _holder.exchange(holder, std::memory_order_seq_cst);
+      EpochReclaimer::GetInstance().Retire(old);
     }
 
     void reset(std::shared_ptr<T> ptr = nullptr) noexcept {
@@ -33,16 +55,27 @@ namespace carla {
     }
 
     std::shared_ptr<T> load() const noexcept {
-      return std::atomic_load_explicit(&_ptr, std::memory_order_acquire);
+      EpochReclaimer::Guard guard;
+      return *_holder.load(std::memory_order_seq_cst);
     }
 
     bool compare_exchange(std::shared_ptr<T> *expected, std::shared_ptr<T> desired) noexcept {
-      return std::atomic_compare_exchange_strong_explicit(
-          &_ptr,
-          expected,
-          desired,
-          std::memory_order_acq_rel,
-          std::memory_order_acq_rel);
+      EpochReclaimer::Guard guard;
+      auto *holder = _holder.load(std::memory_order_seq_cst);
+      if (*holder == *expected) {
+        auto *new_holder = new std::shared_ptr<T>(std::move(desired));
+        if (_holder.compare_exchange_strong(
+            holder,
+            new_holder,
+            std::memory_order_seq_cst,
+            std::memory_order_seq_cst)) {
+          EpochReclaimer::GetInstance().Retire(holder);
+          return true;
+        }
+        delete new_holder;
+      }
+      *expected = *_holder.load(std::memory_order_seq_cst);
+      return false;
     }
 
     AtomicSharedPtr &operator=(std::shared_ptr<T> ptr) noexcept {
@@ -59,7 +92,7 @@ namespace carla {
 
   private:
 
-    std::shared_ptr<T> _ptr;
+    std::atomic<std::shared_ptr<T> *> _holder;
   };
 
 } // namespace carla
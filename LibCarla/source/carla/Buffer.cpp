@@ -1,9 +1,76 @@
 #include "carla/Buffer.h"
 
 #include "carla/BufferPool.h"
+#include "carla/profiler/AllocationTracker.h"
+
+#include <atomic>
 
 namespace carla {
 
+namespace {
+
+  std::atomic<Buffer::allocator_fn> custom_allocator{nullptr};
+
+  std::atomic<Buffer::deallocator_fn> custom_deallocator{nullptr};
+
+} // namespace
+
+  void Buffer::SetPinnedMemoryAllocator(allocator_fn allocate, deallocator_fn deallocate) {
+    DEBUG_ASSERT((allocate == nullptr) == (deallocate == nullptr));
+    custom_allocator = allocate;
+    custom_deallocator = deallocate;
+  }
+
+  bool Buffer::HasPinnedMemoryAllocator() {
+    return custom_allocator != nullptr;
+  }
+
+  Buffer::value_type *Buffer::Allocate(size_type size) {
+    auto allocate = custom_allocator.load();
+    auto *data = (allocate != nullptr)
+        ? allocate(size)
+        : static_cast<value_type *>(std::malloc(size));
+    if (data == nullptr) {
+      throw_exception(std::bad_alloc());
+    }
+    // buffers bypass operator new, report them to the allocation tracker
+    // directly.
+    profiler::AllocationTracker::RecordAllocation(profiler::AllocationTag::Buffer, size);
+    return data;
+  }
+
+  Buffer::value_type *Buffer::Reallocate(value_type *data, size_type old_size, size_type new_size) {
+    if (custom_allocator != nullptr) {
+      // Pinned allocators have no realloc; fall back to allocate and copy.
+      auto *result = Allocate(new_size);
+      if (old_size > 0u) {
+        std::memcpy(result, data, old_size);
+      }
+      custom_deallocator.load()(data);
+      profiler::AllocationTracker::RecordDeallocation(profiler::AllocationTag::Buffer, old_size);
+      return result;
+    }
+    auto *result = static_cast<value_type *>(std::realloc(data, new_size));
+    if (result == nullptr) {
+      throw_exception(std::bad_alloc());
+    }
+    profiler::AllocationTracker::RecordDeallocation(profiler::AllocationTag::Buffer, old_size);
+    profiler::AllocationTracker::RecordAllocation(profiler::AllocationTag::Buffer, new_size);
+    return result;
+  }
+
+  void Buffer::Deallocate() noexcept {
+    if (IsHeapAllocated()) {
+      auto deallocate = custom_deallocator.load();
+      if (deallocate != nullptr) {
+        deallocate(_data);
+      } else {
+        std::free(_data);
+      }
+      profiler::AllocationTracker::RecordDeallocation(profiler::AllocationTag::Buffer, _capacity);
+    }
+  }
+
   void Buffer::ReuseThisBuffer() {
     auto pool = _parent_pool.lock();
     if (pool != nullptr) {
@@ -9,10 +9,14 @@
 #include "carla/Debug.h"
 #include "carla/Exception.h"
 #include "carla/Logging.h"
+#include "carla/profiler/Metrics.h"
 
 #include <boost/asio/buffer.hpp>
 
+#include <array>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -27,9 +31,13 @@ namespace carla {
 
   /// A piece of raw data.
   ///
-  /// Note that if more capacity is needed, a new memory block is allocated and
-  /// the old one is deleted. This means that by default the buffer can only
-  /// grow. To release the memory use `clear` or `pop`.
+  /// Small payloads (up to inline_capacity bytes) are stored inline and never
+  /// touch the heap, which makes high-rate small messages (IMU, GNSS)
+  /// allocation-free. Bigger payloads live in a heap block that grows in
+  /// place when the allocator allows it.
+  ///
+  /// Note that if more capacity is needed, the buffer can only grow. To
+  /// release the memory use `clear`.
   ///
   /// This is a move-only type, meant to be cheap to pass by value. If the
   /// buffer is retrieved from a BufferPool, the memory is automatically pushed
@@ -53,6 +61,36 @@ namespace carla {
 
     using const_iterator = const value_type *;
 
+    /// Payloads up to this size are stored inline; sized so the sensor
+    /// message header always fits without touching the heap.
+    static constexpr size_type inline_capacity = 96u;
+
+    /// @}
+    // =========================================================================
+    /// @name Pinned memory
+    // =========================================================================
+    /// @{
+
+  public:
+
+    using allocator_fn = value_type *(*)(size_type);
+
+    using deallocator_fn = void (*)(value_type *);
+
+    /// Route the heap allocations of every buffer through @a allocate and
+    /// @a deallocate instead of malloc and free. Meant for page-locked
+    /// (pinned) memory, e.g. cudaHostAlloc/cudaFreeHost, so sensor frames
+    /// land in memory the GPU can DMA from directly. Pass nullptr to
+    /// restore the default.
+    ///
+    /// @warning Blocks are released with the deallocator installed at the
+    /// time they are freed; install the allocator once at start-up, before
+    /// the first buffer is created.
+    static void SetPinnedMemoryAllocator(allocator_fn allocate, deallocator_fn deallocate);
+
+    /// Whether a pinned memory allocator is currently installed.
+    static bool HasPinnedMemoryAllocator();
+
     /// @}
     // =========================================================================
     /// @name Construction and destruction
@@ -65,10 +103,9 @@ namespace carla {
     Buffer() = default;
 
     /// Create a buffer with @a size bytes allocated.
-    explicit Buffer(size_type size)
-      : _size(size),
-        _capacity(size),
-        _data(std::make_unique<value_type[]>(size)) {}
+    explicit Buffer(size_type size) {
+      reset(size);
+    }
 
     /// @copydoc Buffer(size_type)
     explicit Buffer(uint64_t size)
@@ -100,16 +137,16 @@ namespace carla {
 
     Buffer(const Buffer &) = delete;
 
-    Buffer(Buffer &&rhs) noexcept
-      : _parent_pool(std::move(rhs._parent_pool)),
-        _size(rhs._size),
-        _capacity(rhs._capacity),
-        _data(rhs.pop()) {}
+    Buffer(Buffer &&rhs) noexcept {
+      MoveFrom(rhs);
+      _parent_pool = std::move(rhs._parent_pool);
+    }
 
     ~Buffer() {
-      if (_capacity > 0u) {
-        ReuseThisBuffer();
-      }
+      // Inline buffers go back to the pool too, their contents move with
+      // them. Deallocate is a no-op once the pool has taken the heap block.
+      ReuseThisBuffer();
+      Deallocate();
     }
 
     /// @}
@@ -123,10 +160,9 @@ namespace carla {
     Buffer &operator=(const Buffer &) = delete;
 
     Buffer &operator=(Buffer &&rhs) noexcept {
+      Deallocate();
+      MoveFrom(rhs);
       _parent_pool = std::move(rhs._parent_pool);
-      _size = rhs._size;
-      _capacity = rhs._capacity;
-      _data = rhs.pop();
       return *this;
     }
 
@@ -151,13 +187,13 @@ namespace carla {
     /// Direct access to the allocated memory or nullptr if no memory is
     /// allocated.
     const value_type *data() const noexcept {
-      return _data.get();
+      return _data;
     }
 
     /// Direct access to the allocated memory or nullptr if no memory is
     /// allocated.
     value_type *data() noexcept {
-      return _data.get();
+      return _data;
     }
 
     /// Make a boost::asio::buffer from this buffer.
@@ -212,7 +248,7 @@ namespace carla {
   public:
 
     const_iterator cbegin() const noexcept {
-      return _data.get();
+      return _data;
     }
 
     const_iterator begin() const noexcept {
@@ -220,7 +256,7 @@ namespace carla {
     }
 
     iterator begin() noexcept {
-      return _data.get();
+      return _data;
     }
 
     const_iterator cend() const noexcept {
@@ -248,9 +284,18 @@ namespace carla {
     /// allocated.
     void reset(size_type size) {
       if (_capacity < size) {
-        log_debug("allocating buffer of", size, "bytes");
-        _data = std::make_unique<value_type[]>(size);
-        _capacity = size;
+        if (size <= inline_capacity) {
+          // Release any heap block smaller than the inline storage (resize on
+          // an empty buffer allocates at exact size) before repointing at it.
+          Deallocate();
+          _data = _inline.data();
+          _capacity = inline_capacity;
+        } else {
+          log_debug("allocating buffer of", size, "bytes");
+          Deallocate();
+          _data = Allocate(size);
+          _capacity = size;
+        }
       }
       _size = size;
     }
@@ -263,30 +308,36 @@ namespace carla {
       reset(static_cast<size_type>(size));
     }
 
-    /// Resize the buffer, a new block of size @a size is
-    /// allocated if the capacity is not enough and the data is copied.
+    /// Resize the buffer; the data is preserved. Heap blocks grow in place
+    /// whenever the allocator can extend them.
     void resize(uint64_t size) {
-      if(_capacity < size) {
-        std::unique_ptr<value_type[]> data = std::move(_data);
-        uint64_t old_size = size;
-        reset(size);
-        copy_from(data.get(), static_cast<size_type>(old_size));
+      if (size > max_size()) {
+        throw_exception(std::invalid_argument("message size too big"));
+      }
+      if (_capacity < size) {
+        const auto new_size = static_cast<size_type>(size);
+        if (IsHeapAllocated()) {
+          // May grow in place, sparing both the allocation and the copy.
+          _data = Reallocate(_data, _capacity, new_size);
+        } else {
+          auto *data = Allocate(new_size);
+          if (_size > 0u) {
+            std::memcpy(data, _data, _size);
+          }
+          _data = data;
+        }
+        _capacity = new_size;
       }
       _size = static_cast<size_type>(size);
     }
 
-    /// Release the contents of this buffer and set its size and capacity to
-    /// zero.
-    std::unique_ptr<value_type[]> pop() noexcept {
-      _size = 0u;
-      _capacity = 0u;
-      return std::move(_data);
-    }
-
     /// Clear the contents of this buffer and set its size and capacity to zero.
     /// Deletes allocated memory.
     void clear() noexcept {
-      pop();
+      Deallocate();
+      _data = nullptr;
+      _capacity = 0u;
+      _size = 0u;
     }
 
     /// @}
@@ -319,6 +370,7 @@ namespace carla {
     template <typename T>
     typename std::enable_if<boost::asio::is_const_buffer_sequence<T>::value>::type
     copy_from(size_type offset, const T &source) {
+      CARLA_METRIC_SCOPE(buffer, copy_from);
       reset(boost::asio::buffer_size(source) + offset);
       DEBUG_ASSERT(boost::asio::buffer_size(source) == size() - offset);
       DEBUG_ONLY(auto bytes_copied = )
@@ -355,6 +407,37 @@ namespace carla {
 
   private:
 
+    bool IsInline() const noexcept {
+      return _data == _inline.data();
+    }
+
+    bool IsHeapAllocated() const noexcept {
+      return (_data != nullptr) && !IsInline();
+    }
+
+    static value_type *Allocate(size_type size);
+
+    /// @a old_size is the size of the block @a data was allocated with.
+    static value_type *Reallocate(value_type *data, size_type old_size, size_type new_size);
+
+    void Deallocate() noexcept;
+
+    /// Take over the contents of @a rhs, leaving it empty. Inline payloads
+    /// are copied, heap blocks are stolen.
+    void MoveFrom(Buffer &rhs) noexcept {
+      _size = rhs._size;
+      _capacity = rhs._capacity;
+      if (rhs.IsInline()) {
+        _data = _inline.data();
+        std::memcpy(_inline.data(), rhs._inline.data(), rhs._size);
+      } else {
+        _data = rhs._data;
+      }
+      rhs._data = nullptr;
+      rhs._size = 0u;
+      rhs._capacity = 0u;
+    }
+
     void ReuseThisBuffer();
 
     friend class BufferPool;
@@ -365,7 +448,9 @@ namespace carla {
 
     size_type _capacity = 0u;
 
-    std::unique_ptr<value_type[]> _data = nullptr;
+    value_type *_data = nullptr;
+
+    std::array<value_type, inline_capacity> _inline;
   };
 
 } // namespace carla
@@ -17,6 +17,7 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <array>
 #include <memory>
 
 namespace carla {
@@ -24,20 +25,53 @@ namespace carla {
   /// A pool of Buffer. Buffers popped from this pool automatically return to
   /// the pool on destruction so the allocated memory can be reused.
   ///
+  /// Buffers are kept in buckets by capacity (powers of two starting at 4 KB)
+  /// so that a small message does not pin a frame-sized allocation and a big
+  /// message does not repeatedly regrow a small one. Memory is first-touch
+  /// allocated by the thread that grows the buffer, so on NUMA machines
+  /// buffers naturally live on the node of the producer that filled them;
+  /// keeping one pool per producer preserves that locality.
+  ///
+  /// With a pinned memory allocator installed (see
+  /// Buffer::SetPinnedMemoryAllocator) the pool also amortizes the cost of
+  /// page-locking: each block is pinned once and reused frame after frame.
+  ///
   /// @warning Buffers adjust their size only by growing, they never shrink
   /// unless explicitly cleared. The allocated memory is only deleted when this
   /// pool is destroyed.
   class BufferPool : public std::enable_shared_from_this<BufferPool> {
+
+    /// Capacity of the smallest bucket.
+    static constexpr size_t BASE_BUCKET_SIZE = 4096u;
+
+    /// Number of capacity buckets; the last one takes everything bigger.
+    static constexpr size_t NUMBER_OF_BUCKETS = 8u;
+
   public:
 
     BufferPool() = default;
 
-    explicit BufferPool(size_t estimated_size) : _queue(estimated_size) {}
+    explicit BufferPool(size_t estimated_size) {
+      for (auto &queue : _buckets) {
+        queue = Queue(estimated_size);
+      }
+    }
 
     /// Pop a Buffer from the queue, creates a new one if the queue is empty.
     Buffer Pop() {
+      return Pop(0u);
+    }
+
+    /// Pop a Buffer whose capacity is likely to fit @a size_hint bytes
+    /// without regrowing. Creates a new one if no such buffer is pooled.
+    Buffer Pop(size_t size_hint) {
       Buffer item;
-      _queue.try_dequeue(item); // we don't care if it fails.
+      // Look in the matching bucket first, then in the bigger ones.
+      for (auto i = BucketFor(size_hint); i < NUMBER_OF_BUCKETS; ++i) {
+        if (_buckets[i].try_dequeue(item)) {
+          break;
+        }
+      }
 #if __cplusplus >= 201703L // C++17
       item._parent_pool = weak_from_this();
 #else
@@ -50,11 +84,23 @@ namespace carla {
 
     friend class Buffer;
 
+    static size_t BucketFor(size_t capacity) {
+      size_t bucket = 0u;
+      size_t bucket_size = BASE_BUCKET_SIZE;
+      while ((capacity > bucket_size) && (bucket + 1u < NUMBER_OF_BUCKETS)) {
+        bucket_size *= 2u;
+        ++bucket;
+      }
+      return bucket;
+    }
+
     void Push(Buffer &&buffer) {
-      _queue.enqueue(std::move(buffer));
+      _buckets[BucketFor(buffer.capacity())].enqueue(std::move(buffer));
     }
 
-    moodycamel::ConcurrentQueue<Buffer> _queue;
+    using Queue = moodycamel::ConcurrentQueue<Buffer>;
+
+    std::array<Queue, NUMBER_OF_BUCKETS> _buckets;
   };
 
 } // namespace carla
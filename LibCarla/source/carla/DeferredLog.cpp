@@ -0,0 +1,139 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/DeferredLog.h"
+
+#include <chrono>
+
+namespace carla {
+namespace logging {
+
+  /// File header of the binary structured stream: magic plus a format
+  /// version byte, so readers can reject streams they do not understand.
+  static const char STREAM_MAGIC[5u] = {'C', 'L', 'O', 'G', '\x01'};
+
+  std::atomic<uint8_t> DeferredLog::_minimum_level {static_cast<uint8_t>(Level::debug)};
+
+  DeferredLog &DeferredLog::Get() {
+    static DeferredLog instance;
+    return instance;
+  }
+
+  DeferredLog::~DeferredLog() {
+    Disable();
+  }
+
+  void DeferredLog::Enable(const std::string &path, size_t capacity) {
+    if (IsEnabled()) {
+      return;
+    }
+    size_t rounded = 1u;
+    while (rounded < capacity) {
+      rounded <<= 1u;
+    }
+    _slots.reset(new Slot[rounded]);
+    for (size_t i = 0u; i < rounded; ++i) {
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _mask = rounded - 1u;
+    _enqueue_pos.store(0u, std::memory_order_relaxed);
+    _dequeue_pos = 0u;
+    _file.open(path, std::ios::binary | std::ios::app);
+    _file.write(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+    _running.store(true, std::memory_order_release);
+    _thread = std::thread(&DeferredLog::WriterLoop, this);
+    _enabled.store(true, std::memory_order_release);
+  }
+
+  void DeferredLog::Disable() {
+    if (!IsEnabled()) {
+      return;
+    }
+    _enabled.store(false, std::memory_order_release);
+    _running.store(false, std::memory_order_release);
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+    _file.close();
+    _slots.reset();
+  }
+
+  void DeferredLog::SetMinimumLevel(Level level) {
+    _minimum_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+  }
+
+  bool DeferredLog::IsLevelEnabled(Level level) {
+    return static_cast<uint8_t>(level) >= _minimum_level.load(std::memory_order_relaxed);
+  }
+
+  uint64_t DeferredLog::NowNanos() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  bool DeferredLog::TryPush(const Record &record) {
+    uint64_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = _slots[pos & _mask];
+      const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const int64_t difference =
+          static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+      if (difference == 0) {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+          slot.record = record;
+          slot.sequence.store(pos + 1u, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        // A whole lap behind the consumer: the ring is full.
+        return false;
+      } else {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool DeferredLog::TryPop(Record &record) {
+    Slot &slot = _slots[_dequeue_pos & _mask];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<int64_t>(sequence) - static_cast<int64_t>(_dequeue_pos + 1u) < 0) {
+      return false;
+    }
+    record = slot.record;
+    slot.sequence.store(_dequeue_pos + _mask + 1u, std::memory_order_release);
+    ++_dequeue_pos;
+    return true;
+  }
+
+  void DeferredLog::WriterLoop() {
+    Record record;
+    for (;;) {
+      if (TryPop(record)) {
+        const uint8_t level = static_cast<uint8_t>(record.GetLevel());
+        const uint64_t nanos = record.GetTimestampNanos();
+        const uint16_t size = record.GetPayloadSize();
+        _file.write(reinterpret_cast<const char *>(&level), sizeof(level));
+        _file.write(reinterpret_cast<const char *>(&nanos), sizeof(nanos));
+        _file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        _file.write(reinterpret_cast<const char *>(record.GetPayload()), size);
+        continue;
+      }
+      _file.flush();
+      if (!_running.load(std::memory_order_acquire)) {
+        // Spin out producers that had already claimed a slot when the
+        // stop flag flipped, then exit; Disable never drops records.
+        if (_dequeue_pos == _enqueue_pos.load(std::memory_order_acquire)) {
+          break;
+        }
+        continue;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+} // namespace logging
+} // namespace carla
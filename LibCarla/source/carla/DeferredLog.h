@@ -0,0 +1,282 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace carla {
+namespace logging {
+
+  enum class Level : uint8_t {
+    debug = 1u,
+    info = 2u,
+    warning = 3u,
+    error = 4u,
+    critical = 5u
+  };
+
+  /// A log record serialized on the calling thread as a flat binary payload
+  /// of typed fields; no text formatting happens until the writer thread
+  /// picks the record up. Fields that do not fit in the fixed payload are
+  /// replaced by a truncation marker rather than growing the record.
+  class Record {
+  public:
+
+    static constexpr size_t PayloadCapacity = 232u;
+
+    enum FieldTag : uint8_t {
+      field_end       = 0u,
+      field_int       = 1u,
+      field_uint      = 2u,
+      field_float     = 3u,
+      field_bool      = 4u,
+      field_text      = 5u,
+      field_truncated = 6u
+    };
+
+    void Reset(Level level, uint64_t timestamp_nanos) {
+      _level = level;
+      _timestamp_nanos = timestamp_nanos;
+      _size = 0u;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    Append(T value) {
+      AppendScalar(field_int, static_cast<int64_t>(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    Append(T value) {
+      AppendScalar(field_uint, static_cast<uint64_t>(value));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    Append(T value) {
+      AppendScalar(field_float, static_cast<double>(value));
+    }
+
+    void Append(bool value) {
+      AppendScalar(field_bool, static_cast<uint8_t>(value ? 1u : 0u));
+    }
+
+    void Append(const char *text) {
+      AppendText(text, std::strlen(text));
+    }
+
+    void Append(const std::string &text) {
+      AppendText(text.data(), text.size());
+    }
+
+    Level GetLevel() const {
+      return _level;
+    }
+
+    uint64_t GetTimestampNanos() const {
+      return _timestamp_nanos;
+    }
+
+    const uint8_t *GetPayload() const {
+      return _payload.data();
+    }
+
+    uint16_t GetPayloadSize() const {
+      return _size;
+    }
+
+  private:
+
+    template <typename T>
+    void AppendScalar(FieldTag tag, T value) {
+      if (!Fits(1u + sizeof(T))) {
+        MarkTruncated();
+        return;
+      }
+      _payload[_size++] = static_cast<uint8_t>(tag);
+      std::memcpy(_payload.data() + _size, &value, sizeof(T));
+      _size += sizeof(T);
+    }
+
+    void AppendText(const char *data, size_t length) {
+      if (length > UINT16_MAX) {
+        length = UINT16_MAX;
+      }
+      if (!Fits(1u + sizeof(uint16_t) + length)) {
+        MarkTruncated();
+        return;
+      }
+      _payload[_size++] = static_cast<uint8_t>(field_text);
+      const uint16_t stored = static_cast<uint16_t>(length);
+      std::memcpy(_payload.data() + _size, &stored, sizeof(stored));
+      _size += sizeof(stored);
+      std::memcpy(_payload.data() + _size, data, length);
+      _size += static_cast<uint16_t>(length);
+    }
+
+    bool Fits(size_t bytes) const {
+      // Always leave room for the truncation marker.
+      return _size + bytes + 1u <= PayloadCapacity;
+    }
+
+    void MarkTruncated() {
+      if ((_size == 0u) || (_payload[_size - 1u] != field_truncated)) {
+        _payload[_size++] = static_cast<uint8_t>(field_truncated);
+      }
+    }
+
+    Level _level = Level::debug;
+
+    uint64_t _timestamp_nanos = 0u;
+
+    uint16_t _size = 0u;
+
+    std::array<uint8_t, PayloadCapacity> _payload;
+  };
+
+namespace detail {
+
+  template <typename T>
+  struct is_encodable : std::integral_constant<bool,
+      std::is_arithmetic<typename std::decay<T>::type>::value> {};
+
+  template <>
+  struct is_encodable<std::string> : std::true_type {};
+
+  template <>
+  struct is_encodable<const char *> : std::true_type {};
+
+  template <>
+  struct is_encodable<char *> : std::true_type {};
+
+  template <typename ... Ts>
+  struct all_encodable;
+
+  template <>
+  struct all_encodable<> : std::true_type {};
+
+  template <typename T, typename ... Ts>
+  struct all_encodable<T, Ts...> : std::integral_constant<bool,
+      is_encodable<typename std::decay<T>::type>::value &&
+      all_encodable<Ts...>::value> {};
+
+} // namespace detail
+
+  /// Deferred structured logging backend: records are serialized on the
+  /// calling thread into a bounded lock-free ring and written by a
+  /// dedicated thread as a binary structured stream. Disabled by default;
+  /// while disabled the log functions keep their eager behaviour.
+  ///
+  /// The ring never loses messages: when it is full, or an argument type
+  /// cannot be binary-encoded, TryLog reports failure and the caller
+  /// falls back to the eager path.
+  class DeferredLog : private NonCopyable {
+  public:
+
+    static DeferredLog &Get();
+
+    /// Start the writer thread and route the log functions through the
+    /// ring; the binary structured stream is appended to the file at
+    /// @a path. @a capacity is rounded up to a power of two.
+    void Enable(const std::string &path, size_t capacity = 1024u);
+
+    /// Drain the ring, stop the writer thread and return the log
+    /// functions to their eager behaviour.
+    void Disable();
+
+    bool IsEnabled() const {
+      return _enabled.load(std::memory_order_acquire);
+    }
+
+    /// Records below this level are discarded before their arguments are
+    /// encoded; affects both the deferred and the level-checked macro
+    /// paths.
+    static void SetMinimumLevel(Level level);
+
+    static bool IsLevelEnabled(Level level);
+
+    /// Hand a record over to the writer thread. Returns true when the
+    /// record was either queued or discarded by the level filter; false
+    /// when the backend is disabled, the ring is full, or an argument is
+    /// not encodable, in which case the caller should log eagerly.
+    template <typename ... Args>
+    static typename std::enable_if<detail::all_encodable<Args...>::value, bool>::type
+    TryLog(Level level, const Args & ... args) {
+      DeferredLog &self = Get();
+      if (!self.IsEnabled()) {
+        return false;
+      }
+      if (!IsLevelEnabled(level)) {
+        return true;
+      }
+      Record record;
+      record.Reset(level, NowNanos());
+      using expander = int[];
+      (void) expander{0, (record.Append(args), 0) ...};
+      return self.TryPush(record);
+    }
+
+    template <typename ... Args>
+    static typename std::enable_if<!detail::all_encodable<Args...>::value, bool>::type
+    TryLog(Level, const Args & ...) {
+      return false;
+    }
+
+  private:
+
+    DeferredLog() = default;
+
+    ~DeferredLog();
+
+    static uint64_t NowNanos();
+
+    bool TryPush(const Record &record);
+
+    bool TryPop(Record &record);
+
+    void WriterLoop();
+
+    /// Bounded multi-producer ring; the writer thread is the only
+    /// consumer. Each slot carries the sequence number expected by the
+    /// next producer or consumer, so a producer never blocks on another.
+    struct Slot {
+      std::atomic<uint64_t> sequence;
+      Record record;
+    };
+
+    std::atomic<bool> _enabled {false};
+
+    std::atomic<bool> _running {false};
+
+    static std::atomic<uint8_t> _minimum_level;
+
+    std::atomic<uint64_t> _enqueue_pos {0u};
+
+    uint64_t _dequeue_pos = 0u;
+
+    size_t _mask = 0u;
+
+    std::unique_ptr<Slot[]> _slots;
+
+    std::ofstream _file;
+
+    std::thread _thread;
+  };
+
+} // namespace logging
+} // namespace carla
@@ -0,0 +1,153 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+
+  /// Epoch-based memory reclamation.
+  ///
+  /// Readers wrap their critical section in a Guard, which is a pair of
+  /// atomic stores and never blocks. Writers hand retired objects to Retire;
+  /// an object is deleted only once every thread that was inside a Guard when
+  /// it was retired has left it. Writers pay a mutex, readers never do.
+  ///
+  /// Used to back AtomicSharedPtr so that load is wait-free instead of going
+  /// through the standard library's shared_ptr spinlock pool.
+  class EpochReclaimer : private NonCopyable {
+
+    struct ThreadSlot;
+
+  public:
+
+    static EpochReclaimer &GetInstance() {
+      static EpochReclaimer instance;
+      return instance;
+    }
+
+    /// Marks a read-side critical section; any object reachable at
+    /// construction stays alive until destruction. Nesting is allowed, the
+    /// outermost guard keeps its epoch pinned.
+    class Guard : private NonCopyable {
+    public:
+
+      Guard() : _slot(GetInstance().LocalSlot()) {
+        _is_outermost = (_slot.epoch.load(std::memory_order_relaxed) == QUIESCENT);
+        if (_is_outermost) {
+          _slot.epoch.store(
+              GetInstance()._global_epoch.load(std::memory_order_acquire),
+              std::memory_order_seq_cst);
+        }
+      }
+
+      ~Guard() {
+        if (_is_outermost) {
+          _slot.epoch.store(QUIESCENT, std::memory_order_release);
+        }
+      }
+
+    private:
+
+      ThreadSlot &_slot;
+
+      bool _is_outermost;
+    };
+
+    /// Schedule @a ptr for deletion once no reader can still see it.
+    template <typename T>
+    void Retire(T *ptr) {
+      Retire([ptr]() { delete ptr; });
+    }
+
+    /// @copydoc Retire(T *)
+    void Retire(std::function<void()> deleter) {
+      std::vector<std::function<void()>> expired;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto epoch = _global_epoch.fetch_add(1u, std::memory_order_acq_rel);
+        _retired.push_back({epoch, std::move(deleter)});
+        CollectLocked(expired);
+      }
+      // Run the deleters unlocked: dropping the last reference to an object
+      // can destroy AtomicSharedPtr members inside it, which re-enter Retire
+      // and would self-deadlock on the mutex.
+      for (auto &run : expired) {
+        run();
+      }
+    }
+
+  private:
+
+    static constexpr uint64_t QUIESCENT = 0u;
+
+    struct ThreadSlot {
+      /// Epoch the thread entered at, or QUIESCENT when outside any Guard.
+      std::atomic<uint64_t> epoch{QUIESCENT};
+    };
+
+    struct RetiredItem {
+      uint64_t epoch;
+      std::function<void()> deleter;
+    };
+
+    EpochReclaimer() = default;
+
+    ThreadSlot &LocalSlot() {
+      static thread_local ThreadSlot *slot = RegisterThread();
+      return *slot;
+    }
+
+    ThreadSlot *RegisterThread() {
+      auto slot = std::make_unique<ThreadSlot>();
+      auto *result = slot.get();
+      std::lock_guard<std::mutex> lock(_mutex);
+      _slots.push_back(std::move(slot));
+      return result;
+    }
+
+    /// Move the deleter of everything retired before the oldest epoch any
+    /// thread is still reading in into @a expired, for the caller to run
+    /// after releasing the mutex. Must be called with the mutex held.
+    void CollectLocked(std::vector<std::function<void()>> &expired) {
+      auto safe_epoch = _global_epoch.load(std::memory_order_acquire);
+      for (auto &slot : _slots) {
+        const auto epoch = slot->epoch.load(std::memory_order_seq_cst);
+        if ((epoch != QUIESCENT) && (epoch < safe_epoch)) {
+          safe_epoch = epoch;
+        }
+      }
+      auto it = _retired.begin();
+      while (it != _retired.end()) {
+        if (it->epoch < safe_epoch) {
+          expired.push_back(std::move(it->deleter));
+          it = _retired.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    std::mutex _mutex;
+
+    /// Starts past QUIESCENT so a pinned epoch is never mistaken for idle.
+    std::atomic<uint64_t> _global_epoch{1u};
+
+    /// Slots are never removed; a finished thread simply stays quiescent.
+    std::vector<std::unique_ptr<ThreadSlot>> _slots;
+
+    std::vector<RetiredItem> _retired;
+  };
+
+} // namespace carla
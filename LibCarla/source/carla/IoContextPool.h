@@ -0,0 +1,81 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace carla {
+
+  /// A pool of independent io contexts, each served by its own threads.
+  /// Distributing connections across contexts removes the contention on a
+  /// single io context's queue when many sessions are active.
+  class IoContextPool : private NonCopyable {
+  public:
+
+    explicit IoContextPool(size_t num_contexts)
+      : _contexts(num_contexts) {
+      DEBUG_ASSERT(num_contexts > 0u);
+      for (auto &context : _contexts) {
+        context.work = std::make_unique<boost::asio::io_context::work>(context.io_context);
+      }
+    }
+
+    ~IoContextPool() {
+      Stop();
+    }
+
+    /// Returns the next io context in round-robin order.
+    boost::asio::io_context &NextContext() {
+      return _contexts[_next++ % _contexts.size()].io_context;
+    }
+
+    size_t size() const {
+      return _contexts.size();
+    }
+
+    /// Launch @a threads_per_context threads for each io context.
+    void AsyncRun(size_t threads_per_context = 1u) {
+      for (auto &context : _contexts) {
+        auto *io_context = &context.io_context;
+        _workers.CreateThreads(threads_per_context, [io_context]() {
+          io_context->run();
+        });
+      }
+    }
+
+    /// Stop every io context and join all the threads.
+    void Stop() {
+      for (auto &context : _contexts) {
+        context.work.reset();
+        context.io_context.stop();
+      }
+      _workers.JoinAll();
+    }
+
+  private:
+
+    struct Context {
+      boost::asio::io_context io_context;
+      std::unique_ptr<boost::asio::io_context::work> work;
+    };
+
+    std::vector<Context> _contexts;
+
+    std::atomic_size_t _next{0u};
+
+    ThreadGroup _workers;
+  };
+
+} // namespace carla
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "carla/ListView.h"
+
 #include <boost/iterator/transform_iterator.hpp>
 
 namespace carla {
@@ -47,5 +49,24 @@ namespace iterator {
     return boost::make_transform_iterator(it, [](const auto &pair) -> const_ref_to_second { return pair.second; });
   }
 
+  /// Creates a sized view over const references to the keys of a map; the
+  /// size comes from the map itself, map iterators cannot provide it in O(1).
+  template <typename Map>
+  inline static auto make_map_keys_const_view(const Map &map) {
+    return MakeListView(
+        make_map_keys_const_iterator(map.begin()),
+        make_map_keys_const_iterator(map.end()),
+        map.size());
+  }
+
+  /// Creates a sized view over const references to the values of a map.
+  template <typename Map>
+  inline static auto make_map_values_const_view(const Map &map) {
+    return MakeListView(
+        make_map_values_const_iterator(map.begin()),
+        make_map_values_const_iterator(map.end()),
+        map.size());
+  }
+
 } // namespace iterator
 } // namespace carla
@@ -28,10 +28,19 @@ namespace carla {
     using reference = typename std::iterator_traits<iterator>::reference;
 
     explicit ListView(iterator begin, iterator end)
-      : _begin(begin), _end(end) {
+      : _begin(begin),
+        _end(end),
+        _size(static_cast<size_type>(std::distance(begin, end))) {
       DEBUG_ASSERT(std::distance(_begin, _end) >= 0);
     }
 
+    /// Same, with the element count supplied by a caller that already knows
+    /// it; spares walking the range when the iterators are not random access.
+    explicit ListView(iterator begin, iterator end, size_type size)
+      : _begin(begin), _end(end), _size(size) {
+      DEBUG_ASSERT(std::distance(_begin, _end) == static_cast<difference_type>(size));
+    }
+
     ListView(const ListView &) = default;
     ListView &operator=(const ListView &) = delete;
 
@@ -64,7 +73,15 @@ namespace carla {
     }
 
     size_type size() const {
-      return static_cast<size_t>(std::distance(begin(), end()));
+      return _size;
+    }
+
+    /// Append the elements of the view to @a container, reserving the exact
+    /// final size up front instead of growing element by element.
+    template <typename Container>
+    void AppendTo(Container &container) const {
+      container.reserve(container.size() + size());
+      container.insert(container.end(), begin(), end());
     }
 
   private:
@@ -72,6 +89,8 @@ namespace carla {
     const iterator _begin;
 
     const iterator _end;
+
+    const size_type _size;
   };
 
   template <typename Iterator>
@@ -79,6 +98,11 @@ namespace carla {
     return ListView<Iterator>(begin, end);
   }
 
+  template <typename Iterator>
+  static inline auto MakeListView(Iterator begin, Iterator end, size_t size) {
+    return ListView<Iterator>(begin, end, size);
+  }
+
   template <typename Container>
   static inline auto MakeListView(Container &c) {
     return MakeListView(std::begin(c), std::end(c));
@@ -40,6 +40,8 @@
 // -- Implementation of log functions ------------------------------------------
 // =============================================================================
 
+#include "carla/DeferredLog.h"
+
 #include <iostream>
 
 namespace carla {
@@ -66,7 +68,9 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_debug(Args && ... args) {
-    logging::write_to_stream(std::cout, "DEBUG:", std::forward<Args>(args) ..., '\n');
+    if (!logging::DeferredLog::TryLog(logging::Level::debug, args ...)) {
+      logging::write_to_stream(std::cout, "DEBUG:", std::forward<Args>(args) ..., '\n');
+    }
   }
 
 #else
@@ -80,7 +84,9 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_info(Args && ... args) {
-    logging::write_to_stream(std::cout, "INFO: ", std::forward<Args>(args) ..., '\n');
+    if (!logging::DeferredLog::TryLog(logging::Level::info, args ...)) {
+      logging::write_to_stream(std::cout, "INFO: ", std::forward<Args>(args) ..., '\n');
+    }
   }
 
 #else
@@ -94,7 +100,9 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_warning(Args && ... args) {
-    logging::write_to_stream(std::cerr, "WARNING:", std::forward<Args>(args) ..., '\n');
+    if (!logging::DeferredLog::TryLog(logging::Level::warning, args ...)) {
+      logging::write_to_stream(std::cerr, "WARNING:", std::forward<Args>(args) ..., '\n');
+    }
   }
 
 #else
@@ -108,7 +116,9 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_error(Args && ... args) {
-    logging::write_to_stream(std::cerr, "ERROR:", std::forward<Args>(args) ..., '\n');
+    if (!logging::DeferredLog::TryLog(logging::Level::error, args ...)) {
+      logging::write_to_stream(std::cerr, "ERROR:", std::forward<Args>(args) ..., '\n');
+    }
   }
 
 #else
@@ -122,7 +132,9 @@ namespace logging {
 
   template <typename ... Args>
   static inline void log_critical(Args && ... args) {
-    logging::write_to_stream(std::cerr, "CRITICAL:", std::forward<Args>(args) ..., '\n');
+    if (!logging::DeferredLog::TryLog(logging::Level::critical, args ...)) {
+      logging::write_to_stream(std::cerr, "CRITICAL:", std::forward<Args>(args) ..., '\n');
+    }
   }
 
 #else
@@ -149,3 +161,27 @@ namespace logging {
 #else
 #  define LOG_INFO_ONLY(code)
 #endif
+
+// Level-checked variants: the arguments are guaranteed not to be evaluated
+// unless the level is active at compile time and at run time
+// (DeferredLog::SetMinimumLevel), so argument construction can never cost
+// anything on a disabled level.
+
+#define LIBCARLA_LOG_CHECKED(level_, func_, ...)                            \
+    do {                                                                    \
+      if (::carla::logging::DeferredLog::IsLevelEnabled(level_)) {          \
+        ::carla::func_(__VA_ARGS__);                                        \
+      }                                                                     \
+    } while (false)
+
+#define LIBCARLA_LOG_DEBUG(...) \
+    LOG_DEBUG_ONLY(LIBCARLA_LOG_CHECKED(::carla::logging::Level::debug, log_debug, __VA_ARGS__);)
+
+#define LIBCARLA_LOG_INFO(...) \
+    LOG_INFO_ONLY(LIBCARLA_LOG_CHECKED(::carla::logging::Level::info, log_info, __VA_ARGS__);)
+
+#define LIBCARLA_LOG_WARNING(...) \
+    LIBCARLA_LOG_CHECKED(::carla::logging::Level::warning, log_warning, __VA_ARGS__)
+
+#define LIBCARLA_LOG_ERROR(...) \
+    LIBCARLA_LOG_CHECKED(::carla::logging::Level::error, log_error, __VA_ARGS__)
@@ -0,0 +1,126 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Exception.h"
+#include "carla/MsgPack.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace carla {
+namespace msgpack_bin {
+
+  /// Helpers behind CARLA_MSGPACK_VECTOR_AS_BIN. The generic msgpack vector
+  /// adaptor walks the elements one by one; for flat element types a vector
+  /// goes out instead as a two element array of [element size, bin blob],
+  /// one memcpy each way. The element size doubles as a layout check when
+  /// converting back.
+  ///
+  /// @warning This changes the wire format of the vector, both ends must see
+  /// the same CARLA_MSGPACK_VECTOR_AS_BIN declaration; invoke the macro in
+  /// the header defining the element type. Bytes go out in host order, same
+  /// as every other binary blob we move around.
+
+  template <typename T>
+  static constexpr bool IsBinCompatible() {
+    // Not is_trivially_copyable, which std::pair fails on its user-provided
+    // assignment despite being memcpy-safe for flat members.
+    return std::is_standard_layout<T>::value && std::is_trivially_destructible<T>::value;
+  }
+
+  template <typename Stream, typename T>
+  static void Pack(clmdep_msgpack::packer<Stream> &packer, const std::vector<T> &v) {
+    static_assert(IsBinCompatible<T>(), "element type cannot be packed as bin");
+    const uint32_t byte_size = static_cast<uint32_t>(v.size() * sizeof(T));
+    packer.pack_array(2u);
+    packer.pack(static_cast<uint32_t>(sizeof(T)));
+    packer.pack_bin(byte_size);
+    packer.pack_bin_body(reinterpret_cast<const char *>(v.data()), byte_size);
+  }
+
+  template <typename T>
+  static void Convert(const clmdep_msgpack::object &o, std::vector<T> &v) {
+    static_assert(IsBinCompatible<T>(), "element type cannot be packed as bin");
+    namespace mp = ::clmdep_msgpack;
+    if ((o.type != mp::type::ARRAY) || (o.via.array.size != 2u)) {
+      ::carla::throw_exception(mp::type_error());
+    }
+    const auto &bin = o.via.array.ptr[1u];
+    if ((o.via.array.ptr[0u].as<uint32_t>() != sizeof(T)) ||
+        (bin.type != mp::type::BIN) ||
+        (bin.via.bin.size % sizeof(T) != 0u)) {
+      ::carla::throw_exception(mp::type_error());
+    }
+    v.resize(bin.via.bin.size / sizeof(T));
+    if (bin.via.bin.size > 0u) {
+      std::memcpy(v.data(), bin.via.bin.ptr, bin.via.bin.size);
+    }
+  }
+
+  template <typename T>
+  static void ObjectWithZone(clmdep_msgpack::object::with_zone &o, const std::vector<T> &v) {
+    static_assert(IsBinCompatible<T>(), "element type cannot be packed as bin");
+    namespace mp = ::clmdep_msgpack;
+    o.type = mp::type::ARRAY;
+    o.via.array.size = 2u;
+    o.via.array.ptr = static_cast<mp::object *>(o.zone.allocate_align(
+        sizeof(mp::object) * o.via.array.size,
+        MSGPACK_ZONE_ALIGNOF(mp::object)));
+    o.via.array.ptr[0u] = mp::object(static_cast<uint32_t>(sizeof(T)), o.zone);
+    const uint32_t byte_size = static_cast<uint32_t>(v.size() * sizeof(T));
+    char *data = nullptr;
+    if (byte_size > 0u) {
+      data = static_cast<char *>(o.zone.allocate_align(byte_size, MSGPACK_ZONE_ALIGNOF(T)));
+      std::memcpy(data, v.data(), byte_size);
+    }
+    o.via.array.ptr[1u].type = mp::type::BIN;
+    o.via.array.ptr[1u].via.bin.ptr = data;
+    o.via.array.ptr[1u].via.bin.size = byte_size;
+  }
+
+} // namespace msgpack_bin
+} // namespace carla
+
+/// Serialize std::vector of the given element type as one binary blob
+/// instead of element by element. Invoke at global scope in the header that
+/// defines the element type, so every translation unit serializing the
+/// vector agrees on the format. The argument is variadic only to let commas
+/// through, e.g. pair element types.
+#define CARLA_MSGPACK_VECTOR_AS_BIN(...) \
+  namespace clmdep_msgpack { \
+  MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) { \
+  namespace adaptor { \
+    template <> \
+    struct pack<std::vector<__VA_ARGS__>> { \
+      template <typename Stream> \
+      packer<Stream> &operator()(packer<Stream> &o, const std::vector<__VA_ARGS__> &v) const { \
+        ::carla::msgpack_bin::Pack(o, v); \
+        return o; \
+      } \
+    }; \
+    template <> \
+    struct convert<std::vector<__VA_ARGS__>> { \
+      const clmdep_msgpack::object &operator()( \
+          const clmdep_msgpack::object &o, \
+          std::vector<__VA_ARGS__> &v) const { \
+        ::carla::msgpack_bin::Convert(o, v); \
+        return o; \
+      } \
+    }; \
+    template <> \
+    struct object_with_zone<std::vector<__VA_ARGS__>> { \
+      void operator()( \
+          clmdep_msgpack::object::with_zone &o, \
+          const std::vector<__VA_ARGS__> &v) const { \
+        ::carla::msgpack_bin::ObjectWithZone(o, v); \
+      } \
+    }; \
+  } \
+  } \
+  }
@@ -8,14 +8,19 @@
 
 #include "carla/Exception.h"
 #include "carla/Time.h"
+#include "carla/profiler/Profiler.h"
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <exception>
 #include <map>
 #include <mutex>
+#include <thread>
 
 namespace carla {
 
@@ -31,6 +36,11 @@ namespace detail {
 
   /// This class is meant to be used similar to a shared future, but the value
   /// can be set any number of times.
+  ///
+  /// Waiters spin briefly on a per-thread flag before parking on the
+  /// condition variable; in the common lockstep case (one waiter, value set
+  /// within the spin window) the wake-up avoids the scheduler entirely. The
+  /// spin budget adapts per waiter to how often spinning actually succeeds.
   template <typename T>
   class RecurrentSharedFuture {
   public:
@@ -57,12 +67,19 @@ namespace detail {
 
   private:
 
+    /// Upper bound for the adaptive spin phase, in spin iterations.
+    static constexpr uint32_t MAX_SPIN_ITERATIONS = 16u * 1024u;
+
     std::mutex _mutex;
 
     std::condition_variable _cv;
 
     struct mapped_type {
-      bool should_wait;
+      /// Written under the mutex, but also polled lock-free by the spin
+      /// phase of its owning thread.
+      std::atomic<bool> should_wait{false};
+      /// Only touched by the owning waiter thread.
+      uint32_t spin_iterations = 1024u;
       boost::variant<SharedException, T> value;
     };
 
@@ -103,10 +120,33 @@ namespace detail {
 
   template <typename T>
   boost::optional<T> RecurrentSharedFuture<T>::WaitFor(time_duration timeout) {
+    CARLA_PROFILE_SCOPE(RecurrentSharedFuture, WaitFor);
     std::unique_lock<std::mutex> lock(_mutex);
     auto &r = _map[&detail::thread_tag];
-    r.should_wait = true;
-    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() { return !r.should_wait; })) {
+    r.should_wait.store(true, std::memory_order_relaxed);
+    lock.unlock();
+
+    // Spin before parking; map nodes are stable so the entry can be polled
+    // without the lock.
+    bool ready = false;
+    for (uint32_t i = 0u; i < r.spin_iterations; ++i) {
+      if (!r.should_wait.load(std::memory_order_acquire)) {
+        ready = true;
+        break;
+      }
+      if (i >= 1024u) {
+        std::this_thread::yield();
+      }
+    }
+    // Grow the budget while spinning pays off, shrink it when we block.
+    r.spin_iterations = ready
+        ? std::min(2u * r.spin_iterations, MAX_SPIN_ITERATIONS)
+        : std::max(r.spin_iterations / 2u, 64u);
+
+    lock.lock();
+    if (!_cv.wait_for(lock, timeout.to_chrono(), [&]() {
+          return !r.should_wait.load(std::memory_order_relaxed);
+        })) {
       return {};
     }
     if (r.value.which() == 0) {
@@ -120,8 +160,8 @@ namespace detail {
   void RecurrentSharedFuture<T>::SetValue(const T2 &value) {
     std::lock_guard<std::mutex> lock(_mutex);
     for (auto &pair : _map) {
-      pair.second.should_wait = false;
       pair.second.value = value;
+      pair.second.should_wait.store(false, std::memory_order_release);
     }
     _cv.notify_all();
   }
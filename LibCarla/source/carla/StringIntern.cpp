@@ -0,0 +1,67 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/StringIntern.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace carla {
+
+namespace {
+
+  /// The table itself: a deque keeps the stored strings at stable
+  /// addresses, so Get can hand out references without holding the lock.
+  struct InternTable {
+
+    InternTable() {
+      strings.emplace_back();
+      ids.emplace(std::string(), 0u);
+    }
+
+    uint32_t Intern(const std::string &text) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = ids.find(text);
+      if (it != ids.end()) {
+        return it->second;
+      }
+      const uint32_t id = static_cast<uint32_t>(strings.size());
+      strings.push_back(text);
+      ids.emplace(text, id);
+      return id;
+    }
+
+    const std::string &Lookup(uint32_t id) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return strings[id];
+    }
+
+    std::mutex mutex;
+
+    std::deque<std::string> strings;
+
+    std::unordered_map<std::string, uint32_t> ids;
+  };
+
+  static InternTable &GetTable() {
+    static InternTable table;
+    return table;
+  }
+
+} // namespace
+
+  InternedString::InternedString(const std::string &text)
+    : _id(GetTable().Intern(text)) {}
+
+  InternedString::InternedString(const char *text)
+    : InternedString(std::string(text)) {}
+
+  const std::string &InternedString::Get() const {
+    return GetTable().Lookup(_id);
+  }
+
+} // namespace carla
@@ -0,0 +1,58 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace carla {
+
+  /// Handle into a process-wide string interning table. Equal strings
+  /// intern to the same small integer id, so equality is an integer
+  /// compare and the character data is stored once no matter how many
+  /// actor definitions repeat it. Interned strings are never released;
+  /// the table is meant for low-cardinality identifiers like actor type
+  /// ids and tags, not for arbitrary payloads.
+  class InternedString {
+  public:
+
+    /// The default handle is the interned empty string.
+    InternedString() = default;
+
+    InternedString(const std::string &text);
+
+    InternedString(const char *text);
+
+    uint32_t GetId() const {
+      return _id;
+    }
+
+    /// Reference into the table; stable for the lifetime of the process.
+    const std::string &Get() const;
+
+    operator const std::string &() const {
+      return Get();
+    }
+
+    const char *c_str() const {
+      return Get().c_str();
+    }
+
+    bool operator==(const InternedString &rhs) const {
+      return _id == rhs._id;
+    }
+
+    bool operator!=(const InternedString &rhs) const {
+      return _id != rhs._id;
+    }
+
+  private:
+
+    uint32_t _id = 0u;
+  };
+
+} // namespace carla
@@ -22,4 +22,110 @@ namespace carla {
 #endif // _WIN32
   }
 
+  GlobPattern::GlobPattern(const std::string &pattern) {
+    _tokens.reserve(pattern.size());
+    for (size_t i = 0u; i < pattern.size(); ++i) {
+      Token token;
+      const char character = pattern[i];
+      if (character == '*') {
+        // Collapse runs of stars, they match the same inputs.
+        if (!_tokens.empty() && (_tokens.back().kind == Token::any_many)) {
+          continue;
+        }
+        token.kind = Token::any_many;
+      } else if (character == '?') {
+        token.kind = Token::any_one;
+      } else if ((character == '[') && (i + 1u < pattern.size())) {
+        token.kind = Token::char_class;
+        size_t j = i + 1u;
+        if (pattern[j] == '!') {
+          token.negated = true;
+          ++j;
+        }
+        token.class_begin = static_cast<uint32_t>(_class_characters.size());
+        // A ']' right after the opening is a literal member of the set.
+        for (size_t k = j; k < pattern.size(); ++k) {
+          if ((pattern[k] == ']') && (k > j)) {
+            i = k;
+            break;
+          }
+          if ((pattern[k] == '-') && (k > j) && (k + 1u < pattern.size()) && (pattern[k + 1u] != ']')) {
+            for (int c = pattern[k - 1u] + 1; c <= pattern[k + 1u]; ++c) {
+              _class_characters.push_back(static_cast<char>(c));
+            }
+            ++k;
+            continue;
+          }
+          _class_characters.push_back(pattern[k]);
+        }
+        if (i < j) {
+          // No closing bracket, treat the '[' as a literal.
+          _class_characters.resize(token.class_begin);
+          token = Token();
+          token.character = character;
+        } else {
+          token.class_end = static_cast<uint32_t>(_class_characters.size());
+        }
+      } else {
+        if ((character == '\\') && (i + 1u < pattern.size())) {
+          ++i;
+          token.character = pattern[i];
+        } else {
+          token.character = character;
+        }
+      }
+      _tokens.push_back(token);
+    }
+  }
+
+  bool GlobPattern::MatchesOne(const Token &token, char character) const {
+    switch (token.kind) {
+      case Token::literal:
+        return token.character == character;
+      case Token::any_one:
+        return true;
+      case Token::char_class: {
+        bool found = false;
+        for (uint32_t i = token.class_begin; i < token.class_end; ++i) {
+          if (_class_characters[i] == character) {
+            found = true;
+            break;
+          }
+        }
+        return found != token.negated;
+      }
+      default:
+        return false;
+    }
+  }
+
+  bool GlobPattern::Match(const std::string &str) const {
+    size_t token_index = 0u;
+    size_t str_index = 0u;
+    size_t star_token = std::string::npos;
+    size_t star_str = 0u;
+    while (str_index < str.size()) {
+      if ((token_index < _tokens.size()) &&
+          (_tokens[token_index].kind == Token::any_many)) {
+        star_token = token_index++;
+        star_str = str_index;
+      } else if ((token_index < _tokens.size()) &&
+                 MatchesOne(_tokens[token_index], str[str_index])) {
+        ++token_index;
+        ++str_index;
+      } else if (star_token != std::string::npos) {
+        // Backtrack: let the last star swallow one more character.
+        token_index = star_token + 1u;
+        str_index = ++star_str;
+      } else {
+        return false;
+      }
+    }
+    while ((token_index < _tokens.size()) &&
+           (_tokens[token_index].kind == Token::any_many)) {
+      ++token_index;
+    }
+    return token_index == _tokens.size();
+  }
+
 } // namespace carla
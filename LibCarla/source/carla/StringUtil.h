@@ -8,6 +8,9 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <string>
+#include <vector>
+
 namespace carla {
 
   class StringUtil {
@@ -77,4 +80,47 @@ namespace carla {
     }
   };
 
+  /// A Unix shell-style wildcard pattern parsed once and matched many
+  /// times. Supports the same '*', '?', '[set]' and '[!set]' syntax as
+  /// StringUtil::Match without re-parsing the pattern on every candidate,
+  /// which is what makes filtering hundreds of blueprint definitions
+  /// cheap.
+  class GlobPattern {
+  public:
+
+    explicit GlobPattern(const std::string &pattern);
+
+    bool Match(const std::string &str) const;
+
+  private:
+
+    struct Token {
+
+      enum Kind : uint8_t {
+        literal,
+        any_one,
+        any_many,
+        char_class
+      };
+
+      Kind kind = literal;
+
+      char character = '\0';
+
+      /// Range into _class_characters for char_class tokens.
+      uint32_t class_begin = 0u;
+
+      uint32_t class_end = 0u;
+
+      bool negated = false;
+    };
+
+    bool MatchesOne(const Token &token, char character) const;
+
+    std::vector<Token> _tokens;
+
+    /// Character classes expanded at parse time, shared by all tokens.
+    std::string _class_characters;
+  };
+
 } // namespace carla
@@ -0,0 +1,194 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/ThreadGroup.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace carla {
+
+  /// A work-stealing thread pool for CPU-bound tasks.
+  ///
+  /// Each worker owns a deque of tasks; Post enqueues into the caller's own
+  /// queue when called from a worker, or round-robin otherwise. An idle worker
+  /// first drains its own queue, then steals half of a victim's queue, so many
+  /// small tasks spread across cores without funnelling through a single lock
+  /// the way ThreadPool's io_context does.
+  ///
+  /// Use ThreadPool when the tasks need an io_context (Boost.Asio I/O
+  /// objects); use this scheduler for plain compute such as parallel
+  /// deserialization.
+  class TaskScheduler : private NonCopyable {
+  public:
+
+    explicit TaskScheduler(size_t num_workers = std::thread::hardware_concurrency())
+      : _queues(num_workers > 0u ? num_workers : 1u) {
+      for (auto &queue : _queues) {
+        queue = std::make_unique<WorkQueue>();
+      }
+    }
+
+    /// Stops the scheduler and joins all its threads. Tasks still queued are
+    /// discarded.
+    ~TaskScheduler() {
+      Stop();
+    }
+
+    /// Post a task to the pool.
+    template <typename FunctorT, typename ResultT = typename std::result_of<FunctorT()>::type>
+    std::future<ResultT> Post(FunctorT &&functor) {
+      auto task = std::make_shared<std::packaged_task<ResultT()>>(
+          std::forward<FunctorT>(functor));
+      auto future = task->get_future();
+      Push([task]() { (*task)(); });
+      return future;
+    }
+
+    /// Launch one thread per work queue to run tasks asynchronously.
+    void AsyncRun() {
+      for (size_t i = 0u; i < _queues.size(); ++i) {
+        _workers.CreateThread([this, i]() { WorkerLoop(i); });
+      }
+    }
+
+    /// Stop the scheduler and join all its threads.
+    void Stop() {
+      {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+        _done = true;
+      }
+      _wake_up.notify_all();
+      _workers.JoinAll();
+    }
+
+  private:
+
+    using task_type = std::function<void()>;
+
+    struct WorkQueue {
+      std::mutex mutex;
+      std::deque<task_type> tasks;
+    };
+
+    void Push(task_type task) {
+      auto &queue = *_queues[SubmissionQueueIndex()];
+      {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+      }
+      _wake_up.notify_one();
+    }
+
+    /// Index of this thread's own queue, or -1 on non-worker threads.
+    static int &WorkerIndex() {
+      static thread_local int index = -1;
+      return index;
+    }
+
+    /// Workers push to their own queue, external threads round-robin.
+    size_t SubmissionQueueIndex() {
+      if (WorkerIndex() >= 0) {
+        return static_cast<size_t>(WorkerIndex());
+      }
+      return _next_queue++ % _queues.size();
+    }
+
+    bool TryPop(size_t index, task_type &task) {
+      auto &queue = *_queues[index];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) {
+        return false;
+      }
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+
+    /// Steal half of the victim's queue into the thief's, and return one of
+    /// the stolen tasks.
+    bool TrySteal(size_t thief, size_t victim, task_type &task) {
+      auto &from = *_queues[victim];
+      std::deque<task_type> stolen;
+      {
+        std::lock_guard<std::mutex> lock(from.mutex);
+        const auto count = (from.tasks.size() + 1u) / 2u;
+        if (count == 0u) {
+          return false;
+        }
+        for (size_t i = 0u; i < count; ++i) {
+          stolen.emplace_back(std::move(from.tasks.back()));
+          from.tasks.pop_back();
+        }
+      }
+      task = std::move(stolen.front());
+      stolen.pop_front();
+      if (!stolen.empty()) {
+        auto &to = *_queues[thief];
+        std::lock_guard<std::mutex> lock(to.mutex);
+        for (auto &item : stolen) {
+          to.tasks.emplace_back(std::move(item));
+        }
+      }
+      return true;
+    }
+
+    bool FindTask(size_t index, task_type &task) {
+      if (TryPop(index, task)) {
+        return true;
+      }
+      for (size_t i = 1u; i < _queues.size(); ++i) {
+        const auto victim = (index + i) % _queues.size();
+        if (TrySteal(index, victim, task)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void WorkerLoop(size_t index) {
+      WorkerIndex() = static_cast<int>(index);
+      task_type task;
+      while (true) {
+        if (FindTask(index, task)) {
+          task();
+          task = nullptr;
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        if (_done) {
+          break;
+        }
+        _wake_up.wait_for(lock, std::chrono::milliseconds(1));
+      }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+
+    ThreadGroup _workers;
+
+    std::atomic_size_t _next_queue{0u};
+
+    std::mutex _sleep_mutex;
+
+    std::condition_variable _wake_up;
+
+    bool _done = false;
+  };
+
+} // namespace carla
@@ -0,0 +1,116 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/ThreadConfig.h"
+
+#include "carla/Logging.h"
+#include "carla/StringUtil.h"
+
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace carla {
+
+  /// Parse a core list of the form "0,2,4-7".
+  static std::vector<uint32_t> ParseCpuList(const std::string &text) {
+    std::vector<uint32_t> cpus;
+    std::vector<std::string> ranges;
+    StringUtil::Split(ranges, text, ",");
+    for (auto &range : ranges) {
+      const auto dash = range.find('-');
+      try {
+        if (dash == std::string::npos) {
+          cpus.push_back(static_cast<uint32_t>(std::stoul(range)));
+        } else {
+          const auto first = std::stoul(range.substr(0u, dash));
+          const auto last = std::stoul(range.substr(dash + 1u));
+          for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+          }
+        }
+      } catch (const std::exception &) {
+        log_warning("thread config: invalid cpu list entry:", range);
+      }
+    }
+    return cpus;
+  }
+
+  static ThreadConfig::Priority ParsePriority(const std::string &text) {
+    if (text == "low") {
+      return ThreadConfig::Priority::Low;
+    } else if (text == "normal") {
+      return ThreadConfig::Priority::Normal;
+    } else if (text == "high") {
+      return ThreadConfig::Priority::High;
+    }
+    log_warning("thread config: invalid priority:", text);
+    return ThreadConfig::Priority::Inherit;
+  }
+
+  static ThreadConfig MakeDefaultFromEnvironment() {
+    ThreadConfig config;
+    if (const char *cpus = std::getenv("CARLA_WORKER_CPUS")) {
+      config.cpus = ParseCpuList(cpus);
+    }
+    if (const char *priority = std::getenv("CARLA_WORKER_PRIORITY")) {
+      config.priority = ParsePriority(priority);
+    }
+    return config;
+  }
+
+  ThreadConfig &ThreadConfig::ProcessDefault() {
+    static ThreadConfig config = MakeDefaultFromEnvironment();
+    return config;
+  }
+
+  void ThreadConfig::ApplyToCurrentThread() const {
+#ifndef _WIN32
+    if (!name.empty()) {
+#ifdef __APPLE__
+      pthread_setname_np(name.substr(0u, 15u).c_str());
+#else
+      pthread_setname_np(pthread_self(), name.substr(0u, 15u).c_str());
+#endif
+    }
+#endif
+#ifdef __linux__
+    if (!cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (auto cpu : cpus) {
+        CPU_SET(cpu, &set);
+      }
+      if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        log_warning("thread config: failed to set affinity of", name);
+      }
+    }
+    if (priority == Priority::High) {
+      sched_param param;
+      param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+      if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        log_warning("thread config: failed to raise priority of", name,
+            "(missing CAP_SYS_NICE?)");
+      }
+    } else if (priority != Priority::Inherit) {
+      const int nice_value = (priority == Priority::Low) ? 10 : 0;
+      const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+      if (setpriority(PRIO_PROCESS, tid, nice_value) != 0) {
+        log_warning("thread config: failed to set priority of", name);
+      }
+    }
+#endif // __linux__
+  }
+
+} // namespace carla
@@ -0,0 +1,50 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+
+  /// Name, CPU affinity and scheduling priority for a LibCarla worker
+  /// thread, so streaming, RPC and traffic manager threads can be kept off
+  /// the cores running the simulator's render thread.
+  ///
+  /// Process-wide defaults can be set programmatically through
+  /// ProcessDefault, or from the environment: CARLA_WORKER_CPUS accepts a
+  /// core list ("0,2,4-7"), CARLA_WORKER_PRIORITY accepts "low", "normal" or
+  /// "high". Affinity and priority are applied best-effort; failures (e.g.
+  /// raising priority without the needed capability) are logged and ignored.
+  struct ThreadConfig {
+
+    enum class Priority : uint8_t {
+      Inherit, ///< Leave the thread as created.
+      Low,     ///< Background work, nice +10.
+      Normal,  ///< Default scheduling, nice 0.
+      High     ///< Real-time FIFO scheduling, if permitted.
+    };
+
+    /// Thread name as shown by debuggers and top; truncated by the OS
+    /// (15 characters on Linux). Empty leaves the name unset.
+    std::string name;
+
+    /// Cores this thread may run on; empty means no affinity change.
+    std::vector<uint32_t> cpus;
+
+    Priority priority = Priority::Inherit;
+
+    /// Apply this configuration to the calling thread.
+    void ApplyToCurrentThread() const;
+
+    /// Defaults applied by ThreadPool and the traffic manager worker;
+    /// initialized once from the environment, mutable before threads launch.
+    static ThreadConfig &ProcessDefault();
+  };
+
+} // namespace carla
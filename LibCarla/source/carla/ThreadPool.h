@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include "carla/Logging.h"
 #include "carla/MoveHandler.h"
 #include "carla/NonCopyable.h"
+#include "carla/ThreadConfig.h"
 #include "carla/ThreadGroup.h"
 #include "carla/Time.h"
 
@@ -47,9 +49,21 @@ namespace carla {
 
     /// Launch threads to run tasks asynchronously. Launch specific number of
     /// threads if @a worker_threads is provided, otherwise use all available
-    /// hardware concurrency.
+    /// hardware concurrency. Threads are named, pinned and prioritized
+    /// according to @a config; by default the process-wide ThreadConfig.
+    void AsyncRun(size_t worker_threads, ThreadConfig config) {
+      if (config.name.empty()) {
+        config.name = "carla-worker";
+      }
+      _workers.CreateThreads(worker_threads, [this, config]() {
+        config.ApplyToCurrentThread();
+        Run();
+      });
+    }
+
+    /// @copydoc AsyncRun(size_t, ThreadConfig)
     void AsyncRun(size_t worker_threads) {
-      _workers.CreateThreads(worker_threads, [this]() { Run(); });
+      AsyncRun(worker_threads, ThreadConfig::ProcessDefault());
     }
 
     /// @copydoc AsyncRun(size_t)
@@ -59,9 +73,20 @@ namespace carla {
 
     /// Run tasks in this thread.
     ///
+    /// A task that throws is logged and dropped and the loop resumes; an
+    /// exception escaping a pool thread would otherwise terminate the
+    /// process.
+    ///
     /// @warning This function blocks until the ThreadPool has been stopped.
     void Run() {
-      _io_context.run();
+      while (!_io_context.stopped()) {
+        try {
+          _io_context.run();
+          return;
+        } catch (const std::exception &e) {
+          log_error("thread-pool worker: uncaught task exception:", e.what());
+        }
+      }
     }
 
     /// Run tasks in this thread for an specific @a duration.
@@ -10,6 +10,7 @@
 #include "carla/StringUtil.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -25,16 +26,25 @@ namespace client {
 
   ActorBlueprint::ActorBlueprint(rpc::ActorDefinition definition)
     : _uid(definition.uid),
-      _id(std::move(definition.id)) {
-    StringUtil::Split(_tags, definition.tags, ",");
+      _id(definition.id) {
+    std::vector<std::string> tags;
+    StringUtil::Split(tags, definition.tags, ",");
+    _tags.reserve(tags.size());
+    for (const auto &tag : tags) {
+      _tags.emplace_back(tag);
+    }
     FillMap(_attributes, definition.attributes);
   }
 
   bool ActorBlueprint::MatchTags(const std::string &wildcard_pattern) const {
+    return MatchTags(GlobPattern(wildcard_pattern));
+  }
+
+  bool ActorBlueprint::MatchTags(const GlobPattern &pattern) const {
     return
-        StringUtil::Match(_id, wildcard_pattern) ||
+        pattern.Match(_id.Get()) ||
         std::any_of(_tags.begin(), _tags.end(), [&](const auto &tag) {
-          return StringUtil::Match(tag, wildcard_pattern);
+          return pattern.Match(tag.Get());
         });
   }
 
@@ -8,15 +8,19 @@
 
 #include "carla/Debug.h"
 #include "carla/Iterator.h"
+#include "carla/StringIntern.h"
 #include "carla/client/ActorAttribute.h"
 #include "carla/rpc/ActorDefinition.h"
 #include "carla/rpc/ActorDescription.h"
 
+#include <algorithm>
 #include <exception>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace carla {
+
+  class GlobPattern;
+
 namespace client {
 
   /// Contains all the necessary information for spawning an Actor.
@@ -39,7 +43,7 @@ namespace client {
   public:
 
     const std::string &GetId() const {
-      return _id;
+      return _id.Get();
     }
 
     /// @}
@@ -51,7 +55,9 @@ namespace client {
   public:
 
     bool ContainsTag(const std::string &tag) const {
-      return _tags.find(tag) != _tags.end();
+      // Interning the probe makes every comparison an integer compare.
+      const InternedString interned(tag);
+      return std::find(_tags.begin(), _tags.end(), interned) != _tags.end();
     }
 
     /// Test if any of the flags matches @a wildcard_pattern.
@@ -59,8 +65,16 @@ namespace client {
     /// @a wildcard_pattern follows Unix shell-style wildcards.
     bool MatchTags(const std::string &wildcard_pattern) const;
 
+    /// Same, against a pattern compiled once by the caller.
+    bool MatchTags(const GlobPattern &pattern) const;
+
     std::vector<std::string> GetTags() const {
-      return {_tags.begin(), _tags.end()};
+      std::vector<std::string> result;
+      result.reserve(_tags.size());
+      for (const auto &tag : _tags) {
+        result.push_back(tag.Get());
+      }
+      return result;
     }
 
     /// @}
@@ -113,9 +127,9 @@ namespace client {
 
     uint32_t _uid = 0u;
 
-    std::string _id;
+    InternedString _id;
 
-    std::unordered_set<std::string> _tags;
+    std::vector<InternedString> _tags;
 
     std::unordered_map<std::string, ActorAttribute> _attributes;
   };
@@ -30,9 +30,13 @@ namespace client {
   }
 
   SharedPtr<ActorList> ActorList::Filter(const std::string &wildcard_pattern) const {
+    const GlobPattern pattern(wildcard_pattern);
     SharedPtr<ActorList> filtered (new ActorList(_episode, {}));
+    // Reserve for the worst case, a filtered list is short-lived and the
+    // slack beats growing through the matches.
+    filtered->_actors.reserve(_actors.size());
     for (auto &&actor : _actors) {
-      if (StringUtil::Match(actor.GetTypeId(), wildcard_pattern)) {
+      if (pattern.Match(actor.GetTypeId())) {
         filtered->_actors.push_back(actor);
       }
     }
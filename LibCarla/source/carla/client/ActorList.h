@@ -41,6 +41,19 @@ namespace client {
       return _actors.at(pos).Get(_episode);
     }
 
+    /// Return the id of the actor at @a pos without instantiating a
+    /// client-side Actor for it; use it when scanning the list and only a
+    /// few entries end up being accessed as actors.
+    ActorId GetActorId(size_t pos) const {
+      return _actors[pos].GetId();
+    }
+
+    /// Return the type id of the actor at @a pos, also without
+    /// instantiating a client-side Actor.
+    const std::string &GetActorTypeId(size_t pos) const {
+      return _actors[pos].GetTypeId();
+    }
+
     auto begin() const {
       return MakeIterator(_actors.begin());
     }
@@ -7,6 +7,7 @@
 #include "carla/client/BlueprintLibrary.h"
 
 #include "carla/Exception.h"
+#include "carla/StringUtil.h"
 
 #include <algorithm>
 #include <iterator>
@@ -24,9 +25,11 @@ namespace client {
 
   SharedPtr<BlueprintLibrary> BlueprintLibrary::Filter(
       const std::string &wildcard_pattern) const {
+    // Compile the pattern once instead of re-parsing it per definition.
+    const GlobPattern pattern(wildcard_pattern);
     map_type result;
     for (auto &pair : _blueprints) {
-      if (pair.second.MatchTags(wildcard_pattern)) {
+      if (pair.second.MatchTags(pattern)) {
         result.emplace(pair);
       }
     }
@@ -8,6 +8,7 @@
 
 #include "carla/client/detail/Simulator.h"
 #include "carla/client/World.h"
+#include "carla/profiler/Metrics.h"
 #include "carla/PythonUtil.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
@@ -50,6 +51,18 @@ namespace client {
       return _simulator->GetServerVersion();
     }
 
+    /// Aggregated client-side timing metrics (buffer copies, message
+    /// dispatch, deserialization) as CSV lines; see profiler::Metrics.
+    std::string GetClientMetrics() const {
+      return profiler::Metrics::Report();
+    }
+
+    /// Frame-budget breakdown of the simulator over its recent frames;
+    /// cheap enough to poll periodically.
+    rpc::FrameStats GetFrameStats() const {
+      return _simulator->GetFrameStats();
+    }
+
     std::vector<std::string> GetAvailableMaps() const {
       return _simulator->GetAvailableMaps();
     }
@@ -108,6 +121,10 @@ namespace client {
       return _simulator->ReplayFile(name, start, duration, follow_id);
     }
 
+    std::string ReplayBatch(std::vector<std::string> names, double time_factor) {
+      return _simulator->ReplayBatch(std::move(names), time_factor);
+    }
+
     void StopReplayer(bool keep_actors) {
       _simulator->StopReplayer(keep_actors);
     }
@@ -132,6 +149,41 @@ namespace client {
       return _simulator->ApplyBatchSync(std::move(commands), do_tick_cue);
     }
 
+    /// Submit a pre-encoded batch (see rpc::CommandBuffer). The buffer's
+    /// bytes are sent as-is, so resubmitting the same buffer does not
+    /// re-serialize the commands.
+    void ApplyBatch(
+        const rpc::CommandBuffer &commands,
+        bool do_tick_cue = false) const {
+      _simulator->ApplyBatch(commands, do_tick_cue);
+    }
+
+    /// @copydoc ApplyBatch(const rpc::CommandBuffer &, bool)
+    std::vector<rpc::CommandResponse> ApplyBatchSync(
+        const rpc::CommandBuffer &commands,
+        bool do_tick_cue = false) const {
+      return _simulator->ApplyBatchSync(commands, do_tick_cue);
+    }
+
+    /// Queue @a commands to be applied atomically at the top of
+    /// @a target_frame instead of whatever frame the RPC thread reaches.
+    ///
+    /// @return the frame the commands were (or will be) applied on; when it
+    /// differs from @a target_frame the schedule was missed and they were
+    /// applied immediately.
+    uint64_t ApplyBatchAtFrame(
+        std::vector<rpc::Command> commands,
+        uint64_t target_frame) const {
+      return _simulator->ApplyBatchAtFrame(std::move(commands), target_frame);
+    }
+
+    /// Spawn every actor in @a commands in a single round trip; the whole
+    /// batch is executed within one simulator step.
+    std::vector<rpc::CommandResponse> SpawnActors(
+        std::vector<rpc::Command::SpawnActor> commands) const {
+      return _simulator->SpawnActors(std::move(commands));
+    }
+
   private:
 
     std::shared_ptr<detail::Simulator> _simulator;
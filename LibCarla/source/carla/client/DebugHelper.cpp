@@ -81,5 +81,69 @@ namespace client {
     DrawShape(_episode, string, color, life_time, persistent_lines);
   }
 
+  void DebugHelper::Batch::DrawPoint(
+      const geom::Location &location,
+      float size,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    Shape::Point point{location, size};
+    _shapes.push_back(Shape{point, color, life_time, persistent_lines});
+  }
+
+  void DebugHelper::Batch::DrawLine(
+      const geom::Location &begin,
+      const geom::Location &end,
+      float thickness,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    Shape::Line line{begin, end, thickness};
+    _shapes.push_back(Shape{line, color, life_time, persistent_lines});
+  }
+
+  void DebugHelper::Batch::DrawArrow(
+      const geom::Location &begin,
+      const geom::Location &end,
+      float thickness,
+      float arrow_size,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    Shape::Line line{begin, end, thickness};
+    Shape::Arrow arrow{line, arrow_size};
+    _shapes.push_back(Shape{arrow, color, life_time, persistent_lines});
+  }
+
+  void DebugHelper::Batch::DrawBox(
+      const geom::BoundingBox &box,
+      const geom::Rotation &rotation,
+      float thickness,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    Shape::Box the_box{box, rotation, thickness};
+    _shapes.push_back(Shape{the_box, color, life_time, persistent_lines});
+  }
+
+  void DebugHelper::Batch::DrawString(
+      const geom::Location &location,
+      const std::string &text,
+      bool draw_shadow,
+      sensor::data::Color color,
+      float life_time,
+      bool persistent_lines) {
+    Shape::String string{location, text, draw_shadow};
+    _shapes.push_back(Shape{string, color, life_time, persistent_lines});
+  }
+
+  void DebugHelper::Batch::Flush() {
+    if (_shapes.empty()) {
+      return;
+    }
+    _episode.Lock()->DrawDebugShapes(_shapes);
+    _shapes.clear();
+  }
+
 } // namespace client
 } // namespace carla
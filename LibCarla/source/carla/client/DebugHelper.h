@@ -10,8 +10,11 @@
 #include "carla/geom/BoundingBox.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Rotation.h"
+#include "carla/rpc/DebugShape.h"
 #include "carla/sensor/data/Color.h"
 
+#include <vector>
+
 namespace carla {
 namespace client {
 
@@ -63,6 +66,81 @@ namespace client {
         float life_time = -1.0f,
         bool persistent_lines = true);
 
+    /// Accumulates shapes locally and submits them all as one command; use
+    /// it instead of the immediate Draw* calls above when drawing many
+    /// shapes per frame (e.g. a whole route overlay), which would otherwise
+    /// cost one command per shape.
+    class Batch {
+    public:
+
+      void DrawPoint(
+          const geom::Location &location,
+          float size = 0.1f,
+          Color color = Color{255u, 0u, 0u},
+          float life_time = -1.0f,
+          bool persistent_lines = true);
+
+      void DrawLine(
+          const geom::Location &begin,
+          const geom::Location &end,
+          float thickness = 0.1f,
+          Color color = Color{255u, 0u, 0u},
+          float life_time = -1.0f,
+          bool persistent_lines = true);
+
+      void DrawArrow(
+          const geom::Location &begin,
+          const geom::Location &end,
+          float thickness = 0.1f,
+          float arrow_size = 0.1f,
+          Color color = Color{255u, 0u, 0u},
+          float life_time = -1.0f,
+          bool persistent_lines = true);
+
+      void DrawBox(
+          const geom::BoundingBox &box,
+          const geom::Rotation &rotation,
+          float thickness = 0.1f,
+          Color color = Color{255u, 0u, 0u},
+          float life_time = -1.0f,
+          bool persistent_lines = true);
+
+      void DrawString(
+          const geom::Location &location,
+          const std::string &text,
+          bool draw_shadow = false,
+          Color color = Color{255u, 0u, 0u},
+          float life_time = -1.0f,
+          bool persistent_lines = true);
+
+      /// Send every accumulated shape in a single command and clear the
+      /// batch for reuse.
+      void Flush();
+
+      size_t size() const {
+        return _shapes.size();
+      }
+
+      bool empty() const {
+        return _shapes.empty();
+      }
+
+    private:
+
+      friend class DebugHelper;
+
+      explicit Batch(detail::EpisodeProxy episode)
+        : _episode(std::move(episode)) {}
+
+      detail::EpisodeProxy _episode;
+
+      std::vector<rpc::DebugShape> _shapes;
+    };
+
+    Batch MakeBatch() const {
+      return Batch{_episode};
+    }
+
   private:
 
     detail::EpisodeProxy _episode;
@@ -12,6 +12,7 @@
 #include "carla/client/detail/Simulator.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
+#include "carla/road/element/LaneCrossingCalculator.h"
 #include "carla/sensor/data/LaneInvasionEvent.h"
 
 #include <exception>
@@ -55,15 +56,23 @@ namespace client {
 
   private:
 
+    using ResolvedLocation = road::element::LaneCrossingCalculator::ResolvedLocation;
+
     struct Bounds {
       size_t frame;
       std::array<geom::Location, 4u> corners;
+      /// Filled right before the bounds are published, so the next tick
+      /// reuses these as its origin endpoints instead of resolving the
+      /// same corners against the map again.
+      std::array<ResolvedLocation, 4u> resolved;
     };
 
-    std::shared_ptr<const Bounds> MakeBounds(
+    std::shared_ptr<Bounds> MakeBounds(
         size_t frame,
         const geom::Transform &vehicle_transform) const;
 
+    void ResolveBounds(Bounds &bounds) const;
+
     ActorId _parent;
 
     geom::BoundingBox _parent_bounding_box;
@@ -86,8 +95,11 @@ namespace client {
     auto prev = _bounds.load();
 
     // First frame it'll be null.
-    if ((prev == nullptr) && _bounds.compare_exchange(&prev, next)) {
-      return;
+    if (prev == nullptr) {
+      ResolveBounds(*next);
+      if (_bounds.compare_exchange(&prev, next)) {
+        return;
+      }
     }
 
     // Make sure the distance is long enough.
@@ -98,6 +110,10 @@ namespace client {
       }
     }
 
+    // Resolve the new corners against the map only once the early-outs
+    // have passed; published bounds always carry their resolved state.
+    ResolveBounds(*next);
+
     // Make sure the current frame is up-to-date.
     do {
       if (prev->frame >= next->frame) {
@@ -105,10 +121,16 @@ namespace client {
       }
     } while (!_bounds.compare_exchange(&prev, next));
 
-    // Finally it's safe to compute the crossed lanes.
+    // Finally it's safe to compute the crossed lanes, reusing the map
+    // state resolved when the previous bounds were published.
     std::vector<road::element::LaneMarking> crossed_lanes;
     for (auto i = 0u; i < 4u; ++i) {
-      const auto lanes = _map->CalculateCrossedLanes(prev->corners[i], next->corners[i]);
+      const auto lanes = road::element::LaneCrossingCalculator::Calculate(
+          _map->GetMap(),
+          prev->resolved[i],
+          prev->corners[i],
+          next->resolved[i],
+          next->corners[i]);
       crossed_lanes.insert(crossed_lanes.end(), lanes.begin(), lanes.end());
     }
 
@@ -122,17 +144,28 @@ namespace client {
     }
   }
 
-  std::shared_ptr<const LaneInvasionCallback::Bounds> LaneInvasionCallback::MakeBounds(
+  std::shared_ptr<LaneInvasionCallback::Bounds> LaneInvasionCallback::MakeBounds(
       const size_t frame,
       const geom::Transform &transform) const {
     const auto &box = _parent_bounding_box;
     const auto location = transform.location + box.location;
     const auto yaw = transform.rotation.yaw;
-    return std::make_shared<Bounds>(Bounds{frame, {
+    auto bounds = std::make_shared<Bounds>();
+    bounds->frame = frame;
+    bounds->corners = {
         location + Rotate(yaw, geom::Location( box.extent.x,  box.extent.y, 0.0f)),
         location + Rotate(yaw, geom::Location(-box.extent.x,  box.extent.y, 0.0f)),
         location + Rotate(yaw, geom::Location( box.extent.x, -box.extent.y, 0.0f)),
-        location + Rotate(yaw, geom::Location(-box.extent.x, -box.extent.y, 0.0f))}});
+        location + Rotate(yaw, geom::Location(-box.extent.x, -box.extent.y, 0.0f))};
+    return bounds;
+  }
+
+  void LaneInvasionCallback::ResolveBounds(Bounds &bounds) const {
+    for (auto i = 0u; i < bounds.corners.size(); ++i) {
+      bounds.resolved[i] = road::element::LaneCrossingCalculator::Resolve(
+          _map->GetMap(),
+          bounds.corners[i]);
+    }
   }
 
   // ===========================================================================
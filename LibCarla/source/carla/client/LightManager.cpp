@@ -288,35 +288,51 @@ void LightManager::QueryLightsStateToServer() {
 }
 
 void LightManager::UpdateServerLightsState(bool discard_client) {
+  // Polled every tick; skip the mutex and the round trip entirely on the
+  // common no-change tick.
+  if(!_dirty && !discard_client) {
+    return;
+  }
+
+  auto episode = _episode.TryLock();
+  if(episode == nullptr) {
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(_mutex);
 
-  if(_dirty) {
-    std::vector<rpc::LightState> message;
-    for(auto it : _lights_changes) {
-      auto it_light = _lights.find(it.first);
-      if(it_light != _lights.end()) {
-        rpc::LightState state(
-          it_light->second.GetLocation(),
-          it.second._intensity,
-          it.second._group,
-          rpc::Color(it.second._color.r, it.second._color.g, it.second._color.b),
-          it.second._active
-        );
-        state._id = it.first;
-        // Add to command
-        message.push_back(state);
-      }
+  std::vector<rpc::LightState> message;
+  for(auto it : _lights_changes) {
+    auto it_light = _lights.find(it.first);
+    if(it_light != _lights.end()) {
+      rpc::LightState state(
+        it_light->second.GetLocation(),
+        it.second._intensity,
+        it.second._group,
+        rpc::Color(it.second._color.r, it.second._color.g, it.second._color.b),
+        it.second._active
+      );
+      state._id = it.first;
+      // Add to command
+      message.push_back(state);
     }
-    _episode.Lock()->UpdateServerLightsState(message, discard_client);
-
-    _lights_changes.clear();
-    _dirty = false;
   }
+  // An empty message is still sent when discarding, so the server drops
+  // this client from its version bookkeeping.
+  episode->UpdateServerLightsState(message, discard_client);
+
+  _lights_changes.clear();
+  _dirty = false;
 }
 
 void LightManager::ApplyChanges() {
-  std::lock_guard<std::mutex> lock(_mutex);
-  for(const auto& it : _lights_changes) {
+  // Copy the pending changes first, SetLightState takes the mutex itself.
+  std::unordered_map<LightId, LightState> changes;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    changes = _lights_changes;
+  }
+  for(const auto& it : changes) {
     SetLightState(it.first, it.second);
   }
 }
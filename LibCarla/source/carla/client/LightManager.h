@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
@@ -40,7 +41,7 @@ public:
     _episode = other._episode;
     _on_tick_register_id = other._on_tick_register_id;
     _on_light_update_register_id = other._on_light_update_register_id;
-    _dirty = other._dirty;
+    _dirty = other._dirty.load();
   }
 
   void SetEpisode(detail::EpisodeProxy episode);
@@ -103,7 +104,10 @@ private:
   LightState _state;
   size_t _on_tick_register_id = 0;
   size_t _on_light_update_register_id = 0;
-  bool _dirty = false;
+
+  /// Atomic so the per-tick update can skip taking the mutex when there are
+  /// no pending changes.
+  std::atomic<bool> _dirty {false};
 };
 
 } // namespace client
@@ -8,27 +8,45 @@
 
 #include "carla/client/Junction.h"
 #include "carla/client/Waypoint.h"
+#include "carla/client/WaypointPool.h"
 #include "carla/opendrive/OpenDriveParser.h"
+#include "carla/TaskScheduler.h"
 #include "carla/road/Map.h"
+#include "carla/road/MapSnapshot.h"
 #include "carla/road/RoadTypes.h"
 
-#include <sstream>
+#include <algorithm>
+#include <new>
 
 namespace carla {
 namespace client {
 
   static auto MakeMap(const std::string &opendrive_contents) {
-    auto stream = std::istringstream(opendrive_contents);
-    auto map = opendrive::OpenDriveParser::Load(stream.str());
+    const std::string snapshot_path =
+        road::MapSnapshot::GetCachedSnapshotPath(opendrive_contents);
+    if (!snapshot_path.empty()) {
+      auto cached = road::MapSnapshot::LoadFromFile(snapshot_path);
+      if (cached.has_value()) {
+        return std::move(*cached);
+      }
+    }
+    road::MapSnapshotWriter snapshot_writer;
+    auto map = opendrive::OpenDriveParser::Load(
+        opendrive_contents,
+        snapshot_path.empty() ? nullptr : &snapshot_writer);
     if (!map.has_value()) {
       throw_exception(std::runtime_error("failed to generate map"));
     }
+    if (!snapshot_path.empty()) {
+      road::MapSnapshot::SaveToFile(snapshot_path, snapshot_writer.Finish());
+    }
     return std::move(*map);
   }
 
   Map::Map(rpc::MapInfo description)
     : _description(std::move(description)),
-      _map(MakeMap(_description.open_drive_file)) {}
+      _map(MakeMap(_description.open_drive_file)),
+      _waypoint_pool(std::make_shared<WaypointPool>()) {}
 
   Map::Map(std::string name, std::string xodr_content)
     : Map(rpc::MapInfo{
@@ -48,9 +66,47 @@ namespace client {
     } else {
       waypoint = _map.GetWaypoint(location, lane_type);
     }
-    return waypoint.has_value() ?
-    SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
-    nullptr;
+    return waypoint.has_value() ? MakeWaypoint(*waypoint) : nullptr;
+  }
+
+  /// Shared pool for batched road map queries, started on first use.
+  static TaskScheduler &GetQueryScheduler() {
+    static TaskScheduler scheduler;
+    static std::once_flag started;
+    std::call_once(started, [] { scheduler.AsyncRun(); });
+    return scheduler;
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GetWaypoints(
+      const std::vector<geom::Location> &locations,
+      bool project_to_road,
+      uint32_t lane_type) const {
+    constexpr size_t chunk_size = 64u;
+    std::vector<SharedPtr<Waypoint>> result(locations.size());
+    if (locations.size() <= chunk_size) {
+      for (size_t i = 0u; i < locations.size(); ++i) {
+        result[i] = GetWaypoint(locations[i], project_to_road, lane_type);
+      }
+      return result;
+    }
+    // The queries are independent and read-only on the road map, fan the
+    // chunks out over the shared scheduler.
+    auto &scheduler = GetQueryScheduler();
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(locations.size() / chunk_size + 1u);
+    for (size_t begin = 0u; begin < locations.size(); begin += chunk_size) {
+      const size_t end = std::min(begin + chunk_size, locations.size());
+      chunks.emplace_back(scheduler.Post(
+          [this, &locations, &result, begin, end, project_to_road, lane_type]() {
+            for (size_t i = begin; i < end; ++i) {
+              result[i] = GetWaypoint(locations[i], project_to_road, lane_type);
+            }
+          }));
+    }
+    for (auto &chunk : chunks) {
+      chunk.get();
+    }
+    return result;
   }
 
   SharedPtr<Waypoint> Map::GetWaypointXODR(
@@ -59,9 +115,27 @@ namespace client {
       float s) const {
     boost::optional<road::element::Waypoint> waypoint;
     waypoint = _map.GetWaypoint(road_id, lane_id, s);
-    return waypoint.has_value() ?
-        SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
-        nullptr;
+    return waypoint.has_value() ? MakeWaypoint(*waypoint) : nullptr;
+  }
+
+  SharedPtr<Waypoint> Map::MakeWaypoint(const road::element::Waypoint &waypoint) const {
+    auto pool = _waypoint_pool;
+    auto *storage = static_cast<Waypoint *>(pool->Pop());
+#ifndef LIBCARLA_NO_EXCEPTIONS
+    try {
+      new (storage) Waypoint(shared_from_this(), waypoint);
+    } catch (...) {
+      pool->Push(storage);
+      throw;
+    }
+#else
+    new (storage) Waypoint(shared_from_this(), waypoint);
+#endif // LIBCARLA_NO_EXCEPTIONS
+    // The deleter keeps the pool alive until the last waypoint is released.
+    return SharedPtr<Waypoint>(storage, [pool](Waypoint *self) {
+      self->~Waypoint();
+      pool->Push(self);
+    });
   }
 
   Map::TopologyList Map::GetTopology() const {
@@ -71,9 +145,7 @@ namespace client {
     auto get_or_make_waypoint = [&](const auto &waypoint) {
       auto it = waypoints.find(waypoint);
       if (it == waypoints.end()) {
-        it = waypoints.emplace(
-            waypoint,
-            SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint})).first;
+        it = waypoints.emplace(waypoint, MakeWaypoint(waypoint)).first;
       }
       return it->second;
     };
@@ -94,7 +166,29 @@ namespace client {
     const auto waypoints = _map.GenerateWaypoints(distance);
     result.reserve(waypoints.size());
     for (const auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
+      result.emplace_back(MakeWaypoint(waypoint));
+    }
+    return result;
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::TraceRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      double resolution) const {
+    auto planner = _route_planner.load();
+    if (planner == nullptr) {
+      // Two threads may race to build the planner; both build the same
+      // tables, so whichever one gets stored first wins.
+      std::shared_ptr<const road::RoutePlanner> expected = nullptr;
+      _route_planner.compare_exchange(
+          &expected, std::make_shared<const road::RoutePlanner>(_map));
+      planner = _route_planner.load();
+    }
+    const auto route = planner->TraceRoute(origin, destination, resolution);
+    std::vector<SharedPtr<Waypoint>> result;
+    result.reserve(route.size());
+    for (const auto &waypoint : route) {
+      result.emplace_back(MakeWaypoint(waypoint));
     }
     return result;
   }
@@ -126,8 +220,7 @@ namespace client {
     auto junction_waypoints = GetMap().GetJunctionWaypoints(id, lane_type);
     for (auto &waypoint_pair : junction_waypoints) {
       result.emplace_back(
-      std::make_pair(SharedPtr<Waypoint>(new Waypoint(shared_from_this(), waypoint_pair.first)),
-      SharedPtr<Waypoint>(new Waypoint(shared_from_this(), waypoint_pair.second))));
+      std::make_pair(MakeWaypoint(waypoint_pair.first), MakeWaypoint(waypoint_pair.second)));
     }
     return result;
   }
@@ -166,6 +259,42 @@ namespace client {
     return result;
   }
 
+  std::vector<std::vector<SharedPtr<Landmark>>> Map::GetAllLandmarksInDistance(
+      const std::vector<SharedPtr<Waypoint>> &waypoints,
+      double distance,
+      bool stop_at_junction) const {
+    constexpr size_t chunk_size = 8u;
+    std::vector<std::vector<SharedPtr<Landmark>>> result(waypoints.size());
+    auto search = [&](const size_t i) {
+      if (waypoints[i] != nullptr) {
+        result[i] = waypoints[i]->GetAllLandmarksInDistance(distance, stop_at_junction);
+      }
+    };
+    if (waypoints.size() <= chunk_size) {
+      for (size_t i = 0u; i < waypoints.size(); ++i) {
+        search(i);
+      }
+      return result;
+    }
+    // Each search only reads the road map, fan the chunks out over the
+    // shared scheduler.
+    auto &scheduler = GetQueryScheduler();
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(waypoints.size() / chunk_size + 1u);
+    for (size_t begin = 0u; begin < waypoints.size(); begin += chunk_size) {
+      const size_t end = std::min(begin + chunk_size, waypoints.size());
+      chunks.emplace_back(scheduler.Post([&search, begin, end]() {
+        for (size_t i = begin; i < end; ++i) {
+          search(i);
+        }
+      }));
+    }
+    for (auto &chunk : chunks) {
+      chunk.get();
+    }
+    return result;
+  }
+
   std::vector<SharedPtr<Landmark>>
       Map::GetLandmarkGroup(const Landmark &landmark) const {
     std::vector<SharedPtr<Landmark>> result;
@@ -6,15 +6,18 @@
 
 #pragma once
 
+#include "carla/AtomicSharedPtr.h"
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/road/element/LaneMarking.h"
 #include "carla/road/Lane.h"
 #include "carla/road/Map.h"
 #include "carla/road/RoadTypes.h"
+#include "carla/road/RoutePlanner.h"
 #include "carla/rpc/MapInfo.h"
 #include "Landmark.h"
 
+#include <memory>
 #include <string>
 
 namespace carla {
@@ -22,6 +25,7 @@ namespace geom { class GeoLocation; }
 namespace client {
 
   class Waypoint;
+  class WaypointPool;
   class Junction;
 
   class Map
@@ -56,17 +60,43 @@ namespace client {
         bool project_to_road = true,
         uint32_t lane_type = static_cast<uint32_t>(road::Lane::LaneType::Driving)) const;
 
+    /// Batched version of GetWaypoint: projects every location in
+    /// @a locations in a single call, running the queries in parallel over
+    /// the shared task scheduler. Locations that do not match any waypoint
+    /// yield a null entry.
+    std::vector<SharedPtr<Waypoint>> GetWaypoints(
+        const std::vector<geom::Location> &locations,
+        bool project_to_road = true,
+        uint32_t lane_type = static_cast<uint32_t>(road::Lane::LaneType::Driving)) const;
+
     SharedPtr<Waypoint> GetWaypointXODR(
       carla::road::RoadId road_id,
       carla::road::LaneId lane_id,
       float s) const;
 
+    /// Makes a client waypoint wrapping @a waypoint. Its storage comes from a
+    /// pool shared by every waypoint this map hands out, so the allocation is
+    /// recycled once the waypoint is released.
+    SharedPtr<Waypoint> MakeWaypoint(const road::element::Waypoint &waypoint) const;
+
     using TopologyList = std::vector<std::pair<SharedPtr<Waypoint>, SharedPtr<Waypoint>>>;
 
     TopologyList GetTopology() const;
 
     std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
 
+    /// Trace the shortest drivable route from @a origin to @a destination,
+    /// returning a waypoint approximately every @a resolution meters along
+    /// it. The routing graph and its landmark tables are built on first use
+    /// and cached for the lifetime of this map, so the first call pays the
+    /// preprocessing and every route after that is a plain graph search.
+    /// Returns an empty list when either location cannot be projected onto
+    /// a driving lane or no route connects them.
+    std::vector<SharedPtr<Waypoint>> TraceRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double resolution = 2.0) const;
+
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
         const geom::Location &destination) const;
@@ -94,11 +124,26 @@ namespace client {
     /// Returns all the landmarks in the same group including this one
     std::vector<SharedPtr<Landmark>> GetLandmarkGroup(const Landmark &landmark) const;
 
+    /// Batched version of Waypoint::GetAllLandmarksInDistance: searches the
+    /// landmarks ahead of every waypoint in @a waypoints in a single call,
+    /// running the searches in parallel over the shared task scheduler. Use
+    /// it to query a whole route or fleet at once instead of one waypoint at
+    /// a time. Null waypoints yield an empty entry.
+    std::vector<std::vector<SharedPtr<Landmark>>> GetAllLandmarksInDistance(
+        const std::vector<SharedPtr<Waypoint>> &waypoints,
+        double distance,
+        bool stop_at_junction = false) const;
+
   private:
 
     const rpc::MapInfo _description;
 
     const road::Map _map;
+
+    const std::shared_ptr<WaypointPool> _waypoint_pool;
+
+    /// Lazily built by TraceRoute; read-only once stored.
+    mutable AtomicSharedPtr<const road::RoutePlanner> _route_planner;
   };
 
 } // namespace client
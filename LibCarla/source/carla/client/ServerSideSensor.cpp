@@ -47,6 +47,10 @@ namespace client {
     _is_listening = false;
   }
 
+  rpc::SensorTiming ServerSideSensor::GetTiming() const {
+    return GetEpisode().Lock()->GetSensorTiming(*this);
+  }
+
   bool ServerSideSensor::Destroy() {
     if (IsListening()) {
       Stop();
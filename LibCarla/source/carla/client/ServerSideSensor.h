@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Sensor.h"
+#include "carla/rpc/SensorTiming.h"
 
 namespace carla {
 namespace client {
@@ -36,6 +37,10 @@ namespace client {
       return _is_listening;
     }
 
+    /// Return the capture, serialization, and transmission times accumulated
+    /// by this sensor in the simulator since it was spawned.
+    rpc::SensorTiming GetTiming() const;
+
     /// @copydoc Actor::Destroy()
     ///
     /// Additionally stop listening.
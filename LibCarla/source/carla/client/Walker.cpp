@@ -22,6 +22,14 @@ namespace client {
     GetEpisode().Lock()->ApplyBoneControlToWalker(*this, bone_control);
   }
 
+  void Walker::ApplyControl(const BonePose &bone_pose) {
+    GetEpisode().Lock()->ApplyBonePoseToWalker(*this, bone_pose);
+  }
+
+  std::vector<std::string> Walker::GetBoneNames() const {
+    return GetEpisode().Lock()->GetWalkerBoneNames(*this);
+  }
+
   Walker::Control Walker::GetWalkerControl() const {
     return GetEpisode().Lock()->GetActorSnapshot(*this).state.walker_control;
   }
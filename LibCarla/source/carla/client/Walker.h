@@ -9,6 +9,10 @@
 #include "carla/client/Actor.h"
 #include "carla/rpc/WalkerControl.h"
 #include "carla/rpc/WalkerBoneControl.h"
+#include "carla/rpc/WalkerBonePose.h"
+
+#include <string>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -18,6 +22,7 @@ namespace client {
 
     using Control = rpc::WalkerControl;
     using BoneControl = rpc::WalkerBoneControl;
+    using BonePose = rpc::WalkerBonePose;
 
     explicit Walker(ActorInitializer init) : Actor(std::move(init)) {}
 
@@ -28,6 +33,14 @@ namespace client {
 
     void ApplyControl(const BoneControl &bone_control);
 
+    /// Apply @a bone_pose to this Walker; bones are addressed by skeleton
+    /// index so no bone names travel with the pose.
+    void ApplyControl(const BonePose &bone_pose);
+
+    /// Names of every bone in this Walker's skeleton, in the index order
+    /// BonePose expects. The skeleton does not change, fetch once and reuse.
+    std::vector<std::string> GetBoneNames() const;
+
     /// Return the control last applied to this Walker.
     ///
     /// @note This function does not call the simulator, it returns the Control
@@ -52,7 +52,7 @@ namespace client {
     std::vector<SharedPtr<Waypoint>> result;
     result.reserve(waypoints.size());
     for (auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, std::move(waypoint))));
+      result.emplace_back(_parent->MakeWaypoint(waypoint));
     }
     return result;
   }
@@ -62,7 +62,7 @@ namespace client {
     std::vector<SharedPtr<Waypoint>> result;
     result.reserve(waypoints.size());
     for (auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, std::move(waypoint))));
+      result.emplace_back(_parent->MakeWaypoint(waypoint));
     }
     return result;
   }
@@ -131,7 +131,7 @@ namespace client {
     auto right_lane_waypoint =
         _parent->GetMap().GetRight(_waypoint);
     if (right_lane_waypoint.has_value()) {
-      return SharedPtr<Waypoint>(new Waypoint(_parent, std::move(*right_lane_waypoint)));
+      return _parent->MakeWaypoint(*right_lane_waypoint);
     }
     return nullptr;
   }
@@ -140,7 +140,7 @@ namespace client {
     auto left_lane_waypoint =
         _parent->GetMap().GetLeft(_waypoint);
     if (left_lane_waypoint.has_value()) {
-      return SharedPtr<Waypoint>(new Waypoint(_parent, std::move(*left_lane_waypoint)));
+      return _parent->MakeWaypoint(*left_lane_waypoint);
     }
     return nullptr;
   }
@@ -226,7 +226,7 @@ namespace client {
         continue;
       }
       added_signals.insert(signal_data.signal);
-      auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, signal_data.waypoint));
+      auto waypoint = _parent->MakeWaypoint(signal_data.waypoint);
       result.emplace_back(
           new Landmark(waypoint, _parent, signal_data.signal, signal_data.accumulated_s));
     }
@@ -244,7 +244,7 @@ namespace client {
         if(added_signals.count(signal_data.signal) > 0) {
           continue;
         }
-        auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, signal_data.waypoint));
+        auto waypoint = _parent->MakeWaypoint(signal_data.waypoint);
         result.emplace_back(
             new Landmark(waypoint, _parent, signal_data.signal, signal_data.accumulated_s));
       }
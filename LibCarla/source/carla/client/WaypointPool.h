@@ -0,0 +1,64 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/client/Waypoint.h"
+
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#endif
+#include "moodycamel/ConcurrentQueue.h"
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+namespace carla {
+namespace client {
+
+  /// A pool of storage for client::Waypoint objects. Waypoints are handed out
+  /// as shared pointers whose deleter destroys the object and returns its
+  /// storage here instead of to the allocator, so dense queries such as
+  /// Map::GenerateWaypoints recycle a bounded set of allocations instead of
+  /// hitting the heap once per waypoint.
+  ///
+  /// The pooled memory is released when the pool is destroyed, i.e. once the
+  /// owning Map and every waypoint it handed out are gone.
+  class WaypointPool {
+  public:
+
+    WaypointPool() = default;
+
+    ~WaypointPool() {
+      void *storage = nullptr;
+      while (_storage.try_dequeue(storage)) {
+        ::operator delete(storage);
+      }
+    }
+
+    /// Pop storage for one Waypoint, allocating fresh storage if the pool is
+    /// empty.
+    void *Pop() {
+      void *storage = nullptr;
+      if (_storage.try_dequeue(storage)) {
+        return storage;
+      }
+      return ::operator new(sizeof(Waypoint));
+    }
+
+    /// Return the storage of a destroyed Waypoint to the pool.
+    void Push(void *storage) {
+      _storage.enqueue(storage);
+    }
+
+  private:
+
+    moodycamel::ConcurrentQueue<void *> _storage;
+  };
+
+} // namespace client
+} // namespace carla
@@ -54,10 +54,26 @@ namespace client {
     _episode.Lock()->SetWeatherParameters(weather);
   }
 
+  void World::PrewarmWeatherPresets(const std::vector<rpc::WeatherParameters> &presets) {
+    _episode.Lock()->PrewarmWeatherPresets(presets);
+  }
+
+  void World::PrefetchRoute(const std::vector<geom::Location> &route, float lookahead) {
+    _episode.Lock()->PrefetchRoute(route, lookahead);
+  }
+
   WorldSnapshot World::GetSnapshot() const {
     return _episode.Lock()->GetWorldSnapshot();
   }
 
+  detail::StateRetentionMetrics World::GetStateRetentionMetrics() const {
+    return _episode.Lock()->GetStateRetentionMetrics();
+  }
+
+  void World::SetMaxPooledStates(size_t count) {
+    _episode.Lock()->SetMaxPooledStates(count);
+  }
+
   SharedPtr<Actor> World::GetActor(ActorId id) const {
     auto simulator = _episode.Lock();
     auto description = simulator->GetActorById(id);
@@ -78,6 +94,10 @@ namespace client {
                                   _episode.Lock()->GetActorsById(actor_ids)}};
   }
 
+  rpc::ActorListDiff World::GetActorListDiff(uint64_t known_version) const {
+    return _episode.Lock()->GetActorListDiff(known_version);
+  }
+
   SharedPtr<Actor> World::SpawnActor(
       const ActorBlueprint &blueprint,
       const geom::Transform &transform,
@@ -110,14 +130,26 @@ namespace client {
     _episode.Lock()->RemoveOnTickEvent(callback_id);
   }
 
+  void World::OnNextTick(std::function<void(WorldSnapshot)> callback) {
+    _episode.Lock()->OnNextTick(std::move(callback));
+  }
+
   uint64_t World::Tick(time_duration timeout) {
     return _episode.Lock()->Tick(timeout);
   }
 
+  uint64_t World::FastForward(double duration, float relevance_radius) {
+    return _episode.Lock()->FastForward(duration, relevance_radius);
+  }
+
   void World::SetPedestriansCrossFactor(float percentage) {
     _episode.Lock()->SetPedestriansCrossFactor(percentage);
   }
 
+  void World::SetPedestriansSeed(unsigned int seed) {
+    _episode.Lock()->SetPedestriansSeed(seed);
+  }
+
   SharedPtr<Actor> World::GetTrafficSign(const Landmark& landmark) const {
     SharedPtr<ActorList> actors = GetActors();
     SharedPtr<TrafficSign> result;
@@ -162,6 +194,10 @@ namespace client {
     _episode.Lock()->FreezeAllTrafficLights(frozen);
   }
 
+  void World::FastReset() {
+    _episode.Lock()->FastReset();
+  }
+
   std::vector<geom::BoundingBox> World::GetLevelBBs(uint8_t queried_tag) const {
     return _episode.Lock()->GetLevelBBs(queried_tag);
   }
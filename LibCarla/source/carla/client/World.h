@@ -14,8 +14,10 @@
 #include "carla/client/Timestamp.h"
 #include "carla/client/WorldSnapshot.h"
 #include "carla/client/detail/EpisodeProxy.h"
+#include "carla/client/detail/StateRetentionMetrics.h"
 #include "carla/geom/Transform.h"
 #include "carla/rpc/Actor.h"
+#include "carla/rpc/ActorListDiff.h"
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/EpisodeSettings.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
@@ -82,9 +84,28 @@ namespace client {
     /// Change the weather in the simulation.
     void SetWeather(const rpc::WeatherParameters &weather);
 
+    /// Warm up the shader and texture variants of the given weather
+    /// @a presets on the server, one per frame, so later cycling through
+    /// them does not drop frames; the active weather is restored once the
+    /// warm-up finishes.
+    void PrewarmWeatherPresets(const std::vector<rpc::WeatherParameters> &presets);
+
+    /// Send a planned @a route to the server so the streaming system
+    /// prefetches the map along it ahead of the ego view. @a lookahead is
+    /// the route distance in meters kept warm past the route point closest
+    /// to the spectator; pass an empty route to stop prefetching.
+    void PrefetchRoute(const std::vector<geom::Location> &route, float lookahead = 500.0f);
+
     /// Return a snapshot of the world at this moment.
     WorldSnapshot GetSnapshot() const;
 
+    /// Counters over the episode states this client keeps alive for its
+    /// snapshots; useful to spot user code retaining old snapshots.
+    detail::StateRetentionMetrics GetStateRetentionMetrics() const;
+
+    /// Cap the number of spare snapshot states recycled between ticks.
+    void SetMaxPooledStates(size_t count);
+
     /// Find actor by id, return nullptr if not found.
     SharedPtr<Actor> GetActor(ActorId id) const;
 
@@ -94,6 +115,10 @@ namespace client {
     /// Return a list with the actors requested by ActorId.
     SharedPtr<ActorList> GetActors(const std::vector<ActorId> &actor_ids) const;
 
+    /// Return the actors added and the ids of the actors removed from the
+    /// episode since @a known_version of the server-side actor registry.
+    rpc::ActorListDiff GetActorListDiff(uint64_t known_version) const;
+
     /// Spawn an actor into the world based on the @a blueprint provided at @a
     /// transform. If a @a parent is provided, the actor is attached to
     /// @a parent.
@@ -122,18 +147,36 @@ namespace client {
     /// Remove a callback registered with OnTick.
     void RemoveOnTick(size_t callback_id);
 
+    /// Register a @a callback to be called only once, on the next world tick.
+    /// Does not block a thread the way WaitForTick does, so one reactor
+    /// thread can await ticks from many worlds.
+    void OnNextTick(std::function<void(WorldSnapshot)> callback);
+
     /// Signal the simulator to continue to next tick (only has effect on
     /// synchronous mode).
     ///
     /// @return The id of the frame that this call started.
     uint64_t Tick(time_duration timeout);
 
+    /// Fast-forward the simulation by @a duration simulated seconds:
+    /// sensors are suspended and physics runs coarse until the target
+    /// time; in synchronous mode frames free-run without tick cues. A
+    /// @a relevance_radius in meters above zero additionally freezes the
+    /// physics of vehicles farther than that from the spectator.
+    ///
+    /// @return The id of the first fast-forwarded frame.
+    uint64_t FastForward(double duration, float relevance_radius = 0.0f);
+
     /// set the probability that an agent could cross the roads in its path following
     /// percentage of 0.0f means no pedestrian can cross roads
     /// percentage of 0.5f means 50% of all pedestrians can cross roads
     /// percentage of 1.0f means all pedestrians can cross roads if needed
     void SetPedestriansCrossFactor(float percentage);
 
+    /// seed the counter-based random streams driving the pedestrians, so
+    /// crossing decisions and targets repeat from run to run
+    void SetPedestriansSeed(unsigned int seed);
+
     SharedPtr<Actor> GetTrafficSign(const Landmark& landmark) const;
 
     SharedPtr<Actor> GetTrafficLight(const Landmark& landmark) const;
@@ -152,6 +195,12 @@ namespace client {
 
     void FreezeAllTrafficLights(bool frozen);
 
+    /// Reset the episode without reloading the level: destroys every actor
+    /// spawned through the API and restores the default weather, keeping the
+    /// map, streamed tiles and nav data resident. Orders of magnitude faster
+    /// than Client::ReloadWorld.
+    void FastReset();
+
     /// Returns all the BBs of all the elements of the level
     std::vector<geom::BoundingBox> GetLevelBBs(uint8_t queried_tag) const;
 
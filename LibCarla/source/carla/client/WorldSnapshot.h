@@ -45,6 +45,14 @@ namespace client {
       return _state->GetActorSnapshotIfPresent(actor_id);
     }
 
+    /// @copydoc detail::EpisodeState::CopyPackedActorState
+    void CopyPackedActorState(
+        std::vector<ActorId> &ids,
+        std::vector<float> &transforms,
+        std::vector<float> &velocities) const {
+      _state->CopyPackedActorState(ids, transforms, velocities);
+    }
+
     /// Return number of ActorSnapshots present in this WorldSnapshot.
     size_t size() const {
       return _state->size();
@@ -6,14 +6,17 @@
 
 #pragma once
 
+#include "carla/AtomicSharedPtr.h"
 #include "carla/NonCopyable.h"
 #include "carla/rpc/Actor.h"
 
-#include <boost/iterator/transform_iterator.hpp>
+#include <boost/optional.hpp>
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace carla {
 namespace client {
@@ -26,11 +29,14 @@ namespace detail {
   /// Keeps a list of actor descriptions to avoid requesting each time the
   /// descriptions to the server.
   ///
-  /// @todo Dead actors are never removed from the list.
+  /// Readers work on an immutable snapshot (a sorted-by-id vector swapped
+  /// atomically by writers), so accessors never block behind the tick
+  /// thread; only concurrent writers serialize against each other.
   class CachedActorList : private MovableNonCopyable {
   public:
 
-    /// Inserts an actor into the list.
+    /// Inserts an actor into the list, replacing any previous entry with the
+    /// same id.
     void Insert(rpc::Actor actor);
 
     /// Inserts a @a range containing actors.
@@ -50,54 +56,89 @@ namespace detail {
     template <typename RangeT>
     std::vector<rpc::Actor> GetActorsById(const RangeT &range) const;
 
+    /// Remove the actor matching @a id from the list, if present.
+    void Remove(ActorId id);
+
     void Clear();
 
   private:
 
-    mutable std::mutex _mutex;
+    /// Immutable list of actors sorted by id.
+    using Snapshot = std::vector<rpc::Actor>;
+
+    static Snapshot::const_iterator Find(const Snapshot &snapshot, ActorId id);
+
+    static void InsertInto(Snapshot &snapshot, rpc::Actor actor);
+
+    /// Serializes writers only, readers just load the current snapshot.
+    std::mutex _write_mutex;
 
-    std::unordered_map<ActorId, rpc::Actor> _actors;
+    AtomicSharedPtr<const Snapshot> _snapshot{std::make_shared<const Snapshot>()};
   };
 
   // ===========================================================================
   // -- CachedActorList implementation -----------------------------------------
   // ===========================================================================
 
+  inline CachedActorList::Snapshot::const_iterator CachedActorList::Find(
+      const Snapshot &snapshot,
+      ActorId id) {
+    auto it = std::lower_bound(
+        snapshot.begin(),
+        snapshot.end(),
+        id,
+        [](const rpc::Actor &actor, ActorId value) { return actor.id < value; });
+    return ((it != snapshot.end()) && (it->id == id)) ? it : snapshot.end();
+  }
+
+  inline void CachedActorList::InsertInto(Snapshot &snapshot, rpc::Actor actor) {
+    auto it = std::lower_bound(
+        snapshot.begin(),
+        snapshot.end(),
+        actor.id,
+        [](const rpc::Actor &lhs, ActorId value) { return lhs.id < value; });
+    if ((it != snapshot.end()) && (it->id == actor.id)) {
+      *it = std::move(actor);
+    } else {
+      snapshot.insert(it, std::move(actor));
+    }
+  }
+
   inline void CachedActorList::Insert(rpc::Actor actor) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    auto id = actor.id;
-    _actors.emplace(id, std::move(actor));
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    auto next = std::make_shared<Snapshot>(*_snapshot.load());
+    InsertInto(*next, std::move(actor));
+    _snapshot.store(std::move(next));
   }
 
   template <typename RangeT>
   inline void CachedActorList::InsertRange(RangeT range) {
-    auto make_a_pair = [](rpc::Actor actor) {
-      auto id = actor.id;
-      return std::make_pair(id, std::move(actor));
-    };
-    auto make_iterator = [&make_a_pair](auto it) {
-      return boost::make_transform_iterator(std::make_move_iterator(it), make_a_pair);
-    };
-    std::lock_guard<std::mutex> lock(_mutex);
-    _actors.insert(make_iterator(std::begin(range)), make_iterator(std::end(range)));
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    auto next = std::make_shared<Snapshot>(*_snapshot.load());
+    next->reserve(next->size() + range.size());
+    for (auto it = std::make_move_iterator(std::begin(range)),
+              end = std::make_move_iterator(std::end(range)); it != end; ++it) {
+      InsertInto(*next, *it);
+    }
+    _snapshot.store(std::move(next));
   }
 
   template <typename RangeT>
   inline std::vector<ActorId> CachedActorList::GetMissingIds(const RangeT &range) const {
     std::vector<ActorId> result;
     result.reserve(range.size());
-    std::lock_guard<std::mutex> lock(_mutex);
-    std::copy_if(std::begin(range), std::end(range), std::back_inserter(result), [this](auto id) {
-      return _actors.find(id) == _actors.end();
+    auto snapshot = _snapshot.load();
+    std::copy_if(std::begin(range), std::end(range), std::back_inserter(result), [&](auto id) {
+      return Find(*snapshot, id) == snapshot->end();
     });
     return result;
   }
 
   inline boost::optional<rpc::Actor> CachedActorList::GetActorById(ActorId id) const {
-    std::lock_guard<std::mutex> lock(_mutex);
-    auto it = _actors.find(id);
-    if (it != _actors.end()) {
-      return it->second;
+    auto snapshot = _snapshot.load();
+    auto it = Find(*snapshot, id);
+    if (it != snapshot->end()) {
+      return *it;
     }
     return boost::none;
   }
@@ -106,19 +147,31 @@ namespace detail {
   inline std::vector<rpc::Actor> CachedActorList::GetActorsById(const RangeT &range) const {
     std::vector<rpc::Actor> result;
     result.reserve(range.size());
-    std::lock_guard<std::mutex> lock(_mutex);
+    auto snapshot = _snapshot.load();
     for (auto &&id : range) {
-      auto it = _actors.find(id);
-      if (it != _actors.end()) {
-        result.emplace_back(it->second);
+      auto it = Find(*snapshot, id);
+      if (it != snapshot->end()) {
+        result.emplace_back(*it);
       }
     }
     return result;
   }
 
+  inline void CachedActorList::Remove(ActorId id) {
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    auto snapshot = _snapshot.load();
+    auto it = Find(*snapshot, id);
+    if (it == snapshot->end()) {
+      return;
+    }
+    auto next = std::make_shared<Snapshot>(*snapshot);
+    next->erase(next->begin() + (it - snapshot->begin()));
+    _snapshot.store(std::move(next));
+  }
+
   inline void CachedActorList::Clear() {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _actors.clear();
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    _snapshot.store(std::make_shared<const Snapshot>());
   }
 
 } // namespace detail
@@ -9,19 +9,24 @@
 #include "carla/Exception.h"
 #include "carla/Version.h"
 #include "carla/client/TimeoutException.h"
+#include "carla/profiler/AllocationTracker.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/BoneTransformData.h"
+#include "carla/rpc/BulkTransfer.h"
 #include "carla/rpc/Client.h"
 #include "carla/rpc/DebugShape.h"
 #include "carla/rpc/Response.h"
 #include "carla/rpc/VehicleControl.h"
 #include "carla/rpc/VehicleLightState.h"
 #include "carla/rpc/WalkerBoneControl.h"
+#include "carla/rpc/WalkerBonePose.h"
 #include "carla/rpc/WalkerControl.h"
 #include "carla/streaming/Client.h"
+#include "carla/streaming/detail/Compression.h"
 
 #include <rpc/rpc_error.h>
 
+#include <future>
 #include <thread>
 
 namespace carla {
@@ -30,7 +35,7 @@ namespace detail {
 
   template <typename T>
   static T Get(carla::rpc::Response<T> &response) {
-    return response.Get();
+    return std::move(response).Get();
   }
 
   static bool Get(carla::rpc::Response<void> &) {
@@ -55,6 +60,7 @@ namespace detail {
 
     template <typename ... Args>
     auto RawCall(const std::string &function, Args && ... args) {
+      CARLA_ALLOCATION_SCOPE(Rpc);
       try {
         return rpc_client.call(function, std::forward<Args>(args) ...);
       } catch (const ::rpc::timeout &) {
@@ -79,6 +85,28 @@ namespace detail {
       rpc_client.async_call(function, std::forward<Args>(args) ...);
     }
 
+    /// Issue the call immediately, pipelined behind any other call in
+    /// flight on this connection, and defer waiting for the reply until
+    /// the returned future is queried.
+    template <typename T, typename ... Args>
+    auto CallAsync(const std::string &function, Args && ... args) {
+      using ObjectFutureT =
+          decltype(rpc_client.async_call_with_result(function, std::forward<Args>(args) ...));
+      auto object = std::make_shared<ObjectFutureT>(
+          rpc_client.async_call_with_result(function, std::forward<Args>(args) ...));
+      return std::async(std::launch::deferred, [this, object]() {
+        try {
+          auto response = object->get().template as<carla::rpc::Response<T>>();
+          if (response.HasError()) {
+            throw_exception(std::runtime_error(response.GetError().What()));
+          }
+          return Get(response);
+        } catch (const ::rpc::timeout &) {
+          throw_exception(TimeoutException(endpoint, GetTimeout()));
+        }
+      });
+    }
+
     time_duration GetTimeout() const {
       auto timeout = rpc_client.get_timeout();
       DEBUG_ASSERT(timeout.has_value());
@@ -140,6 +168,10 @@ namespace detail {
     return _pimpl->CallAndWait<std::string>("version");
   }
 
+  void Client::FastResetEpisode() {
+    _pimpl->CallAndWait<void>("fast_reset_episode");
+  }
+
   void Client::LoadEpisode(std::string map_name) {
     // Await response, we need to be sure in this one.
     _pimpl->CallAndWait<void>("load_new_episode", std::move(map_name));
@@ -155,7 +187,30 @@ namespace detail {
   }
 
   rpc::MapInfo Client::GetMapInfo() {
-    return _pimpl->CallAndWait<rpc::MapInfo>("get_map_info");
+    auto info = _pimpl->CallAndWait<rpc::MapInfo>("get_map_info");
+    // The OpenDRIVE content is pulled in chunks, on the bigger maps it is
+    // way past what a single msgpack message should carry.
+    info.open_drive_file = PullBulkPayload(
+        _pimpl->CallAndWait<rpc::BulkTransfer>("get_map_data"));
+    return info;
+  }
+
+  std::string Client::PullBulkPayload(const rpc::BulkTransfer &descriptor) {
+    if (descriptor.size == 0u) {
+      return std::string();
+    }
+    Buffer payload(descriptor.size);
+    uint64_t offset = 0u;
+    for (auto chunk = 0u; offset < descriptor.size; ++chunk) {
+      auto bytes = _pimpl->CallAndWait<std::vector<uint8_t>>("pull_bulk_chunk", descriptor.id, chunk);
+      if (bytes.empty() || (offset + bytes.size() > descriptor.size)) {
+        throw_exception(std::runtime_error("bulk transfer out of sync with server"));
+      }
+      payload.copy_from(static_cast<Buffer::size_type>(offset), bytes.data(), static_cast<Buffer::size_type>(bytes.size()));
+      offset += bytes.size();
+    }
+    auto decompressed = streaming::detail::Compression::Decompress(std::move(payload));
+    return std::string(decompressed.begin(), decompressed.end());
   }
 
   std::vector<uint8_t> Client::GetNavigationMesh() const {
@@ -170,6 +225,10 @@ namespace detail {
     return _pimpl->CallAndWait<std::vector<rpc::ActorDefinition>>("get_actor_definitions");
   }
 
+  uint64_t Client::GetBlueprintLibraryVersion() {
+    return _pimpl->CallAndWait<uint64_t>("get_blueprint_library_version");
+  }
+
   rpc::Actor Client::GetSpectator() {
     return _pimpl->CallAndWait<carla::rpc::Actor>("get_spectator");
   }
@@ -182,6 +241,10 @@ namespace detail {
     return _pimpl->CallAndWait<uint64_t>("set_episode_settings", settings);
   }
 
+  rpc::FrameStats Client::GetFrameStats() const {
+    return _pimpl->CallAndWait<rpc::FrameStats>("get_frame_stats");
+  }
+
   rpc::WeatherParameters Client::GetWeatherParameters() {
     return _pimpl->CallAndWait<rpc::WeatherParameters>("get_weather_parameters");
   }
@@ -190,12 +253,24 @@ namespace detail {
     _pimpl->AsyncCall("set_weather_parameters", weather);
   }
 
+  void Client::PrewarmWeatherPresets(const std::vector<rpc::WeatherParameters> &presets) {
+    _pimpl->AsyncCall("prewarm_weather_presets", presets);
+  }
+
+  void Client::PrefetchRoute(const std::vector<geom::Location> &route, float lookahead) {
+    _pimpl->AsyncCall("prefetch_route", route, lookahead);
+  }
+
   std::vector<rpc::Actor> Client::GetActorsById(
       const std::vector<ActorId> &ids) {
     using return_t = std::vector<rpc::Actor>;
     return _pimpl->CallAndWait<return_t>("get_actors_by_id", ids);
   }
 
+  rpc::ActorListDiff Client::GetActorListDiff(uint64_t known_version) {
+    return _pimpl->CallAndWait<rpc::ActorListDiff>("get_actor_list_diff", known_version);
+  }
+
   rpc::VehiclePhysicsControl Client::GetVehiclePhysicsControl(
       rpc::ActorId vehicle) const {
     return _pimpl->CallAndWait<carla::rpc::VehiclePhysicsControl>("get_physics_control", vehicle);
@@ -247,6 +322,24 @@ namespace detail {
         attachment_type);
   }
 
+  std::future<rpc::Actor> Client::SpawnActorAsync(
+      const rpc::ActorDescription &description,
+      const geom::Transform &transform) {
+    return _pimpl->CallAsync<rpc::Actor>("spawn_actor", description, transform);
+  }
+
+  std::future<rpc::Actor> Client::SpawnActorWithParentAsync(
+      const rpc::ActorDescription &description,
+      const geom::Transform &transform,
+      rpc::ActorId parent,
+      rpc::AttachmentType attachment_type) {
+    return _pimpl->CallAsync<rpc::Actor>("spawn_actor_with_parent",
+        description,
+        transform,
+        parent,
+        attachment_type);
+  }
+
   bool Client::DestroyActor(rpc::ActorId actor) {
     try {
       return _pimpl->CallAndWait<void>("destroy_actor", actor);
@@ -256,6 +349,10 @@ namespace detail {
     }
   }
 
+  std::future<bool> Client::DestroyActorAsync(rpc::ActorId actor) {
+    return _pimpl->CallAsync<void>("destroy_actor", actor);
+  }
+
   void Client::SetActorLocation(rpc::ActorId actor, const geom::Location &location) {
     _pimpl->AsyncCall("set_actor_location", actor, location);
   }
@@ -312,6 +409,10 @@ namespace detail {
     _pimpl->AsyncCall("set_actor_enable_gravity", actor, enabled);
   }
 
+  rpc::SensorTiming Client::GetSensorTiming(rpc::ActorId sensor) const {
+    return _pimpl->CallAndWait<rpc::SensorTiming>("get_sensor_timing", sensor);
+  }
+
   void Client::SetActorAutopilot(rpc::ActorId vehicle, const bool enabled) {
     _pimpl->AsyncCall("set_actor_autopilot", vehicle, enabled);
   }
@@ -328,6 +429,15 @@ namespace detail {
     _pimpl->AsyncCall("apply_bone_control_to_walker", walker, control);
   }
 
+  std::vector<std::string> Client::GetWalkerBoneNames(rpc::ActorId walker) {
+    using return_t = std::vector<std::string>;
+    return _pimpl->CallAndWait<return_t>("get_walker_bone_names", walker);
+  }
+
+  void Client::ApplyBonePoseToWalker(rpc::ActorId walker, const rpc::WalkerBonePose &pose) {
+    _pimpl->AsyncCall("apply_bone_pose_to_walker", walker, pose);
+  }
+
   void Client::SetTrafficLightState(
       rpc::ActorId traffic_light,
       const rpc::TrafficLightState traffic_light_state) {
@@ -380,21 +490,28 @@ namespace detail {
   }
 
   std::string Client::ShowRecorderFileInfo(std::string name, bool show_all) {
-    return _pimpl->CallAndWait<std::string>("show_recorder_file_info", name, show_all);
+    return PullBulkPayload(
+        _pimpl->CallAndWait<rpc::BulkTransfer>("show_recorder_file_info", name, show_all));
   }
 
   std::string Client::ShowRecorderCollisions(std::string name, char type1, char type2) {
-    return _pimpl->CallAndWait<std::string>("show_recorder_collisions", name, type1, type2);
+    return PullBulkPayload(
+        _pimpl->CallAndWait<rpc::BulkTransfer>("show_recorder_collisions", name, type1, type2));
   }
 
   std::string Client::ShowRecorderActorsBlocked(std::string name, double min_time, double min_distance) {
-    return _pimpl->CallAndWait<std::string>("show_recorder_actors_blocked", name, min_time, min_distance);
+    return PullBulkPayload(
+        _pimpl->CallAndWait<rpc::BulkTransfer>("show_recorder_actors_blocked", name, min_time, min_distance));
   }
 
   std::string Client::ReplayFile(std::string name, double start, double duration, uint32_t follow_id) {
     return _pimpl->CallAndWait<std::string>("replay_file", name, start, duration, follow_id);
   }
 
+  std::string Client::ReplayBatch(std::vector<std::string> names, double time_factor) {
+    return _pimpl->CallAndWait<std::string>("replay_batch", std::move(names), time_factor);
+  }
+
   void Client::StopReplayer(bool keep_actors) {
     _pimpl->AsyncCall("stop_replayer", keep_actors);
   }
@@ -421,6 +538,10 @@ namespace detail {
     _pimpl->AsyncCall("draw_debug_shape", shape);
   }
 
+  void Client::DrawDebugShapes(const std::vector<rpc::DebugShape> &shapes) {
+    _pimpl->AsyncCall("draw_debug_shapes", shapes);
+  }
+
   void Client::ApplyBatch(std::vector<rpc::Command> commands, bool do_tick_cue) {
     _pimpl->AsyncCall("apply_batch", std::move(commands), do_tick_cue);
   }
@@ -432,10 +553,38 @@ namespace detail {
     return result.as<std::vector<rpc::CommandResponse>>();
   }
 
+  void Client::ApplyBatch(const rpc::CommandBuffer &commands, bool do_tick_cue) {
+    _pimpl->AsyncCall("apply_batch_raw", commands.Encode(), do_tick_cue);
+  }
+
+  std::vector<rpc::CommandResponse> Client::ApplyBatchSync(
+      const rpc::CommandBuffer &commands,
+      bool do_tick_cue) {
+    auto result = _pimpl->RawCall("apply_batch_raw", commands.Encode(), do_tick_cue);
+    return result.as<std::vector<rpc::CommandResponse>>();
+  }
+
+  uint64_t Client::ApplyBatchAtFrame(
+      std::vector<rpc::Command> commands,
+      uint64_t target_frame) {
+    return _pimpl->CallAndWait<uint64_t>(
+        "apply_batch_at_frame", std::move(commands), target_frame);
+  }
+
+  std::vector<rpc::CommandResponse> Client::SpawnActors(
+      std::vector<rpc::Command::SpawnActor> commands) {
+    auto result = _pimpl->RawCall("spawn_actors", std::move(commands));
+    return result.as<std::vector<rpc::CommandResponse>>();
+  }
+
   uint64_t Client::SendTickCue() {
     return _pimpl->CallAndWait<uint64_t>("tick_cue");
   }
 
+  uint64_t Client::FastForward(double duration, float relevance_radius) {
+    return _pimpl->CallAndWait<uint64_t>("fast_forward", duration, relevance_radius);
+  }
+
   std::vector<rpc::LightState> Client::QueryLightsStateToServer() const {
     using return_t = std::vector<rpc::LightState>;
     return _pimpl->CallAndWait<return_t>("query_lights_state", _pimpl->endpoint);
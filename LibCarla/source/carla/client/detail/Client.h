@@ -12,13 +12,17 @@
 #include "carla/geom/Transform.h"
 #include "carla/rpc/Actor.h"
 #include "carla/rpc/ActorDefinition.h"
+#include "carla/rpc/ActorListDiff.h"
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandBuffer.h"
 #include "carla/rpc/CommandResponse.h"
 #include "carla/rpc/EpisodeInfo.h"
 #include "carla/rpc/EpisodeSettings.h"
+#include "carla/rpc/FrameStats.h"
 #include "carla/rpc/LightState.h"
 #include "carla/rpc/MapInfo.h"
+#include "carla/rpc/SensorTiming.h"
 #include "carla/rpc/TrafficLightState.h"
 #include "carla/rpc/VehiclePhysicsControl.h"
 #include "carla/rpc/VehicleLightState.h"
@@ -27,6 +31,7 @@
 #include "carla/rpc/VehicleLightStateList.h"
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,10 +41,12 @@ namespace carla {
   class Buffer;
 namespace rpc {
   class ActorDescription;
+  class BulkTransfer;
   class DebugShape;
   class VehicleControl;
   class WalkerControl;
   class WalkerBoneControl;
+  class WalkerBonePose;
 }
 namespace sensor {
   class SensorData;
@@ -89,6 +96,10 @@ namespace detail {
 
     void LoadEpisode(std::string map_name);
 
+    /// Reset the current episode without reloading the level: only actors
+    /// spawned through the API, and the weather, are reset.
+    void FastResetEpisode();
+
     void CopyOpenDriveToServer(
         std::string opendrive, const rpc::OpendriveGenerationParameters & params);
 
@@ -102,18 +113,39 @@ namespace detail {
 
     std::vector<rpc::ActorDefinition> GetActorDefinitions();
 
+    /// Cheap probe for the blueprint library: the returned counter changes
+    /// whenever the actor definitions on the server do, so an unchanged
+    /// library can be detected without downloading it again.
+    uint64_t GetBlueprintLibraryVersion();
+
     rpc::Actor GetSpectator();
 
     rpc::EpisodeSettings GetEpisodeSettings();
 
     uint64_t SetEpisodeSettings(const rpc::EpisodeSettings &settings);
 
+    rpc::FrameStats GetFrameStats() const;
+
     rpc::WeatherParameters GetWeatherParameters();
 
     void SetWeatherParameters(const rpc::WeatherParameters &weather);
 
+    /// Warm up the shader and texture variants of @a presets on the
+    /// server, one per frame, so cycling through them later causes no
+    /// hitches.
+    void PrewarmWeatherPresets(const std::vector<rpc::WeatherParameters> &presets);
+
+    /// Send a planned route to the server so the streaming system
+    /// prefetches the map along it; an empty @a route stops prefetching.
+    void PrefetchRoute(const std::vector<geom::Location> &route, float lookahead);
+
     std::vector<rpc::Actor> GetActorsById(const std::vector<ActorId> &ids);
 
+    /// Retrieve the changes to the episode's actor list since
+    /// @a known_version, so the local cache can be reconciled without
+    /// re-downloading every actor description.
+    rpc::ActorListDiff GetActorListDiff(uint64_t known_version);
+
     rpc::VehiclePhysicsControl GetVehiclePhysicsControl(rpc::ActorId vehicle) const;
 
     rpc::VehicleLightState GetVehicleLightState(rpc::ActorId vehicle) const;
@@ -130,14 +162,33 @@ namespace detail {
         const rpc::ActorDescription &description,
         const geom::Transform &transform);
 
+    /// Like SpawnActor, but the request is pipelined behind any other call
+    /// in flight on the connection and the reply is only waited for when
+    /// the returned future is queried, so independent calls overlap their
+    /// round trips.
+    std::future<rpc::Actor> SpawnActorAsync(
+        const rpc::ActorDescription &description,
+        const geom::Transform &transform);
+
     rpc::Actor SpawnActorWithParent(
         const rpc::ActorDescription &description,
         const geom::Transform &transform,
         rpc::ActorId parent,
         rpc::AttachmentType attachment_type);
 
+    /// @copydoc SpawnActorAsync
+    std::future<rpc::Actor> SpawnActorWithParentAsync(
+        const rpc::ActorDescription &description,
+        const geom::Transform &transform,
+        rpc::ActorId parent,
+        rpc::AttachmentType attachment_type);
+
     bool DestroyActor(rpc::ActorId actor);
 
+    /// Pipelined DestroyActor; unlike the synchronous version, errors are
+    /// reported through the returned future rather than logged.
+    std::future<bool> DestroyActorAsync(rpc::ActorId actor);
+
     void SetActorLocation(
         rpc::ActorId actor,
         const geom::Location &location);
@@ -195,6 +246,8 @@ namespace detail {
         rpc::ActorId actor,
         bool enabled);
 
+    rpc::SensorTiming GetSensorTiming(rpc::ActorId sensor) const;
+
     void SetActorAutopilot(
         rpc::ActorId vehicle,
         bool enabled);
@@ -211,6 +264,15 @@ namespace detail {
         rpc::ActorId walker,
         const rpc::WalkerBoneControl &control);
 
+    /// Names of every bone in @a walker's skeleton, in skeleton index order.
+    /// This is the handshake for the packed pose path: fetch once, then
+    /// address bones by index through ApplyBonePoseToWalker.
+    std::vector<std::string> GetWalkerBoneNames(rpc::ActorId walker);
+
+    void ApplyBonePoseToWalker(
+        rpc::ActorId walker,
+        const rpc::WalkerBonePose &pose);
+
     void SetTrafficLightState(
         rpc::ActorId traffic_light,
         const rpc::TrafficLightState trafficLightState);
@@ -257,6 +319,8 @@ namespace detail {
 
     std::string ReplayFile(std::string name, double start, double duration, uint32_t follow_id);
 
+    std::string ReplayBatch(std::vector<std::string> names, double time_factor);
+
     void SetReplayerTimeFactor(double time_factor);
 
     void SetReplayerIgnoreHero(bool ignore_hero);
@@ -271,6 +335,10 @@ namespace detail {
 
     void DrawDebugShape(const rpc::DebugShape &shape);
 
+    /// Same as DrawDebugShape but sending a whole batch of shapes as a
+    /// single command.
+    void DrawDebugShapes(const std::vector<rpc::DebugShape> &shapes);
+
     void ApplyBatch(
         std::vector<rpc::Command> commands,
         bool do_tick_cue);
@@ -279,8 +347,35 @@ namespace detail {
         std::vector<rpc::Command> commands,
         bool do_tick_cue);
 
+    /// Same as ApplyBatch, sending the pre-encoded bytes of @a commands
+    /// instead of serializing a vector of commands per call.
+    void ApplyBatch(
+        const rpc::CommandBuffer &commands,
+        bool do_tick_cue);
+
+    /// @copydoc ApplyBatch(const rpc::CommandBuffer &, bool)
+    std::vector<rpc::CommandResponse> ApplyBatchSync(
+        const rpc::CommandBuffer &commands,
+        bool do_tick_cue);
+
+    /// Queue @a commands server-side to be applied atomically at the top of
+    /// @a target_frame. Returns the frame they were (or will be) applied on;
+    /// if the simulation is already at or past the target, they are applied
+    /// immediately and the actual frame is returned instead.
+    uint64_t ApplyBatchAtFrame(
+        std::vector<rpc::Command> commands,
+        uint64_t target_frame);
+
+    /// Spawn every actor in @a commands within a single simulator step and
+    /// receive all the ids in one response. Sub-commands attached through
+    /// SpawnActor::do_after are executed as in ApplyBatchSync.
+    std::vector<rpc::CommandResponse> SpawnActors(
+        std::vector<rpc::Command::SpawnActor> commands);
+
     uint64_t SendTickCue();
 
+    uint64_t FastForward(double duration, float relevance_radius);
+
     std::vector<rpc::LightState> QueryLightsStateToServer() const;
 
     void UpdateServerLightsState(
@@ -292,6 +387,10 @@ namespace detail {
 
   private:
 
+    /// Pull the payload described by @a descriptor chunk by chunk and undo
+    /// the wire compression; see "pull_bulk_chunk" on the server.
+    std::string PullBulkPayload(const rpc::BulkTransfer &descriptor);
+
     class Pimpl;
     const std::unique_ptr<Pimpl> _pimpl;
   };
@@ -12,6 +12,7 @@
 #include "carla/sensor/Deserializer.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
+#include <chrono>
 #include <exception>
 
 namespace carla {
@@ -40,8 +41,97 @@ using namespace std::chrono_literals;
   Episode::Episode(Client &client, const rpc::EpisodeInfo &info)
     : _client(client),
       _state(std::make_shared<EpisodeState>(info.id)),
+      _state_pool(std::make_shared<StatePool>()),
       _token(info.token) {}
 
+  std::shared_ptr<const EpisodeState> Episode::MakePooledState(
+      const sensor::data::RawEpisodeState &state) {
+    auto next = PopPooledState();
+    if (next == nullptr) {
+      next = std::make_unique<EpisodeState>(state);
+    } else {
+      next->Assign(state);
+    }
+    return WrapPooledState(std::move(next));
+  }
+
+  std::shared_ptr<const EpisodeState> Episode::MakePooledDeltaState(
+      const sensor::data::RawEpisodeState &state,
+      const EpisodeState &previous) {
+    if ((previous.GetEpisodeId() != state.GetEpisodeId()) ||
+        (previous.GetFrame() + 1u != state.GetFrame())) {
+      return nullptr;
+    }
+    auto next = PopPooledState();
+    if (next == nullptr) {
+      next = std::make_unique<EpisodeState>(state.GetEpisodeId());
+    }
+    next->AssignDelta(state, previous);
+    return WrapPooledState(std::move(next));
+  }
+
+  std::unique_ptr<EpisodeState> Episode::PopPooledState() {
+    std::unique_ptr<EpisodeState> next;
+    std::lock_guard<std::mutex> lock(_state_pool->mutex);
+    if (!_state_pool->states.empty()) {
+      next = std::move(_state_pool->states.back());
+      _state_pool->states.pop_back();
+    }
+    return next;
+  }
+
+  std::shared_ptr<const EpisodeState> Episode::WrapPooledState(
+      std::unique_ptr<EpisodeState> state) {
+    // Recycle through the pool when the last reference is dropped; keep a
+    // couple of spares so the steady state is current plus previous frame.
+    const size_t footprint = state->MemoryFootprint();
+    const size_t live = _state_pool->live_states.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    _state_pool->live_bytes.fetch_add(footprint, std::memory_order_relaxed);
+    // A handful of states alive is normal (current, previous, snapshots in
+    // flight through callbacks); past that, user code is retaining them.
+    // Warn at every doubling so a stalled consumer shows up in the log
+    // before the retained set grows into gigabytes.
+    if ((live >= 16u) && ((live & (live - 1u)) == 0u)) {
+      log_warning(
+          live, "episode states retained (~",
+          _state_pool->live_bytes.load(std::memory_order_relaxed) / (1024u * 1024u),
+          "MiB); user-held snapshots are only freed when their last reference drops");
+    }
+    std::weak_ptr<StatePool> weak_pool = _state_pool;
+    return std::shared_ptr<const EpisodeState>(
+        state.release(),
+        [weak_pool, footprint](const EpisodeState *ptr) {
+          auto pool = weak_pool.lock();
+          if (pool != nullptr) {
+            pool->live_states.fetch_sub(1u, std::memory_order_relaxed);
+            pool->live_bytes.fetch_sub(footprint, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(pool->mutex);
+            if (pool->states.size() < pool->max_spares) {
+              pool->states.emplace_back(const_cast<EpisodeState *>(ptr));
+              return;
+            }
+          }
+          delete ptr;
+        });
+  }
+
+  StateRetentionMetrics Episode::GetStateRetentionMetrics() const {
+    StateRetentionMetrics metrics;
+    metrics.live_states = _state_pool->live_states.load(std::memory_order_relaxed);
+    metrics.live_bytes = _state_pool->live_bytes.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(_state_pool->mutex);
+    metrics.pooled_states = _state_pool->states.size();
+    return metrics;
+  }
+
+  void Episode::SetMaxPooledStates(size_t count) {
+    std::lock_guard<std::mutex> lock(_state_pool->mutex);
+    _state_pool->max_spares = count;
+    while (_state_pool->states.size() > count) {
+      _state_pool->states.pop_back();
+    }
+  }
+
   Episode::~Episode() {
     try {
       _client.UnSubscribeFromStream(_token);
@@ -54,13 +144,38 @@ using namespace std::chrono_literals;
     std::weak_ptr<Episode> weak = shared_from_this();
     _client.SubscribeToStream(_token, [weak](auto buffer) {
       auto self = weak.lock();
+      if (self == nullptr) {
+        return;
+      }
 
-      if (self != nullptr) {
+      try {
+
+        // Only pay for the phase timestamps while the watchdog is armed.
+        const bool watching = self->_tick_watchdog.GetBudget() > 0.0;
+        const auto arrival = watching
+            ? std::chrono::steady_clock::now()
+            : std::chrono::steady_clock::time_point{};
 
         auto data = sensor::Deserializer::Deserialize(std::move(buffer));
-        auto next = std::make_shared<const EpisodeState>(CastData(*data));
+        const auto &raw_state = CastData(*data);
         auto prev = self->GetState();
 
+        std::shared_ptr<const EpisodeState> next;
+        if (raw_state.IsDeltaFrame()) {
+          next = self->MakePooledDeltaState(raw_state, *prev);
+          if (next == nullptr) {
+            // No base state to patch (e.g. we just subscribed); drop ticks
+            // until the next keyframe arrives.
+            return;
+          }
+        } else {
+          next = self->MakePooledState(raw_state);
+        }
+
+        const auto deserialized = watching
+            ? std::chrono::steady_clock::now()
+            : std::chrono::steady_clock::time_point{};
+
         // TODO: Update how the map change is detected
         // bool HasMapChanged = next->HasMapChanged();
         bool UpdateLights = next->IsLightUpdatePending();
@@ -105,9 +220,38 @@ using namespace std::chrono_literals;
             navigation->Tick(self);
           }
 
+          const auto callbacks_begin = watching
+              ? std::chrono::steady_clock::now()
+              : std::chrono::steady_clock::time_point{};
+
           // Call user callbacks.
           self->_on_tick_callbacks.Call(next);
+
+          // Fire and drop the one-shot callbacks waiting for this tick.
+          std::vector<std::function<void(WorldSnapshot)>> one_shots;
+          {
+            std::lock_guard<std::mutex> lock(self->_on_next_tick_mutex);
+            one_shots.swap(self->_on_next_tick_callbacks);
+          }
+          for (auto &callback : one_shots) {
+            callback(next);
+          }
+
+          if (watching) {
+            using ms = std::chrono::duration<double, std::milli>;
+            self->_tick_watchdog.RecordStreamPhases(
+                next->GetFrame(),
+                ms(deserialized - arrival).count(),
+                ms(std::chrono::steady_clock::now() - callbacks_begin).count());
+          }
         }
+      } catch (const std::exception &e) {
+        // Decode failures and throwing user callbacks are recoverable: drop
+        // the frame, report it, and keep the stream alive instead of
+        // unwinding through the streaming worker.
+        log_error("episode stream: dropping frame:", e.what());
+        self->_on_error_callbacks.Call(std::current_exception());
+        self->_snapshot.SetException(std::runtime_error(e.what()));
       }
     });
   }
@@ -141,11 +285,33 @@ using namespace std::chrono_literals;
   }
 
   std::vector<rpc::Actor> Episode::GetActors() {
+    // Reconcile the cached list incrementally: ask the server only for what
+    // changed since the registry version we already know about, instead of
+    // re-downloading the description of every missing actor.
+    auto diff = _client.GetActorListDiff(_actor_list_version);
+    if (diff.is_full_list) {
+      _actors.Clear();
+    }
+    for (auto id : diff.removed) {
+      _actors.Remove(id);
+    }
+    for (const auto &actor : diff.added) {
+      // An id can be reused when an actor is re-registered; drop any stale
+      // entry so the fresh description wins.
+      _actors.Remove(actor.id);
+    }
+    _actors.InsertRange(std::move(diff.added));
+    _actor_list_version = diff.version;
     return GetActorsById_Impl(_client, _actors, GetState()->GetActorIds());
   }
 
+  rpc::ActorListDiff Episode::GetActorListDiff(uint64_t known_version) {
+    return _client.GetActorListDiff(known_version);
+  }
+
   void Episode::OnEpisodeStarted() {
     _actors.Clear();
+    _actor_list_version = 0u;
     _on_tick_callbacks.Clear();
     _navigation.reset();
     traffic_manager::TrafficManager::Release();
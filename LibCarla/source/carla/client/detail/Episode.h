@@ -14,9 +14,16 @@
 #include "carla/client/detail/CachedActorList.h"
 #include "carla/client/detail/CallbackList.h"
 #include "carla/client/detail/EpisodeState.h"
+#include "carla/client/detail/StateRetentionMetrics.h"
+#include "carla/client/detail/TickWatchdog.h"
 #include "carla/client/detail/WalkerNavigation.h"
+#include "carla/rpc/ActorListDiff.h"
 #include "carla/rpc/EpisodeInfo.h"
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace carla {
@@ -49,6 +56,12 @@ namespace detail {
       return _state.load();
     }
 
+    StateRetentionMetrics GetStateRetentionMetrics() const;
+
+    /// Cap the number of spare states kept for recycling between ticks;
+    /// anything above the cap is freed instead of pooled.
+    void SetMaxPooledStates(size_t count);
+
     std::shared_ptr<WalkerNavigation> CreateNavigationIfMissing();
 
     std::shared_ptr<WalkerNavigation> GetNavigation() const {
@@ -67,6 +80,11 @@ namespace detail {
 
     std::vector<rpc::Actor> GetActors();
 
+    /// Changes to the server-side actor registry since @a known_version.
+    /// Unlike GetActors this does not touch the cached list; callers keep
+    /// their own version cursor.
+    rpc::ActorListDiff GetActorListDiff(uint64_t known_version);
+
     boost::optional<WorldSnapshot> WaitForState(time_duration timeout) {
       return _snapshot.WaitFor(timeout);
     }
@@ -75,6 +93,14 @@ namespace detail {
       return _on_tick_callbacks.Push(std::move(callback));
     }
 
+    /// Invoke @a callback exactly once on the next tick received and then
+    /// drop it. Unlike WaitForState this does not park a thread, so a single
+    /// reactor thread can drive many episodes.
+    void OnNextTick(std::function<void(WorldSnapshot)> callback) {
+      std::lock_guard<std::mutex> lock(_on_next_tick_mutex);
+      _on_next_tick_callbacks.emplace_back(std::move(callback));
+    }
+
     void RemoveOnTickEvent(size_t id) {
       _on_tick_callbacks.Remove(id);
     }
@@ -91,6 +117,18 @@ namespace detail {
       return _on_light_update_callbacks.Push(std::move(callback));
     }
 
+    /// Invoked from the streaming thread when a tick could not be processed
+    /// (decode failure or a throwing user callback). The frame is dropped
+    /// and the stream keeps running; without a listener the error is only
+    /// logged and surfaced to threads blocked on WaitForState.
+    size_t RegisterOnErrorEvent(std::function<void(std::exception_ptr)> callback) {
+      return _on_error_callbacks.Push(std::move(callback));
+    }
+
+    void RemoveOnErrorEvent(size_t id) {
+      _on_error_callbacks.Remove(id);
+    }
+
     void RemoveLightUpdateChangeEvent(size_t id) {
       _on_light_update_callbacks.Remove(id);
     }
@@ -101,6 +139,10 @@ namespace detail {
       nav->SetPedestriansCrossFactor(percentage);
     }
 
+    TickWatchdog &GetTickWatchdog() {
+      return _tick_watchdog;
+    }
+
     void AddPendingException(std::string e) {
       _pending_exceptions = true;
       _pending_exceptions_msg = e;
@@ -110,6 +152,40 @@ namespace detail {
 
     Episode(Client &client, const rpc::EpisodeInfo &info);
 
+    /// States returned to the pool keep their actor map storage, so the next
+    /// tick refills them without reallocating. The pool also carries the
+    /// retention counters, so states outliving the episode still settle them
+    /// on release.
+    struct StatePool {
+      std::mutex mutex;
+      std::vector<std::unique_ptr<EpisodeState>> states;
+      size_t max_spares = 4u;
+      std::atomic<size_t> live_states{0u};
+      std::atomic<size_t> live_bytes{0u};
+    };
+
+    /// Build the state for a new tick from a pooled EpisodeState if one is
+    /// available; the state returns to the pool once the last reference to it
+    /// is dropped.
+    std::shared_ptr<const EpisodeState> MakePooledState(
+        const sensor::data::RawEpisodeState &state);
+
+    /// Same as MakePooledState, for a delta frame applied on top of
+    /// @a previous. Returns nullptr if @a previous is not the frame the delta
+    /// was encoded against, in which case the tick has to be dropped until
+    /// the next keyframe arrives.
+    std::shared_ptr<const EpisodeState> MakePooledDeltaState(
+        const sensor::data::RawEpisodeState &state,
+        const EpisodeState &previous);
+
+    /// Pop a recycled state from the pool, or null if the pool is empty.
+    std::unique_ptr<EpisodeState> PopPooledState();
+
+    /// Hand ownership of @a state to a shared pointer that returns it to the
+    /// pool once the last reference is dropped.
+    std::shared_ptr<const EpisodeState> WrapPooledState(
+        std::unique_ptr<EpisodeState> state);
+
     void OnEpisodeStarted();
 
     void OnEpisodeChanged();
@@ -118,20 +194,34 @@ namespace detail {
 
     AtomicSharedPtr<const EpisodeState> _state;
 
+    std::shared_ptr<StatePool> _state_pool;
+
     AtomicSharedPtr<WalkerNavigation> _navigation;
 
     std::string _pending_exceptions_msg;
 
     CachedActorList _actors;
 
+    /// Server-side actor registry version _actors was last reconciled
+    /// against; see Client::GetActorListDiff.
+    std::atomic<uint64_t> _actor_list_version{0u};
+
     CallbackList<WorldSnapshot> _on_tick_callbacks;
 
+    std::mutex _on_next_tick_mutex;
+
+    std::vector<std::function<void(WorldSnapshot)>> _on_next_tick_callbacks;
+
     CallbackList<WorldSnapshot> _on_map_change_callbacks;
 
     CallbackList<WorldSnapshot> _on_light_update_callbacks;
 
+    CallbackList<std::exception_ptr> _on_error_callbacks;
+
     RecurrentSharedFuture<WorldSnapshot> _snapshot;
 
+    TickWatchdog _tick_watchdog;
+
     const streaming::Token _token;
 
     bool _pending_exceptions = false;
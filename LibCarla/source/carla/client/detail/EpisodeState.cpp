@@ -11,13 +11,21 @@ namespace client {
 namespace detail {
 
   EpisodeState::EpisodeState(const sensor::data::RawEpisodeState &state)
-    : _episode_id(state.GetEpisodeId()),
-      _timestamp(
-          state.GetFrame(),
-          state.GetGameTimeStamp(),
-          state.GetDeltaSeconds(),
-          state.GetPlatformTimeStamp()),
-      _simulation_state(state.GetSimulationState()) {
+    : _episode_id(0u) {
+    Assign(state);
+  }
+
+  void EpisodeState::Assign(const sensor::data::RawEpisodeState &state) {
+    _episode_id = state.GetEpisodeId();
+    _timestamp = Timestamp(
+        state.GetFrame(),
+        state.GetGameTimeStamp(),
+        state.GetDeltaSeconds(),
+        state.GetPlatformTimeStamp());
+    _simulation_state = state.GetSimulationState();
+    // clear keeps the bucket array, so a recycled state refills without
+    // rehashing or touching the allocator.
+    _actors.clear();
     _actors.reserve(state.size());
     for (auto &&actor : state) {
       DEBUG_ONLY(auto result = )
@@ -34,6 +42,31 @@ namespace detail {
     }
   }
 
+  void EpisodeState::AssignDelta(
+      const sensor::data::RawEpisodeState &state,
+      const EpisodeState &previous) {
+    DEBUG_ASSERT(state.IsDeltaFrame());
+    _episode_id = state.GetEpisodeId();
+    _timestamp = Timestamp(
+        state.GetFrame(),
+        state.GetGameTimeStamp(),
+        state.GetDeltaSeconds(),
+        state.GetPlatformTimeStamp());
+    _simulation_state = state.GetSimulationState();
+    _actors.clear();
+    _actors.reserve(previous._actors.size());
+    _actors.insert(previous._actors.begin(), previous._actors.end());
+    for (auto &&actor : state) {
+      _actors[actor.id] = ActorSnapshot{
+          actor.id,
+          actor.transform,
+          actor.velocity,
+          actor.angular_velocity,
+          actor.acceleration,
+          actor.state};
+    }
+  }
+
 } // namespace detail
 } // namespace client
 } // namespace carla
@@ -17,11 +17,14 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace client {
 namespace detail {
 
+  class Episode;
+
   /// Represents the state of all the actors of an episode at a given frame.
   class EpisodeState
     : public std::enable_shared_from_this<EpisodeState>,
@@ -81,10 +84,48 @@ namespace detail {
           iterator::make_map_keys_const_iterator(_actors.end()));
     }
 
+    /// Copy the state of every actor into flat parallel arrays: one id, one
+    /// [x, y, z, pitch, yaw, roll] transform row and one [x, y, z] velocity
+    /// row per actor, all three in the same order. Meant for language
+    /// bindings that would otherwise create one object per ActorSnapshot.
+    void CopyPackedActorState(
+        std::vector<ActorId> &ids,
+        std::vector<float> &transforms,
+        std::vector<float> &velocities) const {
+      ids.clear();
+      transforms.clear();
+      velocities.clear();
+      ids.reserve(_actors.size());
+      transforms.reserve(6u * _actors.size());
+      velocities.reserve(3u * _actors.size());
+      for (const auto &pair : _actors) {
+        const ActorSnapshot &snapshot = pair.second;
+        ids.push_back(snapshot.id);
+        transforms.push_back(snapshot.transform.location.x);
+        transforms.push_back(snapshot.transform.location.y);
+        transforms.push_back(snapshot.transform.location.z);
+        transforms.push_back(snapshot.transform.rotation.pitch);
+        transforms.push_back(snapshot.transform.rotation.yaw);
+        transforms.push_back(snapshot.transform.rotation.roll);
+        velocities.push_back(snapshot.velocity.x);
+        velocities.push_back(snapshot.velocity.y);
+        velocities.push_back(snapshot.velocity.z);
+      }
+    }
+
     size_t size() const {
       return _actors.size();
     }
 
+    /// Approximate heap footprint of this state, dominated by the actor
+    /// snapshot map. Episode aggregates it to report how much memory the
+    /// states still referenced by user code are holding on to.
+    size_t MemoryFootprint() const {
+      return sizeof(EpisodeState)
+          + _actors.bucket_count() * sizeof(void *)
+          + _actors.size() * (sizeof(std::pair<const ActorId, ActorSnapshot>) + 2u * sizeof(void *));
+    }
+
     auto begin() const {
       return iterator::make_map_values_const_iterator(_actors.begin());
     }
@@ -95,6 +136,20 @@ namespace detail {
 
   private:
 
+    friend class Episode;
+
+    /// Refill this state from a new tick, reusing the actor map's bucket
+    /// storage. Only safe while nobody else holds a reference; Episode calls
+    /// it on states recycled through its snapshot pool.
+    void Assign(const sensor::data::RawEpisodeState &state);
+
+    /// Refill this state from a delta frame, starting from @a previous and
+    /// patching in the actors carried by @a state. Same ownership caveats as
+    /// Assign.
+    void AssignDelta(
+        const sensor::data::RawEpisodeState &state,
+        const EpisodeState &previous);
+
     template <typename T>
     void CopyActorSnapshotIfPresent(ActorId id, T &value) const {
       auto it = _actors.find(id);
@@ -103,9 +158,9 @@ namespace detail {
       }
     }
 
-    const uint64_t _episode_id;
+    uint64_t _episode_id;
 
-    const Timestamp _timestamp;
+    Timestamp _timestamp;
 
     SimulationState _simulation_state;
 
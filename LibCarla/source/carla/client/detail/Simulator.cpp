@@ -10,6 +10,7 @@
 #include "carla/Exception.h"
 #include "carla/Logging.h"
 #include "carla/RecurrentSharedFuture.h"
+#include "carla/StringUtil.h"
 #include "carla/client/BlueprintLibrary.h"
 #include "carla/client/Map.h"
 #include "carla/client/Sensor.h"
@@ -17,8 +18,10 @@
 #include "carla/client/WalkerAIController.h"
 #include "carla/client/detail/ActorFactory.h"
 #include "carla/trafficmanager/TrafficManager.h"
+#include "carla/sensor/DecodeDispatcher.h"
 #include "carla/sensor/Deserializer.h"
 
+#include <chrono>
 #include <exception>
 #include <thread>
 
@@ -133,22 +136,44 @@ namespace detail {
   // -- Tick -------------------------------------------------------------------
   // ===========================================================================
 
+  /// Milliseconds elapsed since @a start, or zero when not watching.
+  static double ElapsedMs(bool watching, std::chrono::steady_clock::time_point start) {
+    return watching
+        ? std::chrono::duration<double, std::milli>(
+              std::chrono::steady_clock::now() - start).count()
+        : 0.0;
+  }
+
   WorldSnapshot Simulator::WaitForTick(time_duration timeout) {
     DEBUG_ASSERT(_episode != nullptr);
+    auto &watchdog = _episode->GetTickWatchdog();
+    const bool watching = watchdog.GetBudget() > 0.0;
+    const auto start = std::chrono::steady_clock::now();
     auto result = _episode->WaitForState(timeout);
     if (!result.has_value()) {
       throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
     }
+    if (watching) {
+      watchdog.Check(result->GetFrame(), 0.0, ElapsedMs(watching, start));
+    }
     return *result;
   }
 
   uint64_t Simulator::Tick(time_duration timeout) {
     DEBUG_ASSERT(_episode != nullptr);
+    auto &watchdog = _episode->GetTickWatchdog();
+    const bool watching = watchdog.GetBudget() > 0.0;
+    const auto rpc_start = std::chrono::steady_clock::now();
     const auto frame = _client.SendTickCue();
+    const auto rpc_ms = ElapsedMs(watching, rpc_start);
+    const auto wait_start = std::chrono::steady_clock::now();
     bool result = SynchronizeFrame(frame, *_episode, timeout);
     if (!result) {
       throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
     }
+    if (watching) {
+      watchdog.Check(frame, rpc_ms, ElapsedMs(watching, wait_start));
+    }
     return frame;
   }
 
@@ -157,12 +182,39 @@ namespace detail {
   // ===========================================================================
 
   SharedPtr<BlueprintLibrary> Simulator::GetBlueprintLibrary() {
+    // The full definitions list is around a megabyte of msgpack; probe the
+    // server-side version counter first and only re-download the library if
+    // it changed since the last call (or the episode did).
+    const auto episode_id = GetCurrentEpisode().GetId();
+    const auto version = _client.GetBlueprintLibraryVersion();
+    if ((_cached_blueprint_library != nullptr) &&
+        (_cached_blueprint_library_version == version) &&
+        (_cached_blueprint_library_episode == episode_id)) {
+      return _cached_blueprint_library;
+    }
     auto defs = _client.GetActorDefinitions();
-    return MakeShared<BlueprintLibrary>(std::move(defs));
+    _cached_blueprint_library = MakeShared<BlueprintLibrary>(std::move(defs));
+    _cached_blueprint_library_version = version;
+    _cached_blueprint_library_episode = episode_id;
+    return _cached_blueprint_library;
   }
 
   rpc::VehicleLightStateList Simulator::GetVehiclesLightStates() {
-    return _client.GetVehiclesLightStates();
+    // The light states ride the world-observer stream with the rest of the
+    // per-actor dynamic state, so the list is assembled from the latest
+    // snapshot instead of polling the server.
+    rpc::VehicleLightStateList result;
+    auto state = _episode->GetState();
+    for (const auto &actor : _episode->GetActors()) {
+      if (!StringUtil::StartsWith(actor.description.id, "vehicle")) {
+        continue;
+      }
+      auto snapshot = state->GetActorSnapshotIfPresent(actor.id);
+      if (snapshot.has_value()) {
+        result.emplace_back(actor.id, snapshot->state.vehicle_data.light_state);
+      }
+    }
+    return result;
   }
 
   SharedPtr<Actor> Simulator::GetSpectator() {
@@ -223,6 +275,13 @@ namespace detail {
     navigation->SetPedestriansCrossFactor(percentage);
   }
 
+  void Simulator::SetPedestriansSeed(unsigned int seed) {
+    DEBUG_ASSERT(_episode != nullptr);
+    auto navigation = _episode->CreateNavigationIfMissing();
+    DEBUG_ASSERT(navigation != nullptr);
+    navigation->SetPedestriansSeed(seed);
+  }
+
   // ===========================================================================
   // -- General operations with actors -----------------------------------------
   // ===========================================================================
@@ -257,6 +316,30 @@ namespace detail {
     return result;
   }
 
+  std::future<SharedPtr<Actor>> Simulator::SpawnActorAsync(
+      const ActorBlueprint &blueprint,
+      const geom::Transform &transform,
+      Actor *parent,
+      rpc::AttachmentType attachment_type,
+      GarbageCollectionPolicy gc) {
+    DEBUG_ASSERT(_episode != nullptr);
+    auto future_actor = (parent != nullptr)
+        ? _client.SpawnActorWithParentAsync(
+              blueprint.MakeActorDescription(),
+              transform,
+              parent->GetId(),
+              attachment_type)
+        : _client.SpawnActorAsync(blueprint.MakeActorDescription(), transform);
+    const auto gca = (gc == GarbageCollectionPolicy::Inherit ? _gc_policy : gc);
+    auto self = shared_from_this();
+    return std::async(std::launch::deferred,
+        [self, gca, future_actor=std::move(future_actor)]() mutable {
+          auto actor = future_actor.get();
+          self->_episode->RegisterActor(actor);
+          return ActorFactory::MakeActor(EpisodeProxy{self}, actor, gca);
+        });
+  }
+
   bool Simulator::DestroyActor(Actor &actor) {
     bool success = true;
     success = _client.DestroyActor(actor.GetId());
@@ -278,19 +361,26 @@ namespace detail {
       const Sensor &sensor,
       std::function<void(SharedPtr<sensor::SensorData>)> callback) {
     DEBUG_ASSERT(_episode != nullptr);
-    _client.SubscribeToStream(
-        sensor.GetActorDescription().GetStreamToken(),
-        [cb=std::move(callback), ep=WeakEpisodeProxy{shared_from_this()}](auto buffer) {
-          auto data = sensor::Deserializer::Deserialize(std::move(buffer));
+    auto decoder = std::make_shared<sensor::DecodeDispatcher>(
+        [cb=std::move(callback), ep=WeakEpisodeProxy{shared_from_this()}](auto data) {
           data->_episode = ep.TryLock();
           cb(std::move(data));
         });
+    _client.SubscribeToStream(
+        sensor.GetActorDescription().GetStreamToken(),
+        [decoder](auto buffer) {
+          decoder->Decode(std::move(buffer));
+        });
   }
 
   void Simulator::UnSubscribeFromSensor(const Sensor &sensor) {
     _client.UnSubscribeFromStream(sensor.GetActorDescription().GetStreamToken());
   }
 
+  rpc::SensorTiming Simulator::GetSensorTiming(const Sensor &sensor) {
+    return _client.GetSensorTiming(sensor.GetId());
+  }
+
   void Simulator::FreezeAllTrafficLights(bool frozen) {
     _client.FreezeAllTrafficLights(frozen);
   }
@@ -26,6 +26,7 @@
 
 #include <boost/optional.hpp>
 
+#include <future>
 #include <memory>
 
 namespace carla {
@@ -98,6 +99,16 @@ namespace detail {
       return WorldSnapshot{_episode->GetState()};
     }
 
+    StateRetentionMetrics GetStateRetentionMetrics() const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetStateRetentionMetrics();
+    }
+
+    void SetMaxPooledStates(size_t count) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->SetMaxPooledStates(count);
+    }
+
     /// @}
     // =========================================================================
     /// @name Map related methods
@@ -155,6 +166,13 @@ namespace detail {
       return _episode->RegisterOnTickEvent(std::move(callback));
     }
 
+    /// Non-blocking alternative to WaitForTick: @a callback is invoked
+    /// exactly once on the next tick and then dropped.
+    void OnNextTick(std::function<void(WorldSnapshot)> callback) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->OnNextTick(std::move(callback));
+    }
+
     void RemoveOnTickEvent(size_t id) {
       DEBUG_ASSERT(_episode != nullptr);
       _episode->RemoveOnTickEvent(id);
@@ -162,6 +180,30 @@ namespace detail {
 
     uint64_t Tick(time_duration timeout);
 
+    uint64_t FastForward(double duration, float relevance_radius) {
+      return _client.FastForward(duration, relevance_radius);
+    }
+
+    /// Budget in milliseconds a tick is allowed to take before the
+    /// registered budget-violation callbacks fire; zero (the default)
+    /// disables the watchdog.
+    void SetTickBudget(double budget_ms) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->GetTickWatchdog().SetBudget(budget_ms);
+    }
+
+    /// Register @a callback to be invoked with the phase breakdown of every
+    /// tick that exceeds the budget; see TickTiming.
+    size_t RegisterTickBudgetViolationEvent(std::function<void(TickTiming)> callback) {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetTickWatchdog().RegisterCallback(std::move(callback));
+    }
+
+    void RemoveTickBudgetViolationEvent(size_t id) {
+      DEBUG_ASSERT(_episode != nullptr);
+      _episode->GetTickWatchdog().RemoveCallback(id);
+    }
+
     /// @}
     // =========================================================================
     /// @name Access to global objects in the episode
@@ -210,6 +252,10 @@ namespace detail {
 
     uint64_t SetEpisodeSettings(const rpc::EpisodeSettings &settings);
 
+    rpc::FrameStats GetFrameStats() const {
+      return _client.GetFrameStats();
+    }
+
     rpc::WeatherParameters GetWeatherParameters() {
       return _client.GetWeatherParameters();
     }
@@ -218,6 +264,14 @@ namespace detail {
       _client.SetWeatherParameters(weather);
     }
 
+    void PrewarmWeatherPresets(const std::vector<rpc::WeatherParameters> &presets) {
+      _client.PrewarmWeatherPresets(presets);
+    }
+
+    void PrefetchRoute(const std::vector<geom::Location> &route, float lookahead) {
+      _client.PrefetchRoute(route, lookahead);
+    }
+
     rpc::VehiclePhysicsControl GetVehiclePhysicsControl(const Vehicle &vehicle) const {
       return _client.GetVehiclePhysicsControl(vehicle.GetId());
     }
@@ -249,6 +303,8 @@ namespace detail {
 
     void SetPedestriansCrossFactor(float percentage);
 
+    void SetPedestriansSeed(unsigned int seed);
+
     /// @}
     // =========================================================================
     /// @name General operations with actors
@@ -270,6 +326,12 @@ namespace detail {
       return _episode->GetActors();
     }
 
+    /// Changes to the server-side actor registry since @a known_version.
+    rpc::ActorListDiff GetActorListDiff(uint64_t known_version) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->GetActorListDiff(known_version);
+    }
+
     /// Creates an actor instance out of a description of an existing actor.
     /// Note that this does not spawn an actor.
     ///
@@ -296,6 +358,17 @@ namespace detail {
         rpc::AttachmentType attachment_type = rpc::AttachmentType::Rigid,
         GarbageCollectionPolicy gc = GarbageCollectionPolicy::Inherit);
 
+    /// Pipelined SpawnActor; the request is sent immediately and the
+    /// returned future resolves into the actor once the server replies, so
+    /// several independent spawns overlap their round trips instead of
+    /// stacking them.
+    std::future<SharedPtr<Actor>> SpawnActorAsync(
+        const ActorBlueprint &blueprint,
+        const geom::Transform &transform,
+        Actor *parent = nullptr,
+        rpc::AttachmentType attachment_type = rpc::AttachmentType::Rigid,
+        GarbageCollectionPolicy gc = GarbageCollectionPolicy::Inherit);
+
     bool DestroyActor(Actor &actor);
 
     ActorSnapshot GetActorSnapshot(ActorId actor_id) const {
@@ -408,6 +481,14 @@ namespace detail {
       _client.ApplyBoneControlToWalker(walker.GetId(), control);
     }
 
+    std::vector<std::string> GetWalkerBoneNames(const Walker &walker) {
+      return _client.GetWalkerBoneNames(walker.GetId());
+    }
+
+    void ApplyBonePoseToWalker(Walker &walker, const rpc::WalkerBonePose &pose) {
+      _client.ApplyBonePoseToWalker(walker.GetId(), pose);
+    }
+
     void ApplyPhysicsControlToVehicle(Vehicle &vehicle, const rpc::VehiclePhysicsControl &physicsControl) {
       _client.ApplyPhysicsControlToVehicle(vehicle.GetId(), physicsControl);
     }
@@ -446,6 +527,10 @@ namespace detail {
       return _client.ReplayFile(std::move(name), start, duration, follow_id);
     }
 
+    std::string ReplayBatch(std::vector<std::string> names, double time_factor) {
+      return _client.ReplayBatch(std::move(names), time_factor);
+    }
+
     void SetReplayerTimeFactor(double time_factor) {
       _client.SetReplayerTimeFactor(time_factor);
     }
@@ -470,6 +555,8 @@ namespace detail {
 
     void UnSubscribeFromSensor(const Sensor &sensor);
 
+    rpc::SensorTiming GetSensorTiming(const Sensor &sensor);
+
     /// @}
     // =========================================================================
     /// @name Operations with traffic lights
@@ -518,6 +605,10 @@ namespace detail {
       _client.DrawDebugShape(shape);
     }
 
+    void DrawDebugShapes(const std::vector<rpc::DebugShape> &shapes) {
+      _client.DrawDebugShapes(shapes);
+    }
+
     /// @}
     // =========================================================================
     /// @name Apply commands in batch
@@ -532,6 +623,22 @@ namespace detail {
       return _client.ApplyBatchSync(std::move(commands), do_tick_cue);
     }
 
+    void ApplyBatch(const rpc::CommandBuffer &commands, bool do_tick_cue) {
+      _client.ApplyBatch(commands, do_tick_cue);
+    }
+
+    auto ApplyBatchSync(const rpc::CommandBuffer &commands, bool do_tick_cue) {
+      return _client.ApplyBatchSync(commands, do_tick_cue);
+    }
+
+    auto ApplyBatchAtFrame(std::vector<rpc::Command> commands, uint64_t target_frame) {
+      return _client.ApplyBatchAtFrame(std::move(commands), target_frame);
+    }
+
+    auto SpawnActors(std::vector<rpc::Command::SpawnActor> commands) {
+      return _client.SpawnActors(std::move(commands));
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations lights
@@ -564,6 +671,12 @@ namespace detail {
 
     void FreezeAllTrafficLights(bool frozen);
 
+    /// Reset the episode keeping the level resident; see
+    /// Client::FastResetEpisode.
+    void FastReset() {
+      _client.FastResetEpisode();
+    }
+
     /// @}
 
   private:
@@ -575,6 +688,14 @@ namespace detail {
     std::shared_ptr<Episode> _episode;
 
     const GarbageCollectionPolicy _gc_policy;
+
+    /// Cache for GetBlueprintLibrary, valid while the server keeps reporting
+    /// the same library version for the same episode.
+    SharedPtr<BlueprintLibrary> _cached_blueprint_library;
+
+    uint64_t _cached_blueprint_library_version = 0u;
+
+    uint64_t _cached_blueprint_library_episode = 0u;
   };
 
 } // namespace detail
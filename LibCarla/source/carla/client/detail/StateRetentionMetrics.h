@@ -0,0 +1,34 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Counters over the episode states a client keeps alive for its world
+  /// snapshots. States are freed by whoever drops the last reference, so
+  /// live_states growing without bound means user code is holding on to old
+  /// snapshots.
+  struct StateRetentionMetrics {
+
+    /// States currently alive, including the current one and any still
+    /// referenced by user code.
+    size_t live_states = 0u;
+
+    /// Approximate heap bytes held by those states.
+    size_t live_bytes = 0u;
+
+    /// Spare states parked in the recycling pool.
+    size_t pooled_states = 0u;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
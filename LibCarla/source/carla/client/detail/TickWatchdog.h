@@ -0,0 +1,131 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/client/detail/CallbackList.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Breakdown of where one tick's latency went, in milliseconds.
+  struct TickTiming {
+
+    uint64_t frame = 0u;
+
+    /// Tick cue RPC round trip; only filled in synchronous mode.
+    double rpc_ms = 0.0;
+
+    /// Time spent blocked waiting for the worldstate message.
+    double wait_ms = 0.0;
+
+    /// Rebuilding the EpisodeState from the stream message. Happens while
+    /// the waiting thread is blocked, i.e. this is the part of wait_ms that
+    /// was spent deserializing rather than waiting on the network.
+    double deserialize_ms = 0.0;
+
+    /// User on-tick callbacks, including the one-shot ones. These run on the
+    /// stream thread after the waiter is released and delay the next tick,
+    /// not this one.
+    double callbacks_ms = 0.0;
+
+    /// Deserialization is contained in the wait, so it does not add here.
+    double TotalMs() const {
+      return rpc_ms + wait_ms + callbacks_ms;
+    }
+  };
+
+  /// Watches tick latency against a budget and notifies registered callbacks
+  /// with the phase breakdown whenever a tick exceeds it, so slow ticks can
+  /// be attributed to the phase that caused them instead of just noticed.
+  ///
+  /// The stream thread records the phases it owns (deserialize, callbacks)
+  /// as each worldstate arrives; the thread that waits for the tick adds the
+  /// rpc and wait phases and triggers the budget check. Disabled (the
+  /// default, budget zero) it costs one atomic load per tick.
+  class TickWatchdog : private NonCopyable {
+  public:
+
+    /// A budget of zero (the default) disables the watchdog.
+    void SetBudget(double budget_ms) {
+      _budget_ms.store(budget_ms, std::memory_order_relaxed);
+    }
+
+    double GetBudget() const {
+      return _budget_ms.load(std::memory_order_relaxed);
+    }
+
+    /// Register @a callback to be invoked with the breakdown of every tick
+    /// that exceeds the budget. Called from the thread that waited for the
+    /// tick.
+    size_t RegisterCallback(std::function<void(TickTiming)> callback) {
+      return _callbacks.Push(std::move(callback));
+    }
+
+    void RemoveCallback(size_t id) {
+      _callbacks.Remove(id);
+    }
+
+    /// Record the phases measured on the stream thread for @a frame.
+    void RecordStreamPhases(uint64_t frame, double deserialize_ms, double callbacks_ms) {
+      if (GetBudget() <= 0.0) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stream_frame = frame;
+      _deserialize_ms = deserialize_ms;
+      _callbacks_ms = callbacks_ms;
+    }
+
+    /// Complete the timing of @a frame with the phases measured on the
+    /// waiting thread and fire the callbacks if the total exceeds the budget.
+    void Check(uint64_t frame, double rpc_ms, double wait_ms) {
+      const auto budget_ms = GetBudget();
+      if (budget_ms <= 0.0) {
+        return;
+      }
+      TickTiming timing;
+      timing.frame = frame;
+      timing.rpc_ms = rpc_ms;
+      timing.wait_ms = wait_ms;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stream_frame == frame) {
+          timing.deserialize_ms = _deserialize_ms;
+          timing.callbacks_ms = _callbacks_ms;
+        }
+      }
+      if (timing.TotalMs() > budget_ms) {
+        _callbacks.Call(timing);
+      }
+    }
+
+  private:
+
+    std::atomic<double> _budget_ms{0.0};
+
+    CallbackList<TickTiming> _callbacks;
+
+    std::mutex _mutex;
+
+    /// @name Phases of the latest worldstate, written by the stream thread.
+    /// @{
+    uint64_t _stream_frame = 0u;
+
+    double _deserialize_ms = 0.0;
+
+    double _callbacks_ms = 0.0;
+    /// @}
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
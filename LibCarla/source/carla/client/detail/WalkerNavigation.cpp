@@ -102,8 +102,9 @@ namespace detail {
     // optional debug info
     if (show_debug) {
       if (_nav.GetCrowd() == nullptr) return;
-      
-      // draw bounding boxes for debug
+
+      // draw bounding boxes for debug (vehicles are mirrored into every
+      // crowd shard, so the first shard already holds all of them)
       for (int i = 0; i < _nav.GetCrowd()->getAgentCount(); ++i) {
         // get the agent
         const dtCrowdAgent *agent = _nav.GetCrowd()->getAgent(i);
@@ -144,22 +145,26 @@ namespace detail {
         }
       }
 
-      // draw some text for debug
-      for (int i = 0; i < _nav.GetCrowd()->getAgentCount(); ++i) {
-        // get the agent
-        const dtCrowdAgent *agent = _nav.GetCrowd()->getAgent(i);
-        if (agent) {
-          // draw for debug
-          carla::geom::Location p1(agent->npos[0], agent->npos[2], agent->npos[1] + 1);
-          if (agent->params.userData) {
-            std::ostringstream out;
-            out << *(reinterpret_cast<const float *>(agent->params.userData));
-            carla::rpc::DebugShape text;
-            text.life_time = 0.01f;
-            text.persistent_lines = false;
-            text.primitive = carla::rpc::DebugShape::String {p1, out.str(), false};
-            text.color = { 0, 255, 0 };
-            _client.DrawDebugShape(text);
+      // draw some text for debug, walkers live in one shard each so
+      // every shard must be visited (vehicle copies beyond the first
+      // shard are skipped to avoid drawing them several times)
+      for (int shard = 0; shard < _nav.GetCrowdShardCount(); ++shard) {
+        for (int i = 0; i < _nav.GetCrowd(shard)->getAgentCount(); ++i) {
+          // get the agent
+          const dtCrowdAgent *agent = _nav.GetCrowd(shard)->getAgent(i);
+          if (agent && (shard == 0 || !agent->params.useObb)) {
+            // draw for debug
+            carla::geom::Location p1(agent->npos[0], agent->npos[2], agent->npos[1] + 1);
+            if (agent->params.userData) {
+              std::ostringstream out;
+              out << *(reinterpret_cast<const float *>(agent->params.userData));
+              carla::rpc::DebugShape text;
+              text.life_time = 0.01f;
+              text.persistent_lines = false;
+              text.primitive = carla::rpc::DebugShape::String {p1, out.str(), false};
+              text.color = { 0, 255, 0 };
+              _client.DrawDebugShape(text);
+            }
           }
         }
       }
@@ -85,6 +85,11 @@ namespace detail {
       _nav.SetPedestriansCrossFactor(percentage);
     }
 
+    // set the seed of the per-walker random streams
+    void SetPedestriansSeed(unsigned int seed) {
+      _nav.SetSeed(seed);
+    }
+
   private:
 
     Client &_client;
@@ -0,0 +1,249 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/federation/Coordinator.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/client/Actor.h"
+#include "carla/client/ActorBlueprint.h"
+#include "carla/client/ActorList.h"
+#include "carla/client/BlueprintLibrary.h"
+#include "carla/client/WorldSnapshot.h"
+
+#include <stdexcept>
+
+namespace carla {
+namespace federation {
+
+  /// Only self-propelled actors cross region boundaries; sensors and props
+  /// stay with the instance that spawned them.
+  static bool IsFederatedType(const std::string &type_id) {
+    return
+        (type_id.compare(0u, 8u, "vehicle.") == 0) ||
+        (type_id.compare(0u, 7u, "walker.") == 0);
+  }
+
+  Coordinator::Coordinator(double ghost_margin)
+    : _ghost_margin(ghost_margin) {
+    if (!(ghost_margin > 0.0)) {
+      throw_exception(std::invalid_argument("federation: ghost margin must be positive"));
+    }
+  }
+
+  size_t Coordinator::AddInstance(const std::string &host, uint16_t port, const Region &region) {
+    for (const auto &instance : _instances) {
+      if (instance.region.Overlaps(region)) {
+        throw_exception(std::invalid_argument("federation: regions must be disjoint"));
+      }
+    }
+    client::Client client{host, port};
+    auto world = client.GetWorld();
+    _instances.push_back(Instance{std::move(client), std::move(world), region});
+    _ghost_ids.emplace_back();
+    return _instances.size() - 1u;
+  }
+
+  boost::optional<size_t> Coordinator::FindOwner(const geom::Location &location) const {
+    for (size_t i = 0u; i < _instances.size(); ++i) {
+      if (_instances[i].region.Contains(location)) {
+        return i;
+      }
+    }
+    return boost::none;
+  }
+
+  SharedPtr<client::Actor> Coordinator::SpawnActor(
+      const std::string &blueprint_id,
+      const geom::Transform &transform) {
+    auto owner = FindOwner(transform.location);
+    if (!owner.has_value()) {
+      throw_exception(std::runtime_error("federation: spawn location is outside every region"));
+    }
+    auto &instance = _instances[*owner];
+    auto blueprint = instance.world.GetBlueprintLibrary()->Find(blueprint_id);
+    if (blueprint == nullptr) {
+      throw_exception(std::runtime_error("federation: blueprint not found: " + blueprint_id));
+    }
+    auto actor = instance.world.SpawnActor(*blueprint, transform);
+    _actors.emplace(
+        ActorKey(*owner, actor->GetId()),
+        TrackedActor{*owner, actor->GetId(), blueprint_id, {}});
+    return actor;
+  }
+
+  void Coordinator::Synchronize(time_duration timeout) {
+    // Tick every instance first so the snapshots below all belong to the
+    // same federation step.
+    for (auto &instance : _instances) {
+      instance.world.Tick(timeout);
+    }
+
+    std::vector<client::WorldSnapshot> snapshots;
+    snapshots.reserve(_instances.size());
+    for (auto &instance : _instances) {
+      snapshots.emplace_back(instance.world.GetSnapshot());
+    }
+
+    AdoptNewActors();
+
+    // Handing an actor over re-keys its entry, iterate over a stable copy
+    // of the keys instead of the map itself.
+    std::vector<uint64_t> keys;
+    keys.reserve(_actors.size());
+    for (const auto &entry : _actors) {
+      keys.push_back(entry.first);
+    }
+
+    for (const auto key : keys) {
+      auto it = _actors.find(key);
+      TrackedActor &tracked = it->second;
+      const auto snapshot = snapshots[tracked.owner].Find(tracked.id);
+      if (!snapshot.has_value()) {
+        // Destroyed on its owner, take the ghosts down with it.
+        DestroyGhosts(tracked);
+        _actors.erase(it);
+        continue;
+      }
+
+      const auto &location = snapshot->transform.location;
+      if (!_instances[tracked.owner].region.Contains(location)) {
+        const auto new_owner = FindOwner(location);
+        if (new_owner.has_value()) {
+          HandOver(tracked, *new_owner, *snapshot);
+          if (ActorKey(tracked.owner, tracked.id) != key) {
+            TrackedActor moved = std::move(tracked);
+            _actors.erase(it);
+            _actors.emplace(ActorKey(moved.owner, moved.id), std::move(moved));
+            continue;
+          }
+        }
+        // Outside every region the actor keeps simulating where it is.
+      }
+
+      UpdateGhosts(tracked, *snapshot);
+    }
+  }
+
+  void Coordinator::AdoptNewActors() {
+    for (size_t i = 0u; i < _instances.size(); ++i) {
+      const auto actors = _instances[i].world.GetActors();
+      for (size_t pos = 0u; pos < actors->size(); ++pos) {
+        const auto id = actors->GetActorId(pos);
+        if ((_ghost_ids[i].count(id) != 0u) ||
+            (_actors.count(ActorKey(i, id)) != 0u)) {
+          continue;
+        }
+        const auto &type_id = actors->GetActorTypeId(pos);
+        if (IsFederatedType(type_id)) {
+          _actors.emplace(ActorKey(i, id), TrackedActor{i, id, type_id, {}});
+        }
+      }
+    }
+  }
+
+  SharedPtr<client::Actor> Coordinator::SpawnGhost(
+      size_t instance_index,
+      const std::string &type_id,
+      const geom::Transform &transform) {
+    auto &instance = _instances[instance_index];
+    auto blueprint_ptr = instance.world.GetBlueprintLibrary()->Find(type_id);
+    if (blueprint_ptr == nullptr) {
+      log_warning("federation: instance", instance_index, "has no blueprint", type_id, ", ghost skipped");
+      return nullptr;
+    }
+    client::ActorBlueprint blueprint = *blueprint_ptr;
+    if (blueprint.ContainsAttribute("role_name")) {
+      blueprint.SetAttribute("role_name", "ghost");
+    }
+    auto ghost = instance.world.TrySpawnActor(blueprint, transform);
+    if (ghost != nullptr) {
+      // The owner instance simulates the actor, the ghost only follows.
+      ghost->SetSimulatePhysics(false);
+    }
+    return ghost;
+  }
+
+  void Coordinator::UpdateGhosts(TrackedActor &tracked, const client::ActorSnapshot &snapshot) {
+    const auto &location = snapshot.transform.location;
+    for (size_t i = 0u; i < _instances.size(); ++i) {
+      if (i == tracked.owner) {
+        continue;
+      }
+      const bool wanted =
+          _instances[i].region.Inflate(static_cast<float>(_ghost_margin)).Contains(location);
+      const auto ghost_it = tracked.ghosts.find(i);
+      if (ghost_it == tracked.ghosts.end()) {
+        if (wanted) {
+          auto ghost = SpawnGhost(i, tracked.type_id, snapshot.transform);
+          if (ghost != nullptr) {
+            tracked.ghosts.emplace(i, ghost->GetId());
+            _ghost_ids[i].insert(ghost->GetId());
+          }
+        }
+      } else {
+        auto ghost = _instances[i].world.GetActor(ghost_it->second);
+        if (!wanted) {
+          if (ghost != nullptr) {
+            ghost->Destroy();
+          }
+          _ghost_ids[i].erase(ghost_it->second);
+          tracked.ghosts.erase(ghost_it);
+        } else if (ghost != nullptr) {
+          ghost->SetTransform(snapshot.transform);
+        }
+      }
+    }
+  }
+
+  void Coordinator::DestroyGhosts(TrackedActor &tracked) {
+    for (const auto &entry : tracked.ghosts) {
+      auto ghost = _instances[entry.first].world.GetActor(entry.second);
+      if (ghost != nullptr) {
+        ghost->Destroy();
+      }
+      _ghost_ids[entry.first].erase(entry.second);
+    }
+    tracked.ghosts.clear();
+  }
+
+  void Coordinator::HandOver(TrackedActor &tracked, size_t new_owner, const client::ActorSnapshot &snapshot) {
+    auto &target = _instances[new_owner];
+    SharedPtr<client::Actor> successor = nullptr;
+
+    const auto ghost_it = tracked.ghosts.find(new_owner);
+    if (ghost_it != tracked.ghosts.end()) {
+      // The ghost is already in place, promote it instead of re-spawning.
+      successor = target.world.GetActor(ghost_it->second);
+      _ghost_ids[new_owner].erase(ghost_it->second);
+      tracked.ghosts.erase(ghost_it);
+    }
+    if (successor == nullptr) {
+      auto blueprint = target.world.GetBlueprintLibrary()->Find(tracked.type_id);
+      if (blueprint != nullptr) {
+        successor = target.world.TrySpawnActor(*blueprint, snapshot.transform);
+      }
+    }
+    if (successor == nullptr) {
+      log_warning("federation: could not hand actor", tracked.id, "over to instance", new_owner);
+      return;
+    }
+
+    successor->SetSimulatePhysics(true);
+    successor->SetTransform(snapshot.transform);
+    successor->SetTargetVelocity(snapshot.velocity);
+
+    auto original = _instances[tracked.owner].world.GetActor(tracked.id);
+    if (original != nullptr) {
+      original->Destroy();
+    }
+
+    tracked.owner = new_owner;
+    tracked.id = successor->GetId();
+  }
+
+} // namespace federation
+} // namespace carla
@@ -0,0 +1,138 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/client/Client.h"
+#include "carla/client/World.h"
+#include "carla/federation/Region.h"
+#include "carla/rpc/ActorId.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carla {
+namespace client {
+  struct ActorSnapshot;
+} // namespace client
+namespace federation {
+
+  /// Coordinates several simulator instances that own disjoint regions of
+  /// the same map, so scenarios too big for one process can be sharded
+  /// across servers. Each instance simulates only the actors inside its
+  /// region; actors close to a region boundary are mirrored into the
+  /// neighbouring instances as physics-less ghosts, and ownership is handed
+  /// over when an actor crosses into another region.
+  ///
+  /// Ghosts ride the regular client connections so the servers themselves
+  /// need no changes; run the instances in synchronous mode and call
+  /// Synchronize() once per step to keep the shards consistent.
+  class Coordinator : private NonCopyable {
+  public:
+
+    /// @param ghost_margin distance in meters from a region boundary within
+    /// which an actor gets mirrored into the adjacent instances.
+    explicit Coordinator(double ghost_margin = 50.0);
+
+    /// Register the simulator at @a host : @a port as the owner of
+    /// @a region. Throws if @a region overlaps a region already registered.
+    ///
+    /// @return the index of the new instance.
+    size_t AddInstance(const std::string &host, uint16_t port, const Region &region);
+
+    size_t GetInstanceCount() const {
+      return _instances.size();
+    }
+
+    client::World GetWorld(size_t index) {
+      return _instances.at(index).world;
+    }
+
+    const Region &GetRegion(size_t index) const {
+      return _instances.at(index).region;
+    }
+
+    /// Index of the instance owning @a location, empty if no registered
+    /// region contains it.
+    boost::optional<size_t> FindOwner(const geom::Location &location) const;
+
+    /// Spawn an actor on the instance owning @a transform's location and
+    /// track it in the federation. Throws if the location is outside every
+    /// region or the blueprint is not found.
+    SharedPtr<client::Actor> SpawnActor(
+        const std::string &blueprint_id,
+        const geom::Transform &transform);
+
+    /// Advance the federation one step: tick every instance, adopt actors
+    /// spawned behind our back, refresh ghost transforms, create and destroy
+    /// ghosts as actors enter and leave the boundary margins, and hand
+    /// actors over when they cross into another region.
+    void Synchronize(time_duration timeout = time_duration::seconds(10));
+
+    /// Number of actors currently tracked by the federation.
+    size_t GetActorCount() const {
+      return _actors.size();
+    }
+
+  private:
+
+    struct Instance {
+      client::Client client;
+      client::World world;
+      Region region;
+    };
+
+    /// Actor tracked by the federation: the instance simulating it and the
+    /// ghost mirrored into each neighbouring instance.
+    struct TrackedActor {
+      size_t owner;
+      ActorId id;
+      std::string type_id;
+      std::unordered_map<size_t, ActorId> ghosts;
+    };
+
+    static uint64_t ActorKey(size_t instance_index, ActorId id) {
+      return (static_cast<uint64_t>(instance_index) << 32) | id;
+    }
+
+    /// Start tracking federated actors spawned directly on the instances.
+    void AdoptNewActors();
+
+    SharedPtr<client::Actor> SpawnGhost(
+        size_t instance_index,
+        const std::string &type_id,
+        const geom::Transform &transform);
+
+    void UpdateGhosts(TrackedActor &tracked, const client::ActorSnapshot &snapshot);
+
+    void DestroyGhosts(TrackedActor &tracked);
+
+    /// Move @a tracked to @a new_owner, promoting its ghost there when one
+    /// exists. Leaves ownership untouched if the target instance cannot
+    /// host the actor.
+    void HandOver(TrackedActor &tracked, size_t new_owner, const client::ActorSnapshot &snapshot);
+
+    double _ghost_margin;
+
+    std::vector<Instance> _instances;
+
+    /// Ghosts owned by the coordinator on each instance, so they are not
+    /// mistaken for newly spawned actors.
+    std::vector<std::unordered_set<ActorId>> _ghost_ids;
+
+    std::unordered_map<uint64_t, TrackedActor> _actors;
+  };
+
+} // namespace federation
+} // namespace carla
@@ -0,0 +1,63 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Location.h"
+
+#include <algorithm>
+
+namespace carla {
+namespace federation {
+
+  /// Axis-aligned map region owned by a single simulator instance. Regions
+  /// partition the map on the XY plane; height is ignored so bridges and
+  /// tunnels stay with the region underneath them.
+  struct Region {
+
+    geom::Location min_corner;
+
+    geom::Location max_corner;
+
+    Region() = default;
+
+    Region(const geom::Location &in_min_corner, const geom::Location &in_max_corner)
+      : min_corner(in_min_corner),
+        max_corner(in_max_corner) {}
+
+    /// The maximum edges are exclusive so two regions sharing an edge do not
+    /// both claim the locations on it.
+    bool Contains(const geom::Location &location) const {
+      return
+          (location.x >= min_corner.x) && (location.x < max_corner.x) &&
+          (location.y >= min_corner.y) && (location.y < max_corner.y);
+    }
+
+    bool Overlaps(const Region &rhs) const {
+      return
+          (min_corner.x < rhs.max_corner.x) && (rhs.min_corner.x < max_corner.x) &&
+          (min_corner.y < rhs.max_corner.y) && (rhs.min_corner.y < max_corner.y);
+    }
+
+    /// Distance on the XY plane from @a location to the closest region
+    /// boundary; negative when the location is outside the region.
+    float DistanceToBoundary(const geom::Location &location) const {
+      const float dx = std::min(location.x - min_corner.x, max_corner.x - location.x);
+      const float dy = std::min(location.y - min_corner.y, max_corner.y - location.y);
+      return std::min(dx, dy);
+    }
+
+    /// Return this region grown by @a margin meters on every side of the XY
+    /// plane.
+    Region Inflate(float margin) const {
+      return {
+          geom::Location(min_corner.x - margin, min_corner.y - margin, min_corner.z),
+          geom::Location(max_corner.x + margin, max_corner.y + margin, max_corner.z)};
+    }
+  };
+
+} // namespace federation
+} // namespace carla
@@ -88,9 +88,7 @@ namespace geom {
      */
     std::array<Location, 8> GetWorldVertices(const Transform &in_bbox_to_world_tr) const {
         auto world_vertices = GetLocalVertices();
-        std::for_each(world_vertices.begin(), world_vertices.end(), [&in_bbox_to_world_tr](auto &world_vertex) {
-          in_bbox_to_world_tr.TransformPoint(world_vertex);
-        });
+        in_bbox_to_world_tr.TransformPoints(world_vertices.begin(), world_vertices.end());
         return world_vertices;
     }
 
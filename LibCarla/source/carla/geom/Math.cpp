@@ -8,6 +8,8 @@
 
 #include "carla/geom/Rotation.h"
 
+#include <limits>
+
 namespace carla {
 namespace geom {
 
@@ -30,6 +32,36 @@ namespace geom {
     return std::make_pair(t * l, Distance2D(projection, p));
   }
 
+  float Math::DistanceAlongSegment2D(
+      const Vector3D &p,
+      const Vector3D &v,
+      const Vector3D &w) {
+    const float l2 = DistanceSquared2D(v, w);
+    if (l2 == 0.0f) {
+      return 0.0f;
+    }
+    const float t = Clamp(Dot2D(p - v, w - v) / l2);
+    return t * std::sqrt(l2);
+  }
+
+  std::pair<size_t, float> Math::NearestSegmentToPoint2D(
+      const Vector3D &p,
+      const std::pair<Vector3D, Vector3D> *segments,
+      size_t count) {
+    DEBUG_ASSERT(count > 0u);
+    size_t nearest = 0u;
+    float nearest_squared = std::numeric_limits<float>::max();
+    for (size_t i = 0u; i < count; ++i) {
+      const float squared =
+          SquaredDistanceSegmentToPoint2D(p, segments[i].first, segments[i].second);
+      if (squared < nearest_squared) {
+        nearest_squared = squared;
+        nearest = i;
+      }
+    }
+    return std::make_pair(nearest, nearest_squared);
+  }
+
   std::pair<float, float> Math::DistanceArcToPoint(
       Vector3D p,
       Vector3D start_pos,
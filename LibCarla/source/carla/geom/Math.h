@@ -82,6 +82,26 @@ namespace geom {
     /// Returns the angle between 2 vectors in radians
     static double GetVectorAngle(const Vector3D &a, const Vector3D &b);
 
+    /// Squared 2D Euclidean distance from @a p to its projection on the
+    /// segment (w - v). Fast path of DistanceSegmentToPoint for selection
+    /// loops: it stays in squared space, so no square root is paid per
+    /// candidate segment.
+    static float SquaredDistanceSegmentToPoint2D(
+        const Vector3D &p,
+        const Vector3D &v,
+        const Vector3D &w) {
+      const float dx = w.x - v.x;
+      const float dy = w.y - v.y;
+      const float px = p.x - v.x;
+      const float py = p.y - v.y;
+      const float l2 = dx * dx + dy * dy;
+      // Degenerate segments project everything onto v.
+      const float t = (l2 > 0.0f) ? Clamp((px * dx + py * dy) / l2) : 0.0f;
+      const float ex = px - t * dx;
+      const float ey = py - t * dy;
+      return ex * ex + ey * ey;
+    }
+
     /// Returns a pair containing:
     /// - @b first:  distance from v to p' where p' = p projected on segment
     ///   (w - v)
@@ -94,6 +114,26 @@ namespace geom {
         const Vector3D &v,
         const Vector3D &w);
 
+    /// Distance from @a v to the projection of @a p on the segment (w - v);
+    /// i.e. DistanceSegmentToPoint(p, v, w).first without paying for the
+    /// Euclidean distance when only the distance along the segment is needed.
+    static float DistanceAlongSegment2D(
+        const Vector3D &p,
+        const Vector3D &v,
+        const Vector3D &w);
+
+    /// Returns a pair containing:
+    /// - @b first:  index of the segment of @a segments closest to @a p
+    /// - @b second: squared 2D Euclidean distance from @a p to that segment
+    /// Fused batch form of DistanceSegmentToPoint against @a count segments;
+    /// a single square-root-free pass over contiguous data instead of one
+    /// call per segment.
+    ///   @warning Calling this with @a count == 0 is undefined.
+    static std::pair<size_t, float> NearestSegmentToPoint2D(
+        const Vector3D &p,
+        const std::pair<Vector3D, Vector3D> *segments,
+        size_t count);
+
     /// Returns a pair containing:
     /// - @b first:  distance across the arc from start_pos to p' where p' = p
     /// projected on Arc
@@ -6,9 +6,11 @@
 
 #include <carla/geom/Mesh.h>
 
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <ios>
+#include <unordered_map>
 
 #include <carla/geom/Math.h>
 
@@ -137,6 +139,85 @@ namespace geom {
     _materials.back().index_end = close_index;
   }
 
+  namespace {
+
+    /// Per-vertex attribute bundle used to weld duplicates; two vertices
+    /// merge only when every attribute matches exactly.
+    struct WeldKey {
+
+      Mesh::vertex_type vertex;
+
+      Mesh::normal_type normal;
+
+      Mesh::uv_type uv;
+
+      bool operator==(const WeldKey &rhs) const {
+        return vertex == rhs.vertex && normal == rhs.normal && uv == rhs.uv;
+      }
+    };
+
+    struct WeldKeyHash {
+      size_t operator()(const WeldKey &key) const {
+        size_t seed = 0u;
+        for (const float component : {
+            key.vertex.x, key.vertex.y, key.vertex.z,
+            key.normal.x, key.normal.y, key.normal.z,
+            key.uv.x, key.uv.y }) {
+          seed ^= std::hash<float>()(component) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+      }
+    };
+
+  } // namespace
+
+  void Mesh::WeldVertices() {
+    if (_vertices.empty() || _indexes.empty()) {
+      return;
+    }
+    // The attribute lists can only follow the remap when they run parallel
+    // to the vertex list.
+    const bool has_normals = _normals.size() == _vertices.size();
+    const bool has_uvs = _uvs.size() == _vertices.size();
+    if ((!_normals.empty() && !has_normals) || (!_uvs.empty() && !has_uvs)) {
+      return;
+    }
+
+    std::vector<vertex_type> vertices;
+    std::vector<normal_type> normals;
+    std::vector<uv_type> uvs;
+    // Maps each old 1-based vertex index to its welded 1-based index.
+    std::vector<index_type> remap(_vertices.size() + 1u, 0u);
+    std::unordered_map<WeldKey, index_type, WeldKeyHash> unique_vertices;
+    unique_vertices.reserve(_vertices.size());
+
+    for (size_t i = 0u; i < _vertices.size(); ++i) {
+      const WeldKey key {
+          _vertices[i],
+          has_normals ? _normals[i] : normal_type(),
+          has_uvs ? _uvs[i] : uv_type() };
+      auto it = unique_vertices.find(key);
+      if (it == unique_vertices.end()) {
+        vertices.push_back(_vertices[i]);
+        if (has_normals) {
+          normals.push_back(_normals[i]);
+        }
+        if (has_uvs) {
+          uvs.push_back(_uvs[i]);
+        }
+        it = unique_vertices.emplace(key, vertices.size()).first;
+      }
+      remap[i + 1u] = it->second;
+    }
+
+    for (auto &index : _indexes) {
+      index = remap[index];
+    }
+    _vertices = std::move(vertices);
+    _normals = std::move(normals);
+    _uvs = std::move(uvs);
+  }
+
   std::string Mesh::GenerateOBJ() const {
     if (!IsValid()) {
       return "";
@@ -241,9 +322,67 @@ namespace geom {
     if (!IsValid()) {
       return "Invalid Mesh";
     }
+    const bool has_normals = _normals.size() == _vertices.size();
+    const bool has_uvs = _uvs.size() == _vertices.size();
+    const size_t face_num = _indexes.size() / 3u;
+
     // Generate header
     std::stringstream out;
-    return out.str();
+    out << "ply\n"
+        << "format binary_little_endian 1.0\n"
+        << "element vertex " << _vertices.size() << "\n"
+        << "property float x\n"
+        << "property float y\n"
+        << "property float z\n";
+    if (has_normals) {
+      out << "property float nx\n"
+          << "property float ny\n"
+          << "property float nz\n";
+    }
+    if (has_uvs) {
+      out << "property float s\n"
+          << "property float t\n";
+    }
+    out << "element face " << face_num << "\n"
+        << "property list uchar uint vertex_indices\n"
+        << "end_header\n";
+
+    std::string result = out.str();
+    const size_t floats_per_vertex =
+        3u + (has_normals ? 3u : 0u) + (has_uvs ? 2u : 0u);
+    result.reserve(result.size() +
+        _vertices.size() * floats_per_vertex * sizeof(float) +
+        face_num * (sizeof(uint8_t) + 3u * sizeof(uint32_t)));
+
+    auto append_bytes = [&result](const void *data, size_t size) {
+      result.append(reinterpret_cast<const char *>(data), size);
+    };
+
+    for (size_t i = 0u; i < _vertices.size(); ++i) {
+      const float position[3u] = { _vertices[i].x, _vertices[i].y, _vertices[i].z };
+      append_bytes(position, sizeof(position));
+      if (has_normals) {
+        const float normal[3u] = { _normals[i].x, _normals[i].y, _normals[i].z };
+        append_bytes(normal, sizeof(normal));
+      }
+      if (has_uvs) {
+        const float uv[2u] = { _uvs[i].x, _uvs[i].y };
+        append_bytes(uv, sizeof(uv));
+      }
+    }
+
+    for (size_t i = 0u; i < face_num * 3u; i += 3u) {
+      const uint8_t face_size = 3u;
+      append_bytes(&face_size, sizeof(face_size));
+      // PLY indices start at 0, the mesh stores them starting at 1.
+      const uint32_t face[3u] = {
+          static_cast<uint32_t>(_indexes[i] - 1u),
+          static_cast<uint32_t>(_indexes[i + 1u] - 1u),
+          static_cast<uint32_t>(_indexes[i + 2u] - 1u) };
+      append_bytes(face, sizeof(face));
+    }
+
+    return result;
   }
 
   const std::vector<Mesh::vertex_type> &Mesh::GetVertices() const {
@@ -286,6 +425,12 @@ namespace geom {
     const size_t v_num = GetVerticesNum();
     const size_t i_num = GetIndexesNum();
 
+    _vertices.reserve(v_num + rhs.GetVerticesNum());
+    _normals.reserve(_normals.size() + rhs.GetNormals().size());
+    _indexes.reserve(i_num + rhs.GetIndexesNum());
+    _uvs.reserve(_uvs.size() + rhs.GetUVs().size());
+    _materials.reserve(_materials.size() + rhs.GetMaterials().size());
+
     _vertices.insert(
         _vertices.end(),
         rhs.GetVertices().begin(),
@@ -99,6 +99,13 @@ namespace geom {
     /// Stops applying the material to the new added triangles.
     void EndMaterial();
 
+    /// Merges duplicated vertices and remaps the index list accordingly.
+    /// Two vertices are welded only when their position, normal and UV
+    /// match, so the triangles are preserved exactly. The strip and fan
+    /// builders duplicate the shared vertices of every quad, welding the
+    /// generated road meshes roughly halves their vertex data.
+    void WeldVertices();
+
     // =========================================================================
     // -- Export methods -------------------------------------------------------
     // =========================================================================
@@ -113,8 +120,8 @@ namespace geom {
     /// Changes the build face direction and the coordinate space.
     std::string GenerateOBJForRecast() const;
 
-    /// Returns a string containing the mesh encoded in PLY.
-    /// Units are in meters.
+    /// Returns a string containing the mesh encoded in binary
+    /// little-endian PLY. Units are in meters.
     std::string GeneratePLY() const;
 
     // =========================================================================
@@ -37,6 +37,13 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Rebuild the tree from the whole element set at once; the range
+    /// constructor bulk-loads with the packing algorithm, much faster than
+    /// inserting the elements one by one.
+    void BuildFromElements(const std::vector<TreeElement> &elements) {
+      _rtree = decltype(_rtree)(elements.begin(), elements.end());
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
@@ -94,6 +101,13 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Rebuild the tree from the whole element set at once; the range
+    /// constructor bulk-loads with the packing algorithm, much faster than
+    /// inserting the elements one by one.
+    void BuildFromElements(const std::vector<TreeElement> &elements) {
+      _rtree = decltype(_rtree)(elements.begin(), elements.end());
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
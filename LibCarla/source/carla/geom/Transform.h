@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackBin.h"
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/Rotation.h"
@@ -77,6 +78,44 @@ namespace geom {
       in_point = out_point;
     }
 
+    /// Applies this transformation in-place to every point in the range
+    /// [@a begin, @a end). The rotation matrix is built once for the whole
+    /// batch instead of once per point, and rotation-free transforms reduce
+    /// to a plain translation loop.
+    template <typename PointIt>
+    void TransformPoints(PointIt begin, PointIt end) const {
+      if (rotation == Rotation()) {
+        for (auto it = begin; it != end; ++it) {
+          *it += location;
+        }
+        return;
+      }
+
+      const float cy = std::cos(Math::ToRadians(rotation.yaw));
+      const float sy = std::sin(Math::ToRadians(rotation.yaw));
+      const float cr = std::cos(Math::ToRadians(rotation.roll));
+      const float sr = std::sin(Math::ToRadians(rotation.roll));
+      const float cp = std::cos(Math::ToRadians(rotation.pitch));
+      const float sp = std::sin(Math::ToRadians(rotation.pitch));
+
+      const float m00 = cp * cy;
+      const float m01 = cy * sp * sr - sy * cr;
+      const float m02 = -cy * sp * cr - sy * sr;
+      const float m10 = cp * sy;
+      const float m11 = sy * sp * sr + cy * cr;
+      const float m12 = -sy * sp * cr + cy * sr;
+      const float m20 = sp;
+      const float m21 = -cp * sr;
+      const float m22 = cp * cr;
+
+      for (auto it = begin; it != end; ++it) {
+        const Vector3D in_point = *it;
+        it->x = in_point.x * m00 + in_point.y * m01 + in_point.z * m02 + location.x;
+        it->y = in_point.x * m10 + in_point.y * m11 + in_point.z * m12 + location.y;
+        it->z = in_point.x * m20 + in_point.y * m21 + in_point.z * m22 + location.z;
+      }
+    }
+
     /// Computes the 4-matrix form of the transformation
     std::array<float, 16> GetMatrix() const {
       const float yaw = rotation.yaw;
@@ -157,3 +196,6 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+// Spawn point lists on big maps reach thousands of entries.
+CARLA_MSGPACK_VECTOR_AS_BIN(carla::geom::Transform)
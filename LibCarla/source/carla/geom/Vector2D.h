@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MsgPack.h"
+#include "carla/MsgPackBin.h"
 
 #include <cmath>
 #include <limits>
@@ -151,3 +152,6 @@ namespace geom {
 
 } // namespace geom
 } // namespace carla
+
+// Physics control curves move these around by the hundreds.
+CARLA_MSGPACK_VECTOR_AS_BIN(carla::geom::Vector2D)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 namespace carla {
@@ -73,5 +74,39 @@ namespace detail {
     }
   };
 
+  /// A runtime-remappable palette: a 256-entry BGRA lookup table initialized
+  /// from the CityScapes palette and editable per tag. Lets users merge
+  /// CARLA's classes into their own ontology or paint custom colors during
+  /// the conversion itself, instead of running a second full-image pass.
+  class PaletteLUT {
+  public:
+
+    PaletteLUT() {
+      for (auto tag = 0u; tag < 256u; ++tag) {
+        const auto color = CityScapesPalette::GetColor(static_cast<uint8_t>(tag));
+        SetColor(static_cast<uint8_t>(tag), color[0u], color[1u], color[2u]);
+      }
+    }
+
+    /// Paint @a tag with an RGB color.
+    void SetColor(uint8_t tag, uint8_t r, uint8_t g, uint8_t b) {
+      _bgra[tag] = {{b, g, r, 255u}};
+    }
+
+    /// Remap @a tag to the color of @a to_tag, merging the two classes.
+    void Remap(uint8_t tag, uint8_t to_tag) {
+      _bgra[tag] = _bgra[to_tag];
+    }
+
+    /// BGRA color of @a tag.
+    const uint8_t *GetColor(uint8_t tag) const {
+      return _bgra[tag].data();
+    }
+
+  private:
+
+    std::array<std::array<uint8_t, 4u>, 256u> _bgra;
+  };
+
 } // namespace image
 } // namespace carla
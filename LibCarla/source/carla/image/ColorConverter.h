@@ -54,6 +54,27 @@ namespace image {
         color_convert(rgb8c_pixel_t{color[0u], color[1u], color[2u]}, dst);
       }
     };
+
+    /// Like CityScapesPalette but looking the colors up in a user-supplied
+    /// image::PaletteLUT. Keeps a pointer to the table, which must outlive
+    /// the conversion.
+    struct Palette {
+
+      explicit Palette(const image::PaletteLUT &palette)
+        : _palette(&palette) {}
+
+      template <typename SrcPixelT, typename DstPixelT>
+      void operator()(const SrcPixelT &src, DstPixelT &dst) const {
+        using namespace boost::gil;
+        static_assert(
+            sizeof(typename color_space_type<SrcPixelT>::type) == sizeof(uint8_t),
+            "Invalid pixel type.");
+        const auto *bgra = _palette->GetColor(get_color(src, red_t()));
+        color_convert(rgb8c_pixel_t{bgra[2u], bgra[1u], bgra[0u]}, dst);
+      }
+
+      const image::PaletteLUT *_palette;
+    };
   };
 
 } // namespace image
@@ -0,0 +1,108 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/image/BoostGil.h"
+#include "carla/image/CityScapesPalette.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#  include <emmintrin.h>
+#  define LIBCARLA_IMAGE_WITH_SSE2
+#endif
+
+namespace carla {
+namespace image {
+namespace detail {
+
+  /// Flat conversion kernels over contiguous BGRA8 memory, the layout of the
+  /// images coming from the simulator. They produce bit-identical results to
+  /// the equivalent ColorConverter functors applied through a
+  /// color-converted view, but skip the per-pixel view composition that
+  /// dominates the cost of converting a full frame.
+  ///
+  /// The depth decode and clamping of the logarithmic depth kernel are
+  /// vectorized where the result stays exact; the logarithm itself is kept
+  /// scalar since an approximate vectorized log would change the output
+  /// bytes.
+
+  /// Value of ColorConverter::Depth composed with
+  /// ColorConverter::LogarithmicLinear for a single BGRA8 pixel.
+  inline float LogarithmicDepthValue(const uint8_t *bgra) {
+    const int depth = bgra[2u] + (bgra[1u] << 8) + (bgra[0u] << 16);
+    const float normalized = static_cast<float>(depth) / static_cast<float>(256 * 256 * 256 - 1);
+    const float value = 1.0f + std::log(normalized) / 5.70378f;
+    return std::max(std::min(value, 1.0f), 0.005f);
+  }
+
+  inline void WriteGrayPixel(uint8_t *bgra, float clamped) {
+    auto &dst = *reinterpret_cast<boost::gil::bgra8_pixel_t *>(bgra);
+    boost::gil::color_convert(boost::gil::gray32fc_pixel_t{clamped}, dst);
+  }
+
+  inline void LogarithmicDepthKernel(uint8_t *bgra, size_t num_pixels) {
+    size_t i = 0u;
+#ifdef LIBCARLA_IMAGE_WITH_SSE2
+    for (; i + 4u <= num_pixels; i += 4u) {
+      uint8_t *p = bgra + 4u * i;
+      const auto depth24 = [](const uint8_t *px) {
+        return px[2u] + (px[1u] << 8) + (px[0u] << 16);
+      };
+      const __m128 normalized = _mm_div_ps(
+          _mm_cvtepi32_ps(_mm_setr_epi32(
+              depth24(p), depth24(p + 4u), depth24(p + 8u), depth24(p + 12u))),
+          _mm_set1_ps(static_cast<float>(256 * 256 * 256 - 1)));
+      alignas(16u) float n[4u];
+      _mm_store_ps(n, normalized);
+      const __m128 value = _mm_add_ps(
+          _mm_set1_ps(1.0f),
+          _mm_div_ps(
+              _mm_setr_ps(std::log(n[0u]), std::log(n[1u]), std::log(n[2u]), std::log(n[3u])),
+              _mm_set1_ps(5.70378f)));
+      alignas(16u) float clamped[4u];
+      _mm_store_ps(clamped, _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_set1_ps(0.005f)));
+      WriteGrayPixel(p, clamped[0u]);
+      WriteGrayPixel(p + 4u, clamped[1u]);
+      WriteGrayPixel(p + 8u, clamped[2u]);
+      WriteGrayPixel(p + 12u, clamped[3u]);
+    }
+#endif // LIBCARLA_IMAGE_WITH_SSE2
+    for (; i < num_pixels; ++i) {
+      uint8_t *p = bgra + 4u * i;
+      WriteGrayPixel(p, LogarithmicDepthValue(p));
+    }
+  }
+
+  /// The palette lookup is a gather and stays scalar; the flat loop is
+  /// memory-bound anyway.
+  inline void CityScapesPaletteKernel(uint8_t *bgra, size_t num_pixels) {
+    for (size_t i = 0u; i < num_pixels; ++i, bgra += 4u) {
+      const auto color = CityScapesPalette::GetColor(bgra[2u]);
+      bgra[0u] = color[2u];
+      bgra[1u] = color[1u];
+      bgra[2u] = color[0u];
+      bgra[3u] = 255u;
+    }
+  }
+
+  /// Same gather with a user-supplied table: the LUT stores whole BGRA
+  /// entries, so each pixel is one 4-byte load and one 4-byte store, and the
+  /// 1 KB table stays resident in L1.
+  inline void PaletteLUTKernel(uint8_t *bgra, size_t num_pixels, const PaletteLUT &palette) {
+    for (size_t i = 0u; i < num_pixels; ++i, bgra += 4u) {
+      std::memcpy(bgra, palette.GetColor(bgra[2u]), 4u);
+    }
+  }
+
+} // namespace detail
+} // namespace image
+} // namespace carla
@@ -6,11 +6,44 @@
 
 #pragma once
 
+#include "carla/ThreadPool.h"
+#include "carla/image/ColorConverterKernels.h"
 #include "carla/image/ImageView.h"
 
+#include <algorithm>
+#include <future>
+#include <type_traits>
+#include <vector>
+
 namespace carla {
 namespace image {
 
+namespace detail {
+
+  /// Shared pool of worker threads for the parallel converters. Unlike the
+  /// encode pipeline the conversions are synchronous, the caller blocks on
+  /// its own tiles, so no backlog bound is needed.
+  class ConvertPool {
+  public:
+
+    static ThreadPool &Get() {
+      static ConvertPool instance;
+      return instance._pool;
+    }
+
+  private:
+
+    ConvertPool() {
+      auto config = ThreadConfig::ProcessDefault();
+      config.name = "carla-convert";
+      _pool.AsyncRun(std::max(2u, std::thread::hardware_concurrency()), config);
+    }
+
+    ThreadPool _pool;
+  };
+
+} // namespace detail
+
   class ImageConverter {
   public:
 
@@ -23,11 +56,155 @@ namespace image {
     static void ConvertInPlace(
         MutableImageView &image_view,
         ColorConverter converter = ColorConverter()) {
+      ConvertInPlaceGeneric(image_view, converter);
+    }
+
+    /// Converters with a flat kernel run it when the view is over contiguous
+    /// BGRA8 memory, the layout of images coming from the simulator; any
+    /// other view falls back to the generic pixel-by-pixel conversion.
+    template <typename MutableImageView>
+    static void ConvertInPlace(
+        MutableImageView &image_view,
+        ColorConverter::LogarithmicDepth converter) {
+      if (!TryConvertFlat(image_view, detail::LogarithmicDepthKernel)) {
+        ConvertInPlaceGeneric(image_view, converter);
+      }
+    }
+
+    /// @copydoc ConvertInPlace(MutableImageView&,ColorConverter::LogarithmicDepth)
+    template <typename MutableImageView>
+    static void ConvertInPlace(
+        MutableImageView &image_view,
+        ColorConverter::CityScapesPalette converter) {
+      if (!TryConvertFlat(image_view, detail::CityScapesPaletteKernel)) {
+        ConvertInPlaceGeneric(image_view, converter);
+      }
+    }
+
+    /// @copydoc ConvertInPlace(MutableImageView&,ColorConverter::LogarithmicDepth)
+    template <typename MutableImageView>
+    static void ConvertInPlace(
+        MutableImageView &image_view,
+        ColorConverter::Palette converter) {
+      auto kernel = [&converter](uint8_t *bgra, size_t num_pixels) {
+        detail::PaletteLUTKernel(bgra, num_pixels, *converter._palette);
+      };
+      if (!TryConvertFlat(image_view, kernel)) {
+        ConvertInPlaceGeneric(image_view, converter);
+      }
+    }
+
+    /// Out-of-place version of ConvertInPlace: write the conversion of
+    /// @a src into @a dst, which must have the same dimensions.
+    template <typename ColorConverter, typename SrcViewT, typename MutableDstViewT>
+    static void Convert(
+        const SrcViewT &src,
+        MutableDstViewT &dst,
+        ColorConverter converter = ColorConverter()) {
+      DEBUG_ASSERT(src.dimensions() == dst.dimensions());
+      using DstPixelT = typename MutableDstViewT::value_type;
+      CopyPixels(
+          ImageView::MakeColorConvertedView<SrcViewT, DstPixelT>(src, converter),
+          dst);
+    }
+
+    /// Apply @a converter in place to every view in @a batch, splitting the
+    /// rows of each image across a shared pool of worker threads. Blocks
+    /// until the whole batch is converted; meant for bulk post-processing of
+    /// recorded sequences, where converting frame by frame leaves all but
+    /// one core idle.
+    template <typename ColorConverter, typename MutableImageView>
+    static void ConvertInPlaceParallel(
+        std::vector<MutableImageView> &batch,
+        ColorConverter converter = ColorConverter()) {
+      auto &pool = detail::ConvertPool::Get();
+      std::vector<std::future<void>> tiles;
+      for (auto &image_view : batch) {
+        ForEachRowBand(image_view, [&](std::ptrdiff_t, auto band) {
+          tiles.emplace_back(pool.Post([band, converter]() mutable {
+            ConvertInPlace(band, converter);
+          }));
+        });
+      }
+      for (auto &tile : tiles) {
+        tile.get();
+      }
+    }
+
+    /// @copydoc ConvertInPlaceParallel but out-of-place; @a src_batch and
+    /// @a dst_batch must match in size and per-image dimensions.
+    template <typename ColorConverter, typename SrcViewT, typename MutableDstViewT>
+    static void ConvertParallel(
+        const std::vector<SrcViewT> &src_batch,
+        std::vector<MutableDstViewT> &dst_batch,
+        ColorConverter converter = ColorConverter()) {
+      DEBUG_ASSERT(src_batch.size() == dst_batch.size());
+      auto &pool = detail::ConvertPool::Get();
+      std::vector<std::future<void>> tiles;
+      for (auto i = 0u; i < src_batch.size(); ++i) {
+        auto &dst = dst_batch[i];
+        DEBUG_ASSERT(src_batch[i].dimensions() == dst.dimensions());
+        ForEachRowBand(src_batch[i], [&](std::ptrdiff_t y, auto src_band) {
+          auto dst_band = ImageView::MakeSubImageView(
+              dst, 0, y, dst.width(), src_band.height());
+          tiles.emplace_back(pool.Post([src_band, dst_band, converter]() mutable {
+            Convert(src_band, dst_band, converter);
+          }));
+        });
+      }
+      for (auto &tile : tiles) {
+        tile.get();
+      }
+    }
+
+  private:
+
+    /// Call @a func(y, band) for full-width row bands covering @a view, one
+    /// band per worker thread. Full-width bands of a contiguous image are
+    /// still 1d-traversable, so the flat kernels keep applying inside each
+    /// band.
+    template <typename ViewT, typename FuncT>
+    static void ForEachRowBand(const ViewT &view, FuncT func) {
+      const std::ptrdiff_t height = view.height();
+      const std::ptrdiff_t num_bands = std::max(2u, std::thread::hardware_concurrency());
+      const std::ptrdiff_t band_height = std::max<std::ptrdiff_t>(1, (height + num_bands - 1) / num_bands);
+      for (std::ptrdiff_t y = 0; y < height; y += band_height) {
+        func(y, ImageView::MakeSubImageView(
+            view, 0, y, view.width(), std::min(band_height, height - y)));
+      }
+    }
+
+    template <typename ColorConverter, typename MutableImageView>
+    static void ConvertInPlaceGeneric(
+        MutableImageView &image_view,
+        ColorConverter converter) {
       using DstPixelT = typename MutableImageView::value_type;
       CopyPixels(
           ImageView::MakeColorConvertedView<MutableImageView, DstPixelT>(image_view, converter),
           image_view);
     }
+
+    template <typename MutableImageView, typename KernelT>
+    static auto TryConvertFlat(MutableImageView &image_view, KernelT kernel)
+        -> typename std::enable_if<
+            std::is_same<typename MutableImageView::x_iterator, boost::gil::bgra8_pixel_t *>::value,
+            bool>::type {
+      if (!image_view.is_1d_traversable()) {
+        return false;
+      }
+      kernel(
+          reinterpret_cast<uint8_t *>(&image_view(0, 0)),
+          static_cast<size_t>(image_view.size()));
+      return true;
+    }
+
+    template <typename MutableImageView, typename KernelT>
+    static auto TryConvertFlat(MutableImageView &, KernelT)
+        -> typename std::enable_if<
+            !std::is_same<typename MutableImageView::x_iterator, boost::gil::bgra8_pixel_t *>::value,
+            bool>::type {
+      return false;
+    }
   };
 
 } // namespace image
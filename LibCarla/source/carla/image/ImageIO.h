@@ -6,11 +6,79 @@
 
 #pragma once
 
+#include "carla/ThreadPool.h"
 #include "carla/image/ImageIOConfig.h"
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 namespace carla {
 namespace image {
 
+namespace detail {
+
+  /// Shared pool of encoder threads with a bounded backlog. Encoding a PNG
+  /// is far more expensive than capturing it, so saving a multi-camera rig
+  /// from the sensor callbacks cannot keep up single-threaded; the pipeline
+  /// overlaps the encodes of consecutive frames instead.
+  class EncodePipeline {
+  public:
+
+    /// Images waiting in the pipeline before Post blocks the caller; bounds
+    /// memory use when the disk cannot keep up.
+    static constexpr size_t max_pending_encodes = 32u;
+
+    static EncodePipeline &GetInstance() {
+      static EncodePipeline instance;
+      return instance;
+    }
+
+    template <typename FunctorT, typename ResultT = typename std::result_of<FunctorT()>::type>
+    std::future<ResultT> Post(FunctorT &&functor) {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _not_full.wait(lock, [this]() { return _pending < max_pending_encodes; });
+        ++_pending;
+      }
+      return _pool.Post([this, functor = std::forward<FunctorT>(functor)]() mutable {
+        try {
+          auto result = functor();
+          ReleaseSlot();
+          return result;
+        } catch (...) {
+          ReleaseSlot();
+          throw;
+        }
+      });
+    }
+
+  private:
+
+    EncodePipeline() {
+      // leave cores free for whoever is producing the images.
+      auto config = ThreadConfig::ProcessDefault();
+      config.name = "carla-encode";
+      _pool.AsyncRun(std::max(2u, std::thread::hardware_concurrency() / 2u), config);
+    }
+
+    void ReleaseSlot() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      --_pending;
+      _not_full.notify_one();
+    }
+
+    ThreadPool _pool;
+
+    std::mutex _mutex;
+
+    std::condition_variable _not_full;
+
+    size_t _pending = 0u;
+  };
+
+} // namespace detail
+
   class ImageIO {
   public:
 
@@ -24,6 +92,31 @@ namespace image {
       IO::write_view(out_filename, image_view);
       return out_filename;
     }
+
+    /// Write the view as PNG with a specific zlib compression level, 0
+    /// (store) to 9 (smallest); the default level spends a lot of CPU on
+    /// output that is usually post-processed anyway.
+    template <typename ViewT>
+    static std::string WriteView(std::string out_filename, const ViewT &image_view, int png_compression_level) {
+      io::png::write_view(out_filename, image_view, png_compression_level);
+      return out_filename;
+    }
+
+    /// Copy @a image_view and encode it to @a out_filename on a background
+    /// thread, overlapping the encodes of consecutive frames. At most
+    /// detail::EncodePipeline::max_pending_encodes images wait in the
+    /// pipeline; past that the call blocks until an encoder frees up. The
+    /// future delivers the final path, or rethrows the encoder's exception.
+    template <typename ViewT, typename IO = io::any>
+    static std::future<std::string> WriteViewAsync(std::string out_filename, const ViewT &image_view, IO io = IO()) {
+      using pixel_t = typename boost::gil::get_pixel_type<ViewT>::type;
+      boost::gil::image<pixel_t, false> copy(image_view.dimensions());
+      boost::gil::copy_pixels(image_view, boost::gil::view(copy));
+      return detail::EncodePipeline::GetInstance().Post(
+          [out_filename = std::move(out_filename), copy = std::move(copy), io]() mutable {
+            return WriteView(std::move(out_filename), boost::gil::const_view(copy), io);
+          });
+    }
   };
 
 } // namespace image
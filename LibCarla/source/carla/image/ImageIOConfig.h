@@ -6,11 +6,17 @@
 
 #pragma once
 
+#include "carla/Exception.h"
 #include "carla/FileSystem.h"
 #include "carla/Logging.h"
 #include "carla/StringUtil.h"
 #include "carla/image/BoostGil.h"
 
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
 #ifndef LIBCARLA_IMAGE_WITH_PNG_SUPPORT
 #  if defined(__has_include) && __has_include("png.h")
 #    define LIBCARLA_IMAGE_WITH_PNG_SUPPORT true
@@ -123,6 +129,13 @@ namespace detail {
       boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::png_tag());
     }
 
+    template <typename Str, typename ViewT>
+    static void write_view(Str &&out_filename, const ViewT &view, int compression_level) {
+      boost::gil::image_write_info<boost::gil::png_tag> info;
+      info._compression_level = compression_level;
+      boost::gil::write_view(std::forward<Str>(out_filename), view, info);
+    }
+
 #endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
   };
 
@@ -203,6 +216,68 @@ namespace detail {
 #endif // LIBCARLA_IMAGE_WITH_TIFF_SUPPORT
   };
 
+  /// Trivial uncompressed container: a small header (magic, width, height,
+  /// bytes per pixel) followed by the interleaved pixel rows. For pipelines
+  /// that post-process the frames anyway, skipping the PNG filter and
+  /// deflate passes is often the difference between keeping up with the
+  /// sensor rate and not.
+  struct io_raw {
+
+    static constexpr bool is_supported = true;
+
+    static constexpr const char *get_default_extension() {
+      return "raw";
+    }
+
+    template <typename Str>
+    static bool match_extension(const Str &str) {
+      return StringUtil::EndsWith(str, get_default_extension());
+    }
+
+    template <typename Str, typename ImageT>
+    static void read_image(Str &&in_filename, ImageT &image) {
+      using pixel_t = typename ImageT::value_type;
+      std::ifstream in(std::forward<Str>(in_filename), std::ios_base::binary);
+      char magic[4u];
+      uint32_t width, height, pixel_size;
+      in.read(magic, sizeof(magic));
+      in.read(reinterpret_cast<char *>(&width), sizeof(width));
+      in.read(reinterpret_cast<char *>(&height), sizeof(height));
+      in.read(reinterpret_cast<char *>(&pixel_size), sizeof(pixel_size));
+      if (!in || std::string(magic, sizeof(magic)) != "CRAW") {
+        throw_exception(std::runtime_error("invalid raw image file"));
+      }
+      if (pixel_size != sizeof(pixel_t)) {
+        throw_exception(std::runtime_error("raw image pixel type mismatch"));
+      }
+      image.recreate(width, height);
+      auto view = boost::gil::view(image);
+      std::vector<pixel_t> row(width);
+      for (uint32_t y = 0u; y < height; ++y) {
+        in.read(reinterpret_cast<char *>(row.data()), row.size() * sizeof(pixel_t));
+        std::copy(row.begin(), row.end(), view.row_begin(y));
+      }
+    }
+
+    template <typename Str, typename ViewT>
+    static void write_view(Str &&out_filename, const ViewT &view) {
+      using pixel_t = typename boost::gil::get_pixel_type<ViewT>::type;
+      std::ofstream out(std::forward<Str>(out_filename), std::ios_base::binary);
+      const uint32_t width = static_cast<uint32_t>(view.width());
+      const uint32_t height = static_cast<uint32_t>(view.height());
+      const uint32_t pixel_size = sizeof(pixel_t);
+      out.write("CRAW", 4u);
+      out.write(reinterpret_cast<const char *>(&width), sizeof(width));
+      out.write(reinterpret_cast<const char *>(&height), sizeof(height));
+      out.write(reinterpret_cast<const char *>(&pixel_size), sizeof(pixel_size));
+      std::vector<pixel_t> row(width);
+      for (std::ptrdiff_t y = 0u; y < view.height(); ++y) {
+        std::copy(view.row_begin(y), view.row_end(y), row.begin());
+        out.write(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(pixel_t));
+      }
+    }
+  };
+
   struct io_resolver {
 
     template <typename IO, typename Str>
@@ -322,6 +397,8 @@ namespace detail {
 
   struct tiff : detail::io_impl<detail::io_tiff> {};
 
+  struct raw : detail::io_impl<detail::io_raw> {};
+
 #if LIBCARLA_IMAGE_WITH_PNG_SUPPORT
 
   struct any : detail::io_any<detail::io_png, detail::io_tiff, detail::io_jpeg> {};
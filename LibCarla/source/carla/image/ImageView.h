@@ -54,6 +54,47 @@ namespace image {
       return MakeViewFromSensorImage<boost::gil::bgra8c_pixel_t>(image);
     }
 
+    /// @name Lazy view adapters
+    ///
+    /// The returned views reference the pixels of @a src, nothing is copied
+    /// or converted up front. Composed with MakeColorConvertedView, the
+    /// conversion kernel runs only on the pixels actually accessed, so e.g.
+    /// converting a 64x64 crop does not touch the rest of the frame.
+    /// @{
+
+    /// Crop of @a src at (@a x, @a y) of @a width by @a height pixels.
+    template <typename SrcViewT>
+    static auto MakeSubImageView(
+        const SrcViewT &src,
+        std::ptrdiff_t x,
+        std::ptrdiff_t y,
+        std::ptrdiff_t width,
+        std::ptrdiff_t height) {
+      DEBUG_ASSERT((x >= 0) && (y >= 0));
+      DEBUG_ASSERT((x + width <= src.width()) && (y + height <= src.height()));
+      return boost::gil::subimage_view(src, x, y, width, height);
+    }
+
+    /// @a src subsampled by taking every @a x_step'th pixel of every
+    /// @a y_step'th row.
+    template <typename SrcViewT>
+    static auto MakeSubsampledView(
+        const SrcViewT &src,
+        std::ptrdiff_t x_step,
+        std::ptrdiff_t y_step) {
+      DEBUG_ASSERT((x_step > 0) && (y_step > 0));
+      return boost::gil::subsampled_view(src, x_step, y_step);
+    }
+
+    /// Channel @a channel of @a src as a grayscale view.
+    template <typename SrcViewT>
+    static auto MakeChannelView(const SrcViewT &src, int channel) {
+      DEBUG_ASSERT((channel >= 0) && (channel < boost::gil::num_channels<SrcViewT>::value));
+      return boost::gil::nth_channel_view(src, channel);
+    }
+
+    /// @}
+
     template <typename SrcViewT, typename DstPixelT, typename CC>
     static auto MakeColorConvertedView(const SrcViewT &src, CC cc) {
       return _MakeColorConvertedView<DstPixelT>(src, cc);
@@ -75,6 +116,11 @@ namespace image {
       return _MakeColorConvertedView<DstPixelT>(src, cc);
     }
 
+    template <typename SrcViewT, typename DstPixelT = typename SrcViewT::value_type>
+    static auto MakeColorConvertedView(const SrcViewT &src, ColorConverter::Palette cc) {
+      return _MakeColorConvertedView<DstPixelT>(src, cc);
+    }
+
   private:
 
     template <typename SrcView, typename DstP, typename CC>
@@ -0,0 +1,281 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/io/DatasetFile.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace carla {
+namespace io {
+
+  static constexpr uint64_t DATASET_MAGIC = 0x6361726c612e696fu; // "carla.io"
+
+  static constexpr uint32_t DATASET_VERSION = 1u;
+
+#ifndef _WIN32
+
+  static uint64_t ComputeStride(uint64_t record_size) {
+    // round the stride up to a cache line so concurrent writers never share
+    // one.
+    const uint64_t raw = sizeof(DatasetRecordHeader) + record_size;
+    return (raw + 63u) & ~uint64_t(63u);
+  }
+
+  // ===========================================================================
+  // -- DatasetWriter ----------------------------------------------------------
+  // ===========================================================================
+
+  std::shared_ptr<DatasetWriter> DatasetWriter::Create(
+      std::string path,
+      uint64_t record_size,
+      uint64_t record_capacity) {
+    DEBUG_ASSERT((record_size > 0u) && (record_capacity > 0u));
+    const int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) {
+      log_warning("dataset: cannot create", path, ": ", std::strerror(errno));
+      return nullptr;
+    }
+    const auto stride = ComputeStride(record_size);
+    const auto mapped_size = sizeof(DatasetHeader) + record_capacity * stride;
+    if (::ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) {
+      log_warning("dataset: cannot preallocate", path, ": ", std::strerror(errno));
+      ::close(fd);
+      return nullptr;
+    }
+    auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      log_warning("dataset: cannot map", path, ": ", std::strerror(errno));
+      ::close(fd);
+      return nullptr;
+    }
+    auto *header = new (mapping) DatasetHeader();
+    header->magic = DATASET_MAGIC;
+    header->version = DATASET_VERSION;
+    header->record_stride = stride;
+    header->record_capacity = record_capacity;
+    log_debug("dataset: created shard", path, "of", mapped_size, "bytes");
+    return std::shared_ptr<DatasetWriter>(new DatasetWriter(
+        std::move(path),
+        fd,
+        reinterpret_cast<uint8_t *>(mapping),
+        mapped_size));
+  }
+
+  DatasetWriter::DatasetWriter(std::string path, int fd, uint8_t *mapping, uint64_t mapped_size)
+    : _path(std::move(path)),
+      _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {
+    const auto &header = *reinterpret_cast<const DatasetHeader *>(mapping);
+    _capacity = header.record_capacity;
+    _stride = header.record_stride;
+  }
+
+  DatasetWriter::~DatasetWriter() {
+    Close();
+  }
+
+  bool DatasetWriter::WriteRecord(uint64_t frame, const void *data, uint64_t size) {
+    if (size + sizeof(DatasetRecordHeader) > _stride) {
+      log_warning("dataset: record of", size, "bytes does not fit in", _path);
+      return false;
+    }
+    const auto position = _next.fetch_add(1u, std::memory_order_relaxed);
+    if (position >= _capacity) {
+      return false;
+    }
+    auto *slot = _mapping + sizeof(DatasetHeader) + position * _stride;
+    auto *record = reinterpret_cast<DatasetRecordHeader *>(slot);
+    record->frame = frame;
+    record->size = size;
+    std::memcpy(slot + sizeof(DatasetRecordHeader), data, size);
+    return true;
+  }
+
+  std::string DatasetWriter::Close() {
+    if (_mapping == nullptr) {
+      return _path;
+    }
+    const auto count = GetRecordCount();
+    auto &header = *reinterpret_cast<DatasetHeader *>(_mapping);
+    const uint64_t index_offset = sizeof(DatasetHeader) + count * _stride;
+    header.record_count = count;
+    header.index_offset = index_offset;
+    // build the frame index from the record headers before the mapping goes
+    // away.
+    std::vector<DatasetIndexEntry> index;
+    index.reserve(count);
+    for (uint64_t i = 0u; i < count; ++i) {
+      const uint64_t offset = sizeof(DatasetHeader) + i * _stride;
+      const auto *record = reinterpret_cast<const DatasetRecordHeader *>(_mapping + offset);
+      index.push_back(DatasetIndexEntry{record->frame, offset});
+    }
+    ::munmap(_mapping, _mapped_size);
+    _mapping = nullptr;
+    // release the unused tail of the preallocation and append the index.
+    if (::ftruncate(_fd, static_cast<off_t>(index_offset)) != 0) {
+      log_warning("dataset: cannot truncate", _path, ": ", std::strerror(errno));
+    }
+    if (::lseek(_fd, static_cast<off_t>(index_offset), SEEK_SET) >= 0) {
+      const auto index_size = index.size() * sizeof(DatasetIndexEntry);
+      if (::write(_fd, index.data(), index_size) != static_cast<ssize_t>(index_size)) {
+        log_warning("dataset: cannot write index of", _path, ": ", std::strerror(errno));
+      }
+    }
+    ::close(_fd);
+    _fd = -1;
+    return _path;
+  }
+
+  // ===========================================================================
+  // -- DatasetReader ----------------------------------------------------------
+  // ===========================================================================
+
+  std::shared_ptr<DatasetReader> DatasetReader::Open(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      log_warning("dataset: cannot open", path, ": ", std::strerror(errno));
+      return nullptr;
+    }
+    struct stat info;
+    if ((::fstat(fd, &info) != 0) || (static_cast<size_t>(info.st_size) < sizeof(DatasetHeader))) {
+      log_warning("dataset: cannot stat", path);
+      ::close(fd);
+      return nullptr;
+    }
+    const auto mapped_size = static_cast<uint64_t>(info.st_size);
+    auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      log_warning("dataset: cannot map", path, ": ", std::strerror(errno));
+      ::close(fd);
+      return nullptr;
+    }
+    const auto &header = *reinterpret_cast<const DatasetHeader *>(mapping);
+    if ((header.magic != DATASET_MAGIC) || (header.version != DATASET_VERSION)) {
+      log_warning("dataset:", path, "is not a dataset shard");
+      ::munmap(mapping, mapped_size);
+      ::close(fd);
+      return nullptr;
+    }
+    return std::shared_ptr<DatasetReader>(new DatasetReader(
+        fd,
+        reinterpret_cast<const uint8_t *>(mapping),
+        mapped_size));
+  }
+
+  DatasetReader::DatasetReader(int fd, const uint8_t *mapping, uint64_t mapped_size)
+    : _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {}
+
+  DatasetReader::~DatasetReader() {
+    ::munmap(const_cast<uint8_t *>(_mapping), _mapped_size);
+    ::close(_fd);
+  }
+
+  const DatasetHeader &DatasetReader::GetHeader() const {
+    return *reinterpret_cast<const DatasetHeader *>(_mapping);
+  }
+
+  uint64_t DatasetReader::GetRecordCount() const {
+    return GetHeader().record_count;
+  }
+
+  DatasetReader::Record DatasetReader::GetRecord(uint64_t position) const {
+    Record result;
+    const auto &header = GetHeader();
+    if (position >= header.record_count) {
+      return result;
+    }
+    const auto *slot = _mapping + sizeof(DatasetHeader) + position * header.record_stride;
+    const auto *record = reinterpret_cast<const DatasetRecordHeader *>(slot);
+    result.frame = record->frame;
+    result.data = slot + sizeof(DatasetRecordHeader);
+    result.size = record->size;
+    return result;
+  }
+
+  DatasetReader::Record DatasetReader::FindFrame(uint64_t frame) const {
+    const auto &header = GetHeader();
+    const auto *index = reinterpret_cast<const DatasetIndexEntry *>(_mapping + header.index_offset);
+    for (uint64_t i = 0u; i < header.record_count; ++i) {
+      if (index[i].frame == frame) {
+        const auto *slot = _mapping + index[i].offset;
+        const auto *record = reinterpret_cast<const DatasetRecordHeader *>(slot);
+        return Record{record->frame, slot + sizeof(DatasetRecordHeader), record->size};
+      }
+    }
+    return Record{};
+  }
+
+#else // _WIN32
+
+  std::shared_ptr<DatasetWriter> DatasetWriter::Create(std::string, uint64_t, uint64_t) {
+    log_warning("dataset: memory-mapped shards not supported on this platform");
+    return nullptr;
+  }
+
+  DatasetWriter::DatasetWriter(std::string path, int fd, uint8_t *mapping, uint64_t mapped_size)
+    : _path(std::move(path)),
+      _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {}
+
+  DatasetWriter::~DatasetWriter() {}
+
+  bool DatasetWriter::WriteRecord(uint64_t, const void *, uint64_t) {
+    return false;
+  }
+
+  std::string DatasetWriter::Close() {
+    return _path;
+  }
+
+  std::shared_ptr<DatasetReader> DatasetReader::Open(const std::string &) {
+    log_warning("dataset: memory-mapped shards not supported on this platform");
+    return nullptr;
+  }
+
+  DatasetReader::DatasetReader(int fd, const uint8_t *mapping, uint64_t mapped_size)
+    : _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {}
+
+  DatasetReader::~DatasetReader() {}
+
+  const DatasetHeader &DatasetReader::GetHeader() const {
+    return *reinterpret_cast<const DatasetHeader *>(_mapping);
+  }
+
+  uint64_t DatasetReader::GetRecordCount() const {
+    return 0u;
+  }
+
+  DatasetReader::Record DatasetReader::GetRecord(uint64_t) const {
+    return Record{};
+  }
+
+  DatasetReader::Record DatasetReader::FindFrame(uint64_t) const {
+    return Record{};
+  }
+
+#endif // _WIN32
+
+} // namespace io
+} // namespace carla
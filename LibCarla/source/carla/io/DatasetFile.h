@@ -0,0 +1,151 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace carla {
+namespace io {
+
+#pragma pack(push, 1)
+
+  /// Header at the beginning of every dataset shard.
+  struct DatasetHeader {
+    uint64_t magic = 0u;
+    uint32_t version = 0u;
+    uint64_t record_stride = 0u;   ///< Distance between consecutive records.
+    uint64_t record_capacity = 0u; ///< Records the shard was preallocated for.
+    uint64_t record_count = 0u;    ///< Records actually written, patched on close.
+    uint64_t index_offset = 0u;    ///< Offset of the frame index, 0 while writing.
+  };
+
+  /// Header of each record inside a shard.
+  struct DatasetRecordHeader {
+    uint64_t frame = 0u;
+    uint64_t size = 0u;
+  };
+
+  /// Entry of the frame index appended when a shard is closed.
+  struct DatasetIndexEntry {
+    uint64_t frame = 0u;
+    uint64_t offset = 0u;
+  };
+
+#pragma pack(pop)
+
+  /// Writes sensor frames into a single preallocated memory-mapped shard
+  /// instead of one file per frame. Records have a fixed stride, sized for
+  /// the (fixed-size) output of one sensor, so any record is addressable
+  /// without parsing and several threads can write concurrently: each
+  /// WriteRecord claims a slot with an atomic increment and copies into it
+  /// without taking any lock. On close, the unused tail of the shard is
+  /// released and a frame index is appended.
+  class DatasetWriter : private NonCopyable {
+  public:
+
+    /// Creates the shard at @a path preallocated for @a record_capacity
+    /// records of up to @a record_size bytes each. Returns nullptr if the
+    /// file cannot be created or mapped (or on platforms without mmap).
+    static std::shared_ptr<DatasetWriter> Create(
+        std::string path,
+        uint64_t record_size,
+        uint64_t record_capacity);
+
+    /// Patches the header and closes the shard if still open.
+    ~DatasetWriter();
+
+    /// Copies @a size bytes of @a data into the next free record, tagged
+    /// with @a frame. Thread-safe and lock-free. Returns false when the
+    /// shard is full or the payload exceeds the record size.
+    bool WriteRecord(uint64_t frame, const void *data, uint64_t size);
+
+    /// @copydoc WriteRecord
+    bool WriteRecord(uint64_t frame, const Buffer &buffer) {
+      return WriteRecord(frame, buffer.data(), buffer.size());
+    }
+
+    uint64_t GetRecordCount() const {
+      return std::min(_next.load(std::memory_order_relaxed), _capacity);
+    }
+
+    uint64_t GetCapacity() const {
+      return _capacity;
+    }
+
+    /// Truncate the shard to the records actually written, append the frame
+    /// index, patch the header and unmap. Called by the destructor if not
+    /// called explicitly; returns the final path.
+    std::string Close();
+
+  private:
+
+    DatasetWriter(std::string path, int fd, uint8_t *mapping, uint64_t mapped_size);
+
+    std::string _path;
+
+    int _fd = -1;
+
+    uint8_t *_mapping = nullptr;
+
+    uint64_t _mapped_size = 0u;
+
+    uint64_t _capacity = 0u;
+
+    uint64_t _stride = 0u;
+
+    std::atomic<uint64_t> _next{0u};
+  };
+
+  /// Read-only view of a closed dataset shard; the records are accessed in
+  /// place through the mapping, nothing is loaded up front.
+  class DatasetReader : private NonCopyable {
+  public:
+
+    /// A record inside the mapped shard; valid while the reader is alive.
+    struct Record {
+      uint64_t frame = 0u;
+      const uint8_t *data = nullptr;
+      uint64_t size = 0u;
+    };
+
+    /// Maps the shard at @a path. Returns nullptr if the file cannot be
+    /// mapped or is not a dataset shard.
+    static std::shared_ptr<DatasetReader> Open(const std::string &path);
+
+    ~DatasetReader();
+
+    uint64_t GetRecordCount() const;
+
+    /// Record at @a position in write order.
+    Record GetRecord(uint64_t position) const;
+
+    /// Looks @a frame up in the embedded index; returns a record with null
+    /// data if the frame is not in this shard.
+    Record FindFrame(uint64_t frame) const;
+
+  private:
+
+    DatasetReader(int fd, const uint8_t *mapping, uint64_t mapped_size);
+
+    const DatasetHeader &GetHeader() const;
+
+    int _fd = -1;
+
+    const uint8_t *_mapping = nullptr;
+
+    uint64_t _mapped_size = 0u;
+  };
+
+} // namespace io
+} // namespace carla
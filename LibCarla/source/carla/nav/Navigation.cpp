@@ -12,10 +12,20 @@
 #include "carla/nav/Navigation.h"
 #include "carla/nav/WalkerManager.h"
 #include "carla/geom/Math.h"
+#include "carla/TaskScheduler.h"
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+#include <future>
 #include <iterator>
 #include <fstream>
 #include <mutex>
+#include <unordered_set>
 
 namespace carla {
 namespace nav {
@@ -43,11 +53,52 @@ namespace nav {
   static const float AREA_GRASS_COST =  1.0f;
   static const float AREA_ROAD_COST  = 10.0f;
 
+  // the crowd is split into this many shards stepped in parallel
+  static const int   CROWD_SHARD_COUNT = 8;
+  // side in meters of the square regions assigned to the shards
+  static const float CROWD_SHARD_CELL_SIZE = 128.0f;
+
   // return a random float
   static float frand() {
     return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
   }
 
+  // SplitMix64 finalizer: a bijection on 64-bit words with full avalanche
+  static uint64_t MixBits(uint64_t z) {
+    z += 0x9e3779b97f4a7c15u;
+    z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31u);
+  }
+
+  // counter-based random float in [0, 1); a pure function of the seed, the
+  // walker and the draw index, so decisions stay reproducible no matter how
+  // the crowd shards interleave
+  static float WalkerRand(unsigned int seed, ActorId id, uint32_t draw) {
+    const uint64_t stream_key = MixBits((static_cast<uint64_t>(seed) << 32u) + id);
+    const uint64_t word = MixBits(stream_key + draw);
+    return static_cast<float>(word >> 40u) * (1.0f / 16777216.0f);
+  }
+
+  // return the shard owning a position on the ground plane; walkers of the
+  // same region always share a crowd so local avoidance keeps working
+  static int GetCrowdShard(float x, float y) {
+    const int cell_x = static_cast<int>(std::floor(x / CROWD_SHARD_CELL_SIZE));
+    const int cell_y = static_cast<int>(std::floor(y / CROWD_SHARD_CELL_SIZE));
+    const unsigned int hash =
+        (static_cast<unsigned int>(cell_x) * 73856093u) ^
+        (static_cast<unsigned int>(cell_y) * 19349663u);
+    return static_cast<int>(hash % static_cast<unsigned int>(CROWD_SHARD_COUNT));
+  }
+
+  // shared pool stepping the crowd shards, started on first use
+  static TaskScheduler &GetCrowdScheduler() {
+    static TaskScheduler scheduler;
+    static std::once_flag started;
+    std::call_once(started, [] { scheduler.AsyncRun(); });
+    return scheduler;
+  }
+
   Navigation::Navigation() {
     // assign walker manager
     _walker_manager.SetNav(this);
@@ -60,32 +111,84 @@ namespace nav {
     _mapped_vehicles_id.clear();
     _mapped_by_index.clear();
     _walkers_blocked_position.clear();
+    _walker_draw_count.clear();
     _yaw_walkers.clear();
-    _binary_mesh.clear();
-    dtFreeCrowd(_crowd);
+    for (dtCrowd *crowd : _crowds) {
+      dtFreeCrowd(crowd);
+    }
+    _crowds.clear();
     dtFreeNavMeshQuery(_nav_query);
     dtFreeNavMesh(_nav_mesh);
+    // the tiles reference the backing buffer, release it after the mesh
+    ReleaseMeshBacking();
   }
 
   // load navigation data
   bool Navigation::Load(const std::string &filename) {
-    std::ifstream f;
-    std::istream_iterator<uint8_t> start(f), end;
-
+#ifndef _WIN32
+    // map the file instead of streaming it; the tiles reference the mapping
+    // in place, so big meshes load without copying the data and the pages
+    // are shared with every other process mapping the same file
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_info;
+    if (::fstat(fd, &file_info) != 0 || file_info.st_size <= 0) {
+      ::close(fd);
+      return false;
+    }
+    const size_t size = static_cast<size_t>(file_info.st_size);
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // fault the pages in upfront instead of one page miss at a time
+    flags |= MAP_POPULATE;
+#endif // MAP_POPULATE
+    // Detour writes the tile link lists inside the tile data, the private
+    // mapping keeps those writes copy-on-write per page
+    auto *mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      return false;
+    }
+    if (!LoadMesh(static_cast<uint8_t *>(mapping), size)) {
+      ::munmap(mapping, size);
+      return false;
+    }
+    // the new tiles are in place, drop whatever backed the previous mesh
+    ReleaseMeshBacking();
+    _mapped_mesh = static_cast<uint8_t *>(mapping);
+    _mapped_size = size;
+    return true;
+#else
     // read the whole file
-    f.open(filename, std::ios::binary);
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
     if (!f.is_open()) {
       return false;
     }
-    std::vector<uint8_t> content(start, end);
+    std::vector<uint8_t> content(static_cast<size_t>(f.tellg()));
+    f.seekg(0, std::ios::beg);
+    f.read(reinterpret_cast<char *>(content.data()), static_cast<std::streamsize>(content.size()));
     f.close();
 
     // parse the content
     return Load(std::move(content));
+#endif // _WIN32
   }
 
   // load navigation data from memory
   bool Navigation::Load(std::vector<uint8_t> content) {
+    if (!LoadMesh(content.data(), content.size())) {
+      return false;
+    }
+    // the new tiles are in place, drop whatever backed the previous mesh
+    ReleaseMeshBacking();
+    _binary_mesh = std::move(content);
+    return true;
+  }
+
+  // build the mesh from a buffer that must outlive it
+  bool Navigation::LoadMesh(uint8_t *content, size_t size) {
     const int NAVMESHSET_MAGIC = 'M' << 24 | 'S' << 16 | 'E' << 8 | 'T'; // 'MSET';
     const int NAVMESHSET_VERSION = 1;
 #pragma pack(push, 1)
@@ -103,7 +206,7 @@ namespace nav {
 #pragma pack(pop)
 
     // check size for header
-    if (content.size() < sizeof(header)) {
+    if (size < sizeof(header)) {
       logging::log("Nav: failed loading binary");
       return false;
     }
@@ -135,36 +238,26 @@ namespace nav {
       NavMeshTileHeader tile_header;
 
       // read the tile header
-      memcpy(&tile_header, &content[pos], sizeof(tile_header));
-      pos += sizeof(tile_header);
-      if (pos >= content.size()) {
+      if (pos + sizeof(tile_header) > size) {
         dtFreeNavMesh(mesh);
         return false;
       }
+      memcpy(&tile_header, &content[pos], sizeof(tile_header));
+      pos += sizeof(tile_header);
 
       // check for valid tile
       if (!tile_header.tile_ref || !tile_header.data_size) {
         break;
       }
-
-      // allocate the buffer
-      char *data = static_cast<char *>(dtAlloc(static_cast<size_t>(tile_header.data_size), DT_ALLOC_PERM));
-      if (!data) {
-        break;
-      }
-
-      // read the tile
-      memcpy(data, &content[pos], static_cast<size_t>(tile_header.data_size));
-      pos += static_cast<unsigned long>(tile_header.data_size);
-      if (pos > content.size()) {
-        dtFree(data);
+      if (pos + static_cast<unsigned long>(tile_header.data_size) > size) {
         dtFreeNavMesh(mesh);
         return false;
       }
 
-      // add the tile data
-      mesh->addTile(reinterpret_cast<unsigned char *>(data), tile_header.data_size, DT_TILE_FREE_DATA,
-      tile_header.tile_ref, 0);
+      // hand the tile over in place instead of copying it into a dtAlloc
+      // block; no DT_TILE_FREE_DATA, the backing buffer owns the memory
+      mesh->addTile(&content[pos], tile_header.data_size, 0, tile_header.tile_ref, 0);
+      pos += static_cast<unsigned long>(tile_header.data_size);
     }
 
     // exchange
@@ -176,8 +269,6 @@ namespace nav {
     _nav_query = dtAllocNavMeshQuery();
     _nav_query->init(_nav_mesh, MAX_QUERY_SEARCH_NODES);
 
-    // copy
-    _binary_mesh = std::move(content);
     _ready = true;
 
     // create and init the crowd manager
@@ -186,6 +277,18 @@ namespace nav {
     return true;
   }
 
+  // release the buffer or file mapping backing the current tiles
+  void Navigation::ReleaseMeshBacking() {
+    _binary_mesh = std::vector<uint8_t>();
+#ifndef _WIN32
+    if (_mapped_mesh != nullptr) {
+      ::munmap(_mapped_mesh, _mapped_size);
+      _mapped_mesh = nullptr;
+      _mapped_size = 0u;
+    }
+#endif // _WIN32
+  }
+
   void Navigation::CreateCrowd(void) {
 
     // check if all is ready
@@ -193,62 +296,72 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd == nullptr);
+    DEBUG_ASSERT(_crowds.empty());
 
-    // create and init
-    _crowd = dtAllocCrowd();
-    // these radius should be the maximum size of the vehicles (CarlaCola for Carla)
-    const float max_agent_radius = AGENT_RADIUS * 20;
-    if (!_crowd->init(MAX_AGENTS, max_agent_radius, _nav_mesh)) {
-      logging::log("Nav: failed to create crowd");
-      return;
-    }
+    // create and init one crowd per shard, all configured the same
+    for (int shard = 0; shard < CROWD_SHARD_COUNT; ++shard) {
+      dtCrowd *crowd = dtAllocCrowd();
+      // these radius should be the maximum size of the vehicles (CarlaCola for Carla)
+      const float max_agent_radius = AGENT_RADIUS * 20;
+      if (!crowd->init(MAX_AGENTS, max_agent_radius, _nav_mesh)) {
+        logging::log("Nav: failed to create crowd");
+        dtFreeCrowd(crowd);
+        return;
+      }
 
-    // set different filters
-    // filter 0 can not walk on roads
-    _crowd->getEditableFilter(0)->setIncludeFlags(CARLA_TYPE_WALKABLE);
-    _crowd->getEditableFilter(0)->setExcludeFlags(CARLA_TYPE_ROAD);
-    _crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
-    _crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
-    // filter 1 can walk on roads
-    _crowd->getEditableFilter(1)->setIncludeFlags(CARLA_TYPE_WALKABLE);
-    _crowd->getEditableFilter(1)->setExcludeFlags(CARLA_TYPE_NONE);
-    _crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
-    _crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
-
-    // Setup local avoidance params to different qualities.
-    dtObstacleAvoidanceParams params;
-    // Use mostly default settings, copy from dtCrowd.
-    memcpy(&params, _crowd->getObstacleAvoidanceParams(0), sizeof(dtObstacleAvoidanceParams));
-
-    // Low (11)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 5;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 1;
-    _crowd->setObstacleAvoidanceParams(0, &params);
-
-    // Medium (22)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 5;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 2;
-    _crowd->setObstacleAvoidanceParams(1, &params);
-
-    // Good (45)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 7;
-    params.adaptiveRings = 2;
-    params.adaptiveDepth = 3;
-    _crowd->setObstacleAvoidanceParams(2, &params);
-
-    // High (66)
-    params.velBias = 0.5f;
-    params.adaptiveDivs = 7;
-    params.adaptiveRings = 3;
-    params.adaptiveDepth = 3;
-
-    _crowd->setObstacleAvoidanceParams(3, &params);
+      // set different filters
+      // filter 0 can not walk on roads
+      crowd->getEditableFilter(0)->setIncludeFlags(CARLA_TYPE_WALKABLE);
+      crowd->getEditableFilter(0)->setExcludeFlags(CARLA_TYPE_ROAD);
+      crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
+      crowd->getEditableFilter(0)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
+      // filter 1 can walk on roads
+      crowd->getEditableFilter(1)->setIncludeFlags(CARLA_TYPE_WALKABLE);
+      crowd->getEditableFilter(1)->setExcludeFlags(CARLA_TYPE_NONE);
+      crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_ROAD, AREA_ROAD_COST);
+      crowd->getEditableFilter(1)->setAreaCost(CARLA_AREA_GRASS, AREA_GRASS_COST);
+
+      // Setup local avoidance params to different qualities.
+      dtObstacleAvoidanceParams params;
+      // Use mostly default settings, copy from dtCrowd.
+      memcpy(&params, crowd->getObstacleAvoidanceParams(0), sizeof(dtObstacleAvoidanceParams));
+
+      // Low (11)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 5;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 1;
+      crowd->setObstacleAvoidanceParams(0, &params);
+
+      // Medium (22)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 5;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 2;
+      crowd->setObstacleAvoidanceParams(1, &params);
+
+      // Good (45)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 7;
+      params.adaptiveRings = 2;
+      params.adaptiveDepth = 3;
+      crowd->setObstacleAvoidanceParams(2, &params);
+
+      // High (66)
+      params.velBias = 0.5f;
+      params.adaptiveDivs = 7;
+      params.adaptiveRings = 3;
+      params.adaptiveDepth = 3;
+
+      crowd->setObstacleAvoidanceParams(3, &params);
+
+      _crowds.push_back(crowd);
+    }
+
+    // per shard bookkeeping
+    _mapped_by_index.resize(_crowds.size());
+    _walkers_blocked_position.resize(_crowds.size());
+    _walker_draw_count.resize(_crowds.size());
   }
 
   // return the path points to go from one position to another
@@ -389,7 +502,8 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      filter = _crowd->getFilter(_crowd->getAgent(it->second)->params.queryFilterType);
+      dtCrowd *crowd = GetAgentCrowd(it->second);
+      filter = crowd->getFilter(crowd->getAgent(it->second.index)->params.queryFilterType);
     }
 
     // set the points
@@ -466,7 +580,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // set parameters
     memset(&params, 0, sizeof(params));
@@ -478,8 +592,9 @@ namespace nav {
     params.obstacleAvoidanceType = 3;
     params.separationWeight = 0.5f;
     
-    // set if the agent can cross roads or not
-    if (frand() <= _probability_crossing) {
+    // set if the agent can cross roads or not; first draw of the walker's
+    // counter-based stream so respawning the same id reproduces the decision
+    if (WalkerRand(_seed, id, 0u) <= _probability_crossing) {
       params.queryFilterType = 1;
     } else {
       params.queryFilterType = 0;
@@ -494,20 +609,24 @@ namespace nav {
     // from Unreal coordinates (subtract half height to move pivot from center
     // (unreal) to bottom (recast))
     float point_from[3] = { from.x, from.z - (AGENT_HEIGHT / 2.0f), from.y };
-    // add walker
-    int index;
+    // add walker to the shard owning its region
+    AgentHandle handle;
+    handle.crowd = GetCrowdShard(from.x, from.y);
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      index = _crowd->addAgent(point_from, &params);
-      if (index == -1) {
+      handle.index = GetAgentCrowd(handle)->addAgent(point_from, &params);
+      if (handle.index == -1) {
         return false;
       }
     }
 
     // save the id
-    _mapped_walkers_id[id] = index;
-    _mapped_by_index[index] = id;
+    _mapped_walkers_id[id] = handle;
+    _mapped_by_index[static_cast<size_t>(handle.crowd)][handle.index] = id;
+
+    // the crossing decision above consumed draw 0 of this walker's stream
+    _walker_draw_count[static_cast<size_t>(handle.crowd)][handle.index] = 1u;
 
     // init yaw
     _yaw_walkers[id] = 0.0f;
@@ -528,7 +647,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the bounding box extension plus some space around
     float marge = 0.8f;
@@ -551,18 +670,21 @@ namespace nav {
     box_corner3 += vehicle.transform.location;
     box_corner4 += vehicle.transform.location;
 
-    // check if this actor exists
+    // check if this actor exists, updating its agent in every shard
     auto it = _mapped_vehicles_id.find(vehicle.id);
     if (it != _mapped_vehicles_id.end()) {
-      // get the index found
-      int index = it->second;
-      if (index != -1) {
+      for (size_t shard = 0; shard < it->second.size(); ++shard) {
+        // get the index found
+        int index = it->second[shard];
+        if (index == -1) {
+          continue;
+        }
         // get the agent
         dtCrowdAgent *agent;
         {
           // critical section, force single thread running this
           std::lock_guard<std::mutex> lock(_mutex);
-          agent = _crowd->getEditableAgent(index);
+          agent = _crowds[shard]->getEditableAgent(index);
         }
         if (agent) {
           // update its position
@@ -583,8 +705,8 @@ namespace nav {
           agent->params.obb[10] = box_corner4.z;
           agent->params.obb[11] = box_corner4.y;
         }
-        return true;
       }
+      return true;
     }
 
     // set parameters
@@ -622,27 +744,30 @@ namespace nav {
                             vehicle.transform.location.z,
                             vehicle.transform.location.y };
 
-    // add walker
-    int index;
+    // mirror the vehicle into every shard so all walkers avoid it
+    std::vector<int> indices;
+    indices.reserve(_crowds.size());
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      index = _crowd->addAgent(point_from, &params);
-      if (index == -1) {
-        logging::log("Vehicle agent not added to the crowd by some problem!");
-        return false;
-      }
-
-      // mark as valid
-      dtCrowdAgent *agent = _crowd->getEditableAgent(index);
-      if (agent) {
-        agent->state = DT_CROWDAGENT_STATE_WALKING;
+      for (size_t shard = 0; shard < _crowds.size(); ++shard) {
+        int index = _crowds[shard]->addAgent(point_from, &params);
+        if (index == -1) {
+          logging::log("Vehicle agent not added to the crowd by some problem!");
+        } else {
+          // mark as valid
+          dtCrowdAgent *agent = _crowds[shard]->getEditableAgent(index);
+          if (agent) {
+            agent->state = DT_CROWDAGENT_STATE_WALKING;
+          }
+          _mapped_by_index[shard][index] = vehicle.id;
+        }
+        indices.push_back(index);
       }
     }
 
     // save the id
-    _mapped_vehicles_id[vehicle.id] = index;
-    _mapped_by_index[index] = vehicle.id;
+    _mapped_vehicles_id[vehicle.id] = std::move(indices);
 
     return true;
   }
@@ -655,37 +780,44 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal walker index
     auto it = _mapped_walkers_id.find(id);
     if (it != _mapped_walkers_id.end()) {
+      const AgentHandle handle = it->second;
       // remove from crowd
       {
         // critical section, force single thread running this
         std::lock_guard<std::mutex> lock(_mutex);
-        _crowd->removeAgent(it->second);
+        GetAgentCrowd(handle)->removeAgent(handle.index);
       }
       _walker_manager.RemoveWalker(id);
       // remove from mapping
       _mapped_walkers_id.erase(it);
-      _mapped_by_index.erase(it->second);
+      _mapped_by_index[static_cast<size_t>(handle.crowd)].erase(handle.index);
 
       return true;
     }
 
-    // get the internal vehicle index
-    it = _mapped_vehicles_id.find(id);
-    if (it != _mapped_vehicles_id.end()) {
-      // remove from crowd
-      {
-        // critical section, force single thread running this
-        std::lock_guard<std::mutex> lock(_mutex);
-        _crowd->removeAgent(it->second);
+    // get the internal vehicle indices, one per shard
+    auto it2 = _mapped_vehicles_id.find(id);
+    if (it2 != _mapped_vehicles_id.end()) {
+      for (size_t shard = 0; shard < it2->second.size(); ++shard) {
+        int index = it2->second[shard];
+        if (index == -1) {
+          continue;
+        }
+        // remove from crowd
+        {
+          // critical section, force single thread running this
+          std::lock_guard<std::mutex> lock(_mutex);
+          _crowds[shard]->removeAgent(index);
+        }
+        // remove from mapping
+        _mapped_by_index[shard].erase(index);
       }
-      // remove from mapping
-      _mapped_vehicles_id.erase(it);
-      _mapped_by_index.erase(it->second);
+      _mapped_vehicles_id.erase(it2);
 
       return true;
     }
@@ -727,7 +859,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -739,7 +871,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      dtCrowdAgent *agent = _crowd->getEditableAgent(it->second);
+      dtCrowdAgent *agent = GetAgentCrowd(it->second)->getEditableAgent(it->second.index);
       if (agent) {
         agent->params.maxSpeed = max_speed;
         return true;
@@ -784,17 +916,17 @@ namespace nav {
   }
 
   // set a new target point to go directly without events
-  bool Navigation::SetWalkerDirectTargetIndex(int index, carla::geom::Location to) {
+  bool Navigation::SetWalkerDirectTargetIndex(AgentHandle handle, carla::geom::Location to) {
 
     // check if all is ready
     if (!_ready) {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
     DEBUG_ASSERT(_nav_query != nullptr);
 
-    if (index == -1) {
+    if (handle.crowd == -1 || handle.index == -1) {
       return false;
     }
 
@@ -805,14 +937,15 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      const dtQueryFilter *filter = _crowd->getFilter(0);
+      dtCrowd *crowd = GetAgentCrowd(handle);
+      const dtQueryFilter *filter = crowd->getFilter(0);
       dtPolyRef target_ref;
-      _nav_query->findNearestPoly(point_to, _crowd->getQueryHalfExtents(), filter, &target_ref, nearest);
+      _nav_query->findNearestPoly(point_to, crowd->getQueryHalfExtents(), filter, &target_ref, nearest);
       if (!target_ref) {
         return false;
       }
 
-      res = _crowd->requestMoveTarget(index, target_ref, point_to);
+      res = crowd->requestMoveTarget(handle.index, target_ref, point_to);
     }
 
     return res;
@@ -826,14 +959,48 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
-    // update crowd agents
+    // update crowd agents, stepping the shards in parallel; each task only
+    // touches its own crowd and the navmesh is read-only during the update
     _delta_seconds = state.GetTimestamp().delta_seconds;
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      _crowd->update(static_cast<float>(_delta_seconds), nullptr);
+      if (_crowds.size() == 1u) {
+        _crowds.front()->update(static_cast<float>(_delta_seconds), nullptr);
+      } else {
+        auto &scheduler = GetCrowdScheduler();
+        std::vector<std::future<void>> shards;
+        shards.reserve(_crowds.size());
+        for (dtCrowd *crowd : _crowds) {
+          shards.emplace_back(scheduler.Post([this, crowd]() {
+            crowd->update(static_cast<float>(_delta_seconds), nullptr);
+          }));
+        }
+        for (auto &shard : shards) {
+          shard.get();
+        }
+      }
+    }
+
+    // hand walkers over when they crossed a region boundary
+    {
+      // critical section, force single thread running this
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (size_t shard = 0; shard < _crowds.size(); ++shard) {
+        const int total = _crowds[shard]->getAgentCount();
+        for (int i = 0; i < total; ++i) {
+          const dtCrowdAgent *walker = _crowds[shard]->getAgent(i);
+          if (!walker->active || walker->params.useObb) {
+            continue;
+          }
+          const int target_crowd = GetCrowdShard(walker->npos[0], walker->npos[2]);
+          if (target_crowd != static_cast<int>(shard)) {
+            HandOverWalker(AgentHandle{static_cast<int>(shard), i}, target_crowd);
+          }
+        }
+      }
     }
 
     // update the walkers route
@@ -844,57 +1011,60 @@ namespace nav {
 
     // check all active agents
     int total_unblocked = 0;
-    int total_agents;
-    {
-      // critical section, force single thread running this
-      std::lock_guard<std::mutex> lock(_mutex);
-      total_agents = _crowd->getAgentCount();
-    }
-    const dtCrowdAgent *ag;
-    for (int i = 0; i < total_agents; ++i) {
+    for (size_t shard = 0; shard < _crowds.size(); ++shard) {
+      int total_agents;
       {
         // critical section, force single thread running this
         std::lock_guard<std::mutex> lock(_mutex);
-        ag = _crowd->getAgent(i);
-      }
-      if (!ag->active || ag->paused) {
-        continue;
+        total_agents = _crowds[shard]->getAgentCount();
       }
+      const dtCrowdAgent *ag;
+      for (int i = 0; i < total_agents; ++i) {
+        {
+          // critical section, force single thread running this
+          std::lock_guard<std::mutex> lock(_mutex);
+          ag = _crowds[shard]->getAgent(i);
+        }
+        if (!ag->active || ag->paused) {
+          continue;
+        }
 
-      // check only pedestrians not paused, and no vehicles
-      if (!ag->params.useObb && !ag->paused) {
-        bool reset_target_pos = false;
-        bool use_same_filter = false;
-
-        // check for unblocking actors
-        if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
-          // get the distance moved by each actor
-          carla::geom::Vector3D previous = _walkers_blocked_position[i];
-          carla::geom::Vector3D current = carla::geom::Vector3D(ag->npos[0], ag->npos[1], ag->npos[2]);
-          carla::geom::Vector3D distance = current - previous;
-          float d = distance.SquaredLength();
-          if (d < AGENT_UNBLOCK_DISTANCE_SQUARED) {
-            ++total_unblocked;
-            reset_target_pos = true;
-            use_same_filter = true;
-          }
-          // update with current position
-          _walkers_blocked_position[i] = current;
-
-          // check to assign a new target position
-          if (reset_target_pos) {
-            // set if the agent can cross roads or not
-            if (!use_same_filter) {
-              if (frand() <= _probability_crossing) {
-                SetAgentFilter(i, 1);
-              } else {
-                SetAgentFilter(i, 0);
+        // check only pedestrians not paused, and no vehicles
+        if (!ag->params.useObb && !ag->paused) {
+          bool reset_target_pos = false;
+          bool use_same_filter = false;
+
+          // check for unblocking actors
+          if (_time_to_unblock >= AGENT_UNBLOCK_TIME) {
+            // get the distance moved by each actor
+            carla::geom::Vector3D previous = _walkers_blocked_position[shard][i];
+            carla::geom::Vector3D current = carla::geom::Vector3D(ag->npos[0], ag->npos[1], ag->npos[2]);
+            carla::geom::Vector3D distance = current - previous;
+            float d = distance.SquaredLength();
+            if (d < AGENT_UNBLOCK_DISTANCE_SQUARED) {
+              ++total_unblocked;
+              reset_target_pos = true;
+              use_same_filter = true;
+            }
+            // update with current position
+            _walkers_blocked_position[shard][i] = current;
+
+            // check to assign a new target position
+            if (reset_target_pos) {
+              // set if the agent can cross roads or not; draw from the
+              // walker's own stream so the sharded update stays reproducible
+              if (!use_same_filter) {
+                if (WalkerRand(_seed, _mapped_by_index[shard][i], _walker_draw_count[shard][i]++) <= _probability_crossing) {
+                  SetAgentFilter(AgentHandle{static_cast<int>(shard), i}, 1);
+                } else {
+                  SetAgentFilter(AgentHandle{static_cast<int>(shard), i}, 0);
+                }
               }
+              // set a new random target
+              carla::geom::Location location;
+              GetRandomLocation(location, nullptr);
+              _walker_manager.SetWalkerRoute(_mapped_by_index[shard][i], location);
             }
-            // set a new random target
-            carla::geom::Location location;
-            GetRandomLocation(location, nullptr);
-            _walker_manager.SetWalkerRoute(_mapped_by_index[i], location);
           }
         }
       }
@@ -906,6 +1076,66 @@ namespace nav {
     }
   }
 
+  // move a walker to another shard keeping its parameters and target;
+  // expects _mutex to be held by the caller
+  void Navigation::HandOverWalker(AgentHandle handle, int target_crowd) {
+    dtCrowd *source = GetAgentCrowd(handle);
+    const dtCrowdAgent *walker = source->getAgent(handle.index);
+
+    // keep what the new agent needs before removing the old one
+    const dtCrowdAgentParams params = walker->params;
+    float position[3] = { walker->npos[0], walker->npos[1], walker->npos[2] };
+    float target[3] = { walker->targetPos[0], walker->targetPos[1], walker->targetPos[2] };
+    const bool has_target = (walker->targetState != DT_CROWDAGENT_TARGET_NONE);
+    const bool paused = walker->paused;
+
+    // add to the new shard first, keep the walker where it is on failure
+    dtCrowd *destination = _crowds[static_cast<size_t>(target_crowd)];
+    const int new_index = destination->addAgent(position, &params);
+    if (new_index == -1) {
+      return;
+    }
+    destination->getEditableAgent(new_index)->paused = paused;
+    source->removeAgent(handle.index);
+
+    // update the mappings
+    auto &by_index = _mapped_by_index[static_cast<size_t>(handle.crowd)];
+    auto it = by_index.find(handle.index);
+    if (it != by_index.end()) {
+      const ActorId id = it->second;
+      by_index.erase(it);
+      _mapped_by_index[static_cast<size_t>(target_crowd)][new_index] = id;
+      _mapped_walkers_id[id] = AgentHandle{target_crowd, new_index};
+    }
+
+    // move the blocked-position bookkeeping
+    auto &blocked = _walkers_blocked_position[static_cast<size_t>(handle.crowd)];
+    auto it_blocked = blocked.find(handle.index);
+    if (it_blocked != blocked.end()) {
+      _walkers_blocked_position[static_cast<size_t>(target_crowd)][new_index] = it_blocked->second;
+      blocked.erase(it_blocked);
+    }
+
+    // move the random stream draw counter
+    auto &draws = _walker_draw_count[static_cast<size_t>(handle.crowd)];
+    auto it_draws = draws.find(handle.index);
+    if (it_draws != draws.end()) {
+      _walker_draw_count[static_cast<size_t>(target_crowd)][new_index] = it_draws->second;
+      draws.erase(it_draws);
+    }
+
+    // re-request the current target on the new crowd
+    if (has_target) {
+      const dtQueryFilter *filter = destination->getFilter(0);
+      dtPolyRef target_ref;
+      float nearest[3];
+      _nav_query->findNearestPoly(target, destination->getQueryHalfExtents(), filter, &target_ref, nearest);
+      if (target_ref) {
+        destination->requestMoveTarget(new_index, target_ref, target);
+      }
+    }
+  }
+
   // get the walker current transform
   bool Navigation::GetWalkerTransform(ActorId id, carla::geom::Transform &trans) {
 
@@ -914,7 +1144,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -922,9 +1152,9 @@ namespace nav {
       return false;
     }
 
-    // get the index found
-    int index = it->second;
-    if (index == -1) {
+    // get the handle found
+    const AgentHandle handle = it->second;
+    if (handle.index == -1) {
       return false;
     }
 
@@ -933,7 +1163,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = GetAgentCrowd(handle)->getAgent(handle.index);
     }
 
     if (!agent->active) {
@@ -978,7 +1208,7 @@ namespace nav {
       return false;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -986,9 +1216,9 @@ namespace nav {
       return false;
     }
 
-    // get the index found
-    int index = it->second;
-    if (index == -1) {
+    // get the handle found
+    const AgentHandle handle = it->second;
+    if (handle.index == -1) {
       return false;
     }
 
@@ -997,7 +1227,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = GetAgentCrowd(handle)->getAgent(handle.index);
     }
 
     if (!agent->active) {
@@ -1012,6 +1242,43 @@ namespace nav {
     return true;
   }
 
+  // get the current location of several walkers at once; walkers not
+  // found keep the default location
+  void Navigation::GetWalkersPosition(const std::vector<ActorId> &ids, std::vector<carla::geom::Location> &locations) {
+
+    locations.clear();
+    locations.resize(ids.size());
+
+    // check if all is ready
+    if (!_ready) {
+      return;
+    }
+
+    DEBUG_ASSERT(!_crowds.empty());
+
+    // critical section, force single thread running this
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < ids.size(); ++i) {
+
+      // get the handle found
+      auto it = _mapped_walkers_id.find(ids[i]);
+      if (it == _mapped_walkers_id.end() || it->second.index == -1) {
+        continue;
+      }
+
+      // get the walker
+      const dtCrowdAgent *agent = GetAgentCrowd(it->second)->getAgent(it->second.index);
+      if (!agent->active) {
+        continue;
+      }
+
+      // set its position in Unreal coordinates
+      locations[i].x = agent->npos[0];
+      locations[i].y = agent->npos[2];
+      locations[i].z = agent->npos[1];
+    }
+  }
+
   float Navigation::GetWalkerSpeed(ActorId id) {
 
     // check if all is ready
@@ -1019,7 +1286,7 @@ namespace nav {
       return 0.0f;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -1027,9 +1294,9 @@ namespace nav {
       return 0.0f;
     }
 
-    // get the index found
-    int index = it->second;
-    if (index == -1) {
+    // get the handle found
+    const AgentHandle handle = it->second;
+    if (handle.index == -1) {
       return 0.0f;
     }
 
@@ -1038,7 +1305,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getAgent(index);
+      agent = GetAgentCrowd(handle)->getAgent(handle.index);
     }
 
     return sqrt(agent->vel[0] * agent->vel[0] + agent->vel[1] * agent->vel[1] + agent->vel[2] *
@@ -1087,14 +1354,14 @@ namespace nav {
   }
 
   // assign a filter index to an agent
-  void Navigation::SetAgentFilter(int agent_index, int filter_index)
+  void Navigation::SetAgentFilter(AgentHandle handle, int filter_index)
   {
     // get the walker
     dtCrowdAgent *agent;
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(agent_index);
+      agent = GetAgentCrowd(handle)->getEditableAgent(handle.index);
     }
     agent->params.queryFilterType = static_cast<unsigned char>(filter_index);
   }
@@ -1108,6 +1375,14 @@ namespace nav {
     _probability_crossing = percentage;
   }
 
+  // set the seed of the per-walker random streams; also seeds the generator
+  // behind GetRandomLocation so target picking repeats too
+  void Navigation::SetSeed(unsigned int seed)
+  {
+    _seed = seed;
+    srand(seed);
+  }
+
   // set an agent as paused for the crowd
   void Navigation::PauseAgent(ActorId id, bool pause) {
     // check if all is ready
@@ -1115,7 +1390,7 @@ namespace nav {
       return;
     }
 
-    DEBUG_ASSERT(_crowd != nullptr);
+    DEBUG_ASSERT(!_crowds.empty());
 
     // get the internal index
     auto it = _mapped_walkers_id.find(id);
@@ -1123,9 +1398,9 @@ namespace nav {
       return;
     }
 
-    // get the index found
-    int index = it->second;
-    if (index == -1) {
+    // get the handle found
+    const AgentHandle handle = it->second;
+    if (handle.index == -1) {
       return;
     }
 
@@ -1134,7 +1409,7 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(index);
+      agent = GetAgentCrowd(handle)->getEditableAgent(handle.index);
     }
 
     // mark
@@ -1142,13 +1417,26 @@ namespace nav {
   }
 
   bool Navigation::HasVehicleNear(ActorId id, float distance, carla::geom::Location direction) {
-    // get the internal index (walker or vehicle)
+    // get the internal handle (walker, or any shard copy of a vehicle)
+    AgentHandle handle;
     auto it = _mapped_walkers_id.find(id);
-    if (it == _mapped_walkers_id.end()) {
-      it = _mapped_vehicles_id.find(id);
-      if (it == _mapped_vehicles_id.end()) {
+    if (it != _mapped_walkers_id.end()) {
+      handle = it->second;
+    } else {
+      auto it_veh = _mapped_vehicles_id.find(id);
+      if (it_veh == _mapped_vehicles_id.end()) {
         return false;
       }
+      for (size_t shard = 0; shard < it_veh->second.size(); ++shard) {
+        if (it_veh->second[shard] != -1) {
+          handle.crowd = static_cast<int>(shard);
+          handle.index = it_veh->second[shard];
+          break;
+        }
+      }
+    }
+    if (handle.index == -1) {
+      return false;
     }
 
     float dir[3] = { direction.x, direction.z, direction.y };
@@ -1156,44 +1444,54 @@ namespace nav {
     {
       // critical section, force single thread running this
       std::lock_guard<std::mutex> lock(_mutex);
-      result = _crowd->hasVehicleNear(it->second, distance * distance, dir, false);
+      result = GetAgentCrowd(handle)->hasVehicleNear(handle.index, distance * distance, dir, false);
     }
     return result;
   }
 
   /// make agent look at some location
   bool Navigation::SetWalkerLookAt(ActorId id, carla::geom::Location location) {
-    // get the internal index (walker or vehicle)
+    // get the internal handles (one for a walker, one per shard for a vehicle)
+    std::vector<AgentHandle> handles;
     auto it = _mapped_walkers_id.find(id);
-    if (it == _mapped_walkers_id.end()) {
-      it = _mapped_vehicles_id.find(id);
-      if (it == _mapped_vehicles_id.end()) {
+    if (it != _mapped_walkers_id.end()) {
+      handles.push_back(it->second);
+    } else {
+      auto it_veh = _mapped_vehicles_id.find(id);
+      if (it_veh == _mapped_vehicles_id.end()) {
         return false;
       }
+      for (size_t shard = 0; shard < it_veh->second.size(); ++shard) {
+        if (it_veh->second[shard] != -1) {
+          handles.push_back(AgentHandle{static_cast<int>(shard), it_veh->second[shard]});
+        }
+      }
     }
 
-    dtCrowdAgent *agent;
-    {
-      // critical section, force single thread running this
-      std::lock_guard<std::mutex> lock(_mutex);
-      agent = _crowd->getEditableAgent(it->second);
-    }
-
-    // get the position
-    float x = (location.x - agent->npos[0]) * 0.0001f;
-    float y = (location.y - agent->npos[2]) * 0.0001f;
-    float z = (location.z - agent->npos[1]) * 0.0001f;
-
-    // set its velocity
-    agent->vel[0] = x;
-    agent->vel[2] = y;
-    agent->vel[1] = z;
-    agent->nvel[0] = x;
-    agent->nvel[2] = y;
-    agent->nvel[1] = z;
-    agent->dvel[0] = x;
-    agent->dvel[2] = y;
-    agent->dvel[1] = z;
+    for (const AgentHandle handle : handles) {
+      dtCrowdAgent *agent;
+      {
+        // critical section, force single thread running this
+        std::lock_guard<std::mutex> lock(_mutex);
+        agent = GetAgentCrowd(handle)->getEditableAgent(handle.index);
+      }
+
+      // get the position
+      float x = (location.x - agent->npos[0]) * 0.0001f;
+      float y = (location.y - agent->npos[2]) * 0.0001f;
+      float z = (location.z - agent->npos[1]) * 0.0001f;
+
+      // set its velocity
+      agent->vel[0] = x;
+      agent->vel[2] = y;
+      agent->vel[1] = z;
+      agent->nvel[0] = x;
+      agent->nvel[2] = y;
+      agent->nvel[1] = z;
+      agent->dvel[0] = x;
+      agent->dvel[2] = y;
+      agent->dvel[1] = z;
+    }
 
     return true;
   }
@@ -54,14 +54,26 @@ namespace nav {
   ///
   /// This class gets the binary content of the map from the server, which is required for the path finding.
   /// Then this class can add or remove pedestrians, and also set target points to walk for each one.
+  ///
+  /// The crowd is sharded by map region into several dtCrowd objects that
+  /// are stepped in parallel; walkers are handed over to the neighbour
+  /// shard when they cross a region boundary, and vehicles are mirrored
+  /// into every shard so all walkers keep avoiding them.
   class Navigation : private NonCopyable {
 
   public:
 
+    /// points to one agent of one crowd shard
+    struct AgentHandle {
+      int crowd { -1 };
+      int index { -1 };
+    };
+
     Navigation();
     ~Navigation();
 
-    /// load navigation data
+    /// load navigation data from a file, mapping it into memory when the
+    /// platform allows it
     bool Load(const std::string &filename);
     /// load navigation data from memory
     bool Load(std::vector<uint8_t> content);
@@ -87,11 +99,14 @@ namespace nav {
     bool SetWalkerTarget(ActorId id, carla::geom::Location to);
     // set a new target point to go directly without events
     bool SetWalkerDirectTarget(ActorId id, carla::geom::Location to);
-    bool SetWalkerDirectTargetIndex(int index, carla::geom::Location to);
+    bool SetWalkerDirectTargetIndex(AgentHandle handle, carla::geom::Location to);
     /// get the walker current transform
     bool GetWalkerTransform(ActorId id, carla::geom::Transform &trans);
     /// get the walker current location
     bool GetWalkerPosition(ActorId id, carla::geom::Location &location);
+    /// get the current location of several walkers at once, taking the
+    /// crowd lock once for the whole batch instead of once per walker
+    void GetWalkersPosition(const std::vector<ActorId> &ids, std::vector<carla::geom::Location> &locations);
     /// get the walker current transform
     float GetWalkerSpeed(ActorId id);
     /// update all walkers in crowd
@@ -100,6 +115,8 @@ namespace nav {
     bool GetRandomLocation(carla::geom::Location &location, dtQueryFilter * filter = nullptr) const;
     /// set the probability that an agent could cross the roads in its path following
     void SetPedestriansCrossFactor(float percentage);
+    /// set the seed of the per-walker random streams
+    void SetSeed(unsigned int seed);
     /// set an agent as paused for the crowd
     void PauseAgent(ActorId id, bool pause);
     /// return if the agent has a vehicle near (as neighbour)
@@ -107,30 +124,47 @@ namespace nav {
     /// make agent look at some location
     bool SetWalkerLookAt(ActorId id, carla::geom::Location location);
 
-    dtCrowd *GetCrowd() { return _crowd; };
+    /// return the number of crowd shards
+    int GetCrowdShardCount() const { return static_cast<int>(_crowds.size()); };
+
+    dtCrowd *GetCrowd(int shard = 0) {
+      return shard < static_cast<int>(_crowds.size()) ? _crowds[static_cast<size_t>(shard)] : nullptr;
+    };
 
     /// return the last delta seconds
     double GetDeltaSeconds() { return _delta_seconds; };
 
   private:
 
+    /// build the mesh with tiles referencing @a content in place, so the
+    /// buffer must stay alive as long as the mesh
+    bool LoadMesh(uint8_t *content, size_t size);
+    /// release the buffer or file mapping backing the current tiles
+    void ReleaseMeshBacking();
+
     bool _ready { false };
     std::vector<uint8_t> _binary_mesh;
+    /// file mapping backing the tiles when loaded from disk
+    uint8_t *_mapped_mesh { nullptr };
+    size_t _mapped_size { 0u };
     double _delta_seconds { 0.0 };
     /// meshes
     dtNavMesh *_nav_mesh { nullptr };
     dtNavMeshQuery *_nav_query { nullptr };
-    /// crowd
-    dtCrowd *_crowd { nullptr };
+    /// crowd shards, one per map region
+    std::vector<dtCrowd *> _crowds;
     /// mapping Id
-    std::unordered_map<ActorId, int> _mapped_walkers_id;
-    std::unordered_map<ActorId, int> _mapped_vehicles_id;
-    // mapping by index also
-    std::unordered_map<int, ActorId> _mapped_by_index;
+    std::unordered_map<ActorId, AgentHandle> _mapped_walkers_id;
+    /// vehicles keep one agent per shard, indexed by shard
+    std::unordered_map<ActorId, std::vector<int>> _mapped_vehicles_id;
+    // mapping by index also, one map per shard
+    std::vector<std::unordered_map<int, ActorId>> _mapped_by_index;
     /// store walkers yaw angle from previous tick
     std::unordered_map<ActorId, float> _yaw_walkers;
-    /// saves the position of each actor at intervals and check if any is blocked
-    std::unordered_map<int, carla::geom::Vector3D> _walkers_blocked_position;
+    /// saves the position of each actor at intervals and check if any is blocked, one map per shard
+    std::vector<std::unordered_map<int, carla::geom::Vector3D>> _walkers_blocked_position;
+    /// draws already taken from each walker's random stream, one map per shard
+    std::vector<std::unordered_map<int, uint32_t>> _walker_draw_count;
     double _time_to_unblock { 0.0 };
 
     /// walker manager for the route planning with events
@@ -140,8 +174,18 @@ namespace nav {
 
     float _probability_crossing { 0.0f };
 
+    unsigned int _seed { 0u };
+
     /// assign a filter index to an agent
-    void SetAgentFilter(int agent_index, int filter_index);
+    void SetAgentFilter(AgentHandle handle, int filter_index);
+
+    /// return the crowd shard an agent handle belongs to
+    dtCrowd *GetAgentCrowd(AgentHandle handle) {
+      return _crowds[static_cast<size_t>(handle.crowd)];
+    }
+
+    /// move a walker to another shard keeping its parameters and target
+    void HandOverWalker(AgentHandle handle, int target_crowd);
   };
 
 } // namespace nav
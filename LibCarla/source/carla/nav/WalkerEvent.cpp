@@ -34,7 +34,7 @@ namespace nav {
             carla::geom::Location currentUnrealPos;
             carla::geom::Location crosswalkEnd;
             carla::geom::Location direction;
-            _manager->GetNavigation()->GetWalkerPosition(_id, currentUnrealPos);
+            _manager->GetWalkerCachedPosition(_id, currentUnrealPos);
             _manager->GetWalkerCrosswalkEnd(_id, crosswalkEnd);
             direction.x = crosswalkEnd.x - currentUnrealPos.x;
             direction.y = crosswalkEnd.y - currentUnrealPos.y;
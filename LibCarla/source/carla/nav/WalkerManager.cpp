@@ -7,9 +7,14 @@
 #include "carla/nav/WalkerManager.h"
 #include "carla/nav/Navigation.h"
 
+#include <chrono>
+
 namespace carla {
 namespace nav {
 
+    /// time each Update may spend solving queued route requests
+    static const std::chrono::microseconds ROUTE_SOLVE_BUDGET(2000);
+
     WalkerManager::WalkerManager() {
         _nav = nullptr;
     }
@@ -36,12 +41,47 @@ namespace nav {
             return false;
         _walkers.erase(it);
 
+        // drop any route request still pending
+        for (auto itr = _route_requests.begin(); itr != _route_requests.end(); ++itr) {
+            if (itr->id == id) {
+                _route_requests.erase(itr);
+                break;
+            }
+        }
+
         return true;
     }
 
 	// update all routes
     bool WalkerManager::Update(double delta) {
 
+        // solve queued route requests within the time budget, so mass
+        // retargets get spread over several ticks instead of stalling one
+        const auto start = std::chrono::steady_clock::now();
+        while (!_route_requests.empty()) {
+            WalkerRouteRequest request = _route_requests.front();
+            _route_requests.pop_front();
+            ComputeWalkerRoute(request.id, request.to);
+            if (std::chrono::steady_clock::now() - start >= ROUTE_SOLVE_BUDGET) {
+                break;
+            }
+        }
+
+        // refresh the position of every walker in one batch, so the state
+        // checks and events below don't take the crowd lock once per walker
+        if (_nav != nullptr && !_walkers.empty()) {
+            std::vector<ActorId> ids;
+            ids.reserve(_walkers.size());
+            for (auto &it : _walkers) {
+                ids.push_back(it.first);
+            }
+            std::vector<carla::geom::Location> positions;
+            _nav->GetWalkersPosition(ids, positions);
+            for (unsigned int i = 0; i < ids.size(); ++i) {
+                _walkers[ids[i]].position = positions[i];
+            }
+        }
+
         // check all walkers
         for (auto &it : _walkers) {
 
@@ -57,9 +97,8 @@ namespace nav {
                     {
                         // get the target point
                         carla::geom::Location &target = info.route[info.currentIndex].location;
-                        // get current position
-                        carla::geom::Location current;
-                        _nav->GetWalkerPosition(it.first, current);
+                        // get current position (from the batch above)
+                        carla::geom::Location current = info.position;
                         // check distance to the target point
                         carla::geom::Vector3D dist(target.x - current.x, target.z - current.z, target.y - current.y);
                         if (dist.SquaredLength() <= 4) {
@@ -107,7 +146,7 @@ namespace nav {
         return SetWalkerRoute(id, location);
     }
 
-	// set a new route from its current position
+	// queue a new route from its current position
     bool WalkerManager::SetWalkerRoute(ActorId id, carla::geom::Location to) {
         // check
         if (_nav == nullptr)
@@ -118,6 +157,33 @@ namespace nav {
         if (it == _walkers.end())
             return false;
 
+        // stop the walker until its route is solved
+        it->second.state = WALKER_IDLE;
+
+        // replace any request still pending for this walker, last target wins
+        for (auto &request : _route_requests) {
+            if (request.id == id) {
+                request.to = to;
+                return true;
+            }
+        }
+
+        // queue it to be solved within the Update budget
+        _route_requests.emplace_back(id, to);
+        return true;
+    }
+
+	// solve one queued route, assigning it to the walker
+    bool WalkerManager::ComputeWalkerRoute(ActorId id, carla::geom::Location to) {
+        // check
+        if (_nav == nullptr)
+            return false;
+
+        // search
+        auto it = _walkers.find(id);
+        if (it == _walkers.end())
+            return false;
+
         // get it
         WalkerInfo &info = it->second;
         std::vector<carla::geom::Location> path;
@@ -247,6 +313,17 @@ namespace nav {
         return false;
     }
 
+    // get the walker position cached by the last Update
+    bool WalkerManager::GetWalkerCachedPosition(ActorId id, carla::geom::Location &location) {
+        // search
+        auto it = _walkers.find(id);
+        if (it == _walkers.end())
+            return false;
+
+        location = it->second.position;
+        return true;
+    }
+
     EventResult WalkerManager::ExecuteEvent(ActorId id, WalkerInfo &info, double delta) {
         // go to the event
         WalkerRoutePoint &rp = info.route[info.currentIndex];
@@ -12,6 +12,8 @@
 #include "carla/nav/WalkerEvent.h"
 #include "carla/rpc/ActorId.h"
 
+#include <deque>
+
 namespace carla {
 namespace nav {
 
@@ -34,11 +36,19 @@ namespace nav {
     struct WalkerInfo {
         carla::geom::Location from;
         carla::geom::Location to;
+        /// position refreshed in batch at the start of each Update
+        carla::geom::Location position;
         unsigned int currentIndex { 0 };
         WalkerState state;
         std::vector<WalkerRoutePoint> route;
     };
 
+    struct WalkerRouteRequest {
+        ActorId id;
+        carla::geom::Location to;
+        WalkerRouteRequest(ActorId i, carla::geom::Location t) : id(i), to(t) {};
+    };
+
   class WalkerManager : private NonCopyable {
 
   public:
@@ -58,7 +68,9 @@ namespace nav {
     /// update all routes
     bool Update(double delta);
 
-    /// set a new route from its current position
+    /// queue a new route from its current position; the path finding is
+    /// solved in Update within a time budget per tick, so retargeting a
+    /// whole crowd does not stall the tick that requested it
     bool SetWalkerRoute(ActorId id);
     bool SetWalkerRoute(ActorId id, carla::geom::Location to);
 
@@ -70,6 +82,10 @@ namespace nav {
 
     /// get the point in the route that end current crosswalk
     bool GetWalkerCrosswalkEnd(ActorId id, carla::geom::Location &location);
+
+    /// get the walker position cached by the last Update, avoiding one
+    /// crowd query per event check
+    bool GetWalkerCachedPosition(ActorId id, carla::geom::Location &location);
     
     /// return the navigation object
     Navigation *GetNavigation() { return _nav; };
@@ -78,7 +94,11 @@ namespace nav {
 
     EventResult ExecuteEvent(ActorId id, WalkerInfo &info, double delta);
 
+    /// solve one queued route, assigning it to the walker
+    bool ComputeWalkerRoute(ActorId id, carla::geom::Location to);
+
     std::unordered_map<ActorId, WalkerInfo> _walkers;
+    std::deque<WalkerRouteRequest> _route_requests;
     Navigation *_nav { nullptr };
   };
 
@@ -24,27 +24,43 @@
 namespace carla {
 namespace opendrive {
 
-  boost::optional<road::Map> OpenDriveParser::Load(const std::string &opendrive) {
-    pugi::xml_document xml;
-    pugi::xml_parse_result parse_result = xml.load_string(opendrive.c_str());
+  boost::optional<road::Map> OpenDriveParser::Load(
+      const std::string &opendrive,
+      road::MapSnapshotWriter *snapshot_writer) {
+    carla::road::MapBuilder map_builder;
+    map_builder.SetSnapshotWriter(snapshot_writer);
 
-    if (parse_result == false) {
-      log_error("unable to parse the OpenDRIVE XML string");
-      return {};
-    }
+    // The DOM lives in this scope so its memory is returned before Build()
+    // materializes the derived map state; on big maps the two together are
+    // the peak of the whole load.
+    {
+      // Parsing the copy in place makes element and attribute strings alias
+      // the buffer instead of being duplicated node by node.
+      std::string buffer = opendrive;
+      pugi::xml_document xml;
+      pugi::xml_parse_result parse_result =
+          xml.load_buffer_inplace(&buffer[0], buffer.size());
 
-    carla::road::MapBuilder map_builder;
+      if (parse_result == false) {
+        log_error("unable to parse the OpenDRIVE XML string");
+        return {};
+      }
+
+      parser::GeoReferenceParser::Parse(xml, map_builder);
+      parser::RoadParser::Parse(xml, map_builder);
+      parser::JunctionParser::Parse(xml, map_builder);
+      parser::GeometryParser::Parse(xml, map_builder);
+      parser::LaneParser::Parse(xml, map_builder);
+      parser::ProfilesParser::Parse(xml, map_builder);
+      parser::TrafficGroupParser::Parse(xml, map_builder);
+      parser::SignalParser::Parse(xml, map_builder);
+      parser::ObjectParser::Parse(xml, map_builder);
+      parser::ControllerParser::Parse(xml, map_builder);
+    }
 
-    parser::GeoReferenceParser::Parse(xml, map_builder);
-    parser::RoadParser::Parse(xml, map_builder);
-    parser::JunctionParser::Parse(xml, map_builder);
-    parser::GeometryParser::Parse(xml, map_builder);
-    parser::LaneParser::Parse(xml, map_builder);
-    parser::ProfilesParser::Parse(xml, map_builder);
-    parser::TrafficGroupParser::Parse(xml, map_builder);
-    parser::SignalParser::Parse(xml, map_builder);
-    parser::ObjectParser::Parse(xml, map_builder);
-    parser::ControllerParser::Parse(xml, map_builder);
+    // Build() regenerates its derived state on every replay, there is no
+    // point recording it.
+    map_builder.SetSnapshotWriter(nullptr);
 
     return map_builder.Build();
   }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/MapSnapshot.h"
 
 #include <boost/optional.hpp>
 
@@ -18,7 +19,12 @@ namespace opendrive {
   class OpenDriveParser {
   public:
 
-    static boost::optional<road::Map> Load(const std::string &opendrive);
+    /// When @a snapshot_writer is provided, the builder calls of the parse are
+    /// recorded into it so the resulting map can be cached as a binary
+    /// snapshot.
+    static boost::optional<road::Map> Load(
+        const std::string &opendrive,
+        road::MapSnapshotWriter *snapshot_writer = nullptr);
   };
 
 } // namespace opendrive
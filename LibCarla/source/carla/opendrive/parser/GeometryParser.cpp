@@ -6,10 +6,13 @@
 
 #include "carla/opendrive/parser/GeometryParser.h"
 
+#include "carla/TaskScheduler.h"
 #include "carla/road/MapBuilder.h"
 
 #include <pugixml/pugixml.hpp>
 
+#include <future>
+
 namespace carla {
 namespace opendrive {
 namespace parser {
@@ -58,60 +61,103 @@ namespace parser {
     GeometryParamPoly3 param_poly3;
   };
 
+  static std::vector<Geometry> ParseRoadGeometries(const pugi::xml_node &node_road) {
+    std::vector<Geometry> geometry;
+
+    // parse plan view
+    pugi::xml_node node_plan_view = node_road.child("planView");
+    if (node_plan_view) {
+      // all geometry
+      for (pugi::xml_node node_geo : node_plan_view.children("geometry")) {
+        Geometry geo;
+
+        // get road id
+        geo.road_id = node_road.attribute("id").as_uint();
+
+        // get common properties
+        geo.s = node_geo.attribute("s").as_double();
+        geo.x = node_geo.attribute("x").as_double();
+        geo.y = node_geo.attribute("y").as_double();
+        geo.hdg = node_geo.attribute("hdg").as_double();
+        geo.length = node_geo.attribute("length").as_double();
+
+        // check geometry type
+        pugi::xml_node node = node_geo.first_child();
+        geo.type = node.name();
+        if (geo.type == "arc") {
+          geo.arc.curvature = node.attribute("curvature").as_double();
+        } else if (geo.type == "spiral") {
+          geo.spiral.curvStart = node.attribute("curvStart").as_double();
+          geo.spiral.curvEnd = node.attribute("curvEnd").as_double();
+        } else if (geo.type == "poly3") {
+          geo.poly3.a = node.attribute("a").as_double();
+          geo.poly3.b = node.attribute("b").as_double();
+          geo.poly3.c = node.attribute("c").as_double();
+          geo.poly3.d = node.attribute("d").as_double();
+        } else if (geo.type == "paramPoly3") {
+          geo.param_poly3.aU = node.attribute("aU").as_double();
+          geo.param_poly3.bU = node.attribute("bU").as_double();
+          geo.param_poly3.cU = node.attribute("cU").as_double();
+          geo.param_poly3.dU = node.attribute("dU").as_double();
+          geo.param_poly3.aV = node.attribute("aV").as_double();
+          geo.param_poly3.bV = node.attribute("bV").as_double();
+          geo.param_poly3.cV = node.attribute("cV").as_double();
+          geo.param_poly3.dV = node.attribute("dV").as_double();
+          geo.param_poly3.p_range = node.attribute("pRange").value();
+        }
+
+        // add it
+        geometry.emplace_back(geo);
+      }
+    }
+    return geometry;
+  }
+
   void GeometryParser::Parse(
       const pugi::xml_document &xml,
       carla::road::MapBuilder &map_builder) {
 
-    std::vector<Geometry> geometry;
-
+    std::vector<pugi::xml_node> road_nodes;
     for (pugi::xml_node node_road : xml.child("OpenDRIVE").children("road")) {
+      road_nodes.push_back(node_road);
+    }
 
-      // parse plan view
-      pugi::xml_node node_plan_view = node_road.child("planView");
-      if (node_plan_view) {
-        // all geometry
-        for (pugi::xml_node node_geo : node_plan_view.children("geometry")) {
-          Geometry geo;
-
-          // get road id
-          geo.road_id = node_road.attribute("id").as_uint();
-
-          // get common properties
-          geo.s = node_geo.attribute("s").as_double();
-          geo.x = node_geo.attribute("x").as_double();
-          geo.y = node_geo.attribute("y").as_double();
-          geo.hdg = node_geo.attribute("hdg").as_double();
-          geo.length = node_geo.attribute("length").as_double();
-
-          // check geometry type
-          pugi::xml_node node = node_geo.first_child();
-          geo.type = node.name();
-          if (geo.type == "arc") {
-            geo.arc.curvature = node.attribute("curvature").as_double();
-          } else if (geo.type == "spiral") {
-            geo.spiral.curvStart = node.attribute("curvStart").as_double();
-            geo.spiral.curvEnd = node.attribute("curvEnd").as_double();
-          } else if (geo.type == "poly3") {
-            geo.poly3.a = node.attribute("a").as_double();
-            geo.poly3.b = node.attribute("b").as_double();
-            geo.poly3.c = node.attribute("c").as_double();
-            geo.poly3.d = node.attribute("d").as_double();
-          } else if (geo.type == "paramPoly3") {
-            geo.param_poly3.aU = node.attribute("aU").as_double();
-            geo.param_poly3.bU = node.attribute("bU").as_double();
-            geo.param_poly3.cU = node.attribute("cU").as_double();
-            geo.param_poly3.dU = node.attribute("dU").as_double();
-            geo.param_poly3.aV = node.attribute("aV").as_double();
-            geo.param_poly3.bV = node.attribute("bV").as_double();
-            geo.param_poly3.cV = node.attribute("cV").as_double();
-            geo.param_poly3.dV = node.attribute("dV").as_double();
-            geo.param_poly3.p_range = node.attribute("pRange").value();
+    // Staging only reads the document and each <road> is independent, so big
+    // maps shard the nodes over a local pool; the builder phase below stays
+    // sequential in document order.
+    constexpr size_t serial_threshold = 64u;
+    std::vector<std::vector<Geometry>> staged(road_nodes.size());
+    if (road_nodes.size() <= serial_threshold) {
+      for (size_t i = 0u; i < road_nodes.size(); ++i) {
+        staged[i] = ParseRoadGeometries(road_nodes[i]);
+      }
+    } else {
+      const size_t num_workers = std::max<size_t>(1u, std::thread::hardware_concurrency());
+      const size_t chunk_size =
+          std::max<size_t>(1u, road_nodes.size() / (num_workers * 4u));
+      TaskScheduler scheduler(num_workers);
+      scheduler.AsyncRun();
+      std::vector<std::future<void>> chunks;
+      chunks.reserve(road_nodes.size() / chunk_size + 1u);
+      for (size_t begin = 0u; begin < road_nodes.size(); begin += chunk_size) {
+        const size_t end = std::min(begin + chunk_size, road_nodes.size());
+        chunks.emplace_back(scheduler.Post([&road_nodes, &staged, begin, end]() {
+          for (size_t i = begin; i < end; ++i) {
+            staged[i] = ParseRoadGeometries(road_nodes[i]);
           }
-
-          // add it
-          geometry.emplace_back(geo);
-        }
+        }));
       }
+      for (auto &chunk : chunks) {
+        chunk.get();
+      }
+    }
+
+    std::vector<Geometry> geometry;
+    for (auto &road_geometries : staged) {
+      geometry.insert(
+          geometry.end(),
+          std::make_move_iterator(road_geometries.begin()),
+          std::make_move_iterator(road_geometries.end()));
     }
 
     // map_builder calls
@@ -6,11 +6,16 @@
 
 #pragma once
 
+#include "carla/AsyncFileIO.h"
+#include "carla/Debug.h"
 #include "carla/FileSystem.h"
 
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <iomanip>
+#include <type_traits>
+#include <vector>
 
 namespace carla {
 namespace pointcloud {
@@ -27,6 +32,16 @@ namespace pointcloud {
       }
     }
 
+    /// Same as Dump but in binary-little-endian PLY; the detection structs
+    /// are laid out exactly as their declared properties, so the points go
+    /// out as bulk buffer writes instead of ostream formatting, an order of
+    /// magnitude faster for lidar-sized clouds.
+    template <typename PointIt>
+    static void DumpBinary(std::ostream &out, PointIt begin, PointIt end) {
+      WriteHeader(out, begin, end, "binary_little_endian");
+      WriteBinaryPoints(out, begin, end);
+    }
+
     template <typename PointIt>
     static std::string SaveToDisk(std::string path, PointIt begin, PointIt end) {
       FileSystem::ValidateFilePath(path, ".ply");
@@ -35,16 +50,144 @@ namespace pointcloud {
       return path;
     }
 
+    /// @copydoc DumpBinary
+    template <typename PointIt>
+    static std::string SaveToDiskBinary(std::string path, PointIt begin, PointIt end) {
+      FileSystem::ValidateFilePath(path, ".ply");
+      std::ofstream out(path, std::ios_base::binary);
+      DumpBinary(out, begin, end);
+      return path;
+    }
+
+    /// Copy the points and save them from an AsyncFileIO writer thread, so a
+    /// slow disk stalls the writer instead of the calling sensor thread. The
+    /// future delivers the final path, or rethrows the writer's exception.
+    template <typename PointIt>
+    static std::future<std::string> SaveToDiskAsync(std::string path, PointIt begin, PointIt end) {
+      using point_type = typename std::iterator_traits<PointIt>::value_type;
+      std::vector<point_type> points(begin, end);
+      return AsyncFileIO::GetInstance().Post(
+          [path = std::move(path), points = std::move(points)]() mutable {
+            return SaveToDisk(std::move(path), points.begin(), points.end());
+          });
+    }
+
+    /// @copydoc SaveToDiskAsync
+    template <typename PointIt>
+    static std::future<std::string> SaveToDiskBinaryAsync(std::string path, PointIt begin, PointIt end) {
+      using point_type = typename std::iterator_traits<PointIt>::value_type;
+      std::vector<point_type> points(begin, end);
+      return AsyncFileIO::GetInstance().Post(
+          [path = std::move(path), points = std::move(points)]() mutable {
+            return SaveToDiskBinary(std::move(path), points.begin(), points.end());
+          });
+    }
+
   private:
-    template <typename PointIt> static void WriteHeader(std::ostream &out, PointIt begin, PointIt end) {
+
+    friend class PlyStreamWriter;
+
+    template <typename PointIt>
+    static void WriteHeader(std::ostream &out, PointIt begin, PointIt end, const char *format = "ascii") {
       DEBUG_ASSERT(std::distance(begin, end) >= 0);
       out << "ply\n"
-           "format ascii 1.0\n"
+           "format " << format << " 1.0\n"
            "element vertex " << std::to_string(static_cast<size_t>(std::distance(begin, end))) << "\n";
       begin->WritePlyHeaderInfo(out);
       out << "\nend_header\n";
       out << std::fixed << std::setprecision(4u);
     }
+
+    template <typename PointIt>
+    static void WriteBinaryPoints(std::ostream &out, PointIt begin, PointIt end) {
+      using point_type = typename std::iterator_traits<PointIt>::value_type;
+      static_assert(
+          std::is_trivially_copyable<point_type>::value,
+          "points are written as raw bytes, the detection type must be trivially copyable");
+      // write in chunks, the points usually come from a strided or
+      // non-contiguous range.
+      constexpr size_t chunk_size = 8192u;
+      std::vector<point_type> chunk;
+      chunk.reserve(chunk_size);
+      for (; begin != end; ++begin) {
+        chunk.emplace_back(*begin);
+        if (chunk.size() == chunk_size) {
+          out.write(reinterpret_cast<const char *>(chunk.data()), chunk.size() * sizeof(point_type));
+          chunk.clear();
+        }
+      }
+      if (!chunk.empty()) {
+        out.write(reinterpret_cast<const char *>(chunk.data()), chunk.size() * sizeof(point_type));
+      }
+    }
+  };
+
+  /// Streams any number of point batches (e.g. consecutive lidar sweeps)
+  /// into a single binary PLY file. The header goes out with the first
+  /// batch carrying a fixed-width placeholder vertex count, patched in
+  /// place when the writer closes, so batches append without rewriting the
+  /// file.
+  class PlyStreamWriter {
+
+  public:
+
+    explicit PlyStreamWriter(std::string path) {
+      FileSystem::ValidateFilePath(path, ".ply");
+      _path = std::move(path);
+      _out.open(_path, std::ios_base::binary);
+    }
+
+    ~PlyStreamWriter() {
+      Close();
+    }
+
+    template <typename PointIt>
+    void Append(PointIt begin, PointIt end) {
+      DEBUG_ASSERT(std::distance(begin, end) >= 0);
+      if (begin == end) {
+        return;
+      }
+      if (_count_position == 0u) {
+        WriteHeader(begin);
+      }
+      _total_points += static_cast<size_t>(std::distance(begin, end));
+      PointCloudIO::WriteBinaryPoints(_out, begin, end);
+    }
+
+    /// Patch the vertex count and close the file; returns the final path.
+    /// Called by the destructor if not called explicitly.
+    std::string Close() {
+      if (_out.is_open()) {
+        _out.seekp(_count_position);
+        _out << std::setw(count_digits) << std::setfill('0') << _total_points;
+        _out.close();
+      }
+      return _path;
+    }
+
+  private:
+
+    // width of the zero-padded vertex count placeholder.
+    static constexpr int count_digits = 15;
+
+    template <typename PointIt>
+    void WriteHeader(PointIt begin) {
+      _out << "ply\n"
+           "format binary_little_endian 1.0\n"
+           "element vertex ";
+      _count_position = _out.tellp();
+      _out << std::setw(count_digits) << std::setfill('0') << 0u << "\n";
+      begin->WritePlyHeaderInfo(_out);
+      _out << "\nend_header\n";
+    }
+
+    std::string _path;
+
+    std::ofstream _out;
+
+    std::streampos _count_position = 0u;
+
+    size_t _total_points = 0u;
   };
 
 } // namespace pointcloud
@@ -0,0 +1,195 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace carla {
+namespace profiler {
+
+namespace {
+
+  constexpr size_t tag_count = static_cast<size_t>(AllocationTag::SIZE);
+
+  const char *tag_names[tag_count] = {
+      "untagged",
+      "buffer",
+      "streaming",
+      "rpc",
+      "sensor",
+      "traffic_manager"};
+
+  // constant-initialized so the operator new hook can record before any
+  // static constructor has run.
+  struct TagCounters {
+    std::atomic<uint64_t> live_bytes{0u};
+    std::atomic<uint64_t> live_allocations{0u};
+    std::atomic<uint64_t> total_bytes{0u};
+    std::atomic<uint64_t> total_allocations{0u};
+  };
+
+  TagCounters counters[tag_count];
+
+  thread_local AllocationTag current_tag = AllocationTag::Untagged;
+
+} // namespace
+
+  AllocationTag &AllocationTracker::CurrentTag() {
+    return current_tag;
+  }
+
+#ifdef LIBCARLA_ENABLE_ALLOCATION_TRACKER
+
+  void AllocationTracker::RecordAllocation(AllocationTag tag, uint64_t bytes) {
+    auto &tag_counters = counters[static_cast<size_t>(tag)];
+    tag_counters.live_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    tag_counters.live_allocations.fetch_add(1u, std::memory_order_relaxed);
+    tag_counters.total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    tag_counters.total_allocations.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  void AllocationTracker::RecordDeallocation(AllocationTag tag, uint64_t bytes) {
+    auto &tag_counters = counters[static_cast<size_t>(tag)];
+    tag_counters.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    tag_counters.live_allocations.fetch_sub(1u, std::memory_order_relaxed);
+  }
+
+#endif // LIBCARLA_ENABLE_ALLOCATION_TRACKER
+
+  std::vector<AllocationTracker::Snapshot> AllocationTracker::Sample() {
+    std::vector<Snapshot> result;
+    result.reserve(tag_count);
+    for (size_t i = 0u; i < tag_count; ++i) {
+      Snapshot snapshot;
+      snapshot.tag = tag_names[i];
+      snapshot.live_bytes = counters[i].live_bytes.load(std::memory_order_relaxed);
+      snapshot.live_allocations = counters[i].live_allocations.load(std::memory_order_relaxed);
+      snapshot.total_bytes = counters[i].total_bytes.load(std::memory_order_relaxed);
+      snapshot.total_allocations = counters[i].total_allocations.load(std::memory_order_relaxed);
+      result.push_back(std::move(snapshot));
+    }
+    return result;
+  }
+
+  std::string AllocationTracker::Report() {
+    std::ostringstream out;
+    out << "tag,live_bytes,live_allocations,total_bytes,total_allocations\n";
+    for (const auto &snapshot : Sample()) {
+      out << snapshot.tag
+          << ',' << snapshot.live_bytes
+          << ',' << snapshot.live_allocations
+          << ',' << snapshot.total_bytes
+          << ',' << snapshot.total_allocations
+          << '\n';
+    }
+    return out.str();
+  }
+
+} // namespace profiler
+} // namespace carla
+
+#ifdef LIBCARLA_ENABLE_ALLOCATION_TRACKER
+
+// =============================================================================
+// -- Global operator new/delete hook ------------------------------------------
+// =============================================================================
+
+namespace {
+
+  // every allocation is prefixed with its size and tag, so the matching
+  // deallocation can be charged to the tag that allocated, no matter which
+  // thread frees. Sixteen bytes keep the payload aligned for any
+  // fundamental type.
+  struct AllocationHeader {
+    uint64_t size;
+    uint32_t tag;
+    uint32_t magic;
+  };
+
+  constexpr uint32_t allocation_magic = 0x4c43414cu; // "LCAL"
+
+  void *TrackedAllocate(size_t size) noexcept {
+    auto *memory = std::malloc(size + sizeof(AllocationHeader));
+    if (memory == nullptr) {
+      return nullptr;
+    }
+    const auto tag = carla::profiler::AllocationTracker::CurrentTag();
+    auto *header = static_cast<AllocationHeader *>(memory);
+    header->size = size;
+    header->tag = static_cast<uint32_t>(tag);
+    header->magic = allocation_magic;
+    carla::profiler::AllocationTracker::RecordAllocation(tag, size);
+    return header + 1u;
+  }
+
+  void TrackedFree(void *ptr) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+    auto *header = static_cast<AllocationHeader *>(ptr) - 1u;
+    if (header->magic != allocation_magic) {
+      // not ours, e.g. allocated by a shared library with its own
+      // operator new.
+      std::free(ptr);
+      return;
+    }
+    carla::profiler::AllocationTracker::RecordDeallocation(
+        static_cast<carla::profiler::AllocationTag>(header->tag),
+        header->size);
+    std::free(header);
+  }
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  auto *result = TrackedAllocate(size);
+  if (result == nullptr) {
+    throw std::bad_alloc();
+  }
+  return result;
+}
+
+void *operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return TrackedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return TrackedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  TrackedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  TrackedFree(ptr);
+}
+
+#endif // LIBCARLA_ENABLE_ALLOCATION_TRACKER
@@ -0,0 +1,113 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+
+  /// Subsystems the allocation tracker can attribute memory to.
+  enum class AllocationTag : uint8_t {
+    Untagged = 0u,
+    Buffer,
+    Streaming,
+    Rpc,
+    Sensor,
+    TrafficManager,
+    SIZE
+  };
+
+  /// Per-subsystem accounting of heap memory, so a growing process can be
+  /// attributed to the subsystem responsible without a heap profiler.
+  ///
+  /// The accounting has two sources: carla::Buffer reports its blocks
+  /// directly (buffers bypass operator new), and, when the library is
+  /// compiled with LIBCARLA_ENABLE_ALLOCATION_TRACKER, a global operator
+  /// new/delete replacement charges every other allocation to the tag of
+  /// the calling thread, set by CARLA_ALLOCATION_SCOPE at the subsystem
+  /// entry points. Without the define the record calls compile to no-ops
+  /// and every counter stays at zero.
+  class AllocationTracker {
+  public:
+
+    /// Point-in-time aggregate of one tag. The totals only ever grow;
+    /// sample them twice to compute allocation rates.
+    struct Snapshot {
+      std::string tag;
+      uint64_t live_bytes = 0u;
+      uint64_t live_allocations = 0u;
+      uint64_t total_bytes = 0u;
+      uint64_t total_allocations = 0u;
+    };
+
+    /// Whether the operator new/delete hook is compiled in.
+    static constexpr bool IsEnabled() {
+#ifdef LIBCARLA_ENABLE_ALLOCATION_TRACKER
+      return true;
+#else
+      return false;
+#endif // LIBCARLA_ENABLE_ALLOCATION_TRACKER
+    }
+
+    /// Tag charged for the allocations of the calling thread.
+    static AllocationTag &CurrentTag();
+
+#ifdef LIBCARLA_ENABLE_ALLOCATION_TRACKER
+
+    static void RecordAllocation(AllocationTag tag, uint64_t bytes);
+
+    static void RecordDeallocation(AllocationTag tag, uint64_t bytes);
+
+#else
+
+    static void RecordAllocation(AllocationTag, uint64_t) {}
+
+    static void RecordDeallocation(AllocationTag, uint64_t) {}
+
+#endif // LIBCARLA_ENABLE_ALLOCATION_TRACKER
+
+    /// Snapshot of every tag, in tag order.
+    static std::vector<Snapshot> Sample();
+
+    /// All tags as CSV lines
+    /// `tag,live_bytes,live_allocations,total_bytes,total_allocations`,
+    /// header included.
+    static std::string Report();
+  };
+
+  /// Charges the allocations of the current thread to a tag for the
+  /// lifetime of the scope; see CARLA_ALLOCATION_SCOPE.
+  class ScopedAllocationContext {
+  public:
+
+    explicit ScopedAllocationContext(AllocationTag tag)
+      : _previous(AllocationTracker::CurrentTag()) {
+      AllocationTracker::CurrentTag() = tag;
+    }
+
+    ~ScopedAllocationContext() {
+      AllocationTracker::CurrentTag() = _previous;
+    }
+
+  private:
+
+    AllocationTag _previous;
+  };
+
+} // namespace profiler
+} // namespace carla
+
+#ifdef LIBCARLA_ENABLE_ALLOCATION_TRACKER
+#  define CARLA_ALLOCATION_SCOPE(tag) \
+      ::carla::profiler::ScopedAllocationContext carla_allocation_scope_##tag( \
+          ::carla::profiler::AllocationTag::tag);
+#else
+#  define CARLA_ALLOCATION_SCOPE(tag)
+#endif // LIBCARLA_ENABLE_ALLOCATION_TRACKER
@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/Metrics.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace carla {
+namespace profiler {
+
+namespace detail {
+
+  class MetricRegistry {
+  public:
+
+    static MetricRegistry &Get() {
+      static MetricRegistry instance;
+      return instance;
+    }
+
+    Metric &GetMetric(const std::string &name) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (auto &metric : _metrics) {
+        if (metric->GetName() == name) {
+          return *metric;
+        }
+      }
+      _metrics.emplace_back(new Metric(name));
+      return *_metrics.back();
+    }
+
+    std::vector<Metric::Snapshot> Sample() {
+      std::vector<Metric::Snapshot> snapshots;
+      std::lock_guard<std::mutex> lock(_mutex);
+      snapshots.reserve(_metrics.size());
+      for (const auto &metric : _metrics) {
+        snapshots.push_back(metric->TakeSnapshot());
+      }
+      std::sort(snapshots.begin(), snapshots.end(),
+          [](const Metric::Snapshot &lhs, const Metric::Snapshot &rhs) {
+            return lhs.name < rhs.name;
+          });
+      return snapshots;
+    }
+
+  private:
+
+    std::mutex _mutex;
+
+    // Metrics are never removed; call sites hold references into this.
+    std::vector<std::unique_ptr<Metric>> _metrics;
+  };
+
+} // namespace detail
+
+  Metric::Snapshot Metric::TakeSnapshot() const {
+    Snapshot snapshot;
+    snapshot.name = _name;
+    snapshot.count = _count.load(std::memory_order_relaxed);
+    snapshot.sum_us = _sum_us.load(std::memory_order_relaxed);
+    snapshot.max_us = _max_us.load(std::memory_order_relaxed);
+    const auto min_us = _min_us.load(std::memory_order_relaxed);
+    snapshot.min_us = (min_us == UINT64_MAX) ? 0u : min_us;
+    if (snapshot.count > 0u) {
+      uint64_t seen = 0u;
+      for (auto bucket = 0u; bucket < bucket_count; ++bucket) {
+        seen += _buckets[bucket].load(std::memory_order_relaxed);
+        if ((snapshot.p50_us == 0u) && (2u * seen > snapshot.count)) {
+          snapshot.p50_us = uint64_t(1u) << (bucket + 1u);
+        }
+        if ((snapshot.p99_us == 0u) && (100u * seen > 99u * snapshot.count)) {
+          snapshot.p99_us = uint64_t(1u) << (bucket + 1u);
+        }
+      }
+    }
+    return snapshot;
+  }
+
+  Metric &Metrics::Get(const std::string &name) {
+    return detail::MetricRegistry::Get().GetMetric(name);
+  }
+
+  std::vector<Metric::Snapshot> Metrics::Sample() {
+    return detail::MetricRegistry::Get().Sample();
+  }
+
+  std::string Metrics::Report() {
+    std::ostringstream out;
+    out << "name,count,sum_us,min_us,max_us,p50_us,p99_us\n";
+    for (const auto &snapshot : Sample()) {
+      out << snapshot.name
+          << ',' << snapshot.count
+          << ',' << snapshot.sum_us
+          << ',' << snapshot.min_us
+          << ',' << snapshot.max_us
+          << ',' << snapshot.p50_us
+          << ',' << snapshot.p99_us
+          << '\n';
+    }
+    return out.str();
+  }
+
+} // namespace profiler
+} // namespace carla
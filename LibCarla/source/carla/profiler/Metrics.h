@@ -0,0 +1,145 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/StopWatch.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+
+namespace detail {
+  class MetricRegistry;
+}
+
+  /// Timing histogram for one named metric. Annotate is lock-free (a few
+  /// relaxed atomic adds into power-of-two microsecond buckets), so it can
+  /// sit on hot paths; snapshots are computed on demand.
+  class Metric : private NonCopyable {
+  public:
+
+    /// Point-in-time aggregate of a metric; percentiles are upper bucket
+    /// bounds, i.e. accurate to a factor of two.
+    struct Snapshot {
+      std::string name;
+      uint64_t count = 0u;
+      uint64_t sum_us = 0u;
+      uint64_t min_us = 0u;
+      uint64_t max_us = 0u;
+      uint64_t p50_us = 0u;
+      uint64_t p99_us = 0u;
+    };
+
+    const std::string &GetName() const {
+      return _name;
+    }
+
+    void Annotate(uint64_t micros) {
+      _count.fetch_add(1u, std::memory_order_relaxed);
+      _sum_us.fetch_add(micros, std::memory_order_relaxed);
+      ++_buckets[BucketFor(micros)];
+      auto prev_min = _min_us.load(std::memory_order_relaxed);
+      while ((micros < prev_min) &&
+          !_min_us.compare_exchange_weak(prev_min, micros, std::memory_order_relaxed)) {}
+      auto prev_max = _max_us.load(std::memory_order_relaxed);
+      while ((micros > prev_max) &&
+          !_max_us.compare_exchange_weak(prev_max, micros, std::memory_order_relaxed)) {}
+    }
+
+    void Annotate(const StopWatch &stop_watch) {
+      Annotate(stop_watch.GetElapsedTime<std::chrono::microseconds>());
+    }
+
+    Snapshot TakeSnapshot() const;
+
+  private:
+
+    friend class detail::MetricRegistry;
+
+    explicit Metric(std::string name) : _name(std::move(name)) {
+      for (auto &bucket : _buckets) {
+        bucket.store(0u, std::memory_order_relaxed);
+      }
+    }
+
+    /// Bucket i holds samples in [2^i, 2^(i+1)) microseconds; 26 buckets
+    /// reach past one minute.
+    static constexpr size_t bucket_count = 26u;
+
+    static size_t BucketFor(uint64_t micros) {
+      size_t bucket = 0u;
+      while ((micros >>= 1u) && (bucket + 1u < bucket_count)) {
+        ++bucket;
+      }
+      return bucket;
+    }
+
+    const std::string _name;
+
+    std::atomic<uint64_t> _count{0u};
+
+    std::atomic<uint64_t> _sum_us{0u};
+
+    std::atomic<uint64_t> _min_us{UINT64_MAX};
+
+    std::atomic<uint64_t> _max_us{0u};
+
+    std::array<std::atomic<uint64_t>, bucket_count> _buckets;
+  };
+
+  /// Process-wide registry of named metrics. Call sites resolve their metric
+  /// once (the scope macro caches the reference in a function-local static)
+  /// and then record without locking; Sample and Report walk the registry
+  /// under a lock.
+  class Metrics {
+  public:
+
+    /// The metric registered under @a name, created on first use. The
+    /// reference stays valid for the lifetime of the process.
+    static Metric &Get(const std::string &name);
+
+    /// Snapshot of every registered metric, sorted by name.
+    static std::vector<Metric::Snapshot> Sample();
+
+    /// All metrics as CSV lines
+    /// `name,count,sum_us,min_us,max_us,p50_us,p99_us`, header included.
+    static std::string Report();
+  };
+
+  /// Annotates the lifetime of the current scope into a metric; see
+  /// CARLA_METRIC_SCOPE.
+  class ScopedMetricTimer {
+  public:
+
+    explicit ScopedMetricTimer(Metric &metric) : _metric(metric) {}
+
+    ~ScopedMetricTimer() {
+      _stop_watch.Stop();
+      _metric.Annotate(_stop_watch);
+    }
+
+  private:
+
+    Metric &_metric;
+
+    StopWatch _stop_watch;
+  };
+
+} // namespace profiler
+} // namespace carla
+
+#define CARLA_METRIC_SCOPE(context, metric_name) \
+    static ::carla::profiler::Metric &carla_metric_ ## context ## _ ## metric_name = \
+        ::carla::profiler::Metrics::Get(#context "." #metric_name); \
+    ::carla::profiler::ScopedMetricTimer carla_metric_timer_ ## context ## _ ## metric_name( \
+        carla_metric_ ## context ## _ ## metric_name);
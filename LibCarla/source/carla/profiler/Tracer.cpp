@@ -0,0 +1,210 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/profiler/Tracer.h"
+
+#include "carla/Logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace profiler {
+namespace detail {
+
+  struct TraceEvent {
+    const char *name;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+  };
+
+  /// Ring buffer written only by its owning thread. The dumper reads it with
+  /// recording paused; a zone that raced past the enabled check may still
+  /// land one event concurrently, in which case the dump sees either the old
+  /// or the new record, both of which are valid.
+  class ThreadBuffer {
+  public:
+
+    ThreadBuffer()
+      : _events(Tracer::events_per_thread),
+        _thread_id(std::hash<std::thread::id>()(std::this_thread::get_id())) {}
+
+    void Push(const char *name, uint64_t begin_ns, uint64_t end_ns) {
+      auto &event = _events[_head % _events.size()];
+      event.name = name;
+      event.begin_ns = begin_ns;
+      event.end_ns = end_ns;
+      ++_head;
+      _published.store(_head, std::memory_order_release);
+    }
+
+    uint64_t GetThreadId() const {
+      return _thread_id;
+    }
+
+    /// Visit the retained events, oldest first.
+    template <typename F>
+    void ForEachEvent(F &&func) const {
+      const auto total = _published.load(std::memory_order_acquire);
+      const auto count = std::min<uint64_t>(total, _events.size());
+      for (auto i = total - count; i < total; ++i) {
+        func(_events[i % _events.size()]);
+      }
+    }
+
+  private:
+
+    std::vector<TraceEvent> _events;
+
+    uint64_t _head = 0u;
+
+    std::atomic<uint64_t> _published{0u};
+
+    const uint64_t _thread_id;
+  };
+
+  /// Owns the per-thread buffers; buffers outlive their threads so events
+  /// from finished threads still show up in the dump.
+  class TraceRegistry {
+  public:
+
+    static TraceRegistry &Get() {
+      static TraceRegistry instance;
+      return instance;
+    }
+
+    static ThreadBuffer &GetThreadBuffer() {
+      static thread_local std::shared_ptr<ThreadBuffer> buffer = Get().RegisterThread();
+      return *buffer;
+    }
+
+    void WriteDump(const std::string &filename) {
+      const bool was_enabled = Tracer::IsEnabled();
+      Tracer::Disable();
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::ofstream file(filename, std::ios_base::out | std::ios_base::binary);
+        if (!file) {
+          log_warning("tracer: cannot open", filename, "for writing");
+        } else {
+          WriteDumpToStream(file);
+          logging::log("tracer: trace written to", filename);
+        }
+      }
+      if (was_enabled) {
+        Tracer::Enable();
+      }
+    }
+
+  private:
+
+    TraceRegistry() {
+      const char *path = std::getenv("CARLA_TRACE");
+      if ((path != nullptr) && (path[0] != '\0')) {
+        _exit_dump_path = path;
+        Tracer::Enable();
+      }
+    }
+
+    ~TraceRegistry() {
+      if (!_exit_dump_path.empty()) {
+        WriteDump(_exit_dump_path);
+      }
+    }
+
+    std::shared_ptr<ThreadBuffer> RegisterThread() {
+      auto buffer = std::make_shared<ThreadBuffer>();
+      std::lock_guard<std::mutex> lock(_mutex);
+      _buffers.push_back(buffer);
+      return buffer;
+    }
+
+    template <typename T>
+    static void WriteBinary(std::ostream &out, const T &value) {
+      out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    void WriteDumpToStream(std::ostream &out) const {
+      // Zone names are string literals, collect them by address.
+      std::unordered_map<const char *, uint32_t> name_index;
+      std::vector<const char *> names;
+      for (const auto &buffer : _buffers) {
+        buffer->ForEachEvent([&](const TraceEvent &event) {
+          if (name_index.emplace(event.name, static_cast<uint32_t>(names.size())).second) {
+            names.push_back(event.name);
+          }
+        });
+      }
+
+      out.write("CARLATRC", 8);
+      WriteBinary(out, uint32_t(1u)); // version.
+
+      WriteBinary(out, static_cast<uint32_t>(names.size()));
+      for (const char *name : names) {
+        const std::string str(name);
+        WriteBinary(out, static_cast<uint32_t>(str.size()));
+        out.write(str.data(), static_cast<std::streamsize>(str.size()));
+      }
+
+      WriteBinary(out, static_cast<uint32_t>(_buffers.size()));
+      for (const auto &buffer : _buffers) {
+        WriteBinary(out, buffer->GetThreadId());
+        uint64_t count = 0u;
+        buffer->ForEachEvent([&](const TraceEvent &) { ++count; });
+        WriteBinary(out, count);
+        buffer->ForEachEvent([&](const TraceEvent &event) {
+          WriteBinary(out, name_index.at(event.name));
+          WriteBinary(out, event.begin_ns);
+          WriteBinary(out, event.end_ns);
+        });
+      }
+    }
+
+    std::mutex _mutex;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+    std::string _exit_dump_path;
+  };
+
+  // Construct the registry at start-up so CARLA_TRACE is honoured even if
+  // the first zone runs late.
+  static const TraceRegistry &trace_registry_initializer = TraceRegistry::Get();
+
+} // namespace detail
+
+  std::atomic<bool> Tracer::_enabled{false};
+
+  void Tracer::Enable() {
+    _enabled.store(true, std::memory_order_relaxed);
+  }
+
+  void Tracer::Disable() {
+    _enabled.store(false, std::memory_order_relaxed);
+  }
+
+  void Tracer::Dump(const std::string &filename) {
+    detail::TraceRegistry::Get().WriteDump(filename);
+  }
+
+  uint64_t Tracer::NowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void Tracer::Record(const char *name, uint64_t begin_ns, uint64_t end_ns) {
+    detail::TraceRegistry::GetThreadBuffer().Push(name, begin_ns, end_ns);
+  }
+
+} // namespace profiler
+} // namespace carla
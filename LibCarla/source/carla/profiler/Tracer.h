@@ -0,0 +1,90 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace carla {
+namespace profiler {
+
+  /// Tracing profiler that is always compiled in, unlike the StopWatch-based
+  /// profiler behind LIBCARLA_WITH_PROFILER. Zones record begin/end pairs
+  /// into fixed-size per-thread ring buffers where the newest events win, so
+  /// a dump is a flight recording of the most recent activity; that is what
+  /// is needed when profiling an incident on a build that was not started
+  /// with profiling in mind.
+  ///
+  /// Recording is off by default and costs one relaxed atomic load per zone.
+  /// It is switched on either programmatically with Enable(), or by setting
+  /// the environment variable CARLA_TRACE to a file path, in which case the
+  /// recording is also dumped to that path at process exit.
+  class Tracer {
+  public:
+
+    /// Events retained per thread; older events are overwritten.
+    static constexpr size_t events_per_thread = 1u << 16u;
+
+    static bool IsEnabled() {
+      return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void Enable();
+
+    static void Disable();
+
+    /// Write every retained event to @a filename in the binary trace format
+    /// (magic "CARLATRC", version 1: a string table of zone names followed by
+    /// per-thread blocks of {name index, begin, end} nanosecond records).
+    /// Recording is paused while the dump is written.
+    static void Dump(const std::string &filename);
+
+    /// Monotonic clock, nanoseconds.
+    static uint64_t NowNs();
+
+  private:
+
+    friend class ScopedTraceZone;
+
+    /// Append one event to the calling thread's ring buffer. @a name must be
+    /// a string literal, the dump keeps it by address.
+    static void Record(const char *name, uint64_t begin_ns, uint64_t end_ns);
+
+    static std::atomic<bool> _enabled;
+  };
+
+  /// Records the lifetime of the current scope as one trace event; see
+  /// CARLA_TRACE_ZONE.
+  class ScopedTraceZone {
+  public:
+
+    explicit ScopedTraceZone(const char *name) {
+      if (Tracer::IsEnabled()) {
+        _name = name;
+        _begin_ns = Tracer::NowNs();
+      }
+    }
+
+    ~ScopedTraceZone() {
+      if (_name != nullptr) {
+        Tracer::Record(_name, _begin_ns, Tracer::NowNs());
+      }
+    }
+
+  private:
+
+    const char *_name = nullptr;
+
+    uint64_t _begin_ns = 0u;
+  };
+
+} // namespace profiler
+} // namespace carla
+
+#define CARLA_TRACE_ZONE(context, zone_name) \
+    ::carla::profiler::ScopedTraceZone carla_trace_ ## context ## _ ## zone_name(#context "." #zone_name);
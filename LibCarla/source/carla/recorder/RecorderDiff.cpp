@@ -0,0 +1,579 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/recorder/RecorderDiff.h"
+
+#include "carla/Exception.h"
+#include "carla/TaskScheduler.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace carla {
+namespace recorder {
+
+namespace {
+
+  // ===========================================================================
+  // -- On-disk format ---------------------------------------------------------
+  // ===========================================================================
+
+  // Mirrors the layout written by CarlaRecorder (see CarlaRecorderPacketId
+  // and friends in the Unreal plugin); packets not listed here are skipped
+  // over by their size.
+  constexpr char packet_frame_start = 0;
+  constexpr char packet_frame_end = 1;
+  constexpr char packet_event_del = 3;
+  constexpr char packet_position = 6;
+  constexpr char packet_frame_index = 18;
+  constexpr char packet_position_delta = 19;
+
+  constexpr char recorder_magic[] = "CARLA_RECORDER";
+  constexpr char compressed_magic[8] = {'C', 'A', 'R', 'L', 'A', 'Z', 'I', 'P'};
+  constexpr char frame_index_magic[8] = {'C', 'A', 'R', 'L', 'A', 'I', 'D', 'X'};
+
+  // quantization step of the delta position records (cm and degrees).
+  constexpr float delta_location_scale = 0.01f;
+  constexpr float delta_rotation_scale = 0.01f;
+
+#pragma pack(push, 1)
+
+  struct FrameRecord {
+    uint64_t id;
+    double duration;
+    double elapsed;
+  };
+
+  struct PositionRecord {
+    uint32_t actor_id;
+    float location[3u];
+    float rotation[3u];
+  };
+
+  struct PositionDeltaRecord {
+    uint32_t actor_id;
+    int16_t location_delta[3u];
+    int16_t rotation_delta[3u];
+  };
+
+  struct CompressedBlockHeader {
+    uint32_t uncompressed_size;
+    uint32_t compressed_size;
+  };
+
+#pragma pack(pop)
+
+  // same wrap the recorder applies when expanding delta records, so the
+  // reconstructed rotations are bit-identical to the replayer's.
+  float WrapAngle(float degrees) {
+    degrees = std::fmod(degrees + 180.0f, 360.0f);
+    if (degrees < 0.0f) {
+      degrees += 360.0f;
+    }
+    return degrees - 180.0f;
+  }
+
+  // ===========================================================================
+  // -- File loading and cursor ------------------------------------------------
+  // ===========================================================================
+
+  std::vector<char> InflateRecording(const std::vector<char> &compressed) {
+    std::vector<char> result;
+    size_t pos = sizeof(compressed_magic);
+    CompressedBlockHeader header;
+    while (pos + sizeof(header) <= compressed.size()) {
+      std::memcpy(&header, compressed.data() + pos, sizeof(header));
+      pos += sizeof(header);
+      if (pos + header.compressed_size > compressed.size()) {
+        break;
+      }
+      const auto offset = result.size();
+      result.resize(offset + header.uncompressed_size);
+      if (header.compressed_size == header.uncompressed_size) {
+        // stored block.
+        std::memcpy(result.data() + offset, compressed.data() + pos, header.uncompressed_size);
+      } else {
+        uLongf destination_size = header.uncompressed_size;
+        const auto code = uncompress(
+            reinterpret_cast<Bytef *>(result.data() + offset),
+            &destination_size,
+            reinterpret_cast<const Bytef *>(compressed.data() + pos),
+            header.compressed_size);
+        if ((code != Z_OK) || (destination_size != header.uncompressed_size)) {
+          throw_exception(std::runtime_error("corrupt compressed recording block"));
+        }
+      }
+      pos += header.compressed_size;
+    }
+    return result;
+  }
+
+  std::vector<char> ReadRecordingFile(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+      throw_exception(std::runtime_error("unable to open recorder file " + filename));
+    }
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    if ((data.size() >= sizeof(compressed_magic)) &&
+        std::equal(std::begin(compressed_magic), std::end(compressed_magic), data.begin())) {
+      data = InflateRecording(data);
+    }
+    return data;
+  }
+
+  /// Bounds-checked reader over the raw bytes of a recording.
+  class Cursor {
+  public:
+
+    Cursor(const char *data, size_t begin, size_t end)
+      : _data(data),
+        _pos(begin),
+        _end(end) {}
+
+    size_t Tell() const {
+      return _pos;
+    }
+
+    bool CanRead(size_t size) const {
+      return (_pos + size) <= _end;
+    }
+
+    template <typename T>
+    T Read() {
+      T value;
+      std::memcpy(&value, _data + _pos, sizeof(T));
+      _pos += sizeof(T);
+      return value;
+    }
+
+    std::string ReadString() {
+      if (!CanRead(sizeof(uint16_t))) {
+        return std::string();
+      }
+      const auto length = Read<uint16_t>();
+      if (!CanRead(length)) {
+        return std::string();
+      }
+      std::string value(_data + _pos, length);
+      _pos += length;
+      return value;
+    }
+
+    void Skip(size_t size) {
+      _pos += size;
+    }
+
+  private:
+
+    const char *_data;
+
+    size_t _pos;
+
+    size_t _end;
+  };
+
+  // ===========================================================================
+  // -- Parsing ----------------------------------------------------------------
+  // ===========================================================================
+
+  /// Transforms of every actor alive at the end of one frame, sorted by
+  /// actor id.
+  struct FrameSnapshot {
+    uint64_t frame = 0u;
+    double time = 0.0;
+    std::vector<PositionRecord> actors;
+  };
+
+  struct ParsedChunk {
+    std::vector<FrameSnapshot> frames;
+    std::vector<std::string> notes;
+  };
+
+  struct RecordingHeader {
+    uint16_t version = 0u;
+    std::string map;
+    size_t body_begin = 0u;   ///< offset of the first packet.
+    size_t body_end = 0u;     ///< offset past the last frame packet.
+    std::vector<size_t> keyframe_offsets;
+  };
+
+  RecordingHeader ParseHeader(const std::string &filename, const std::vector<char> &data) {
+    RecordingHeader header;
+    Cursor cursor(data.data(), 0u, data.size());
+    if (!cursor.CanRead(2u)) {
+      throw_exception(std::runtime_error(filename + " is not a CARLA recording"));
+    }
+    header.version = cursor.Read<uint16_t>();
+    if (cursor.ReadString() != recorder_magic) {
+      throw_exception(std::runtime_error(filename + " is not a CARLA recording"));
+    }
+    if (!cursor.CanRead(sizeof(int64_t) + sizeof(uint16_t))) {
+      throw_exception(std::runtime_error(filename + " is truncated"));
+    }
+    cursor.Skip(sizeof(int64_t)); // date.
+    header.map = cursor.ReadString();
+    header.body_begin = cursor.Tell();
+    header.body_end = data.size();
+
+    // an indexed recording ends with the offset of the frame index packet
+    // followed by a magic tag; use its keyframes as chunk boundaries, the
+    // frame right after each one carries full positions for every actor.
+    const auto footer_size = sizeof(uint64_t) + sizeof(frame_index_magic);
+    if (data.size() < header.body_begin + footer_size) {
+      return header;
+    }
+    if (!std::equal(
+        std::begin(frame_index_magic),
+        std::end(frame_index_magic),
+        data.data() + data.size() - sizeof(frame_index_magic))) {
+      return header;
+    }
+    uint64_t index_offset = 0u;
+    std::memcpy(&index_offset, data.data() + data.size() - footer_size, sizeof(index_offset));
+    if ((index_offset < header.body_begin) || (index_offset + 5u > data.size())) {
+      return header;
+    }
+    Cursor index(data.data(), static_cast<size_t>(index_offset), data.size());
+    if (index.Read<char>() != packet_frame_index) {
+      return header;
+    }
+    index.Skip(sizeof(uint32_t)); // packet size.
+    if (!index.CanRead(sizeof(double) + sizeof(uint32_t))) {
+      return header;
+    }
+    header.body_end = static_cast<size_t>(index_offset);
+    index.Skip(sizeof(double)); // total time.
+    const auto frame_count = index.Read<uint32_t>();
+    index.Skip(frame_count * (sizeof(double) + sizeof(uint64_t)));
+    if (!index.CanRead(sizeof(uint32_t))) {
+      return header;
+    }
+    const auto keyframe_count = index.Read<uint32_t>();
+    for (uint32_t i = 0u; i < keyframe_count; ++i) {
+      if (!index.CanRead(sizeof(double) + sizeof(uint64_t) + sizeof(uint32_t))) {
+        break;
+      }
+      index.Skip(sizeof(double)); // time.
+      const auto frame_offset = static_cast<size_t>(index.Read<uint64_t>());
+      index.Skip(index.Read<uint32_t>()); // snapshot blob.
+      if ((frame_offset > header.body_begin) && (frame_offset < header.body_end)) {
+        header.keyframe_offsets.push_back(frame_offset);
+      }
+    }
+    return header;
+  }
+
+  /// Parse the packets in [ @a begin, @a end ) reconstructing a snapshot
+  /// per frame. Chunks split at keyframe offsets are self-contained: the
+  /// first frame of such a chunk carries full position records for every
+  /// actor, so the delta expansion never needs state from a previous
+  /// chunk.
+  ParsedChunk ParseChunk(
+      const std::string &filename,
+      const std::vector<char> &data,
+      size_t begin,
+      size_t end) {
+    ParsedChunk result;
+    std::unordered_map<uint32_t, PositionRecord> state;
+    FrameRecord frame{0u, 0.0, 0.0};
+    Cursor cursor(data.data(), begin, end);
+    while (cursor.CanRead(sizeof(char) + sizeof(uint32_t))) {
+      const auto id = cursor.Read<char>();
+      const auto size = cursor.Read<uint32_t>();
+      if (!cursor.CanRead(size)) {
+        result.notes.push_back(filename + " is truncated mid-packet");
+        break;
+      }
+      const auto next_packet = cursor.Tell() + size;
+      switch (id) {
+        case packet_frame_start:
+          if (size >= sizeof(FrameRecord)) {
+            frame = cursor.Read<FrameRecord>();
+          }
+          break;
+        case packet_frame_end: {
+          FrameSnapshot snapshot;
+          snapshot.frame = frame.id;
+          snapshot.time = frame.elapsed;
+          snapshot.actors.reserve(state.size());
+          for (const auto &pair : state) {
+            snapshot.actors.push_back(pair.second);
+          }
+          std::sort(
+              snapshot.actors.begin(),
+              snapshot.actors.end(),
+              [](const PositionRecord &lhs, const PositionRecord &rhs) {
+                return lhs.actor_id < rhs.actor_id;
+              });
+          result.frames.push_back(std::move(snapshot));
+          break;
+        }
+        case packet_event_del: {
+          const auto count = cursor.Read<uint16_t>();
+          for (uint16_t i = 0u; i < count; ++i) {
+            state.erase(cursor.Read<uint32_t>());
+          }
+          break;
+        }
+        case packet_position: {
+          const auto count = cursor.Read<uint16_t>();
+          for (uint16_t i = 0u; i < count; ++i) {
+            const auto record = cursor.Read<PositionRecord>();
+            state[record.actor_id] = record;
+          }
+          break;
+        }
+        case packet_position_delta: {
+          const auto count = cursor.Read<uint16_t>();
+          for (uint16_t i = 0u; i < count; ++i) {
+            const auto delta = cursor.Read<PositionDeltaRecord>();
+            auto search = state.find(delta.actor_id);
+            if (search == state.end()) {
+              // only possible on a malformed file, full records always
+              // precede the deltas of an actor.
+              continue;
+            }
+            auto &base = search->second;
+            for (auto axis = 0u; axis < 3u; ++axis) {
+              base.location[axis] += delta.location_delta[axis] * delta_location_scale;
+              base.rotation[axis] = WrapAngle(
+                  base.rotation[axis] + delta.rotation_delta[axis] * delta_rotation_scale);
+            }
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      cursor.Skip(next_packet - cursor.Tell());
+    }
+    return result;
+  }
+
+  /// Post one ParseChunk task per keyframe-delimited chunk of the
+  /// recording. Only the caller ever waits on the futures, so the workers
+  /// never block on each other.
+  std::vector<std::future<ParsedChunk>> PostParseChunks(
+      const std::string &filename,
+      const std::vector<char> &data,
+      const RecordingHeader &header,
+      TaskScheduler &scheduler) {
+    std::vector<size_t> boundaries;
+    boundaries.push_back(header.body_begin);
+    boundaries.insert(
+        boundaries.end(),
+        header.keyframe_offsets.begin(),
+        header.keyframe_offsets.end());
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    boundaries.push_back(header.body_end);
+
+    std::vector<std::future<ParsedChunk>> futures;
+    for (size_t i = 0u; i + 1u < boundaries.size(); ++i) {
+      const auto begin = boundaries[i];
+      const auto end = boundaries[i + 1u];
+      futures.push_back(scheduler.Post([&filename, &data, begin, end]() {
+        return ParseChunk(filename, data, begin, end);
+      }));
+    }
+    return futures;
+  }
+
+  ParsedChunk GatherChunks(std::vector<std::future<ParsedChunk>> &futures) {
+    ParsedChunk result;
+    for (auto &future : futures) {
+      auto chunk = future.get();
+      result.frames.insert(
+          result.frames.end(),
+          std::make_move_iterator(chunk.frames.begin()),
+          std::make_move_iterator(chunk.frames.end()));
+      result.notes.insert(result.notes.end(), chunk.notes.begin(), chunk.notes.end());
+    }
+    return result;
+  }
+
+  // ===========================================================================
+  // -- Comparison -------------------------------------------------------------
+  // ===========================================================================
+
+  float LocationDelta(const PositionRecord &lhs, const PositionRecord &rhs) {
+    float squared = 0.0f;
+    for (auto axis = 0u; axis < 3u; ++axis) {
+      const auto diff = lhs.location[axis] - rhs.location[axis];
+      squared += diff * diff;
+    }
+    return std::sqrt(squared);
+  }
+
+  float RotationDelta(const PositionRecord &lhs, const PositionRecord &rhs) {
+    float result = 0.0f;
+    for (auto axis = 0u; axis < 3u; ++axis) {
+      const auto diff = std::abs(WrapAngle(lhs.rotation[axis] - rhs.rotation[axis]));
+      result = std::max(result, diff);
+    }
+    return result;
+  }
+
+  /// Compare the frames in [ @a begin, @a end ), collecting at most
+  /// @a options.max_divergences records.
+  std::vector<RecorderDivergence> CompareFrameRange(
+      const std::vector<FrameSnapshot> &lhs,
+      const std::vector<FrameSnapshot> &rhs,
+      size_t begin,
+      size_t end,
+      const RecorderDiffOptions &options) {
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    std::vector<RecorderDivergence> result;
+    auto add = [&](const FrameSnapshot &frame, uint32_t actor_id, float location, float rotation) {
+      if (result.size() < options.max_divergences) {
+        result.push_back(RecorderDivergence{frame.frame, frame.time, actor_id, location, rotation});
+      }
+    };
+    for (auto i = begin; i < end; ++i) {
+      const auto &lhs_frame = lhs[i];
+      const auto &rhs_frame = rhs[i];
+      auto lhs_it = lhs_frame.actors.begin();
+      auto rhs_it = rhs_frame.actors.begin();
+      while ((lhs_it != lhs_frame.actors.end()) && (rhs_it != rhs_frame.actors.end())) {
+        if (lhs_it->actor_id < rhs_it->actor_id) {
+          add(lhs_frame, (lhs_it++)->actor_id, infinity, infinity);
+        } else if (rhs_it->actor_id < lhs_it->actor_id) {
+          add(lhs_frame, (rhs_it++)->actor_id, infinity, infinity);
+        } else {
+          const auto location = LocationDelta(*lhs_it, *rhs_it);
+          const auto rotation = RotationDelta(*lhs_it, *rhs_it);
+          if ((location > options.location_epsilon) || (rotation > options.rotation_epsilon)) {
+            add(lhs_frame, lhs_it->actor_id, location, rotation);
+          }
+          ++lhs_it;
+          ++rhs_it;
+        }
+      }
+      for (; lhs_it != lhs_frame.actors.end(); ++lhs_it) {
+        add(lhs_frame, lhs_it->actor_id, infinity, infinity);
+      }
+      for (; rhs_it != rhs_frame.actors.end(); ++rhs_it) {
+        add(lhs_frame, rhs_it->actor_id, infinity, infinity);
+      }
+    }
+    return result;
+  }
+
+} // namespace
+
+  RecorderDiffResult DiffRecorderFiles(
+      const std::string &lhs_filename,
+      const std::string &rhs_filename,
+      const RecorderDiffOptions &options) {
+    const auto num_threads =
+        (options.num_threads > 0u) ? options.num_threads : std::thread::hardware_concurrency();
+    TaskScheduler scheduler(num_threads);
+    scheduler.AsyncRun();
+    RecorderDiffResult result;
+
+    const auto lhs_data = ReadRecordingFile(lhs_filename);
+    const auto rhs_data = ReadRecordingFile(rhs_filename);
+    const auto lhs_header = ParseHeader(lhs_filename, lhs_data);
+    const auto rhs_header = ParseHeader(rhs_filename, rhs_data);
+    if (lhs_header.version != rhs_header.version) {
+      result.notes.push_back(
+          "version mismatch: " + std::to_string(lhs_header.version) +
+          " vs " + std::to_string(rhs_header.version));
+    }
+    if (lhs_header.map != rhs_header.map) {
+      result.notes.push_back("map mismatch: " + lhs_header.map + " vs " + rhs_header.map);
+    }
+
+    auto lhs_futures = PostParseChunks(lhs_filename, lhs_data, lhs_header, scheduler);
+    auto rhs_futures = PostParseChunks(rhs_filename, rhs_data, rhs_header, scheduler);
+    auto lhs_parsed = GatherChunks(lhs_futures);
+    auto rhs_parsed = GatherChunks(rhs_futures);
+    result.notes.insert(result.notes.end(), lhs_parsed.notes.begin(), lhs_parsed.notes.end());
+    result.notes.insert(result.notes.end(), rhs_parsed.notes.begin(), rhs_parsed.notes.end());
+
+    if (lhs_parsed.frames.size() != rhs_parsed.frames.size()) {
+      result.notes.push_back(
+          "frame count mismatch: " + std::to_string(lhs_parsed.frames.size()) +
+          " vs " + std::to_string(rhs_parsed.frames.size()) + ", comparing the common prefix");
+    }
+    auto common = std::min(lhs_parsed.frames.size(), rhs_parsed.frames.size());
+    for (size_t i = 0u; i < common; ++i) {
+      if (lhs_parsed.frames[i].frame != rhs_parsed.frames[i].frame) {
+        result.notes.push_back(
+            "frame sequences differ from frame " + std::to_string(lhs_parsed.frames[i].frame) +
+            " vs " + std::to_string(rhs_parsed.frames[i].frame) + " onwards, comparison stops there");
+        common = i;
+        break;
+      }
+    }
+    result.frames_compared = common;
+
+    // compare in parallel chunks of frames; each worker collects its own
+    // divergences and the chunks are merged back in frame order.
+    const auto chunk_size = std::max<size_t>(1u, common / (4u * num_threads));
+    std::vector<std::future<std::vector<RecorderDivergence>>> futures;
+    for (size_t begin = 0u; begin < common; begin += chunk_size) {
+      const auto end = std::min(common, begin + chunk_size);
+      futures.push_back(scheduler.Post([&, begin, end]() {
+        return CompareFrameRange(lhs_parsed.frames, rhs_parsed.frames, begin, end, options);
+      }));
+    }
+    for (auto &future : futures) {
+      auto divergences = future.get();
+      for (auto &divergence : divergences) {
+        if (result.divergences.size() < options.max_divergences) {
+          result.divergences.push_back(divergence);
+        }
+      }
+    }
+    if (!result.divergences.empty()) {
+      result.divergence_frame = result.divergences.front().frame;
+      result.divergence_time = result.divergences.front().time;
+    }
+    return result;
+  }
+
+  std::string RecorderDiffResult::ToString() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    if (divergence_frame != 0u) {
+      out << "recordings diverge at frame " << divergence_frame
+          << " (" << divergence_time << " seconds), "
+          << frames_compared << " frames compared\n";
+      for (const auto &divergence : divergences) {
+        out << "  frame " << divergence.frame
+            << " actor " << divergence.actor_id;
+        if (std::isinf(divergence.location_delta)) {
+          out << ": present in only one recording\n";
+        } else {
+          out << ": location delta " << divergence.location_delta
+              << " cm, rotation delta " << divergence.rotation_delta << " degrees\n";
+        }
+      }
+    } else {
+      out << "recordings match, " << frames_compared << " frames compared\n";
+    }
+    for (const auto &note : notes) {
+      out << "note: " << note << "\n";
+    }
+    return out.str();
+  }
+
+} // namespace recorder
+} // namespace carla
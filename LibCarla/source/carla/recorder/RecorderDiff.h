@@ -0,0 +1,94 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace recorder {
+
+  /// Tolerances and limits for DiffRecorderFiles.
+  struct RecorderDiffOptions {
+
+    /// Location differences up to this many centimetres are considered
+    /// equal; the recorder quantizes delta records to 0.01 cm, so values
+    /// below that only measure the quantization itself.
+    float location_epsilon = 1.0f;
+
+    /// Rotation differences up to this many degrees are considered equal.
+    float rotation_epsilon = 1.0f;
+
+    /// At most this many divergent actor records are kept in the result;
+    /// the first divergence frame is always exact regardless.
+    size_t max_divergences = 128u;
+
+    /// Worker threads for parsing and comparing, 0 means hardware
+    /// concurrency.
+    size_t num_threads = 0u;
+  };
+
+  /// One actor whose transform differs between the two recordings at a
+  /// given frame. An actor present in only one of the recordings is
+  /// reported with infinite deltas.
+  struct RecorderDivergence {
+    uint64_t frame = 0u;
+    double time = 0.0;
+    uint32_t actor_id = 0u;
+    float location_delta = 0.0f;  ///< centimetres.
+    float rotation_delta = 0.0f;  ///< degrees, largest axis.
+  };
+
+  /// Outcome of comparing two recordings.
+  struct RecorderDiffResult {
+
+    /// Frames present in both recordings that were actually compared.
+    uint64_t frames_compared = 0u;
+
+    /// First frame where any actor exceeded the tolerances, 0 when the
+    /// recordings match.
+    uint64_t divergence_frame = 0u;
+
+    /// Elapsed simulation time of the divergence frame.
+    double divergence_time = 0.0;
+
+    /// Divergent actor records ordered by frame, capped at
+    /// RecorderDiffOptions::max_divergences.
+    std::vector<RecorderDivergence> divergences;
+
+    /// Structural differences that make the comparison itself suspect:
+    /// mismatched map or version, different frame counts, truncated files.
+    std::vector<std::string> notes;
+
+    bool HasDiverged() const {
+      return (divergence_frame != 0u) || !notes.empty();
+    }
+
+    /// Human-readable report of this result.
+    std::string ToString() const;
+  };
+
+  /// Structurally compare two recordings written by CarlaRecorder, frame
+  /// by frame: actor transforms are reconstructed from the full and
+  /// delta position records and diffed against @a options' tolerances,
+  /// identifying the first frame the simulations diverged at. Recordings
+  /// of deterministic runs should compare clean; anything else is
+  /// nondeterminism worth chasing before it surfaces as scenario
+  /// flakiness.
+  ///
+  /// Both files are parsed and compared in parallel chunks, split at the
+  /// keyframes of the frame index when the recording has one; compressed
+  /// recordings are inflated in memory. Throws std::runtime_error if a
+  /// file cannot be read or is not a CARLA recording.
+  RecorderDiffResult DiffRecorderFiles(
+      const std::string &lhs_filename,
+      const std::string &rhs_filename,
+      const RecorderDiffOptions &options = RecorderDiffOptions());
+
+} // namespace recorder
+} // namespace carla
@@ -10,7 +10,10 @@
 #include "carla/road/RoadElementSet.h"
 #include "carla/road/element/RoadInfo.h"
 #include "carla/road/element/RoadInfoIterator.h"
+#include "carla/road/element/RoadInfoTypeIndex.h"
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <memory>
 
@@ -23,15 +26,18 @@ namespace road {
     InformationSet() = default;
 
     InformationSet(std::vector<std::unique_ptr<element::RoadInfo>> &&vec)
-      : _road_set(std::move(vec)) {}
+      : _road_set(std::move(vec)) {
+      BuildTypeIndex();
+    }
 
     /// Return all infos given a type from the start of the road
     template <typename T>
     std::vector<const T *> GetInfos() const {
+      const auto range = GetTypeRange<T>();
       std::vector<const T *> vec;
-      auto it = element::MakeRoadInfoIterator<T>(_road_set.GetAll());
-      for (; !it.IsAtEnd(); ++it) {
-        vec.emplace_back(&*it);
+      vec.reserve(range.second - range.first);
+      for (size_t i = range.first; i < range.second; ++i) {
+        vec.emplace_back(static_cast<const T *>(_type_index[i].info));
       }
       return vec;
     }
@@ -40,25 +46,34 @@ namespace road {
     /// the start of the road
     template <typename T>
     const T *GetInfo(const double s) const {
-      auto it = element::MakeRoadInfoIterator<T>(_road_set.GetReverseSubset(s));
-      return it.IsAtEnd() ? nullptr : &*it;
+      const auto range = GetTypeRange<T>();
+      auto begin = _type_index.begin() + static_cast<ptrdiff_t>(range.first);
+      auto end = _type_index.begin() + static_cast<ptrdiff_t>(range.second);
+      auto it = std::upper_bound(begin, end, s,
+          [](const double value, const IndexEntry &entry) { return value < entry.s; });
+      return it == begin ? nullptr : static_cast<const T *>((it - 1u)->info);
     }
 
     /// Return all infos given a type in a given range of the road
     template <typename T>
     std::vector<const T *> GetInfos(const double min_s, const double max_s) const {
+      const auto range = GetTypeRange<T>();
+      auto begin = _type_index.begin() + static_cast<ptrdiff_t>(range.first);
+      auto end = _type_index.begin() + static_cast<ptrdiff_t>(range.second);
+      auto lower_comp = [](const IndexEntry &entry, const double value) { return entry.s < value; };
+      auto upper_comp = [](const double value, const IndexEntry &entry) { return value < entry.s; };
       std::vector<const T *> vec;
-      if(min_s < max_s) {
-        auto it = element::MakeRoadInfoIterator<T>(
-            _road_set.GetSubsetInRange(min_s, max_s)); //reverse
-        for (; !it.IsAtEnd(); ++it) {
-          vec.emplace_back(&*it);
+      if (min_s < max_s) {
+        auto low = std::lower_bound(begin, end, min_s, lower_comp);
+        auto up = std::upper_bound(low, end, max_s, upper_comp);
+        for (auto it = low; it != up; ++it) {
+          vec.emplace_back(static_cast<const T *>(it->info));
         }
       } else {
-        auto it = element::MakeRoadInfoIterator<T>(
-            _road_set.GetReverseSubsetInRange(max_s, min_s)); //reverse
-        for (; !it.IsAtEnd(); ++it) {
-          vec.emplace_back(&*it);
+        auto low = std::lower_bound(begin, end, max_s, lower_comp);
+        auto up = std::upper_bound(low, end, min_s, upper_comp);
+        for (auto it = up; it != low; --it) { // reverse
+          vec.emplace_back(static_cast<const T *>((it - 1u)->info));
         }
       }
       return vec;
@@ -66,7 +81,48 @@ namespace road {
 
   private:
 
+    /// One record of the flat per-type index: the record's distance sits next
+    /// to its pointer so queries binary-search contiguous memory instead of
+    /// chasing the unique_ptrs of the road set.
+    struct IndexEntry {
+      double s;
+      const element::RoadInfo *info;
+    };
+
+    template <typename T>
+    std::pair<size_t, size_t> GetTypeRange() const {
+      return _type_ranges[static_cast<size_t>(element::RoadInfoTypeIndex<T>::value)];
+    }
+
+    /// Classify every record once and pack them into one contiguous array
+    /// partitioned by type; within a partition the road-set order (sorted by
+    /// distance) is preserved.
+    void BuildTypeIndex() {
+      constexpr size_t num_types = static_cast<size_t>(element::RoadInfoType::SIZE);
+      std::array<std::vector<IndexEntry>, num_types> buckets;
+      element::RoadInfoTypeVisitor visitor;
+      for (const auto &info : _road_set.GetAll()) {
+        info->AcceptVisitor(visitor);
+        buckets[static_cast<size_t>(visitor.GetType())].push_back(
+            IndexEntry{info->GetDistance(), info.get()});
+      }
+      _type_index.reserve(_road_set.size());
+      for (size_t slot = 0u; slot < num_types; ++slot) {
+        const size_t first = _type_index.size();
+        _type_index.insert(_type_index.end(), buckets[slot].begin(), buckets[slot].end());
+        _type_ranges[slot] = {first, _type_index.size()};
+      }
+    }
+
     RoadElementSet<std::unique_ptr<element::RoadInfo>> _road_set;
+
+    /// Flat per-type index over the records of _road_set; the records stay
+    /// valid across moves, so the index moves along with the set.
+    std::vector<IndexEntry> _type_index;
+
+    /// [first, second) range of each RoadInfoType inside _type_index.
+    std::array<std::pair<size_t, size_t>, static_cast<size_t>(element::RoadInfoType::SIZE)>
+        _type_ranges{};
   };
 
 } // road
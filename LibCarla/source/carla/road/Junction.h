@@ -82,10 +82,46 @@ namespace road {
       return _road_conflicts.at(road_id);
     }
 
+    /// True when the connecting roads @a lhs and @a rhs geometrically overlap
+    /// inside this junction. Backed by a bitmatrix precomputed at map load,
+    /// so the test costs two index lookups instead of a geometry check.
+    bool RoadsConflict(RoadId lhs, RoadId rhs) const {
+      const auto row = _conflict_index.find(lhs);
+      const auto col = _conflict_index.find(rhs);
+      if (row == _conflict_index.end() || col == _conflict_index.end()) {
+        return false;
+      }
+      return _conflict_matrix[row->second * _conflict_index.size() + col->second];
+    }
+
   private:
 
     friend MapBuilder;
 
+    /// Flattens _road_conflicts into the bitmatrix queried by RoadsConflict;
+    /// called by MapBuilder once the conflict sets have been computed.
+    void BuildConflictMatrix() {
+      _conflict_index.clear();
+      for (const auto &connection : _connections) {
+        _conflict_index.emplace(connection.second.connecting_road, _conflict_index.size());
+      }
+      const size_t stride = _conflict_index.size();
+      _conflict_matrix.assign(stride * stride, false);
+      for (const auto &conflict : _road_conflicts) {
+        const auto row = _conflict_index.find(conflict.first);
+        if (row == _conflict_index.end()) {
+          continue;
+        }
+        for (const auto other_road_id : conflict.second) {
+          const auto col = _conflict_index.find(other_road_id);
+          if (col == _conflict_index.end()) {
+            continue;
+          }
+          _conflict_matrix[row->second * stride + col->second] = true;
+        }
+      }
+    }
+
     JuncId _id;
 
     std::string _name;
@@ -97,6 +133,10 @@ namespace road {
     std::unordered_map<RoadId, std::unordered_set<RoadId>>
         _road_conflicts;
 
+    std::unordered_map<RoadId, size_t> _conflict_index;
+
+    std::vector<bool> _conflict_matrix;
+
     carla::geom::BoundingBox _bounding_box;
   };
 
@@ -6,6 +6,7 @@
 
 #include "carla/road/Lane.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "carla/Debug.h"
@@ -57,9 +58,15 @@ namespace road {
 
   double Lane::GetWidth(const double s) const {
     RELEASE_ASSERT(s <= GetRoad()->GetLength());
-    const auto width_info = GetInfo<element::RoadInfoLaneWidth>(s);
-    RELEASE_ASSERT(width_info != nullptr);
-    return width_info->GetPolynomial().Evaluate(s);
+    return ComputeWidthAndTangent(s).first;
+  }
+
+  std::pair<double, double> Lane::ComputeWidthAndTangent(const double s) const {
+    auto it = std::upper_bound(_width_table.begin(), _width_table.end(), s,
+        [](const double value, const WidthRecord &record) { return value < record.s; });
+    RELEASE_ASSERT(it != _width_table.begin());
+    const geom::CubicPolynomial &polynomial = (it - 1u)->polynomial;
+    return std::make_pair(polynomial.Evaluate(s), polynomial.Tangent(s));
   }
 
   bool Lane::IsStraight() const {
@@ -108,11 +115,9 @@ namespace road {
     double dist = 0.0;
     double tangent = 0.0;
     for (const auto &lane : container) {
-      auto info = lane.second.template GetInfo<element::RoadInfoLaneWidth>(s);
-      RELEASE_ASSERT(info != nullptr);
-      const auto current_polynomial = info->GetPolynomial();
-      auto current_dist = current_polynomial.Evaluate(s);
-      auto current_tang = current_polynomial.Tangent(s);
+      const auto width_tangent = lane.second.ComputeWidthAndTangent(s);
+      auto current_dist = width_tangent.first;
+      auto current_tang = width_tangent.second;
       if (lane.first != lane_id) {
         dist += negative_lane_id ? current_dist : -current_dist;
         tangent += negative_lane_id ? current_tang : -current_tang;
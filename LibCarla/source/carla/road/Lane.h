@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/geom/CubicPolynomial.h"
 #include "carla/geom/Mesh.h"
 #include "carla/geom/Transform.h"
 #include "carla/road/InformationSet.h"
@@ -110,6 +111,11 @@ namespace road {
     /// Returns the total lane width given a s
     double GetWidth(const double s) const;
 
+    /// Evaluates the lane width and its tangent at @a s from the packed
+    /// width table in a single pass, without going through the RoadInfo
+    /// records.
+    std::pair<double, double> ComputeWidthAndTangent(const double s) const;
+
     /// Checks whether the geometry is straight or not
     bool IsStraight() const;
 
@@ -123,6 +129,13 @@ namespace road {
 
     friend MapBuilder;
 
+    /// One piece of the lane-width polynomial: the s-breakpoint packed next
+    /// to the coefficients so an evaluation touches a single table record.
+    struct WidthRecord {
+      double s;
+      geom::CubicPolynomial polynomial;
+    };
+
     LaneSection *_lane_section = nullptr;
 
     LaneId _id = 0;
@@ -140,6 +153,10 @@ namespace road {
     std::vector<Lane *> _next_lanes;
 
     std::vector<Lane *> _prev_lanes;
+
+    /// Piecewise width polynomial sorted by s, precomputed by
+    /// MapBuilder::Build() from the RoadInfoLaneWidth records.
+    std::vector<WidthRecord> _width_table;
   };
 
 } // road
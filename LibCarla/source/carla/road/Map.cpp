@@ -6,6 +6,7 @@
 
 #include "carla/road/Map.h"
 #include "carla/Exception.h"
+#include "carla/TaskScheduler.h"
 #include "carla/geom/Math.h"
 #include "carla/road/MeshFactory.h"
 #include "carla/road/element/LaneCrossingCalculator.h"
@@ -17,6 +18,8 @@
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
+#include <cmath>
+#include <future>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
@@ -170,7 +173,9 @@ namespace road {
     Rtree::BSegment segment = query_result.front().first;
     Rtree::BPoint s1 = segment.first;
     Rtree::BPoint s2 = segment.second;
-    auto distance_to_segment = geom::Math::DistanceSegmentToPoint(pos,
+    // Only the distance along the segment is needed, the cheaper kernel
+    // skips the Euclidean distance.
+    const double segment_delta_s = geom::Math::DistanceAlongSegment2D(pos,
         geom::Vector3D(s1.get<0>(), s1.get<1>(), s1.get<2>()),
         geom::Vector3D(s2.get<0>(), s2.get<1>(), s2.get<2>()));
 
@@ -178,7 +183,7 @@ namespace road {
     Waypoint result_end = query_result.front().second.second;
 
     if (result_start.lane_id < 0) {
-      double delta_s = distance_to_segment.first;
+      double delta_s = segment_delta_s;
       double final_s = result_start.s + delta_s;
       if (final_s >= result_end.s) {
         return result_end;
@@ -188,7 +193,7 @@ namespace road {
         return GetNext(result_start, delta_s).front();
       }
     } else {
-      double delta_s = distance_to_segment.first;
+      double delta_s = segment_delta_s;
       double final_s = result_start.s - delta_s;
       if (final_s <= result_end.s) {
         return result_end;
@@ -200,6 +205,61 @@ namespace road {
     }
   }
 
+  boost::optional<Waypoint> Map::ProjectOntoHintedLane(
+      const geom::Location &pos,
+      Waypoint hint,
+      uint32_t lane_type) const {
+    if (!_data.ContainsRoad(hint.road_id) || !IsLanePresent(_data, hint)) {
+      return boost::optional<Waypoint>{};
+    }
+    const Lane &lane = GetLane(hint);
+    if ((lane_type & static_cast<uint32_t>(lane.GetType())) == 0u) {
+      return boost::optional<Waypoint>{};
+    }
+
+    // Advance the hint along its lane by the forward distance travelled; on
+    // negative lanes the driving direction increases s, on positive ones it
+    // decreases it.
+    const geom::Transform hint_transform = ComputeTransform(hint);
+    const double travelled = geom::Math::Dot(
+        hint_transform.GetForwardVector(), pos - hint_transform.location);
+    double candidate_s = hint.s + (hint.lane_id < 0 ? travelled : -travelled);
+
+    const double lane_start = lane.GetDistance();
+    const double lane_end = lane_start + lane.GetLength();
+    if (candidate_s < lane_start || candidate_s > lane_end) {
+      // left the hinted lane section
+      return boost::optional<Waypoint>{};
+    }
+    Waypoint candidate = hint;
+    candidate.s = geom::Math::Clamp(candidate_s, lane_start + EPSILON, lane_end - EPSILON);
+
+    // Accept the hint only while the location stays within the lane.
+    const auto candidate_location = ComputeTransform(candidate).location;
+    const auto half_lane_width = 0.5 * GetLaneWidth(candidate);
+    if (geom::Math::Distance2D(candidate_location, pos) > half_lane_width) {
+      return boost::optional<Waypoint>{};
+    }
+    return candidate;
+  }
+
+  std::vector<boost::optional<Waypoint>> Map::GetClosestWaypointsOnRoad(
+      const std::vector<geom::Location> &locations,
+      const std::vector<boost::optional<Waypoint>> &hints,
+      uint32_t lane_type) const {
+    std::vector<boost::optional<Waypoint>> results(locations.size());
+    for (size_t i = 0u; i < locations.size(); ++i) {
+      if (i < hints.size() && hints[i].has_value()) {
+        results[i] = ProjectOntoHintedLane(locations[i], *hints[i], lane_type);
+        if (results[i].has_value()) {
+          continue;
+        }
+      }
+      results[i] = GetClosestWaypointOnRoad(locations[i], lane_type);
+    }
+    return results;
+  }
+
   boost::optional<Waypoint> Map::GetWaypoint(
       const geom::Location &pos,
       uint32_t lane_type) const {
@@ -400,62 +460,7 @@ namespace road {
   }
 
   std::vector<geom::Location> Map::GetAllCrosswalkZones() const {
-    std::vector<geom::Location> result;
-
-    for (const auto &pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      std::vector<const RoadInfoCrosswalk *> crosswalks = road.GetInfos<RoadInfoCrosswalk>();
-      if (crosswalks.size() > 0) {
-        for (auto crosswalk : crosswalks) {
-          // waypoint only at start position
-          std::vector<geom::Location> points;
-          Waypoint waypoint;
-          geom::Transform base;
-          for (const auto &section : road.GetLaneSectionsAt(crosswalk->GetS())) {
-            // get the section with the center lane
-            for (const auto &lane : section.GetLanes()) {
-              // is the center line
-              if (lane.first == 0) {
-                // get the center point
-                waypoint.road_id = pair.first;
-                waypoint.section_id = section.GetId();
-                waypoint.lane_id = 0;
-                waypoint.s = crosswalk->GetS();
-                base = ComputeTransform(waypoint);
-              }
-            }
-          }
-
-          // move perpendicular ('t')
-          geom::Transform pivot = base;
-          pivot.rotation.yaw -= geom::Math::ToDegrees<float>(static_cast<float>(crosswalk->GetHeading()));
-          pivot.rotation.yaw -= 90;   // move perpendicular to 's' for the lateral offset
-          geom::Vector3D v(static_cast<float>(crosswalk->GetT()), 0.0f, 0.0f);
-          pivot.TransformPoint(v);
-          // restore pivot position and orientation
-          pivot = base;
-          pivot.location = v;
-          pivot.rotation.yaw -= geom::Math::ToDegrees<float>(static_cast<float>(crosswalk->GetHeading()));
-
-          // calculate all the corners
-          for (auto corner : crosswalk->GetPoints()) {
-            geom::Vector3D v2(
-                static_cast<float>(corner.u),
-                static_cast<float>(corner.v),
-                static_cast<float>(corner.z));
-            // set the width larger to contact with the sidewalk (in case they have gutter area)
-            if (corner.u < 0) {
-              v2.x -= 1.0f;
-            } else {
-              v2.x += 1.0f;
-            }
-            pivot.TransformPoint(v2);
-            result.push_back(v2);
-          }
-        }
-      }
-    }
-    return result;
+    return _crosswalk_zones;
   }
 
   // ===========================================================================
@@ -589,6 +594,31 @@ namespace road {
   std::vector<Waypoint> Map::GenerateWaypoints(const double distance) const {
     RELEASE_ASSERT(distance > 0.0);
     std::vector<Waypoint> result;
+    // The result easily reaches millions of waypoints on a dense map and
+    // growing the vector dominates the call otherwise; the count is plain
+    // per-section arithmetic, no geometry involved.
+    size_t expected = 0u;
+    for (const auto &pair : _data.GetRoads()) {
+      const auto &road = pair.second;
+      const double length = road.GetLength() - EPSILON;
+      for (const auto &lane_section : road.GetLaneSections()) {
+        const double begin = std::max(lane_section.GetDistance(), EPSILON);
+        const double end = std::min(lane_section.GetDistance() + lane_section.GetLength(), length);
+        if (end <= begin) {
+          continue;
+        }
+        size_t drivable_lanes = 0u;
+        for (const auto &lane : lane_section.GetLanes()) {
+          if ((lane.first != 0) &&
+              ((static_cast<uint32_t>(lane.second.GetType()) &
+                static_cast<uint32_t>(Lane::LaneType::Driving)) > 0)) {
+            ++drivable_lanes;
+          }
+        }
+        expected += drivable_lanes * (1u + static_cast<size_t>((end - begin) / distance));
+      }
+    }
+    result.reserve(expected);
     for (const auto &pair : _data.GetRoads()) {
       const auto &road = pair.second;
       for (double s = EPSILON; s < (road.GetLength() - EPSILON); s += distance) {
@@ -815,7 +845,9 @@ namespace road {
     }
   }
 
-  void Map::CreateRtree() {
+  void Map::GenerateLaneSegments(
+      Waypoint lane_start_waypoint,
+      std::vector<Rtree::TreeElement> &rtree_elements) {
     const double epsilon = 0.000001; // small delta in the road (set to 1
                                      // micrometer to prevent numeric errors)
     const double min_delta_s = 1;    // segments of minimum 1m through the road
@@ -825,6 +857,87 @@ namespace road {
     // maximum distance of a segment
     constexpr double max_segment_length = 100.0;
 
+    auto current_waypoint = lane_start_waypoint;
+
+    const Lane &lane = GetLane(current_waypoint);
+
+    geom::Transform current_transform = ComputeTransform(current_waypoint);
+
+    // Save computation time in straight lines
+    if (lane.IsStraight()) {
+      double delta_s = min_delta_s;
+      double remaining_length =
+          GetRemainingLength(lane, current_waypoint.s);
+      remaining_length -= epsilon;
+      delta_s = remaining_length;
+      if (delta_s < epsilon) {
+        return;
+      }
+      auto next = GetNext(current_waypoint, delta_s);
+
+      RELEASE_ASSERT(next.size() == 1);
+      RELEASE_ASSERT(next.front().road_id == current_waypoint.road_id);
+      auto next_waypoint = next.front();
+
+      AddElementToRtreeAndUpdateTransforms(
+          rtree_elements,
+          current_transform,
+          current_waypoint,
+          next_waypoint);
+      // end of lane
+    } else {
+      auto next_waypoint = current_waypoint;
+
+      // Loop until the end of the lane
+      // Advance in small s-increments
+      while (true) {
+        double delta_s = min_delta_s;
+        double remaining_length =
+            GetRemainingLength(lane, next_waypoint.s);
+        remaining_length -= epsilon;
+        delta_s = std::min(delta_s, remaining_length);
+
+        if (delta_s < epsilon) {
+          AddElementToRtreeAndUpdateTransforms(
+              rtree_elements,
+              current_transform,
+              current_waypoint,
+              next_waypoint);
+          break;
+        }
+
+        auto next = GetNext(next_waypoint, delta_s);
+        if (next.size() != 1 ||
+        current_waypoint.section_id != next.front().section_id) {
+          AddElementToRtreeAndUpdateTransforms(
+              rtree_elements,
+              current_transform,
+              current_waypoint,
+              next_waypoint);
+          break;
+        }
+
+        next_waypoint = next.front();
+        geom::Transform next_transform = ComputeTransform(next_waypoint);
+        double angle = geom::Math::GetVectorAngle(
+            current_transform.GetForwardVector(), next_transform.GetForwardVector());
+
+        if (std::abs(angle) > angle_threshold ||
+            std::abs(current_waypoint.s - next_waypoint.s) > max_segment_length) {
+          AddElementToRtree(
+              rtree_elements,
+              current_transform,
+              next_transform,
+              current_waypoint,
+              next_waypoint);
+          current_waypoint = next_waypoint;
+          current_transform = next_transform;
+        }
+      }
+    }
+  }
+
+  void Map::CreateRtree() {
     // Generate waypoints at start of every lane
     std::vector<Waypoint> topology;
     for (const auto &pair : _data.GetRoads()) {
@@ -836,101 +949,145 @@ namespace road {
       });
     }
 
+    // Sampling a lane only reads the road map, so lanes can be processed
+    // independently; fan chunks of them out over a local pool and bulk-load
+    // the tree from the combined result.
+    const size_t num_workers = std::max<size_t>(1u, std::thread::hardware_concurrency());
+    const size_t chunk_size =
+        std::max<size_t>(1u, topology.size() / (num_workers * 4u));
+    const size_t num_chunks = (topology.size() + chunk_size - 1u) / chunk_size;
+
+    std::vector<std::vector<Rtree::TreeElement>> chunk_elements(num_chunks);
+    TaskScheduler scheduler(num_workers);
+    scheduler.AsyncRun();
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(num_chunks);
+    for (size_t chunk = 0u; chunk < num_chunks; ++chunk) {
+      const size_t begin = chunk * chunk_size;
+      const size_t end = std::min(begin + chunk_size, topology.size());
+      chunks.emplace_back(scheduler.Post([this, &topology, &chunk_elements, chunk, begin, end]() {
+        for (size_t i = begin; i < end; ++i) {
+          GenerateLaneSegments(topology[i], chunk_elements[chunk]);
+        }
+      }));
+    }
+    for (auto &chunk : chunks) {
+      chunk.get();
+    }
+
     // Container of segments and waypoints
     std::vector<Rtree::TreeElement> rtree_elements;
-    // Loop through all lanes
-    for (auto &waypoint : topology) {
-      auto &lane_start_waypoint = waypoint;
+    size_t total_elements = 0u;
+    for (const auto &elements : chunk_elements) {
+      total_elements += elements.size();
+    }
+    rtree_elements.reserve(total_elements);
+    for (auto &elements : chunk_elements) {
+      rtree_elements.insert(
+          rtree_elements.end(),
+          std::make_move_iterator(elements.begin()),
+          std::make_move_iterator(elements.end()));
+    }
 
-      auto current_waypoint = lane_start_waypoint;
+    // Add segments to Rtree
+    _rtree.BuildFromElements(rtree_elements);
+  }
 
-      const Lane &lane = GetLane(current_waypoint);
+  Junction* Map::GetJunction(JuncId id) {
+    return _data.GetJunction(id);
+  }
 
-      geom::Transform current_transform = ComputeTransform(current_waypoint);
+  const Junction* Map::GetJunction(JuncId id) const {
+    return _data.GetJunction(id);
+  }
 
-      // Save computation time in straight lines
-      if (lane.IsStraight()) {
-        double delta_s = min_delta_s;
-        double remaining_length =
-            GetRemainingLength(lane, current_waypoint.s);
-        remaining_length -= epsilon;
-        delta_s = remaining_length;
-        if (delta_s < epsilon) {
-          continue;
+  /// Runs @a task(i) for every i in [0, @a size) over a local pool; mesh
+  /// generation and other per-road work only read the map, so the items can
+  /// be processed in any order as long as results are merged by index.
+  template <typename FuncT>
+  static void ParallelFor(const size_t size, FuncT &&task) {
+    const size_t num_workers = std::max<size_t>(1u, std::thread::hardware_concurrency());
+    const size_t chunk_size = std::max<size_t>(1u, size / (num_workers * 4u));
+    TaskScheduler scheduler(num_workers);
+    scheduler.AsyncRun();
+    std::vector<std::future<void>> chunks;
+    chunks.reserve(size / chunk_size + 1u);
+    for (size_t begin = 0u; begin < size; begin += chunk_size) {
+      const size_t end = std::min(begin + chunk_size, size);
+      chunks.emplace_back(scheduler.Post([&task, begin, end]() {
+        for (size_t i = begin; i < end; ++i) {
+          task(i);
         }
-        auto next = GetNext(current_waypoint, delta_s);
-
-        RELEASE_ASSERT(next.size() == 1);
-        RELEASE_ASSERT(next.front().road_id == current_waypoint.road_id);
-        auto next_waypoint = next.front();
-
-        AddElementToRtreeAndUpdateTransforms(
-            rtree_elements,
-            current_transform,
-            current_waypoint,
-            next_waypoint);
-        // end of lane
-      } else {
-        auto next_waypoint = current_waypoint;
-
-        // Loop until the end of the lane
-        // Advance in small s-increments
-        while (true) {
-          double delta_s = min_delta_s;
-          double remaining_length =
-              GetRemainingLength(lane, next_waypoint.s);
-          remaining_length -= epsilon;
-          delta_s = std::min(delta_s, remaining_length);
-
-          if (delta_s < epsilon) {
-            AddElementToRtreeAndUpdateTransforms(
-                rtree_elements,
-                current_transform,
-                current_waypoint,
-                next_waypoint);
-            break;
-          }
+      }));
+    }
+    for (auto &chunk : chunks) {
+      chunk.get();
+    }
+  }
 
-          auto next = GetNext(next_waypoint, delta_s);
-          if (next.size() != 1 ||
-          current_waypoint.section_id != next.front().section_id) {
-            AddElementToRtreeAndUpdateTransforms(
-                rtree_elements,
-                current_transform,
-                current_waypoint,
-                next_waypoint);
-            break;
+  void Map::CreateCrosswalkZones() {
+    // Only a few roads declare crosswalks, extract their zones in parallel
+    // and merge the corners in the original iteration order.
+    std::vector<std::pair<RoadId, const Road *>> roads;
+    for (const auto &pair : _data.GetRoads()) {
+      if (!pair.second.GetInfos<RoadInfoCrosswalk>().empty()) {
+        roads.emplace_back(pair.first, &pair.second);
+      }
+    }
+    std::vector<std::vector<geom::Location>> zones(roads.size());
+    ParallelFor(roads.size(), [&](const size_t i) {
+      const auto &road = *roads[i].second;
+      auto &result = zones[i];
+      for (auto crosswalk : road.GetInfos<RoadInfoCrosswalk>()) {
+        // waypoint only at start position
+        Waypoint waypoint;
+        geom::Transform base;
+        for (const auto &section : road.GetLaneSectionsAt(crosswalk->GetS())) {
+          // get the section with the center lane
+          for (const auto &lane : section.GetLanes()) {
+            // is the center line
+            if (lane.first == 0) {
+              // get the center point
+              waypoint.road_id = roads[i].first;
+              waypoint.section_id = section.GetId();
+              waypoint.lane_id = 0;
+              waypoint.s = crosswalk->GetS();
+              base = ComputeTransform(waypoint);
+            }
           }
+        }
 
-          next_waypoint = next.front();
-          geom::Transform next_transform = ComputeTransform(next_waypoint);
-          double angle = geom::Math::GetVectorAngle(
-              current_transform.GetForwardVector(), next_transform.GetForwardVector());
-
-          if (std::abs(angle) > angle_threshold ||
-              std::abs(current_waypoint.s - next_waypoint.s) > max_segment_length) {
-            AddElementToRtree(
-                rtree_elements,
-                current_transform,
-                next_transform,
-                current_waypoint,
-                next_waypoint);
-            current_waypoint = next_waypoint;
-            current_transform = next_transform;
+        // move perpendicular ('t')
+        geom::Transform pivot = base;
+        pivot.rotation.yaw -= geom::Math::ToDegrees<float>(static_cast<float>(crosswalk->GetHeading()));
+        pivot.rotation.yaw -= 90;   // move perpendicular to 's' for the lateral offset
+        geom::Vector3D v(static_cast<float>(crosswalk->GetT()), 0.0f, 0.0f);
+        pivot.TransformPoint(v);
+        // restore pivot position and orientation
+        pivot = base;
+        pivot.location = v;
+        pivot.rotation.yaw -= geom::Math::ToDegrees<float>(static_cast<float>(crosswalk->GetHeading()));
+
+        // calculate all the corners
+        for (auto corner : crosswalk->GetPoints()) {
+          geom::Vector3D v2(
+              static_cast<float>(corner.u),
+              static_cast<float>(corner.v),
+              static_cast<float>(corner.z));
+          // set the width larger to contact with the sidewalk (in case they have gutter area)
+          if (corner.u < 0) {
+            v2.x -= 1.0f;
+          } else {
+            v2.x += 1.0f;
           }
+          pivot.TransformPoint(v2);
+          result.push_back(v2);
         }
       }
+    });
+    for (auto &zone : zones) {
+      _crosswalk_zones.insert(_crosswalk_zones.end(), zone.begin(), zone.end());
     }
-    // Add segments to Rtree
-    _rtree.InsertElements(rtree_elements);
-  }
-
-  Junction* Map::GetJunction(JuncId id) {
-    return _data.GetJunction(id);
-  }
-
-  const Junction* Map::GetJunction(JuncId id) const {
-    return _data.GetJunction(id);
   }
 
   geom::Mesh Map::GenerateMesh(
@@ -944,18 +1101,32 @@ namespace road {
     mesh_factory.road_param.resolution = static_cast<float>(distance);
     mesh_factory.road_param.extra_lane_width = extra_width;
 
-    // Generate roads outside junctions
+    // Generate roads outside junctions in parallel, merging the meshes in
+    // the original iteration order.
+    std::vector<const Road *> roads;
     for (auto &&pair : _data.GetRoads()) {
       const auto &road = pair.second;
       if (road.IsJunction()) {
         continue;
       }
-      out_mesh += *mesh_factory.Generate(road);
+      roads.push_back(&road);
+    }
+    std::vector<std::unique_ptr<geom::Mesh>> road_meshes(roads.size());
+    ParallelFor(roads.size(), [&](const size_t i) {
+      road_meshes[i] = mesh_factory.Generate(*roads[i]);
+    });
+    for (const auto &road_mesh : road_meshes) {
+      out_mesh += *road_mesh;
     }
 
-    // Generate roads within junctions and smooth them
+    // Generate roads within junctions and smooth them, one junction per task
+    std::vector<const Junction *> junctions;
     for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+      junctions.push_back(&junc_pair.second);
+    }
+    std::vector<geom::Mesh> junction_meshes(junctions.size());
+    ParallelFor(junctions.size(), [&](const size_t j) {
+      const auto &junction = *junctions[j];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
         const auto &connection = connection_pair.second;
@@ -967,41 +1138,46 @@ namespace road {
         }
       }
       if(smooth_junctions) {
-        out_mesh += *mesh_factory.MergeAndSmooth(lane_meshes);
+        junction_meshes[j] = std::move(*mesh_factory.MergeAndSmooth(lane_meshes));
       } else {
         geom::Mesh junction_mesh;
         for(auto& lane : lane_meshes) {
           junction_mesh += *lane;
         }
-        out_mesh += junction_mesh;
+        junction_meshes[j] = std::move(junction_mesh);
       }
+    });
+    for (const auto &junction_mesh : junction_meshes) {
+      out_mesh += junction_mesh;
     }
 
     return out_mesh;
   }
 
-  std::vector<std::unique_ptr<geom::Mesh>> Map::GenerateChunkedMesh(
-      const rpc::OpendriveGenerationParameters& params) const {
+  std::vector<std::unique_ptr<geom::Mesh>> Map::GenerateMeshChunks(
+      const rpc::OpendriveGenerationParameters &params,
+      const std::vector<const Road *> &roads,
+      const std::vector<const Junction *> &junctions) const {
     geom::MeshFactory mesh_factory(params);
     std::vector<std::unique_ptr<geom::Mesh>> out_mesh_list;
 
-    std::unordered_map<JuncId, geom::Mesh> junction_map;
-    for (auto &&pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      if (!road.IsJunction()) {
-        std::vector<std::unique_ptr<geom::Mesh>> road_mesh_list =
-            mesh_factory.GenerateAllWithMaxLen(road);
-
-        out_mesh_list.insert(
-            out_mesh_list.end(),
-            std::make_move_iterator(road_mesh_list.begin()),
-            std::make_move_iterator(road_mesh_list.end()));
-      }
+    // Generate roads outside junctions in parallel, merging the mesh lists
+    // in the original iteration order.
+    std::vector<std::vector<std::unique_ptr<geom::Mesh>>> road_mesh_lists(roads.size());
+    ParallelFor(roads.size(), [&](const size_t i) {
+      road_mesh_lists[i] = mesh_factory.GenerateAllWithMaxLen(*roads[i]);
+    });
+    for (auto &road_mesh_list : road_mesh_lists) {
+      out_mesh_list.insert(
+          out_mesh_list.end(),
+          std::make_move_iterator(road_mesh_list.begin()),
+          std::make_move_iterator(road_mesh_list.end()));
     }
 
-    // Generate roads within junctions and smooth them
-    for (const auto &junc_pair : _data.GetJunctions()) {
-      const auto &junction = junc_pair.second;
+    // Generate roads within junctions and smooth them, one junction per task
+    std::vector<std::unique_ptr<geom::Mesh>> junction_meshes(junctions.size());
+    ParallelFor(junctions.size(), [&](const size_t j) {
+      const auto &junction = *junctions[j];
       std::vector<std::unique_ptr<geom::Mesh>> lane_meshes;
       std::vector<std::unique_ptr<geom::Mesh>> sidewalk_lane_meshes;
       for(const auto &connection_pair : junction.GetConnections()) {
@@ -1023,7 +1199,7 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *merged_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(merged_mesh));
+        junction_meshes[j] = std::move(merged_mesh);
       } else {
         std::unique_ptr<geom::Mesh> junction_mesh = std::make_unique<geom::Mesh>();
         for(auto& lane : lane_meshes) {
@@ -1032,9 +1208,30 @@ namespace road {
         for(auto& lane : sidewalk_lane_meshes) {
           *junction_mesh += *lane;
         }
-        out_mesh_list.push_back(std::move(junction_mesh));
+        junction_meshes[j] = std::move(junction_mesh);
       }
+    });
+    for (auto &junction_mesh : junction_meshes) {
+      out_mesh_list.push_back(std::move(junction_mesh));
+    }
+
+    return out_mesh_list;
+  }
+
+  std::vector<std::unique_ptr<geom::Mesh>> Map::GenerateChunkedMesh(
+      const rpc::OpendriveGenerationParameters& params) const {
+    std::vector<const Road *> roads;
+    for (auto &&pair : _data.GetRoads()) {
+      const auto &road = pair.second;
+      if (!road.IsJunction()) {
+        roads.push_back(&road);
+      }
+    }
+    std::vector<const Junction *> junctions;
+    for (const auto &junc_pair : _data.GetJunctions()) {
+      junctions.push_back(&junc_pair.second);
     }
+    auto out_mesh_list = GenerateMeshChunks(params, roads, junctions);
 
     auto min_pos = geom::Vector2D(
         out_mesh_list.front()->GetVertices().front().x,
@@ -1064,6 +1261,112 @@ namespace road {
     return result;
   }
 
+  Map::MeshTileId Map::GetMeshTileId(
+      const geom::Location &location,
+      const double tile_size) {
+    DEBUG_ASSERT(tile_size > 0.0);
+    return {
+        static_cast<int32_t>(std::floor(location.x / tile_size)),
+        static_cast<int32_t>(std::floor(location.y / tile_size))};
+  }
+
+  /// Returns the tile side to use for @a params.
+  static double GetTileSize(const rpc::OpendriveGenerationParameters &params) {
+    return params.tile_size > 0.0 ? params.tile_size : params.max_road_length;
+  }
+
+  /// True when @a road comes within one tile of @a tile. The reference line
+  /// is sampled every half tile; the one tile margin absorbs the lane width
+  /// and the assignment of each chunk to the tile of its first vertex.
+  static bool RoadTouchesTile(
+      const Road &road,
+      const Map::MeshTileId tile,
+      const double tile_size) {
+    const double step = 0.5 * tile_size;
+    const double length = road.GetLength();
+    for (double s = 0.0; s < length + step; s += step) {
+      const auto point = road.GetDirectedPointIn(std::min(s, length));
+      const auto sample = Map::GetMeshTileId(point.location, tile_size);
+      if (std::abs(sample.first - tile.first) <= 1 &&
+          std::abs(sample.second - tile.second) <= 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::map<Map::MeshTileId, std::unique_ptr<geom::Mesh>> Map::GenerateTiledMesh(
+      const rpc::OpendriveGenerationParameters &params) const {
+    const double tile_size = GetTileSize(params);
+    std::vector<const Road *> roads;
+    for (auto &&pair : _data.GetRoads()) {
+      const auto &road = pair.second;
+      if (!road.IsJunction()) {
+        roads.push_back(&road);
+      }
+    }
+    std::vector<const Junction *> junctions;
+    for (const auto &junc_pair : _data.GetJunctions()) {
+      junctions.push_back(&junc_pair.second);
+    }
+    auto chunks = GenerateMeshChunks(params, roads, junctions);
+
+    std::map<MeshTileId, std::unique_ptr<geom::Mesh>> result;
+    for (auto &chunk : chunks) {
+      if (chunk == nullptr || chunk->GetVertices().empty()) {
+        continue;
+      }
+      // Each chunk goes to the tile of its first vertex, like the grid of
+      // GenerateChunkedMesh.
+      const auto id = GetMeshTileId(chunk->GetVertices().front(), tile_size);
+      auto &tile_mesh = result[id];
+      if (tile_mesh == nullptr) {
+        tile_mesh = std::make_unique<geom::Mesh>();
+      }
+      *tile_mesh += *chunk;
+    }
+    return result;
+  }
+
+  std::unique_ptr<geom::Mesh> Map::GenerateTileMesh(
+      const rpc::OpendriveGenerationParameters &params,
+      const MeshTileId tile) const {
+    const double tile_size = GetTileSize(params);
+
+    // Mesh only the roads and junctions that can reach the tile, the rest
+    // of the map never leaves the road data.
+    std::vector<const Road *> roads;
+    for (auto &&pair : _data.GetRoads()) {
+      const auto &road = pair.second;
+      if (!road.IsJunction() && RoadTouchesTile(road, tile, tile_size)) {
+        roads.push_back(&road);
+      }
+    }
+    std::vector<const Junction *> junctions;
+    for (const auto &junc_pair : _data.GetJunctions()) {
+      const auto &junction = junc_pair.second;
+      for (const auto &connection_pair : junction.GetConnections()) {
+        const auto &road = _data.GetRoads().at(connection_pair.second.connecting_road);
+        if (RoadTouchesTile(road, tile, tile_size)) {
+          junctions.push_back(&junction);
+          break;
+        }
+      }
+    }
+
+    auto chunks = GenerateMeshChunks(params, roads, junctions);
+    auto result = std::make_unique<geom::Mesh>();
+    for (auto &chunk : chunks) {
+      if (chunk == nullptr || chunk->GetVertices().empty()) {
+        continue;
+      }
+      if (GetMeshTileId(chunk->GetVertices().front(), tile_size) == tile) {
+        *result += *chunk;
+      }
+    }
+    return result;
+  }
+
   geom::Mesh Map::GetAllCrosswalkMesh() const {
     geom::Mesh out_mesh;
 
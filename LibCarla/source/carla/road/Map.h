@@ -19,6 +19,7 @@
 
 #include <boost/optional.hpp>
 
+#include <map>
 #include <vector>
 
 namespace carla {
@@ -35,6 +36,7 @@ namespace road {
 
     Map(MapData m) : _data(std::move(m)) {
       CreateRtree();
+      CreateCrosswalkZones();
     }
 
     /// ========================================================================
@@ -53,6 +55,15 @@ namespace road {
         const geom::Location &location,
         uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
 
+    /// Batched version of GetClosestWaypointOnRoad. @a hints may be empty or
+    /// hold the waypoint each location projected to on a previous tick; a
+    /// hinted query is first projected along its hinted lane and only falls
+    /// back to the R-tree when the location has left that lane.
+    std::vector<boost::optional<element::Waypoint>> GetClosestWaypointsOnRoad(
+        const std::vector<geom::Location> &locations,
+        const std::vector<boost::optional<element::Waypoint>> &hints = {},
+        uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
+
     boost::optional<element::Waypoint> GetWaypoint(
         const geom::Location &location,
         uint32_t lane_type = static_cast<uint32_t>(Lane::LaneType::Driving)) const;
@@ -159,6 +170,29 @@ namespace road {
     std::vector<std::unique_ptr<geom::Mesh>> GenerateChunkedMesh(
         const rpc::OpendriveGenerationParameters& params) const;
 
+    /// Identifies one square tile of the tiled mesh generation. The id is
+    /// the tile's world position divided by the tile size, so for a given
+    /// map and tile size it is stable no matter which tiles get generated.
+    using MeshTileId = std::pair<int32_t, int32_t>;
+
+    /// Return the id of the tile of @a tile_size meters containing
+    /// @a location.
+    static MeshTileId GetMeshTileId(const geom::Location &location, double tile_size);
+
+    /// Buids the whole map as one mesh per tile, keyed by tile id. The tile
+    /// side comes from @a params tile_size, falling back to max_road_length
+    /// when it is not set.
+    std::map<MeshTileId, std::unique_ptr<geom::Mesh>> GenerateTiledMesh(
+        const rpc::OpendriveGenerationParameters& params) const;
+
+    /// Buids only the tile @a tile, meshing just the roads and junctions
+    /// that can reach it, so tiles near the vehicles can be generated
+    /// lazily without paying for the whole map. The returned mesh matches
+    /// the one GenerateTiledMesh produces for the same id.
+    std::unique_ptr<geom::Mesh> GenerateTileMesh(
+        const rpc::OpendriveGenerationParameters& params,
+        MeshTileId tile) const;
+
     /// Buids a mesh of all crosswalks based on the OpenDRIVE
     geom::Mesh GetAllCrosswalkMesh() const;
 
@@ -188,6 +222,32 @@ private:
 
     void CreateRtree();
 
+    /// Extract the crosswalk zones of every road, done once at
+    /// construction so the queries just return the cached list.
+    void CreateCrosswalkZones();
+
+    std::vector<geom::Location> _crosswalk_zones;
+
+    /// Generate the raw per-road and per-junction mesh chunks of
+    /// GenerateChunkedMesh for the given subset of the map.
+    std::vector<std::unique_ptr<geom::Mesh>> GenerateMeshChunks(
+        const rpc::OpendriveGenerationParameters &params,
+        const std::vector<const Road *> &roads,
+        const std::vector<const Junction *> &junctions) const;
+
+    /// Project @a location along the lane of @a hint; returns empty when the
+    /// location no longer lies on that lane and the R-tree must be queried.
+    boost::optional<element::Waypoint> ProjectOntoHintedLane(
+        const geom::Location &location,
+        Waypoint hint,
+        uint32_t lane_type) const;
+
+    /// Sample one lane into rtree segments, starting from the waypoint at
+    /// the entrance of the lane.
+    void GenerateLaneSegments(
+        Waypoint lane_start_waypoint,
+        std::vector<Rtree::TreeElement> &rtree_elements);
+
     /// Helper Functions for constructing the rtree element list
     void AddElementToRtree(
         std::vector<Rtree::TreeElement> &rtree_elements,
@@ -46,6 +46,16 @@ namespace road {
     for (auto &&info : _temp_lane_info_container) {
       DEBUG_ASSERT(info.first != nullptr);
       info.first->_info = InformationSet(std::move(info.second));
+
+      // Pack the piecewise width polynomial of the lane next to its
+      // breakpoints, so width evaluations read one contiguous table instead
+      // of the RoadInfo records.
+      auto width_infos = info.first->_info.GetInfos<element::RoadInfoLaneWidth>();
+      info.first->_width_table.reserve(width_infos.size());
+      for (const auto *width_info : width_infos) {
+        info.first->_width_table.push_back(
+            Lane::WidthRecord{width_info->GetDistance(), width_info->GetPolynomial()});
+      }
     }
 
     // compute transform requires the roads to have the RoadInfo
@@ -77,6 +87,7 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_ELEVATION_PROFILE, road->GetId(), s, a, b, c, d);
     auto elevation = std::make_unique<RoadInfoElevation>(s, a, b, c, d);
     _temp_road_info_container[road].emplace_back(std::move(elevation));
   }
@@ -95,6 +106,8 @@ namespace road {
       const double length,
       const std::vector<road::element::CrosswalkPoint> points) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_OBJECT_CROSSWALK,
+        road->GetId(), name, s, t, zOffset, hdg, pitch, roll, orientation, width, length, points);
     auto cross = std::make_unique<RoadInfoCrosswalk>(s, name, t, zOffset, hdg, pitch, roll, std::move(orientation), width, length, std::move(points));
     _temp_road_info_container[road].emplace_back(std::move(cross));
   }
@@ -105,6 +118,8 @@ namespace road {
       const double s,
       const std::string restriction) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_ACCESS,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, restriction);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneAccess>(s, restriction));
   }
 
@@ -116,6 +131,8 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_BORDER,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, a, b, c, d);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneBorder>(s, a, b, c, d));
   }
 
@@ -125,6 +142,8 @@ namespace road {
       const double inner,
       const double outer) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_HEIGHT,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, inner, outer);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneHeight>(s, inner, outer));
   }
 
@@ -135,6 +154,8 @@ namespace road {
       const double friction,
       const double roughness) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_MATERIAL,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, surface, friction, roughness);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneMaterial>(s, surface, friction,
         roughness));
   }
@@ -144,6 +165,8 @@ namespace road {
       const double s,
       const std::string value) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_RULE,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, value);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneRule>(s, value));
   }
 
@@ -155,6 +178,8 @@ namespace road {
       const double left,
       const double right) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_VISIBILITY,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, forward, back, left, right);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneVisibility>(s, forward, back,
         left, right));
   }
@@ -167,6 +192,8 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_WIDTH,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, a, b, c, d);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoLaneWidth>(s, a, b, c, d));
   }
 
@@ -184,6 +211,10 @@ namespace road {
       const std::string type_name,
       const double type_width) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_ROAD_MARK,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(),
+        static_cast<int32_t>(road_mark_id), s, type, weight, color, material, width, lane_change,
+        height, type_name, type_width);
     RoadInfoMarkRecord::LaneChange lc;
 
     StringUtil::ToLower(lane_change);
@@ -212,6 +243,9 @@ namespace road {
       const std::string rule,
       const double width) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_ROAD_MARK_TYPE_LINE,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(),
+        static_cast<int32_t>(road_mark_id), length, space, tOffset, s, rule, width);
     auto it = MakeRoadInfoIterator<RoadInfoMarkRecord>(_temp_lane_info_container[lane]);
     for (; !it.IsAtEnd(); ++it) {
       if (it->GetRoadMarkId() == road_mark_id) {
@@ -227,8 +261,10 @@ namespace road {
       Lane *lane,
       const double s,
       const double max,
-      const std::string /*unit*/) {
+      const std::string unit) {
     DEBUG_ASSERT(lane != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_LANE_SPEED,
+        lane->GetRoad()->GetId(), lane->GetLaneSection()->GetId(), lane->GetId(), s, max, unit);
     _temp_lane_info_container[lane].emplace_back(std::make_unique<RoadInfoSpeed>(s, max));
   }
 
@@ -253,6 +289,9 @@ namespace road {
         const double hOffset,
         const double pitch,
         const double roll) {
+      RecordSnapshot(MapSnapshotOp::ADD_SIGNAL,
+          road->GetId(), signal_id, s, t, name, dynamic, orientation, zOffset,
+          country, type, subtype, value, unit, height, width, text, hOffset, pitch, roll);
       _temp_signal_container[signal_id] = std::make_unique<Signal>(
           road->GetId(),
           signal_id,
@@ -274,7 +313,13 @@ namespace road {
           pitch,
           roll);
 
-      return AddSignalReference(road, signal_id, s, t, orientation);
+      // The reference below is part of this record already, don't record it
+      // a second time.
+      MapSnapshotWriter *writer = _snapshot_writer;
+      _snapshot_writer = nullptr;
+      auto road_info_signal = AddSignalReference(road, signal_id, s, t, orientation);
+      _snapshot_writer = writer;
+      return road_info_signal;
     }
 
     element::RoadInfoSignal* MapBuilder::AddSignalReference(
@@ -284,6 +329,8 @@ namespace road {
         const double t_position,
         const std::string signal_reference_orientation) {
 
+      RecordSnapshot(MapSnapshotOp::ADD_SIGNAL_REFERENCE,
+          road->GetId(), signal_id, s_position, t_position, signal_reference_orientation);
       const double epsilon = 0.00001;
       RELEASE_ASSERT(s_position >= 0.0);
       // Prevent s_position from being equal to the road length
@@ -300,6 +347,18 @@ namespace road {
         element::RoadInfoSignal* signal_reference,
         const LaneId from_lane,
         const LaneId to_lane) {
+      if (_snapshot_writer != nullptr) {
+        // Encode the reference as its insertion ordinal; the parsers always
+        // add validities to the reference they just created, so search from
+        // the back.
+        for (size_t i = _temp_signal_reference_container.size(); i > 0u; --i) {
+          if (_temp_signal_reference_container[i - 1u] == signal_reference) {
+            RecordSnapshot(MapSnapshotOp::ADD_VALIDITY_TO_SIGNAL_REFERENCE,
+                static_cast<uint64_t>(i - 1u), from_lane, to_lane);
+            break;
+          }
+        }
+      }
       signal_reference->_validities.emplace_back(LaneValidity(from_lane, to_lane));
     }
 
@@ -307,6 +366,7 @@ namespace road {
         const SignId signal_id,
         const std::string dependency_id,
         const std::string dependency_type) {
+      RecordSnapshot(MapSnapshotOp::ADD_DEPENDENCY_TO_SIGNAL, signal_id, dependency_id, dependency_type);
       _temp_signal_container[signal_id]->_dependencies.emplace_back(
           SignalDependency(dependency_id, dependency_type));
     }
@@ -320,6 +380,7 @@ namespace road {
         const RoadId predecessor,
         const RoadId successor)
     {
+      RecordSnapshot(MapSnapshotOp::ADD_ROAD, road_id, name, length, junction_id, predecessor, successor);
 
       // add it
       auto road = &(_map_data._roads.emplace(road_id, Road()).first->second);
@@ -342,6 +403,7 @@ namespace road {
       const SectionId id,
       const double s) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_SECTION, road->GetId(), id, s);
     carla::road::LaneSection &sec = road->_lane_sections.Emplace(id, s);
     sec._road = road;
     return &sec;
@@ -355,6 +417,8 @@ namespace road {
       const int32_t predecessor,
       const int32_t successor) {
     DEBUG_ASSERT(section != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_SECTION_LANE,
+        section->GetRoad()->GetId(), section->GetId(), lane_id, lane_type, lane_level, predecessor, successor);
 
     // add the lane
     auto *lane = &((section->_lanes.emplace(lane_id, Lane()).first)->second);
@@ -378,6 +442,7 @@ namespace road {
       const double hdg,
       const double length) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_GEOMETRY_LINE, road->GetId(), s, x, y, hdg, length);
     const geom::Location location(static_cast<float>(x), static_cast<float>(y), 0.0f);
     auto line_geometry = std::make_unique<GeometryLine>(
         s,
@@ -392,10 +457,11 @@ namespace road {
   void MapBuilder::CreateRoadSpeed(
       Road *road,
       const double s,
-      const std::string /*type*/,
+      const std::string type,
       const double max,
-      const std::string /*unit*/) {
+      const std::string unit) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_ROAD_SPEED, road->GetId(), s, type, max, unit);
     _temp_road_info_container[road].emplace_back(std::make_unique<RoadInfoSpeed>(s, max));
   }
 
@@ -407,6 +473,7 @@ namespace road {
       const double c,
       const double d) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::CREATE_SECTION_OFFSET, road->GetId(), s, a, b, c, d);
     _temp_road_info_container[road].emplace_back(std::make_unique<RoadInfoLaneOffset>(s, a, b, c, d));
   }
 
@@ -419,6 +486,7 @@ namespace road {
       const double length,
       const double curvature) {
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_GEOMETRY_ARC, road->GetId(), s, x, y, hdg, length, curvature);
     const geom::Location location(static_cast<float>(x), static_cast<float>(y), 0.0f);
     auto arc_geometry = std::make_unique<GeometryArc>(
         s,
@@ -442,6 +510,8 @@ namespace road {
       const double curvEnd) {
     //throw_exception(std::runtime_error("geometry spiral not supported"));
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_GEOMETRY_SPIRAL,
+        road->GetId(), s, x, y, hdg, length, curvStart, curvEnd);
     const geom::Location location(static_cast<float>(x), static_cast<float>(y), 0.0f);
     auto spiral_geometry = std::make_unique<GeometrySpiral>(
         s,
@@ -468,6 +538,8 @@ namespace road {
       const double d) {
     //throw_exception(std::runtime_error("geometry poly3 not supported"));
     DEBUG_ASSERT(road != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_GEOMETRY_POLY3,
+        road->GetId(), s, x, y, hdg, length, a, b, c, d);
     const geom::Location location(static_cast<float>(x), static_cast<float>(y), 0.0f);
     auto poly3_geometry = std::make_unique<GeometryPoly3>(
         s,
@@ -499,6 +571,8 @@ namespace road {
       const double dV,
       const std::string p_range) {
     //throw_exception(std::runtime_error("geometry poly3 not supported"));
+    RecordSnapshot(MapSnapshotOp::ADD_ROAD_GEOMETRY_PARAMPOLY3,
+        road->GetId(), s, x, y, hdg, length, aU, bU, cU, dU, aV, bV, cV, dV, p_range);
     bool arcLength;
     if(p_range == "arcLength"){
       arcLength = true;
@@ -526,6 +600,7 @@ namespace road {
   }
 
   void MapBuilder::AddJunction(const int32_t id, const std::string name) {
+    RecordSnapshot(MapSnapshotOp::ADD_JUNCTION, id, name);
     _map_data.GetJunctions().emplace(id, Junction(id, name));
   }
 
@@ -535,6 +610,7 @@ namespace road {
       const RoadId incoming_road,
       const RoadId connecting_road) {
     DEBUG_ASSERT(_map_data.GetJunction(junction_id) != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_CONNECTION, junction_id, connection_id, incoming_road, connecting_road);
     _map_data.GetJunction(junction_id)->GetConnections().emplace(connection_id,
         Junction::Connection(connection_id, incoming_road, connecting_road));
   }
@@ -545,6 +621,7 @@ namespace road {
       const LaneId from,
       const LaneId to) {
     DEBUG_ASSERT(_map_data.GetJunction(junction_id) != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_LANE_LINK, junction_id, connection_id, from, to);
     _map_data.GetJunction(junction_id)->GetConnection(connection_id)->AddLaneLink(from, to);
   }
 
@@ -552,6 +629,7 @@ namespace road {
       const JuncId junction_id,
       std::set<road::ContId>&& controllers) {
     DEBUG_ASSERT(_map_data.GetJunction(junction_id) != nullptr);
+    RecordSnapshot(MapSnapshotOp::ADD_JUNCTION_CONTROLLER, junction_id, controllers);
     _map_data.GetJunction(junction_id)->_controllers = std::move(controllers);
   }
 
@@ -567,6 +645,12 @@ namespace road {
     return &_map_data.GetRoad(road_id);
   }
 
+  void MapBuilder::SetGeoReference(const geom::GeoLocation &geo_reference) {
+    RecordSnapshot(MapSnapshotOp::SET_GEO_REFERENCE,
+        geo_reference.latitude, geo_reference.longitude, geo_reference.altitude);
+    _map_data._geo_reference = geo_reference;
+  }
+
   // return the pointer to a lane object
   Lane *MapBuilder::GetEdgeLanePointer(RoadId road_id, bool from_start, LaneId lane_id) {
 
@@ -869,6 +953,8 @@ void MapBuilder::CreateController(
   const uint32_t controller_sequence,
   const std::set<road::SignId>&& signals) {
 
+    RecordSnapshot(MapSnapshotOp::CREATE_CONTROLLER, controller_id, controller_name, controller_sequence, signals);
+
     // Add the Controller to MapData
     auto controller_pair = _map_data._controllers.emplace(
       std::make_pair(
@@ -895,6 +981,7 @@ void MapBuilder::CreateController(
     for (auto &junctionpair : map._data.GetJunctions()) {
       auto& junction = junctionpair.second;
       junction._road_conflicts = (map.ComputeJunctionConflicts(junction.GetId()));
+      junction.BuildConflictMatrix();
     }
   }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/MapSnapshot.h"
 #include "carla/road/element/RoadInfoCrosswalk.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
@@ -339,12 +340,29 @@ namespace road {
 
 
 
-    void SetGeoReference(const geom::GeoLocation &geo_reference) {
-      _map_data._geo_reference = geo_reference;
+    void SetGeoReference(const geom::GeoLocation &geo_reference);
+
+    /// Attach @a writer so every subsequent builder call gets recorded into a
+    /// map snapshot; pass nullptr to stop recording.
+    void SetSnapshotWriter(MapSnapshotWriter *writer) {
+      _snapshot_writer = writer;
+    }
+
+    /// Return the @a index -th signal reference added to this builder, in
+    /// insertion order; used by the snapshot replay to resolve references.
+    element::RoadInfoSignal *GetSignalReference(const size_t index) {
+      return _temp_signal_reference_container.at(index);
     }
 
   private:
 
+    template <typename... ArgsT>
+    void RecordSnapshot(const MapSnapshotOp op, const ArgsT &... args) {
+      if (_snapshot_writer != nullptr) {
+        _snapshot_writer->Record(op, args...);
+      }
+    }
+
     MapData _map_data;
 
     /// Create the pointers between RoadSegments based on the ids.
@@ -398,6 +416,9 @@ namespace road {
 
     std::vector<element::RoadInfoSignal*> _temp_signal_reference_container;
 
+    /// Snapshot recorder, attached while parsing an OpenDRIVE worth caching.
+    MapSnapshotWriter *_snapshot_writer = nullptr;
+
   };
 
 } // namespace road
@@ -0,0 +1,753 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/MapSnapshot.h"
+
+#include "carla/FileSystem.h"
+#include "carla/Logging.h"
+#include "carla/road/MapBuilder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace carla {
+namespace road {
+
+  static const uint32_t SNAPSHOT_MAGIC = 0x50414D43u; // "CMAP"
+  static const uint32_t SNAPSHOT_VERSION = 1u;
+
+  // ===========================================================================
+  // -- MapSnapshotWriter ------------------------------------------------------
+  // ===========================================================================
+
+  std::string MapSnapshotWriter::Finish() const {
+    std::string snapshot;
+    snapshot.reserve(sizeof(SNAPSHOT_MAGIC) + sizeof(SNAPSHOT_VERSION) + _payload.size());
+    snapshot.append(reinterpret_cast<const char *>(&SNAPSHOT_MAGIC), sizeof(SNAPSHOT_MAGIC));
+    snapshot.append(reinterpret_cast<const char *>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+    snapshot.append(_payload);
+    return snapshot;
+  }
+
+  void MapSnapshotWriter::WriteBytes(const void *data, size_t size) {
+    _payload.append(reinterpret_cast<const char *>(data), size);
+  }
+
+  void MapSnapshotWriter::WriteValue(const uint8_t value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void MapSnapshotWriter::WriteValue(const bool value) {
+    WriteValue(static_cast<uint8_t>(value ? 1u : 0u));
+  }
+
+  void MapSnapshotWriter::WriteValue(const int32_t value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void MapSnapshotWriter::WriteValue(const uint32_t value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void MapSnapshotWriter::WriteValue(const uint64_t value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void MapSnapshotWriter::WriteValue(const double value) {
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void MapSnapshotWriter::WriteValue(const std::string &value) {
+    WriteValue(static_cast<uint32_t>(value.size()));
+    WriteBytes(value.data(), value.size());
+  }
+
+  void MapSnapshotWriter::WriteValue(const std::vector<element::CrosswalkPoint> &value) {
+    WriteValue(static_cast<uint32_t>(value.size()));
+    for (const element::CrosswalkPoint &point : value) {
+      WriteValue(point.u);
+      WriteValue(point.v);
+      WriteValue(point.z);
+    }
+  }
+
+  void MapSnapshotWriter::WriteValue(const std::set<std::string> &value) {
+    WriteValue(static_cast<uint32_t>(value.size()));
+    for (const std::string &entry : value) {
+      WriteValue(entry);
+    }
+  }
+
+  // ===========================================================================
+  // -- Snapshot reader --------------------------------------------------------
+  // ===========================================================================
+
+  namespace {
+
+  /// Bounds-checked reader over a snapshot blob; any underflow marks the
+  /// reader as failed and subsequent reads return defaults.
+  class SnapshotReader {
+  public:
+
+    explicit SnapshotReader(const std::string &data)
+      : _data(data) {}
+
+    bool Failed() const {
+      return _failed;
+    }
+
+    bool IsAtEnd() const {
+      return _position >= _data.size();
+    }
+
+    bool CheckHeader() {
+      const uint32_t magic = ReadUInt32();
+      const uint32_t version = ReadUInt32();
+      return !_failed && magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION;
+    }
+
+    uint8_t ReadUInt8() {
+      uint8_t value = 0u;
+      ReadBytes(&value, sizeof(value));
+      return value;
+    }
+
+    bool ReadBool() {
+      return ReadUInt8() != 0u;
+    }
+
+    int32_t ReadInt32() {
+      int32_t value = 0;
+      ReadBytes(&value, sizeof(value));
+      return value;
+    }
+
+    uint32_t ReadUInt32() {
+      uint32_t value = 0u;
+      ReadBytes(&value, sizeof(value));
+      return value;
+    }
+
+    uint64_t ReadUInt64() {
+      uint64_t value = 0u;
+      ReadBytes(&value, sizeof(value));
+      return value;
+    }
+
+    double ReadDouble() {
+      double value = 0.0;
+      ReadBytes(&value, sizeof(value));
+      return value;
+    }
+
+    std::string ReadString() {
+      const uint32_t size = ReadUInt32();
+      if (_failed || size > _data.size() - _position) {
+        _failed = true;
+        return std::string();
+      }
+      std::string value(_data, _position, size);
+      _position += size;
+      return value;
+    }
+
+    std::vector<element::CrosswalkPoint> ReadCrosswalkPoints() {
+      const uint32_t count = ReadUInt32();
+      std::vector<element::CrosswalkPoint> points;
+      for (uint32_t i = 0u; i < count && !_failed; ++i) {
+        const double u = ReadDouble();
+        const double v = ReadDouble();
+        const double z = ReadDouble();
+        points.emplace_back(u, v, z);
+      }
+      return points;
+    }
+
+    std::set<std::string> ReadStringSet() {
+      const uint32_t count = ReadUInt32();
+      std::set<std::string> entries;
+      for (uint32_t i = 0u; i < count && !_failed; ++i) {
+        entries.insert(ReadString());
+      }
+      return entries;
+    }
+
+  private:
+
+    void ReadBytes(void *destination, size_t size) {
+      if (_failed || size > _data.size() - _position) {
+        _failed = true;
+        return;
+      }
+      std::memcpy(destination, _data.data() + _position, size);
+      _position += size;
+    }
+
+    const std::string &_data;
+    size_t _position = 0u;
+    bool _failed = false;
+  };
+
+  /// Replays every record of @a reader into @a builder. Returns false on a
+  /// corrupt stream.
+  bool ReplaySnapshot(SnapshotReader &reader, MapBuilder &builder) {
+    while (!reader.IsAtEnd()) {
+      const MapSnapshotOp op = static_cast<MapSnapshotOp>(reader.ReadUInt8());
+      if (reader.Failed()) {
+        return false;
+      }
+      switch (op) {
+        case MapSnapshotOp::SET_GEO_REFERENCE: {
+          const double latitude = reader.ReadDouble();
+          const double longitude = reader.ReadDouble();
+          const double altitude = reader.ReadDouble();
+          builder.SetGeoReference(geom::GeoLocation(latitude, longitude, altitude));
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD: {
+          const RoadId road_id = reader.ReadUInt32();
+          const std::string name = reader.ReadString();
+          const double length = reader.ReadDouble();
+          const JuncId junction_id = reader.ReadInt32();
+          const RoadId predecessor = reader.ReadUInt32();
+          const RoadId successor = reader.ReadUInt32();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoad(road_id, name, length, junction_id, predecessor, successor);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_SECTION: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadSection(builder.GetRoad(road_id), section_id, s);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_SECTION_LANE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const uint32_t lane_type = reader.ReadUInt32();
+          const bool lane_level = reader.ReadBool();
+          const LaneId predecessor = reader.ReadInt32();
+          const LaneId successor = reader.ReadInt32();
+          if (reader.Failed()) {
+            return false;
+          }
+          LaneSection &section = builder.GetRoad(road_id)->GetLaneSectionById(section_id);
+          builder.AddRoadSectionLane(&section, lane_id, lane_type, lane_level, predecessor, successor);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_GEOMETRY_LINE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double x = reader.ReadDouble();
+          const double y = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadGeometryLine(builder.GetRoad(road_id), s, x, y, hdg, length);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_GEOMETRY_ARC: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double x = reader.ReadDouble();
+          const double y = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          const double curvature = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadGeometryArc(builder.GetRoad(road_id), s, x, y, hdg, length, curvature);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_GEOMETRY_SPIRAL: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double x = reader.ReadDouble();
+          const double y = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          const double curve_start = reader.ReadDouble();
+          const double curve_end = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadGeometrySpiral(builder.GetRoad(road_id), s, x, y, hdg, length, curve_start, curve_end);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_GEOMETRY_POLY3: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double x = reader.ReadDouble();
+          const double y = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          const double a = reader.ReadDouble();
+          const double b = reader.ReadDouble();
+          const double c = reader.ReadDouble();
+          const double d = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadGeometryPoly3(builder.GetRoad(road_id), s, x, y, hdg, length, a, b, c, d);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_GEOMETRY_PARAMPOLY3: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double x = reader.ReadDouble();
+          const double y = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          const double aU = reader.ReadDouble();
+          const double bU = reader.ReadDouble();
+          const double cU = reader.ReadDouble();
+          const double dU = reader.ReadDouble();
+          const double aV = reader.ReadDouble();
+          const double bV = reader.ReadDouble();
+          const double cV = reader.ReadDouble();
+          const double dV = reader.ReadDouble();
+          const std::string p_range = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadGeometryParamPoly3(
+              builder.GetRoad(road_id), s, x, y, hdg, length, aU, bU, cU, dU, aV, bV, cV, dV, p_range);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_ELEVATION_PROFILE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double a = reader.ReadDouble();
+          const double b = reader.ReadDouble();
+          const double c = reader.ReadDouble();
+          const double d = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadElevationProfile(builder.GetRoad(road_id), s, a, b, c, d);
+          break;
+        }
+        case MapSnapshotOp::ADD_ROAD_OBJECT_CROSSWALK: {
+          const RoadId road_id = reader.ReadUInt32();
+          const std::string name = reader.ReadString();
+          const double s = reader.ReadDouble();
+          const double t = reader.ReadDouble();
+          const double zOffset = reader.ReadDouble();
+          const double hdg = reader.ReadDouble();
+          const double pitch = reader.ReadDouble();
+          const double roll = reader.ReadDouble();
+          const std::string orientation = reader.ReadString();
+          const double width = reader.ReadDouble();
+          const double length = reader.ReadDouble();
+          const std::vector<element::CrosswalkPoint> points = reader.ReadCrosswalkPoints();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddRoadObjectCrosswalk(
+              builder.GetRoad(road_id), name, s, t, zOffset, hdg, pitch, roll, orientation, width, length, points);
+          break;
+        }
+        case MapSnapshotOp::ADD_SIGNAL: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SignId signal_id = reader.ReadString();
+          const double s = reader.ReadDouble();
+          const double t = reader.ReadDouble();
+          const std::string name = reader.ReadString();
+          const std::string dynamic = reader.ReadString();
+          const std::string orientation = reader.ReadString();
+          const double zOffset = reader.ReadDouble();
+          const std::string country = reader.ReadString();
+          const std::string type = reader.ReadString();
+          const std::string subtype = reader.ReadString();
+          const double value = reader.ReadDouble();
+          const std::string unit = reader.ReadString();
+          const double height = reader.ReadDouble();
+          const double width = reader.ReadDouble();
+          const std::string text = reader.ReadString();
+          const double hOffset = reader.ReadDouble();
+          const double pitch = reader.ReadDouble();
+          const double roll = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddSignal(
+              builder.GetRoad(road_id), signal_id, s, t, name, dynamic, orientation, zOffset,
+              country, type, subtype, value, unit, height, width, text, hOffset, pitch, roll);
+          break;
+        }
+        case MapSnapshotOp::ADD_SIGNAL_REFERENCE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SignId signal_id = reader.ReadString();
+          const double s_position = reader.ReadDouble();
+          const double t_position = reader.ReadDouble();
+          const std::string orientation = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddSignalReference(builder.GetRoad(road_id), signal_id, s_position, t_position, orientation);
+          break;
+        }
+        case MapSnapshotOp::ADD_VALIDITY_TO_SIGNAL_REFERENCE: {
+          const uint64_t reference_index = reader.ReadUInt64();
+          const LaneId from_lane = reader.ReadInt32();
+          const LaneId to_lane = reader.ReadInt32();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddValidityToSignalReference(
+              builder.GetSignalReference(static_cast<size_t>(reference_index)), from_lane, to_lane);
+          break;
+        }
+        case MapSnapshotOp::ADD_DEPENDENCY_TO_SIGNAL: {
+          const SignId signal_id = reader.ReadString();
+          const std::string dependency_id = reader.ReadString();
+          const std::string dependency_type = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddDependencyToSignal(signal_id, dependency_id, dependency_type);
+          break;
+        }
+        case MapSnapshotOp::ADD_JUNCTION: {
+          const JuncId junction_id = reader.ReadInt32();
+          const std::string name = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddJunction(junction_id, name);
+          break;
+        }
+        case MapSnapshotOp::ADD_CONNECTION: {
+          const JuncId junction_id = reader.ReadInt32();
+          const ConId connection_id = reader.ReadUInt32();
+          const RoadId incoming_road = reader.ReadUInt32();
+          const RoadId connecting_road = reader.ReadUInt32();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddConnection(junction_id, connection_id, incoming_road, connecting_road);
+          break;
+        }
+        case MapSnapshotOp::ADD_LANE_LINK: {
+          const JuncId junction_id = reader.ReadInt32();
+          const ConId connection_id = reader.ReadUInt32();
+          const LaneId from = reader.ReadInt32();
+          const LaneId to = reader.ReadInt32();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddLaneLink(junction_id, connection_id, from, to);
+          break;
+        }
+        case MapSnapshotOp::ADD_JUNCTION_CONTROLLER: {
+          const JuncId junction_id = reader.ReadInt32();
+          std::set<ContId> controllers = reader.ReadStringSet();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.AddJunctionController(junction_id, std::move(controllers));
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_ACCESS: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const std::string restriction = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneAccess(lane, s, restriction);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_BORDER: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const double a = reader.ReadDouble();
+          const double b = reader.ReadDouble();
+          const double c = reader.ReadDouble();
+          const double d = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneBorder(lane, s, a, b, c, d);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_HEIGHT: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const double inner = reader.ReadDouble();
+          const double outer = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneHeight(lane, s, inner, outer);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_MATERIAL: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const std::string surface = reader.ReadString();
+          const double friction = reader.ReadDouble();
+          const double roughness = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneMaterial(lane, s, surface, friction, roughness);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_RULE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const std::string value = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneRule(lane, s, value);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_VISIBILITY: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const double forward = reader.ReadDouble();
+          const double back = reader.ReadDouble();
+          const double left = reader.ReadDouble();
+          const double right = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneVisibility(lane, s, forward, back, left, right);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_WIDTH: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const double a = reader.ReadDouble();
+          const double b = reader.ReadDouble();
+          const double c = reader.ReadDouble();
+          const double d = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneWidth(lane, s, a, b, c, d);
+          break;
+        }
+        case MapSnapshotOp::CREATE_ROAD_MARK: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const int32_t road_mark_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const std::string type = reader.ReadString();
+          const std::string weight = reader.ReadString();
+          const std::string color = reader.ReadString();
+          const std::string material = reader.ReadString();
+          const double width = reader.ReadDouble();
+          const std::string lane_change = reader.ReadString();
+          const double height = reader.ReadDouble();
+          const std::string type_name = reader.ReadString();
+          const double type_width = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateRoadMark(
+              lane, road_mark_id, s, type, weight, color, material, width, lane_change, height,
+              type_name, type_width);
+          break;
+        }
+        case MapSnapshotOp::CREATE_ROAD_MARK_TYPE_LINE: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const int32_t road_mark_id = reader.ReadInt32();
+          const double length = reader.ReadDouble();
+          const double space = reader.ReadDouble();
+          const double tOffset = reader.ReadDouble();
+          const double s = reader.ReadDouble();
+          const std::string rule = reader.ReadString();
+          const double width = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateRoadMarkTypeLine(lane, road_mark_id, length, space, tOffset, s, rule, width);
+          break;
+        }
+        case MapSnapshotOp::CREATE_LANE_SPEED: {
+          const RoadId road_id = reader.ReadUInt32();
+          const SectionId section_id = reader.ReadUInt32();
+          const LaneId lane_id = reader.ReadInt32();
+          const double s = reader.ReadDouble();
+          const double max = reader.ReadDouble();
+          const std::string unit = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          Lane *lane = builder.GetRoad(road_id)->GetLaneSectionById(section_id).GetLane(lane_id);
+          builder.CreateLaneSpeed(lane, s, max, unit);
+          break;
+        }
+        case MapSnapshotOp::CREATE_ROAD_SPEED: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const std::string type = reader.ReadString();
+          const double max = reader.ReadDouble();
+          const std::string unit = reader.ReadString();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.CreateRoadSpeed(builder.GetRoad(road_id), s, type, max, unit);
+          break;
+        }
+        case MapSnapshotOp::CREATE_SECTION_OFFSET: {
+          const RoadId road_id = reader.ReadUInt32();
+          const double s = reader.ReadDouble();
+          const double a = reader.ReadDouble();
+          const double b = reader.ReadDouble();
+          const double c = reader.ReadDouble();
+          const double d = reader.ReadDouble();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.CreateSectionOffset(builder.GetRoad(road_id), s, a, b, c, d);
+          break;
+        }
+        case MapSnapshotOp::CREATE_CONTROLLER: {
+          const ContId controller_id = reader.ReadString();
+          const std::string controller_name = reader.ReadString();
+          const uint32_t controller_sequence = reader.ReadUInt32();
+          std::set<SignId> signals = reader.ReadStringSet();
+          if (reader.Failed()) {
+            return false;
+          }
+          builder.CreateController(controller_id, controller_name, controller_sequence, std::move(signals));
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return !reader.Failed();
+  }
+
+  } // namespace
+
+  // ===========================================================================
+  // -- MapSnapshot ------------------------------------------------------------
+  // ===========================================================================
+
+  std::string MapSnapshot::GetCachedSnapshotPath(const std::string &opendrive) {
+    std::string cache_dir;
+    const char *env_dir = std::getenv("CARLA_MAP_CACHE_DIR");
+    if (env_dir != nullptr) {
+      cache_dir = env_dir;
+      if (cache_dir.empty()) {
+        return std::string(); // caching disabled
+      }
+    } else {
+      const char *home = std::getenv("HOME");
+      if (home == nullptr) {
+        home = std::getenv("USERPROFILE");
+      }
+      if (home == nullptr) {
+        return std::string();
+      }
+      cache_dir = std::string(home) + "/.cache/carla/maps";
+    }
+    std::ostringstream file_name;
+    file_name << std::hex << std::hash<std::string>()(opendrive);
+    std::string path = cache_dir + "/" + file_name.str() + ".bin";
+    FileSystem::ValidateFilePath(path, ".bin");
+    return path;
+  }
+
+  boost::optional<Map> MapSnapshot::LoadFromFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return {};
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string snapshot = contents.str();
+
+    SnapshotReader reader(snapshot);
+    if (!reader.CheckHeader()) {
+      log_info("map snapshot", path, "has a different format version, re-parsing the OpenDRIVE");
+      return {};
+    }
+
+    MapBuilder builder;
+#ifndef LIBCARLA_NO_EXCEPTIONS
+    try {
+#endif // LIBCARLA_NO_EXCEPTIONS
+      if (!ReplaySnapshot(reader, builder)) {
+        log_warning("map snapshot", path, "is corrupt, re-parsing the OpenDRIVE");
+        return {};
+      }
+      return builder.Build();
+#ifndef LIBCARLA_NO_EXCEPTIONS
+    } catch (const std::exception &e) {
+      log_warning("failed to load map snapshot", path, ":", e.what());
+      return {};
+    }
+#endif // LIBCARLA_NO_EXCEPTIONS
+  }
+
+  void MapSnapshot::SaveToFile(const std::string &path, const std::string &snapshot) {
+    // Write to a private temporary and rename it into place, so concurrent
+    // clients never observe a half-written snapshot.
+    std::ostringstream temp_name;
+    temp_name << path << "." << std::hex << std::hash<std::string>()(snapshot) << ".tmp";
+    const std::string temp_path = temp_name.str();
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      log_warning("unable to write map snapshot at", temp_path);
+      return;
+    }
+    file.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+    file.close();
+    if (!file || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+      log_warning("unable to write map snapshot at", path);
+      std::remove(temp_path.c_str());
+    }
+  }
+
+} // namespace road
+} // namespace carla
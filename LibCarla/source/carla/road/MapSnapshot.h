@@ -0,0 +1,127 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/Map.h"
+#include "carla/road/element/RoadInfoCrosswalk.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Operation codes of the records in a binary map snapshot. Every value is
+  /// part of the on-disk format: only append new codes, and bump the snapshot
+  /// version whenever a record's signature changes.
+  enum class MapSnapshotOp : uint8_t {
+    SET_GEO_REFERENCE = 1u,
+    ADD_ROAD,
+    ADD_ROAD_SECTION,
+    ADD_ROAD_SECTION_LANE,
+    ADD_ROAD_GEOMETRY_LINE,
+    ADD_ROAD_GEOMETRY_ARC,
+    ADD_ROAD_GEOMETRY_SPIRAL,
+    ADD_ROAD_GEOMETRY_POLY3,
+    ADD_ROAD_GEOMETRY_PARAMPOLY3,
+    ADD_ROAD_ELEVATION_PROFILE,
+    ADD_ROAD_OBJECT_CROSSWALK,
+    ADD_SIGNAL,
+    ADD_SIGNAL_REFERENCE,
+    ADD_VALIDITY_TO_SIGNAL_REFERENCE,
+    ADD_DEPENDENCY_TO_SIGNAL,
+    ADD_JUNCTION,
+    ADD_CONNECTION,
+    ADD_LANE_LINK,
+    ADD_JUNCTION_CONTROLLER,
+    CREATE_LANE_ACCESS,
+    CREATE_LANE_BORDER,
+    CREATE_LANE_HEIGHT,
+    CREATE_LANE_MATERIAL,
+    CREATE_LANE_RULE,
+    CREATE_LANE_VISIBILITY,
+    CREATE_LANE_WIDTH,
+    CREATE_ROAD_MARK,
+    CREATE_ROAD_MARK_TYPE_LINE,
+    CREATE_LANE_SPEED,
+    CREATE_ROAD_SPEED,
+    CREATE_SECTION_OFFSET,
+    CREATE_CONTROLLER
+  };
+
+  /// Accumulates the MapBuilder calls of an OpenDRIVE parse as a flat record
+  /// stream; attached to the builder through
+  /// MapBuilder::SetSnapshotWriter.
+  class MapSnapshotWriter {
+  public:
+
+    template <typename... ArgsT>
+    void Record(const MapSnapshotOp op, const ArgsT &... args) {
+      WriteValue(static_cast<uint8_t>(op));
+      WriteAll(args...);
+    }
+
+    /// Returns the versioned snapshot blob.
+    std::string Finish() const;
+
+  private:
+
+    void WriteAll() {}
+
+    template <typename T, typename... RestT>
+    void WriteAll(const T &value, const RestT &... rest) {
+      WriteValue(value);
+      WriteAll(rest...);
+    }
+
+    void WriteBytes(const void *data, size_t size);
+
+    void WriteValue(uint8_t value);
+    void WriteValue(bool value);
+    void WriteValue(int32_t value);
+    void WriteValue(uint32_t value);
+    void WriteValue(uint64_t value);
+    void WriteValue(double value);
+    void WriteValue(const std::string &value);
+    void WriteValue(const std::vector<element::CrosswalkPoint> &value);
+    void WriteValue(const std::set<std::string> &value);
+
+    std::string _payload;
+  };
+
+  /// Binary snapshot of a parsed OpenDRIVE map.
+  ///
+  /// The snapshot is a versioned record stream of the builder calls the
+  /// OpenDRIVE parsers would make; loading replays the records into a fresh
+  /// MapBuilder, skipping the XML parse entirely while rebuilding all derived
+  /// state through the regular build path. Snapshots are a host-local cache:
+  /// the format is not endian-portable and a version mismatch simply falls
+  /// back to parsing the XML.
+  class MapSnapshot {
+  public:
+
+    /// Path the snapshot of @a opendrive is cached at, or empty when caching
+    /// is unavailable. The cache directory is taken from CARLA_MAP_CACHE_DIR
+    /// (set it empty to disable caching), defaulting to ".cache/carla/maps"
+    /// under the user's home directory.
+    static std::string GetCachedSnapshotPath(const std::string &opendrive);
+
+    /// Builds a map by replaying the snapshot at @a path. Returns empty when
+    /// the file is missing, carries a different format version, or is
+    /// corrupt.
+    static boost::optional<Map> LoadFromFile(const std::string &path);
+
+    /// Writes a snapshot blob (from MapSnapshotWriter::Finish) at @a path.
+    static void SaveToFile(const std::string &path, const std::string &snapshot);
+  };
+
+} // namespace road
+} // namespace carla
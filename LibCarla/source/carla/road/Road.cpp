@@ -219,14 +219,37 @@ namespace road {
     auto geom_info_list = _info.GetInfos<element::RoadInfoGeometry>();
     decltype(geom_info_list)::iterator nearest_geom = geom_info_list.end();
 
+    // Straight segments dominate the geometry list; select among them with
+    // the square-root-free batch kernel and keep the exact virtual query for
+    // the arcs and spirals and for the winner.
+    std::vector<std::pair<geom::Vector3D, geom::Vector3D>> segments;
+    std::vector<decltype(geom_info_list)::iterator> segment_geoms;
+    float nearest_squared = std::numeric_limits<float>::max();
     for (auto g = geom_info_list.begin(); g != geom_info_list.end(); ++g) {
       DEBUG_ASSERT(*g != nullptr);
-      auto dist = (*g)->GetGeometry().DistanceTo(loc);
-      if (dist.second < last.second) {
-        last = dist;
-        nearest_geom = g;
+      const auto &geometry = (*g)->GetGeometry();
+      if (geometry.GetType() == element::GeometryType::LINE) {
+        const auto &line = static_cast<const element::GeometryLine &>(geometry);
+        segments.emplace_back(line.GetStartPosition(), line.GetEndPosition());
+        segment_geoms.emplace_back(g);
+      } else {
+        const float squared = geom::Math::Square(geometry.DistanceTo(loc).second);
+        if (squared < nearest_squared) {
+          nearest_squared = squared;
+          nearest_geom = g;
+        }
       }
     }
+    if (!segments.empty()) {
+      const auto batch =
+          geom::Math::NearestSegmentToPoint2D(loc, segments.data(), segments.size());
+      if (batch.second < nearest_squared) {
+        nearest_geom = segment_geoms[batch.first];
+      }
+    }
+    if (nearest_geom != geom_info_list.end()) {
+      last = (*nearest_geom)->GetGeometry().DistanceTo(loc);
+    }
 
     for (auto g = geom_info_list.begin();
         g != geom_info_list.end() && g != nearest_geom;
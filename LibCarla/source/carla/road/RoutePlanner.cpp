@@ -0,0 +1,399 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/RoutePlanner.h"
+
+#include "carla/road/Lane.h"
+#include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/RoadInfoMarkRecord.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace carla {
+namespace road {
+
+  static constexpr uint32_t INVALID_NODE = std::numeric_limits<uint32_t>::max();
+
+  static constexpr float INFINITE_DISTANCE = std::numeric_limits<float>::infinity();
+
+  /// Extra cost of a lane change on top of the lateral offset, so routes
+  /// only change lanes when doing so actually pays off.
+  static constexpr float LANE_CHANGE_PENALTY = 5.0f;
+
+  /// How many landmarks to preprocess; more landmarks tighten the A* lower
+  /// bounds at the price of one distance table pair each.
+  static constexpr size_t MAX_LANDMARKS = 8u;
+
+  /// Whether a vehicle at @a waypoint may change to its right/left adjacent
+  /// lane, reading the lane markings the same way client::Waypoint does.
+  static std::pair<bool, bool> GetAllowedLaneChanges(const Map &map, element::Waypoint waypoint) {
+    using lane_change_type = element::LaneMarking::LaneChange;
+
+    const auto mark_record = map.GetMarkRecord(waypoint);
+
+    auto c_right = (mark_record.first != nullptr)
+        ? static_cast<lane_change_type>(mark_record.first->GetLaneChange())
+        : lane_change_type::Both;
+    auto c_left = (mark_record.second != nullptr)
+        ? static_cast<lane_change_type>(mark_record.second->GetLaneChange())
+        : lane_change_type::Both;
+
+    if (waypoint.lane_id > 0) {
+      // if road goes backward
+      if (c_right == lane_change_type::Right) {
+        c_right = lane_change_type::Left;
+      } else if (c_right == lane_change_type::Left) {
+        c_right = lane_change_type::Right;
+      }
+    }
+
+    if (((waypoint.lane_id > 0) ? waypoint.lane_id - 1 : waypoint.lane_id + 1) > 0) {
+      // if road goes backward
+      if (c_left == lane_change_type::Right) {
+        c_left = lane_change_type::Left;
+      } else if (c_left == lane_change_type::Left) {
+        c_left = lane_change_type::Right;
+      }
+    }
+
+    return {
+        (c_right == lane_change_type::Right) || (c_right == lane_change_type::Both),
+        (c_left == lane_change_type::Left) || (c_left == lane_change_type::Both)};
+  }
+
+  /// Distance still to drive from @a waypoint to the end of its lane.
+  static double GetRemainingLength(const Map &map, element::Waypoint waypoint) {
+    const auto &lane = map.GetLane(waypoint);
+    return (waypoint.lane_id <= 0)
+        ? lane.GetDistance() + lane.GetLength() - waypoint.s
+        : waypoint.s - lane.GetDistance();
+  }
+
+  /// Driving distance from @a from to @a to, both on the same lane;
+  /// negative when @a to is behind @a from.
+  static double GetForwardDistance(element::Waypoint from, element::Waypoint to) {
+    return (from.lane_id <= 0) ? (to.s - from.s) : (from.s - to.s);
+  }
+
+  /// Append one waypoint every @a resolution meters (@a from included)
+  /// driving @a length meters from @a from along its own lane.
+  static void SampleLane(
+      element::Waypoint from,
+      double length,
+      double resolution,
+      std::vector<element::Waypoint> &route) {
+    const double step = std::max(resolution, 0.1);
+    const double direction = (from.lane_id <= 0) ? 1.0 : -1.0;
+    for (double offset = 0.0; offset < length; offset += step) {
+      auto waypoint = from;
+      waypoint.s = from.s + direction * offset;
+      route.push_back(waypoint);
+    }
+  }
+
+  /// Plain Dijkstra from @a source; @a get_edges maps a node index to its
+  /// outgoing (or incoming, for the reverse tables) edge list.
+  template <typename GetEdgesT>
+  static std::vector<float> Dijkstra(size_t node_count, uint32_t source, GetEdgesT &&get_edges) {
+    std::vector<float> distance(node_count, INFINITE_DISTANCE);
+    using QueueEntry = std::pair<float, uint32_t>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    distance[source] = 0.0f;
+    queue.emplace(0.0f, source);
+    while (!queue.empty()) {
+      const auto entry = queue.top();
+      queue.pop();
+      if (entry.first > distance[entry.second]) {
+        continue;
+      }
+      for (const auto &edge : get_edges(entry.second)) {
+        const auto candidate = entry.first + edge.cost;
+        if (candidate < distance[edge.target]) {
+          distance[edge.target] = candidate;
+          queue.emplace(candidate, edge.target);
+        }
+      }
+    }
+    return distance;
+  }
+
+  RoutePlanner::RoutePlanner(const Map &map) : _map(map) {
+    const auto entries = map.GenerateWaypointsOnRoadEntries();
+    _nodes.reserve(entries.size());
+    _lane_to_node.reserve(entries.size());
+    for (const auto &entry : entries) {
+      const LaneKey key{entry.road_id, entry.section_id, entry.lane_id};
+      if (_lane_to_node.emplace(key, static_cast<uint32_t>(_nodes.size())).second) {
+        _nodes.push_back(Node{entry, {}});
+      }
+    }
+    for (auto &node : _nodes) {
+      const auto length = static_cast<float>(map.GetLane(node.entry).GetLength());
+      for (const auto &successor : map.GetSuccessors(node.entry)) {
+        const auto target = FindNode(successor);
+        if (target != INVALID_NODE) {
+          node.edges.push_back(Edge{target, length, false});
+        }
+      }
+      AddLaneChangeEdges(map, node);
+    }
+    _reverse_edges.resize(_nodes.size());
+    for (auto source = 0u; source < _nodes.size(); ++source) {
+      for (const auto &edge : _nodes[source].edges) {
+        _reverse_edges[edge.target].push_back(Edge{source, edge.cost, edge.is_lane_change});
+      }
+    }
+    SelectLandmarks();
+  }
+
+  uint32_t RoutePlanner::FindNode(Waypoint waypoint) const {
+    const auto it = _lane_to_node.find(
+        LaneKey{waypoint.road_id, waypoint.section_id, waypoint.lane_id});
+    return (it != _lane_to_node.end()) ? it->second : INVALID_NODE;
+  }
+
+  void RoutePlanner::AddLaneChangeEdges(const Map &map, Node &node) {
+    const auto allowed = GetAllowedLaneChanges(map, node.entry);
+    const auto add_edge = [&](boost::optional<Waypoint> adjacent) {
+      if (!adjacent.has_value() ||
+          (adjacent->lane_id * node.entry.lane_id < 0) ||
+          (map.GetLaneType(*adjacent) != Lane::LaneType::Driving)) {
+        return;
+      }
+      const auto target = FindNode(*adjacent);
+      if (target != INVALID_NODE) {
+        const auto cost = static_cast<float>(map.GetLaneWidth(*adjacent)) + LANE_CHANGE_PENALTY;
+        node.edges.push_back(Edge{target, cost, true});
+      }
+    };
+    if (allowed.first) {
+      add_edge(map.GetRight(node.entry));
+    }
+    if (allowed.second) {
+      add_edge(map.GetLeft(node.entry));
+    }
+  }
+
+  void RoutePlanner::SelectLandmarks() {
+    if (_nodes.empty()) {
+      return;
+    }
+    // Farthest-point selection: each new landmark is the node the current
+    // set covers worst, so the lower bounds stay tight all over the map and
+    // disconnected parts of the network get a landmark of their own.
+    ComputeLandmarkDistances(0u);
+    while (_from_landmark.size() < std::min(MAX_LANDMARKS, _nodes.size())) {
+      auto farthest = INVALID_NODE;
+      auto best = 0.0f;
+      for (auto node = 0u; node < _nodes.size(); ++node) {
+        auto closest = std::numeric_limits<float>::max();
+        for (const auto &row : _from_landmark) {
+          const auto distance = std::isinf(row[node]) ? 1e30f : row[node];
+          closest = std::min(closest, distance);
+        }
+        if (closest > best) {
+          best = closest;
+          farthest = node;
+        }
+      }
+      if (farthest == INVALID_NODE) {
+        break;
+      }
+      ComputeLandmarkDistances(farthest);
+    }
+  }
+
+  void RoutePlanner::ComputeLandmarkDistances(uint32_t landmark) {
+    _from_landmark.push_back(Dijkstra(_nodes.size(), landmark, [this](uint32_t node) -> const std::vector<Edge> & {
+      return _nodes[node].edges;
+    }));
+    _to_landmark.push_back(Dijkstra(_nodes.size(), landmark, [this](uint32_t node) -> const std::vector<Edge> & {
+      return _reverse_edges[node];
+    }));
+  }
+
+  float RoutePlanner::EstimateDistance(uint32_t node, uint32_t target) const {
+    auto best = 0.0f;
+    for (auto k = 0u; k < _from_landmark.size(); ++k) {
+      const auto &from = _from_landmark[k];
+      const auto &to = _to_landmark[k];
+      if (std::isfinite(from[target]) && std::isfinite(from[node])) {
+        best = std::max(best, from[target] - from[node]);
+      }
+      if (std::isfinite(to[node]) && std::isfinite(to[target])) {
+        best = std::max(best, to[node] - to[target]);
+      }
+    }
+    return best;
+  }
+
+  std::vector<RoutePlanner::Waypoint> RoutePlanner::TraceRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      double resolution) const {
+    const auto from = _map.GetClosestWaypointOnRoad(origin);
+    const auto to = _map.GetClosestWaypointOnRoad(destination);
+    if (!from.has_value() || !to.has_value()) {
+      return {};
+    }
+    return TraceRoute(*from, *to, resolution);
+  }
+
+  std::vector<RoutePlanner::Waypoint> RoutePlanner::TraceRoute(
+      Waypoint origin,
+      Waypoint destination,
+      double resolution) const {
+    std::vector<Waypoint> route;
+    const LaneKey origin_lane{origin.road_id, origin.section_id, origin.lane_id};
+    const LaneKey destination_lane{destination.road_id, destination.section_id, destination.lane_id};
+
+    if (origin_lane == destination_lane) {
+      const auto ahead = GetForwardDistance(origin, destination);
+      if (ahead >= 0.0) {
+        SampleLane(origin, ahead, resolution, route);
+        route.push_back(destination);
+        return route;
+      }
+    }
+
+    const auto target = FindNode(destination);
+    if (target == INVALID_NODE) {
+      return route;
+    }
+
+    const auto allowed = GetAllowedLaneChanges(_map, origin);
+
+    // A destination right next to the origin is one lane change away; the
+    // graph cannot see that because the adjacent lane's entry is behind us.
+    const auto try_adjacent = [&](boost::optional<Waypoint> adjacent) {
+      if (!route.empty() || !adjacent.has_value()) {
+        return;
+      }
+      const LaneKey adjacent_lane{adjacent->road_id, adjacent->section_id, adjacent->lane_id};
+      if (!(adjacent_lane == destination_lane)) {
+        return;
+      }
+      const auto ahead = GetForwardDistance(*adjacent, destination);
+      if (ahead < 0.0) {
+        return;
+      }
+      route.push_back(origin);
+      SampleLane(*adjacent, ahead, resolution, route);
+      route.push_back(destination);
+    };
+    if (allowed.first) {
+      try_adjacent(_map.GetRight(origin));
+    }
+    if (allowed.second) {
+      try_adjacent(_map.GetLeft(origin));
+    }
+    if (!route.empty()) {
+      return route;
+    }
+
+    // A* from the lanes reachable without leaving the origin road section
+    // towards the destination lane's entry node, ordered by the landmark
+    // lower bounds.
+    std::vector<float> distance(_nodes.size(), INFINITE_DISTANCE);
+    std::vector<uint32_t> parent(_nodes.size(), INVALID_NODE);
+    std::unordered_map<uint32_t, Waypoint> seed_lane;
+    using QueueEntry = std::pair<float, uint32_t>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    const auto seed = [&](Waypoint from, float extra_cost) {
+      const auto cost = static_cast<float>(GetRemainingLength(_map, from)) + extra_cost;
+      for (const auto &successor : _map.GetSuccessors(from)) {
+        const auto node = FindNode(successor);
+        if ((node != INVALID_NODE) && (cost < distance[node])) {
+          distance[node] = cost;
+          seed_lane[node] = from;
+          queue.emplace(cost + EstimateDistance(node, target), node);
+        }
+      }
+    };
+    seed(origin, 0.0f);
+    const auto seed_adjacent = [&](boost::optional<Waypoint> adjacent) {
+      if (adjacent.has_value() &&
+          (adjacent->lane_id * origin.lane_id > 0) &&
+          (_map.GetLaneType(*adjacent) == Lane::LaneType::Driving)) {
+        seed(*adjacent, static_cast<float>(_map.GetLaneWidth(*adjacent)) + LANE_CHANGE_PENALTY);
+      }
+    };
+    if (allowed.first) {
+      seed_adjacent(_map.GetRight(origin));
+    }
+    if (allowed.second) {
+      seed_adjacent(_map.GetLeft(origin));
+    }
+
+    while (!queue.empty()) {
+      const auto entry = queue.top();
+      queue.pop();
+      const auto node = entry.second;
+      if (node == target) {
+        break;
+      }
+      if (entry.first > distance[node] + EstimateDistance(node, target)) {
+        continue;
+      }
+      for (const auto &edge : _nodes[node].edges) {
+        const auto candidate = distance[node] + edge.cost;
+        if (candidate < distance[edge.target]) {
+          distance[edge.target] = candidate;
+          parent[edge.target] = node;
+          queue.emplace(candidate + EstimateDistance(edge.target, target), edge.target);
+        }
+      }
+    }
+    if (std::isinf(distance[target])) {
+      return route;
+    }
+
+    std::vector<uint32_t> path;
+    for (auto node = target;; node = parent[node]) {
+      path.push_back(node);
+      if (parent[node] == INVALID_NODE) {
+        break;
+      }
+    }
+    std::reverse(path.begin(), path.end());
+
+    const auto first = seed_lane.at(path.front());
+    const LaneKey first_lane{first.road_id, first.section_id, first.lane_id};
+    if (!(first_lane == origin_lane)) {
+      // The route starts with a lane change.
+      route.push_back(origin);
+    }
+    SampleLane(first, GetRemainingLength(_map, first), resolution, route);
+    for (auto i = 0u; i + 1u < path.size(); ++i) {
+      const auto &node = _nodes[path[i]];
+      const Edge *used = nullptr;
+      for (const auto &edge : node.edges) {
+        if ((edge.target == path[i + 1u]) &&
+            ((used == nullptr) || (edge.cost < used->cost))) {
+          used = &edge;
+        }
+      }
+      if ((used != nullptr) && used->is_lane_change) {
+        route.push_back(node.entry);
+      } else {
+        SampleLane(node.entry, _map.GetLane(node.entry).GetLength(), resolution, route);
+      }
+    }
+    const auto last = _nodes[path.back()].entry;
+    const auto ahead = GetForwardDistance(last, destination);
+    if (ahead > 0.0) {
+      SampleLane(last, ahead, resolution, route);
+    }
+    route.push_back(destination);
+    return route;
+  }
+
+} // namespace road
+} // namespace carla
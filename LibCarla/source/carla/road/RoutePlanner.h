@@ -0,0 +1,126 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/road/Map.h"
+#include "carla/road/RoadTypes.h"
+#include "carla/road/element/Waypoint.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Shortest-route search over the lane topology of a road::Map.
+  ///
+  /// The constructor condenses the map into a graph with one node per
+  /// drivable lane (edges follow lane successors, plus lane changes where
+  /// the markings allow them) and preprocesses a set of landmark distance
+  /// tables, so each query is an A* guided by landmark lower bounds instead
+  /// of a plain breadth-first expansion. Build it once per map and reuse it;
+  /// queries are read-only and can run concurrently.
+  class RoutePlanner : private NonCopyable {
+  public:
+
+    using Waypoint = element::Waypoint;
+
+    /// Build the routing graph and the landmark tables for @a map. The map
+    /// must outlive this planner.
+    explicit RoutePlanner(const Map &map);
+
+    /// Trace the shortest drivable route from @a origin to @a destination,
+    /// returning a waypoint approximately every @a resolution meters along
+    /// it. Both locations are projected onto the closest driving lane the
+    /// same way Map::GetClosestWaypointOnRoad does. Returns an empty list
+    /// when either location misses the road network or no route connects
+    /// them.
+    std::vector<Waypoint> TraceRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double resolution = 2.0) const;
+
+    /// Same as above starting and ending at already projected waypoints.
+    std::vector<Waypoint> TraceRoute(
+        Waypoint origin,
+        Waypoint destination,
+        double resolution = 2.0) const;
+
+    size_t GetNodeCount() const {
+      return _nodes.size();
+    }
+
+  private:
+
+    /// A lane regardless of the s position within it; every graph node is
+    /// the entry waypoint of one of these.
+    struct LaneKey {
+      RoadId road_id;
+      SectionId section_id;
+      LaneId lane_id;
+
+      bool operator==(const LaneKey &rhs) const {
+        return (road_id == rhs.road_id) &&
+               (section_id == rhs.section_id) &&
+               (lane_id == rhs.lane_id);
+      }
+    };
+
+    struct LaneKeyHash {
+      size_t operator()(const LaneKey &key) const {
+        size_t seed = std::hash<RoadId>()(key.road_id);
+        seed ^= std::hash<SectionId>()(key.section_id) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<LaneId>()(key.lane_id) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+        return seed;
+      }
+    };
+
+    struct Edge {
+      uint32_t target;
+      float cost;
+      bool is_lane_change;
+    };
+
+    struct Node {
+      Waypoint entry;
+      std::vector<Edge> edges;
+    };
+
+    uint32_t FindNode(Waypoint waypoint) const;
+
+    void AddLaneChangeEdges(const Map &map, Node &node);
+
+    void SelectLandmarks();
+
+    /// Distances from every node to @a landmark and from @a landmark to
+    /// every node (forward and reverse Dijkstra), appended to the tables.
+    void ComputeLandmarkDistances(uint32_t landmark);
+
+    /// Admissible lower bound on the distance from @a node to @a target
+    /// derived from the landmark tables.
+    float EstimateDistance(uint32_t node, uint32_t target) const;
+
+    std::vector<Node> _nodes;
+
+    std::unordered_map<LaneKey, uint32_t, LaneKeyHash> _lane_to_node;
+
+    /// Reverse adjacency, only needed while preprocessing but also cheap to
+    /// keep: _reverse_edges[n] holds the nodes with an edge into n.
+    std::vector<std::vector<Edge>> _reverse_edges;
+
+    /// One row per landmark: distance from the landmark to each node, and
+    /// from each node to the landmark.
+    std::vector<std::vector<float>> _from_landmark;
+    std::vector<std::vector<float>> _to_landmark;
+
+    const Map &_map;
+  };
+
+} // namespace road
+} // namespace carla
@@ -69,34 +69,72 @@ namespace element {
   DirectedPoint GeometrySpiral::PosFromDist(double dist) const {
     dist = geom::Math::Clamp(dist, 0.0, _length);
     DEBUG_ASSERT(_length > 0.0);
-    DirectedPoint p(_start_position, _heading);
-
-    const double curve_end = (_curve_end);
-    const double curve_start = (_curve_start);
-    const double curve_dot = (curve_end - curve_start) / (_length);
-    const double s_o = curve_start / curve_dot;
-    double s = s_o + dist;
+    DEBUG_ASSERT(_lut.size() > 1u);
+
+    auto it = std::upper_bound(_lut.begin(), _lut.end(), dist,
+        [](const double value, const LutSample &sample) { return value < sample.s; });
+    if (it == _lut.begin()) {
+      ++it;
+    } else if (it == _lut.end()) {
+      --it;
+    }
+    const LutSample &sample0 = *(it - 1u);
+    const LutSample &sample1 = *it;
+
+    // Cubic Hermite interpolation between the two bracketing samples; the
+    // spiral is parameterized by arc length, so the unit heading vectors at
+    // the samples are its exact derivatives.
+    const double h = sample1.s - sample0.s;
+    const double r = (dist - sample0.s) / h;
+    const double r2 = r * r;
+    const double r3 = r2 * r;
+    const double h00 = 2.0 * r3 - 3.0 * r2 + 1.0;
+    const double h10 = r3 - 2.0 * r2 + r;
+    const double h01 = -2.0 * r3 + 3.0 * r2;
+    const double h11 = r3 - r2;
+
+    DirectedPoint p(_start_position, (1.0 - r) * sample0.tangent + r * sample1.tangent);
+    p.location.x = static_cast<float>(
+        h00 * sample0.x + h01 * sample1.x + h * (h10 * sample0.dir_x + h11 * sample1.dir_x));
+    p.location.y = static_cast<float>(
+        h00 * sample0.y + h01 * sample1.y + h * (h10 * sample0.dir_y + h11 * sample1.dir_y));
+    return p;
+  }
 
-    double x;
-    double y;
-    double t;
-    odrSpiral(s, curve_dot, &x, &y, &t);
+  void GeometrySpiral::PreComputeSpline() {
+    // Roughly the interval size in m
+    constexpr double interval_size = 0.3;
+    const double curve_dot = (_curve_end - _curve_start) / _length;
+    const double s_o = _curve_start / curve_dot;
 
     double x_o;
     double y_o;
     double t_o;
     odrSpiral(s_o, curve_dot, &x_o, &y_o, &t_o);
 
-    x = x - x_o;
-    y = y - y_o;
-    t = t - t_o;
-
-    geom::Vector2D pos = RotatebyAngle(_heading - t_o, x, y);
-    p.location.x += pos.x;
-    p.location.y += pos.y;
-    p.tangent = _heading + t;
-
-    return p;
+    const size_t number_intervals =
+        std::max(static_cast<size_t>(_length / interval_size), size_t(8));
+    const double delta_s = _length / static_cast<double>(number_intervals);
+    _lut.reserve(number_intervals + 1u);
+    for (size_t i = 0; i <= number_intervals; ++i) {
+      const double dist = static_cast<double>(i) * delta_s;
+
+      double x;
+      double y;
+      double t;
+      odrSpiral(s_o + dist, curve_dot, &x, &y, &t);
+      t = t - t_o;
+
+      const geom::Vector2D pos = RotatebyAngle(_heading - t_o, x - x_o, y - y_o);
+      const double tangent = _heading + t;
+      _lut.push_back(LutSample{
+          dist,
+          static_cast<double>(_start_position.x) + pos.x,
+          static_cast<double>(_start_position.y) + pos.y,
+          tangent,
+          std::cos(tangent),
+          std::sin(tangent)});
+    }
   }
 
   /// @todo
@@ -107,11 +145,16 @@ namespace element {
   }
 
   DirectedPoint GeometryPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
-
-    auto &val1 = result.second.first;
-    auto &val2 = result.second.second;
+    DEBUG_ASSERT(_lut.size() > 1u);
+    auto it = std::upper_bound(_lut.begin(), _lut.end(), dist,
+        [](const double value, const LutSample &sample) { return value < sample.s; });
+    if (it == _lut.begin()) {
+      ++it;
+    } else if (it == _lut.end()) {
+      --it;
+    }
+    const LutSample &val1 = *(it - 1u);
+    const LutSample &val2 = *it;
 
     double rate = (val2.s - dist) / (val2.s - val1.s);
     double u = rate * val1.u + (1.0 - rate) * val2.u;
@@ -137,38 +180,31 @@ namespace element {
     const double delta_u = interval_size; // interval between values of u
     double current_s = 0;
     double current_u = 0;
-    double last_u = 0;
-    double last_v = _poly.Evaluate(current_u);
-    double last_s = 0;
-    RtreeValue last_val{last_u, last_v, last_s, _poly.Tangent(current_u)};
+    _lut.push_back(LutSample{current_u, _poly.Evaluate(current_u), current_s, _poly.Tangent(current_u)});
     while (current_s < _length + delta_u) {
       current_u += delta_u;
       double current_v = _poly.Evaluate(current_u);
-      double du = current_u - last_u;
-      double dv = current_v - last_v;
+      double du = current_u - _lut.back().u;
+      double dv = current_v - _lut.back().v;
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
       double current_t = _poly.Tangent(current_u);
-      RtreeValue current_val{current_u, current_v, current_s, current_t};
-
-      Rtree::BPoint p1(static_cast<float>(last_s));
-      Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
-
-      last_u = current_u;
-      last_v = current_v;
-      last_s = current_s;
-      last_val = current_val;
-
+      _lut.push_back(LutSample{current_u, current_v, current_s, current_t});
     }
   }
 
   DirectedPoint GeometryParamPoly3::PosFromDist(double dist) const {
-    auto result = _rtree.GetNearestNeighbours(
-        Rtree::BPoint(static_cast<float>(dist))).front();
+    DEBUG_ASSERT(_lut.size() > 1u);
+    auto it = std::upper_bound(_lut.begin(), _lut.end(), dist,
+        [](const double value, const LutSample &sample) { return value < sample.s; });
+    if (it == _lut.begin()) {
+      ++it;
+    } else if (it == _lut.end()) {
+      --it;
+    }
+    const LutSample &val1 = *(it - 1u);
+    const LutSample &val2 = *it;
 
-    auto &val1 = result.second.first;
-    auto &val2 = result.second.second;
     double rate = (val2.s - dist) / (val2.s - val1.s);
     double u = rate * val1.u + (1.0 - rate) * val2.u;
     double v = rate * val1.v + (1.0 - rate) * val2.v;
@@ -199,40 +235,27 @@ namespace element {
     }
     double param_p = 0;
     double current_s = 0;
-    double last_u = _polyU.Evaluate(param_p);
-    double last_v = _polyV.Evaluate(param_p);
-    double last_s = 0;
-    RtreeValue last_val{
-        last_u,
-        last_v,
-        last_s,
+    _lut.reserve(number_intervals + 1u);
+    _lut.push_back(LutSample{
+        _polyU.Evaluate(param_p),
+        _polyV.Evaluate(param_p),
+        current_s,
         _polyU.Tangent(param_p),
-        _polyV.Tangent(param_p) };
+        _polyV.Tangent(param_p) });
     for(size_t i = 0; i < number_intervals; ++i) {
       param_p += delta_p;
       double current_u = _polyU.Evaluate(param_p);
       double current_v = _polyV.Evaluate(param_p);
-      double du = current_u - last_u;
-      double dv = current_v - last_v;
+      double du = current_u - _lut.back().u;
+      double dv = current_v - _lut.back().v;
       double ds = sqrt(du * du + dv * dv);
       current_s += ds;
-      double current_t_u = _polyU.Tangent(param_p);
-      double current_t_v = _polyV.Tangent(param_p);
-      RtreeValue current_val{
+      _lut.push_back(LutSample{
           current_u,
           current_v,
           current_s,
-          current_t_u,
-          current_t_v };
-
-      Rtree::BPoint p1(static_cast<float>(last_s));
-      Rtree::BPoint p2(static_cast<float>(current_s));
-      _rtree.InsertElement(Rtree::BSegment(p1, p2), last_val, current_val);
-
-      last_u = current_u;
-      last_v = current_v;
-      last_s = current_s;
-      last_val = current_val;
+          _polyU.Tangent(param_p),
+          _polyV.Tangent(param_p) });
 
       if(current_s > _length){
         break;
@@ -9,7 +9,8 @@
 #include "carla/geom/Location.h"
 #include "carla/geom/Math.h"
 #include "carla/geom/CubicPolynomial.h"
-#include "carla/geom/Rtree.h"
+
+#include <vector>
 
 namespace carla {
 namespace road {
@@ -62,7 +63,7 @@ namespace element {
       return _heading;
     }
 
-    const geom::Location &GetStartPosition() {
+    const geom::Location &GetStartPosition() const {
       return _start_position;
     }
 
@@ -105,10 +106,21 @@ namespace element {
         double length,
         double heading,
         const geom::Location &start_pos)
-      : Geometry(GeometryType::LINE, start_offset, length, heading, start_pos) {}
+      : Geometry(GeometryType::LINE, start_offset, length, heading, start_pos),
+        // Same expression as PosFromDist(length); cached so distance
+        // queries skip the trigonometry.
+        _end_position(
+            start_pos.x + static_cast<float>(length * std::cos(heading)),
+            start_pos.y + static_cast<float>(length * std::sin(heading)),
+            start_pos.z) {}
 
     DirectedPoint PosFromDist(double dist) const override;
 
+    /// End position of the line on the road plane.
+    const geom::Location &GetEndPosition() const {
+      return _end_position;
+    }
+
     /// Returns a pair containing:
     /// - @b first:  distance to the nearest point in this line from the
     ///              beginning of the shape.
@@ -119,9 +131,13 @@ namespace element {
       return geom::Math::DistanceSegmentToPoint(
           p,
           _start_position,
-          PosFromDist(_length).location);
+          _end_position);
     }
 
+  private:
+
+    geom::Location _end_position;
+
   };
 
   class GeometryArc final : public Geometry {
@@ -173,7 +189,9 @@ namespace element {
         double curv_e)
       : Geometry(GeometryType::SPIRAL, start_offset, length, heading, start_pos),
         _curve_start(curv_s),
-        _curve_end(curv_e) {}
+        _curve_end(curv_e) {
+      PreComputeSpline();
+    }
 
     double GetCurveStart() {
       return _curve_start;
@@ -191,6 +209,19 @@ namespace element {
 
     double _curve_start;
     double _curve_end;
+
+    /// World-frame sample of the spiral at arc length @a s from its start;
+    /// @a dir is the unit heading vector, i.e. (cos(tangent), sin(tangent)).
+    struct LutSample {
+      double s = 0;
+      double x = 0;
+      double y = 0;
+      double tangent = 0;
+      double dir_x = 0;
+      double dir_y = 0;
+    };
+    std::vector<LutSample> _lut;
+    void PreComputeSpline();
   };
 
   class GeometryPoly3 final : public Geometry {
@@ -240,15 +271,13 @@ namespace element {
     double _c;
     double _d;
 
-    struct RtreeValue {
+    struct LutSample {
       double u = 0;
       double v = 0;
       double s = 0;
       double t = 0;
     };
-    using Rtree = geom::SegmentCloudRtree<RtreeValue, 1>;
-    using TreeElement = Rtree::TreeElement;
-    Rtree _rtree;
+    std::vector<LutSample> _lut;
     void PreComputeSpline();
   };
 
@@ -327,16 +356,14 @@ namespace element {
     double _dV;
     bool _arcLength;
 
-    struct RtreeValue {
+    struct LutSample {
       double u = 0;
       double v = 0;
       double s = 0;
       double t_u = 0;
       double t_v = 0;
     };
-    using Rtree = geom::SegmentCloudRtree<RtreeValue, 1>;
-    using TreeElement = Rtree::TreeElement;
-    Rtree _rtree;
+    std::vector<LutSample> _lut;
     void PreComputeSpline();
   };
 
@@ -57,12 +57,37 @@ namespace element {
     return !map.GetWaypoint(location, FLAGS).has_value();
   }
 
+  LaneCrossingCalculator::ResolvedLocation LaneCrossingCalculator::Resolve(
+      const Map &map,
+      const geom::Location &location) {
+    ResolvedLocation resolved;
+    resolved.waypoint = map.GetClosestWaypointOnRoad(location, FLAGS);
+    if (resolved.waypoint.has_value()) {
+      resolved.is_offroad = IsOffRoad(map, location);
+    }
+    return resolved;
+  }
+
+  std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
+      const Map &map,
+      const geom::Location &origin,
+      const geom::Location &destination) {
+    return Calculate(
+        map,
+        Resolve(map, origin),
+        origin,
+        Resolve(map, destination),
+        destination);
+  }
+
   std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
       const Map &map,
+      const ResolvedLocation &resolved_origin,
       const geom::Location &origin,
+      const ResolvedLocation &resolved_destination,
       const geom::Location &destination) {
-    auto w0 = map.GetClosestWaypointOnRoad(origin, FLAGS);
-    auto w1 = map.GetClosestWaypointOnRoad(destination, FLAGS);
+    const auto &w0 = resolved_origin.waypoint;
+    const auto &w1 = resolved_destination.waypoint;
 
     if (!w0.has_value() || !w1.has_value()) {
       return {};
@@ -77,8 +102,8 @@ namespace element {
       return {};
     }
 
-    const auto w0_is_offroad = IsOffRoad(map, origin);
-    const auto w1_is_offroad = IsOffRoad(map, destination);
+    const auto w0_is_offroad = resolved_origin.is_offroad;
+    const auto w1_is_offroad = resolved_destination.is_offroad;
 
     if (w0_is_offroad && w1_is_offroad) {
       // outside the road
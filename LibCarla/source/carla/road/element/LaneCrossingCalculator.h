@@ -7,6 +7,9 @@
 #pragma once
 
 #include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/Waypoint.h"
+
+#include <boost/optional.hpp>
 
 #include <vector>
 
@@ -21,9 +24,31 @@ namespace element {
   class LaneCrossingCalculator {
   public:
 
+    /// Map state of one segment endpoint: the closest on-road waypoint and
+    /// whether the location itself lies off the road. Resolving is the
+    /// expensive half of a crossed-lanes query; a caller tracking a moving
+    /// point can resolve each position once and reuse it as the origin of
+    /// the next segment.
+    struct ResolvedLocation {
+      boost::optional<Waypoint> waypoint;
+      bool is_offroad = true;
+    };
+
+    static ResolvedLocation Resolve(
+        const Map &map,
+        const geom::Location &location);
+
+    static std::vector<LaneMarking> Calculate(
+        const Map &map,
+        const geom::Location &origin,
+        const geom::Location &destination);
+
+    /// Same as above, with both endpoints already resolved.
     static std::vector<LaneMarking> Calculate(
         const Map &map,
+        const ResolvedLocation &resolved_origin,
         const geom::Location &origin,
+        const ResolvedLocation &resolved_destination,
         const geom::Location &destination);
   };
 
@@ -0,0 +1,93 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/element/RoadInfoVisitor.h"
+
+#include <cstddef>
+
+namespace carla {
+namespace road {
+namespace element {
+
+  /// Slot of each concrete RoadInfo type in per-type flat indexes.
+  enum class RoadInfoType : size_t {
+    Elevation,
+    Geometry,
+    Lane,
+    LaneAccess,
+    LaneBorder,
+    LaneHeight,
+    LaneMaterial,
+    LaneOffset,
+    LaneRule,
+    LaneVisibility,
+    LaneWidth,
+    MarkRecord,
+    MarkTypeLine,
+    Speed,
+    Crosswalk,
+    Signal,
+    SIZE
+  };
+
+  /// Compile-time slot of a concrete RoadInfo type.
+  template <typename T>
+  struct RoadInfoTypeIndex;
+
+  template <> struct RoadInfoTypeIndex<RoadInfoElevation>      { static constexpr RoadInfoType value = RoadInfoType::Elevation; };
+  template <> struct RoadInfoTypeIndex<RoadInfoGeometry>       { static constexpr RoadInfoType value = RoadInfoType::Geometry; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLane>           { static constexpr RoadInfoType value = RoadInfoType::Lane; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneAccess>     { static constexpr RoadInfoType value = RoadInfoType::LaneAccess; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneBorder>     { static constexpr RoadInfoType value = RoadInfoType::LaneBorder; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneHeight>     { static constexpr RoadInfoType value = RoadInfoType::LaneHeight; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneMaterial>   { static constexpr RoadInfoType value = RoadInfoType::LaneMaterial; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneOffset>     { static constexpr RoadInfoType value = RoadInfoType::LaneOffset; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneRule>       { static constexpr RoadInfoType value = RoadInfoType::LaneRule; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneVisibility> { static constexpr RoadInfoType value = RoadInfoType::LaneVisibility; };
+  template <> struct RoadInfoTypeIndex<RoadInfoLaneWidth>      { static constexpr RoadInfoType value = RoadInfoType::LaneWidth; };
+  template <> struct RoadInfoTypeIndex<RoadInfoMarkRecord>     { static constexpr RoadInfoType value = RoadInfoType::MarkRecord; };
+  template <> struct RoadInfoTypeIndex<RoadInfoMarkTypeLine>   { static constexpr RoadInfoType value = RoadInfoType::MarkTypeLine; };
+  template <> struct RoadInfoTypeIndex<RoadInfoSpeed>          { static constexpr RoadInfoType value = RoadInfoType::Speed; };
+  template <> struct RoadInfoTypeIndex<RoadInfoCrosswalk>      { static constexpr RoadInfoType value = RoadInfoType::Crosswalk; };
+  template <> struct RoadInfoTypeIndex<RoadInfoSignal>         { static constexpr RoadInfoType value = RoadInfoType::Signal; };
+
+  /// Resolves the runtime slot of a RoadInfo record through one visitor
+  /// dispatch, so records can be classified once instead of type-tested on
+  /// every query.
+  class RoadInfoTypeVisitor : public RoadInfoVisitor {
+  public:
+
+    RoadInfoType GetType() const {
+      return _type;
+    }
+
+    void Visit(RoadInfoElevation &)      { _type = RoadInfoType::Elevation; }
+    void Visit(RoadInfoGeometry &)       { _type = RoadInfoType::Geometry; }
+    void Visit(RoadInfoLane &)           { _type = RoadInfoType::Lane; }
+    void Visit(RoadInfoLaneAccess &)     { _type = RoadInfoType::LaneAccess; }
+    void Visit(RoadInfoLaneBorder &)     { _type = RoadInfoType::LaneBorder; }
+    void Visit(RoadInfoLaneHeight &)     { _type = RoadInfoType::LaneHeight; }
+    void Visit(RoadInfoLaneMaterial &)   { _type = RoadInfoType::LaneMaterial; }
+    void Visit(RoadInfoLaneOffset &)     { _type = RoadInfoType::LaneOffset; }
+    void Visit(RoadInfoLaneRule &)       { _type = RoadInfoType::LaneRule; }
+    void Visit(RoadInfoLaneVisibility &) { _type = RoadInfoType::LaneVisibility; }
+    void Visit(RoadInfoLaneWidth &)      { _type = RoadInfoType::LaneWidth; }
+    void Visit(RoadInfoMarkRecord &)     { _type = RoadInfoType::MarkRecord; }
+    void Visit(RoadInfoMarkTypeLine &)   { _type = RoadInfoType::MarkTypeLine; }
+    void Visit(RoadInfoSpeed &)          { _type = RoadInfoType::Speed; }
+    void Visit(RoadInfoCrosswalk &)      { _type = RoadInfoType::Crosswalk; }
+    void Visit(RoadInfoSignal &)         { _type = RoadInfoType::Signal; }
+
+  private:
+
+    RoadInfoType _type = RoadInfoType::SIZE;
+  };
+
+} // namespace element
+} // namespace road
+} // namespace carla
@@ -0,0 +1,41 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/Actor.h"
+#include "carla/rpc/ActorId.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Changes to the episode's actor list since a version already known to the
+  /// client, as answered by the "get_actor_list_diff" RPC.
+  class ActorListDiff {
+  public:
+
+    /// Version this diff brings the client up to.
+    uint64_t version = 0u;
+
+    /// If true, the server could not produce a diff against the requested
+    /// version and @a added contains the complete actor list instead.
+    bool is_full_list = false;
+
+    /// Actors registered since the requested version.
+    std::vector<Actor> added;
+
+    /// Ids of actors deregistered since the requested version.
+    std::vector<ActorId> removed;
+
+    MSGPACK_DEFINE_ARRAY(version, is_full_list, added, removed);
+  };
+
+} // namespace rpc
+} // namespace carla
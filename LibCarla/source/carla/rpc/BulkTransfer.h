@@ -0,0 +1,35 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace rpc {
+
+  /// Descriptor of a bulk payload held by the server, to be pulled with
+  /// repeated "pull_bulk_chunk" calls instead of one giant msgpack message.
+  /// The payload may carry the streaming compression prefix; pulling the last
+  /// chunk releases it on the server.
+  class BulkTransfer {
+  public:
+
+    uint32_t id = 0u;
+
+    /// Total bytes to pull, after compression.
+    uint64_t size = 0u;
+
+    /// Every chunk but the last has this size.
+    uint32_t chunk_size = 0u;
+
+    MSGPACK_DEFINE_ARRAY(id, size, chunk_size);
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -38,6 +38,15 @@ namespace rpc {
       _client.async_call(function, Metadata::MakeAsync(), std::forward<Args>(args)...);
     }
 
+    /// Same as call() but does not block waiting for the reply; returns a
+    /// future with the raw response instead. Calls issued this way are
+    /// pipelined on the same connection, so independent requests overlap
+    /// their round trips rather than stacking them.
+    template <typename... Args>
+    auto async_call_with_result(const std::string &function, Args &&... args) {
+      return _client.async_call(function, Metadata::MakeSync(), std::forward<Args>(args)...);
+    }
+
   private:
 
     ::rpc::client _client;
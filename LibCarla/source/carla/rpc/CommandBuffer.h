@@ -0,0 +1,80 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/NonCopyable.h"
+#include "carla/rpc/Command.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Reusable builder for large command batches. Each command is serialized
+  /// into a growing msgpack buffer the moment it is added, so submitting the
+  /// batch never has to materialize a std::vector<Command> and never
+  /// re-encodes commands already in the buffer.
+  ///
+  /// Clear() keeps the buffer's capacity, so the same CommandBuffer can be
+  /// refilled every tick without reallocating.
+  class CommandBuffer : private NonCopyable {
+  public:
+
+    /// Serialize @a command and append it to the batch.
+    void Add(const Command &command) {
+      ::clmdep_msgpack::pack(_payload, command);
+      ++_count;
+    }
+
+    /// Number of commands in the batch.
+    size_t size() const {
+      return _count;
+    }
+
+    bool empty() const {
+      return _count == 0u;
+    }
+
+    /// Drop the commands added so far keeping the buffer's capacity.
+    void Clear() {
+      _payload.clear();
+      _count = 0u;
+    }
+
+    /// The batch encoded as a msgpack array of commands, i.e. the same bytes
+    /// that packing a std::vector<Command> would produce. The commands are
+    /// already serialized back to back in the buffer, only the array header
+    /// is prepended here.
+    std::vector<uint8_t> Encode() const {
+      namespace mp = ::clmdep_msgpack;
+      mp::sbuffer header;
+      mp::packer<mp::sbuffer> packer(header);
+      packer.pack_array(static_cast<uint32_t>(_count));
+      std::vector<uint8_t> result;
+      result.reserve(header.size() + _payload.size());
+      result.insert(
+          result.end(),
+          reinterpret_cast<const uint8_t *>(header.data()),
+          reinterpret_cast<const uint8_t *>(header.data()) + header.size());
+      result.insert(
+          result.end(),
+          reinterpret_cast<const uint8_t *>(_payload.data()),
+          reinterpret_cast<const uint8_t *>(_payload.data()) + _payload.size());
+      return result;
+    }
+
+  private:
+
+    ::clmdep_msgpack::sbuffer _payload;
+
+    size_t _count = 0u;
+  };
+
+} // namespace rpc
+} // namespace carla
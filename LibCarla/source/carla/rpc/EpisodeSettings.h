@@ -31,7 +31,26 @@ namespace rpc {
 
     boost::optional<double> fixed_delta_seconds;
 
-    MSGPACK_DEFINE_ARRAY(synchronous_mode, no_rendering_mode, fixed_delta_seconds);
+    bool substepping = true;
+
+    double max_substep_delta_time = 0.01;
+
+    int max_substeps = 10;
+
+    /// Per-frame budget for the aggregate sensor cost, in milliseconds.
+    /// While the cost of the previous frames exceeds it, sensors are
+    /// throttled starting from the lowest sensor_priority. Zero disables
+    /// throttling.
+    double sensor_frame_budget_ms = 0.0;
+
+    MSGPACK_DEFINE_ARRAY(
+        synchronous_mode,
+        no_rendering_mode,
+        fixed_delta_seconds,
+        substepping,
+        max_substep_delta_time,
+        max_substeps,
+        sensor_frame_budget_ms);
 
     // =========================================================================
     // -- Constructors ---------------------------------------------------------
@@ -42,11 +61,19 @@ namespace rpc {
     EpisodeSettings(
         bool synchronous_mode,
         bool no_rendering_mode,
-        double fixed_delta_seconds = 0.0)
+        double fixed_delta_seconds = 0.0,
+        bool substepping = true,
+        double max_substep_delta_time = 0.01,
+        int max_substeps = 10,
+        double sensor_frame_budget_ms = 0.0)
       : synchronous_mode(synchronous_mode),
         no_rendering_mode(no_rendering_mode),
         fixed_delta_seconds(
-            fixed_delta_seconds > 0.0 ? fixed_delta_seconds : boost::optional<double>{}) {}
+            fixed_delta_seconds > 0.0 ? fixed_delta_seconds : boost::optional<double>{}),
+        substepping(substepping),
+        max_substep_delta_time(max_substep_delta_time),
+        max_substeps(max_substeps),
+        sensor_frame_budget_ms(sensor_frame_budget_ms) {}
 
     // =========================================================================
     // -- Comparison operators -------------------------------------------------
@@ -56,7 +83,11 @@ namespace rpc {
       return
           (synchronous_mode == rhs.synchronous_mode) &&
           (no_rendering_mode == rhs.no_rendering_mode) &&
-          (fixed_delta_seconds == rhs.fixed_delta_seconds);
+          (fixed_delta_seconds == rhs.fixed_delta_seconds) &&
+          (substepping == rhs.substepping) &&
+          (max_substep_delta_time == rhs.max_substep_delta_time) &&
+          (max_substeps == rhs.max_substeps) &&
+          (sensor_frame_budget_ms == rhs.sensor_frame_budget_ms);
     }
 
     bool operator!=(const EpisodeSettings &rhs) const {
@@ -73,7 +104,11 @@ namespace rpc {
       : EpisodeSettings(
             Settings.bSynchronousMode,
             Settings.bNoRenderingMode,
-            Settings.FixedDeltaSeconds.Get(0.0)) {}
+            Settings.FixedDeltaSeconds.Get(0.0),
+            Settings.bSubstepping,
+            Settings.MaxSubstepDeltaTime,
+            Settings.MaxSubsteps,
+            Settings.SensorFrameBudgetMs) {}
 
     operator FEpisodeSettings() const {
       FEpisodeSettings Settings;
@@ -82,6 +117,10 @@ namespace rpc {
       if (fixed_delta_seconds.has_value()) {
         Settings.FixedDeltaSeconds = *fixed_delta_seconds;
       }
+      Settings.bSubstepping = substepping;
+      Settings.MaxSubstepDeltaTime = max_substep_delta_time;
+      Settings.MaxSubsteps = max_substeps;
+      Settings.SensorFrameBudgetMs = sensor_frame_budget_ms;
       return Settings;
     }
 
@@ -0,0 +1,80 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace rpc {
+
+  /// Frame-budget breakdown of the simulator, aggregated over a sliding
+  /// window of recent frames, so the load of a server can be monitored by
+  /// polling without attaching a profiler.
+  ///
+  /// The thread times are wall-clock milliseconds per frame as reported
+  /// by the engine; in no-rendering mode the render, GPU and RHI times
+  /// stay at zero.
+  struct FrameStats {
+    FrameStats() = default;
+
+    /// Frame counter of the most recent sampled frame.
+    uint64_t frame = 0u;
+
+    /// Number of frames aggregated in this snapshot.
+    uint64_t window_frames = 0u;
+
+    /// Average frames per second over the window.
+    float fps = 0.0f;
+
+    /// Game thread milliseconds per frame.
+    float game_ms_avg = 0.0f;
+    float game_ms_max = 0.0f;
+
+    /// Render thread milliseconds per frame.
+    float render_ms_avg = 0.0f;
+    float render_ms_max = 0.0f;
+
+    /// GPU milliseconds per frame.
+    float gpu_ms_avg = 0.0f;
+    float gpu_ms_max = 0.0f;
+
+    /// RHI thread milliseconds per frame.
+    float rhi_ms_avg = 0.0f;
+    float rhi_ms_max = 0.0f;
+
+    /// Milliseconds per frame spent by the sensors, summed over every
+    /// sensor alive and their capture, serialization, and transmission
+    /// phases.
+    float sensor_ms_avg = 0.0f;
+    float sensor_ms_max = 0.0f;
+
+    /// Physics sub-steps per frame.
+    float physics_substeps_avg = 0.0f;
+    uint32_t physics_substeps_max = 0u;
+
+    MSGPACK_DEFINE_ARRAY(
+        frame,
+        window_frames,
+        fps,
+        game_ms_avg,
+        game_ms_max,
+        render_ms_avg,
+        render_ms_max,
+        gpu_ms_avg,
+        gpu_ms_max,
+        rhi_ms_avg,
+        rhi_ms_max,
+        sensor_ms_avg,
+        sensor_ms_max,
+        physics_substeps_avg,
+        physics_substeps_max);
+  };
+
+} // namespace rpc
+} // namespace carla
@@ -21,14 +21,16 @@ namespace rpc {
         double a_width,
         bool smooth_junc,
         bool e_visibility,
-        bool e_pedestrian)
+        bool e_pedestrian,
+        double t_size = 0.0)
       : vertex_distance(v_distance),
         max_road_length(max_road_len),
         wall_height(w_height),
         additional_width(a_width),
         smooth_junctions(smooth_junc),
         enable_mesh_visibility(e_visibility),
-        enable_pedestrian_navigation(e_pedestrian)
+        enable_pedestrian_navigation(e_pedestrian),
+        tile_size(t_size)
         {}
 
     double vertex_distance = 2.0;
@@ -38,6 +40,9 @@ namespace rpc {
     bool smooth_junctions = true;
     bool enable_mesh_visibility = true;
     bool enable_pedestrian_navigation = true;
+    /// Side in meters of the square tiles of the tiled mesh generation,
+    /// 0 falls back to max_road_length.
+    double tile_size = 0.0;
 
     MSGPACK_DEFINE_ARRAY(
         vertex_distance,
@@ -46,7 +51,8 @@ namespace rpc {
         additional_width,
         smooth_junctions,
         enable_mesh_visibility,
-        enable_pedestrian_navigation);
+        enable_pedestrian_navigation,
+        tile_size);
   };
 
 }
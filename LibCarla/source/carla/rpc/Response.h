@@ -13,6 +13,7 @@
 #include <boost/variant.hpp>
 
 #include <string>
+#include <utility>
 
 namespace carla {
 namespace rpc {
@@ -71,16 +72,23 @@ namespace rpc {
       return boost::get<error_type>(_data);
     }
 
-    value_type &Get() {
+    value_type &Get() & {
       DEBUG_ASSERT(!HasError());
       return boost::get<value_type>(_data);
     }
 
-    const value_type &Get() const {
+    const value_type &Get() const & {
       DEBUG_ASSERT(!HasError());
       return boost::get<value_type>(_data);
     }
 
+    /// Moves the value out of the response; large payloads (map geometry,
+    /// blueprint lists) can be extracted without a copy.
+    value_type &&Get() && {
+      DEBUG_ASSERT(!HasError());
+      return boost::get<value_type>(std::move(_data));
+    }
+
     operator bool() const {
       return !HasError();
     }
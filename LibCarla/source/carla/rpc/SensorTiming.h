@@ -0,0 +1,50 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace rpc {
+
+  /// Wall-clock cost accumulated by a sensor in the simulator, split by
+  /// phase, since the sensor was spawned.
+  ///
+  /// For render-based sensors the capture time is the latency of the GPU
+  /// readback, measured from the moment the copy is enqueued until the
+  /// pixels are available on the CPU.
+  struct SensorTiming {
+    SensorTiming() = default;
+
+    /// Seconds spent producing the measurements (ray-casting, GPU
+    /// readback, event simulation...).
+    double capture_seconds = 0.0;
+
+    /// Seconds spent serializing the measurements.
+    double serialization_seconds = 0.0;
+
+    /// Seconds spent handing the serialized messages to the stream.
+    double transmission_seconds = 0.0;
+
+    /// Number of measurements sent down the stream.
+    uint64_t measurement_count = 0u;
+
+    /// Number of captures skipped by the sensor frame-budget throttle.
+    uint64_t throttled_count = 0u;
+
+    MSGPACK_DEFINE_ARRAY(
+        capture_seconds,
+        serialization_seconds,
+        transmission_seconds,
+        measurement_count,
+        throttled_count);
+  };
+
+} // namespace rpc
+} // namespace carla
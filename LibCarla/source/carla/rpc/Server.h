@@ -8,6 +8,7 @@
 
 #include "carla/MoveHandler.h"
 #include "carla/Time.h"
+#include "carla/profiler/AllocationTracker.h"
 #include "carla/rpc/Metadata.h"
 #include "carla/rpc/Response.h"
 
@@ -16,11 +17,21 @@
 
 #include <rpc/server.h>
 
+#include <chrono>
 #include <future>
 
 namespace carla {
 namespace rpc {
 
+  /// Cost class of a synchronous RPC handler, declared when the handler is
+  /// bound. Within one `SyncRunFor` window control commands always run
+  /// before queries, and queries before bulk data transfers.
+  enum class CallPriority : uint8_t {
+    Control = 0u,
+    Query = 1u,
+    Bulk = 2u
+  };
+
   // ===========================================================================
   // -- Server -----------------------------------------------------------------
   // ===========================================================================
@@ -41,7 +52,10 @@ namespace rpc {
     explicit Server(Args &&... args);
 
     template <typename FunctorT>
-    void BindSync(const std::string &name, FunctorT &&functor);
+    void BindSync(
+        const std::string &name,
+        FunctorT &&functor,
+        CallPriority priority = CallPriority::Control);
 
     template <typename FunctorT>
     void BindAsync(const std::string &name, FunctorT &&functor);
@@ -51,8 +65,27 @@ namespace rpc {
     }
 
     void SyncRunFor(time_duration duration) {
-      _sync_io_context.reset();
-      _sync_io_context.run_for(duration.to_chrono());
+      using clock = std::chrono::steady_clock;
+      const auto deadline = clock::now() + duration.to_chrono();
+      auto &control = context(CallPriority::Control);
+      auto &query = context(CallPriority::Query);
+      auto &bulk = context(CallPriority::Bulk);
+      control.reset();
+      query.reset();
+      bulk.reset();
+      // Control commands run first and may take the entire window.
+      control.run_until(deadline);
+      const auto now = clock::now();
+      if (now < deadline) {
+        // What is left is split between queries and bulk transfers; queries
+        // run first but a slice of the remainder is reserved for bulk so
+        // heavy client polling cannot push big transfers out entirely.
+        query.run_until(deadline - (deadline - now) / 4);
+        bulk.run_until(deadline);
+        // The contexts return as soon as they go idle; hand any time saved
+        // back to the queries.
+        query.run_until(deadline);
+      }
     }
 
     /// @warning does not stop the game thread.
@@ -62,7 +95,13 @@ namespace rpc {
 
   private:
 
-    boost::asio::io_context _sync_io_context;
+    boost::asio::io_context &context(CallPriority priority) {
+      return _sync_io_contexts[static_cast<size_t>(priority)];
+    }
+
+    /// One context per priority class; the game thread drains them in
+    /// priority order within the `SyncRunFor` window.
+    boost::asio::io_context _sync_io_contexts[3u];
 
     ::rpc::server _server;
   };
@@ -104,6 +143,7 @@ namespace detail {
     static auto WrapSyncCall(boost::asio::io_context &io, FuncT &&functor) {
       return [&io, functor=std::forward<FuncT>(functor)](Metadata metadata, Args... args) -> R {
         auto task = std::packaged_task<R()>([functor=std::move(functor), args...]() {
+          CARLA_ALLOCATION_SCOPE(Rpc);
           return functor(args...);
         });
         if (metadata.IsResponseIgnored()) {
@@ -125,6 +165,7 @@ namespace detail {
     template <typename FuncT>
     static auto WrapAsyncCall(FuncT &&functor) {
       return [functor=std::forward<FuncT>(functor)](::carla::rpc::Metadata metadata, Args... args) -> R {
+        CARLA_ALLOCATION_SCOPE(Rpc);
         if (metadata.IsResponseIgnored()) {
           functor(args...);
           return R();
@@ -144,11 +185,14 @@ namespace detail {
   }
 
   template <typename FunctorT>
-  inline void Server::BindSync(const std::string &name, FunctorT &&functor) {
+  inline void Server::BindSync(
+      const std::string &name,
+      FunctorT &&functor,
+      CallPriority priority) {
     using Wrapper = detail::FunctionWrapper<FunctorT>;
     _server.bind(
         name,
-        Wrapper::WrapSyncCall(_sync_io_context, std::forward<FunctorT>(functor)));
+        Wrapper::WrapSyncCall(context(priority), std::forward<FunctorT>(functor)));
   }
 
   template <typename FunctorT>
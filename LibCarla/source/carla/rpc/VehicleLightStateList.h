@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include "carla/MsgPackBin.h"
 #include "carla/rpc/ActorId.h"
 #include "carla/rpc/VehicleLightState.h"
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace carla {
@@ -20,3 +22,6 @@ namespace rpc {
 
 } // namespace rpc
 } // namespace carla
+
+// One entry per vehicle in the episode, sent every tick.
+CARLA_MSGPACK_VECTOR_AS_BIN(std::pair<carla::rpc::ActorId, carla::rpc::VehicleLightState::flag_type>)
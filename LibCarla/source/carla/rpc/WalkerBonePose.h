@@ -0,0 +1,40 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Packed bone pose for a walker. Bones are addressed by their index in the
+  /// skeleton, fetched once per walker through Walker::GetBoneNames, so the
+  /// bone names are not re-serialized with every pose at animation rate.
+  class WalkerBonePose {
+  public:
+
+    WalkerBonePose() = default;
+
+    WalkerBonePose(std::vector<uint32_t> bones, std::vector<float> pose)
+      : bones(std::move(bones)),
+        pose(std::move(pose)) {}
+
+    /// Skeleton indices of the bones this pose sets.
+    std::vector<uint32_t> bones;
+
+    /// Six floats per entry of @a bones: [x, y, z, pitch, yaw, roll] in
+    /// component space, the same convention as WalkerBoneControl transforms.
+    std::vector<float> pose;
+
+    MSGPACK_DEFINE_ARRAY(bones, pose);
+  };
+
+} // namespace rpc
+} // namespace carla
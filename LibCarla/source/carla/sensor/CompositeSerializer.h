@@ -52,14 +52,16 @@ namespace sensor {
 
     template <typename Data, size_t... Is>
     static interpreted_type Deserialize_impl(size_t i, Data &&data, std::index_sequence<Is...>) {
-      // This function is equivalent to creating a switch statement with a case
-      // for each element in the map, the compiler should be able to optimize it
-      // into a jump table. See https://stackoverflow.com/a/46282159/5308925.
-      interpreted_type result;
-      std::initializer_list<int> ({
-          (i == Is ? (result = Deserialize_impl<Is>(std::forward<Data>(data))), 0 : 0)...
-      });
-      return result;
+      // One deserialize thunk per registered serializer, generated at
+      // compile time; dispatching is then a single indexed call instead of
+      // an index comparison against every entry in the map.
+      using DeserializeThunk = interpreted_type (*)(Data &&);
+      static constexpr DeserializeThunk dispatch_table[] = {
+          &Deserialize_impl<Is, Data>...
+      };
+      return (i < Super::size())
+          ? dispatch_table[i](std::forward<Data>(data))
+          : interpreted_type();
     }
 
     template <typename Data>
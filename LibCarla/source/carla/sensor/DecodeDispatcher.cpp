@@ -0,0 +1,88 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/sensor/DecodeDispatcher.h"
+
+#include "carla/ThreadPool.h"
+#include "carla/profiler/AllocationTracker.h"
+#include "carla/profiler/Tracer.h"
+#include "carla/sensor/SensorData.h"
+#include "carla/sensor/SensorRegistry.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace carla {
+namespace sensor {
+
+  /// Shared pool for CPU-heavy decodes, started on first use.
+  static ThreadPool &GetDecodePool() {
+    static ThreadPool pool;
+    static std::once_flag started;
+    std::call_once(started, [] {
+      auto config = ThreadConfig::ProcessDefault();
+      config.name = "carla-decode";
+      pool.AsyncRun(
+          std::max(2u, std::thread::hardware_concurrency() / 2u),
+          std::move(config));
+    });
+    return pool;
+  }
+
+  static bool IsHeavyDecode(const Buffer &message) {
+    const auto sensor_type =
+        s11n::SensorHeaderSerializer::Deserialize(message).sensor_type;
+    return
+        (sensor_type == SensorRegistry::get<ARayCastLidar *>::index) ||
+        (sensor_type == SensorRegistry::get<ARayCastSemanticLidar *>::index);
+  }
+
+  void DecodeDispatcher::Decode(Buffer &&message) {
+    const auto receive_time_us = s11n::SensorHeaderSerializer::NowEpochUs();
+    if (!IsHeavyDecode(message)) {
+      DecodeAndDeliver(std::move(message), receive_time_us);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _queue.emplace_back(std::move(message), receive_time_us);
+      if (_draining) {
+        return;
+      }
+      _draining = true;
+    }
+    auto self = shared_from_this();
+    GetDecodePool().Post([self]() { self->Drain(); });
+  }
+
+  void DecodeDispatcher::Drain() {
+    for (;;) {
+      std::pair<Buffer, uint64_t> message;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queue.empty()) {
+          _draining = false;
+          return;
+        }
+        message = std::move(_queue.front());
+        _queue.pop_front();
+      }
+      DecodeAndDeliver(std::move(message.first), message.second);
+    }
+  }
+
+  void DecodeDispatcher::DecodeAndDeliver(Buffer &&message, uint64_t receive_time_us) {
+    CARLA_TRACE_ZONE(sensor, deserialize);
+    CARLA_ALLOCATION_SCOPE(Sensor);
+    auto data = SensorRegistry::Deserialize(std::move(message));
+    data->_receive_time_us = receive_time_us;
+    data->_deserialize_time_us = s11n::SensorHeaderSerializer::NowEpochUs();
+    _callback(std::move(data));
+  }
+
+} // namespace sensor
+} // namespace carla
@@ -0,0 +1,63 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace carla {
+namespace sensor {
+
+  class SensorData;
+
+  /// Decodes the messages of one sensor subscription and hands the result to
+  /// a callback. Cheap, view-like decodes run inline on the io thread the
+  /// message arrived on; CPU-heavy ones (the lidar point streams) are posted
+  /// to a shared decode pool so they cannot starve the other streams served
+  /// by that io thread. A dispatcher drains its pending messages serially,
+  /// so per-stream ordering is preserved either way.
+  class DecodeDispatcher
+    : public std::enable_shared_from_this<DecodeDispatcher>,
+      private NonCopyable {
+  public:
+
+    using CallbackType = std::function<void(SharedPtr<SensorData>)>;
+
+    explicit DecodeDispatcher(CallbackType callback)
+      : _callback(std::move(callback)) {}
+
+    /// Decode @a message and invoke the callback with the result, inline or
+    /// on the decode pool depending on the sensor type.
+    void Decode(Buffer &&message);
+
+  private:
+
+    void Drain();
+
+    /// Deserialize @a message, stamp its latency trace and hand it to the
+    /// callback.
+    void DecodeAndDeliver(Buffer &&message, uint64_t receive_time_us);
+
+    CallbackType _callback;
+
+    std::mutex _mutex;
+
+    /// Pending messages with their arrival time.
+    std::deque<std::pair<Buffer, uint64_t>> _queue;
+
+    /// Whether a drain task is pending or running on the decode pool.
+    bool _draining = false;
+  };
+
+} // namespace sensor
+} // namespace carla
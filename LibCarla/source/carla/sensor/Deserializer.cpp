@@ -6,12 +6,14 @@
 
 #include "carla/sensor/Deserializer.h"
 
+#include "carla/profiler/Metrics.h"
 #include "carla/sensor/SensorRegistry.h"
 
 namespace carla {
 namespace sensor {
 
   SharedPtr<SensorData> Deserializer::Deserialize(Buffer &&buffer) {
+    CARLA_METRIC_SCOPE(sensor, deserialize);
     return SensorRegistry::Deserialize(std::move(buffer));
   }
 
@@ -0,0 +1,142 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/sensor/SensorData.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace carla {
+namespace sensor {
+
+  /// Accumulates the latency traces of received sensor data into per-stage
+  /// histograms, to find out where a frame's end-to-end latency goes.
+  /// Buckets are powers of two in microseconds, so the ~1 us to ~1 min range
+  /// fits in a handful of counters and Add stays cheap enough for the data
+  /// callback of every sensor.
+  ///
+  /// Thread-safe; one instance can be fed from several sensor callbacks.
+  class LatencyHistogram {
+  public:
+
+    enum class Stage : size_t {
+      Queue,     ///< Capture to start of serialization.
+      Serialize, ///< Serialization.
+      Transport, ///< Hand-off to transport until arrival at the client.
+      Decode,    ///< Arrival until the data object is ready.
+      Total,     ///< Capture to data object ready.
+      SIZE
+    };
+
+    /// Record the latency trace of @a data; frames without one (data not
+    /// coming from a stream) are ignored.
+    void Add(const SensorData &data) {
+      if (data.GetCaptureTimeUs() == 0u) {
+        return;
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      AddSample(Stage::Queue, Elapsed(data.GetCaptureTimeUs(), data.GetSerializeTimeUs()));
+      AddSample(Stage::Serialize, Elapsed(data.GetSerializeTimeUs(), data.GetSendTimeUs()));
+      AddSample(Stage::Transport, Elapsed(data.GetSendTimeUs(), data.GetReceiveTimeUs()));
+      AddSample(Stage::Decode, Elapsed(data.GetReceiveTimeUs(), data.GetDeserializeTimeUs()));
+      AddSample(Stage::Total, Elapsed(data.GetCaptureTimeUs(), data.GetDeserializeTimeUs()));
+    }
+
+    /// Number of frames recorded.
+    uint64_t GetCount() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _count;
+    }
+
+    /// One line per stage with count, p50, p90, p99 and max; percentiles are
+    /// upper bucket bounds, i.e. accurate to a factor of two.
+    std::string Report() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::ostringstream out;
+      static const char *names[] = {"queue", "serialize", "transport", "decode", "total"};
+      for (auto stage = 0u; stage < static_cast<size_t>(Stage::SIZE); ++stage) {
+        const auto &buckets = _buckets[stage];
+        out << names[stage]
+            << " count=" << _count
+            << " p50=" << Percentile(buckets, 0.50) << "us"
+            << " p90=" << Percentile(buckets, 0.90) << "us"
+            << " p99=" << Percentile(buckets, 0.99) << "us"
+            << " max=" << _max_us[stage] << "us\n";
+      }
+      return out.str();
+    }
+
+    /// Drop all recorded samples.
+    void Reset() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (auto &buckets : _buckets) {
+        buckets.fill(0u);
+      }
+      _max_us.fill(0u);
+      _count = 0u;
+    }
+
+  private:
+
+    /// Bucket i holds samples in [2^i, 2^(i+1)) microseconds; 26 buckets
+    /// reach past one minute.
+    static constexpr size_t bucket_count = 26u;
+
+    using Buckets = std::array<uint64_t, bucket_count>;
+
+    static uint64_t Elapsed(uint64_t from_us, uint64_t to_us) {
+      // clamp, the client and server clocks may be skewed.
+      return to_us > from_us ? to_us - from_us : 0u;
+    }
+
+    static size_t BucketFor(uint64_t micros) {
+      size_t bucket = 0u;
+      while ((micros >>= 1u) && (bucket + 1u < bucket_count)) {
+        ++bucket;
+      }
+      return bucket;
+    }
+
+    void AddSample(Stage stage, uint64_t micros) {
+      const auto i = static_cast<size_t>(stage);
+      ++_buckets[i][BucketFor(micros)];
+      _max_us[i] = std::max(_max_us[i], micros);
+      if (stage == Stage::Total) {
+        ++_count;
+      }
+    }
+
+    uint64_t Percentile(const Buckets &buckets, double fraction) const {
+      if (_count == 0u) {
+        return 0u;
+      }
+      const auto threshold = static_cast<uint64_t>(fraction * static_cast<double>(_count));
+      uint64_t seen = 0u;
+      for (auto bucket = 0u; bucket < bucket_count; ++bucket) {
+        seen += buckets[bucket];
+        if (seen > threshold) {
+          return uint64_t(1u) << (bucket + 1u);
+        }
+      }
+      return _max_us[static_cast<size_t>(Stage::Total)];
+    }
+
+    mutable std::mutex _mutex;
+
+    std::array<Buckets, static_cast<size_t>(Stage::SIZE)> _buckets{};
+
+    std::array<uint64_t, static_cast<size_t>(Stage::SIZE)> _max_us{};
+
+    uint64_t _count = 0u;
+  };
+
+} // namespace sensor
+} // namespace carla
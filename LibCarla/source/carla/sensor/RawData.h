@@ -15,6 +15,10 @@
 namespace carla {
 namespace sensor {
 
+namespace s11n {
+  class LidarSerializer;
+}
+
   /// Wrapper around the raw data generated by a sensor plus some useful
   /// meta-information.
   class RawData {
@@ -47,6 +51,26 @@ namespace sensor {
      return GetHeader().sensor_transform;
     }
 
+    /// Id of this frame's trip through the pipeline, stamped at capture.
+    uint64_t GetTraceId() const {
+     return GetHeader().trace_id;
+    }
+
+    /// Wall clock at capture, microseconds since the Unix epoch.
+    uint64_t GetCaptureTimeUs() const {
+     return GetHeader().capture_time_us;
+    }
+
+    /// Wall clock at the start of serialization on the simulator.
+    uint64_t GetSerializeTimeUs() const {
+     return GetHeader().capture_time_us + GetHeader().serialize_delta_us;
+    }
+
+    /// Wall clock when the message was handed to the transport.
+    uint64_t GetSendTimeUs() const {
+     return GetHeader().capture_time_us + GetHeader().send_delta_us;
+    }
+
     /// Begin iterator to the data generated by the sensor.
     auto begin() noexcept {
      return _buffer.begin() + HeaderSerializer::header_offset;
@@ -89,6 +113,9 @@ namespace sensor {
     template <typename... Items>
     friend class CompositeSerializer;
 
+    // Rebuilds the buffer when expanding quantized point streams.
+    friend class s11n::LidarSerializer;
+
     RawData(Buffer &&buffer) : _buffer(std::move(buffer)) {}
 
     Buffer _buffer;
@@ -28,7 +28,12 @@ namespace sensor {
         _sensor_transform(sensor_transform) {}
 
     explicit SensorData(const RawData &data)
-      : SensorData(data.GetFrame(), data.GetTimestamp(), data.GetSensorTransform()) {}
+      : SensorData(data.GetFrame(), data.GetTimestamp(), data.GetSensorTransform()) {
+      _trace_id = data.GetTraceId();
+      _capture_time_us = data.GetCaptureTimeUs();
+      _serialize_time_us = data.GetSerializeTimeUs();
+      _send_time_us = data.GetSendTimeUs();
+    }
 
   public:
 
@@ -49,6 +54,49 @@ namespace sensor {
       return _sensor_transform;
     }
 
+    /// @name Frame latency trace
+    ///
+    /// Wall-clock timestamps, in microseconds since the Unix epoch, tracing
+    /// this frame from capture to deserialization. Capture, serialize and
+    /// send are stamped with the simulator's clock, receive and deserialize
+    /// with this machine's; remote runs inherit whatever skew exists between
+    /// the two. All zero when the data did not come from a stream.
+    /// @{
+
+    /// Id of this frame's trip through the pipeline, stamped at capture;
+    /// correlates client measurements with server logs.
+    uint64_t GetTraceId() const {
+      return _trace_id;
+    }
+
+    /// Wall clock at capture on the simulator.
+    uint64_t GetCaptureTimeUs() const {
+      return _capture_time_us;
+    }
+
+    /// Start of serialization on the simulator; the gap from capture is the
+    /// time spent queued behind other sends.
+    uint64_t GetSerializeTimeUs() const {
+      return _serialize_time_us;
+    }
+
+    /// Hand-off of the message to the transport on the simulator.
+    uint64_t GetSendTimeUs() const {
+      return _send_time_us;
+    }
+
+    /// Arrival of the complete message on this machine.
+    uint64_t GetReceiveTimeUs() const {
+      return _receive_time_us;
+    }
+
+    /// End of deserialization on this machine.
+    uint64_t GetDeserializeTimeUs() const {
+      return _deserialize_time_us;
+    }
+
+    /// @}
+
   protected:
 
     const auto &GetEpisode() const {
@@ -61,11 +109,26 @@ namespace sensor {
     friend class client::detail::Simulator;
     client::detail::WeakEpisodeProxy _episode;
 
+    /// Stamps the receive and deserialize times.
+    friend class DecodeDispatcher;
+
     const size_t _frame;
 
     const double _timestamp;
 
     const rpc::Transform _sensor_transform;
+
+    uint64_t _trace_id = 0u;
+
+    uint64_t _capture_time_us = 0u;
+
+    uint64_t _serialize_time_us = 0u;
+
+    uint64_t _send_time_us = 0u;
+
+    uint64_t _receive_time_us = 0u;
+
+    uint64_t _deserialize_time_us = 0u;
   };
 
 } // namespace sensor
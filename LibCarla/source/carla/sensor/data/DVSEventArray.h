@@ -7,18 +7,29 @@
 #pragma once
 
 #include "carla/Debug.h"
-#include "carla/sensor/data/Array.h"
+#include "carla/Exception.h"
+#include "carla/sensor/SensorData.h"
 #include "carla/sensor/data/DVSEvent.h"
 #include "carla/sensor/data/Color.h"
 #include "carla/sensor/s11n/DVSEventArraySerializer.h"
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <utility>
+
 namespace carla {
 namespace sensor {
 namespace data {
 
-  /// An array of DVS Events in an image structure HxW
-  class DVSEventArray : public Array<DVSEvent> {
-    using Super = Array<DVSEvent>;
+  /// An array of DVS Events in an image structure HxW.
+  ///
+  /// The events are stored in structure-of-arrays layout, one contiguous
+  /// array per field sorted by timestamp, plus a per-millisecond timestamp
+  /// index; see s11n::DVSEventArraySerializer for the exact layout. Events
+  /// can still be iterated one by one, but they are synthesized on access.
+  class DVSEventArray : public SensorData {
+    using Super = SensorData;
   protected:
 
     using Serializer = s11n::DVSEventArraySerializer;
@@ -26,18 +37,118 @@ namespace data {
     friend Serializer;
 
     explicit DVSEventArray(RawData &&data)
-      : Super(Serializer::header_offset, std::move(data)) {
+      : Super(data),
+        _data(std::move(data)) {
+      DEBUG_ASSERT(_data.size() >= Serializer::header_offset);
+      DEBUG_ASSERT(_data.size() >=
+          Serializer::pol_offset(Serializer::DeserializeHeader(_data)) +
+          Serializer::DeserializeHeader(_data).num_events);
     }
 
   private:
 
     const auto &GetHeader() const {
-      return Serializer::DeserializeHeader(Super::GetRawData());
+      return Serializer::DeserializeHeader(_data);
     }
   public:
 
     using event_type = DVSEvent;
 
+    /// Iterator over the events, synthesizing each one from the per-field
+    /// arrays; dereferences by value.
+    class const_iterator {
+    public:
+
+      using difference_type = std::ptrdiff_t;
+      using value_type = DVSEvent;
+      using pointer = const DVSEvent *;
+      using reference = DVSEvent;
+      using iterator_category = std::input_iterator_tag;
+
+      DVSEvent operator*() const {
+        return (*_parent)[_pos];
+      }
+
+      const_iterator &operator++() {
+        ++_pos;
+        return *this;
+      }
+
+      const_iterator operator++(int) {
+        auto tmp = *this;
+        ++_pos;
+        return tmp;
+      }
+
+      bool operator==(const const_iterator &rhs) const {
+        return _pos == rhs._pos;
+      }
+
+      bool operator!=(const const_iterator &rhs) const {
+        return !(*this == rhs);
+      }
+
+    private:
+
+      friend class DVSEventArray;
+
+      const_iterator(const DVSEventArray *parent, size_t pos)
+        : _parent(parent),
+          _pos(pos) {}
+
+      const DVSEventArray *_parent;
+
+      size_t _pos;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const {
+      return const_iterator(this, 0u);
+    }
+
+    const_iterator end() const {
+      return const_iterator(this, size());
+    }
+
+    size_t size() const {
+      return GetHeader().num_events;
+    }
+
+    bool empty() const {
+      return size() == 0u;
+    }
+
+    DVSEvent operator[](size_t pos) const {
+      return DVSEvent(
+          GetXData()[pos],
+          GetYData()[pos],
+          GetTimeData()[pos],
+          GetPolarityData()[pos] != 0u);
+    }
+
+    DVSEvent at(size_t pos) const {
+      if (!(pos < size())) {
+        throw_exception(std::out_of_range("DVSEventArray index out of range"));
+      }
+      return operator[](pos);
+    }
+
+    /// Overwrite the event at @a pos, fields are written back into the
+    /// per-field arrays. Note that the timestamp index is not rebuilt, time
+    /// window queries are only valid while events remain sorted.
+    void SetEvent(size_t pos, const DVSEvent &event) {
+      if (!(pos < size())) {
+        throw_exception(std::out_of_range("DVSEventArray index out of range"));
+      }
+      const auto &header = GetHeader();
+      auto *begin = _data.begin();
+      reinterpret_cast<uint16_t *>(begin + Serializer::x_offset(header))[pos] = event.x;
+      reinterpret_cast<uint16_t *>(begin + Serializer::y_offset(header))[pos] = event.y;
+      reinterpret_cast<std::int64_t *>(begin + Serializer::times_offset(header))[pos] = event.t;
+      reinterpret_cast<uint8_t *>(begin + Serializer::pol_offset(header))[pos] = event.pol ? 1u : 0u;
+    }
+
     /// Get image width in pixels.
     auto GetWidth() const {
       return GetHeader().width;
@@ -53,12 +164,69 @@ namespace data {
       return GetHeader().fov_angle;
     }
 
+    /// @name Direct access to the per-field arrays, each one contiguous and
+    /// of size() elements.
+    /// @{
+
+    /// Timestamps of all events in nanoseconds, sorted ascending.
+    const std::int64_t *GetTimeData() const {
+      return reinterpret_cast<const std::int64_t *>(
+          _data.begin() + Serializer::times_offset(GetHeader()));
+    }
+
+    /// X coordinates of all events.
+    const uint16_t *GetXData() const {
+      return reinterpret_cast<const uint16_t *>(
+          _data.begin() + Serializer::x_offset(GetHeader()));
+    }
+
+    /// Y coordinates of all events.
+    const uint16_t *GetYData() const {
+      return reinterpret_cast<const uint16_t *>(
+          _data.begin() + Serializer::y_offset(GetHeader()));
+    }
+
+    /// Polarities of all events, 1 positive, 0 negative.
+    const uint8_t *GetPolarityData() const {
+      return reinterpret_cast<const uint8_t *>(
+          _data.begin() + Serializer::pol_offset(GetHeader()));
+    }
+
+    /// @}
+
+    /// Raw bytes of the serialized payload, the per-field arrays plus the
+    /// timestamp index; see s11n::DVSEventArraySerializer for the layout.
+    unsigned char *GetRawPayload() {
+      return _data.begin();
+    }
+
+    /// @copydoc GetRawPayload()
+    const unsigned char *GetRawPayload() const {
+      return _data.begin();
+    }
+
+    /// Size in bytes of the serialized payload.
+    size_t GetRawPayloadSize() const {
+      return _data.size();
+    }
+
+    /// Positions [first, second) of the events with timestamp within
+    /// [ @a t_begin, @a t_end ) nanoseconds. The per-millisecond index
+    /// narrows each lookup to a single bucket, so the search is logarithmic
+    /// in the bucket size rather than linear in the number of events.
+    std::pair<size_t, size_t> GetEventsInTimeWindow(std::int64_t t_begin, std::int64_t t_end) const {
+      return {LowerBound(t_begin), LowerBound(t_end)};
+    }
+
     ///  Get an event "frame" image for visualization
     std::vector<Color> ToImage() const {
       std::vector<Color> img(GetHeight() * GetWidth());
-      for (const auto &event : *this) {
-        size_t index = (GetWidth() * event.y) + event.x;
-        if (event.pol == true) {
+      const auto *xs = GetXData();
+      const auto *ys = GetYData();
+      const auto *pols = GetPolarityData();
+      for (auto i = 0u; i < size(); ++i) {
+        size_t index = (GetWidth() * ys[i]) + xs[i];
+        if (pols[i] != 0u) {
           // Blue is positive
           img[index].b = 255u;
         } else {
@@ -72,6 +240,7 @@ namespace data {
     /// Get the array of events in pure vector format
     std::vector<std::vector<std::int64_t>> ToArray() const {
       std::vector<std::vector<std::int64_t>> array;
+      array.reserve(size());
       for (const auto &event : *this) {
         array.push_back({static_cast<std::int64_t>(event.x), static_cast<std::int64_t>(event.y), static_cast<std::int64_t>(event.t), (2*static_cast<std::int64_t>(event.pol)) - 1});
       }
@@ -80,40 +249,59 @@ namespace data {
 
     /// Get all events' x coordinate for convenience
     std::vector<std::uint16_t> ToArrayX() const {
-      std::vector<std::uint16_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.x);
-      }
-      return array;
+      return {GetXData(), GetXData() + size()};
     }
 
     /// Get all events' y coordinate for convenience
     std::vector<std::uint16_t> ToArrayY() const {
-      std::vector<std::uint16_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.y);
-      }
-      return array;
+      return {GetYData(), GetYData() + size()};
     }
 
     /// Get all events' timestamp for convenience
     std::vector<std::int64_t> ToArrayT() const {
-      std::vector<std::int64_t> array;
-      for (const auto &event : *this) {
-        array.push_back(event.t);
-      }
-      return array;
+      return {GetTimeData(), GetTimeData() + size()};
     }
 
     /// Get all events' polarity for convenience
     std::vector<short> ToArrayPol() const {
       std::vector<short> array;
-      for (const auto &event : *this) {
-        array.push_back(2*static_cast<short>(event.pol) - 1);
+      array.reserve(size());
+      const auto *pols = GetPolarityData();
+      for (auto i = 0u; i < size(); ++i) {
+        array.push_back(2*static_cast<short>(pols[i]) - 1);
       }
       return array;
     }
 
+  private:
+
+    /// Position of the first event with timestamp greater than or equal to
+    /// @a t, seeding the binary search with the timestamp index bucket.
+    size_t LowerBound(std::int64_t t) const {
+      const auto num_events = size();
+      if (num_events == 0u) {
+        return 0u;
+      }
+      const auto *times = GetTimeData();
+      if (t <= times[0u]) {
+        return 0u;
+      }
+      if (t > times[num_events - 1u]) {
+        return num_events;
+      }
+      const auto &header = GetHeader();
+      const auto *index = reinterpret_cast<const uint32_t *>(
+          _data.begin() + Serializer::index_offset(header));
+      const auto bucket = static_cast<size_t>(
+          (t - times[0u]) / Serializer::time_index_resolution);
+      DEBUG_ASSERT(bucket < header.index_count);
+      const size_t first = index[bucket];
+      const size_t last = (bucket + 1u < header.index_count) ? index[bucket + 1u] : num_events;
+      return static_cast<size_t>(
+          std::lower_bound(times + first, times + last, t) - times);
+    }
+
+    RawData _data;
   };
 
 } // namespace data
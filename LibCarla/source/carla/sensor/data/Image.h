@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include "carla/Buffer.h"
 #include "carla/sensor/data/Color.h"
 #include "carla/sensor/data/ImageTmpl.h"
 
+#include <cstdint>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -16,6 +19,41 @@ namespace data {
   /// An image of 32-bit BGRA colors.
   using Image = ImageTmpl<Color>;
 
+  /// Minimal dlpack-style descriptor of the pixel data of an Image. The
+  /// codes match DLPack's DLDeviceType and DLDataTypeCode, so language
+  /// bindings can wrap it into a DLPack capsule (and from there into a
+  /// torch or numpy tensor) without copying the frame and without this
+  /// library linking against any GPU runtime.
+  struct ImageTensorView {
+    void *data = nullptr;
+    int32_t device_type = 1u; ///< 1 = kDLCPU, 3 = kDLCUDAHost.
+    uint8_t dtype_code = 1u;  ///< 1 = kDLUInt.
+    uint8_t dtype_bits = 8u;
+    int32_t ndim = 3u;
+    int64_t shape[3] = {0, 0, 0};   ///< Height, width, channels.
+    int64_t strides[3] = {0, 0, 0}; ///< In elements, row-major.
+  };
+
+  /// Describe the pixels of @a image as a height x width x 4 tensor of
+  /// uint8. The view borrows the image memory, it is valid only while
+  /// @a image is alive. The device is reported as kDLCUDAHost while a
+  /// pinned memory allocator is installed (see
+  /// Buffer::SetPinnedMemoryAllocator); install it before connecting so
+  /// every received frame lands in page-locked memory and uploads with a
+  /// single async DMA.
+  inline ImageTensorView MakeTensorView(Image &image) {
+    ImageTensorView view;
+    view.data = image.data();
+    view.device_type = Buffer::HasPinnedMemoryAllocator() ? 3 : 1;
+    view.shape[0] = static_cast<int64_t>(image.GetHeight());
+    view.shape[1] = static_cast<int64_t>(image.GetWidth());
+    view.shape[2] = sizeof(Color);
+    view.strides[0] = view.shape[1] * view.shape[2];
+    view.strides[1] = view.shape[2];
+    view.strides[2] = 1;
+    return view;
+  }
+
 } // namespace data
 } // namespace sensor
 } // namespace carla
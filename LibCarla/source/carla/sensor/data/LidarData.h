@@ -18,6 +18,7 @@ namespace sensor {
 namespace s11n {
   class LidarSerializer;
   class LidarHeaderView;
+  class LidarDataWriter;
 }
 
 namespace data {
@@ -110,6 +111,7 @@ namespace data {
 
     friend class s11n::LidarSerializer;
     friend class s11n::LidarHeaderView;
+    friend class s11n::LidarDataWriter;
   };
 
 } // namespace s11n
@@ -0,0 +1,93 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/sensor/data/Array.h"
+#include "carla/sensor/data/Color.h"
+#include "carla/sensor/s11n/MultiImageSerializer.h"
+
+namespace carla {
+namespace sensor {
+namespace data {
+
+  /// Set of images of the same size captured from the same pose by the
+  /// multi-output camera. The pixel buffers are concatenated in a fixed
+  /// order: color, depth, semantic segmentation; depth and semantic use the
+  /// same per-pixel encoding as the stand-alone depth and semantic
+  /// segmentation cameras.
+  class MultiImage : public Array<Color> {
+    using Super = Array<Color>;
+  protected:
+
+    using Serializer = s11n::MultiImageSerializer;
+
+    friend Serializer;
+
+    explicit MultiImage(RawData &&data)
+      : Super(Serializer::header_offset, std::move(data)) {
+      DEBUG_ONLY(const auto &header = Serializer::DeserializeHeader(Super::GetRawData());)
+      DEBUG_ASSERT(header.image_count * header.width * header.height == Super::size());
+    }
+
+  private:
+
+    const auto &GetHeader() const {
+      return Serializer::DeserializeHeader(Super::GetRawData());
+    }
+
+  public:
+
+    using pixel_type = Color;
+
+    /// Get image width in pixels, the same for every image of the set.
+    auto GetWidth() const {
+      return GetHeader().width;
+    }
+
+    /// Get image height in pixels, the same for every image of the set.
+    auto GetHeight() const {
+      return GetHeader().height;
+    }
+
+    /// Get horizontal field of view of the images in degrees.
+    auto GetFOVAngle() const {
+      return GetHeader().fov_angle;
+    }
+
+    /// Get the number of images in the set.
+    auto GetImageCount() const {
+      return GetHeader().image_count;
+    }
+
+    /// Get the number of pixels of each individual image.
+    size_type GetImageSize() const {
+      return GetWidth() * GetHeight();
+    }
+
+    /// Get the pixels of the image at @a index within the set.
+    const_pointer GetImageData(size_type index) const {
+      DEBUG_ASSERT(index < GetImageCount());
+      return data() + index * GetImageSize();
+    }
+
+    const_pointer GetColorData() const {
+      return GetImageData(0u);
+    }
+
+    const_pointer GetDepthData() const {
+      return GetImageData(1u);
+    }
+
+    const_pointer GetSemanticSegmentationData() const {
+      return GetImageData(2u);
+    }
+  };
+
+} // namespace data
+} // namespace sensor
+} // namespace carla
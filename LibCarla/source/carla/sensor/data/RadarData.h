@@ -35,6 +35,10 @@ namespace data {
 
     constexpr static auto detection_size = sizeof(RadarDetection);
 
+    /// Azimuth sectors the detections are grouped by when serialized; see
+    /// s11n::RadarSerializer.
+    constexpr static uint32_t sector_count = 16u;
+
     RadarData &operator=(RadarData &&) = default;
 
     /// Set a new resolution for the RadarData.
@@ -11,6 +11,8 @@
 #include "carla/sensor/s11n/RadarSerializer.h"
 #include "carla/sensor/data/RadarData.h"
 
+#include <boost/range/iterator_range.hpp>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -26,13 +28,37 @@ namespace data {
     friend Serializer;
 
     explicit RadarMeasurement(RawData &&data)
-      : Super(0u, std::move(data)) {}
+      : Super(std::move(data), [](const RawData &d) {
+      return Serializer::GetHeaderOffset(d);
+    }) {}
 
   public:
 
     Super::size_type GetDetectionAmount() const {
       return Super::size();
     }
+
+    /// Number of azimuth sectors the detections are grouped by.
+    auto GetSectorCount() const {
+      return Serializer::GetSectorCount(Super::GetRawData());
+    }
+
+    /// Number of detections whose azimuth fell in @a sector.
+    auto GetSectorPointCount(size_t sector) const {
+      return Serializer::GetSectorPointCount(Super::GetRawData(), sector);
+    }
+
+    /// The detections of @a sector as a range over this measurement's
+    /// memory; nothing is copied, the range is valid while the measurement
+    /// is alive. Sector 0 starts at azimuth -pi.
+    boost::iterator_range<Super::const_iterator> GetSectorDetections(size_t sector) const {
+      DEBUG_ASSERT(sector < GetSectorCount());
+      auto begin = Super::begin();
+      for (auto s = 0u; s < sector; ++s) {
+        begin += GetSectorPointCount(s);
+      }
+      return boost::make_iterator_range(begin, begin + GetSectorPointCount(sector));
+    }
   };
 
 } // namespace data
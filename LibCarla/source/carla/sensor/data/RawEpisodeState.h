@@ -62,6 +62,12 @@ namespace data {
       return GetHeader().simulation_state;
     }
 
+    /// Whether this frame only carries the actors that changed since the
+    /// previous frame, rather than the full episode state.
+    bool IsDeltaFrame() const {
+      return (GetSimulationState() & Serializer::SimulationState::DeltaFrame) != 0;
+    }
+
   };
 
 } // namespace data
@@ -46,6 +46,10 @@ namespace data {
   ///      Xn, Yn, Zn, Cos(THn), idx_n, tag_n
   ///    }
   ///
+  /// When serialized, a per-channel azimuth sector index is appended to the
+  /// header and the points of each channel are grouped by sector; see
+  /// s11n::SemanticLidarSerializer.
+  ///
 
   #pragma pack(push, 1)
   class SemanticLidarDetection {
@@ -89,6 +93,11 @@ namespace data {
     };
 
   public:
+
+    /// Azimuth sectors of the per-channel index appended at serialization
+    /// time, mapping [-pi, pi) onto [0, sector_count).
+    constexpr static uint32_t sector_count = 16u;
+
     explicit SemanticLidarData(uint32_t ChannelCount = 0u)
       : _header(Index::SIZE + ChannelCount, 0u) {
       _header[Index::ChannelCount] = ChannelCount;
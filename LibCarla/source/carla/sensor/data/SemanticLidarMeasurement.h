@@ -11,6 +11,8 @@
 #include "carla/sensor/data/Array.h"
 #include "carla/sensor/s11n/SemanticLidarSerializer.h"
 
+#include <boost/range/iterator_range.hpp>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -55,6 +57,39 @@ namespace data {
     auto GetPointCount(size_t channel) const {
       return GetHeader().GetPointCount(channel);
     }
+
+    /// Number of azimuth sectors the points of each channel are grouped by.
+    auto GetSectorCount() const {
+      return data::SemanticLidarData::sector_count;
+    }
+
+    /// Number of points of @a channel whose azimuth fell in @a sector.
+    auto GetSectorPointCount(size_t channel, size_t sector) const {
+      return GetHeader().GetSectorPointCount(channel, sector);
+    }
+
+    /// The points of @a channel as a range over this measurement's memory;
+    /// nothing is copied, the range is valid while the measurement is alive.
+    boost::iterator_range<Super::const_iterator> GetChannelDetections(size_t channel) const {
+      DEBUG_ASSERT(channel < GetChannelCount());
+      auto begin = Super::begin();
+      for (auto c = 0u; c < channel; ++c) {
+        begin += GetPointCount(c);
+      }
+      return boost::make_iterator_range(begin, begin + GetPointCount(channel));
+    }
+
+    /// The points of @a channel whose azimuth falls in @a sector, again as a
+    /// range over this measurement's memory. Sector 0 starts at azimuth -pi.
+    boost::iterator_range<Super::const_iterator> GetSectorDetections(size_t channel, size_t sector) const {
+      DEBUG_ASSERT(sector < GetSectorCount());
+      auto channel_range = GetChannelDetections(channel);
+      auto begin = channel_range.begin();
+      for (auto s = 0u; s < sector; ++s) {
+        begin += GetSectorPointCount(channel, s);
+      }
+      return boost::make_iterator_range(begin, begin + GetSectorPointCount(channel, sector));
+    }
   };
 
 } // namespace data
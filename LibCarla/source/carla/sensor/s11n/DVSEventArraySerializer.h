@@ -10,6 +10,7 @@
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/data/DVSEvent.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -21,6 +22,17 @@ namespace sensor {
 namespace s11n {
 
   /// Serializes events array generated by DVS camera sensors.
+  ///
+  /// The events are shipped in structure-of-arrays layout so that per-field
+  /// scans (all timestamps, all polarities...) touch contiguous memory. The
+  /// payload is laid out as
+  ///
+  ///    {header}{t int64[n]}{index uint32[m]}{x uint16[n]}{y uint16[n]}{pol uint8[n]}
+  ///
+  /// where the index holds, per millisecond of event time, the position of
+  /// the first event of that millisecond; events are serialized sorted by
+  /// timestamp, so time-window queries only need to binary search within a
+  /// single bucket.
   class DVSEventArraySerializer {
   public:
 
@@ -29,45 +41,108 @@ namespace s11n {
       uint32_t width;
       uint32_t height;
       float fov_angle;
+      uint32_t num_events;
+      /// Number of entries of the per-millisecond timestamp index.
+      uint32_t index_count;
+      /// Unused, keeps the timestamp array that follows 8-byte aligned.
+      uint32_t padding;
     };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(DVSHeader);
+
+    /// Resolution of the timestamp index, one bucket per millisecond of
+    /// event time (event timestamps are in nanoseconds).
+    constexpr static std::int64_t time_index_resolution = 1000000;
+
     using DVSEventArray = std::vector<data::DVSEvent>;
 
     static const DVSHeader &DeserializeHeader(const RawData &data) {
       return *reinterpret_cast<const DVSHeader *>(data.begin());
     }
 
+    /// @name Offsets of the per-field arrays, relative to the start of the
+    /// payload.
+    /// @{
+
+    static size_t times_offset(const DVSHeader &) {
+      return header_offset;
+    }
+
+    static size_t index_offset(const DVSHeader &header) {
+      return times_offset(header) + header.num_events * sizeof(std::int64_t);
+    }
+
+    static size_t x_offset(const DVSHeader &header) {
+      return index_offset(header) + header.index_count * sizeof(uint32_t);
+    }
+
+    static size_t y_offset(const DVSHeader &header) {
+      return x_offset(header) + header.num_events * sizeof(uint16_t);
+    }
+
+    static size_t pol_offset(const DVSHeader &header) {
+      return y_offset(header) + header.num_events * sizeof(uint16_t);
+    }
+
+    /// @}
+
     template <typename Sensor>
-    static Buffer Serialize(const Sensor &sensor, const DVSEventArray &events, Buffer &&output);
+    static Buffer Serialize(const Sensor &sensor, DVSEventArray &&events, Buffer &&output);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
   };
 
   template <typename Sensor>
-  inline Buffer DVSEventArraySerializer::Serialize(const Sensor &sensor, const DVSEventArray &events, Buffer &&output) {
-    DEBUG_ASSERT(events.size() > sizeof(DVSHeader));
-    DVSHeader header = {
-      sensor.GetImageWidth(),
-      sensor.GetImageHeight(),
-      sensor.GetFOVAngle(),
-    };
+  inline Buffer DVSEventArraySerializer::Serialize(const Sensor &sensor, DVSEventArray &&events, Buffer &&output) {
+    // Sort the events by increasing timestamp, this is what most event
+    // processing algorithms expect and what the timestamp index needs;
+    // done here so the cost lands on whichever thread serializes
+    if (!std::is_sorted(events.begin(), events.end(),
+        [](const data::DVSEvent &lhs, const data::DVSEvent &rhs) { return lhs.t < rhs.t; })) {
+      std::sort(events.begin(), events.end(),
+          [](const data::DVSEvent &lhs, const data::DVSEvent &rhs) { return lhs.t < rhs.t; });
+    }
 
-    /// Reset the output buffer
-    output.reset(sizeof(DVSHeader) + (events.size() * sizeof(data::DVSEvent)));
+    DVSHeader header;
+    header.width = sensor.GetImageWidth();
+    header.height = sensor.GetImageHeight();
+    header.fov_angle = sensor.GetFOVAngle();
+    header.num_events = static_cast<uint32_t>(events.size());
+    header.index_count = events.empty() ? 0u : static_cast<uint32_t>(
+        (events.back().t - events.front().t) / time_index_resolution + 1);
+    header.padding = 0u;
 
-    /// Pointer to data in buffer
-    unsigned char *it = output.data();
+    /// Reset the output buffer
+    output.reset(static_cast<Buffer::size_type>(
+        pol_offset(header) + header.num_events * sizeof(uint8_t)));
 
     /// Copy the header into the output buffer
-    std::memcpy(it, reinterpret_cast<const void *>(&header), sizeof(header));
-    it += sizeof(DVSHeader);
+    std::memcpy(output.data(), reinterpret_cast<const void *>(&header), sizeof(header));
+
+    /// Transpose the events into one contiguous array per field
+    auto *times = reinterpret_cast<std::int64_t *>(output.data() + times_offset(header));
+    auto *index = reinterpret_cast<uint32_t *>(output.data() + index_offset(header));
+    auto *xs = reinterpret_cast<uint16_t *>(output.data() + x_offset(header));
+    auto *ys = reinterpret_cast<uint16_t *>(output.data() + y_offset(header));
+    auto *pols = reinterpret_cast<uint8_t *>(output.data() + pol_offset(header));
+
+    for (auto i = 0u; i < events.size(); ++i) {
+      times[i] = events[i].t;
+      xs[i] = events[i].x;
+      ys[i] = events[i].y;
+      pols[i] = events[i].pol ? 1u : 0u;
+    }
 
-    /// Copy the events into the output buffer
-    for (auto e : events) {
-      std::memcpy(it, reinterpret_cast<const void *>(&e), sizeof(data::DVSEvent));
-      it += sizeof(data::DVSEvent);
+    /// Build the timestamp index; events are sorted so both cursors only
+    /// move forward and this is linear
+    size_t pos = 0u;
+    for (auto bucket = 0u; bucket < header.index_count; ++bucket) {
+      const auto bucket_begin = events.front().t + bucket * time_index_resolution;
+      while ((pos < events.size()) && (events[pos].t < bucket_begin)) {
+        ++pos;
+      }
+      index[bucket] = static_cast<uint32_t>(pos);
     }
     return std::move(output);
   }
@@ -24,13 +24,21 @@ namespace sensor {
 namespace s11n {
 
   /// Serializes the current state of the whole episode.
+  ///
+  /// The payload after the header is an array of ActorDynamicState. On a
+  /// keyframe it covers every actor in the episode; on a frame flagged with
+  /// SimulationState::DeltaFrame it only carries the actors whose state
+  /// changed since the previous frame, and the receiver patches them over
+  /// its previous state. The sender emits a keyframe periodically and
+  /// whenever the actor set changes, so delta frames never encode removals.
   class EpisodeStateSerializer {
   public:
 
     enum SimulationState {
       None               = (0x0 << 0),
       MapChange          = (0x1 << 0),
-      PendingLightUpdate = (0x1 << 1)
+      PendingLightUpdate = (0x1 << 1),
+      DeltaFrame         = (0x1 << 2)
     };
 
 #pragma pack(push, 1)
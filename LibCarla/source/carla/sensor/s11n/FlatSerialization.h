@@ -0,0 +1,53 @@
+// Copyright (c) 2019 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Debug.h"
+#include "carla/sensor/RawData.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace carla {
+namespace sensor {
+namespace s11n {
+
+  /// Serialization for trivially copyable, fixed-layout payloads; the bytes
+  /// of the value are the wire format. High-rate event sensors (IMU, GNSS)
+  /// use this instead of MsgPack, whose per-message unpacking costs more
+  /// than the transport for payloads this small.
+  ///
+  /// Only types whose layout is identical on every platform we ship (no
+  /// padding, fixed-width members) may use this; both ends of the stream
+  /// must agree on the format.
+  class FlatSerialization {
+  public:
+
+    template <typename T>
+    static Buffer Pack(const T &data) {
+      static_assert(
+          std::is_trivially_copyable<T>::value,
+          "Flat serialization requires a trivially copyable type.");
+      return Buffer(reinterpret_cast<const Buffer::value_type *>(&data), sizeof(T));
+    }
+
+    template <typename T>
+    static T UnPack(const RawData &message) {
+      static_assert(
+          std::is_trivially_copyable<T>::value,
+          "Flat serialization requires a trivially copyable type.");
+      DEBUG_ASSERT(message.size() == sizeof(T));
+      T data;
+      std::memcpy(&data, message.begin(), sizeof(T));
+      return data;
+    }
+  };
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
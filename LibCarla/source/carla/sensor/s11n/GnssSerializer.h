@@ -10,6 +10,7 @@
 #include "carla/geom/GeoLocation.h"
 #include "carla/rpc/ActorId.h"
 #include "carla/sensor/RawData.h"
+#include "carla/sensor/s11n/FlatSerialization.h"
 
 #include <cstdint>
 #include <cstring>
@@ -25,7 +26,7 @@ namespace s11n {
   public:
 
     static geom::GeoLocation DeserializeRawData(const RawData &message) {
-      return MsgPack::UnPack<geom::GeoLocation>(message.begin(), message.size());
+      return FlatSerialization::UnPack<geom::GeoLocation>(message);
     }
 
     template <typename SensorT>
@@ -33,7 +34,7 @@ namespace s11n {
         const SensorT &,
         const geom::GeoLocation &geo_location
         ) {
-      return MsgPack::Pack(geo_location);
+      return FlatSerialization::Pack(geo_location);
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
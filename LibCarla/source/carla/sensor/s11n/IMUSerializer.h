@@ -9,6 +9,7 @@
 #include "carla/Buffer.h"
 #include "carla/Memory.h"
 #include "carla/sensor/RawData.h"
+#include "carla/sensor/s11n/FlatSerialization.h"
 
 namespace carla {
 namespace sensor {
@@ -40,7 +41,7 @@ namespace s11n {
       const float compass);
 
     static Data DeserializeRawData(const RawData &message) {
-      return MsgPack::UnPack<Data>(message.begin(), message.size());
+      return FlatSerialization::UnPack<Data>(message);
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
@@ -52,7 +53,7 @@ namespace s11n {
       const geom::Vector3D &accelerometer,
       const geom::Vector3D &gyroscope,
       const float compass) {
-    return MsgPack::Pack(Data{accelerometer, gyroscope, compass});
+    return FlatSerialization::Pack(Data{accelerometer, gyroscope, compass});
   }
 
 } // namespace s11n
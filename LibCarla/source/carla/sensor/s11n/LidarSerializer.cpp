@@ -7,16 +7,53 @@
 
 #include "carla/sensor/data/LidarMeasurement.h"
 #include "carla/sensor/s11n/LidarSerializer.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
 
 namespace carla {
 namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> LidarSerializer::Deserialize(RawData &&data) {
+    if (DeserializeHeader(data).IsQuantized()) {
+      data = RawData{ExpandQuantizedPoints(data)};
+    }
     return SharedPtr<data::LidarMeasurement>(
         new data::LidarMeasurement{std::move(data)});
   }
 
+  Buffer LidarSerializer::ExpandQuantizedPoints(const RawData &data) {
+    using Index = data::LidarData::Index;
+    const auto header = DeserializeHeader(data);
+    const auto lidar_header_size = GetHeaderOffset(data);
+    const auto prefix_size = SensorHeaderSerializer::header_offset + lidar_header_size;
+    const auto num_points =
+        (data.size() - lidar_header_size) / sizeof(QuantizedLidarDetection);
+
+    Buffer expanded{static_cast<Buffer::size_type>(
+        prefix_size + num_points * 4u * sizeof(float))};
+    std::memcpy(expanded.data(), data._buffer.data(), prefix_size);
+
+    // Clear the quantized flag so the expanded buffer reads as a plain float
+    // stream.
+    const uint32_t channel_count = header.GetChannelCount();
+    std::memcpy(
+        expanded.data() + SensorHeaderSerializer::header_offset +
+            sizeof(uint32_t) * Index::ChannelCount,
+        &channel_count,
+        sizeof(uint32_t));
+
+    const auto *src = reinterpret_cast<const QuantizedLidarDetection *>(
+        data.begin() + lidar_header_size);
+    auto *dst = reinterpret_cast<float *>(expanded.data() + prefix_size);
+    for (size_t i = 0u; i < num_points; ++i) {
+      dst[4u * i]      = static_cast<float>(src[i].x) / 100.0f;
+      dst[4u * i + 1u] = static_cast<float>(src[i].y) / 100.0f;
+      dst[4u * i + 2u] = static_cast<float>(src[i].z) / 100.0f;
+      dst[4u * i + 3u] = static_cast<float>(src[i].intensity) / 65535.0f;
+    }
+    return expanded;
+  }
+
 } // namespace s11n
 } // namespace sensor
 } // namespace carla
@@ -11,6 +11,10 @@
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/data/LidarData.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace carla {
 namespace sensor {
 
@@ -27,12 +31,21 @@ namespace s11n {
     using Index = data::LidarData::Index;
 
   public:
+
+    /// Bit of the channel-count header word flagging that points travel as
+    /// 16-bit fixed point instead of floats.
+    static constexpr uint32_t QUANTIZED_FLAG = 0x80000000u;
+
     float GetHorizontalAngle() const {
       return reinterpret_cast<const float &>(_begin[Index::HorizontalAngle]);
     }
 
     uint32_t GetChannelCount() const {
-      return _begin[Index::ChannelCount];
+      return _begin[Index::ChannelCount] & ~QUANTIZED_FLAG;
+    }
+
+    bool IsQuantized() const {
+      return (_begin[Index::ChannelCount] & QUANTIZED_FLAG) != 0u;
     }
 
     uint32_t GetPointCount(size_t channel) const {
@@ -50,6 +63,126 @@ namespace s11n {
     const uint32_t *_begin;
   };
 
+  // ===========================================================================
+  // -- LidarDataWriter --------------------------------------------------------
+  // ===========================================================================
+
+#pragma pack(push, 1)
+  /// Wire format of one point on a quantized stream: centimeters in 16-bit
+  /// fixed point, intensity in 1/65535 steps.
+  struct QuantizedLidarDetection {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+    uint16_t intensity;
+  };
+#pragma pack(pop)
+
+  /// Writes a Lidar measurement directly into a Buffer, in the same layout
+  /// produced by LidarSerializer::Serialize. The sensor can append detections
+  /// as they are computed, without accumulating them in an intermediate point
+  /// vector; per-channel point counts are patched in the header as points are
+  /// written. Create one with LidarSerializer::MakeWriter, call WritePoint for
+  /// each detection and Finish to obtain the serialized buffer.
+  class LidarDataWriter {
+    using Index = data::LidarData::Index;
+
+  public:
+
+    LidarDataWriter() = default;
+
+    LidarDataWriter(LidarDataWriter &&) = default;
+    LidarDataWriter &operator=(LidarDataWriter &&) = default;
+
+    void SetHorizontalAngle(float angle) {
+      std::memcpy(&Header()[Index::HorizontalAngle], &angle, sizeof(uint32_t));
+    }
+
+    /// Grow the buffer up front for @a point_count points in total; points
+    /// beyond this count still grow the buffer as needed.
+    void Reserve(uint32_t point_count) {
+      const auto bytes = _offset + PointSize() * point_count;
+      if (bytes > _buffer.size()) {
+        _buffer.resize(bytes);
+      }
+    }
+
+    /// Append a detection to @a channel. Points must be written in channel
+    /// order, lower channels first.
+    void WritePoint(uint32_t channel, const data::LidarDetection &detection) {
+      const auto point_size = PointSize();
+      if (_offset + point_size > _buffer.size()) {
+        _buffer.resize(std::max<size_t>(2u * _buffer.size(), _offset + point_size));
+      }
+      if (_quantized) {
+        const QuantizedLidarDetection point = {
+            QuantizeCoordinate(detection.point.x),
+            QuantizeCoordinate(detection.point.y),
+            QuantizeCoordinate(detection.point.z),
+            QuantizeIntensity(detection.intensity)};
+        std::memcpy(_buffer.data() + _offset, &point, point_size);
+      } else {
+        const float point[4u] = {
+            detection.point.x,
+            detection.point.y,
+            detection.point.z,
+            detection.intensity};
+        std::memcpy(_buffer.data() + _offset, point, point_size);
+      }
+      _offset += point_size;
+      ++Header()[Index::SIZE + channel];
+    }
+
+    /// Trim the buffer to the bytes actually written and return it; this
+    /// writer is left empty.
+    Buffer Finish() {
+      _buffer.resize(_offset);
+      _offset = 0u;
+      return std::move(_buffer);
+    }
+
+  private:
+
+    friend class LidarSerializer;
+
+    LidarDataWriter(Buffer &&buffer, uint32_t channel_count, bool quantized)
+      : _buffer(std::move(buffer)),
+        _offset(sizeof(uint32_t) * (Index::SIZE + channel_count)),
+        _quantized(quantized) {
+      _buffer.resize(_offset);
+      std::memset(_buffer.data(), 0, _offset);
+      Header()[Index::ChannelCount] =
+          channel_count | (quantized ? LidarHeaderView::QUANTIZED_FLAG : 0u);
+    }
+
+    size_t PointSize() const {
+      return _quantized ? sizeof(QuantizedLidarDetection) : 4u * sizeof(float);
+    }
+
+    static int16_t QuantizeCoordinate(float value) {
+      // Points arrive in meters; the wire format stores centimeters, which
+      // bounds the quantized range to +-327.67m around the sensor.
+      const float centimeters = std::max(std::min(value * 100.0f, 32767.0f), -32768.0f);
+      return static_cast<int16_t>(std::lround(centimeters));
+    }
+
+    static uint16_t QuantizeIntensity(float value) {
+      const float clamped = std::max(std::min(value, 1.0f), 0.0f);
+      return static_cast<uint16_t>(std::lround(clamped * 65535.0f));
+    }
+
+    uint32_t *Header() {
+      return reinterpret_cast<uint32_t *>(_buffer.data());
+    }
+
+    Buffer _buffer;
+
+    /// Bytes written so far, header included.
+    size_t _offset = 0u;
+
+    bool _quantized = false;
+  };
+
   // ===========================================================================
   // -- LidarSerializer --------------------------------------------------------
   // ===========================================================================
@@ -67,13 +200,36 @@ namespace s11n {
       return sizeof(uint32_t) * (View.GetChannelCount() + data::LidarData::Index::SIZE);
     }
 
+    /// Make a writer over @a output for a measurement of @a channel_count
+    /// channels, so points can be serialized in place as they are produced.
+    /// With @a quantized, points travel as 16-bit fixed point (centimeter
+    /// resolution) and are expanded back to floats on deserialization.
+    static LidarDataWriter MakeWriter(
+        Buffer &&output,
+        uint32_t channel_count,
+        bool quantized = false) {
+      return LidarDataWriter{std::move(output), channel_count, quantized};
+    }
+
     template <typename Sensor>
     static Buffer Serialize(
         const Sensor &sensor,
         const data::LidarData &data,
         Buffer &&output);
 
+    /// Pass-through for measurements already laid out by a LidarDataWriter.
+    template <typename Sensor>
+    static Buffer Serialize(const Sensor &, Buffer &&output) {
+      return std::move(output);
+    }
+
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    /// Decode a quantized stream back into the float layout, so the
+    /// measurement keeps exposing an array of LidarDetection.
+    static Buffer ExpandQuantizedPoints(const RawData &data);
   };
 
   // ===========================================================================
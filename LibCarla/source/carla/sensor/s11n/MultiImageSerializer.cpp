@@ -0,0 +1,26 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/sensor/s11n/MultiImageSerializer.h"
+
+#include "carla/sensor/data/MultiImage.h"
+
+namespace carla {
+namespace sensor {
+namespace s11n {
+
+  SharedPtr<SensorData> MultiImageSerializer::Deserialize(RawData &&data) {
+    auto images = SharedPtr<data::MultiImage>(new data::MultiImage{std::move(data)});
+    // Set alpha of each pixel in the buffer to max to make it 100% opaque
+    for (auto &pixel : *images) {
+      pixel.a = 255u;
+    }
+    return images;
+  }
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
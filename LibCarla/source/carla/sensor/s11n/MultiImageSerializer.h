@@ -0,0 +1,69 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/sensor/RawData.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace carla {
+namespace sensor {
+
+  class SensorData;
+
+namespace s11n {
+
+  /// Serializes the payload of the multi-output camera: several image
+  /// buffers of the same size captured from the same pose, concatenated
+  /// after a single header. Shipping the frames in one message keeps them
+  /// implicitly synchronized and pays the stream overhead only once.
+  class MultiImageSerializer {
+  public:
+
+#pragma pack(push, 1)
+    struct MultiImageHeader {
+      uint32_t width;
+      uint32_t height;
+      float fov_angle;
+      uint32_t image_count;
+    };
+#pragma pack(pop)
+
+    constexpr static auto header_offset = sizeof(MultiImageHeader);
+
+    /// Images shipped per message, in order: color, depth, semantic
+    /// segmentation.
+    constexpr static uint32_t image_count = 3u;
+
+    static const MultiImageHeader &DeserializeHeader(const RawData &data) {
+      return *reinterpret_cast<const MultiImageHeader *>(data.begin());
+    }
+
+    template <typename Sensor>
+    static Buffer Serialize(const Sensor &sensor, Buffer &&bitmaps);
+
+    static SharedPtr<SensorData> Deserialize(RawData &&data);
+  };
+
+  template <typename Sensor>
+  inline Buffer MultiImageSerializer::Serialize(const Sensor &sensor, Buffer &&bitmaps) {
+    DEBUG_ASSERT(bitmaps.size() > sizeof(MultiImageHeader));
+    MultiImageHeader header = {
+      sensor.GetImageWidth(),
+      sensor.GetImageHeight(),
+      sensor.GetFOVAngle(),
+      image_count
+    };
+    std::memcpy(bitmaps.data(), reinterpret_cast<const void *>(&header), sizeof(header));
+    return std::move(bitmaps);
+  }
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
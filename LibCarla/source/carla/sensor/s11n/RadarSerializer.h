@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include "carla/Debug.h"
 #include "carla/Memory.h"
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/data/RadarData.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -25,9 +27,36 @@ namespace s11n {
   // ===========================================================================
 
   /// Serializes the data generated by Radar sensors.
+  ///
+  /// The serialized blob starts with a small index, an array of uint32_t's in
+  /// the following layout
+  ///
+  ///    {
+  ///      Sector count S,
+  ///      Detection count of sector 0,
+  ///      ...
+  ///      Detection count of sector S-1,
+  ///    }
+  ///
+  /// followed by the detections grouped by azimuth sector (sector 0 starting
+  /// at -pi), so consumers can take per-sector slices of the array without
+  /// re-partitioning it every frame.
   class RadarSerializer {
   public:
 
+    static uint32_t GetSectorCount(const RawData &data) {
+      return reinterpret_cast<const uint32_t *>(data.begin())[0u];
+    }
+
+    static uint32_t GetSectorPointCount(const RawData &data, size_t sector) {
+      DEBUG_ASSERT(sector < GetSectorCount(data));
+      return reinterpret_cast<const uint32_t *>(data.begin())[1u + sector];
+    }
+
+    static size_t GetHeaderOffset(const RawData &data) {
+      return sizeof(uint32_t) * (1u + GetSectorCount(data));
+    }
+
     template <typename Sensor>
     static Buffer Serialize(
         const Sensor &sensor,
@@ -35,6 +64,19 @@ namespace s11n {
         Buffer &&output);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    /// Azimuth sector of @a azimuth radians, mapping [-pi, pi) onto
+    /// [0, sector_count).
+    static uint32_t SectorOf(float azimuth, uint32_t sector_count) {
+      constexpr float pi = 3.14159265358979323846f;
+      const auto sector = static_cast<int32_t>(
+          (azimuth + pi) * static_cast<float>(sector_count) / (2.0f * pi));
+      return static_cast<uint32_t>(std::min(
+          std::max(sector, 0),
+          static_cast<int32_t>(sector_count) - 1));
+    }
   };
 
   template <typename Sensor>
@@ -42,7 +84,33 @@ namespace s11n {
       const Sensor &,
       const data::RadarData &measurement,
       Buffer &&output) {
-    output.copy_from(measurement._detections);
+    using data::RadarData;
+    using data::RadarDetection;
+    constexpr auto sectors = RadarData::sector_count;
+    const auto &detections = measurement._detections;
+    const size_t header_size = 1u + sectors;
+    output.reset(
+        sizeof(uint32_t) * header_size +
+        sizeof(RadarDetection) * detections.size());
+    auto *header = reinterpret_cast<uint32_t *>(output.data());
+    header[0u] = sectors;
+    std::memset(header + 1u, 0, sizeof(uint32_t) * sectors);
+    for (const auto &detection : detections) {
+      ++header[1u + SectorOf(detection.azimuth, sectors)];
+    }
+    // exclusive prefix sums turn the counts into per-sector write cursors,
+    // the detections then scatter straight into the output buffer.
+    uint32_t cursors[sectors];
+    uint32_t offset = 0u;
+    for (auto s = 0u; s < sectors; ++s) {
+      cursors[s] = offset;
+      offset += header[1u + s];
+    }
+    auto *grouped = reinterpret_cast<RadarDetection *>(
+        output.data() + sizeof(uint32_t) * header_size);
+    for (const auto &detection : detections) {
+      grouped[cursors[SectorOf(detection.azimuth, sectors)]++] = detection;
+    }
     return std::move(output);
   }
 
@@ -11,6 +11,10 @@
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/data/SemanticLidarData.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace carla {
 namespace sensor {
 
@@ -41,6 +45,15 @@ namespace s11n {
       return _begin[Index::SIZE + channel];
     }
 
+    /// Number of points of @a channel whose azimuth fell in @a sector.
+    uint32_t GetSectorPointCount(size_t channel, size_t sector) const {
+      DEBUG_ASSERT(channel < GetChannelCount());
+      DEBUG_ASSERT(sector < data::SemanticLidarData::sector_count);
+      return _begin[
+          Index::SIZE + GetChannelCount() +
+          channel * data::SemanticLidarData::sector_count + sector];
+    }
+
   protected:
     friend class SemanticLidarSerializer;
 
@@ -65,7 +78,10 @@ namespace s11n {
 
     static size_t GetHeaderOffset(const RawData &data) {
       auto View = DeserializeHeader(data);
-      return sizeof(uint32_t) * (View.GetChannelCount() + data::SemanticLidarData::Index::SIZE);
+      // channel counts plus the per-channel azimuth sector index.
+      return sizeof(uint32_t) * (
+          data::SemanticLidarData::Index::SIZE +
+          View.GetChannelCount() * (1u + data::SemanticLidarData::sector_count));
     }
 
     template <typename Sensor>
@@ -75,6 +91,21 @@ namespace s11n {
         Buffer &&output);
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    /// Azimuth sector of @a detection, mapping [-pi, pi) onto
+    /// [0, sector_count).
+    static uint32_t SectorOf(const data::SemanticLidarDetection &detection) {
+      constexpr float pi = 3.14159265358979323846f;
+      constexpr auto sector_count = data::SemanticLidarData::sector_count;
+      const float azimuth = std::atan2(detection.point.y, detection.point.x);
+      const auto sector = static_cast<int32_t>(
+          (azimuth + pi) * static_cast<float>(sector_count) / (2.0f * pi));
+      return static_cast<uint32_t>(std::min(
+          std::max(sector, 0),
+          static_cast<int32_t>(sector_count) - 1));
+    }
   };
 
   // ===========================================================================
@@ -86,10 +117,48 @@ namespace s11n {
       const Sensor &,
       const data::SemanticLidarData &measurement,
       Buffer &&output) {
-    std::array<boost::asio::const_buffer, 2u> seq = {
-        boost::asio::buffer(measurement._header),
-        boost::asio::buffer(measurement._ser_points)};
-    output.copy_from(seq);
+    using data::SemanticLidarData;
+    using data::SemanticLidarDetection;
+    constexpr auto sectors = SemanticLidarData::sector_count;
+    const auto &header = measurement._header;
+    const auto &points = measurement._ser_points;
+    const auto channel_count = measurement.GetChannelCount();
+    const size_t table_size = static_cast<size_t>(channel_count) * sectors;
+    const size_t header_size = header.size() + table_size;
+    output.reset(
+        sizeof(uint32_t) * header_size +
+        sizeof(SemanticLidarDetection) * points.size());
+    auto *out_header = reinterpret_cast<uint32_t *>(output.data());
+    std::memcpy(out_header, header.data(), sizeof(uint32_t) * header.size());
+    auto *table = out_header + header.size();
+    std::memset(table, 0, sizeof(uint32_t) * table_size);
+    auto *grouped = reinterpret_cast<SemanticLidarDetection *>(
+        output.data() + sizeof(uint32_t) * header_size);
+    // group the points of each channel by azimuth sector while copying them
+    // out; the channels stay in place, and within a channel the sweep order
+    // makes the scatter almost sequential.
+    size_t channel_begin = 0u;
+    uint32_t cursors[sectors];
+    for (auto channel = 0u; channel < channel_count; ++channel) {
+      // clamp to the points actually written, the header counts are filled
+      // by the sensor before the sweep.
+      const size_t count = std::min<size_t>(
+          header[SemanticLidarData::Index::SIZE + channel],
+          points.size() - channel_begin);
+      auto *counts = table + channel * sectors;
+      for (auto i = channel_begin; i < channel_begin + count; ++i) {
+        ++counts[SectorOf(points[i])];
+      }
+      uint32_t offset = 0u;
+      for (auto s = 0u; s < sectors; ++s) {
+        cursors[s] = offset;
+        offset += counts[s];
+      }
+      for (auto i = channel_begin; i < channel_begin + count; ++i) {
+        grouped[channel_begin + cursors[SectorOf(points[i])]++] = points[i];
+      }
+      channel_begin += count;
+    }
     return std::move(output);
   }
 
@@ -6,19 +6,26 @@
 
 #include "carla/sensor/s11n/SensorHeaderSerializer.h"
 
-#include "carla/BufferPool.h"
+#include <atomic>
+#include <chrono>
 
 namespace carla {
 namespace sensor {
 namespace s11n {
 
   static_assert(
-      SensorHeaderSerializer::header_offset == 3u * 8u + 6u * 4u,
+      SensorHeaderSerializer::header_offset == 3u * 8u + 6u * 4u + 3u * 8u,
       "Header size missmatch");
 
-  static Buffer PopBufferFromPool() {
-    static auto pool = std::make_shared<BufferPool>();
-    return pool->Pop();
+  static_assert(
+      SensorHeaderSerializer::header_offset <= Buffer::inline_capacity,
+      "The header is expected to fit in the buffer's inline storage; "
+      "serializing it should not allocate.");
+
+  uint64_t SensorHeaderSerializer::NowEpochUs() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
   }
 
   Buffer SensorHeaderSerializer::Serialize(
@@ -26,14 +33,19 @@ namespace s11n {
       const uint64_t frame,
       double timestamp,
       const rpc::Transform transform) {
+    static std::atomic<uint64_t> next_trace_id{1u};
     Header h;
     h.sensor_type = index;
     h.frame = frame;
     h.timestamp = timestamp;
     h.sensor_transform = transform;
-    auto buffer = PopBufferFromPool();
-    buffer.copy_from(reinterpret_cast<const unsigned char *>(&h), sizeof(h));
-    return buffer;
+    h.trace_id = next_trace_id.fetch_add(1u, std::memory_order_relaxed);
+    h.capture_time_us = NowEpochUs();
+    h.serialize_delta_us = 0u;
+    h.send_delta_us = 0u;
+    // The header fits in the buffer's inline small-buffer storage, so this
+    // neither allocates nor needs to go through a pool.
+    return Buffer(reinterpret_cast<const unsigned char *>(&h), sizeof(h));
   }
 
 } // namespace s11n
@@ -23,11 +23,24 @@ namespace s11n {
       uint64_t frame;
       double timestamp;
       rpc::Transform sensor_transform;
+      /// Unique id of this frame's trip through the pipeline, stamped at
+      /// capture; correlates server logs with client-side measurements.
+      uint64_t trace_id;
+      /// Wall clock at capture, microseconds since the Unix epoch.
+      uint64_t capture_time_us;
+      /// Start of serialization, as an offset from the capture time.
+      uint32_t serialize_delta_us;
+      /// Hand-off of the message to the transport, same origin.
+      uint32_t send_delta_us;
     };
 #pragma pack(pop)
 
     constexpr static auto header_offset = sizeof(Header);
 
+    /// Wall clock in microseconds since the Unix epoch; the clock the
+    /// latency trace is stamped with.
+    static uint64_t NowEpochUs();
+
     static Buffer Serialize(
         uint64_t index,
         uint64_t frame,
@@ -37,6 +50,27 @@ namespace s11n {
     static const Header &Deserialize(const Buffer &message) {
       return *reinterpret_cast<const Header *>(message.data());
     }
+
+    /// Stamp the start of serialization on a serialized header.
+    static void StampSerialize(Buffer &header) {
+      auto &h = *reinterpret_cast<Header *>(header.data());
+      h.serialize_delta_us = DeltaFromCapture(h);
+    }
+
+    /// Stamp the hand-off of the message to the transport.
+    static void StampSend(Buffer &header) {
+      auto &h = *reinterpret_cast<Header *>(header.data());
+      h.send_delta_us = DeltaFromCapture(h);
+    }
+
+  private:
+
+    static uint32_t DeltaFromCapture(const Header &h) {
+      const auto now = NowEpochUs();
+      return now > h.capture_time_us
+          ? static_cast<uint32_t>(now - h.capture_time_us)
+          : 0u;
+    }
   };
 
 } // namespace s11n
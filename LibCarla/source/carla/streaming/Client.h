@@ -9,11 +9,16 @@
 #include "carla/Logging.h"
 #include "carla/ThreadPool.h"
 #include "carla/streaming/Token.h"
+#include "carla/streaming/detail/Compression.h"
+#include "carla/streaming/detail/PrefetchRing.h"
+#include "carla/streaming/detail/shm/Client.h"
 #include "carla/streaming/detail/tcp/Client.h"
 #include "carla/streaming/low_level/Client.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <unordered_map>
+
 namespace carla {
 namespace streaming {
 
@@ -24,10 +29,23 @@ namespace streaming {
     using underlying_client = low_level::Client<detail::tcp::Client>;
   public:
 
-    Client() = default;
+    Client()
+      : _fallback_address(make_localhost_address()) {}
 
     explicit Client(const std::string &fallback_address)
-      : _client(fallback_address) {}
+      : _client(fallback_address),
+        _fallback_address(make_address(fallback_address)) {}
+
+    /// Buffer up to @a depth frames per stream between the network thread and
+    /// the subscriber callback, dropping frames according to @a policy when
+    /// the consumer falls behind. Applies to subsequent subscriptions; a depth
+    /// of zero restores the unbuffered behavior.
+    void SetPrefetch(
+        size_t depth,
+        detail::PrefetchRing::DropPolicy policy = detail::PrefetchRing::DropPolicy::DropOldest) {
+      _prefetch_depth = depth;
+      _prefetch_policy = policy;
+    }
 
     ~Client() {
       _service.Stop();
@@ -35,12 +53,58 @@ namespace streaming {
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
     /// MultiStream).
+    ///
+    /// If the server runs on this same host and exports the stream through
+    /// shared memory, the subscription attaches to the ring instead of opening
+    /// a TCP connection.
     template <typename Functor>
-    void Subscribe(const Token &token, Functor &&callback) {
-      _client.Subscribe(_service.io_context(), token, std::forward<Functor>(callback));
+    void Subscribe(const Token &token, Functor &&functor) {
+      detail::token_type t{token};
+      // Transparently undo the server-side wire compression, if any.
+      std::function<void(Buffer)> callback =
+          [functor=std::forward<Functor>(functor)](Buffer buffer) mutable {
+            functor(detail::Compression::Decompress(std::move(buffer)));
+          };
+      if (_prefetch_depth > 0u) {
+        auto ring = std::make_shared<detail::PrefetchRing>(
+            _service.io_context(),
+            _prefetch_depth,
+            _prefetch_policy,
+            std::move(callback));
+        callback = [ring](Buffer buffer) { ring->Push(std::move(buffer)); };
+        _prefetch_rings.emplace(t.get_stream_id(), std::move(ring));
+      }
+      // Tokens usually carry no address and rely on the fallback (the host
+      // this client connected to); resolve it the same way the TCP path does
+      // before deciding whether the server can be reached through memory.
+      if (!t.has_address()) {
+        t.set_address(_fallback_address);
+      }
+      if (t.get_address().is_loopback()) {
+        auto reader = detail::shm::RingReader::TryOpen(
+            detail::shm::MakeRingName(t.get_port(), t.get_stream_id()));
+        if (reader != nullptr) {
+          auto shm_client = std::make_shared<detail::shm::Client>(
+              _service.io_context(),
+              std::move(reader),
+              std::move(callback));
+          shm_client->Run();
+          _shm_clients.emplace(t.get_stream_id(), std::move(shm_client));
+          return;
+        }
+      }
+      _client.Subscribe(_service.io_context(), token, std::move(callback));
     }
 
     void UnSubscribe(const Token &token) {
+      detail::token_type t{token};
+      _prefetch_rings.erase(t.get_stream_id());
+      auto it = _shm_clients.find(t.get_stream_id());
+      if (it != _shm_clients.end()) {
+        it->second->Stop();
+        _shm_clients.erase(it);
+        return;
+      }
       _client.UnSubscribe(token);
     }
 
@@ -59,6 +123,21 @@ namespace streaming {
     ThreadPool _service;
 
     underlying_client _client;
+
+    boost::asio::ip::address _fallback_address;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<detail::shm::Client>> _shm_clients;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<detail::PrefetchRing>> _prefetch_rings;
+
+    size_t _prefetch_depth = 0u;
+
+    detail::PrefetchRing::DropPolicy _prefetch_policy =
+        detail::PrefetchRing::DropPolicy::DropOldest;
   };
 
 } // namespace streaming
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include "carla/IoContextPool.h"
 #include "carla/ThreadPool.h"
 #include "carla/streaming/detail/tcp/Server.h"
 #include "carla/streaming/low_level/Server.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <vector>
+
 namespace carla {
 namespace streaming {
 
@@ -37,6 +40,9 @@ namespace streaming {
           make_endpoint<protocol_type>(external_address, external_port)) {}
 
     ~Server() {
+      if (_session_pool != nullptr) {
+        _session_pool->Stop();
+      }
       _pool.Stop();
     }
 
@@ -52,6 +58,32 @@ namespace streaming {
       return _server.MakeStream();
     }
 
+    /// Export new streams also through shared memory rings; clients running on
+    /// this same host attach to them transparently and skip the TCP stack.
+    void EnableSharedMemory() {
+      _server.EnableSharedMemory();
+    }
+
+    /// Returns per-stream counters (frames, bytes, drops and last write
+    /// latency) for every live stream. Cheap enough to poll every tick.
+    std::vector<detail::StreamTelemetry> GetTelemetry() {
+      return _server.GetTelemetry();
+    }
+
+    /// Deflate stream frames before they hit the wire. Clients detect and
+    /// undo the compression transparently. Worth it for remote clients on
+    /// constrained links, counter-productive on localhost.
+    void EnableCompression() {
+      _server.EnableCompression();
+    }
+
+    /// Serve new streams over UDP instead of TCP, trading reliability for
+    /// latency: a lost datagram drops that frame only. Meant for high-rate
+    /// camera streams where a late frame is as good as no frame.
+    void EnableUdp() {
+      _server.EnableUdp(_pool.io_context());
+    }
+
     void Run() {
       _pool.Run();
     }
@@ -60,6 +92,16 @@ namespace streaming {
       _pool.AsyncRun(worker_threads);
     }
 
+    /// Distribute the sessions created from now on across @a num_contexts
+    /// independent io contexts, each running @a threads_per_context threads.
+    /// Without sharding every session competes for the single io context
+    /// driven by AsyncRun.
+    void ShardSessions(size_t num_contexts, size_t threads_per_context = 1u) {
+      _session_pool = std::make_shared<IoContextPool>(num_contexts);
+      _server.ShardSessionsAcross(_session_pool);
+      _session_pool->AsyncRun(threads_per_context);
+    }
+
   private:
 
     // The order of these two arguments is very important.
@@ -67,6 +109,8 @@ namespace streaming {
     ThreadPool _pool;
 
     underlying_server _server;
+
+    std::shared_ptr<IoContextPool> _session_pool;
   };
 
 } // namespace streaming
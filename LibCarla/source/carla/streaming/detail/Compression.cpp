@@ -0,0 +1,104 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/Compression.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+
+#include <zlib.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+#pragma pack(push, 1)
+
+  struct CompressedFrameHeader {
+    uint64_t magic = MAGIC;
+    uint64_t uncompressed_size = 0u;
+
+    static constexpr uint64_t MAGIC = 0x4341524c415a4950u; // "CARLAZIP"
+  };
+
+#pragma pack(pop)
+
+  bool Compression::IsCompressed(const Buffer &buffer) {
+    if (buffer.size() < sizeof(CompressedFrameHeader)) {
+      return false;
+    }
+    uint64_t magic = 0u;
+    std::memcpy(&magic, buffer.data(), sizeof(magic));
+    return magic == CompressedFrameHeader::MAGIC;
+  }
+
+  Buffer Compression::Compress(const boost::asio::const_buffer *views, size_t count) {
+    uint64_t total_size = 0u;
+    for (size_t i = 0u; i < count; ++i) {
+      total_size += views[i].size();
+    }
+
+    CompressedFrameHeader header;
+    header.uncompressed_size = total_size;
+
+    const auto bound = compressBound(static_cast<uLong>(total_size));
+    Buffer result(static_cast<uint64_t>(sizeof(header)) + bound);
+    std::memcpy(result.data(), &header, sizeof(header));
+
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (deflateInit(&stream, Z_BEST_SPEED) != Z_OK) {
+      throw_exception(std::runtime_error("deflateInit failed"));
+    }
+    stream.next_out = result.data() + sizeof(header);
+    stream.avail_out = static_cast<uInt>(bound);
+    for (size_t i = 0u; i < count; ++i) {
+      stream.next_in = const_cast<Bytef *>(static_cast<const Bytef *>(views[i].data()));
+      stream.avail_in = static_cast<uInt>(views[i].size());
+      const auto flush = (i + 1u == count) ? Z_FINISH : Z_NO_FLUSH;
+      const auto code = deflate(&stream, flush);
+      if ((code != Z_OK) && (code != Z_STREAM_END)) {
+        deflateEnd(&stream);
+        throw_exception(std::runtime_error("deflate failed"));
+      }
+    }
+    const auto compressed_size = stream.total_out;
+    deflateEnd(&stream);
+
+    if (sizeof(header) + compressed_size >= total_size) {
+      log_debug("compression: frame not compressible, sending as is");
+      return Buffer();
+    }
+    result.resize(static_cast<uint64_t>(sizeof(header)) + compressed_size);
+    return result;
+  }
+
+  Buffer Compression::Decompress(Buffer &&buffer) {
+    if (!IsCompressed(buffer)) {
+      return std::move(buffer);
+    }
+    CompressedFrameHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    Buffer result(header.uncompressed_size);
+    uLongf uncompressed_size = static_cast<uLongf>(header.uncompressed_size);
+    const auto code = uncompress(
+        result.data(),
+        &uncompressed_size,
+        buffer.data() + sizeof(header),
+        buffer.size() - sizeof(header));
+    if ((code != Z_OK) || (uncompressed_size != header.uncompressed_size)) {
+      throw_exception(std::runtime_error("failed to decompress frame"));
+    }
+    return result;
+  }
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
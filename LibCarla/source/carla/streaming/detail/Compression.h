@@ -0,0 +1,42 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+
+#include <boost/asio/buffer.hpp>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// On-the-wire compression for stream messages. Compressed frames carry a
+  /// magic prefix and the original size, so the receiving side can detect and
+  /// undo the compression without any extra negotiation; uncompressed frames
+  /// pass through untouched.
+  ///
+  /// Deflate at the fastest level is used: for camera and lidar payloads the
+  /// byte savings at higher levels do not pay for the extra CPU on the
+  /// simulator side.
+  class Compression {
+  public:
+
+    /// Returns whether @a buffer starts with the compressed-frame prefix.
+    static bool IsCompressed(const Buffer &buffer);
+
+    /// Compresses the concatenation of @a count @a views into a single
+    /// prefixed buffer. Returns an empty buffer if the result would not be
+    /// smaller than the input, callers should then send the original.
+    static Buffer Compress(const boost::asio::const_buffer *views, size_t count);
+
+    /// Undoes Compress. Buffers without the prefix are returned unchanged.
+    static Buffer Decompress(Buffer &&buffer);
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
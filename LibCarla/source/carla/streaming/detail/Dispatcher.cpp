@@ -8,6 +8,7 @@
 
 #include "carla/Exception.h"
 #include "carla/Logging.h"
+#include "carla/profiler/Metrics.h"
 #include "carla/streaming/detail/MultiStreamState.h"
 
 #include <exception>
@@ -50,10 +51,38 @@ namespace detail {
     std::lock_guard<std::mutex> lock(_mutex);
     ++_cached_token._token.stream_id; // id zero only happens in overflow.
     log_info("Created new stream:", _cached_token._token.stream_id);
-    return MakeStreamState<MultiStreamState>(_cached_token, _stream_map);
+    token_type token = _cached_token;
+    if (_udp_broadcaster != nullptr) {
+      token._token.protocol = token_data::protocol::udp;
+    }
+    auto stream_state = MakeStreamState<MultiStreamState>(token, _stream_map);
+    if (_udp_broadcaster != nullptr) {
+      stream_state->EnableUdp(_udp_broadcaster);
+    } else if (_shm_enabled) {
+      stream_state->EnableSharedMemory(token.get_port());
+    }
+    if (_compression_enabled) {
+      stream_state->EnableCompression();
+    }
+    return stream_state;
+  }
+
+  std::vector<StreamTelemetry> Dispatcher::GetTelemetry() {
+    std::vector<StreamTelemetry> result;
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_stream_map.size());
+    for (auto &pair : _stream_map) {
+      auto stream_state = pair.second.lock();
+      if (stream_state != nullptr) {
+        result.emplace_back(
+            std::static_pointer_cast<MultiStreamState>(stream_state)->GetTelemetry());
+      }
+    }
+    return result;
   }
 
   bool Dispatcher::RegisterSession(std::shared_ptr<Session> session) {
+    CARLA_METRIC_SCOPE(streaming, register_session);
     DEBUG_ASSERT(session != nullptr);
     std::lock_guard<std::mutex> lock(_mutex);
     auto search = _stream_map.find(session->get_stream_id());
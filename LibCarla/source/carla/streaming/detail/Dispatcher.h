@@ -10,10 +10,14 @@
 #include "carla/streaming/Stream.h"
 #include "carla/streaming/detail/Session.h"
 #include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/udp/Broadcaster.h"
+
+#include "carla/streaming/detail/StreamTelemetry.h"
 
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -33,6 +37,26 @@ namespace detail {
 
     carla::streaming::Stream MakeStream();
 
+    /// Export the streams created from now on also through shared memory
+    /// rings, so clients running on this same host can skip the TCP stack.
+    void EnableSharedMemory() {
+      _shm_enabled = true;
+    }
+
+    /// Serve the streams created from now on through @a broadcaster instead
+    /// of TCP; their tokens advertise the UDP protocol to the clients.
+    void EnableUdp(std::shared_ptr<udp::Broadcaster> broadcaster) {
+      _udp_broadcaster = std::move(broadcaster);
+    }
+
+    /// Compress the frames of the streams created from now on.
+    void EnableCompression() {
+      _compression_enabled = true;
+    }
+
+    /// Returns a telemetry snapshot for every live stream.
+    std::vector<StreamTelemetry> GetTelemetry();
+
     bool RegisterSession(std::shared_ptr<Session> session);
 
     void DeregisterSession(std::shared_ptr<Session> session);
@@ -47,6 +71,12 @@ namespace detail {
 
     token_type _cached_token;
 
+    bool _shm_enabled = false;
+
+    bool _compression_enabled = false;
+
+    std::shared_ptr<udp::Broadcaster> _udp_broadcaster;
+
     std::unordered_map<
         stream_id_type,
         std::weak_ptr<StreamStateBase>> _stream_map;
@@ -8,9 +8,15 @@
 
 #include "carla/AtomicSharedPtr.h"
 #include "carla/Logging.h"
+#include "carla/streaming/detail/Compression.h"
 #include "carla/streaming/detail/StreamStateBase.h"
+#include "carla/streaming/detail/StreamTelemetry.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
 #include "carla/streaming/detail/tcp/Message.h"
+#include "carla/streaming/detail/udp/Broadcaster.h"
 
+#include <array>
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <atomic>
@@ -32,30 +38,133 @@ namespace detail {
       _session(nullptr)
       {};
 
+    /// Exports this stream through a shared memory ring so co-located clients
+    /// can pick up the frames without going through the TCP stack. Slots are
+    /// sized for a 1080p RGBA frame; bigger frames fall back to TCP.
+    void EnableSharedMemory(uint16_t port) {
+      constexpr uint64_t slot_size = (1920u * 1080u * 4u) + 1024u;
+      constexpr uint64_t slot_count = 3u;
+      _shm_writer = shm::RingWriter::Create(
+          shm::MakeRingName(port, token().get_stream_id()),
+          slot_size,
+          slot_count);
+    }
+
+    /// @copydoc EnableSharedMemory(uint16_t)
+    /// The ring name is derived from this stream's own token.
+    void EnableSharedMemory() {
+      EnableSharedMemory(token().get_port());
+    }
+
+    /// Fan this stream out through the lossy datagram transport instead of
+    /// per-session TCP writes.
+    void EnableUdp(std::shared_ptr<udp::Broadcaster> broadcaster) {
+      _udp_broadcaster.store(std::move(broadcaster));
+    }
+
+    /// Deflate the frames of this stream before they hit the wire. The
+    /// receiving side detects compressed frames by their prefix, frames that
+    /// do not shrink are sent uncompressed.
+    void EnableCompression() {
+      _compression_enabled = true;
+    }
+
+    /// Callback receiving every message written to this stream.
+    using ListenerCallback = std::function<void(std::shared_ptr<const tcp::Message>)>;
+
+    /// Hands every outgoing message to @a listener as well, sharing the
+    /// buffers with the transport so the payload is never copied; the
+    /// server-side recorder uses this to capture sensor output. Pass nullptr
+    /// to remove the listener.
+    ///
+    /// @warning The listener runs on whatever thread writes the stream.
+    void SetMessageListener(std::shared_ptr<const ListenerCallback> listener) {
+      _listener.store(std::move(listener));
+    }
+
     template <typename... Buffers>
     void Write(Buffers &&... buffers) {
-      auto message = Session::MakeMessage(std::move(buffers)...);
+      if (_compression_enabled) {
+        const std::array<boost::asio::const_buffer, sizeof...(Buffers)> views = {{buffers.cbuffer()...}};
+        auto compressed = Compression::Compress(views.data(), views.size());
+        if (!compressed.empty()) {
+          WriteMessage(Session::MakeMessage(std::move(compressed)));
+          return;
+        }
+      }
+      WriteMessage(Session::MakeMessage(std::move(buffers)...));
+    }
+
+    /// Returns a snapshot of this stream's counters.
+    StreamTelemetry GetTelemetry() {
+      StreamTelemetry telemetry;
+      telemetry.stream_id = token().get_stream_id();
+      telemetry.frames_sent = _frames_sent;
+      telemetry.bytes_sent = _bytes_sent;
+      std::lock_guard<std::mutex> lock(_mutex);
+      telemetry.sessions = _sessions.size();
+      for (auto &session : _sessions) {
+        if (session != nullptr) {
+          telemetry.frames_dropped += session->GetDroppedMessageCount();
+          telemetry.last_write_latency_us = std::max(
+              telemetry.last_write_latency_us,
+              session->GetLastWriteLatency());
+        }
+      }
+      return telemetry;
+    }
+
+  private:
+
+    void WriteMessage(std::shared_ptr<const tcp::Message> message) {
+      ++_frames_sent;
+      _bytes_sent += message->size();
+
+      // hand the message to the listener, if any; it takes shared ownership
+      // of the same buffers that go down the transports below.
+      auto listener = _listener.load();
+      if (listener != nullptr) {
+        (*listener)(message);
+      }
+
+      // fan out through the datagram transport, if enabled.
+      auto udp_broadcaster = _udp_broadcaster.load();
+      if (udp_broadcaster != nullptr) {
+        udp_broadcaster->Write(token().get_stream_id(), message);
+        return;
+      }
+
+      // publish to the shared memory ring, if any.
+      auto shm_writer = _shm_writer.load();
+      if (shm_writer != nullptr) {
+        auto sequence = message->GetBufferSequence();
+        shm_writer->Write(&(*sequence.begin()), sequence.size());
+      }
 
       // try write single stream
       auto session = _session.load();
       if (session != nullptr) {
         session->Write(std::move(message));
-        // Return here, _session is only valid if we have a 
+        // Return here, _session is only valid if we have a
         // single session.
-        return; 
+        return;
       }
 
-      // try write multiple stream
-      std::lock_guard<std::mutex> lock(_mutex);
-      for (auto &s : _sessions) {
-        if (s != nullptr) {
-          s->Write(message);
+      // Broadcast: enqueue the same immutable message to every session of the
+      // current snapshot. Each write is asynchronous on the session's strand,
+      // so adding subscribers does not serialize the producer, and the
+      // snapshot is rebuilt only on (de)registration so no lock is taken on
+      // the hot path.
+      auto sessions = _session_snapshot.load();
+      if (sessions != nullptr) {
+        for (auto &s : *sessions) {
+          if (s != nullptr) {
+            s->Write(message);
+          }
         }
       }
     }
 
-  private:
-
     void ConnectSession(std::shared_ptr<Session> session) final {
       DEBUG_ASSERT(session != nullptr);
       std::lock_guard<std::mutex> lock(_mutex);
@@ -67,6 +176,7 @@ namespace detail {
       else if (_sessions.size() > 1) {
         _session.store(nullptr);
       }
+      PublishSessionSnapshot();
     }
 
     void DisconnectSession(std::shared_ptr<Session> session) final {
@@ -88,6 +198,7 @@ namespace detail {
         else
           _session.store(nullptr);
       }
+      PublishSessionSnapshot();
       log_debug("Disconnecting multistream sessions:", _sessions.size());
     }
 
@@ -95,15 +206,46 @@ namespace detail {
       std::lock_guard<std::mutex> lock(_mutex);
       _sessions.clear();
       _session.store(nullptr);
+      PublishSessionSnapshot();
       log_debug("Disconnecting all multistream sessions");
     }
 
+    /// Publishes an immutable copy of the session list for the writer thread.
+    /// Must be called with @a _mutex held.
+    void PublishSessionSnapshot() {
+      if (_sessions.size() > 1u) {
+        _session_snapshot.store(
+            std::make_shared<const std::vector<std::shared_ptr<Session>>>(_sessions));
+      } else {
+        _session_snapshot.store(nullptr);
+      }
+    }
+
     std::mutex _mutex;
 
     // if there is only one session, then we use atomic
     AtomicSharedPtr<Session> _session;
     // if there are more than one session, we use vector of sessions with mutex
     std::vector<std::shared_ptr<Session>> _sessions;
+
+    // immutable snapshot of _sessions used by the broadcast path; only
+    // present when there is more than one session
+    AtomicSharedPtr<const std::vector<std::shared_ptr<Session>>> _session_snapshot;
+
+    // optional shared memory ring for co-located clients
+    AtomicSharedPtr<shm::RingWriter> _shm_writer;
+
+    // optional lossy datagram fan-out, replaces the TCP sessions
+    AtomicSharedPtr<udp::Broadcaster> _udp_broadcaster;
+
+    // optional tap on the outgoing messages (e.g. the recorder)
+    AtomicSharedPtr<const ListenerCallback> _listener;
+
+    std::atomic_bool _compression_enabled{false};
+
+    std::atomic<uint64_t> _frames_sent{0u};
+
+    std::atomic<uint64_t> _bytes_sent{0u};
   };
 
 } // namespace detail
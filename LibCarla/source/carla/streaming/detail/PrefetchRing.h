@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/Logging.h"
+#include "carla/NonCopyable.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// A bounded ring of received frames decoupling the network thread from the
+  /// subscriber callback. The network thread only pushes; frames are handed
+  /// to the callback from a task posted on the io context, so a slow consumer
+  /// delays its own frames instead of stalling the socket. When the ring is
+  /// full, frames are dropped according to the configured policy.
+  class PrefetchRing
+    : public std::enable_shared_from_this<PrefetchRing>,
+      private NonCopyable {
+  public:
+
+    enum class DropPolicy {
+      DropOldest, ///< keep the freshest frames, drop the queued ones (default).
+      DropNewest  ///< keep the backlog intact, drop the incoming frame.
+    };
+
+    using callback_function_type = std::function<void(Buffer)>;
+
+    PrefetchRing(
+        boost::asio::io_context &io_context,
+        size_t capacity,
+        DropPolicy policy,
+        callback_function_type callback)
+      : _io_context(io_context),
+        _capacity(capacity > 0u ? capacity : 1u),
+        _policy(policy),
+        _callback(std::move(callback)) {}
+
+    /// Queue @a buffer for delivery. Called from the network thread.
+    void Push(Buffer buffer) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_frames.size() >= _capacity) {
+          if (_policy == DropPolicy::DropNewest) {
+            log_debug("prefetch ring full: incoming frame dropped");
+            return;
+          }
+          log_debug("prefetch ring full: oldest frame dropped");
+          _frames.pop_front();
+        }
+        _frames.emplace_back(std::move(buffer));
+        if (_draining) {
+          return;
+        }
+        _draining = true;
+      }
+      boost::asio::post(_io_context, [self=shared_from_this()]() {
+        self->Drain();
+      });
+    }
+
+  private:
+
+    void Drain() {
+      for (;;) {
+        Buffer buffer;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          if (_frames.empty()) {
+            _draining = false;
+            return;
+          }
+          buffer = std::move(_frames.front());
+          _frames.pop_front();
+        }
+        _callback(std::move(buffer));
+      }
+    }
+
+    boost::asio::io_context &_io_context;
+
+    const size_t _capacity;
+
+    const DropPolicy _policy;
+
+    const callback_function_type _callback;
+
+    std::mutex _mutex;
+
+    std::deque<Buffer> _frames;
+
+    bool _draining = false;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
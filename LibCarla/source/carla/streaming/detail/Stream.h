@@ -52,6 +52,22 @@ namespace detail {
       _shared_state->Write(std::move(buffers)...);
     }
 
+    /// Register a listener that receives every message written to this
+    /// stream, sharing the buffers with the transport. Pass nullptr to
+    /// remove it.
+    void SetMessageListener(
+        std::shared_ptr<const typename StreamStateT::ListenerCallback> listener) {
+      _shared_state->SetMessageListener(std::move(listener));
+    }
+
+    /// Export this particular stream also through a shared memory ring, so
+    /// clients on this same host attach to it instead of opening a TCP
+    /// connection. Silently stays TCP-only on platforms without POSIX shared
+    /// memory.
+    void EnableSharedMemory() {
+      _shared_state->EnableSharedMemory();
+    }
+
     /// Make a copy of @a data and flush it down the stream.
     template <typename T>
     Stream &operator<<(const T &data) {
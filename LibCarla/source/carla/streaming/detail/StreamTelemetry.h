@@ -0,0 +1,42 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/streaming/detail/Types.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// A snapshot of the counters of one stream. Counters accumulate since
+  /// stream creation; rates are left to the caller, who knows the sampling
+  /// period.
+  struct StreamTelemetry {
+    stream_id_type stream_id = 0u;
+
+    /// Number of sessions currently subscribed.
+    size_t sessions = 0u;
+
+    /// Frames handed to the transport.
+    uint64_t frames_sent = 0u;
+
+    /// Payload bytes handed to the transport.
+    uint64_t bytes_sent = 0u;
+
+    /// Frames discarded because a session could not keep up.
+    uint64_t frames_dropped = 0u;
+
+    /// Wire latency of the last completed write, in microseconds, taken as
+    /// the worst across the subscribed sessions.
+    uint64_t last_write_latency_us = 0u;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
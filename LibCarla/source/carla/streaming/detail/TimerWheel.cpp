@@ -0,0 +1,130 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/TimerWheel.h"
+
+#include "carla/Debug.h"
+
+#include <unordered_map>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  std::shared_ptr<TimerWheel> TimerWheel::SharedForContext(
+      boost::asio::io_context &io_context) {
+    static std::mutex registry_mutex;
+    static std::unordered_map<
+        const boost::asio::io_context *,
+        std::weak_ptr<TimerWheel>> registry;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto &entry = registry[&io_context];
+    auto wheel = entry.lock();
+    if (wheel == nullptr) {
+      wheel = std::make_shared<TimerWheel>(io_context);
+      entry = wheel;
+    }
+    return wheel;
+  }
+
+  TimerWheel::TimerWheel(boost::asio::io_context &io_context)
+    : _ticker(io_context) {}
+
+  TimerWheel::TimerHandle TimerWheel::MakeTimer(std::function<void()> callback) {
+    DEBUG_ASSERT(callback != nullptr);
+    StartTicker();
+    return std::make_shared<Timer>(std::move(callback));
+  }
+
+  void TimerWheel::Arm(const TimerHandle &timer, time_duration timeout) {
+    DEBUG_ASSERT(timer != nullptr);
+    const uint64_t resolution_ms = GetResolution().milliseconds();
+    // Round up plus one tick so a timer armed right before a tick boundary
+    // never fires early.
+    const uint64_t ticks = 2u + (timeout.milliseconds() / resolution_ms);
+    timer->_deadline_tick.store(
+        _current_tick.load(std::memory_order_relaxed) + ticks,
+        std::memory_order_release);
+    Enqueue(timer);
+  }
+
+  void TimerWheel::Cancel(const TimerHandle &timer) {
+    DEBUG_ASSERT(timer != nullptr);
+    // Lazy cancellation, the slot entry is dropped whenever its slot comes
+    // around next.
+    timer->_deadline_tick.store(0u, std::memory_order_release);
+  }
+
+  void TimerWheel::Enqueue(const TimerHandle &timer) {
+    if (timer->_queued.exchange(true)) {
+      // Already sitting in a slot, the new deadline is picked up lazily.
+      return;
+    }
+    const auto deadline = timer->_deadline_tick.load(std::memory_order_acquire);
+    if (deadline == 0u) {
+      // Cancelled in between.
+      timer->_queued.store(false);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slots[deadline % SLOT_COUNT].emplace_back(timer);
+  }
+
+  void TimerWheel::StartTicker() {
+    if (_ticking.exchange(true)) {
+      return;
+    }
+    ScheduleTick();
+  }
+
+  void TimerWheel::ScheduleTick() {
+    _ticker.expires_from_now(GetResolution());
+    std::weak_ptr<TimerWheel> weak = shared_from_this();
+    _ticker.async_wait([weak](boost::system::error_code ec) {
+      auto self = weak.lock();
+      if ((self == nullptr) || ec) {
+        return;
+      }
+      self->Tick();
+      self->ScheduleTick();
+    });
+  }
+
+  void TimerWheel::Tick() {
+    const uint64_t now = _current_tick.fetch_add(1u) + 1u;
+    std::vector<std::weak_ptr<Timer>> bucket;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      bucket.swap(_slots[now % SLOT_COUNT]);
+    }
+    for (auto &weak : bucket) {
+      auto timer = weak.lock();
+      if (timer == nullptr) {
+        continue;
+      }
+      auto deadline = timer->_deadline_tick.load(std::memory_order_acquire);
+      if (deadline > now) {
+        // Re-armed since it was queued here, park it in its new slot.
+        std::lock_guard<std::mutex> lock(_mutex);
+        _slots[deadline % SLOT_COUNT].emplace_back(std::move(timer));
+        continue;
+      }
+      timer->_queued.store(false);
+      if ((deadline != 0u) &&
+          timer->_deadline_tick.compare_exchange_strong(deadline, 0u)) {
+        timer->_callback();
+      }
+      // An Arm racing with the flag clear above may have seen the timer as
+      // still queued, put it back ourselves.
+      if (timer->_deadline_tick.load(std::memory_order_acquire) != 0u) {
+        Enqueue(timer);
+      }
+    }
+  }
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
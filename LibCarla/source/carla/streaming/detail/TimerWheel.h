@@ -0,0 +1,116 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+
+  /// A hashed timer wheel shared by every timeout serviced on one io_context.
+  ///
+  /// Sessions and clients used to own a boost::asio timer each and re-schedule
+  /// it on every message; at high message rates the resulting timer churn is
+  /// measurable. The wheel replaces that with a single periodic asio timer:
+  /// re-arming an already queued timer is one atomic store, cancelling is
+  /// another, and expired entries are only looked at once per wheel tick.
+  ///
+  /// The trade-off is resolution, timeouts fire on tick boundaries. That is
+  /// plenty for inactivity deadlines and reconnection back-off, which is all
+  /// this wheel is meant for; do not use it where sub-tick accuracy matters.
+  class TimerWheel
+    : public std::enable_shared_from_this<TimerWheel>,
+      private NonCopyable {
+  public:
+
+    /// A timer serviced by the wheel. Create through TimerWheel::MakeTimer.
+    class Timer : private NonCopyable {
+    public:
+
+      explicit Timer(std::function<void()> callback)
+        : _callback(std::move(callback)) {}
+
+    private:
+
+      friend class TimerWheel;
+
+      std::function<void()> _callback;
+
+      /// Absolute tick at which the timer fires, zero while disarmed.
+      std::atomic<uint64_t> _deadline_tick{0u};
+
+      /// Whether the timer currently sits in some wheel slot.
+      std::atomic<bool> _queued{false};
+    };
+
+    using TimerHandle = std::shared_ptr<Timer>;
+
+    /// Returns the wheel servicing @a io_context, creating it on first use.
+    /// Every caller on the same io_context shares one wheel.
+    static std::shared_ptr<TimerWheel> SharedForContext(
+        boost::asio::io_context &io_context);
+
+    explicit TimerWheel(boost::asio::io_context &io_context);
+
+    /// Creates a disarmed timer firing @a callback on expiration. The wheel
+    /// only keeps weak references, releasing the handle drops the timer.
+    TimerHandle MakeTimer(std::function<void()> callback);
+
+    /// (Re-)arms @a timer to fire once @a timeout from now has elapsed,
+    /// rounded up to the wheel resolution. Re-arming a queued timer is a
+    /// single atomic store; the wheel re-hashes it lazily when its old slot
+    /// comes around.
+    void Arm(const TimerHandle &timer, time_duration timeout);
+
+    /// Disarms @a timer. The callback is not called unless it is already
+    /// running on the io_context.
+    void Cancel(const TimerHandle &timer);
+
+    /// Tick period of the wheel.
+    static time_duration GetResolution() {
+      return time_duration::milliseconds(50u);
+    }
+
+  private:
+
+    void StartTicker();
+
+    void ScheduleTick();
+
+    void Tick();
+
+    /// Inserts @a timer in the slot of its deadline unless already queued.
+    void Enqueue(const TimerHandle &timer);
+
+    static constexpr size_t SLOT_COUNT = 256u;
+
+    boost::asio::deadline_timer _ticker;
+
+    std::atomic<bool> _ticking{false};
+
+    std::atomic<uint64_t> _current_tick{0u};
+
+    std::mutex _mutex;
+
+    std::array<std::vector<std::weak_ptr<Timer>>, SLOT_COUNT> _slots;
+  };
+
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,101 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/BufferPool.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  /// A client that consumes a single stream from a shared memory ring instead
+  /// of a TCP socket. Frames are picked up by polling the ring on the given
+  /// io_context; consumers that need the frame without even this single copy
+  /// can use RingReader directly.
+  class Client
+    : public std::enable_shared_from_this<Client>,
+      private NonCopyable {
+  public:
+
+    using callback_function_type = std::function<void(Buffer)>;
+
+    Client(
+        boost::asio::io_context &io_context,
+        std::shared_ptr<RingReader> reader,
+        callback_function_type callback)
+      : _reader(std::move(reader)),
+        _callback(std::move(callback)),
+        _timer(io_context),
+        _buffer_pool(std::make_shared<BufferPool>()) {}
+
+    /// Starts polling the ring for new frames.
+    void Run() {
+      Poll();
+    }
+
+    void Stop() {
+      _done = true;
+      _timer.cancel();
+    }
+
+  private:
+
+    void Poll() {
+      if (_done) {
+        return;
+      }
+      RingReader::Frame frame;
+      while (_reader->PollFrame(frame)) {
+        // The frame carries the same bytes as the TCP wire, skip the message
+        // size prefix to deliver exactly what the TCP client delivers.
+        DEBUG_ASSERT(frame.size >= sizeof(message_size_type));
+        auto buffer = _buffer_pool->Pop();
+        buffer.copy_from(
+            frame.data + sizeof(message_size_type),
+            static_cast<Buffer::size_type>(frame.size - sizeof(message_size_type)));
+        if (!_reader->IsFrameValid(frame)) {
+          continue; // the writer lapped us mid-copy, the copy is torn.
+        }
+        _callback(std::move(buffer));
+      }
+      _timer.expires_from_now(boost::posix_time::milliseconds(1));
+      auto self = shared_from_this();
+      _timer.async_wait([self](boost::system::error_code ec) {
+        if (!ec) {
+          self->Poll();
+        }
+      });
+    }
+
+    std::shared_ptr<RingReader> _reader;
+
+    callback_function_type _callback;
+
+    boost::asio::deadline_timer _timer;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
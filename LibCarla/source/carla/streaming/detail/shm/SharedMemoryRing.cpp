@@ -0,0 +1,256 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/shm/SharedMemoryRing.h"
+
+#include "carla/Logging.h"
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif // _WIN32
+
+#include <algorithm>
+#include <cstring>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  static constexpr uint64_t RING_MAGIC = 0x6361726c612e7368u; // "carla.sh"
+
+  std::string MakeRingName(uint16_t port, stream_id_type stream_id) {
+    return "/carla." + std::to_string(port) + "." + std::to_string(stream_id);
+  }
+
+#ifndef _WIN32
+
+  static uint64_t ComputeMappedSize(uint64_t slot_size, uint64_t slot_count) {
+    return sizeof(RingHeader) + slot_count * (sizeof(FrameHeader) + slot_size);
+  }
+
+  // ===========================================================================
+  // -- RingWriter -------------------------------------------------------------
+  // ===========================================================================
+
+  std::shared_ptr<RingWriter> RingWriter::Create(
+      const std::string &name,
+      uint64_t slot_size,
+      uint64_t slot_count) {
+    DEBUG_ASSERT(slot_count > 1u);
+    // Round the slots up to the alignment of the atomics in their headers.
+    slot_size = (slot_size + 7u) & ~uint64_t(7u);
+    ::shm_unlink(name.c_str()); // discard leftovers of a crashed server.
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      log_warning("shm: cannot create", name, ": ", std::strerror(errno));
+      return nullptr;
+    }
+    const auto mapped_size = ComputeMappedSize(slot_size, slot_count);
+    if (::ftruncate(fd, static_cast<off_t>(mapped_size)) != 0) {
+      log_warning("shm: cannot size", name, ": ", std::strerror(errno));
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      return nullptr;
+    }
+    auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      log_warning("shm: cannot map", name, ": ", std::strerror(errno));
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      return nullptr;
+    }
+    auto *header = new (mapping) RingHeader();
+    header->slot_size = slot_size;
+    header->slot_count = slot_count;
+    header->head.store(0u, std::memory_order_release);
+    header->magic = RING_MAGIC;
+    log_debug("shm: created ring", name, "of", mapped_size, "bytes");
+    return std::shared_ptr<RingWriter>(new RingWriter(
+        name,
+        fd,
+        reinterpret_cast<uint8_t *>(mapping),
+        mapped_size));
+  }
+
+  RingWriter::RingWriter(std::string name, int fd, uint8_t *mapping, uint64_t mapped_size)
+    : _name(std::move(name)),
+      _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {}
+
+  RingWriter::~RingWriter() {
+    ::munmap(_mapping, _mapped_size);
+    ::close(_fd);
+    ::shm_unlink(_name.c_str());
+  }
+
+  RingHeader &RingWriter::GetHeader() const {
+    return *reinterpret_cast<RingHeader *>(_mapping);
+  }
+
+  uint8_t *RingWriter::GetSlot(uint64_t sequence) const {
+    auto &header = GetHeader();
+    const auto stride = sizeof(FrameHeader) + header.slot_size;
+    return _mapping + sizeof(RingHeader) + (sequence % header.slot_count) * stride;
+  }
+
+  void RingWriter::Write(const boost::asio::const_buffer *buffers, size_t count) {
+    auto &ring = GetHeader();
+    uint64_t total = 0u;
+    for (size_t i = 0u; i < count; ++i) {
+      total += buffers[i].size();
+    }
+    if (total > ring.slot_size) {
+      log_warning("shm: frame of", total, "bytes does not fit in ring", _name);
+      return;
+    }
+    const auto sequence = ring.head.load(std::memory_order_relaxed);
+    auto *slot = GetSlot(sequence);
+    auto *frame = reinterpret_cast<FrameHeader *>(slot);
+    // Invalidate the slot before touching its contents: a reader still
+    // holding the previous lap's frame must see the sentinel, not that
+    // frame's sequence, while the payload changes under it.
+    frame->sequence.store(0u, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    frame->size.store(total, std::memory_order_relaxed);
+    auto *dst = slot + sizeof(FrameHeader);
+    for (size_t i = 0u; i < count; ++i) {
+      std::memcpy(dst, buffers[i].data(), buffers[i].size());
+      dst += buffers[i].size();
+    }
+    frame->sequence.store(sequence + 1u, std::memory_order_release);
+    // Publish: the reader only trusts slots whose sequence matches the head.
+    ring.head.store(sequence + 1u, std::memory_order_release);
+  }
+
+  // ===========================================================================
+  // -- RingReader -------------------------------------------------------------
+  // ===========================================================================
+
+  std::shared_ptr<RingReader> RingReader::TryOpen(const std::string &name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0600);
+    if (fd < 0) {
+      return nullptr; // the server is not exporting this stream locally.
+    }
+    struct stat info;
+    if ((::fstat(fd, &info) != 0) || (static_cast<size_t>(info.st_size) < sizeof(RingHeader))) {
+      ::close(fd);
+      return nullptr;
+    }
+    const auto mapped_size = static_cast<uint64_t>(info.st_size);
+    auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      ::close(fd);
+      return nullptr;
+    }
+    const auto *header = reinterpret_cast<const RingHeader *>(mapping);
+    if (header->magic != RING_MAGIC) {
+      ::munmap(mapping, mapped_size);
+      ::close(fd);
+      return nullptr;
+    }
+    log_debug("shm: attached to ring", name);
+    return std::shared_ptr<RingReader>(new RingReader(
+        fd,
+        reinterpret_cast<const uint8_t *>(mapping),
+        mapped_size));
+  }
+
+  RingReader::RingReader(int fd, const uint8_t *mapping, uint64_t mapped_size)
+    : _fd(fd),
+      _mapping(mapping),
+      _mapped_size(mapped_size) {}
+
+  RingReader::~RingReader() {
+    ::munmap(const_cast<uint8_t *>(_mapping), _mapped_size);
+    ::close(_fd);
+  }
+
+  const RingHeader &RingReader::GetHeader() const {
+    return *reinterpret_cast<const RingHeader *>(_mapping);
+  }
+
+  const uint8_t *RingReader::GetSlot(uint64_t sequence) const {
+    const auto &header = GetHeader();
+    const auto stride = sizeof(FrameHeader) + header.slot_size;
+    return _mapping + sizeof(RingHeader) + (sequence % header.slot_count) * stride;
+  }
+
+  bool RingReader::PollFrame(Frame &frame) {
+    const auto &ring = GetHeader();
+    const auto head = ring.head.load(std::memory_order_acquire);
+    if (head == _last_sequence) {
+      return false; // nothing new.
+    }
+    auto sequence = _last_sequence + 1u;
+    if (head - sequence >= ring.slot_count) {
+      // We fell behind more than a full ring, jump to the oldest valid frame.
+      log_debug("shm: reader dropped", head - sequence, "frames");
+      sequence = head - ring.slot_count + 1u;
+    }
+    const auto *slot = GetSlot(sequence - 1u);
+    const auto *header = reinterpret_cast<const FrameHeader *>(slot);
+    if (header->sequence.load(std::memory_order_acquire) != sequence) {
+      return false; // writer is in the middle of this slot, try again later.
+    }
+    // The size shares the slot with the payload, so a writer lapping us can
+    // be rewriting it as we read; clamp it to the slot so a torn read can
+    // never drive a copy past the mapping (IsFrameValid catches the tear).
+    const auto size = std::min(
+        std::max<uint64_t>(
+            header->size.load(std::memory_order_relaxed),
+            sizeof(message_size_type)),
+        ring.slot_size);
+    frame.data = slot + sizeof(FrameHeader);
+    frame.size = size;
+    frame.sequence = sequence;
+    _last_sequence = sequence;
+    return true;
+  }
+
+  bool RingReader::IsFrameValid(const Frame &frame) const {
+    // Make sure whatever the caller read out of the frame is ordered before
+    // re-reading the slot's sequence, seqlock style.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto *slot = GetSlot(frame.sequence - 1u);
+    const auto *header = reinterpret_cast<const FrameHeader *>(slot);
+    return header->sequence.load(std::memory_order_relaxed) == frame.sequence;
+  }
+
+#else // _WIN32
+
+  std::shared_ptr<RingWriter> RingWriter::Create(const std::string &, uint64_t, uint64_t) {
+    return nullptr; // not implemented on this platform, TCP is used instead.
+  }
+
+  RingWriter::~RingWriter() = default;
+
+  void RingWriter::Write(const boost::asio::const_buffer *, size_t) {}
+
+  std::shared_ptr<RingReader> RingReader::TryOpen(const std::string &) {
+    return nullptr;
+  }
+
+  RingReader::~RingReader() = default;
+
+  bool RingReader::PollFrame(Frame &) {
+    return false;
+  }
+
+  bool RingReader::IsFrameValid(const Frame &) const {
+    return false;
+  }
+
+#endif // _WIN32
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
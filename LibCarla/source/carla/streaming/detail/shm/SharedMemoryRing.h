@@ -0,0 +1,142 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/asio/buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace shm {
+
+  /// Returns the name of the shared memory object associated to a stream
+  /// served at @a port. Both ends derive the same name from the token so no
+  /// extra negotiation round-trip is needed.
+  std::string MakeRingName(uint16_t port, stream_id_type stream_id);
+
+#pragma pack(push, 1)
+
+  /// Header of each frame slot inside the ring. Both fields are read and
+  /// written concurrently across processes, hence the atomics; a sequence of
+  /// zero marks a slot the writer is currently overwriting.
+  struct FrameHeader {
+    std::atomic<uint64_t> sequence{0u};
+    std::atomic<uint64_t> size{0u};
+  };
+
+  /// Control block placed at the beginning of the shared memory segment.
+  struct RingHeader {
+    uint64_t magic = 0u;
+    uint64_t slot_size = 0u;
+    uint64_t slot_count = 0u;
+    std::atomic<uint64_t> head{0u}; ///< Sequence number of the next frame.
+  };
+
+#pragma pack(pop)
+
+  /// Server side of a single-producer shared memory ring. Each stream owns at
+  /// most one ring; frames are written in place into the mapped segment and
+  /// published by bumping an atomic sequence number, so a co-located reader
+  /// sees the pixels without them ever entering the TCP stack.
+  class RingWriter : private NonCopyable {
+  public:
+
+    /// Creates (or re-creates) the shared memory object @a name with
+    /// @a slot_count slots of @a slot_size bytes each. Returns nullptr on
+    /// platforms without POSIX shared memory or if the segment cannot be
+    /// created, callers are expected to silently fall back to TCP.
+    static std::shared_ptr<RingWriter> Create(
+        const std::string &name,
+        uint64_t slot_size,
+        uint64_t slot_count);
+
+    ~RingWriter();
+
+    /// Copies the wire frame made of @a count @a buffers into the next slot
+    /// and publishes it. This is the only copy the frame pays on its way to a
+    /// co-located client. Frames bigger than the slot size are dropped with a
+    /// warning, the TCP path still delivers them.
+    void Write(const boost::asio::const_buffer *buffers, size_t count);
+
+  private:
+
+    RingWriter(std::string name, int fd, uint8_t *mapping, uint64_t mapped_size);
+
+    RingHeader &GetHeader() const;
+
+    uint8_t *GetSlot(uint64_t sequence) const;
+
+    const std::string _name;
+
+    const int _fd;
+
+    uint8_t *const _mapping;
+
+    const uint64_t _mapped_size;
+  };
+
+  /// Client side of the ring. Maps the segment read-only and hands out views
+  /// directly over the shared pages.
+  class RingReader : private NonCopyable {
+  public:
+
+    /// A view over a frame living in the shared mapping. Valid until the ring
+    /// wraps around; PollFrame tells the caller when a frame was overrun.
+    struct Frame {
+      const Buffer::value_type *data = nullptr;
+      uint64_t size = 0u;
+      uint64_t sequence = 0u;
+    };
+
+    /// Tries to map an existing ring, returns nullptr if the server did not
+    /// create one for this stream.
+    static std::shared_ptr<RingReader> TryOpen(const std::string &name);
+
+    ~RingReader();
+
+    /// Polls for a frame newer than the last one returned. Returns true and
+    /// fills @a frame when a new frame is available. Frames older than the
+    /// ring capacity are skipped (the drop is logged at debug level).
+    bool PollFrame(Frame &frame);
+
+    /// Whether @a frame still holds the bytes PollFrame returned it with.
+    /// Consumers must re-check after copying the frame out and discard the
+    /// copy on failure: a writer lapping the ring mid-copy leaves the copy
+    /// torn.
+    bool IsFrameValid(const Frame &frame) const;
+
+  private:
+
+    RingReader(int fd, const uint8_t *mapping, uint64_t mapped_size);
+
+    const RingHeader &GetHeader() const;
+
+    const uint8_t *GetSlot(uint64_t sequence) const;
+
+    const int _fd;
+
+    const uint8_t *const _mapping;
+
+    const uint64_t _mapped_size;
+
+    uint64_t _last_sequence = 0u;
+  };
+
+} // namespace shm
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -75,7 +75,7 @@ namespace tcp {
       _callback(std::move(callback)),
       _socket(io_context),
       _strand(io_context),
-      _connection_timer(io_context),
+      _timer_wheel(TimerWheel::SharedForContext(io_context)),
       _buffer_pool(std::make_shared<BufferPool>()) {
     if (!_token.protocol_is_tcp()) {
       throw_exception(std::invalid_argument("invalid token, only TCP tokens supported"));
@@ -120,7 +120,9 @@ namespace tcp {
                 }
                 if (!ec) {
                   DEBUG_ASSERT_EQ(bytes, sizeof(stream_id));
-                  // If succeeded start reading data.
+                  // If succeeded start reading data, and reset the
+                  // reconnection back-off for the next drop.
+                  _reconnect_delay = time_duration::seconds(1u);
                   ReadData();
                 } else {
                   // Else try again.
@@ -140,7 +142,9 @@ namespace tcp {
   }
 
   void Client::Stop() {
-    _connection_timer.cancel();
+    if (_reconnect_timer != nullptr) {
+      _timer_wheel->Cancel(_reconnect_timer);
+    }
     auto self = shared_from_this();
     boost::asio::post(_strand, [this, self]() {
       _done = true;
@@ -151,13 +155,18 @@ namespace tcp {
   }
 
   void Client::Reconnect() {
-    auto self = shared_from_this();
-    _connection_timer.expires_from_now(time_duration::seconds(1u));
-    _connection_timer.async_wait([this, self](boost::system::error_code ec) {
-      if (!ec) {
-        Connect();
-      }
-    });
+    constexpr size_t max_delay_seconds = 30u;
+    if (_reconnect_timer == nullptr) {
+      std::weak_ptr<Client> weak = shared_from_this();
+      _reconnect_timer = _timer_wheel->MakeTimer([weak]() {
+        if (auto self = weak.lock()) {
+          self->Connect();
+        }
+      });
+    }
+    _timer_wheel->Arm(_reconnect_timer, _reconnect_delay);
+    _reconnect_delay = time_duration::milliseconds(
+        std::min(max_delay_seconds * 1000u, 2u * _reconnect_delay.milliseconds()));
   }
 
   void Client::ReadData() {
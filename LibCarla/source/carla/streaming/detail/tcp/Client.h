@@ -8,11 +8,12 @@
 
 #include "carla/Buffer.h"
 #include "carla/NonCopyable.h"
+#include "carla/Time.h"
 #include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/TimerWheel.h"
 #include "carla/streaming/detail/Token.h"
 #include "carla/streaming/detail/Types.h"
 
-#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
@@ -31,6 +32,12 @@ namespace tcp {
 
   /// A client that connects to a single stream.
   ///
+  /// The token is kept for the whole lifetime of the client, so a dropped
+  /// connection is re-established with the original token alone; no RPC round
+  /// trip to the simulator is needed. Reconnection attempts back off
+  /// exponentially up to a cap and the delay resets once a connection
+  /// succeeds.
+  ///
   /// @warning This client should be stopped before releasing the shared pointer
   /// or won't be destroyed.
   class Client
@@ -72,10 +79,14 @@ namespace tcp {
 
     boost::asio::io_context::strand _strand;
 
-    boost::asio::deadline_timer _connection_timer;
+    std::shared_ptr<TimerWheel> _timer_wheel;
+
+    TimerWheel::TimerHandle _reconnect_timer;
 
     std::shared_ptr<BufferPool> _buffer_pool;
 
+    time_duration _reconnect_delay = time_duration::seconds(1u);
+
     std::atomic_bool _done{false};
   };
 
@@ -48,8 +48,12 @@ namespace tcp {
       : MessageTmpl(size, std::move(buffers)...) {
       ++_number_of_buffers;
       _total_size += buffer.size();
-      _buffer_views[1u + size - _number_of_buffers] = buffer.cbuffer();
+      // The view has to be taken after the move: small buffers live in the
+      // Buffer's inline storage, so moving one relocates its bytes and
+      // would leave a view taken earlier dangling.
       _buffers[size - _number_of_buffers] = std::move(buffer);
+      _buffer_views[1u + size - _number_of_buffers] =
+          _buffers[size - _number_of_buffers].cbuffer();
     }
 
   public:
@@ -86,9 +90,11 @@ namespace tcp {
     std::array<boost::asio::const_buffer, MaxNumberOfBuffers + 1u> _buffer_views;
   };
 
-  /// A TCP message containing a maximum of 2 buffers. This is optimized for a
-  /// header and body sort of messages.
-  using Message = MessageTmpl<2u>;
+  /// A TCP message containing a maximum of 4 buffers. The wire concatenates
+  /// the segments, so a serializer can frame a sub-header and its payload as
+  /// separate segments instead of copying the sub-header into the payload
+  /// buffer; the client sees the exact same bytes either way.
+  using Message = MessageTmpl<4u>;
 
 } // namespace tcp
 } // namespace detail
@@ -22,13 +22,58 @@ namespace tcp {
       _acceptor(_io_context, std::move(ep)),
       _timeout(time_duration::seconds(10u)) {}
 
+  std::shared_ptr<ServerSession> Server::PopRecycledSession(
+      const boost::asio::io_context &session_context) {
+    std::lock_guard<std::mutex> lock(_recycled_sessions_mutex);
+    auto it = _recycled_sessions.find(&session_context);
+    if ((it == _recycled_sessions.end()) || it->second.empty()) {
+      return nullptr;
+    }
+    auto session = std::move(it->second.back());
+    it->second.pop_back();
+    return session;
+  }
+
+  void Server::RecycleSession(
+      const boost::asio::io_context *session_context,
+      std::shared_ptr<ServerSession> session) {
+    constexpr size_t max_recycled_per_context = 64u;
+    std::lock_guard<std::mutex> lock(_recycled_sessions_mutex);
+    auto &pool = _recycled_sessions[session_context];
+    if (pool.size() < max_recycled_per_context) {
+      pool.emplace_back(std::move(session));
+    }
+  }
+
   void Server::OpenSession(
       time_duration timeout,
       ServerSession::callback_function_type on_opened,
       ServerSession::callback_function_type on_closed) {
     using boost::system::error_code;
 
-    auto session = std::make_shared<ServerSession>(_io_context, timeout);
+    // Sessions run on their own io context when sharding is enabled, only
+    // the accept itself stays on the server's io context.
+    auto &session_context = (_session_pool != nullptr) ? _session_pool->NextContext() : _io_context;
+
+    // Reconnecting clients are common, recycle a closed session when we have
+    // one instead of re-allocating socket, strand and buffers.
+    auto session = PopRecycledSession(session_context);
+    if (session != nullptr) {
+      session->PrepareForReuse(timeout);
+    } else {
+      session = std::make_shared<ServerSession>(session_context, timeout);
+    }
+    session->SetMaxPendingBytes(_max_pending_bytes);
+
+    // Intercept the close to return the session to the pool once the user
+    // callback has run. CloseNow delivers this through the session's strand,
+    // so by the time the session lands in the pool the strand has drained
+    // every handler queued for the old connection.
+    on_closed = [this, context=&session_context, on_closed=std::move(on_closed)](
+        std::shared_ptr<ServerSession> closed_session) {
+      on_closed(closed_session);
+      RecycleSession(context, std::move(closed_session));
+    };
 
     auto handle_query = [on_opened, on_closed, session](const error_code &ec) {
       if (!ec) {
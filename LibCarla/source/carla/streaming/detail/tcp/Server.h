@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "carla/IoContextPool.h"
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
 #include "carla/streaming/detail/tcp/ServerSession.h"
@@ -15,6 +16,9 @@
 #include <boost/asio/post.hpp>
 
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -41,16 +45,40 @@ namespace tcp {
       _timeout = timeout;
     }
 
+    /// Shard newly accepted sessions across the io contexts of @a pool
+    /// instead of running them all on the acceptor's io context. The pool
+    /// must outlive this server and be running.
+    void ShardSessionsAcross(std::shared_ptr<IoContextPool> pool) {
+      _session_pool = std::move(pool);
+    }
+
+    /// Set the per-session write coalescing budget, i.e. how many bytes may
+    /// accumulate while a write is in flight before messages are discarded.
+    /// Applies only to newly created sessions.
+    void SetMaxPendingBytes(size_t bytes) {
+      _max_pending_bytes = bytes;
+    }
+
+    /// Number of accept operations kept pending at all times. A reconnect
+    /// storm, e.g. every sensor re-listening after an episode restart, is
+    /// then absorbed in a single round through the io context instead of one
+    /// connection per round. Applies to the next call to Listen.
+    void SetAcceptChainLength(size_t length) {
+      _accept_chain_length = length;
+    }
+
     /// Start listening for connections. On each new connection, @a
     /// on_session_opened is called, and @a on_session_closed when the session
     /// is closed.
     template <typename FunctorT1, typename FunctorT2>
     void Listen(FunctorT1 on_session_opened, FunctorT2 on_session_closed) {
       boost::asio::post(_io_context, [=]() {
-        OpenSession(
-            _timeout,
-            std::move(on_session_opened),
-            std::move(on_session_closed));
+        // Each chain perpetuates itself, accepting one connection and
+        // immediately re-arming.
+        const size_t chains = _accept_chain_length;
+        for (size_t i = 0u; i < chains; ++i) {
+          OpenSession(_timeout, on_session_opened, on_session_closed);
+        }
       });
     }
 
@@ -61,11 +89,34 @@ namespace tcp {
         ServerSession::callback_function_type on_session_opened,
         ServerSession::callback_function_type on_session_closed);
 
+    /// Pops a closed session previously created on @a session_context, or
+    /// nullptr if the pool is empty.
+    std::shared_ptr<ServerSession> PopRecycledSession(
+        const boost::asio::io_context &session_context);
+
+    void RecycleSession(
+        const boost::asio::io_context *session_context,
+        std::shared_ptr<ServerSession> session);
+
     boost::asio::io_context &_io_context;
 
     boost::asio::ip::tcp::acceptor _acceptor;
 
     std::atomic<time_duration> _timeout;
+
+    std::atomic_size_t _max_pending_bytes{16u * 1024u * 1024u};
+
+    std::atomic_size_t _accept_chain_length{8u};
+
+    std::shared_ptr<IoContextPool> _session_pool;
+
+    std::mutex _recycled_sessions_mutex;
+
+    /// Closed sessions waiting to be reused, keyed by the io context they
+    /// were created on since socket and strand stay bound to it.
+    std::unordered_map<
+        const boost::asio::io_context *,
+        std::vector<std::shared_ptr<ServerSession>>> _recycled_sessions;
   };
 
 } // namespace tcp
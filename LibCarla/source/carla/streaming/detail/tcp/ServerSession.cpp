@@ -8,6 +8,8 @@
 
 #include "carla/Debug.h"
 #include "carla/Logging.h"
+#include "carla/profiler/AllocationTracker.h"
+#include "carla/profiler/Tracer.h"
 
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
@@ -15,6 +17,7 @@
 #include <boost/asio/post.hpp>
 
 #include <atomic>
+#include <chrono>
 
 namespace carla {
 namespace streaming {
@@ -31,7 +34,7 @@ namespace tcp {
       _session_id(SESSION_COUNTER++),
       _socket(io_context),
       _timeout(timeout),
-      _deadline(io_context),
+      _timer_wheel(TimerWheel::SharedForContext(io_context)),
       _strand(io_context) {}
 
   void ServerSession::Open(
@@ -45,7 +48,19 @@ namespace tcp {
     const boost::asio::ip::tcp::no_delay option(true);
     _socket.set_option(option);
 
-    StartTimer();
+    // Inactivity deadline, shared wheel instead of a timer of our own so
+    // re-arming it per message stays an atomic store. Recycled sessions keep
+    // their timer.
+    if (_idle_timer == nullptr) {
+      std::weak_ptr<ServerSession> weak = shared_from_this();
+      _idle_timer = _timer_wheel->MakeTimer([weak]() {
+        if (auto session = weak.lock()) {
+          log_debug("session", session->_session_id, "timed out");
+          session->Close();
+        }
+      });
+    }
+
     auto self = shared_from_this(); // To keep myself alive.
     boost::asio::post(_strand, [=]() {
 
@@ -63,7 +78,7 @@ namespace tcp {
       };
 
       // Read the stream id.
-      _deadline.expires_from_now(_timeout);
+      _timer_wheel->Arm(_idle_timer, _timeout);
       boost::asio::async_read(
           _socket,
           boost::asio::buffer(&_stream_id, sizeof(_stream_id)),
@@ -75,17 +90,35 @@ namespace tcp {
     DEBUG_ASSERT(message != nullptr);
     DEBUG_ASSERT(!message->empty());
     auto self = shared_from_this();
+    const auto generation = _reuse_count.load(std::memory_order_acquire);
     boost::asio::post(_strand, [=]() {
+      CARLA_TRACE_ZONE(streaming, write);
+      CARLA_ALLOCATION_SCOPE(Streaming);
+      if (generation != _reuse_count.load(std::memory_order_acquire)) {
+        return; // queued against a previous connection, the session was recycled.
+      }
       if (!_socket.is_open()) {
         return;
       }
       if (_is_writing) {
-        log_debug("session", _session_id, ": connection too slow: message discarded");
+        // Coalesce with the next write instead of dropping; the completion
+        // handler flushes everything queued in one scatter-gather write.
+        if (_pending_bytes + message->size() > _max_pending_bytes) {
+          log_debug("session", _session_id, ": connection too slow: message discarded");
+          ++_dropped_messages;
+          return;
+        }
+        _pending_bytes += message->size();
+        _pending_messages.emplace_back(std::move(message));
         return;
       }
       _is_writing = true;
 
-      auto handle_sent = [this, self, message](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+      const auto start = std::chrono::steady_clock::now();
+      auto handle_sent = [this, self, message, start, generation](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+        if (generation != _reuse_count.load(std::memory_order_acquire)) {
+          return; // the session was recycled while this write was in flight.
+        }
         _is_writing = false;
         if (ec) {
           log_info("session", _session_id, ": error sending data :", ec.message());
@@ -93,12 +126,16 @@ namespace tcp {
         } else {
           DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "bytes"));
           DEBUG_ASSERT_EQ(bytes, sizeof(message_size_type) + message->size());
+          _last_write_latency_us = static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start).count());
+          FlushPending();
         }
       };
 
       log_debug("session", _session_id, ": sending message of", message->size(), "bytes");
 
-      _deadline.expires_from_now(_timeout);
+      _timer_wheel->Arm(_idle_timer, _timeout);
       boost::asio::async_write(
           _socket,
           message->GetBufferSequence(),
@@ -106,32 +143,84 @@ namespace tcp {
     });
   }
 
+  void ServerSession::FlushPending() {
+    DEBUG_ASSERT(_strand.running_in_this_thread());
+    if (_pending_messages.empty() || !_socket.is_open()) {
+      return;
+    }
+    auto messages = std::make_shared<std::vector<std::shared_ptr<const Message>>>(
+        std::move(_pending_messages));
+    _pending_messages.clear();
+    _pending_bytes = 0u;
+
+    // One writev for everything accumulated while the previous write was on
+    // the wire; for high-rate small sensors this amortizes the syscall.
+    std::vector<boost::asio::const_buffer> buffers;
+    for (auto &message : *messages) {
+      for (auto &buffer : message->GetBufferSequence()) {
+        buffers.emplace_back(buffer);
+      }
+    }
+    _is_writing = true;
+
+    auto self = shared_from_this();
+    const auto generation = _reuse_count.load(std::memory_order_acquire);
+    auto handle_sent = [this, self, messages, generation](const boost::system::error_code &ec, size_t DEBUG_ONLY(bytes)) {
+      if (generation != _reuse_count.load(std::memory_order_acquire)) {
+        return; // the session was recycled while this write was in flight.
+      }
+      _is_writing = false;
+      if (ec) {
+        log_info("session", _session_id, ": error sending data :", ec.message());
+        CloseNow();
+      } else {
+        DEBUG_ONLY(log_debug("session", _session_id, ": successfully sent", bytes, "coalesced bytes"));
+        FlushPending();
+      }
+    };
+
+    log_debug("session", _session_id, ": sending", messages->size(), "coalesced messages");
+
+    _timer_wheel->Arm(_idle_timer, _timeout);
+    boost::asio::async_write(
+        _socket,
+        buffers,
+        boost::asio::bind_executor(_strand, handle_sent));
+  }
+
   void ServerSession::Close() {
     boost::asio::post(_strand, [self=shared_from_this()]() { self->CloseNow(); });
   }
 
-  void ServerSession::StartTimer() {
-    if (_deadline.expires_at() <= boost::asio::deadline_timer::traits_type::now()) {
-      log_debug("session", _session_id, "timed out");
-      Close();
-    } else {
-      _deadline.async_wait([this, self=shared_from_this()](boost::system::error_code ec) {
-        if (!ec) {
-          StartTimer();
-        } else {
-          log_debug("session", _session_id, "timed out error:", ec.message());
-        }
-      });
-    }
+  void ServerSession::PrepareForReuse(const time_duration timeout) {
+    // Runs off-strand on the acceptor thread, but only after the
+    // strand-posted finalizer in CloseNow pooled the session, so the strand
+    // holds no more work for the previous connection. The bump retires any
+    // write a slow producer still queues against the old session.
+    _reuse_count.fetch_add(1u, std::memory_order_acq_rel);
+    _timeout = timeout;
+    _stream_id = 0u;
+    _on_closed = nullptr;
+    _is_writing = false;
+    // clear() keeps the vector capacity, which is the point of recycling.
+    _pending_messages.clear();
+    _pending_bytes = 0u;
+    _dropped_messages = 0u;
+    _last_write_latency_us = 0u;
   }
 
   void ServerSession::CloseNow() {
     DEBUG_ASSERT(_strand.running_in_this_thread());
-    _deadline.cancel();
+    if (_idle_timer != nullptr) {
+      _timer_wheel->Cancel(_idle_timer);
+    }
     if (_socket.is_open()) {
       _socket.close();
     }
-    boost::asio::post(_strand.context(), [self=shared_from_this()]() {
+    // Hand the session back through the strand, not the bare context: every
+    // handler already queued for this connection runs first, so the server
+    // only sees the session (and can recycle it) once the strand drained.
+    boost::asio::post(_strand, [self=shared_from_this()]() {
       DEBUG_ASSERT(self->_on_closed);
       self->_on_closed(self);
     });
@@ -10,16 +10,18 @@
 #include "carla/Time.h"
 #include "carla/TypeTraits.h"
 #include "carla/profiler/LifetimeProfiled.h"
+#include "carla/streaming/detail/TimerWheel.h"
 #include "carla/streaming/detail/Types.h"
 #include "carla/streaming/detail/tcp/Message.h"
 
-#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace carla {
 namespace streaming {
@@ -74,9 +76,33 @@ namespace tcp {
     /// Post a job to close the session.
     void Close();
 
+    /// Return the session to a clean state so the server can recycle it for
+    /// the next accepted connection, keeping the allocated buffers around.
+    /// Only call on a closed session.
+    void PrepareForReuse(time_duration timeout);
+
+    /// Set the maximum number of bytes that can be queued while a write is in
+    /// flight; messages arriving on a full queue are discarded. Should only be
+    /// called before the session is opened.
+    void SetMaxPendingBytes(size_t bytes) {
+      _max_pending_bytes = bytes;
+    }
+
+    /// Number of messages discarded because this connection could not keep up.
+    uint64_t GetDroppedMessageCount() const {
+      return _dropped_messages;
+    }
+
+    /// Wire latency of the last completed write, in microseconds.
+    uint64_t GetLastWriteLatency() const {
+      return _last_write_latency_us;
+    }
+
   private:
 
-    void StartTimer();
+    /// Sends every queued message in a single scatter-gather write. Must be
+    /// called from within the strand.
+    void FlushPending();
 
     void CloseNow();
 
@@ -90,13 +116,32 @@ namespace tcp {
 
     time_duration _timeout;
 
-    boost::asio::deadline_timer _deadline;
+    std::shared_ptr<TimerWheel> _timer_wheel;
+
+    TimerWheel::TimerHandle _idle_timer;
 
     boost::asio::io_context::strand _strand;
 
     callback_function_type _on_closed;
 
     bool _is_writing = false;
+
+    // messages coalesced while a write is in flight, flushed as one
+    // scatter-gather write when the socket becomes available
+    std::vector<std::shared_ptr<const Message>> _pending_messages;
+
+    size_t _pending_bytes = 0u;
+
+    size_t _max_pending_bytes = 16u * 1024u * 1024u;
+
+    std::atomic<uint64_t> _dropped_messages{0u};
+
+    std::atomic<uint64_t> _last_write_latency_us{0u};
+
+    /// Bumped every time the session is recycled; write handlers capture it
+    /// so work queued against a previous connection cannot touch the new one
+    /// (the socket being open again defeats the is_open guard).
+    std::atomic<uint64_t> _reuse_count{0u};
   };
 
 } // namespace tcp
@@ -0,0 +1,146 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/udp/Broadcaster.h"
+
+#include "carla/Logging.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  constexpr std::chrono::seconds Broadcaster::SUBSCRIPTION_TIMEOUT;
+
+  Broadcaster::Broadcaster(boost::asio::io_context &io_context, uint16_t port)
+    : _socket(io_context, endpoint(boost::asio::ip::udp::v4(), port)),
+      _strand(io_context) {}
+
+  void Broadcaster::Listen() {
+    boost::asio::post(_strand, [self=shared_from_this()]() {
+      self->ReceiveSubscription();
+    });
+  }
+
+  void Broadcaster::ReceiveSubscription() {
+    auto self = shared_from_this();
+    _socket.async_receive_from(
+        boost::asio::buffer(&_subscription_datagram, sizeof(_subscription_datagram)),
+        _subscription_sender,
+        boost::asio::bind_executor(_strand, [this, self](boost::system::error_code ec, size_t bytes) {
+          if (!ec && (bytes == sizeof(SubscribeDatagram)) &&
+              (_subscription_datagram.magic == SubscribeDatagram::SUBSCRIBE_MAGIC)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto &subscribers = _subscribers[_subscription_datagram.stream_id];
+            if (subscribers.emplace(_subscription_sender, clock::now()).second) {
+              log_debug("udp: new subscriber for stream", _subscription_datagram.stream_id);
+            } else {
+              subscribers[_subscription_sender] = clock::now(); // keep-alive.
+            }
+          }
+          if (!ec) {
+            ReceiveSubscription();
+          }
+        }));
+  }
+
+  void Broadcaster::Write(stream_id_type stream_id, std::shared_ptr<const tcp::Message> message) {
+    std::vector<endpoint> targets;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto search = _subscribers.find(stream_id);
+      if (search == _subscribers.end()) {
+        return;
+      }
+      const auto deadline = clock::now() - SUBSCRIPTION_TIMEOUT;
+      auto &subscribers = search->second;
+      for (auto it = subscribers.begin(); it != subscribers.end(); ) {
+        if (it->second < deadline) {
+          log_debug("udp: subscription to stream", stream_id, "expired");
+          it = subscribers.erase(it);
+        } else {
+          targets.emplace_back(it->first);
+          ++it;
+        }
+      }
+    }
+    if (targets.empty()) {
+      return;
+    }
+
+    const auto sequence = ++_next_sequence;
+    auto self = shared_from_this();
+    boost::asio::post(_strand, [this, self, message, targets, sequence]() {
+
+      // Flatten the wire views of the message skipping the size prefix, the
+      // frame boundary is given by the datagram headers instead.
+      std::vector<boost::asio::const_buffer> payload;
+      uint64_t total_size = 0u;
+      bool first = true;
+      for (auto &view : message->GetBufferSequence()) {
+        if (first) {
+          first = false; // size prefix.
+          continue;
+        }
+        payload.emplace_back(view);
+        total_size += view.size();
+      }
+
+      const auto fragment_count = static_cast<uint32_t>(
+          (total_size + DATAGRAM_PAYLOAD_SIZE - 1u) / DATAGRAM_PAYLOAD_SIZE);
+
+      // Keep the headers and the message alive until every datagram is out.
+      auto headers = std::make_shared<std::vector<DatagramHeader>>(fragment_count);
+
+      size_t view_index = 0u;
+      size_t view_offset = 0u;
+      for (uint32_t i = 0u; i < fragment_count; ++i) {
+        auto &header = (*headers)[i];
+        header.frame_sequence = sequence;
+        header.fragment_index = i;
+        header.fragment_count = fragment_count;
+
+        std::vector<boost::asio::const_buffer> datagram;
+        datagram.emplace_back(&header, sizeof(header));
+        size_t remaining = DATAGRAM_PAYLOAD_SIZE;
+        while ((remaining > 0u) && (view_index < payload.size())) {
+          const auto &view = payload[view_index];
+          const auto chunk = std::min(remaining, view.size() - view_offset);
+          datagram.emplace_back(
+              static_cast<const unsigned char *>(view.data()) + view_offset,
+              chunk);
+          remaining -= chunk;
+          view_offset += chunk;
+          if (view_offset == view.size()) {
+            ++view_index;
+            view_offset = 0u;
+          }
+        }
+
+        for (const auto &target : targets) {
+          _socket.async_send_to(
+              datagram,
+              target,
+              boost::asio::bind_executor(_strand,
+                  [message, headers](boost::system::error_code ec, size_t) {
+                    if (ec) {
+                      log_debug("udp: send error:", ec.message());
+                    }
+                  }));
+        }
+      }
+    }); // post
+  }
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,78 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/udp/Datagram.h"
+#include "carla/streaming/detail/tcp/Message.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// Server side of the lossy datagram transport. A single UDP socket bound
+  /// to the streaming port receives subscription datagrams and fans frames
+  /// out to every subscriber of a stream, fragmenting them as needed. No
+  /// retransmission is attempted, late frames are worthless for high-rate
+  /// camera streams.
+  class Broadcaster
+    : public std::enable_shared_from_this<Broadcaster>,
+      private NonCopyable {
+  public:
+
+    using endpoint = boost::asio::ip::udp::endpoint;
+
+    Broadcaster(boost::asio::io_context &io_context, uint16_t port);
+
+    /// Starts listening for subscription datagrams.
+    void Listen();
+
+    /// Sends @a message to every endpoint subscribed to @a stream_id.
+    void Write(stream_id_type stream_id, std::shared_ptr<const tcp::Message> message);
+
+  private:
+
+    void ReceiveSubscription();
+
+    using clock = std::chrono::steady_clock;
+
+    static constexpr auto SUBSCRIPTION_TIMEOUT = std::chrono::seconds(10);
+
+    boost::asio::ip::udp::socket _socket;
+
+    // all socket operations run on this strand, Write may be called from any
+    // thread
+    boost::asio::io_context::strand _strand;
+
+    std::mutex _mutex;
+
+    std::unordered_map<stream_id_type, std::map<endpoint, clock::time_point>> _subscribers;
+
+    SubscribeDatagram _subscription_datagram;
+
+    endpoint _subscription_sender;
+
+    std::atomic<uint64_t> _next_sequence{0u};
+  };
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,135 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/detail/udp/Client.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+
+#include <cstring>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  Client::Client(
+      boost::asio::io_context &io_context,
+      const token_type &token,
+      callback_function_type callback)
+    : _token(token),
+      _callback(std::move(callback)),
+      _socket(io_context, endpoint(boost::asio::ip::udp::v4(), 0u)),
+      _strand(io_context),
+      _keep_alive_timer(io_context),
+      _buffer_pool(std::make_shared<BufferPool>()),
+      _datagram(sizeof(DatagramHeader) + DATAGRAM_PAYLOAD_SIZE) {
+    if (!_token.protocol_is_udp()) {
+      throw_exception(std::invalid_argument("invalid token, only UDP tokens supported"));
+    }
+    _subscription_datagram.stream_id = _token.get_stream_id();
+  }
+
+  void Client::Connect() {
+    auto self = shared_from_this();
+    boost::asio::post(_strand, [this, self]() {
+      SendSubscription();
+      ReceiveData();
+    });
+  }
+
+  void Client::Stop() {
+    _done = true;
+    auto self = shared_from_this();
+    boost::asio::post(_strand, [this, self]() {
+      _keep_alive_timer.cancel();
+      if (_socket.is_open()) {
+        _socket.close();
+      }
+    });
+  }
+
+  void Client::SendSubscription() {
+    if (_done) {
+      return;
+    }
+    // The subscription doubles as keep-alive, resend it periodically so the
+    // server side does not expire us; losing one is harmless.
+    _socket.send_to(
+        boost::asio::buffer(&_subscription_datagram, sizeof(_subscription_datagram)),
+        _token.to_udp_endpoint());
+    _keep_alive_timer.expires_from_now(boost::posix_time::seconds(2));
+    auto self = shared_from_this();
+    _keep_alive_timer.async_wait(
+        boost::asio::bind_executor(_strand, [this, self](boost::system::error_code ec) {
+          if (!ec) {
+            SendSubscription();
+          }
+        }));
+  }
+
+  void Client::ReceiveData() {
+    if (_done) {
+      return;
+    }
+    auto self = shared_from_this();
+    _socket.async_receive(
+        boost::asio::buffer(_datagram),
+        boost::asio::bind_executor(_strand, [this, self](boost::system::error_code ec, size_t bytes) {
+          if (ec || (bytes < sizeof(DatagramHeader))) {
+            if (!_done && !ec) {
+              ReceiveData();
+            }
+            return;
+          }
+
+          DatagramHeader header;
+          std::memcpy(&header, _datagram.data(), sizeof(header));
+          const auto payload_size = bytes - sizeof(header);
+
+          if (header.frame_sequence != _frame_sequence) {
+            if (_fragment_count != 0u) {
+              log_debug("udp: stream", GetStreamId(), ": frame", _frame_sequence, "dropped");
+            }
+            // Start reassembling the new frame, the old one is lost.
+            _frame_sequence = header.frame_sequence;
+            _fragment_count = header.fragment_count;
+            _fragments_received = 0u;
+            _frame = _buffer_pool->Pop();
+            _frame.reset(static_cast<uint64_t>(header.fragment_count) * DATAGRAM_PAYLOAD_SIZE);
+          }
+
+          if ((header.fragment_index < _fragment_count) &&
+              (header.fragment_index * DATAGRAM_PAYLOAD_SIZE + payload_size <= _frame.size())) {
+            std::memcpy(
+                _frame.data() + header.fragment_index * DATAGRAM_PAYLOAD_SIZE,
+                _datagram.data() + sizeof(header),
+                payload_size);
+            ++_fragments_received;
+            if (header.fragment_index == _fragment_count - 1u) {
+              // The last fragment tells us the actual frame size.
+              _last_fragment_size = static_cast<uint32_t>(payload_size);
+            }
+            if (_fragments_received == _fragment_count) {
+              _frame.resize(
+                  static_cast<uint64_t>(_fragment_count - 1u) * DATAGRAM_PAYLOAD_SIZE +
+                  _last_fragment_size);
+              _fragment_count = 0u;
+              _callback(std::move(_frame));
+            }
+          }
+
+          ReceiveData();
+        }));
+  }
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
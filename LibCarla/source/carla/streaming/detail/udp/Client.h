@@ -0,0 +1,97 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/BufferPool.h"
+#include "carla/NonCopyable.h"
+#include "carla/streaming/detail/Token.h"
+#include "carla/streaming/detail/Types.h"
+#include "carla/streaming/detail/udp/Datagram.h"
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// A client that consumes a single stream over the lossy datagram
+  /// transport. Fragments are reassembled into frames; a frame is discarded
+  /// as soon as a newer one starts arriving, so a lost datagram costs one
+  /// frame and nothing else.
+  class Client
+    : public std::enable_shared_from_this<Client>,
+      private NonCopyable {
+  public:
+
+    using endpoint = boost::asio::ip::udp::endpoint;
+    using protocol_type = endpoint::protocol_type;
+    using callback_function_type = std::function<void(Buffer)>;
+
+    Client(
+        boost::asio::io_context &io_context,
+        const token_type &token,
+        callback_function_type callback);
+
+    /// Sends the subscription datagram and starts receiving frames.
+    void Connect();
+
+    stream_id_type GetStreamId() const {
+      return _token.get_stream_id();
+    }
+
+    void Stop();
+
+  private:
+
+    void SendSubscription();
+
+    void ReceiveData();
+
+    const token_type _token;
+
+    callback_function_type _callback;
+
+    boost::asio::ip::udp::socket _socket;
+
+    boost::asio::io_context::strand _strand;
+
+    boost::asio::deadline_timer _keep_alive_timer;
+
+    std::shared_ptr<BufferPool> _buffer_pool;
+
+    SubscribeDatagram _subscription_datagram;
+
+    // reassembly state of the frame currently on the wire
+    std::vector<unsigned char> _datagram;
+
+    Buffer _frame;
+
+    uint64_t _frame_sequence = 0u;
+
+    uint32_t _fragments_received = 0u;
+
+    uint32_t _fragment_count = 0u;
+
+    uint32_t _last_fragment_size = 0u;
+
+    std::atomic_bool _done{false};
+  };
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
@@ -0,0 +1,48 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/streaming/detail/Types.h"
+
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+namespace detail {
+namespace udp {
+
+  /// Maximum payload carried by a single datagram. Frames bigger than this
+  /// are split into fragments; a frame is dropped as a whole if any of its
+  /// fragments is lost, this transport deliberately trades reliability for
+  /// latency.
+  static constexpr size_t DATAGRAM_PAYLOAD_SIZE = 32u * 1024u;
+
+#pragma pack(push, 1)
+
+  /// Header prepended to every datagram of a fragmented frame.
+  struct DatagramHeader {
+    uint64_t frame_sequence = 0u;
+    uint32_t fragment_index = 0u;
+    uint32_t fragment_count = 0u;
+  };
+
+  /// Datagram periodically sent by a client to (re)subscribe to a stream.
+  /// Also serves as keep-alive, subscriptions expire server-side when no
+  /// datagram is seen for a while.
+  struct SubscribeDatagram {
+    uint32_t magic = SUBSCRIBE_MAGIC;
+    stream_id_type stream_id = 0u;
+
+    static constexpr uint32_t SUBSCRIBE_MAGIC = 0x43414442u; // "CADB"
+  };
+
+#pragma pack(pop)
+
+} // namespace udp
+} // namespace detail
+} // namespace streaming
+} // namespace carla
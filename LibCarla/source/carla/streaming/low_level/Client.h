@@ -8,6 +8,7 @@
 
 #include "carla/streaming/detail/Token.h"
 #include "carla/streaming/detail/tcp/Client.h"
+#include "carla/streaming/detail/udp/Client.h"
 
 #include <boost/asio/io_context.hpp>
 
@@ -44,6 +45,9 @@ namespace low_level {
       for (auto &pair : _clients) {
         pair.second->Stop();
       }
+      for (auto &pair : _udp_clients) {
+        pair.second->Stop();
+      }
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
@@ -57,6 +61,15 @@ namespace low_level {
       if (!token.has_address()) {
         token.set_address(_fallback_address);
       }
+      if (token.protocol_is_udp()) {
+        auto udp_client = std::make_shared<detail::udp::Client>(
+            io_context,
+            token,
+            std::forward<Functor>(callback));
+        udp_client->Connect();
+        _udp_clients.emplace(token.get_stream_id(), std::move(udp_client));
+        return;
+      }
       auto client = std::make_shared<underlying_client>(
           io_context,
           token,
@@ -71,6 +84,11 @@ namespace low_level {
         it->second->Stop();
         _clients.erase(it);
       }
+      auto udp_it = _udp_clients.find(token.get_stream_id());
+      if (udp_it != _udp_clients.end()) {
+        udp_it->second->Stop();
+        _udp_clients.erase(udp_it);
+      }
     }
 
   private:
@@ -80,6 +98,10 @@ namespace low_level {
     std::unordered_map<
         detail::stream_id_type,
         std::shared_ptr<underlying_client>> _clients;
+
+    std::unordered_map<
+        detail::stream_id_type,
+        std::shared_ptr<detail::udp::Client>> _udp_clients;
   };
 
 } // namespace low_level
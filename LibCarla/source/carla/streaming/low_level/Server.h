@@ -6,11 +6,15 @@
 
 #pragma once
 
+#include "carla/IoContextPool.h"
 #include "carla/streaming/detail/Dispatcher.h"
+#include "carla/streaming/detail/udp/Broadcaster.h"
 #include "carla/streaming/Stream.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <memory>
+
 namespace carla {
 namespace streaming {
 namespace low_level {
@@ -64,6 +68,35 @@ namespace low_level {
       return _dispatcher.MakeStream();
     }
 
+    /// Also export new streams through shared memory for co-located clients.
+    void EnableSharedMemory() {
+      _dispatcher.EnableSharedMemory();
+    }
+
+    /// Shard newly accepted sessions across the io contexts of @a pool.
+    void ShardSessionsAcross(std::shared_ptr<IoContextPool> pool) {
+      _server.ShardSessionsAcross(std::move(pool));
+    }
+
+    /// Compress the frames of the streams created from now on.
+    void EnableCompression() {
+      _dispatcher.EnableCompression();
+    }
+
+    /// Returns a telemetry snapshot for every live stream.
+    std::vector<detail::StreamTelemetry> GetTelemetry() {
+      return _dispatcher.GetTelemetry();
+    }
+
+    /// Serve new streams over the lossy datagram transport on the same port.
+    void EnableUdp(boost::asio::io_context &io_context) {
+      auto broadcaster = std::make_shared<detail::udp::Broadcaster>(
+          io_context,
+          GetLocalEndpoint().port());
+      broadcaster->Listen();
+      _dispatcher.EnableUdp(std::move(broadcaster));
+    }
+
   private:
 
     void StartServer() {
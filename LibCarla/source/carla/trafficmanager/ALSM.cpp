@@ -46,11 +46,54 @@ void ALSM::Update() {
 
   bool hybrid_physics_mode = parameters.GetHybridPhysicsMode();
 
-  std::set<ActorId> world_vehicle_ids;
-  std::set<ActorId> world_pedestrian_ids;
-  std::vector<ActorId> unregistered_list_to_be_deleted;
-
   current_timestamp = world.GetSnapshot().GetTimestamp();
+
+  // The position hash is rebuilt from scratch every cycle while actor data
+  // is refreshed below.
+  track_traffic.ClearPositionGrid();
+
+  // Ask the server only for registry changes since the previous cycle and
+  // apply the (usually empty) delta. The full scan of the actor list runs
+  // at low frequency as a consistency pass, and whenever the server could
+  // not resolve the version we hold.
+  rpc::ActorListDiff registry_diff = world.GetActorListDiff(actor_registry_version);
+  actor_registry_version = registry_diff.version;
+
+  if (registry_diff.is_full_list || cycles_since_full_scan >= FULL_ACTOR_SCAN_INTERVAL) {
+    FullActorScan(hybrid_physics_mode);
+    cycles_since_full_scan = 0u;
+  } else {
+    ApplyActorRegistryDelta(registry_diff, hybrid_physics_mode);
+    ++cycles_since_full_scan;
+  }
+
+  // Update dynamic state and static attributes for all registered vehicles.
+  ALSM::IdleInfo max_idle_time = std::make_pair(0u, current_timestamp.elapsed_seconds);
+  UpdateRegisteredActorsData(hybrid_physics_mode, max_idle_time);
+
+  // Destroy registered vehicle if stuck at a location for too long.
+  if (IsVehicleStuck(max_idle_time.first)
+      && (current_timestamp.elapsed_seconds - elapsed_last_actor_destruction) > DELTA_TIME_BETWEEN_DESTRUCTIONS) {
+    registered_vehicles.Destroy(max_idle_time.first);
+    RemoveActor(max_idle_time.first, true);
+    elapsed_last_actor_destruction = current_timestamp.elapsed_seconds;
+  }
+
+  // Destorying vehicles for marked for removal by stages.
+  if (parameters.GetOSMMode()) {
+    for (const ActorId& actor_id: marked_for_removal) {
+      registered_vehicles.Destroy(actor_id);
+      RemoveActor(actor_id, true);
+    }
+    marked_for_removal.clear();
+  }
+
+  // Update dynamic state and static attributes for unregistered actors.
+  UpdateUnregisteredActorsData();
+}
+
+void ALSM::FullActorScan(const bool hybrid_physics_mode) {
+
   ActorList world_actors = world.GetActors();
 
   // Find destroyed actors and perform clean up.
@@ -83,54 +126,72 @@ void ALSM::Update() {
   // Scan for new unregistered actors.
   ALSM::ActorVector new_actors = IdentifyNewActors(world_actors);
   for (const ActorPtr &actor: new_actors) {
-    unregistered_actors.insert({actor->GetId(), actor});
-
-    // Identify any new hero vehicle if the system is in hybrid physics mode.
-    if (hybrid_physics_mode) {
-      if (actor->GetTypeId().front() == 'v') {
-        ActorId hero_actor_id = actor->GetId();
-        for (auto&& attribute: actor->GetAttributes()) {
-          if (attribute.GetId() == "role_name" && attribute.GetValue() == "hero") {
-            hero_actors.insert({hero_actor_id, actor});
-          }
-        }
-      }
-    }
+    AddUnregisteredActor(actor, hybrid_physics_mode);
   }
+}
 
-  // Update dynamic state and static attributes for all registered vehicles.
-  ALSM::IdleInfo max_idle_time = std::make_pair(0u, current_timestamp.elapsed_seconds);
-  UpdateRegisteredActorsData(hybrid_physics_mode, max_idle_time);
+void ALSM::ApplyActorRegistryDelta(const rpc::ActorListDiff &diff, const bool hybrid_physics_mode) {
 
-  // Destroy registered vehicle if stuck at a location for too long.
-  if (IsVehicleStuck(max_idle_time.first)
-      && (current_timestamp.elapsed_seconds - elapsed_last_actor_destruction) > DELTA_TIME_BETWEEN_DESTRUCTIONS) {
-    registered_vehicles.Destroy(max_idle_time.first);
-    RemoveActor(max_idle_time.first, true);
-    elapsed_last_actor_destruction = current_timestamp.elapsed_seconds;
+  // Clean up actors destroyed since the previous cycle.
+  for (const ActorId deletion_id : diff.removed) {
+    if (registered_vehicles.Contains(deletion_id)) {
+      RemoveActor(deletion_id, true);
+    } else if (unregistered_actors.find(deletion_id) != unregistered_actors.end()) {
+      RemoveActor(deletion_id, false);
+    }
   }
 
-  // Destorying vehicles for marked for removal by stages.
-  if (parameters.GetOSMMode()) {
-    for (const ActorId& actor_id: marked_for_removal) {
-      registered_vehicles.Destroy(actor_id);
-      RemoveActor(actor_id, true);
+  // Drop unregistered entries for vehicles handed to the traffic manager
+  // since the previous cycle; their state is rebuilt through the registered
+  // vehicle update.
+  for (const ActorId registered_id : registered_vehicles.GetIDList()) {
+    if (unregistered_actors.find(registered_id) != unregistered_actors.end()) {
+      RemoveActor(registered_id, false);
     }
-    marked_for_removal.clear();
   }
 
-  // Update dynamic state and static attributes for unregistered actors.
-  UpdateUnregisteredActorsData();
+  // Start tracking actors spawned since the previous cycle.
+  std::vector<ActorId> new_actor_ids;
+  for (const auto &actor_description : diff.added) {
+    const ActorId actor_id = actor_description.id;
+    if (!registered_vehicles.Contains(actor_id)
+        && unregistered_actors.find(actor_id) == unregistered_actors.end()) {
+      new_actor_ids.push_back(actor_id);
+    }
+  }
+  if (!new_actor_ids.empty()) {
+    ActorList new_actors = world.GetActors(new_actor_ids);
+    for (auto iter = new_actors->begin(); iter != new_actors->end(); ++iter) {
+      AddUnregisteredActor(*iter, hybrid_physics_mode);
+    }
+  }
+}
+
+void ALSM::AddUnregisteredActor(const ActorPtr &actor, const bool hybrid_physics_mode) {
+  unregistered_actors.insert({actor->GetId(), actor});
+
+  // Identify any new hero vehicle if the system is in hybrid physics mode.
+  if (hybrid_physics_mode) {
+    if (actor->GetTypeId().front() == 'v') {
+      ActorId hero_actor_id = actor->GetId();
+      for (auto&& attribute: actor->GetAttributes()) {
+        if (attribute.GetId() == "role_name" && attribute.GetValue() == "hero") {
+          hero_actors.insert({hero_actor_id, actor});
+        }
+      }
+    }
+  }
 }
 
 std::vector<ActorPtr> ALSM::IdentifyNewActors(const ActorList &actor_list) {
   std::vector<ActorPtr> new_actors;
-  for  (auto iter = actor_list->begin(); iter != actor_list->end(); ++iter) {
-    ActorPtr actor = *iter;
-    ActorId actor_id = actor->GetId();
+  // Check ids first so only the actors actually new to the tracker get a
+  // client-side handle materialized.
+  for (size_t index = 0u; index < actor_list->size(); ++index) {
+    const ActorId actor_id = actor_list->GetActorId(index);
     if (!registered_vehicles.Contains(actor_id)
         && unregistered_actors.find(actor_id) == unregistered_actors.end()) {
-      new_actors.push_back(actor);
+      new_actors.push_back(actor_list->at(index));
     }
   }
   return new_actors;
@@ -144,8 +205,8 @@ ALSM::DestroyeddActors ALSM::IdentifyDestroyedActors(const ActorList &actor_list
 
   // Building hash set of actors present in current frame.
   ActorIdSet current_actors;
-  for  (auto iter = actor_list->begin(); iter != actor_list->end(); ++iter) {
-    current_actors.insert((*iter)->GetId());
+  for (size_t index = 0u; index < actor_list->size(); ++index) {
+    current_actors.insert(actor_list->GetActorId(index));
   }
 
   // Searching for destroyed registered actors.
@@ -174,12 +235,21 @@ void ALSM::UpdateRegisteredActorsData(const bool hybrid_physics_mode, ALSM::Idle
   bool hero_actor_present = hybrid_physics_mode && hero_actors.size() != 0u;
   float physics_radius = parameters.GetHybridPhysicsRadius();
   float physics_radius_square = SQUARE(physics_radius);
+  // One snapshot fetch covers every vehicle this update: the transform,
+  // velocity, speed limit and traffic light binding all come out of a single
+  // snapshot entry instead of one episode state lookup per accessor.
+  const cc::WorldSnapshot world_snapshot = world.GetSnapshot();
   for (const Actor &vehicle : vehicle_list) {
     ActorId actor_id = vehicle->GetId();
-    cg::Transform vehicle_transform = vehicle->GetTransform();
+    const auto snapshot = world_snapshot.Find(actor_id);
+    if (!snapshot.has_value()) {
+      // Not part of this frame yet, pick it up on the next update.
+      continue;
+    }
+    const cg::Transform vehicle_transform = snapshot->transform;
     cg::Location vehicle_location = vehicle_transform.location;
     cg::Rotation vehicle_rotation = vehicle_transform.rotation;
-    cg::Vector3D vehicle_velocity = vehicle->GetVelocity();
+    cg::Vector3D vehicle_velocity = snapshot->velocity;
 
     // Initializing idle times.
     if (idle_time.find(actor_id) == idle_time.end() && current_timestamp.elapsed_seconds != 0.0) {
@@ -218,11 +288,12 @@ void ALSM::UpdateRegisteredActorsData(const bool hybrid_physics_mode, ALSM::Idle
 
     // Updated kinematic state object.
     auto vehicle_ptr = boost::static_pointer_cast<cc::Vehicle>(vehicle);
+    const auto &vehicle_data = snapshot->state.vehicle_data;
     KinematicState kinematic_state{vehicle_location, vehicle_rotation,
-                                   vehicle_velocity, vehicle_ptr->GetSpeedLimit(), enable_physics};
+                                   vehicle_velocity, vehicle_data.speed_limit, enable_physics};
 
     // Updated traffic light state object.
-    TrafficLightState tl_state = {vehicle_ptr->GetTrafficLightState(), vehicle_ptr->IsAtTrafficLight()};
+    TrafficLightState tl_state = {vehicle_data.traffic_light_state, vehicle_data.has_traffic_light};
 
     // Update simulation state.
     if (state_entry_present) {
@@ -238,20 +309,28 @@ void ALSM::UpdateRegisteredActorsData(const bool hybrid_physics_mode, ALSM::Idle
 
     // Updating idle time when necessary.
     UpdateIdleTime(max_idle_time, actor_id);
+
+    track_traffic.UpdatePosition(actor_id, vehicle_location);
   }
 }
 
 void ALSM::UpdateUnregisteredActorsData() {
+  const cc::WorldSnapshot world_snapshot = world.GetSnapshot();
   for (auto &actor_info: unregistered_actors) {
 
     const ActorId actor_id = actor_info.first;
     const ActorPtr actor_ptr = actor_info.second;
     const std::string type_id = actor_ptr->GetTypeId();
 
-    const cg::Transform actor_transform = actor_ptr->GetTransform();
+    const auto snapshot = world_snapshot.Find(actor_id);
+    if (!snapshot.has_value()) {
+      // Not part of this frame yet, pick it up on the next update.
+      continue;
+    }
+    const cg::Transform actor_transform = snapshot->transform;
     const cg::Location actor_location = actor_transform.location;
     const cg::Rotation actor_rotation = actor_transform.rotation;
-    const cg::Vector3D actor_velocity = actor_ptr->GetVelocity();
+    const cg::Vector3D actor_velocity = snapshot->velocity;
     KinematicState kinematic_state {actor_location, actor_rotation, actor_velocity, -1.0f, true};
 
     TrafficLightState tl_state;
@@ -262,9 +341,10 @@ void ALSM::UpdateUnregisteredActorsData() {
     bool state_entry_not_present = !simulation_state.ContainsActor(actor_id);
     if (type_id.front() == 'v') {
       auto vehicle_ptr = boost::static_pointer_cast<cc::Vehicle>(actor_ptr);
-      kinematic_state.speed_limit = vehicle_ptr->GetSpeedLimit();
+      const auto &vehicle_data = snapshot->state.vehicle_data;
+      kinematic_state.speed_limit = vehicle_data.speed_limit;
 
-      tl_state = {vehicle_ptr->GetTrafficLightState(), vehicle_ptr->IsAtTrafficLight()};
+      tl_state = {vehicle_data.traffic_light_state, vehicle_data.has_traffic_light};
 
       if (state_entry_not_present) {
         dimensions = vehicle_ptr->GetBoundingBox().extent;
@@ -279,7 +359,7 @@ void ALSM::UpdateUnregisteredActorsData() {
 
       // Identify occupied waypoints.
       cg::Vector3D extent = vehicle_ptr->GetBoundingBox().extent;
-      cg::Vector3D heading_vector = vehicle_ptr->GetTransform().GetForwardVector();
+      cg::Vector3D heading_vector = actor_transform.GetForwardVector();
       std::vector<cg::Location> corners = {actor_location + cg::Location(extent.x * heading_vector),
                                            actor_location,
                                            actor_location + cg::Location(-extent.x * heading_vector)};
@@ -307,6 +387,7 @@ void ALSM::UpdateUnregisteredActorsData() {
     }
 
     track_traffic.UpdateUnregisteredGridPosition(actor_id, nearest_waypoints);
+    track_traffic.UpdatePosition(actor_id, actor_location);
   }
 }
 
@@ -361,6 +442,8 @@ void ALSM::Reset() {
   idle_time.clear();
   hero_actors.clear();
   elapsed_last_actor_destruction = 0.0;
+  actor_registry_version = 0u;
+  cycles_since_full_scan = FULL_ACTOR_SCAN_INTERVAL;
   current_timestamp = world.GetSnapshot().GetTimestamp();
 }
 
@@ -7,6 +7,7 @@
 #include "carla/client/Timestamp.h"
 #include "carla/client/World.h"
 #include "carla/Memory.h"
+#include "carla/rpc/ActorListDiff.h"
 
 #include "carla/trafficmanager/AtomicActorSet.h"
 #include "carla/trafficmanager/CollisionStage.h"
@@ -22,6 +23,7 @@
 namespace carla {
 namespace traffic_manager {
 
+using namespace constants::ActorLifecycle;
 using namespace constants::HybridMode;
 using namespace constants::VehicleRemoval;
 
@@ -61,6 +63,11 @@ private:
   MotionPlanStage &motion_plan_stage;
   // Time elapsed since last vehicle destruction due to being idle for too long.
   double elapsed_last_actor_destruction {0.0};
+  // Server-side actor registry version the tracked actor set is based on.
+  uint64_t actor_registry_version {0u};
+  // Update cycles since the last full actor list scan. Initialized past the
+  // scan interval so the first update performs a full scan.
+  uint64_t cycles_since_full_scan {FULL_ACTOR_SCAN_INTERVAL};
   cc::Timestamp current_timestamp;
   // Random devices.
   RandomGeneratorMap &random_devices;
@@ -80,6 +87,15 @@ private:
   // Arrays of registered and unregistered actors are returned separately.
   DestroyeddActors IdentifyDestroyedActors(const ActorList &actor_list);
 
+  // Method to rebuild actor tracking from a full scan of the actor list.
+  void FullActorScan(const bool hybrid_physics_mode);
+
+  // Method to apply a registry delta in place of a full actor list scan.
+  void ApplyActorRegistryDelta(const rpc::ActorListDiff &diff, const bool hybrid_physics_mode);
+
+  // Method to start tracking an actor not registered with the traffic manager.
+  void AddUnregisteredActor(const ActorPtr &actor, const bool hybrid_physics_mode);
+
   using IdleInfo = std::pair<ActorId, double>;
   void UpdateRegisteredActorsData(const bool hybrid_physics_mode, IdleInfo &max_idle_time);
 
@@ -102,6 +118,11 @@ public:
 
   void Update();
 
+  // Time-stamp of the snapshot taken by the last Update call.
+  cc::Timestamp GetCurrentTimestamp() const {
+    return current_timestamp;
+  }
+
   // Removes an actor from traffic manager and performs clean up of associated data
   // from various stages tracking the said vehicle.
   void RemoveActor(const ActorId actor_id, const bool registered_actor);
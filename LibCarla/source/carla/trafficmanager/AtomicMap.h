@@ -6,54 +6,16 @@
 
 #pragma once
 
-#include <mutex>
-#include <unordered_map>
+#include "carla/AtomicMap.h"
 
 namespace carla {
 namespace traffic_manager {
 
+  /// The traffic manager's per-actor parameter maps are looked up by every
+  /// vehicle on every stage; the sharded map keeps those lookups from
+  /// contending on a single mutex.
   template <typename Key, typename Value>
-  class AtomicMap {
-
-    private:
-
-    mutable std::mutex map_mutex;
-    std::unordered_map<Key, Value> map;
-
-    public:
-
-    AtomicMap() {}
-
-    void AddEntry(const std::pair<Key, Value> &entry) {
-
-      std::lock_guard<std::mutex> lock(map_mutex);
-      const Key& key = entry.first;
-      if (map.find(key) != map.end()) {
-        map.at(key) = entry.second;
-      } else {
-        map.insert(entry);
-      }
-    }
-
-    bool Contains(const Key &key) const {
-
-      std::lock_guard<std::mutex> lock(map_mutex);
-      return map.find(key) != map.end();
-    }
-
-    const Value &GetValue(const Key &key) const {
-
-      std::lock_guard<std::mutex> lock(map_mutex);
-      return map.at(key);
-    }
-
-    void RemoveEntry(const Key &key) {
-
-      std::lock_guard<std::mutex> lock(map_mutex);
-      map.erase(key);
-    }
-
-  };
+  using AtomicMap = carla::AtomicMap<Key, Value>;
 
 } // namespace traffic_manager
 } // namespace carla
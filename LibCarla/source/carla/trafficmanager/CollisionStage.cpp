@@ -44,12 +44,18 @@ void CollisionStage::Update(const unsigned long index) {
     const Buffer &ego_buffer = buffer_map.at(ego_actor_id);
     const unsigned long look_ahead_index = GetTargetWaypoint(ego_buffer, JUNCTION_LOOK_AHEAD).second;
 
-    ActorIdSet overlapping_actors = track_traffic.GetOverlappingVehicles(ego_actor_id);
-    std::vector<ActorId> collision_candidate_ids;
+    // Candidates come from the position hash; neighbouring cells bound the
+    // search to the collision radius instead of unioning every actor that
+    // shares a path grid with the ego vehicle.
+    TrackedActorSet overlapping_actors = track_traffic.GetNearbyActors(ego_location, MAX_COLLISION_RADIUS);
+    ArenaVector<ActorId> collision_candidate_ids;
 
-    // Run through vehicles with overlapping paths and filter them;
+    // Run through nearby actors and filter them;
     float collision_radius_square = SQUARE(MAX_COLLISION_RADIUS);
     for (ActorId overlapping_actor_id : overlapping_actors) {
+      if (!simulation_state.ContainsActor(overlapping_actor_id)) {
+        continue;
+      }
       // If actor is within maximum collision avoidance and vertical overlap range.
       const cg::Location &overlapping_actor_location = simulation_state.GetLocation(overlapping_actor_id);
       if (overlapping_actor_id != ego_actor_id
@@ -102,11 +108,15 @@ void CollisionStage::Update(const unsigned long index) {
 }
 
 void CollisionStage::RemoveActor(const ActorId actor_id) {
+  std::lock_guard<std::mutex> guard(cache_mutex);
   collision_locks.erase(actor_id);
+  persistent_boundary_map.erase(actor_id);
 }
 
 void CollisionStage::Reset() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
   collision_locks.clear();
+  persistent_boundary_map.clear();
 }
 
 float CollisionStage::GetBoundingBoxExtention(const ActorId actor_id) {
@@ -116,8 +126,17 @@ float CollisionStage::GetBoundingBoxExtention(const ActorId actor_id) {
   // Using a linear function to calculate boundary length.
   bbox_extension = BOUNDARY_EXTENSION_RATE * velocity + BOUNDARY_EXTENSION_MINIMUM;
   // If a valid collision lock present, change boundary length to maintain lock.
-  if (collision_locks.find(actor_id) != collision_locks.end()) {
-    const CollisionLock &lock = collision_locks.at(actor_id);
+  bool lock_present = false;
+  CollisionLock lock;
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    auto lock_entry = collision_locks.find(actor_id);
+    if (lock_entry != collision_locks.end()) {
+      lock_present = true;
+      lock = lock_entry->second;
+    }
+  }
+  if (lock_present) {
     float lock_boundary_length = static_cast<float>(lock.distance_to_lead_vehicle + LOCKING_DISTANCE_PADDING);
     // Only extend boundary track vehicle if the leading vehicle
     // if it is not further than velocity dependent extension by MAX_LOCKING_EXTENSION.
@@ -163,9 +182,18 @@ LocationVector CollisionStage::GetBoundary(const ActorId actor_id) {
 LocationVector CollisionStage::GetGeodesicBoundary(const ActorId actor_id) {
   LocationVector geodesic_boundary;
 
-  if (geodesic_boundary_map.find(actor_id) != geodesic_boundary_map.end()) {
-    geodesic_boundary = geodesic_boundary_map.at(actor_id);
-  } else {
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    auto cache_entry = geodesic_boundary_map.find(actor_id);
+    if (cache_entry != geodesic_boundary_map.end()) {
+      // Element-wise copy so the result is backed by this shard's arena, not
+      // by the arena of the shard that computed the boundary.
+      geodesic_boundary.assign(cache_entry->second.begin(), cache_entry->second.end());
+      cached = true;
+    }
+  }
+  if (!cached) {
     const LocationVector bbox = GetBoundary(actor_id);
 
     if (buffer_map.find(actor_id) != buffer_map.end()) {
@@ -174,59 +202,93 @@ LocationVector CollisionStage::GetGeodesicBoundary(const ActorId actor_id) {
       bbox_extension = std::max(specific_lead_distance, bbox_extension);
       const float bbox_extension_square = SQUARE(bbox_extension);
 
-      LocationVector left_boundary;
-      LocationVector right_boundary;
-      cg::Vector3D dimensions = simulation_state.GetDimensions(actor_id);
-      const float width = dimensions.y;
-      const float length = dimensions.x;
-
       const Buffer &waypoint_buffer = buffer_map.at(actor_id);
-      const TargetWPInfo target_wp_info = GetTargetWaypoint(waypoint_buffer, length);
-      const SimpleWaypointPtr boundary_start = target_wp_info.first;
-      const uint64_t boundary_start_index = target_wp_info.second;
-
-      // At non-signalized junctions, we extend the boundary across the junction
-      // and in all other situations, boundary length is velocity-dependent.
-      SimpleWaypointPtr boundary_end = nullptr;
-      SimpleWaypointPtr current_point = waypoint_buffer.at(boundary_start_index);
-      bool reached_distance = false;
-      for (uint64_t j = boundary_start_index; !reached_distance && (j < waypoint_buffer.size()); ++j) {
-        if (boundary_start->DistanceSquared(current_point) > bbox_extension_square || j == waypoint_buffer.size() - 1) {
-          reached_distance = true;
+      const cg::Location vehicle_location = simulation_state.GetLocation(actor_id);
+
+      // Reuse the boundary built in a previous cycle while the waypoint
+      // buffer has not advanced and the vehicle has barely moved, the common
+      // case for vehicles queued in dense traffic.
+      bool reused = false;
+      {
+        std::lock_guard<std::mutex> guard(cache_mutex);
+        auto previous_entry = persistent_boundary_map.find(actor_id);
+        if (previous_entry != persistent_boundary_map.end()) {
+          const CachedGeodesicBoundary &previous = previous_entry->second;
+          if (previous.front_waypoint_id == waypoint_buffer.front()->GetId()
+              && previous.back_waypoint_id == waypoint_buffer.back()->GetId()
+              && cg::Math::DistanceSquared(previous.location, vehicle_location) < SQUARE(BOUNDARY_CACHE_DISTANCE_THRESHOLD)
+              && std::abs(previous.bbox_extension - bbox_extension) < BOUNDARY_CACHE_EXTENSION_THRESHOLD) {
+            geodesic_boundary.assign(previous.boundary.begin(), previous.boundary.end());
+            reused = true;
+          }
         }
-        if (boundary_end == nullptr
-            || cg::Math::Dot(boundary_end->GetForwardVector(), current_point->GetForwardVector()) < COS_10_DEGREES
-            || reached_distance) {
-
-          const cg::Vector3D heading_vector = current_point->GetForwardVector();
-          const cg::Location location = current_point->GetLocation();
-          cg::Vector3D perpendicular_vector = cg::Vector3D(-heading_vector.y, heading_vector.x, 0.0f);
-          perpendicular_vector = perpendicular_vector.MakeSafeUnitVector(EPSILON);
-          // Direction determined for the left-handed system.
-          const cg::Vector3D scaled_perpendicular = perpendicular_vector * width;
-          left_boundary.push_back(location + cg::Location(scaled_perpendicular));
-          right_boundary.push_back(location + cg::Location(-1.0f * scaled_perpendicular));
-
-          boundary_end = current_point;
+      }
+
+      if (!reused) {
+        LocationVector left_boundary;
+        LocationVector right_boundary;
+        cg::Vector3D dimensions = simulation_state.GetDimensions(actor_id);
+        const float width = dimensions.y;
+        const float length = dimensions.x;
+
+        const TargetWPInfo target_wp_info = GetTargetWaypoint(waypoint_buffer, length);
+        const SimpleWaypointPtr boundary_start = target_wp_info.first;
+        const uint64_t boundary_start_index = target_wp_info.second;
+
+        // At non-signalized junctions, we extend the boundary across the junction
+        // and in all other situations, boundary length is velocity-dependent.
+        SimpleWaypointPtr boundary_end = nullptr;
+        SimpleWaypointPtr current_point = waypoint_buffer.at(boundary_start_index);
+        bool reached_distance = false;
+        for (uint64_t j = boundary_start_index; !reached_distance && (j < waypoint_buffer.size()); ++j) {
+          if (boundary_start->DistanceSquared(current_point) > bbox_extension_square || j == waypoint_buffer.size() - 1) {
+            reached_distance = true;
+          }
+          if (boundary_end == nullptr
+              || cg::Math::Dot(boundary_end->GetForwardVector(), current_point->GetForwardVector()) < COS_10_DEGREES
+              || reached_distance) {
+
+            const cg::Vector3D heading_vector = current_point->GetForwardVector();
+            const cg::Location location = current_point->GetLocation();
+            cg::Vector3D perpendicular_vector = cg::Vector3D(-heading_vector.y, heading_vector.x, 0.0f);
+            perpendicular_vector = perpendicular_vector.MakeSafeUnitVector(EPSILON);
+            // Direction determined for the left-handed system.
+            const cg::Vector3D scaled_perpendicular = perpendicular_vector * width;
+            left_boundary.push_back(location + cg::Location(scaled_perpendicular));
+            right_boundary.push_back(location + cg::Location(-1.0f * scaled_perpendicular));
+
+            boundary_end = current_point;
+          }
+
+          current_point = waypoint_buffer.at(j);
         }
 
-        current_point = waypoint_buffer.at(j);
+        // Reversing right boundary to construct clockwise (left-hand system)
+        // boundary. This is so because both left and right boundary vectors have
+        // the closest point to the vehicle at their starting index for the right
+        // boundary,
+        // we want to begin at the farthest point to have a clockwise trace.
+        std::reverse(right_boundary.begin(), right_boundary.end());
+        geodesic_boundary.insert(geodesic_boundary.end(), right_boundary.begin(), right_boundary.end());
+        geodesic_boundary.insert(geodesic_boundary.end(), bbox.begin(), bbox.end());
+        geodesic_boundary.insert(geodesic_boundary.end(), left_boundary.begin(), left_boundary.end());
+
+        CachedGeodesicBoundary new_entry;
+        new_entry.front_waypoint_id = waypoint_buffer.front()->GetId();
+        new_entry.back_waypoint_id = waypoint_buffer.back()->GetId();
+        new_entry.location = vehicle_location;
+        new_entry.bbox_extension = bbox_extension;
+        new_entry.boundary.assign(geodesic_boundary.begin(), geodesic_boundary.end());
+
+        std::lock_guard<std::mutex> guard(cache_mutex);
+        persistent_boundary_map[actor_id] = std::move(new_entry);
       }
-
-      // Reversing right boundary to construct clockwise (left-hand system)
-      // boundary. This is so because both left and right boundary vectors have
-      // the closest point to the vehicle at their starting index for the right
-      // boundary,
-      // we want to begin at the farthest point to have a clockwise trace.
-      std::reverse(right_boundary.begin(), right_boundary.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), right_boundary.begin(), right_boundary.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), bbox.begin(), bbox.end());
-      geodesic_boundary.insert(geodesic_boundary.end(), left_boundary.begin(), left_boundary.end());
     } else {
 
       geodesic_boundary = bbox;
     }
 
+    std::lock_guard<std::mutex> guard(cache_mutex);
     geodesic_boundary_map.insert({actor_id, geodesic_boundary});
   }
 
@@ -262,9 +324,17 @@ GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId refere
 
   GeometryComparison comparision_result{-1.0, -1.0, -1.0, -1.0};
 
-  if (geometry_cache.find(actor_id_key) != geometry_cache.end()) {
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> guard(cache_mutex);
+    auto cache_entry = geometry_cache.find(actor_id_key);
+    if (cache_entry != geometry_cache.end()) {
+      comparision_result = cache_entry->second;
+      cached = true;
+    }
+  }
+  if (cached) {
 
-    comparision_result = geometry_cache.at(actor_id_key);
     double mref_veh_other = comparision_result.reference_vehicle_to_other_geodesic;
     comparision_result.reference_vehicle_to_other_geodesic = comparision_result.other_vehicle_to_reference_geodesic;
     comparision_result.other_vehicle_to_reference_geodesic = mref_veh_other;
@@ -287,6 +357,7 @@ GeometryComparison CollisionStage::GetGeometryBetweenActors(const ActorId refere
               inter_geodesic_distance,
               inter_bbox_distance};
 
+    std::lock_guard<std::mutex> guard(cache_mutex);
     geometry_cache.insert({actor_id_key, comparision_result});
   }
 
@@ -376,6 +447,7 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
       // This enables us to smoothly approach the lead vehicle.
 
       // When possible collision found, check if an entry for collision lock present.
+      std::lock_guard<std::mutex> guard(cache_mutex);
       if (collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
         CollisionLock &lock = collision_locks.at(reference_vehicle_id);
         // Check if the same vehicle is under lock.
@@ -403,7 +475,8 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
   }
 
   // If no collision hazard detected, then flush collision lock held by the vehicle.
-  if (!hazard && collision_locks.find(reference_vehicle_id) != collision_locks.end()) {
+  if (!hazard) {
+    std::lock_guard<std::mutex> guard(cache_mutex);
     collision_locks.erase(reference_vehicle_id);
   }
 
@@ -411,6 +484,7 @@ std::pair<bool, float> CollisionStage::NegotiateCollision(const ActorId referenc
 }
 
 void CollisionStage::ClearCycleCache() {
+  std::lock_guard<std::mutex> guard(cache_mutex);
   geodesic_boundary_map.clear();
   geometry_cache.clear();
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "boost/geometry.hpp"
 #include "boost/geometry/geometries/geometries.hpp"
@@ -38,9 +39,25 @@ namespace bg = boost::geometry;
 
 using Buffer = std::deque<std::shared_ptr<SimpleWaypoint>>;
 using BufferMap = std::unordered_map<carla::ActorId, Buffer>;
-using LocationVector = std::vector<cg::Location>;
+// Boundaries are rebuilt per vehicle per cycle; arena-backed so they cost a
+// pointer bump instead of a malloc. The cache holding them is cleared every
+// cycle in ClearCycleCache, before the arena is rewound.
+using LocationVector = ArenaVector<cg::Location>;
 using GeodesicBoundaryMap = std::unordered_map<ActorId, LocationVector>;
 using GeometryComparisonMap = std::unordered_map<uint64_t, GeometryComparison>;
+
+/// Geodesic boundary kept across cycles. It stays valid while the vehicle's
+/// waypoint buffer has not advanced and the vehicle has barely moved, the
+/// common case for vehicles queued in dense traffic. Heap-backed on purpose:
+/// the arenas are rewound every cycle.
+struct CachedGeodesicBoundary {
+  uint64_t front_waypoint_id = 0u;
+  uint64_t back_waypoint_id = 0u;
+  cg::Location location;
+  float bbox_extension = -1.0f;
+  std::vector<cg::Location> boundary;
+};
+using CachedBoundaryMap = std::unordered_map<ActorId, CachedGeodesicBoundary>;
 using Polygon = bg::model::polygon<bg::model::d2::point_xy<double>>;
 
 /// This class has functionality to detect potential collision with a nearby actor.
@@ -60,6 +77,13 @@ private:
   // to avoid repeated computation within a cycle.
   GeometryComparisonMap geometry_cache;
   GeodesicBoundaryMap geodesic_boundary_map;
+  // Boundaries carried over from previous cycles, reused while still valid.
+  CachedBoundaryMap persistent_boundary_map;
+  // Guards the caches and the lock table; vehicle shards of this stage run
+  // concurrently and read each other's entries. Geometry is always computed
+  // outside the lock, so two shards may duplicate work for a pair, but the
+  // lock is never held across the expensive polygon math.
+  std::mutex cache_mutex;
   RandomGeneratorMap &random_devices;
 
   // Method to determine if a vehicle is on a collision path to another.
@@ -102,6 +126,8 @@ public:
 
   void Reset() override;
 
+  using Stage::SetTickArena;
+
   // Method to flush cache for current update cycle.
   void ClearCycleCache();
 };
@@ -21,6 +21,11 @@ static const unsigned short TM_DEFAULT_PORT = 8000u;
 static const int64_t TM_TIMEOUT = 2000; // ms
 } // namespace Networking
 
+namespace ActorLifecycle {
+// Number of delta update cycles between full actor list scans.
+static const uint64_t FULL_ACTOR_SCAN_INTERVAL = 20u;
+} // namespace ActorLifecycle
+
 namespace VehicleRemoval {
 static const float STOPPED_VELOCITY_THRESHOLD = 0.8f;
 static const double BLOCKED_TIME_THRESHOLD = 90.0;
@@ -75,6 +80,8 @@ static const float COS_10_DEGREES = 0.9848f;
 static const float EPSILON_VELOCITY = 0.1f;
 static const float LOCKING_DISTANCE_PADDING = 4.0f;
 static const float MAX_COLLISION_RADIUS = 100.0f;
+static const float BOUNDARY_CACHE_DISTANCE_THRESHOLD = 0.1f;
+static const float BOUNDARY_CACHE_EXTENSION_THRESHOLD = 0.1f;
 static const float MAX_LOCKING_EXTENSION = 10.0f;
 static const float WALKER_TIME_EXTENSION = 1.5f;
 static const float SQUARE_ROOT_OF_TWO = 1.414f;
@@ -88,6 +95,14 @@ static const uint64_t GROWTH_STEP_SIZE = 50u;
 static const float INV_GROWTH_STEP_SIZE = 1.0f / static_cast<float>(GROWTH_STEP_SIZE);
 } // namespace FrameMemory
 
+namespace ParallelStage {
+static const unsigned long MIN_VEHICLES_PER_SHARD = 25u;
+} // namespace ParallelStage
+
+namespace Telemetry {
+static const uint64_t TELEMETRY_WINDOW_SIZE = 256u;
+} // namespace Telemetry
+
 namespace Map {
 static const float INFINITE_DISTANCE = std::numeric_limits<float>::max();
 static const float GRID_SIZE = 4.0f;
@@ -95,6 +110,11 @@ static const float PED_GRID_SIZE = 10.0f;
 static const float MAX_GEODESIC_GRID_LENGTH = 20.0f;
 static const double MAP_RESOLUTION = 0.1;
 static const float INV_MAP_RESOLUTION = 10.0f;
+// Sampling of the always-resident coarse region index; dense waypoints are
+// materialized per region at MAP_RESOLUTION on first use.
+static const double COARSE_MAP_RESOLUTION = 5.0;
+static const float MATERIALIZATION_CELL_SIZE = 100.0f;
+static const float INV_MATERIALIZATION_CELL_SIZE = 1.0f / MATERIALIZATION_CELL_SIZE;
 } // namespace Map
 
 namespace TrafficLight {
@@ -126,6 +146,8 @@ static const float INV_DT = 1.0f / DT;
 namespace TrackTraffic {
 static const uint64_t BUFFER_STEP_THROUGH = 10;
 static const float INV_BUFFER_STEP_THROUGH = 0.1f;
+static const float POSITION_GRID_CELL_SIZE = 50.0f;
+static const float INV_POSITION_GRID_CELL_SIZE = 1.0f / POSITION_GRID_CELL_SIZE;
 } // namespace TrackTraffic
 
 } // namespace constants
@@ -0,0 +1,310 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace carla {
+namespace traffic_manager {
+
+/// Sorted set of trivially copyable ids kept in a contiguous buffer, with
+/// the first @a InlineCapacity entries stored inline. Most of the traffic
+/// manager's occupancy sets hold fewer than four ids, so the common case
+/// never touches the heap and membership tests are a short linear scan over
+/// one cache line. Iteration is in ascending order, so two sets can be fed
+/// directly to the sorted-range algorithms.
+template <typename T, std::size_t InlineCapacity = 4u>
+class SmallIdSet {
+public:
+
+  using value_type = T;
+  using iterator = const T *;
+  using const_iterator = const T *;
+
+  /// Insert @a value keeping the buffer sorted; returns false if it was
+  /// already present.
+  bool insert(const T &value) {
+    T *first = data();
+    T *last = first + _size;
+    T *position = std::lower_bound(first, last, value);
+    if ((position != last) && (*position == value)) {
+      return false;
+    }
+    const std::size_t offset = static_cast<std::size_t>(position - first);
+    if (!_spilled && (_size == InlineCapacity)) {
+      Spill();
+    }
+    if (_spilled) {
+      _heap.insert(_heap.begin() + static_cast<std::ptrdiff_t>(offset), value);
+    } else {
+      std::copy_backward(
+          _inline.begin() + static_cast<std::ptrdiff_t>(offset),
+          _inline.begin() + static_cast<std::ptrdiff_t>(_size),
+          _inline.begin() + static_cast<std::ptrdiff_t>(_size + 1u));
+      _inline[offset] = value;
+    }
+    ++_size;
+    return true;
+  }
+
+  /// Hint-taking overload so the set works with std::inserter; the hint is
+  /// ignored, the sorted position is found as in insert(value).
+  iterator insert(const_iterator, const T &value) {
+    insert(value);
+    return begin();
+  }
+
+  /// Remove @a value; returns false if it was not present.
+  bool erase(const T &value) {
+    T *first = data();
+    T *last = first + _size;
+    T *position = std::lower_bound(first, last, value);
+    if ((position == last) || (*position != value)) {
+      return false;
+    }
+    std::copy(position + 1, last, position);
+    --_size;
+    return true;
+  }
+
+  bool contains(const T &value) const {
+    const T *first = data();
+    const T *last = first + _size;
+    const T *position = std::lower_bound(first, last, value);
+    return (position != last) && (*position == value);
+  }
+
+  const_iterator find(const T &value) const {
+    const T *first = data();
+    const T *last = first + _size;
+    const T *position = std::lower_bound(first, last, value);
+    return ((position != last) && (*position == value)) ? position : last;
+  }
+
+  /// Drop every id keeping the heap buffer's capacity, if any.
+  void clear() {
+    _heap.clear();
+    _size = 0u;
+    _spilled = false;
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0u;
+  }
+
+  const_iterator begin() const {
+    return data();
+  }
+
+  const_iterator end() const {
+    return data() + _size;
+  }
+
+private:
+
+  void Spill() {
+    _heap.reserve(2u * InlineCapacity);
+    _heap.assign(_inline.begin(), _inline.begin() + static_cast<std::ptrdiff_t>(_size));
+    _spilled = true;
+  }
+
+  T *data() {
+    return _spilled ? _heap.data() : _inline.data();
+  }
+
+  const T *data() const {
+    return _spilled ? _heap.data() : _inline.data();
+  }
+
+  std::array<T, InlineCapacity> _inline;
+
+  std::vector<T> _heap;
+
+  std::size_t _size = 0u;
+
+  bool _spilled = false;
+};
+
+/// Open-addressing hash map over a single flat slot array, probing
+/// linearly. Built for the traffic manager's per-cycle tracking tables:
+/// lookups touch consecutive slots instead of chasing list nodes, erasing
+/// marks a tombstone without freeing anything, and Clear() retires every
+/// entry by bumping a generation stamp instead of walking the table.
+///
+/// Values of retired entries stay constructed inside their slots and are
+/// reset in place when the slot is reused, so a value type with internal
+/// capacity (e.g. SmallIdSet) keeps its buffers across generations.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+
+  FlatHashMap() : _slots(INITIAL_CAPACITY) {}
+
+  /// Reference to the value mapped to @a key, default-constructing it if
+  /// the key is absent.
+  Value &operator[](const Key &key) {
+    MaybeGrow();
+    const std::size_t mask = _slots.size() - 1u;
+    std::size_t index = Hash()(key) & mask;
+    std::size_t insertion_index = _slots.size();
+    while (true) {
+      Slot &slot = _slots[index];
+      if (slot.stamp == OccupiedStamp()) {
+        if (slot.key == key) {
+          return slot.value;
+        }
+      } else if (slot.stamp == TombstoneStamp()) {
+        if (insertion_index == _slots.size()) {
+          insertion_index = index;
+        }
+      } else {
+        // Free slot, the key is not in the table.
+        if (insertion_index == _slots.size()) {
+          insertion_index = index;
+        }
+        break;
+      }
+      index = (index + 1u) & mask;
+    }
+    Slot &slot = _slots[insertion_index];
+    if (slot.stamp == TombstoneStamp()) {
+      --_tombstones;
+    }
+    slot.key = key;
+    slot.value.clear();
+    slot.stamp = OccupiedStamp();
+    ++_occupied;
+    return slot.value;
+  }
+
+  Value *Find(const Key &key) {
+    Slot *slot = FindSlot(key);
+    return (slot != nullptr) ? &slot->value : nullptr;
+  }
+
+  const Value *Find(const Key &key) const {
+    const Slot *slot = const_cast<FlatHashMap *>(this)->FindSlot(key);
+    return (slot != nullptr) ? &slot->value : nullptr;
+  }
+
+  /// Remove @a key leaving a tombstone; returns false if it was absent.
+  bool Erase(const Key &key) {
+    Slot *slot = FindSlot(key);
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->stamp = TombstoneStamp();
+    --_occupied;
+    ++_tombstones;
+    return true;
+  }
+
+  /// Retire every entry in constant time by moving to the next generation;
+  /// slot values are reset lazily as their slots get reused.
+  void Clear() {
+    ++_generation;
+    _occupied = 0u;
+    _tombstones = 0u;
+  }
+
+  std::size_t size() const {
+    return _occupied;
+  }
+
+  bool empty() const {
+    return _occupied == 0u;
+  }
+
+private:
+
+  static constexpr std::size_t INITIAL_CAPACITY = 64u;
+
+  struct Slot {
+    Key key;
+    Value value;
+    // Stamps encode the slot state relative to the map's generation:
+    // occupied at 2 * generation, tombstone at 2 * generation + 1, and
+    // everything else (including slots stamped in older generations)
+    // reads as free.
+    uint64_t stamp = 0u;
+  };
+
+  uint64_t OccupiedStamp() const {
+    return 2u * _generation;
+  }
+
+  uint64_t TombstoneStamp() const {
+    return 2u * _generation + 1u;
+  }
+
+  Slot *FindSlot(const Key &key) {
+    const std::size_t mask = _slots.size() - 1u;
+    std::size_t index = Hash()(key) & mask;
+    while (true) {
+      Slot &slot = _slots[index];
+      if (slot.stamp == OccupiedStamp()) {
+        if (slot.key == key) {
+          return &slot;
+        }
+      } else if (slot.stamp != TombstoneStamp()) {
+        return nullptr;
+      }
+      index = (index + 1u) & mask;
+    }
+  }
+
+  void MaybeGrow() {
+    // Grow on live entries, rehash in place when tombstones alone push the
+    // load over the threshold; either way probe chains stay short.
+    if (2u * (_occupied + _tombstones + 1u) < _slots.size()) {
+      return;
+    }
+    const std::size_t new_capacity =
+        (2u * (_occupied + 1u) * 2u < _slots.size()) ? _slots.size() : 2u * _slots.size();
+    std::vector<Slot> old_slots(new_capacity);
+    old_slots.swap(_slots);
+    const uint64_t old_occupied_stamp = OccupiedStamp();
+    _generation = 1u;
+    _occupied = 0u;
+    _tombstones = 0u;
+    const std::size_t mask = _slots.size() - 1u;
+    for (Slot &old_slot : old_slots) {
+      if (old_slot.stamp != old_occupied_stamp) {
+        continue;
+      }
+      std::size_t index = Hash()(old_slot.key) & mask;
+      while (_slots[index].stamp == OccupiedStamp()) {
+        index = (index + 1u) & mask;
+      }
+      Slot &slot = _slots[index];
+      slot.key = old_slot.key;
+      slot.value = std::move(old_slot.value);
+      slot.stamp = OccupiedStamp();
+      ++_occupied;
+    }
+  }
+
+  std::vector<Slot> _slots;
+
+  uint64_t _generation = 1u;
+
+  std::size_t _occupied = 0u;
+
+  std::size_t _tombstones = 0u;
+};
+
+} // namespace traffic_manager
+} // namespace carla
@@ -15,53 +15,42 @@ namespace traffic_manager {
   using namespace constants::Map;
 
   using TopologyList = std::vector<std::pair<WaypointPtr, WaypointPtr>>;
-  using RawNodeList = std::vector<WaypointPtr>;
+  using Box2D = bg::model::box<Point3D>;
 
   InMemoryMap::InMemoryMap(WorldMap world_map) : _world_map(world_map) {}
   InMemoryMap::~InMemoryMap() {}
 
-  SegmentId InMemoryMap::GetSegmentId(const WaypointPtr &wp) const {
-    return std::make_tuple(wp->GetRoadId(), wp->GetLaneId(), wp->GetSectionId());
-  }
+  std::shared_ptr<InMemoryMap> InMemoryMap::GetOrCreate(WorldMap world_map) {
 
-  SegmentId InMemoryMap::GetSegmentId(const SimpleWaypointPtr &swp) const {
-    return GetSegmentId(swp->GetWaypoint());
-  }
+    static std::mutex cache_mutex;
+    static std::unordered_map<std::string, std::weak_ptr<InMemoryMap>> cache;
 
-  std::vector<SimpleWaypointPtr> InMemoryMap::GetSuccessors(const SegmentId segment_id,
-  const SegmentTopology &segment_topology, const SegmentMap &segment_map) {
-    std::vector<SimpleWaypointPtr> result;
-    if (segment_topology.find(segment_id) == segment_topology.end()) {
-      return result;
-    }
+    // Keyed on name plus content hash so a reloaded town with an edited
+    // OpenDRIVE definition does not reuse a stale graph.
+    const std::string map_key = world_map->GetName() + "/"
+        + std::to_string(std::hash<std::string>()(world_map->GetOpenDrive()));
 
-    for (const auto &successor_segment_id : segment_topology.at(segment_id).second) {
-      if (segment_map.find(successor_segment_id) == segment_map.end()) {
-        auto successors = GetSuccessors(successor_segment_id, segment_topology, segment_map);
-        result.insert(result.end(), successors.begin(), successors.end());
-      } else {
-        result.emplace_back(segment_map.at(successor_segment_id).front());
-      }
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::shared_ptr<InMemoryMap> local_map = cache[map_key].lock();
+    if (local_map == nullptr) {
+      local_map = std::make_shared<InMemoryMap>(world_map);
+      local_map->SetUp();
+      cache[map_key] = local_map;
     }
-    return result;
+    return local_map;
   }
 
-  std::vector<SimpleWaypointPtr> InMemoryMap::GetPredecessors(const SegmentId segment_id,
-  const SegmentTopology &segment_topology, const SegmentMap &segment_map) {
-    std::vector<SimpleWaypointPtr> result;
-    if (segment_topology.find(segment_id) == segment_topology.end()) {
-      return result;
-    }
+  static uint64_t MaterializationCellKey(const int32_t cell_x, const int32_t cell_y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cell_x)) << 32)
+           | static_cast<uint64_t>(static_cast<uint32_t>(cell_y));
+  }
 
-    for (const auto &predecessor_segment_id : segment_topology.at(segment_id).first) {
-      if (segment_map.find(predecessor_segment_id) == segment_map.end()) {
-        auto predecessors = GetPredecessors(predecessor_segment_id, segment_topology, segment_map);
-        result.insert(result.end(), predecessors.begin(), predecessors.end());
-      } else {
-        result.emplace_back(segment_map.at(predecessor_segment_id).back());
-      }
-    }
-    return result;
+  SegmentId InMemoryMap::GetSegmentId(const WaypointPtr &wp) const {
+    return std::make_tuple(wp->GetRoadId(), wp->GetLaneId(), wp->GetSectionId());
+  }
+
+  SegmentId InMemoryMap::GetSegmentId(const SimpleWaypointPtr &swp) const {
+    return GetSegmentId(swp->GetWaypoint());
   }
 
   void InMemoryMap::SetUp() {
@@ -70,9 +59,7 @@ namespace traffic_manager {
     assert(_world_map != nullptr && "No map reference found.");
     auto waypoint_topology = _world_map->GetTopology();
 
-    SegmentTopology segment_topology;
     std::unordered_map<int64_t, std::pair<std::set<crd::RoadId>, std::set<crd::RoadId>>> std_road_connectivity;
-    std::unordered_map<crd::RoadId, bool> is_real_junction;
 
     for (auto &connection : waypoint_topology) {
       auto &waypoint = connection.first;
@@ -87,6 +74,15 @@ namespace traffic_manager {
       connection_first.second.push_back(successor_segment_id);
       connection_second.first.push_back(waypoint_segment_id);
 
+      // The topology pairs are taken at segment entries; remember one entry
+      // waypoint per segment as the seed for dense sampling.
+      if (segment_entry.find(waypoint_segment_id) == segment_entry.end()) {
+        segment_entry.insert({waypoint_segment_id, waypoint});
+      }
+      if (segment_entry.find(successor_segment_id) == segment_entry.end()) {
+        segment_entry.insert({successor_segment_id, successor});
+      }
+
       // From path to standard road.
       bool waypoint_is_junction = waypoint->IsJunction();
       bool successor_is_junction = successor->IsJunction();
@@ -122,100 +118,178 @@ namespace traffic_manager {
       }
     }
 
-    // 2. Consuming the raw dense topology from cc::Map into SimpleWaypoints.
-    SegmentMap segment_map;
-    assert(_world_map != nullptr && "No map reference found.");
-    auto raw_dense_topology = _world_map->GenerateWaypoints(MAP_RESOLUTION);
-    for (auto &waypoint_ptr: raw_dense_topology) {
-      segment_map[GetSegmentId(waypoint_ptr)].emplace_back(std::make_shared<SimpleWaypoint>(waypoint_ptr));
+    // 2. Sampling every segment at coarse resolution to build the region
+    // index. Dense sampling at MAP_RESOLUTION is deferred until a region is
+    // first used.
+    for (auto &entry : segment_entry) {
+      const SegmentId segment_id = entry.first;
+      WaypointPtr current_waypoint = entry.second;
+      while (current_waypoint != nullptr) {
+        const cg::Location loc = current_waypoint->GetTransform().location;
+        coarse_rtree.insert(std::make_pair(Point3D(loc.x, loc.y, loc.z), segment_id));
+
+        WaypointPtr next_in_segment = nullptr;
+        for (auto &next_waypoint : current_waypoint->GetNext(COARSE_MAP_RESOLUTION)) {
+          if (GetSegmentId(next_waypoint) == segment_id) {
+            next_in_segment = next_waypoint;
+            break;
+          }
+        }
+        current_waypoint = next_in_segment;
+      }
     }
+  }
 
-    // 3. Processing waypoints.
-    auto distance_squared =
-    [](cg::Location l1, cg::Location l2) {
-      return cg::Math::DistanceSquared(l1, l2);
-    };
-    auto square = [](float input) {return std::pow(input, 2);};
-    auto compare_s = [](const SimpleWaypointPtr &swp1, const SimpleWaypointPtr &swp2) {
-      return (swp1->GetWaypoint()->GetDistance() < swp2->GetWaypoint()->GetDistance());
-    };
-
-    GeoGridId geodesic_grid_id_counter = -1;
-    for (auto &segment: segment_map) {
-      auto &segment_waypoints = segment.second;
-
-      // Generating geodesic grid ids.
-      ++geodesic_grid_id_counter;
-
-      // Ordering waypoints according to road direction.
-      std::sort(segment_waypoints.begin(), segment_waypoints.end(), compare_s);
-      auto lane_id = segment_waypoints.front()->GetWaypoint()->GetLaneId();
-      if (lane_id > 0) {
-        std::reverse(segment_waypoints.begin(), segment_waypoints.end());
-      }
+  void InMemoryMap::EnsureAreaMaterialized(const cg::Location loc) {
 
-      // Placing intra-segment connections.
-      cg::Location grid_edge_location = segment_waypoints.front()->GetLocation();
-      for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
+    const int32_t cell_x = static_cast<int32_t>(std::floor(loc.x * INV_MATERIALIZATION_CELL_SIZE));
+    const int32_t cell_y = static_cast<int32_t>(std::floor(loc.y * INV_MATERIALIZATION_CELL_SIZE));
 
-        // Assigning grid id.
-        if (distance_squared(grid_edge_location, segment_waypoints.at(i)->GetLocation()) >
-        square(MAX_GEODESIC_GRID_LENGTH)) {
-          ++geodesic_grid_id_counter;
-          grid_edge_location = segment_waypoints.at(i)->GetLocation();
+    // Materializing one ring of cells around the query keeps at least one
+    // cell length of dense waypoints ahead of the waypoint buffers extended
+    // from this location.
+    std::set<SegmentId> segments_to_materialize;
+    for (int32_t dx = -1; dx <= 1; ++dx) {
+      for (int32_t dy = -1; dy <= 1; ++dy) {
+        const uint64_t cell_key = MaterializationCellKey(cell_x + dx, cell_y + dy);
+        if (materialized_cells.find(cell_key) != materialized_cells.end()) {
+          continue;
         }
-        segment_waypoints.at(i)->SetGeodesicGridId(geodesic_grid_id_counter);
-
-        segment_waypoints.at(i)->SetNextWaypoint({segment_waypoints.at(i + 1)});
-        segment_waypoints.at(i + 1)->SetPreviousWaypoint({segment_waypoints.at(i)});
-      }
-      segment_waypoints.back()->SetGeodesicGridId(geodesic_grid_id_counter);
-
-      // Adding simple waypoints to processed dense topology.
-      for (auto swp: segment_waypoints) {
-        // Checking whether the waypoint is a real junction.
-        auto road_id = swp->GetWaypoint()->GetRoadId();
-        if (swp->GetWaypoint()->IsJunction() && !is_real_junction.count(road_id)) {
-          swp->SetIsJunction(false);
-        } else {
-          swp->SetIsJunction(swp->GetWaypoint()->IsJunction());
+        materialized_cells.insert(cell_key);
+
+        const float min_x = static_cast<float>(cell_x + dx) * MATERIALIZATION_CELL_SIZE;
+        const float min_y = static_cast<float>(cell_y + dy) * MATERIALIZATION_CELL_SIZE;
+        const Box2D cell_box(Point3D(min_x, min_y, std::numeric_limits<float>::lowest()),
+                             Point3D(min_x + MATERIALIZATION_CELL_SIZE,
+                                     min_y + MATERIALIZATION_CELL_SIZE,
+                                     std::numeric_limits<float>::max()));
+        std::vector<CoarseTreeEntry> cell_samples;
+        coarse_rtree.query(bgi::intersects(cell_box), std::back_inserter(cell_samples));
+        for (const CoarseTreeEntry &sample : cell_samples) {
+          if (segment_map.find(sample.second) == segment_map.end()) {
+            segments_to_materialize.insert(sample.second);
+          }
         }
-
-        dense_topology.push_back(swp);
       }
     }
 
-    // Localizing waypoints into grids.
-    for (auto &simple_waypoint: dense_topology) {
-      if (simple_waypoint != nullptr) {
-        const cg::Location loc = simple_waypoint->GetLocation();
-        Point3D point(loc.x, loc.y, loc.z);
-        rtree.insert(std::make_pair(point, simple_waypoint));
+    std::vector<SegmentId> new_segments;
+    for (const SegmentId &segment_id : segments_to_materialize) {
+      if (MaterializeSegment(segment_id)) {
+        new_segments.push_back(segment_id);
       }
     }
+    LinkMaterializedSegments(new_segments);
+  }
 
-    // Placing inter-segment connections.
-    for (auto &segment : segment_map) {
-      SegmentId segment_id = segment.first;
-      auto &segment_waypoints = segment.second;
+  bool InMemoryMap::MaterializeSegment(const SegmentId segment_id) {
 
-      auto successors = GetSuccessors(segment_id, segment_topology, segment_map);
-      auto predecessors = GetPredecessors(segment_id, segment_topology, segment_map);
+    auto entry = segment_entry.find(segment_id);
+    if (entry == segment_entry.end() || segment_map.find(segment_id) != segment_map.end()) {
+      return false;
+    }
 
-      segment_waypoints.front()->SetPreviousWaypoint(predecessors);
-      segment_waypoints.back()->SetNextWaypoint(successors);
+    // Walking the segment from its entry waypoint samples it in travel
+    // direction, so no reordering is needed afterwards.
+    std::vector<SimpleWaypointPtr> segment_waypoints;
+    WaypointPtr current_waypoint = entry->second;
+    while (current_waypoint != nullptr) {
+      // Waypoints live as long as the map; allocating them from the arena
+      // makes episode teardown O(chunks) instead of O(waypoints). Callers
+      // hold the map_mutex, so bumping the arena here is single-threaded.
+      segment_waypoints.emplace_back(std::allocate_shared<SimpleWaypoint>(
+          ArenaAllocator<SimpleWaypoint>(&waypoint_arena), current_waypoint));
+
+      WaypointPtr next_in_segment = nullptr;
+      for (auto &next_waypoint : current_waypoint->GetNext(MAP_RESOLUTION)) {
+        if (GetSegmentId(next_waypoint) == segment_id) {
+          next_in_segment = next_waypoint;
+          break;
+        }
+      }
+      current_waypoint = next_in_segment;
     }
 
-    // Linking lane change connections.
-    for (auto &simple_waypoint:dense_topology) {
-      if (!simple_waypoint->CheckJunction()) {
-        FindAndLinkLaneChange(simple_waypoint);
+    // Generating geodesic grid ids and placing intra-segment connections.
+    ++geodesic_grid_id_counter;
+    cg::Location grid_edge_location = segment_waypoints.front()->GetLocation();
+    for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
+
+      // Assigning grid id.
+      if (cg::Math::DistanceSquared(grid_edge_location, segment_waypoints.at(i)->GetLocation()) >
+      SQUARE(MAX_GEODESIC_GRID_LENGTH)) {
+        ++geodesic_grid_id_counter;
+        grid_edge_location = segment_waypoints.at(i)->GetLocation();
+      }
+      segment_waypoints.at(i)->SetGeodesicGridId(geodesic_grid_id_counter);
+
+      segment_waypoints.at(i)->SetNextWaypoint({segment_waypoints.at(i + 1)});
+      segment_waypoints.at(i + 1)->SetPreviousWaypoint({segment_waypoints.at(i)});
+    }
+    segment_waypoints.back()->SetGeodesicGridId(geodesic_grid_id_counter);
+
+    // Adding simple waypoints to processed dense topology.
+    for (auto swp: segment_waypoints) {
+      // Checking whether the waypoint is a real junction.
+      auto road_id = swp->GetWaypoint()->GetRoadId();
+      if (swp->GetWaypoint()->IsJunction() && !is_real_junction.count(road_id)) {
+        swp->SetIsJunction(false);
+      } else {
+        swp->SetIsJunction(swp->GetWaypoint()->IsJunction());
       }
+
+      dense_topology.push_back(swp);
+
+      const cg::Location loc = swp->GetLocation();
+      rtree.insert(std::make_pair(Point3D(loc.x, loc.y, loc.z), swp));
     }
 
-    // Linking any unconnected segments.
-    for (auto &swp: dense_topology) {
-      if (swp->GetNextWaypoint().empty()) {
+    segment_map.insert({segment_id, std::move(segment_waypoints)});
+    return true;
+  }
+
+  void InMemoryMap::LinkMaterializedSegments(const std::vector<SegmentId> &new_segments) {
+
+    const std::set<SegmentId> new_segment_set(new_segments.begin(), new_segments.end());
+    for (const SegmentId &segment_id : new_segments) {
+      auto &segment_waypoints = segment_map.at(segment_id);
+      auto topology_entry = segment_topology.find(segment_id);
+
+      // Placing inter-segment connections towards every materialized
+      // neighbour. Predecessors inside this batch are skipped; their own
+      // successor pass places the link.
+      if (topology_entry != segment_topology.end()) {
+        for (const SegmentId &successor_id : topology_entry->second.second) {
+          auto successor = segment_map.find(successor_id);
+          if (successor != segment_map.end()) {
+            segment_waypoints.back()->SetNextWaypoint({successor->second.front()});
+            successor->second.front()->SetPreviousWaypoint({segment_waypoints.back()});
+          }
+        }
+        for (const SegmentId &predecessor_id : topology_entry->second.first) {
+          if (new_segment_set.find(predecessor_id) != new_segment_set.end()) {
+            continue;
+          }
+          auto predecessor = segment_map.find(predecessor_id);
+          if (predecessor != segment_map.end()) {
+            predecessor->second.back()->SetNextWaypoint({segment_waypoints.front()});
+            segment_waypoints.front()->SetPreviousWaypoint({predecessor->second.back()});
+          }
+        }
+      }
+
+      // Linking lane change connections.
+      for (auto &swp : segment_waypoints) {
+        if (!swp->CheckJunction()) {
+          FindAndLinkLaneChange(swp);
+        }
+      }
+
+      // Linking any unconnected segments. Only true dead ends are patched
+      // through a neighbouring lane; a missing link towards a segment the
+      // topology knows about is placed once that segment materializes.
+      if (topology_entry == segment_topology.end() || topology_entry->second.second.empty()) {
+        auto &swp = segment_waypoints.back();
         auto neighbour = swp->GetRightWaypoint();
         if (!neighbour) {
           neighbour = swp->GetLeftWaypoint();
@@ -231,19 +305,49 @@ namespace traffic_manager {
     }
   }
 
-  SimpleWaypointPtr InMemoryMap::GetWaypoint(const cg::Location loc) const {
+  SimpleWaypointPtr InMemoryMap::GetWaypointInternal(const cg::Location loc) const {
 
     Point3D query_point(loc.x, loc.y, loc.z);
     std::vector<SpatialTreeEntry> result_1;
 
     rtree.query(bgi::nearest(query_point, 1), std::back_inserter(result_1));
+    if (result_1.empty()) {
+      return nullptr;
+    }
     SpatialTreeEntry &closest_entry = result_1.front();
     SimpleWaypointPtr &closest_point = closest_entry.second;
 
     return closest_point;
   }
 
+  SimpleWaypointPtr InMemoryMap::GetWaypoint(const cg::Location loc) {
+
+    std::lock_guard<std::mutex> lock(map_mutex);
+    EnsureAreaMaterialized(loc);
+    SimpleWaypointPtr closest_waypoint = GetWaypointInternal(loc);
+
+    // The query landed in a cell without road geometry (e.g. an actor far
+    // off-road); materialize the region owning the nearest coarse sample
+    // instead of answering from whatever happens to be resident.
+    if (closest_waypoint == nullptr
+        || closest_waypoint->DistanceSquared(loc) > SQUARE(MATERIALIZATION_CELL_SIZE)) {
+      std::vector<CoarseTreeEntry> coarse_result;
+      coarse_rtree.query(bgi::nearest(Point3D(loc.x, loc.y, loc.z), 1),
+                         std::back_inserter(coarse_result));
+      if (!coarse_result.empty()) {
+        const Point3D &nearest_sample = coarse_result.front().first;
+        EnsureAreaMaterialized(cg::Location(nearest_sample.get<0>(),
+                                            nearest_sample.get<1>(),
+                                            nearest_sample.get<2>()));
+        closest_waypoint = GetWaypointInternal(loc);
+      }
+    }
+
+    return closest_waypoint;
+  }
+
   std::vector<SimpleWaypointPtr> InMemoryMap::GetDenseTopology() const {
+    std::lock_guard<std::mutex> lock(map_mutex);
     return dense_topology;
   }
 
@@ -263,8 +367,10 @@ namespace traffic_manager {
         left_waypoint->GetType() == crd::Lane::LaneType::Driving &&
         (left_waypoint->GetLaneId() * raw_waypoint->GetLaneId() > 0)) {
 
-          SimpleWaypointPtr closest_simple_waypoint = GetWaypoint(left_waypoint->GetTransform().location);
-          reference_waypoint->SetLeftWaypoint(closest_simple_waypoint);
+          SimpleWaypointPtr closest_simple_waypoint = GetWaypointInternal(left_waypoint->GetTransform().location);
+          if (closest_simple_waypoint != nullptr) {
+            reference_waypoint->SetLeftWaypoint(closest_simple_waypoint);
+          }
         }
       }
       break;
@@ -277,8 +383,10 @@ namespace traffic_manager {
 	    right_waypoint->GetType() == crd::Lane::LaneType::Driving &&
 	    (right_waypoint->GetLaneId() * raw_waypoint->GetLaneId() > 0)) {
 
-	      SimpleWaypointPtr closest_simple_waypoint = GetWaypoint(right_waypoint->GetTransform().location);
-	      reference_waypoint->SetRightWaypoint(closest_simple_waypoint);
+	      SimpleWaypointPtr closest_simple_waypoint = GetWaypointInternal(right_waypoint->GetTransform().location);
+	      if (closest_simple_waypoint != nullptr) {
+	        reference_waypoint->SetRightWaypoint(closest_simple_waypoint);
+	      }
 	    }
       }
       break;
@@ -292,8 +400,10 @@ namespace traffic_manager {
         right_waypoint->GetType() == crd::Lane::LaneType::Driving &&
         (right_waypoint->GetLaneId() * raw_waypoint->GetLaneId() > 0)) {
 
-          SimpleWaypointPtr closest_simple_waypointR = GetWaypoint(right_waypoint->GetTransform().location);
-          reference_waypoint->SetRightWaypoint(closest_simple_waypointR);
+          SimpleWaypointPtr closest_simple_waypointR = GetWaypointInternal(right_waypoint->GetTransform().location);
+          if (closest_simple_waypointR != nullptr) {
+            reference_waypoint->SetRightWaypoint(closest_simple_waypointR);
+          }
         }
 
         /// Left transit way point
@@ -302,8 +412,10 @@ namespace traffic_manager {
         left_waypoint->GetType() == crd::Lane::LaneType::Driving &&
         (left_waypoint->GetLaneId() * raw_waypoint->GetLaneId() > 0)) {
 
-          SimpleWaypointPtr closest_simple_waypointL = GetWaypoint(left_waypoint->GetTransform().location);
-          reference_waypoint->SetLeftWaypoint(closest_simple_waypointL);
+          SimpleWaypointPtr closest_simple_waypointL = GetWaypointInternal(left_waypoint->GetTransform().location);
+          if (closest_simple_waypointL != nullptr) {
+            reference_waypoint->SetLeftWaypoint(closest_simple_waypointL);
+          }
         }
       }
       break;
@@ -6,11 +6,15 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "boost/geometry.hpp"
+#include "boost/geometry/geometries/box.hpp"
 #include "boost/geometry/geometries/point.hpp"
 #include "boost/geometry/index/rtree.hpp"
 
@@ -22,6 +26,7 @@
 #include "carla/road/RoadTypes.h"
 
 #include "carla/trafficmanager/SimpleWaypoint.h"
+#include "carla/trafficmanager/TickArena.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -44,39 +49,74 @@ namespace bgi = boost::geometry::index;
   using SegmentId = std::tuple<crd::RoadId, crd::LaneId, crd::SectionId>;
   using SegmentTopology = std::map<SegmentId, std::pair<std::vector<SegmentId>, std::vector<SegmentId>>>;
   using SegmentMap = std::map<SegmentId, std::vector<SimpleWaypointPtr>>;
+  using CoarseTreeEntry = std::pair<Point3D, SegmentId>;
 
   /// This class builds a discretized local map-cache.
   /// Instantiate the class with the world and run SetUp() to construct the
   /// local map.
+  ///
+  /// The cache is two-level: SetUp() builds only the segment topology graph
+  /// and a coarse region index over the whole town; the dense waypoint
+  /// sampling of a region is materialized the first time a query lands near
+  /// it, so large maps do not pay the full build on startup.
   class InMemoryMap {
 
   private:
 
+    /// Arena owning every SimpleWaypoint and its control block. Individual
+    /// shared_ptr releases are no-ops; the whole graph comes back in a
+    /// handful of chunk frees when the map is dropped, instead of one heap
+    /// free per waypoint. Declared first so it outlives the containers
+    /// below that hold pointers into it.
+    TickArena waypoint_arena;
     /// Object to hold the world map received by the constructor.
     WorldMap _world_map;
-    /// Structure to hold all custom waypoint objects after interpolation of
-    /// sparse topology.
+    /// Structure to hold all custom waypoint objects of materialized regions.
     NodeList dense_topology;
-    /// Spatial quadratic R-tree for indexing and querying waypoints.
+    /// Spatial quadratic R-tree for indexing and querying materialized waypoints.
     bgi::rtree<SpatialTreeEntry, bgi::quadratic<32>> rtree;
 
     /// Geodesic grid topology.
     std::unordered_map<GeoGridId, cg::Location> geodesic_grid_center;
 
+    /// Segment connectivity, built eagerly from the sparse topology.
+    SegmentTopology segment_topology;
+    /// Entry waypoint (travel-direction start) of every segment.
+    std::map<SegmentId, WaypointPtr> segment_entry;
+    /// Junction roads connected to more than one incoming or outgoing road.
+    std::unordered_map<crd::RoadId, bool> is_real_junction;
+    /// Dense waypoints of the segments materialized so far.
+    SegmentMap segment_map;
+    /// Coarse samples of every segment, always resident; used to find the
+    /// segments belonging to a region before it is materialized.
+    bgi::rtree<CoarseTreeEntry, bgi::quadratic<32>> coarse_rtree;
+    /// Grid cells whose segments have already been materialized.
+    std::unordered_set<uint64_t> materialized_cells;
+    GeoGridId geodesic_grid_id_counter {-1};
+    /// Guards all lazy-materialization state; queries mutate the cache.
+    mutable std::mutex map_mutex;
+
   public:
 
     InMemoryMap(WorldMap world_map);
     ~InMemoryMap();
 
-    /// This method constructs the local map with a resolution of
-    /// sampling_resolution.
+    /// Returns the process-wide map instance for @a world_map, building it
+    /// on first request. Traffic manager instances running against the same
+    /// town in one process share one map; the instance is dropped once the
+    /// last of them releases it.
+    static std::shared_ptr<InMemoryMap> GetOrCreate(WorldMap world_map);
+
+    /// This method constructs the coarse topology of the local map; dense
+    /// waypoints are sampled per region on first use.
     void SetUp();
 
-    /// This method returns the closest waypoint to a given location on the map.
-    SimpleWaypointPtr GetWaypoint(const cg::Location loc) const;
+    /// This method returns the closest waypoint to a given location on the
+    /// map, materializing the surrounding region when necessary.
+    SimpleWaypointPtr GetWaypoint(const cg::Location loc);
 
-    /// This method returns the full list of discrete samples of the map in the
-    /// local cache.
+    /// This method returns the discrete samples of the regions materialized
+    /// so far.
     NodeList GetDenseTopology() const;
 
     std::string GetMapName();
@@ -86,10 +126,20 @@ namespace bgi = boost::geometry::index;
     /// This method is used to find and place lane change links.
     void FindAndLinkLaneChange(SimpleWaypointPtr reference_waypoint);
 
-    std::vector<SimpleWaypointPtr> GetSuccessors(const SegmentId segment_id,
-    const SegmentTopology &segment_topology, const SegmentMap &segment_map);
-    std::vector<SimpleWaypointPtr> GetPredecessors(const SegmentId segment_id,
-    const SegmentTopology &segment_topology, const SegmentMap &segment_map);
+    /// Materializes the grid cells around @a loc that have not been
+    /// materialized yet.
+    void EnsureAreaMaterialized(const cg::Location loc);
+
+    /// Builds the dense waypoints of a single segment. Returns true when the
+    /// segment was materialized by this call.
+    bool MaterializeSegment(const SegmentId segment_id);
+
+    /// Places inter-segment, lane change and dead-end links for freshly
+    /// materialized segments.
+    void LinkMaterializedSegments(const std::vector<SegmentId> &new_segments);
+
+    /// Nearest-waypoint query over the materialized regions only.
+    SimpleWaypointPtr GetWaypointInternal(const cg::Location loc) const;
 
     /// Computes the segment id of a given waypoint.
     /// The Id takes into account OpenDrive's road Id, lane Id and Section Id.
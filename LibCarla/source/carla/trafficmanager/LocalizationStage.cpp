@@ -59,6 +59,8 @@ void LocalizationStage::Update(const unsigned long index) {
     for (uint64_t j = 0u; j < number_of_pops; ++j) {
       PopWaypoint(actor_id, track_traffic, waypoint_buffer);
     }
+    // The vehicle diverged from its planned path, the parked chain is stale.
+    path_reserve.erase(actor_id);
   }
 
   bool is_at_junction_entrance = false;
@@ -86,10 +88,12 @@ void LocalizationStage::Update(const unsigned long index) {
       }
     }
 
-    // Purge waypoints too far from the front of the buffer.
+    // Purge waypoints too far from the front of the buffer, parking them
+    // for reuse when the horizon stretches again.
     while (!is_at_junction_entrance
            && !waypoint_buffer.empty()
            && waypoint_buffer.back()->DistanceSquared(waypoint_buffer.front()) > horizon_square) {
+      path_reserve[actor_id].push_back(waypoint_buffer.back());
       PopWaypoint(actor_id, track_traffic, waypoint_buffer, false);
     }
   }
@@ -98,6 +102,7 @@ void LocalizationStage::Update(const unsigned long index) {
   if (waypoint_buffer.empty()) {
     SimpleWaypointPtr closest_waypoint = local_map->GetWaypoint(vehicle_location);
     PushWaypoint(actor_id, track_traffic, waypoint_buffer, closest_waypoint);
+    path_reserve.erase(actor_id);
   }
 
   // Assign a lane change.
@@ -125,10 +130,22 @@ void LocalizationStage::Update(const unsigned long index) {
   bool auto_or_force_lane_change = parameters.GetAutoLaneChange(actor_id) || force_lane_change;
   bool front_waypoint_not_junction = !front_waypoint->CheckJunction();
 
+  // Re-evaluate the lane change decision only when the vehicle has moved on
+  // to a new waypoint; until then the previous decision for this stretch of
+  // road still holds. Forced lane changes bypass the cached decision.
+  bool lane_change_decision_pending = force_lane_change;
+  if (!lane_change_decision_pending) {
+    auto last_evaluation = last_lane_change_evaluation.find(actor_id);
+    lane_change_decision_pending = (last_evaluation == last_lane_change_evaluation.end()
+                                    || last_evaluation->second != front_waypoint->GetId());
+  }
+
   if (auto_or_force_lane_change
       && front_waypoint_not_junction
+      && lane_change_decision_pending
       && (recently_not_executed_lane_change || done_with_previous_lane_change)) {
 
+    last_lane_change_evaluation[actor_id] = front_waypoint->GetId();
     SimpleWaypointPtr change_over_point = AssignLaneChange(actor_id, vehicle_location, vehicle_speed,
                                                            force_lane_change, lane_change_direction);
 
@@ -143,39 +160,50 @@ void LocalizationStage::Update(const unsigned long index) {
         PopWaypoint(actor_id, track_traffic, waypoint_buffer);
       }
       PushWaypoint(actor_id, track_traffic, waypoint_buffer, change_over_point);
+      // The buffer now follows the new lane, drop the chain parked for the
+      // old one.
+      path_reserve.erase(actor_id);
     }
   }
 
-  // Populating the buffer.
+  // Populating the buffer, re-attaching the parked chain before sampling
+  // fresh waypoints so earlier path choices are kept.
+  std::vector<SimpleWaypointPtr> &parked_path = path_reserve[actor_id];
   while (waypoint_buffer.back()->DistanceSquared(waypoint_buffer.front()) <= horizon_square) {
 
-    SimpleWaypointPtr furthest_waypoint = waypoint_buffer.back();
-    std::vector<SimpleWaypointPtr> next_waypoints = furthest_waypoint->GetNextWaypoint();
-    uint64_t selection_index = 0u;
-    // Pseudo-randomized path selection if found more than one choice.
-    if (next_waypoints.size() > 1) {
-      // Arranging selection points from right to left.
-      std::sort(next_waypoints.begin(), next_waypoints.end(),
-                [&furthest_waypoint](const SimpleWaypointPtr &a, const SimpleWaypointPtr &b) {
-                  float a_x_product = DeviationCrossProduct(furthest_waypoint->GetLocation(),
-                                                            furthest_waypoint->GetForwardVector(),
-                                                            a->GetLocation());
-                  float b_x_product = DeviationCrossProduct(furthest_waypoint->GetLocation(),
-                                                            furthest_waypoint->GetForwardVector(),
-                                                            b->GetLocation());
-                  return a_x_product < b_x_product;
-                });
-      double r_sample = random_devices.at(actor_id).next();
-      double s_bucket = 100.0 / next_waypoints.size();
-      selection_index = static_cast<uint64_t>(std::floor(r_sample/s_bucket));
-    } else if (next_waypoints.size() == 0) {
-      if (!parameters.GetOSMMode()) {
-        std::cout << "This map has dead-end roads, please change the set_open_street_map parameter to true" << std::endl;
+    SimpleWaypointPtr next_wp_selection = nullptr;
+    if (!parked_path.empty()) {
+      next_wp_selection = parked_path.back();
+      parked_path.pop_back();
+    } else {
+      SimpleWaypointPtr furthest_waypoint = waypoint_buffer.back();
+      std::vector<SimpleWaypointPtr> next_waypoints = furthest_waypoint->GetNextWaypoint();
+      uint64_t selection_index = 0u;
+      // Pseudo-randomized path selection if found more than one choice.
+      if (next_waypoints.size() > 1) {
+        // Arranging selection points from right to left.
+        std::sort(next_waypoints.begin(), next_waypoints.end(),
+                  [&furthest_waypoint](const SimpleWaypointPtr &a, const SimpleWaypointPtr &b) {
+                    float a_x_product = DeviationCrossProduct(furthest_waypoint->GetLocation(),
+                                                              furthest_waypoint->GetForwardVector(),
+                                                              a->GetLocation());
+                    float b_x_product = DeviationCrossProduct(furthest_waypoint->GetLocation(),
+                                                              furthest_waypoint->GetForwardVector(),
+                                                              b->GetLocation());
+                    return a_x_product < b_x_product;
+                  });
+        double r_sample = random_devices.at(actor_id).next();
+        double s_bucket = 100.0 / next_waypoints.size();
+        selection_index = static_cast<uint64_t>(std::floor(r_sample/s_bucket));
+      } else if (next_waypoints.size() == 0) {
+        if (!parameters.GetOSMMode()) {
+          std::cout << "This map has dead-end roads, please change the set_open_street_map parameter to true" << std::endl;
+        }
+        marked_for_removal.push_back(actor_id);
+        break;
       }
-      marked_for_removal.push_back(actor_id);
-      break;
+      next_wp_selection = next_waypoints.at(selection_index);
     }
-    SimpleWaypointPtr next_wp_selection = next_waypoints.at(selection_index);
     PushWaypoint(actor_id, track_traffic, waypoint_buffer, next_wp_selection);
   }
 
@@ -232,8 +260,10 @@ void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
       }
     }
 
-    // Extend buffer if safe point not found.
+    // Extend buffer if safe point not found. Pushing past the planned
+    // horizon here invalidates the chain parked for this vehicle.
     if (!safe_point_found) {
+      path_reserve.erase(actor_id);
       while (!past_junction) {
         current_waypoint = current_waypoint->GetNextWaypoint().front();
         PushWaypoint(actor_id, track_traffic, waypoint_buffer, current_waypoint);
@@ -274,11 +304,15 @@ void LocalizationStage::ExtendAndFindSafeSpace(const ActorId actor_id,
 
 void LocalizationStage::RemoveActor(ActorId actor_id) {
     last_lane_change_location.erase(actor_id);
+    path_reserve.erase(actor_id);
+    last_lane_change_evaluation.erase(actor_id);
     vehicles_at_junction.erase(actor_id);
 }
 
 void LocalizationStage::Reset() {
   last_lane_change_location.clear();
+  path_reserve.clear();
+  last_lane_change_evaluation.clear();
   vehicles_at_junction.clear();
 }
 
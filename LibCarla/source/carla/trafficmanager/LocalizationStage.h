@@ -21,6 +21,7 @@ namespace cc = carla::client;
 
 using LocalMapPtr = std::shared_ptr<InMemoryMap>;
 using LaneChangeLocationMap = std::unordered_map<ActorId, cg::Location>;
+using PathReserveMap = std::unordered_map<ActorId, std::vector<SimpleWaypointPtr>>;
 
 /// This class has functionality to maintain a horizon of waypoints ahead
 /// of the vehicle for it to follow.
@@ -39,6 +40,14 @@ private:
   LocalizationFrame &output_array;
   cc::DebugHelper &debug_helper;
   LaneChangeLocationMap last_lane_change_location;
+  // Waypoints purged from the rear of a buffer when the horizon shrinks,
+  // kept in reverse travel order and re-attached when it stretches again.
+  // Cleared whenever the vehicle diverges from the planned path.
+  PathReserveMap path_reserve;
+  // Front waypoint at the last lane change evaluation of each vehicle;
+  // the decision is re-evaluated only once the vehicle moves on to a new
+  // waypoint.
+  std::unordered_map<ActorId, uint64_t> last_lane_change_evaluation;
   ActorIdSet vehicles_at_junction;
   using SimpleWaypointPair = std::pair<SimpleWaypointPtr, SimpleWaypointPtr>;
   std::unordered_map<ActorId, SimpleWaypointPair> vehicles_at_junction_entrance;
@@ -72,6 +81,8 @@ public:
   void RemoveActor(const ActorId actor_id) override;
 
   void Reset() override;
+
+  using Stage::SetTickArena;
 };
 
 } // namespace traffic_manager
@@ -44,6 +44,30 @@ MotionPlanStage::MotionPlanStage(
     world(world),
     output_array(output_array) {}
 
+void MotionPlanStage::SetupCycle(const cc::Timestamp &timestamp) {
+  cycle_timestamp = timestamp;
+
+  // Re-align the controller state slots with the vehicle list when it has
+  // changed, carrying over the state of vehicles that are still present.
+  if (pid_state_owner != vehicle_id_list) {
+    std::unordered_map<ActorId, StateEntry> carried_state;
+    for (std::size_t i = 0u; i < pid_state_owner.size(); ++i) {
+      carried_state.insert({pid_state_owner.at(i), pid_state_flat.at(i)});
+    }
+
+    pid_state_owner = vehicle_id_list;
+    pid_state_flat.resize(vehicle_id_list.size());
+    for (std::size_t i = 0u; i < vehicle_id_list.size(); ++i) {
+      auto previous_entry = carried_state.find(vehicle_id_list.at(i));
+      if (previous_entry != carried_state.end()) {
+        pid_state_flat.at(i) = previous_entry->second;
+      } else {
+        pid_state_flat.at(i) = StateEntry{cycle_timestamp, 0.0f, 0.0f, 0.0f, 0.0f};
+      }
+    }
+  }
+}
+
 void MotionPlanStage::Update(const unsigned long index) {
   const ActorId actor_id = vehicle_id_list.at(index);
   const cg::Location ego_location = simulation_state.GetLocation(actor_id);
@@ -67,28 +91,18 @@ void MotionPlanStage::Update(const unsigned long index) {
     dot_product *= -1.0f;
   }
   const float current_deviation = dot_product;
-  current_timestamp = world.GetSnapshot().GetTimestamp();
-
-  // If previous state for vehicle not found, initialize state entry.
-  if (pid_state_map.find(actor_id) == pid_state_map.end()) {
-    const auto initial_state = StateEntry{current_timestamp, 0.0f, 0.0f, 0.0f, 0.0f};
-    pid_state_map.insert({actor_id, initial_state});
-  }
+  const cc::Timestamp &current_timestamp = cycle_timestamp;
 
-  // Retrieving the previous state.
-  traffic_manager::StateEntry previous_state;
-  previous_state = pid_state_map.at(actor_id);
+  // Controller state lives in the slot aligned by SetupCycle; only this
+  // vehicle's shard touches it during the update.
+  const StateEntry previous_state = pid_state_flat.at(index);
 
   // Select PID parameters.
-  std::vector<float> longitudinal_parameters;
-  std::vector<float> lateral_parameters;
-  if (ego_speed > HIGHWAY_SPEED) {
-    longitudinal_parameters = highway_longitudinal_parameters;
-    lateral_parameters = highway_lateral_parameters;
-  } else {
-    longitudinal_parameters = urban_longitudinal_parameters;
-    lateral_parameters = urban_lateral_parameters;
-  }
+  const bool on_highway = ego_speed > HIGHWAY_SPEED;
+  const std::vector<float> &longitudinal_parameters =
+      on_highway ? highway_longitudinal_parameters : urban_longitudinal_parameters;
+  const std::vector<float> &lateral_parameters =
+      on_highway ? highway_lateral_parameters : urban_lateral_parameters;
 
   // Target velocity for vehicle.
   const float ego_speed_limit = simulation_state.GetSpeedLimit(actor_id);
@@ -137,12 +151,14 @@ void MotionPlanStage::Update(const unsigned long index) {
                      0.0f, 0.0f};
 
     // Add entry to teleportation duration clock table if not present.
-    if (teleportation_instance.find(actor_id) == teleportation_instance.end()) {
-      teleportation_instance.insert({actor_id, current_timestamp});
+    cc::Timestamp last_teleportation;
+    {
+      std::lock_guard<std::mutex> guard(state_map_mutex);
+      last_teleportation = teleportation_instance.insert({actor_id, current_timestamp}).first->second;
     }
 
     // Measuring time elapsed since last teleportation for the vehicle.
-    double elapsed_time = current_timestamp.elapsed_seconds - teleportation_instance.at(actor_id).elapsed_seconds;
+    double elapsed_time = current_timestamp.elapsed_seconds - last_teleportation.elapsed_seconds;
 
     // Find a location ahead of the vehicle for teleportation to achieve intended velocity.
     if (!emergency_stop && (parameters.GetSynchronousMode() || elapsed_time > HYBRID_MODE_DT)) {
@@ -171,8 +187,7 @@ void MotionPlanStage::Update(const unsigned long index) {
   }
 
   // Updating PID state.
-  StateEntry &state = pid_state_map.at(actor_id);
-  state = current_state;
+  pid_state_flat.at(index) = current_state;
 
   // Constructing the actuation signal.
   if (ego_physics_enabled) {
@@ -201,7 +216,7 @@ bool MotionPlanStage::SafeAfterJunction(const LocalizationData &localization,
       && junction_end_point != nullptr && safe_point != nullptr
       && junction_end_point->DistanceSquared(safe_point) > SQUARE(MIN_SAFE_INTERVAL_LENGTH)) {
 
-    ActorIdSet initial_set = track_traffic.GetPassingVehicles(junction_end_point->GetId());
+    const TrackedActorSet initial_set = track_traffic.GetPassingVehicles(junction_end_point->GetId());
     float safe_interval_length_squared = junction_end_point->DistanceSquared(safe_point);
     cg::Location mid_point = (junction_end_point->GetLocation() + safe_point->GetLocation())/2.0f;
 
@@ -211,11 +226,13 @@ bool MotionPlanStage::SafeAfterJunction(const LocalizationData &localization,
          current_waypoint->DistanceSquared(junction_end_point) < safe_interval_length_squared && safe_after_junction;
          current_waypoint = current_waypoint->GetNextWaypoint().front()) {
 
-      ActorIdSet current_set = track_traffic.GetPassingVehicles(current_waypoint->GetId());
-      ActorIdSet difference;
+      const TrackedActorSet &current_set = track_traffic.GetPassingVehicles(current_waypoint->GetId());
+      // Both sets iterate in ascending id order, as std::set_difference
+      // requires.
+      std::vector<ActorId> difference;
       std::set_difference(current_set.begin(), current_set.end(),
                           initial_set.begin(), initial_set.end(),
-                          std::inserter(difference, difference.begin()));
+                          std::back_inserter(difference));
       if (difference.size() > 0) {
         for (const ActorId &blocking_id: difference) {
           cg::Location blocking_actor_location = simulation_state.GetLocation(blocking_id);
@@ -279,12 +296,15 @@ std::pair<bool, float> MotionPlanStage::CollisionHandling(const CollisionHazardD
 }
 
 void MotionPlanStage::RemoveActor(const ActorId actor_id) {
-  pid_state_map.erase(actor_id);
+  // Controller state slots re-align with the vehicle list in SetupCycle.
+  std::lock_guard<std::mutex> guard(state_map_mutex);
   teleportation_instance.erase(actor_id);
 }
 
 void MotionPlanStage::Reset() {
-  pid_state_map.clear();
+  std::lock_guard<std::mutex> guard(state_map_mutex);
+  pid_state_flat.clear();
+  pid_state_owner.clear();
   teleportation_instance.clear();
 }
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "carla/trafficmanager/DataStructures.h"
 #include "carla/trafficmanager/LocalizationUtils.h"
 #include "carla/trafficmanager/Parameters.h"
@@ -30,13 +32,21 @@ private:
   const CollisionFrame &collision_frame;
   const TLFrame &tl_frame;
   const cc::World &world;
-  // Structure holding the controller state for registered vehicles.
-  std::unordered_map<ActorId, StateEntry> pid_state_map;
+  // Controller state laid out contiguously by update index, remapped in
+  // SetupCycle when the registered vehicle list changes. During the update
+  // each slot is touched only by its own vehicle's shard.
+  std::vector<StateEntry> pid_state_flat;
+  // Owner of each controller state slot, mirrors vehicle_id_list.
+  std::vector<ActorId> pid_state_owner;
+  // Timestamp of the cycle being processed, set once in SetupCycle.
+  cc::Timestamp cycle_timestamp;
   // Structure to keep track of duration between teleportation
   // in hybrid physics mode.
   std::unordered_map<ActorId, cc::Timestamp> teleportation_instance;
+  // Guards insertion into the teleportation clock table; vehicle shards of
+  // this stage run concurrently and new vehicles may rehash the table.
+  std::mutex state_map_mutex;
   ControlFrame &output_array;
-  cc::Timestamp current_timestamp;
 
   std::pair<bool, float> CollisionHandling(const CollisionHazardData &collision_hazard,
                                            const bool tl_hazard,
@@ -64,6 +74,11 @@ public:
                   const cc::World &world,
                   ControlFrame &output_array);
 
+  // Per-cycle serial preparation: caches the frame timestamp and lays the
+  // controller state out along the current vehicle list. Must run before
+  // the vehicle shards of this stage.
+  void SetupCycle(const cc::Timestamp &timestamp);
+
   void Update(const unsigned long index);
 
   void RemoveActor(const ActorId actor_id);
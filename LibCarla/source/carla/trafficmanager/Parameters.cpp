@@ -91,6 +91,10 @@ void Parameters::SetSynchronousMode(const bool mode_switch) {
   synchronous_mode.store(mode_switch);
 }
 
+void Parameters::SetPipelinedMode(const bool mode_switch) {
+  pipelined_mode.store(mode_switch);
+}
+
 void Parameters::SetSynchronousModeTimeOutInMiliSecond(const double time) {
   synchronous_time_out = std::chrono::duration<double, std::milli>(time);
 }
@@ -137,6 +141,10 @@ void Parameters::SetOSMMode(const bool mode_switch) {
   osm_mode.store(mode_switch);
 }
 
+void Parameters::SetDeterministicStreams(const bool mode_switch) {
+  deterministic_streams.store(mode_switch);
+}
+
 //////////////////////////////////// GETTERS //////////////////////////////////
 
 float Parameters::GetHybridPhysicsRadius() const {
@@ -148,6 +156,10 @@ bool Parameters::GetSynchronousMode() const {
   return synchronous_mode.load();
 }
 
+bool Parameters::GetPipelinedMode() const {
+  return pipelined_mode.load();
+}
+
 double Parameters::GetSynchronousModeTimeOutInMiliSecond() const {
   return synchronous_time_out.count();
 }
@@ -156,9 +168,7 @@ float Parameters::GetVehicleTargetVelocity(const ActorId &actor_id, const float
 
   float percentage_difference = global_percentage_difference_from_limit;
 
-  if (percentage_difference_from_speed_limit.Contains(actor_id)) {
-    percentage_difference = percentage_difference_from_speed_limit.GetValue(actor_id);
-  }
+  percentage_difference_from_speed_limit.GetValueIfPresent(actor_id, percentage_difference);
 
   return speed_limit * (1.0f - percentage_difference / 100.0f);
 }
@@ -167,8 +177,9 @@ bool Parameters::GetCollisionDetection(const ActorId &reference_actor_id, const
 
   bool avoid_collision = true;
 
-  if (ignore_collision.Contains(reference_actor_id) &&
-    ignore_collision.GetValue(reference_actor_id)->Contains(other_actor_id)) {
+  std::shared_ptr<AtomicActorSet> actor_set;
+  if (ignore_collision.GetValueIfPresent(reference_actor_id, actor_set) &&
+    actor_set->Contains(other_actor_id)) {
     avoid_collision = false;
   }
 
@@ -179,9 +190,7 @@ ChangeLaneInfo Parameters::GetForceLaneChange(const ActorId &actor_id) {
 
   ChangeLaneInfo change_lane_info {false, false};
 
-  if (force_lane_change.Contains(actor_id)) {
-    change_lane_info = force_lane_change.GetValue(actor_id);
-  }
+  force_lane_change.GetValueIfPresent(actor_id, change_lane_info);
 
   force_lane_change.RemoveEntry(actor_id);
 
@@ -192,9 +201,7 @@ float Parameters::GetKeepRightPercentage(const ActorId &actor_id) {
 
   float percentage = -1.0f;
 
-  if (perc_keep_right.Contains(actor_id)) {
-    percentage = perc_keep_right.GetValue(actor_id);
-  }
+  perc_keep_right.GetValueIfPresent(actor_id, percentage);
 
   perc_keep_right.RemoveEntry(actor_id);
 
@@ -205,9 +212,7 @@ bool Parameters::GetAutoLaneChange(const ActorId &actor_id) const {
 
   bool auto_lane_change_policy = true;
 
-  if (auto_lane_change.Contains(actor_id)) {
-    auto_lane_change_policy = auto_lane_change.GetValue(actor_id);
-  }
+  auto_lane_change.GetValueIfPresent(actor_id, auto_lane_change_policy);
 
   return auto_lane_change_policy;
 }
@@ -215,9 +220,7 @@ bool Parameters::GetAutoLaneChange(const ActorId &actor_id) const {
 float Parameters::GetDistanceToLeadingVehicle(const ActorId &actor_id) const {
 
   float specific_distance_margin = 0.0f;
-  if (distance_to_leading_vehicle.Contains(actor_id)) {
-    specific_distance_margin = distance_to_leading_vehicle.GetValue(actor_id);
-  } else {
+  if (!distance_to_leading_vehicle.GetValueIfPresent(actor_id, specific_distance_margin)) {
     specific_distance_margin = distance_margin;
   }
 
@@ -228,9 +231,7 @@ float Parameters::GetPercentageRunningLight(const ActorId &actor_id) const {
 
   float percentage = 0.0f;
 
-  if (perc_run_traffic_light.Contains(actor_id)) {
-    percentage = perc_run_traffic_light.GetValue(actor_id);
-  }
+  perc_run_traffic_light.GetValueIfPresent(actor_id, percentage);
 
   return percentage;
 }
@@ -239,9 +240,7 @@ float Parameters::GetPercentageRunningSign(const ActorId &actor_id) const {
 
   float percentage = 0.0f;
 
-  if (perc_run_traffic_sign.Contains(actor_id)) {
-    percentage = perc_run_traffic_sign.GetValue(actor_id);
-  }
+  perc_run_traffic_sign.GetValueIfPresent(actor_id, percentage);
 
   return percentage;
 }
@@ -250,9 +249,7 @@ float Parameters::GetPercentageIgnoreWalkers(const ActorId &actor_id) const {
 
   float percentage = 0.0f;
 
-  if (perc_ignore_walkers.Contains(actor_id)) {
-    percentage = perc_ignore_walkers.GetValue(actor_id);
-  }
+  perc_ignore_walkers.GetValueIfPresent(actor_id, percentage);
 
   return percentage;
 }
@@ -261,9 +258,7 @@ float Parameters::GetPercentageIgnoreVehicles(const ActorId &actor_id) const {
 
   float percentage = 0.0f;
 
-  if (perc_ignore_vehicles.Contains(actor_id)) {
-    percentage = perc_ignore_vehicles.GetValue(actor_id);
-  }
+  perc_ignore_vehicles.GetValueIfPresent(actor_id, percentage);
 
   return percentage;
 }
@@ -278,5 +273,10 @@ bool Parameters::GetOSMMode() const {
   return osm_mode.load();
 }
 
+bool Parameters::GetDeterministicStreams() const {
+
+  return deterministic_streams.load();
+}
+
 } // namespace traffic_manager
 } // namespace carla
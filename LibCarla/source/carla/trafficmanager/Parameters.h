@@ -58,6 +58,8 @@ private:
   AtomicMap<ActorId, float> perc_keep_right;
   /// Synchronous mode switch.
   std::atomic<bool> synchronous_mode{false};
+  /// Pipelined synchronous execution switch.
+  std::atomic<bool> pipelined_mode{false};
   /// Distance margin
   std::atomic<float> distance_margin{2.0};
   /// Hybrid physics mode switch.
@@ -66,6 +68,8 @@ private:
   std::atomic<float> hybrid_physics_radius {70.0};
   /// Parameter specifying Open Street Map mode.
   std::atomic<bool> osm_mode {true};
+  /// Counter-based deterministic random stream switch.
+  std::atomic<bool> deterministic_streams {false};
 
 public:
   Parameters();
@@ -125,12 +129,19 @@ public:
   /// Method to set synchronous mode.
   void SetSynchronousMode(const bool mode_switch = true);
 
+  /// Method to set pipelined synchronous execution.
+  void SetPipelinedMode(const bool mode_switch);
+
   /// Method to set hybrid physics radius.
   void SetHybridPhysicsRadius(const float radius);
 
   /// Method to set Open Street Map mode.
   void SetOSMMode(const bool mode_switch);
 
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode.
+  void SetDeterministicStreams(const bool mode_switch);
+
   ///////////////////////////////// GETTERS /////////////////////////////////////
 
   /// Method to retrieve hybrid physics radius.
@@ -169,6 +180,9 @@ public:
   /// Method to get synchronous mode.
   bool GetSynchronousMode() const;
 
+  /// Method to get pipelined synchronous execution.
+  bool GetPipelinedMode() const;
+
   /// Get synchronous mode time out
   double GetSynchronousModeTimeOutInMiliSecond() const;
 
@@ -178,6 +192,9 @@ public:
   /// Method to get Open Street Map mode.
   bool GetOSMMode() const;
 
+  /// Method to retrieve the deterministic random stream switch.
+  bool GetDeterministicStreams() const;
+
   /// Synchronous mode time out variable.
   std::chrono::duration<double, std::milli> synchronous_time_out;
 };
@@ -9,11 +9,53 @@
 namespace carla {
 namespace traffic_manager {
 
+/// Per-actor random stream used by the traffic manager stages.
+///
+/// Two modes share one interface. The default mode draws from a per-actor
+/// mt19937 and matches the historical behaviour. The opt-in counter-based
+/// mode derives every draw purely from (seed, actor id, frame, draw index),
+/// Philox-style: a stream then never depends on how many draws other actors
+/// made or on thread interleaving, so the stages can shard across vehicles
+/// while staying bitwise reproducible.
 class RandomGenerator {
 public:
     RandomGenerator(const uint64_t seed): mt(std::mt19937(seed)), dist(0.0, 100.0) {}
-    double next() { return dist(mt); }
+
+    RandomGenerator(const uint64_t seed, const carla::rpc::ActorId actor_id)
+      : counter_based(true),
+        stream_key(MixBits(seed + MixBits(static_cast<uint64_t>(actor_id)))),
+        dist(0.0, 100.0) {}
+
+    double next() {
+        if (!counter_based) {
+            return dist(mt);
+        }
+        const uint64_t word = MixBits(MixBits(stream_key + frame) + draw_counter++);
+        // The top 53 bits give a uniform double in [0, 1), scaled to the
+        // [0, 100) range the stages compare percentages against.
+        return 100.0 * static_cast<double>(word >> 11u) * (1.0 / 9007199254740992.0);
+    }
+
+    /// Rebase the counter-based stream on @a current_frame and reset its draw
+    /// counter; called once per update cycle. No-op for the default mode.
+    void SetFrame(const uint64_t current_frame) {
+        frame = current_frame;
+        draw_counter = 0u;
+    }
+
 private:
+    // SplitMix64 finalizer: a bijection on 64-bit words with full avalanche.
+    static uint64_t MixBits(uint64_t z) {
+        z += 0x9e3779b97f4a7c15u;
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+        return z ^ (z >> 31u);
+    }
+
+    bool counter_based = false;
+    uint64_t stream_key = 0u;
+    uint64_t frame = 0u;
+    uint64_t draw_counter = 0u;
     std::mt19937 mt;
     std::uniform_real_distribution<double> dist;
 };
@@ -10,74 +10,133 @@ void SimulationState::AddActor(ActorId actor_id,
                                KinematicState kinematic_state,
                                StaticAttributes attributes,
                                TrafficLightState tl_state) {
-  actor_set.insert(actor_id);
-  kinematic_state_map.insert({actor_id, kinematic_state});
-  static_attribute_map.insert({actor_id, attributes});
-  tl_state_map.insert({actor_id, tl_state});
+  if (actor_slot_map.find(actor_id) != actor_slot_map.end()) {
+    return;
+  }
+  actor_slot_map.insert({actor_id, actor_ids.size()});
+  actor_ids.push_back(actor_id);
+  locations.push_back(kinematic_state.location);
+  rotations.push_back(kinematic_state.rotation);
+  velocities.push_back(kinematic_state.velocity);
+  speed_limits.push_back(kinematic_state.speed_limit);
+  physics_enabled_flags.push_back(kinematic_state.physics_enabled ? 1u : 0u);
+  tl_states.push_back(tl_state);
+  static_attributes.push_back(attributes);
 }
 
 bool SimulationState::ContainsActor(ActorId actor_id) const {
-  return actor_set.find(actor_id) != actor_set.end();
+  return actor_slot_map.find(actor_id) != actor_slot_map.end();
 }
 
 void SimulationState::RemoveActor(ActorId actor_id) {
-  actor_set.erase(actor_id);
-  kinematic_state_map.erase(actor_id);
-  static_attribute_map.erase(actor_id);
-  tl_state_map.erase(actor_id);
+  auto slot_entry = actor_slot_map.find(actor_id);
+  if (slot_entry == actor_slot_map.end()) {
+    return;
+  }
+  const uint64_t slot = slot_entry->second;
+  const uint64_t last_slot = actor_ids.size() - 1u;
+  if (slot != last_slot) {
+    // Move the last slot into the freed one to keep the arrays dense.
+    const ActorId moved_actor_id = actor_ids.at(last_slot);
+    actor_ids.at(slot) = moved_actor_id;
+    locations.at(slot) = locations.at(last_slot);
+    rotations.at(slot) = rotations.at(last_slot);
+    velocities.at(slot) = velocities.at(last_slot);
+    speed_limits.at(slot) = speed_limits.at(last_slot);
+    physics_enabled_flags.at(slot) = physics_enabled_flags.at(last_slot);
+    tl_states.at(slot) = tl_states.at(last_slot);
+    static_attributes.at(slot) = static_attributes.at(last_slot);
+    actor_slot_map.at(moved_actor_id) = slot;
+  }
+  actor_ids.pop_back();
+  locations.pop_back();
+  rotations.pop_back();
+  velocities.pop_back();
+  speed_limits.pop_back();
+  physics_enabled_flags.pop_back();
+  tl_states.pop_back();
+  static_attributes.pop_back();
+  actor_slot_map.erase(slot_entry);
 }
 
 void SimulationState::Reset() {
-  actor_set.clear();
-  kinematic_state_map.clear();
-  static_attribute_map.clear();
-  tl_state_map.clear();
+  actor_slot_map.clear();
+  actor_ids.clear();
+  locations.clear();
+  rotations.clear();
+  velocities.clear();
+  speed_limits.clear();
+  physics_enabled_flags.clear();
+  tl_states.clear();
+  static_attributes.clear();
 }
 
 void SimulationState::UpdateKinematicState(ActorId actor_id, KinematicState state) {
-  kinematic_state_map.at(actor_id) = state;
+  const uint64_t slot = actor_slot_map.at(actor_id);
+  locations.at(slot) = state.location;
+  rotations.at(slot) = state.rotation;
+  velocities.at(slot) = state.velocity;
+  speed_limits.at(slot) = state.speed_limit;
+  physics_enabled_flags.at(slot) = state.physics_enabled ? 1u : 0u;
 }
 
 void SimulationState::UpdateTrafficLightState(ActorId actor_id, TrafficLightState state) {
-  tl_state_map.at(actor_id) = state;
+  tl_states.at(actor_slot_map.at(actor_id)) = state;
 }
 
 cg::Location SimulationState::GetLocation(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).location;
+  return locations.at(actor_slot_map.at(actor_id));
 }
 
 cg::Rotation SimulationState::GetRotation(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).rotation;
+  return rotations.at(actor_slot_map.at(actor_id));
 }
 
 cg::Vector3D SimulationState::GetHeading(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).rotation.GetForwardVector();
+  return rotations.at(actor_slot_map.at(actor_id)).GetForwardVector();
 }
 
 cg::Vector3D SimulationState::GetVelocity(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).velocity;
+  return velocities.at(actor_slot_map.at(actor_id));
 }
 
 float SimulationState::GetSpeedLimit(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).speed_limit;
+  return speed_limits.at(actor_slot_map.at(actor_id));
 }
 
 bool SimulationState::IsPhysicsEnabled(ActorId actor_id) const {
-  return kinematic_state_map.at(actor_id).physics_enabled;
+  return physics_enabled_flags.at(actor_slot_map.at(actor_id)) != 0u;
 }
 
 TrafficLightState SimulationState::GetTLS(ActorId actor_id) const {
-  return tl_state_map.at(actor_id);
+  return tl_states.at(actor_slot_map.at(actor_id));
 }
 
 ActorType SimulationState::GetType(ActorId actor_id) const {
-  return static_attribute_map.at(actor_id).actor_type;
+  return static_attributes.at(actor_slot_map.at(actor_id)).actor_type;
 }
 
 cg::Vector3D SimulationState::GetDimensions(ActorId actor_id) const {
-  const StaticAttributes &attributes = static_attribute_map.at(actor_id);
+  const StaticAttributes &attributes = static_attributes.at(actor_slot_map.at(actor_id));
   return cg::Vector3D(attributes.half_length, attributes.half_width, attributes.half_height);
 }
 
+void SimulationState::GetSquaredDistancesToPoint(const cg::Location &point,
+                                                 std::vector<ActorId> &actor_id_list,
+                                                 std::vector<float> &squared_distances) const {
+  const uint64_t number_of_actors = actor_ids.size();
+  actor_id_list.assign(actor_ids.begin(), actor_ids.end());
+  squared_distances.resize(number_of_actors);
+  // Plain indexed loop over the contiguous location array; the compiler is
+  // free to vectorize it.
+  for (uint64_t slot = 0u; slot < number_of_actors; ++slot) {
+    const cg::Location &location = locations[slot];
+    const float dx = location.x - point.x;
+    const float dy = location.y - point.y;
+    const float dz = location.z - point.z;
+    squared_distances[slot] = dx * dx + dy * dy + dz * dz;
+  }
+}
+
 } // namespace  traffic_manager
 } // namespace carla
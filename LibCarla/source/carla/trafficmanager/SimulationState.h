@@ -1,7 +1,8 @@
 
 #pragma once
 
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "carla/trafficmanager/DataStructures.h"
 
@@ -21,13 +22,11 @@ struct KinematicState {
   float speed_limit;
   bool physics_enabled;
 };
-using KinematicStateMap = std::unordered_map<ActorId, KinematicState>;
 
 struct TrafficLightState {
   TLS tl_state;
   bool at_traffic_light;
 };
-using TrafficLightStateMap = std::unordered_map<ActorId, TrafficLightState>;
 
 struct StaticAttributes {
   ActorType actor_type;
@@ -35,20 +34,28 @@ struct StaticAttributes {
   float half_width;
   float half_height;
 };
-using StaticAttributeMap = std::unordered_map<ActorId, StaticAttributes>;
 
 /// This class holds the state of all the vehicles in the simlation.
+/// State is stored as structure-of-arrays indexed by a dense slot per actor,
+/// so per-stage scans walk contiguous memory instead of chasing hash map
+/// nodes, and the compiler can vectorize bulk queries over the arrays.
 class SimulationState {
 
 private:
-  // Structure to hold ids of all actors in the simulation.
-  std::unordered_set<ActorId> actor_set;
-  // Structure containing dynamic motion related state of actors.
-  KinematicStateMap kinematic_state_map;
-  // Structure containing static attributes of actors.
-  StaticAttributeMap static_attribute_map;
-  // Structure containing dynamic traffic light related state of actors.
-  TrafficLightStateMap tl_state_map;
+  // Mapping from actor id to its slot in the state arrays.
+  std::unordered_map<ActorId, uint64_t> actor_slot_map;
+  // Actor id occupying each slot, for swap-removal bookkeeping.
+  std::vector<ActorId> actor_ids;
+  // Dynamic motion related state of actors, one array per field.
+  std::vector<cg::Location> locations;
+  std::vector<cg::Rotation> rotations;
+  std::vector<cg::Vector3D> velocities;
+  std::vector<float> speed_limits;
+  std::vector<uint8_t> physics_enabled_flags;
+  // Dynamic traffic light related state of actors.
+  std::vector<TrafficLightState> tl_states;
+  // Static attributes of actors.
+  std::vector<StaticAttributes> static_attributes;
 
 public :
   SimulationState();
@@ -63,6 +70,7 @@ public :
   bool ContainsActor(ActorId actor_id) const;
 
   // Method to remove an actor from simulation state.
+  // The last slot is swapped into the freed one, so slots stay dense.
   void RemoveActor(ActorId actor_id);
 
   // Method to flush all states and actors.
@@ -90,6 +98,13 @@ public :
 
   cg::Vector3D GetDimensions(const ActorId actor_id) const;
 
+  // Method to compute squared distances from every actor to a point in one
+  // pass over the location array. Results are ordered by slot; the actor id
+  // of each slot is written to actor_id_list.
+  void GetSquaredDistancesToPoint(const cg::Location &point,
+                                  std::vector<ActorId> &actor_id_list,
+                                  std::vector<float> &squared_distances) const;
+
 };
 
 } // namespace traffic_manager
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "carla/rpc/ActorId.h"
+#include "carla/trafficmanager/TickArena.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -23,6 +24,15 @@ public:
     virtual void RemoveActor(const ActorId actor_id) = 0;
     // This method should flush all internal state of the state type.
     virtual void Reset() = 0;
+
+    // Arena for transient state rebuilt during Update; rewound by the owner
+    // between cycles.
+    void SetTickArena(TickArena *arena) {
+        tick_arena = arena;
+    }
+
+protected:
+    TickArena *tick_arena = nullptr;
 };
 
 } // namespace traffic_manager
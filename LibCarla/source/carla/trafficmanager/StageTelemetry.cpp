@@ -0,0 +1,130 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include <algorithm>
+#include <cmath>
+
+#include "carla/trafficmanager/Constants.h"
+#include "carla/trafficmanager/StageTelemetry.h"
+
+namespace carla {
+namespace traffic_manager {
+
+using constants::Telemetry::TELEMETRY_WINDOW_SIZE;
+
+namespace {
+
+static const std::vector<std::string> STAGE_NAMES = {
+  "ALSM",
+  "Localization",
+  "Collision",
+  "TrafficLight+MotionPlan",
+  "SendCommands"
+};
+
+/// Value below which @a fraction of the samples fall; samples are partially
+/// sorted in place.
+float Percentile(std::vector<float> &samples, const float fraction) {
+  if (samples.empty()) {
+    return 0.0f;
+  }
+  const uint64_t rank = std::min(samples.size() - 1u,
+                                 static_cast<uint64_t>(fraction * static_cast<float>(samples.size())));
+  std::nth_element(samples.begin(), samples.begin() + static_cast<long>(rank), samples.end());
+  return samples.at(rank);
+}
+
+} // namespace
+
+StageTelemetry::StageTelemetry()
+  : duration_rings(TelemetryStage::SIZE, std::vector<float>(TELEMETRY_WINDOW_SIZE, 0.0f)),
+    actor_count_ring(TELEMETRY_WINDOW_SIZE, 0u) {}
+
+void StageTelemetry::RecordStageDuration(const uint64_t stage_index,
+                                         const TimePoint start_time,
+                                         const TimePoint end_time) {
+  const chr::duration<float, std::milli> duration = end_time - start_time;
+  std::lock_guard<std::mutex> lock(telemetry_mutex);
+  duration_rings.at(stage_index).at(tick_count % TELEMETRY_WINDOW_SIZE) = duration.count();
+}
+
+void StageTelemetry::RecordTick(const uint64_t actor_count) {
+  std::lock_guard<std::mutex> lock(telemetry_mutex);
+  actor_count_ring.at(tick_count % TELEMETRY_WINDOW_SIZE) = actor_count;
+  ++tick_count;
+}
+
+TrafficManagerStats StageTelemetry::GetStats() const {
+  std::lock_guard<std::mutex> lock(telemetry_mutex);
+
+  TrafficManagerStats stats;
+  stats.total_ticks = tick_count;
+  const uint64_t window = std::min(tick_count, TELEMETRY_WINDOW_SIZE);
+  if (window == 0u) {
+    return stats;
+  }
+
+  float actor_count_sum = 0.0f;
+  for (uint64_t i = 0u; i < window; ++i) {
+    actor_count_sum += static_cast<float>(actor_count_ring.at(i));
+    stats.max_actor_count = std::max(stats.max_actor_count, actor_count_ring.at(i));
+  }
+  const float mean_actor_count = actor_count_sum / static_cast<float>(window);
+  stats.mean_actor_count = mean_actor_count;
+
+  for (uint64_t stage_index = 0u; stage_index < TelemetryStage::SIZE; ++stage_index) {
+    const std::vector<float> &ring = duration_rings.at(stage_index);
+    std::vector<float> samples(ring.begin(), ring.begin() + static_cast<long>(window));
+
+    StageStats stage_stats;
+    stage_stats.stage_name = STAGE_NAMES.at(stage_index);
+    stage_stats.sample_count = window;
+
+    float duration_sum = 0.0f;
+    for (const float sample : samples) {
+      duration_sum += sample;
+      stage_stats.max_duration_ms = std::max(stage_stats.max_duration_ms, sample);
+    }
+    const float mean_duration = duration_sum / static_cast<float>(window);
+    stage_stats.mean_duration_ms = mean_duration;
+
+    // Pearson correlation between duration and actor count.
+    float covariance = 0.0f;
+    float duration_variance = 0.0f;
+    float actor_count_variance = 0.0f;
+    for (uint64_t i = 0u; i < window; ++i) {
+      const float duration_deviation = samples.at(i) - mean_duration;
+      const float actor_count_deviation = static_cast<float>(actor_count_ring.at(i)) - mean_actor_count;
+      covariance += duration_deviation * actor_count_deviation;
+      duration_variance += duration_deviation * duration_deviation;
+      actor_count_variance += actor_count_deviation * actor_count_deviation;
+    }
+    const float variance_product = duration_variance * actor_count_variance;
+    if (variance_product > 0.0f) {
+      stage_stats.actor_count_correlation = covariance / std::sqrt(variance_product);
+    }
+
+    stage_stats.p50_duration_ms = Percentile(samples, 0.50f);
+    stage_stats.p90_duration_ms = Percentile(samples, 0.90f);
+    stage_stats.p99_duration_ms = Percentile(samples, 0.99f);
+
+    stats.stages.push_back(std::move(stage_stats));
+  }
+
+  return stats;
+}
+
+void StageTelemetry::Reset() {
+  std::lock_guard<std::mutex> lock(telemetry_mutex);
+  for (std::vector<float> &ring : duration_rings) {
+    std::fill(ring.begin(), ring.end(), 0.0f);
+  }
+  std::fill(actor_count_ring.begin(), actor_count_ring.end(), 0u);
+  tick_count = 0u;
+}
+
+} // namespace traffic_manager
+} // namespace carla
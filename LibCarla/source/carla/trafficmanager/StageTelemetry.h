@@ -0,0 +1,105 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "carla/MsgPack.h"
+
+namespace carla {
+namespace traffic_manager {
+
+namespace chr = std::chrono;
+using TimePoint = chr::time_point<chr::system_clock, chr::nanoseconds>;
+
+/// Indexes of the update cycle phases instrumented by the traffic manager.
+namespace TelemetryStage {
+enum Stage : uint64_t {
+  ALSM = 0u,
+  LOCALIZATION = 1u,
+  COLLISION = 2u,
+  TRAFFIC_LIGHT_MOTION_PLAN = 3u,
+  SEND_COMMANDS = 4u,
+  SIZE = 5u
+};
+} // namespace TelemetryStage
+
+/// Execution statistics of one update cycle phase over the sampling window.
+struct StageStats {
+  std::string stage_name;
+  /// Number of ticks in the sampling window.
+  uint64_t sample_count = 0u;
+  float mean_duration_ms = 0.0f;
+  float p50_duration_ms = 0.0f;
+  float p90_duration_ms = 0.0f;
+  float p99_duration_ms = 0.0f;
+  float max_duration_ms = 0.0f;
+  /// Pearson correlation between the stage duration and the number of
+  /// vehicles processed, over the sampling window. Values near 1 indicate
+  /// the stage scales with fleet size; values near 0 point at a cost that
+  /// does not.
+  float actor_count_correlation = 0.0f;
+
+  MSGPACK_DEFINE_ARRAY(stage_name, sample_count, mean_duration_ms, p50_duration_ms,
+                       p90_duration_ms, p99_duration_ms, max_duration_ms,
+                       actor_count_correlation);
+};
+
+/// Per-stage execution statistics of the traffic manager update cycle,
+/// as answered by TrafficManager::GetStats.
+struct TrafficManagerStats {
+  /// Ticks completed since the traffic manager started.
+  uint64_t total_ticks = 0u;
+  float mean_actor_count = 0.0f;
+  uint64_t max_actor_count = 0u;
+  std::vector<StageStats> stages;
+
+  MSGPACK_DEFINE_ARRAY(total_ticks, mean_actor_count, max_actor_count, stages);
+};
+
+/// Always-on instrumentation of the traffic manager update cycle. The update
+/// loop records the wall-clock duration of each stage into a fixed ring per
+/// stage; percentiles and actor-count correlation are computed on demand when
+/// the statistics are queried, so the recording path stays cheap.
+class StageTelemetry {
+
+private:
+  /// One duration ring per stage, in milliseconds, holding the last
+  /// TELEMETRY_WINDOW_SIZE ticks.
+  std::vector<std::vector<float>> duration_rings;
+  /// Number of vehicles processed on each tick of the window.
+  std::vector<uint64_t> actor_count_ring;
+  /// Ticks completed so far; also the ring write position modulo window size.
+  uint64_t tick_count {0u};
+  /// Guards the rings; the update loop writes a handful of samples per tick
+  /// while GetStats may read from an RPC thread.
+  mutable std::mutex telemetry_mutex;
+
+public:
+  StageTelemetry();
+
+  /// Records the wall-clock duration of one stage of the tick in progress.
+  void RecordStageDuration(const uint64_t stage_index,
+                           const TimePoint start_time,
+                           const TimePoint end_time);
+
+  /// Closes the tick in progress, correlating its samples with the number of
+  /// vehicles processed.
+  void RecordTick(const uint64_t actor_count);
+
+  /// Computes statistics over the sampling window.
+  TrafficManagerStats GetStats() const;
+
+  /// Discards all recorded samples.
+  void Reset();
+};
+
+} // namespace traffic_manager
+} // namespace carla
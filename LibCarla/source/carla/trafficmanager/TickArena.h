@@ -0,0 +1,128 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace carla {
+namespace traffic_manager {
+
+/// A bump allocator for transient per-tick stage data.
+///
+/// Allocation is a pointer increment into a chunk; nothing is freed
+/// individually. Reset rewinds every chunk at the start of a cycle, keeping
+/// the memory for reuse, so the boundaries and candidate lists the stages
+/// rebuild per vehicle per tick stop going through malloc.
+///
+/// @warning Anything allocated from the arena must not be kept across a call
+/// to Reset; per-cycle caches must be cleared before the next cycle begins.
+class TickArena {
+
+public:
+
+  /// Default size of each chunk of memory.
+  static constexpr std::size_t CHUNK_SIZE = 1024u * 1024u;
+
+  void *Allocate(std::size_t bytes, std::size_t alignment) {
+    while (active_chunk < chunks.size()) {
+      Chunk &chunk = chunks[active_chunk];
+      const std::size_t aligned = (chunk.used + alignment - 1u) & ~(alignment - 1u);
+      if (aligned + bytes <= chunk.size) {
+        chunk.used = aligned + bytes;
+        return chunk.data.get() + aligned;
+      }
+      ++active_chunk;
+    }
+    const std::size_t size = std::max(CHUNK_SIZE, bytes + alignment);
+    chunks.push_back(Chunk{std::make_unique<unsigned char[]>(size), size, bytes});
+    active_chunk = chunks.size() - 1u;
+    return chunks.back().data.get();
+  }
+
+  /// Rewind every chunk, keeping the memory for the next cycle.
+  void Reset() {
+    for (Chunk &chunk : chunks) {
+      chunk.used = 0u;
+    }
+    active_chunk = 0u;
+  }
+
+  /// Arena picked up by default-constructed ArenaAllocators on this thread,
+  /// or nullptr to fall back to the heap.
+  static TickArena *&Current() {
+    static thread_local TickArena *current = nullptr;
+    return current;
+  }
+
+  void MakeCurrent() {
+    Current() = this;
+  }
+
+private:
+
+  struct Chunk {
+    std::unique_ptr<unsigned char[]> data;
+    std::size_t size;
+    std::size_t used;
+  };
+
+  std::vector<Chunk> chunks;
+  std::size_t active_chunk = 0u;
+};
+
+/// Standard allocator adaptor over TickArena. Default construction binds to
+/// TickArena::Current so existing container declarations only need their
+/// alias changed; with no current arena it degrades to the heap.
+template <typename T>
+class ArenaAllocator {
+
+public:
+
+  using value_type = T;
+
+  ArenaAllocator() : arena(TickArena::Current()) {}
+
+  explicit ArenaAllocator(TickArena *arena) : arena(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &rhs) : arena(rhs.arena) {}
+
+  T *allocate(std::size_t n) {
+    if (arena != nullptr) {
+      return static_cast<T *>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+    // Arena memory is reclaimed wholesale by TickArena::Reset.
+    if (arena == nullptr) {
+      ::operator delete(ptr);
+    }
+  }
+
+  TickArena *arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) {
+  return lhs.arena == rhs.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace traffic_manager
+} // namespace carla
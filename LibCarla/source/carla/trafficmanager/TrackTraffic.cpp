@@ -8,6 +8,7 @@ namespace traffic_manager {
 
 using constants::TrackTraffic::BUFFER_STEP_THROUGH;
 using constants::TrackTraffic::INV_BUFFER_STEP_THROUGH;
+using constants::TrackTraffic::INV_POSITION_GRID_CELL_SIZE;
 
 TrackTraffic::TrackTraffic() {}
 
@@ -16,7 +17,7 @@ void TrackTraffic::UpdateUnregisteredGridPosition(const ActorId actor_id,
 
     DeleteActor(actor_id);
 
-    std::unordered_set<GeoGridId> current_grids;
+    SmallIdSet<GeoGridId> current_grids;
     // Step through waypoints and update grid list for actor and actor list for grids.
     for (auto &waypoint : waypoints) {
         UpdatePassingVehicle(waypoint->GetId(), actor_id);
@@ -24,67 +25,85 @@ void TrackTraffic::UpdateUnregisteredGridPosition(const ActorId actor_id,
         GeoGridId ggid = waypoint->GetGeodesicGridId();
         current_grids.insert(ggid);
 
-        if (grid_to_actors.find(ggid) != grid_to_actors.end()) {
-            ActorIdSet &actor_ids = grid_to_actors.at(ggid);
-            if (actor_ids.find(actor_id) == actor_ids.end()) {
-                actor_ids.insert(actor_id);
-            }
-        } else {
-            grid_to_actors.insert({ggid, {actor_id}});
-        }
+        grid_to_actors[ggid].insert(actor_id);
     }
 
-    actor_to_grids.insert({actor_id, current_grids});
+    actor_to_grids[actor_id] = current_grids;
 }
 
 void TrackTraffic::UpdateGridPosition(const ActorId actor_id, const Buffer &buffer) {
     if (!buffer.empty()) {
 
         // Clear current actor from all grids containing itself.
-        if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
-            std::unordered_set<GeoGridId> &current_grids = actor_to_grids.at(actor_id);
-            for (auto &grid_id : current_grids) {
-                if (grid_to_actors.find(grid_id) != grid_to_actors.end()) {
-                    ActorIdSet &actor_ids = grid_to_actors.at(grid_id);
-                    actor_ids.erase(actor_id);
+        if (SmallIdSet<GeoGridId> *old_grids = actor_to_grids.Find(actor_id)) {
+            for (const GeoGridId &grid_id : *old_grids) {
+                if (TrackedActorSet *actor_ids = grid_to_actors.Find(grid_id)) {
+                    actor_ids->erase(actor_id);
                 }
             }
 
-            actor_to_grids.erase(actor_id);
+            actor_to_grids.Erase(actor_id);
         }
 
         // Step through buffer and update grid list for actor and actor list for grids.
-        std::unordered_set<GeoGridId> current_grids;
+        SmallIdSet<GeoGridId> current_grids;
         uint64_t buffer_size = buffer.size();
         uint64_t step_size = static_cast<uint64_t>(static_cast<float>(buffer_size) * INV_BUFFER_STEP_THROUGH);
         for (uint64_t i = 0u; i <= BUFFER_STEP_THROUGH; ++i) {
             GeoGridId ggid = buffer.at(std::min(i * step_size, buffer_size - 1u))->GetGeodesicGridId();
             current_grids.insert(ggid);
 
-            // Add grid entry if not present.
-            if (grid_to_actors.find(ggid) == grid_to_actors.end()) {
-                grid_to_actors.insert({ggid, {}});
-            }
+            grid_to_actors[ggid].insert(actor_id);
+        }
+
+        actor_to_grids[actor_id] = current_grids;
+    }
+}
+
+uint64_t TrackTraffic::PositionGridKey(float x, float y) {
+    const int32_t cell_x = static_cast<int32_t>(std::floor(x * INV_POSITION_GRID_CELL_SIZE));
+    const int32_t cell_y = static_cast<int32_t>(std::floor(y * INV_POSITION_GRID_CELL_SIZE));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cell_x)) << 32)
+           | static_cast<uint64_t>(static_cast<uint32_t>(cell_y));
+}
+
+void TrackTraffic::ClearPositionGrid() {
+    position_grid.Clear();
+}
+
+void TrackTraffic::UpdatePosition(ActorId actor_id, const cg::Location &location) {
+    position_grid[PositionGridKey(location.x, location.y)].insert(actor_id);
+}
 
-            ActorIdSet &actor_ids = grid_to_actors.at(ggid);
-            if (actor_ids.find(actor_id) == actor_ids.end()) {
-                actor_ids.insert(actor_id);
+TrackedActorSet TrackTraffic::GetNearbyActors(const cg::Location &location, float radius) const {
+    TrackedActorSet actor_id_set;
+
+    const float cell_size = 1.0f / INV_POSITION_GRID_CELL_SIZE;
+    const int32_t cell_span = static_cast<int32_t>(std::ceil(radius * INV_POSITION_GRID_CELL_SIZE));
+    for (int32_t dx = -cell_span; dx <= cell_span; ++dx) {
+        for (int32_t dy = -cell_span; dy <= cell_span; ++dy) {
+            const uint64_t key = PositionGridKey(location.x + static_cast<float>(dx) * cell_size,
+                                                 location.y + static_cast<float>(dy) * cell_size);
+            if (const TrackedActorSet *cell = position_grid.Find(key)) {
+                for (const ActorId &id : *cell) {
+                    actor_id_set.insert(id);
+                }
             }
         }
-
-        actor_to_grids.insert({actor_id, current_grids});
     }
+
+    return actor_id_set;
 }
 
-ActorIdSet TrackTraffic::GetOverlappingVehicles(ActorId actor_id) const {
-    ActorIdSet actor_id_set;
+TrackedActorSet TrackTraffic::GetOverlappingVehicles(ActorId actor_id) const {
+    TrackedActorSet actor_id_set;
 
-    if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
-        const std::unordered_set<GeoGridId> &grid_ids = actor_to_grids.at(actor_id);
-        for (auto &grid_id : grid_ids) {
-            if (grid_to_actors.find(grid_id) != grid_to_actors.end()) {
-                const ActorIdSet &actor_ids = grid_to_actors.at(grid_id);
-                actor_id_set.insert(actor_ids.begin(), actor_ids.end());
+    if (const SmallIdSet<GeoGridId> *grid_ids = actor_to_grids.Find(actor_id)) {
+        for (const GeoGridId &grid_id : *grid_ids) {
+            if (const TrackedActorSet *actor_ids = grid_to_actors.Find(grid_id)) {
+                for (const ActorId &id : *actor_ids) {
+                    actor_id_set.insert(id);
+                }
             }
         }
     }
@@ -93,19 +112,18 @@ ActorIdSet TrackTraffic::GetOverlappingVehicles(ActorId actor_id) const {
 }
 
 void TrackTraffic::DeleteActor(ActorId actor_id) {
-    if (actor_to_grids.find(actor_id) != actor_to_grids.end()) {
-        std::unordered_set<GeoGridId> &grid_ids = actor_to_grids.at(actor_id);
-        for (auto &grid_id : grid_ids) {
-            if (grid_to_actors.find(grid_id) != grid_to_actors.end()) {
-                ActorIdSet &actor_ids = grid_to_actors.at(grid_id);
-                actor_ids.erase(actor_id);
-                }
+    if (SmallIdSet<GeoGridId> *grid_ids = actor_to_grids.Find(actor_id)) {
+        for (const GeoGridId &grid_id : *grid_ids) {
+            if (TrackedActorSet *actor_ids = grid_to_actors.Find(grid_id)) {
+                actor_ids->erase(actor_id);
             }
-        actor_to_grids.erase(actor_id);
+        }
+        actor_to_grids.Erase(actor_id);
     }
 
-    if (waypoint_occupied.find(actor_id) != waypoint_occupied.end()) {
-        WaypointIdSet waypoint_id_set = waypoint_occupied.at(actor_id);
+    if (const WaypointIdSet *occupied = waypoint_occupied.Find(actor_id)) {
+        // Copied, RemovePassingVehicle mutates the set being walked.
+        WaypointIdSet waypoint_id_set = *occupied;
         for (const uint64_t &waypoint_id : waypoint_id_set) {
             RemovePassingVehicle(waypoint_id, actor_id);
         }
@@ -113,59 +131,41 @@ void TrackTraffic::DeleteActor(ActorId actor_id) {
 }
 
 void TrackTraffic::UpdatePassingVehicle(uint64_t waypoint_id, ActorId actor_id) {
-    if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
-        ActorIdSet &actor_id_set = waypoint_overlap_tracker.at(waypoint_id);
-        if (actor_id_set.find(actor_id) == actor_id_set.end()) {
-            actor_id_set.insert(actor_id);
-        }
-    } else {
-        waypoint_overlap_tracker.insert({waypoint_id, {actor_id}});
-    }
-
-    if (waypoint_occupied.find(actor_id) != waypoint_occupied.end()) {
-        WaypointIdSet &waypoint_id_set = waypoint_occupied.at(actor_id);
-        if (waypoint_id_set.find(waypoint_id) == waypoint_id_set.end()) {
-            waypoint_id_set.insert(waypoint_id);
-        }
-    } else {
-        waypoint_occupied.insert({actor_id, {waypoint_id}});
-    }
+    waypoint_overlap_tracker[waypoint_id].insert(actor_id);
+    waypoint_occupied[actor_id].insert(waypoint_id);
 }
 
 void TrackTraffic::RemovePassingVehicle(uint64_t waypoint_id, ActorId actor_id) {
-    if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
-        ActorIdSet &actor_id_set = waypoint_overlap_tracker.at(waypoint_id);
-        actor_id_set.erase(actor_id);
+    if (TrackedActorSet *actor_id_set = waypoint_overlap_tracker.Find(waypoint_id)) {
+        actor_id_set->erase(actor_id);
 
-        if (actor_id_set.size() == 0) {
-            waypoint_overlap_tracker.erase(waypoint_id);
+        if (actor_id_set->empty()) {
+            waypoint_overlap_tracker.Erase(waypoint_id);
         }
     }
 
-    if (waypoint_occupied.find(actor_id) != waypoint_occupied.end()) {
-        WaypointIdSet &waypoint_id_set = waypoint_occupied.at(actor_id);
-        waypoint_id_set.erase(waypoint_id);
+    if (WaypointIdSet *waypoint_id_set = waypoint_occupied.Find(actor_id)) {
+        waypoint_id_set->erase(waypoint_id);
 
-        if (waypoint_id_set.size() == 0) {
-            waypoint_occupied.erase(actor_id);
+        if (waypoint_id_set->empty()) {
+            waypoint_occupied.Erase(actor_id);
         }
     }
 }
 
-ActorIdSet TrackTraffic::GetPassingVehicles(uint64_t waypoint_id) const {
+const TrackedActorSet &TrackTraffic::GetPassingVehicles(uint64_t waypoint_id) const {
+    static const TrackedActorSet empty_set{};
 
-    if (waypoint_overlap_tracker.find(waypoint_id) != waypoint_overlap_tracker.end()) {
-        return waypoint_overlap_tracker.at(waypoint_id);
-    } else {
-        return ActorIdSet();
-    }
+    const TrackedActorSet *actor_id_set = waypoint_overlap_tracker.Find(waypoint_id);
+    return (actor_id_set != nullptr) ? *actor_id_set : empty_set;
 }
 
 void TrackTraffic::Clear() {
-    waypoint_overlap_tracker.clear();
-    waypoint_occupied.clear();
-    actor_to_grids.clear();
-    grid_to_actors.clear();
+    waypoint_overlap_tracker.Clear();
+    waypoint_occupied.Clear();
+    position_grid.Clear();
+    actor_to_grids.Clear();
+    grid_to_actors.Clear();
 }
 
 } // namespace traffic_manager
@@ -1,9 +1,12 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "carla/road/RoadTypes.h"
 #include "carla/rpc/ActorId.h"
 
+#include "carla/trafficmanager/FlatContainers.h"
 #include "carla/trafficmanager/SimpleWaypoint.h"
 
 namespace carla {
@@ -15,23 +18,33 @@ using SimpleWaypointPtr = std::shared_ptr<SimpleWaypoint>;
 using Buffer = std::deque<SimpleWaypointPtr>;
 using GeoGridId = carla::road::JuncId;
 
+/// Small sorted set of the actor ids tracked against one waypoint, grid or
+/// position cell; most of them hold fewer than a handful of ids.
+using TrackedActorSet = SmallIdSet<ActorId>;
+
 // This class is used to track the waypoint occupancy of all the actors.
 class TrackTraffic {
 
 private:
     /// Structure to keep track of overlapping waypoints between vehicles.
-    using WaypointOverlap = std::unordered_map<uint64_t, ActorIdSet>;
+    using WaypointOverlap = FlatHashMap<uint64_t, TrackedActorSet>;
     WaypointOverlap waypoint_overlap_tracker;
 
     /// Structure to keep track of waypoints occupied by vehicles;
-    using WaypointIdSet = std::unordered_set<uint64_t>;
-    using WaypointOccupancyMap = std::unordered_map<ActorId, WaypointIdSet>;
+    using WaypointIdSet = SmallIdSet<uint64_t, 8u>;
+    using WaypointOccupancyMap = FlatHashMap<ActorId, WaypointIdSet>;
     WaypointOccupancyMap waypoint_occupied;
 
     /// Geodesic grids occupied by actors's paths.
-    std::unordered_map<ActorId, std::unordered_set<GeoGridId>> actor_to_grids;
+    FlatHashMap<ActorId, SmallIdSet<GeoGridId>> actor_to_grids;
     /// Actors currently passing through grids.
-    std::unordered_map<GeoGridId, ActorIdSet> grid_to_actors;
+    FlatHashMap<GeoGridId, TrackedActorSet> grid_to_actors;
+    /// Uniform spatial hash over current actor positions, rebuilt every
+    /// update cycle.
+    FlatHashMap<uint64_t, TrackedActorSet> position_grid;
+
+    /// Key of the position grid cell containing a location.
+    static uint64_t PositionGridKey(float x, float y);
 
 public:
     TrackTraffic();
@@ -39,13 +52,23 @@ public:
     /// Methods to update, remove and retrieve vehicles passing through a waypoint.
     void UpdatePassingVehicle(uint64_t waypoint_id, ActorId actor_id);
     void RemovePassingVehicle(uint64_t waypoint_id, ActorId actor_id);
-    ActorIdSet GetPassingVehicles(uint64_t waypoint_id) const;
+    const TrackedActorSet &GetPassingVehicles(uint64_t waypoint_id) const;
 
     void UpdateGridPosition(const ActorId actor_id, const Buffer &buffer);
     void UpdateUnregisteredGridPosition(const ActorId actor_id,
                                         const std::vector<SimpleWaypointPtr> waypoints);
 
-    ActorIdSet GetOverlappingVehicles(ActorId actor_id) const;
+    TrackedActorSet GetOverlappingVehicles(ActorId actor_id) const;
+
+    /// Methods maintaining the spatial hash over actor positions. The grid is
+    /// cleared and repopulated from scratch once per update cycle.
+    void ClearPositionGrid();
+    void UpdatePosition(ActorId actor_id, const cg::Location &location);
+    /// Returns the ids of all actors hashed within @a radius of @a location.
+    /// The result is conservative: every actor within the radius is included,
+    /// along with some others from the surrounding cells.
+    TrackedActorSet GetNearbyActors(const cg::Location &location, float radius) const;
+
     /// Method to delete actor data from tracking.
     void DeleteActor(ActorId actor_id);
 
@@ -34,7 +34,7 @@ void TrafficLightStage::Update(const unsigned long index) {
   const SimpleWaypointPtr look_ahead_point = GetTargetWaypoint(waypoint_buffer, JUNCTION_LOOK_AHEAD).first;
 
   const JunctionID junction_id = look_ahead_point->GetWaypoint()->GetJunctionId();
-  current_timestamp = world.GetSnapshot().GetTimestamp();
+  const cc::Timestamp current_timestamp = world.GetSnapshot().GetTimestamp();
 
   const TrafficLightState tl_state = simulation_state.GetTLS(ego_actor_id);
   const TLS traffic_light_state = tl_state.tl_state;
@@ -67,6 +67,10 @@ bool TrafficLightStage::HandleNonSignalisedJunction(const ActorId ego_actor_id,
 
   bool traffic_light_hazard = false;
 
+  // Ticket issuing arbitrates junction entry between vehicles, so it has to
+  // stay atomic when vehicle shards run concurrently.
+  std::lock_guard<std::mutex> guard(junction_mutex);
+
   if (vehicle_last_junction.find(ego_actor_id) == vehicle_last_junction.end()) {
     // Initializing new map entry for the actor with
     // an arbitrary and different junction id.
@@ -127,11 +131,13 @@ bool TrafficLightStage::HandleNonSignalisedJunction(const ActorId ego_actor_id,
 }
 
 void TrafficLightStage::RemoveActor(const ActorId actor_id) {
+  std::lock_guard<std::mutex> guard(junction_mutex);
   vehicle_last_ticket.erase(actor_id);
   vehicle_last_junction.erase(actor_id);
 }
 
 void TrafficLightStage::Reset() {
+  std::lock_guard<std::mutex> guard(junction_mutex);
   vehicle_last_ticket.clear();
   vehicle_last_junction.clear();
   junction_last_ticket.clear();
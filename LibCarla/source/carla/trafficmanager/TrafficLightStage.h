@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "carla/trafficmanager/DataStructures.h"
 #include "carla/trafficmanager/Parameters.h"
 #include "carla/trafficmanager/RandomGenerator.h"
@@ -25,9 +27,11 @@ private:
   std::unordered_map<JunctionID, cc::Timestamp> junction_last_ticket;
   /// Map containing the previous junction visited by a vehicle.
   std::unordered_map<ActorId, JunctionID> vehicle_last_junction;
+  /// Guards the ticket maps; vehicle shards of this stage run concurrently
+  /// and negotiate junction entry through shared per-junction tickets.
+  std::mutex junction_mutex;
   TLFrame &output_array;
   RandomGeneratorMap &random_devices;
-  cc::Timestamp current_timestamp;
 
   bool HandleNonSignalisedJunction(const ActorId ego_actor_id, const JunctionID junction_id,
                                    cc::Timestamp timestamp);
@@ -197,6 +197,16 @@ public:
     }
   }
 
+  /// Method to switch traffic manager into pipelined synchronous execution.
+  /// Stage computation then overlaps the simulator's tick, at the cost of one
+  /// frame of control latency.
+  void SetPipelinedMode(bool mode) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetPipelinedMode(mode);
+    }
+  }
+
   /// Method to set tick timeout for synchronous execution.
   void SetSynchronousModeTimeOutInMiliSecond(double time) {
     TrafficManagerBase* tm_ptr = GetTM(_port);
@@ -238,6 +248,25 @@ public:
     }
   }
 
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode, making draws reproducible independently of how the
+  /// stages are scheduled.
+  void SetDeterministicStreams(const bool mode_switch) {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      tm_ptr->SetDeterministicStreams(mode_switch);
+    }
+  }
+
+  /// Method to query per-stage execution statistics of the update cycle.
+  TrafficManagerStats GetStats() {
+    TrafficManagerBase* tm_ptr = GetTM(_port);
+    if(tm_ptr != nullptr){
+      return tm_ptr->GetStats();
+    }
+    return TrafficManagerStats();
+  }
+
 private:
 
   void CreateTrafficManagerServer(
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include "carla/client/Actor.h"
+#include "carla/trafficmanager/StageTelemetry.h"
 
 namespace carla {
 namespace traffic_manager {
@@ -80,6 +81,11 @@ public:
   /// Method to switch traffic manager into synchronous execution.
   virtual void SetSynchronousMode(bool mode) = 0;
 
+  /// Method to switch traffic manager into pipelined synchronous execution,
+  /// overlapping stage computation with the simulator's tick at the cost of
+  /// one frame of control latency.
+  virtual void SetPipelinedMode(bool mode) = 0;
+
   /// Method to set Tick timeout for synchronous execution.
   virtual void SetSynchronousModeTimeOutInMiliSecond(double time) = 0;
 
@@ -106,9 +112,16 @@ public:
 
   /// Method to set randomization seed.
   virtual void SetRandomDeviceSeed(const uint64_t seed) = 0;
+
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode.
+  virtual void SetDeterministicStreams(const bool mode_switch) = 0;
   /// Method to set Open Street Map mode.
   virtual void SetOSMMode(const bool mode_switch) = 0;
 
+  /// Method to query per-stage execution statistics of the update cycle.
+  virtual TrafficManagerStats GetStats() = 0;
+
 protected:
 
 };
@@ -7,10 +7,16 @@
 #pragma once
 
 #include "carla/trafficmanager/Constants.h"
+#include "carla/trafficmanager/StageTelemetry.h"
 #include "carla/rpc/Actor.h"
 
 #include <rpc/client.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 namespace carla {
 namespace traffic_manager {
 
@@ -35,20 +41,12 @@ public:
     : tmhost(_host),
       tmport(_port) {
 
-    /// Create client instance.
-      if(!_client) {
-        _client = new ::rpc::client(tmhost, tmport);
-        _client->set_timeout(TM_TIMEOUT);
-      }
+    /// Get the connection shared by every client talking to this server.
+    _client = GetOrCreateClient(tmhost, tmport);
   }
 
   /// Destructor method.
-  ~TrafficManagerClient() {
-    if(_client) {
-      delete _client;
-      _client = nullptr;
-    }
-  };
+  ~TrafficManagerClient() = default;
 
   /// Set parameters.
   void setServerDetails(const std::string &_host, const uint16_t &_port) {
@@ -144,6 +142,12 @@ public:
     _client->call("set_synchronous_mode", mode);
   }
 
+  /// Method to switch traffic manager into pipelined synchronous execution.
+  void SetPipelinedMode(const bool mode) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_pipelined_mode", mode);
+  }
+
   /// Method to set tick timeout for synchronous execution.
   void SetSynchronousModeTimeOutInMiliSecond(const double time) {
     DEBUG_ASSERT(_client != nullptr);
@@ -199,16 +203,51 @@ public:
     _client->call("set_random_device_seed", seed);
   }
 
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode.
+  void SetDeterministicStreams(const bool mode_switch) {
+    DEBUG_ASSERT(_client != nullptr);
+    _client->call("set_deterministic_streams", mode_switch);
+  }
+
   /// Method to set Open Street Map mode.
   void SetOSMMode(const bool mode_switch) {
     DEBUG_ASSERT(_client != nullptr);
     _client->call("set_osm_mode", mode_switch);
   }
 
+  /// Method to query per-stage execution statistics of the update cycle.
+  TrafficManagerStats GetStats() {
+    DEBUG_ASSERT(_client != nullptr);
+    return _client->call("get_stats").as<TrafficManagerStats>();
+  }
+
 private:
 
   /// RPC client.
-  ::rpc::client *_client = nullptr;
+  /// Return the connection to <host, port>, creating it on first use.
+  /// Connections are shared process-wide so several TM clients multiplex
+  /// their calls over one channel instead of opening a socket each; rpclib
+  /// interleaves concurrent requests on the same connection.
+  static std::shared_ptr<::rpc::client> GetOrCreateClient(
+      const std::string &host,
+      uint16_t port) {
+    static std::mutex map_mutex;
+    static std::map<std::pair<std::string, uint16_t>, std::weak_ptr<::rpc::client>> clients;
+    std::lock_guard<std::mutex> lock(map_mutex);
+    auto &slot = clients[std::make_pair(host, port)];
+    auto client = slot.lock();
+    if (client == nullptr) {
+      client = std::make_shared<::rpc::client>(host, port);
+      client->set_timeout(TM_TIMEOUT);
+      slot = client;
+    }
+    return client;
+  }
+
+  /// Connection to the server, shared with any other client using the same
+  /// <host, port>.
+  std::shared_ptr<::rpc::client> _client;
 
   /// Server port and host.
   std::string tmhost;
@@ -4,7 +4,10 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "carla/ThreadConfig.h"
 #include "carla/client/detail/Simulator.h"
+#include "carla/profiler/AllocationTracker.h"
+#include "carla/profiler/Tracer.h"
 
 #include "carla/trafficmanager/TrafficManagerLocal.h"
 
@@ -31,6 +34,9 @@ TrafficManagerLocal::TrafficManagerLocal(
     world(cc::World(episode_proxy)),
     debug_helper(world.MakeDebugHelper()),
 
+    stage_scheduler(number_of_stage_workers),
+    shard_arenas(number_of_stage_workers),
+
     localization_stage(LocalizationStage(vehicle_id_list,
                                          buffer_map,
                                          simulation_state,
@@ -42,37 +48,37 @@ TrafficManagerLocal::TrafficManagerLocal(
                                          debug_helper,
                                          random_devices)),
 
-    collision_stage(CollisionStage(vehicle_id_list,
-                                   simulation_state,
-                                   buffer_map,
-                                   track_traffic,
-                                   parameters,
-                                   collision_frame,
-                                   debug_helper,
-                                   random_devices)),
-
-    traffic_light_stage(TrafficLightStage(vehicle_id_list,
-                                          simulation_state,
-                                          buffer_map,
-                                          parameters,
-                                          world,
-                                          tl_frame,
-                                          random_devices)),
-
-    motion_plan_stage(MotionPlanStage(vehicle_id_list,
-                                      simulation_state,
-                                      parameters,
-                                      buffer_map,
-                                      track_traffic,
-                                      longitudinal_PID_parameters,
-                                      longitudinal_highway_PID_parameters,
-                                      lateral_PID_parameters,
-                                      lateral_highway_PID_parameters,
-                                      localization_frame,
-                                      collision_frame,
-                                      tl_frame,
-                                      world,
-                                      control_frame)),
+    collision_stage(vehicle_id_list,
+                    simulation_state,
+                    buffer_map,
+                    track_traffic,
+                    parameters,
+                    collision_frame,
+                    debug_helper,
+                    random_devices),
+
+    traffic_light_stage(vehicle_id_list,
+                        simulation_state,
+                        buffer_map,
+                        parameters,
+                        world,
+                        tl_frame,
+                        random_devices),
+
+    motion_plan_stage(vehicle_id_list,
+                      simulation_state,
+                      parameters,
+                      buffer_map,
+                      track_traffic,
+                      longitudinal_PID_parameters,
+                      longitudinal_highway_PID_parameters,
+                      lateral_PID_parameters,
+                      lateral_highway_PID_parameters,
+                      localization_frame,
+                      collision_frame,
+                      tl_frame,
+                      world,
+                      control_frame),
 
     alsm(ALSM(registered_vehicles,
               buffer_map,
@@ -92,6 +98,11 @@ TrafficManagerLocal::TrafficManagerLocal(
 
   parameters.SetGlobalPercentageSpeedDifference(perc_difference_from_limit);
 
+  localization_stage.SetTickArena(&tick_arena);
+  collision_stage.SetTickArena(&tick_arena);
+
+  stage_scheduler.AsyncRun();
+
   registered_vehicles_state = -1;
 
   SetupLocalMap();
@@ -106,8 +117,7 @@ TrafficManagerLocal::~TrafficManagerLocal() {
 
 void TrafficManagerLocal::SetupLocalMap() {
   const carla::SharedPtr<cc::Map> world_map = world.GetMap();
-  local_map = std::make_shared<InMemoryMap>(world_map);
-  local_map->SetUp();
+  local_map = InMemoryMap::GetOrCreate(world_map);
 }
 
 void TrafficManagerLocal::Start() {
@@ -117,6 +127,18 @@ void TrafficManagerLocal::Start() {
 
 void TrafficManagerLocal::Run() {
 
+  // Charge this thread's allocations to the traffic manager.
+  CARLA_ALLOCATION_SCOPE(TrafficManager);
+
+  // Name and, if configured, pin this thread away from the render thread.
+  ThreadConfig worker_config = ThreadConfig::ProcessDefault();
+  worker_config.name = "carla-tm";
+  worker_config.ApplyToCurrentThread();
+
+  // Transient stage data on this thread is arena-allocated; the arena is
+  // rewound once per cycle.
+  tick_arena.MakeCurrent();
+
   localization_frame.reserve(INITIAL_SIZE);
   collision_frame.reserve(INITIAL_SIZE);
   tl_frame.reserve(INITIAL_SIZE);
@@ -127,6 +149,7 @@ void TrafficManagerLocal::Run() {
 
     bool synchronous_mode = parameters.GetSynchronousMode();
     bool hybrid_physics_mode = parameters.GetHybridPhysicsMode();
+    bool pipelined_mode = parameters.GetPipelinedMode();
 
     // Wait for external trigger to initiate cycle in synchronous mode.
     if (synchronous_mode) {
@@ -135,6 +158,24 @@ void TrafficManagerLocal::Run() {
       step_begin.store(false);
     }
 
+    // In pipelined synchronous execution, the batch computed during the
+    // previous tick is applied now and the tick is released immediately; the
+    // stages below then run while the simulator computes the next frame. The
+    // controls are one frame stale, which is the price of hiding the stage
+    // latency inside the simulation time.
+    if (synchronous_mode && pipelined_mode) {
+      if (!pending_batch_buffer.empty()) {
+        episode_proxy.Lock()->ApplyBatchSync(pending_batch_buffer, false);
+        pending_batch_buffer.Clear();
+      }
+      step_end.store(true);
+      step_end_trigger.notify_one();
+    } else if (!pending_batch_buffer.empty()) {
+      // Pipelined execution was switched off with a batch still in flight;
+      // drop it rather than apply stale controls later.
+      pending_batch_buffer.Clear();
+    }
+
     // Skipping velocity update if elapsed time is less than 0.05s in asynchronous, hybrid mode.
     if (!synchronous_mode && hybrid_physics_mode) {
       TimePoint current_instance = chr::system_clock::now();
@@ -147,7 +188,13 @@ void TrafficManagerLocal::Run() {
     }
 
     // Updating simulation state, actor life cycle and performing necessary cleanup.
-    alsm.Update();
+    TimePoint stage_start_instance = chr::system_clock::now();
+    {
+      CARLA_TRACE_ZONE(traffic_manager, alsm);
+      alsm.Update();
+    }
+    TimePoint stage_end_instance = chr::system_clock::now();
+    telemetry.RecordStageDuration(TelemetryStage::ALSM, stage_start_instance, stage_end_instance);
 
     // Re-allocating inter-stage communication frames based on changed number of registered vehicles.
     int current_registered_vehicles_state = registered_vehicles.GetState();
@@ -180,34 +227,128 @@ void TrafficManagerLocal::Run() {
     control_frame.clear();
     control_frame.resize(number_of_vehicles);
 
-    // Run core operation stages.
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      localization_stage.Update(index);
+    // Rebase the counter-based random streams on the frame about to be
+    // computed so every draw below is a pure function of (seed, actor id,
+    // frame, draw index), regardless of how the stages shard across threads.
+    if (parameters.GetDeterministicStreams()) {
+      const uint64_t current_frame = static_cast<uint64_t>(alsm.GetCurrentTimestamp().frame);
+      for (auto &entry : random_devices) {
+        entry.second.SetFrame(current_frame);
+      }
     }
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      collision_stage.Update(index);
+
+    // Per-cycle caches were flushed last cycle, rewind their memory.
+    tick_arena.Reset();
+    for (TickArena &shard_arena : shard_arenas) {
+      shard_arena.Reset();
     }
-    collision_stage.ClearCycleCache();
 
-    for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
-      traffic_light_stage.Update(index);
-      motion_plan_stage.Update(index);
+    // Run core operation stages.
+    // Localization stays on this thread; it mutates the waypoint buffers and
+    // the traffic grid across actors. Once it finishes, the buffers are
+    // read-only for the rest of the cycle and the remaining stages shard
+    // across vehicles.
+    stage_start_instance = chr::system_clock::now();
+    {
+      CARLA_TRACE_ZONE(traffic_manager, localization);
+      for (unsigned long index = 0u; index < vehicle_id_list.size(); ++index) {
+        localization_stage.Update(index);
+      }
+    }
+    stage_end_instance = chr::system_clock::now();
+    telemetry.RecordStageDuration(TelemetryStage::LOCALIZATION, stage_start_instance, stage_end_instance);
+
+    stage_start_instance = stage_end_instance;
+    {
+      CARLA_TRACE_ZONE(traffic_manager, collision);
+      ParallelForEachIndex(vehicle_id_list.size(), [this](unsigned long index) {
+        collision_stage.Update(index);
+      });
+      collision_stage.ClearCycleCache();
     }
+    stage_end_instance = chr::system_clock::now();
+    telemetry.RecordStageDuration(TelemetryStage::COLLISION, stage_start_instance, stage_end_instance);
+
+    stage_start_instance = stage_end_instance;
+    {
+      CARLA_TRACE_ZONE(traffic_manager, traffic_light_motion_plan);
+      motion_plan_stage.SetupCycle(world.GetSnapshot().GetTimestamp());
+      ParallelForEachIndex(vehicle_id_list.size(), [this](unsigned long index) {
+        traffic_light_stage.Update(index);
+        motion_plan_stage.Update(index);
+      });
+    }
+    stage_end_instance = chr::system_clock::now();
+    telemetry.RecordStageDuration(TelemetryStage::TRAFFIC_LIGHT_MOTION_PLAN, stage_start_instance, stage_end_instance);
 
     // Building the command array for current cycle.
-    std::vector<carla::rpc::Command> batch_command(number_of_vehicles);
+    stage_start_instance = stage_end_instance;
+    // The controls are packed into the reusable buffer right here; the rpc
+    // layer sends the bytes as-is, so this is the only serialization the
+    // batch goes through. In pipelined execution the batch is packed into
+    // the pending buffer and held until the next tick.
+    const bool hold_batch = synchronous_mode && pipelined_mode;
+    carla::rpc::CommandBuffer &cycle_buffer = hold_batch ? pending_batch_buffer : batch_buffer;
+    cycle_buffer.Clear();
     for (unsigned long i = 0u; i < number_of_vehicles; ++i) {
-      batch_command.at(i) = control_frame.at(i);
+      cycle_buffer.Add(control_frame.at(i));
     }
 
     // Sending the current cycle's batch command to the simulator.
-    if (synchronous_mode) {
-      episode_proxy.Lock()->ApplyBatchSync(std::move(batch_command), false);
+    if (hold_batch) {
+      // Held until the next tick; it was already acknowledged.
+    } else if (synchronous_mode) {
+      episode_proxy.Lock()->ApplyBatchSync(cycle_buffer, false);
       step_end.store(true);
       step_end_trigger.notify_one();
     } else {
-      episode_proxy.Lock()->ApplyBatch(std::move(batch_command), false);
+      episode_proxy.Lock()->ApplyBatch(cycle_buffer, false);
     }
+    stage_end_instance = chr::system_clock::now();
+    telemetry.RecordStageDuration(TelemetryStage::SEND_COMMANDS, stage_start_instance, stage_end_instance);
+    telemetry.RecordTick(number_of_vehicles);
+  }
+}
+
+void TrafficManagerLocal::ParallelForEachIndex(const unsigned long count,
+                                               const std::function<void(unsigned long)> &body) {
+  using constants::ParallelStage::MIN_VEHICLES_PER_SHARD;
+
+  // Shards are sized so each one carries at least MIN_VEHICLES_PER_SHARD
+  // vehicles; below that the scheduling overhead outweighs the work and the
+  // whole range runs inline on this thread.
+  const unsigned long number_of_shards = std::min(static_cast<unsigned long>(number_of_stage_workers) + 1u,
+                                                  count / MIN_VEHICLES_PER_SHARD);
+  if (number_of_shards <= 1u) {
+    for (unsigned long index = 0u; index < count; ++index) {
+      body(index);
+    }
+    return;
+  }
+
+  const unsigned long shard_size = (count + number_of_shards - 1u) / number_of_shards;
+  std::vector<std::future<void>> pending_shards;
+  pending_shards.reserve(number_of_shards - 1u);
+  for (unsigned long shard = 0u; shard + 1u < number_of_shards; ++shard) {
+    const unsigned long begin = shard * shard_size;
+    const unsigned long end = std::min(count, begin + shard_size);
+    TickArena &shard_arena = shard_arenas.at(shard);
+    pending_shards.push_back(stage_scheduler.Post([&body, &shard_arena, begin, end]() {
+      // Transient stage data in this shard bump-allocates from its own arena.
+      shard_arena.MakeCurrent();
+      for (unsigned long index = begin; index < end; ++index) {
+        body(index);
+      }
+    }));
+  }
+
+  // This thread takes the last shard on its own arena, then waiting on the
+  // futures forms the barrier before the next stage.
+  for (unsigned long index = (number_of_shards - 1u) * shard_size; index < count; ++index) {
+    body(index);
+  }
+  for (auto &pending_shard : pending_shards) {
+    pending_shard.get();
   }
 }
 
@@ -244,7 +385,10 @@ void TrafficManagerLocal::Stop() {
   previous_update_instance = chr::system_clock::now();
   current_reserved_capacity = 0u;
   random_devices.clear();
+  batch_buffer.Clear();
+  pending_batch_buffer.Clear();
 
+  telemetry.Reset();
   simulation_state.Reset();
   localization_stage.Reset();
   collision_stage.Reset();
@@ -271,17 +415,47 @@ void TrafficManagerLocal::Release() {
 
 void TrafficManagerLocal::Reset() {
 
+  // Snapshot the registrations before Stop() clears them; vehicles that
+  // survived the episode change are registered again below. Behavioral
+  // parameters live in `parameters`, which a reset never touches, so per
+  // actor and global tuning carries over on its own.
+  const std::vector<ActorId> previous_registrations = registered_vehicles.GetIDList();
+
+  // Hold on to the outgoing map across Release so the process-wide cache
+  // entry stays alive; reloading the same town then reuses the built map
+  // instead of rebuilding it from the OpenDRIVE definition.
+  LocalMapPtr retained_map = local_map;
+
   Release();
   episode_proxy = episode_proxy.Lock()->GetCurrentEpisode();
   world = cc::World(episode_proxy);
   SetupLocalMap();
+  retained_map.reset();
+
+  // Register again the vehicles that exist in the new episode.
+  if (!previous_registrations.empty()) {
+    std::vector<ActorPtr> surviving_vehicles;
+    for (const ActorPtr &actor : *world.GetActors(previous_registrations)) {
+      if (actor != nullptr) {
+        surviving_vehicles.push_back(actor);
+      }
+    }
+    if (!surviving_vehicles.empty()) {
+      RegisterVehicles(surviving_vehicles);
+    }
+  }
+
   Start();
 }
 
 void TrafficManagerLocal::RegisterVehicles(const std::vector<ActorPtr> &vehicle_list) {
   registered_vehicles.Insert(vehicle_list);
   for (const ActorPtr &vehicle: vehicle_list) {
-    random_devices.insert({vehicle->GetId(), RandomGenerator(seed)});
+    if (parameters.GetDeterministicStreams()) {
+      random_devices.insert({vehicle->GetId(), RandomGenerator(seed, vehicle->GetId())});
+    } else {
+      random_devices.insert({vehicle->GetId(), RandomGenerator(seed)});
+    }
   }
 }
 
@@ -391,6 +565,10 @@ void TrafficManagerLocal::SetSynchronousMode(bool mode) {
   }
 }
 
+void TrafficManagerLocal::SetPipelinedMode(bool mode) {
+  parameters.SetPipelinedMode(mode);
+}
+
 void TrafficManagerLocal::SetSynchronousModeTimeOutInMiliSecond(double time) {
   parameters.SetSynchronousModeTimeOutInMiliSecond(time);
 }
@@ -408,5 +586,18 @@ void TrafficManagerLocal::SetRandomDeviceSeed(const uint64_t _seed) {
   ResetAllTrafficLights();
 }
 
+void TrafficManagerLocal::SetDeterministicStreams(const bool mode_switch) {
+  parameters.SetDeterministicStreams(mode_switch);
+  // Re-key the streams of the already registered vehicles so they match the
+  // ones vehicles registered after the switch will get.
+  for (auto &entry : random_devices) {
+    entry.second = mode_switch ? RandomGenerator(seed, entry.first) : RandomGenerator(seed);
+  }
+}
+
+TrafficManagerStats TrafficManagerLocal::GetStats() {
+  return telemetry.GetStats();
+}
+
 } // namespace traffic_manager
 } // namespace carla
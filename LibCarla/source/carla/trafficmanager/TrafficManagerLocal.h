@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <thread>
 #include <vector>
 
@@ -16,13 +18,16 @@
 #include "carla/client/TrafficLight.h"
 #include "carla/client/World.h"
 #include "carla/Memory.h"
+#include "carla/TaskScheduler.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/CommandBuffer.h"
 
 #include "carla/trafficmanager/AtomicActorSet.h"
 #include "carla/trafficmanager/InMemoryMap.h"
 #include "carla/trafficmanager/Parameters.h"
 #include "carla/trafficmanager/RandomGenerator.h"
 #include "carla/trafficmanager/SimulationState.h"
+#include "carla/trafficmanager/StageTelemetry.h"
 #include "carla/trafficmanager/TrackTraffic.h"
 #include "carla/trafficmanager/TrafficManagerBase.h"
 #include "carla/trafficmanager/TrafficManagerServer.h"
@@ -88,8 +93,26 @@ private:
   TLFrame tl_frame;
   /// Array to hold output data of motion planning.
   ControlFrame control_frame;
+  /// Reusable pre-encoded batch for the current cycle's controls; the
+  /// commands are packed once here and the bytes go out as-is, so the rpc
+  /// layer never re-serializes the batch.
+  carla::rpc::CommandBuffer batch_buffer;
+  /// Batch computed last cycle, pending application in pipelined synchronous
+  /// execution. Applying it is all the next tick waits for; the stages for
+  /// the following batch then overlap the simulator's tick.
+  carla::rpc::CommandBuffer pending_batch_buffer;
   /// Variable to keep track of currently reserved array space for frames.
   uint64_t current_reserved_capacity {0u};
+  /// Bump arena for transient per-cycle stage data, rewound every cycle.
+  TickArena tick_arena;
+  /// Number of pool threads sharding stage updates across vehicles.
+  const unsigned int number_of_stage_workers = std::max(1u, std::thread::hardware_concurrency());
+  /// Pool running vehicle shards of the parallelizable stages.
+  TaskScheduler stage_scheduler;
+  /// One arena per posted shard, so parallel stage updates keep bump
+  /// allocation without racing on a shared chunk. Rewound with the main
+  /// arena every cycle.
+  std::vector<TickArena> shard_arenas;
   /// Various stages representing core operations of traffic manager.
   LocalizationStage localization_stage;
   CollisionStage collision_stage;
@@ -98,6 +121,8 @@ private:
   ALSM alsm;
   /// Traffic manager server instance.
   TrafficManagerServer server;
+  /// Always-on per-stage execution statistics of the update cycle.
+  StageTelemetry telemetry;
   /// Switch to turn on / turn off traffic manager.
   std::atomic<bool> run_traffic_manger{true};
   /// Flags to signal step begin and end.
@@ -119,6 +144,11 @@ private:
   /// Method to check if all traffic lights are frozen in a group.
   bool CheckAllFrozen(TLGroup tl_to_freeze);
 
+  /// Run @a body for every index in [0, count), sharded across the stage
+  /// scheduler. Returns once every shard has finished, forming the barrier
+  /// between stages. Small fleets run inline on the calling thread.
+  void ParallelForEachIndex(unsigned long count, const std::function<void(unsigned long)> &body);
+
 public:
   /// Private constructor for singleton lifecycle management.
   TrafficManagerLocal(std::vector<float> longitudinal_PID_parameters,
@@ -193,6 +223,9 @@ public:
   /// Method to switch traffic manager into synchronous execution.
   void SetSynchronousMode(bool mode);
 
+  /// Method to switch traffic manager into pipelined synchronous execution.
+  void SetPipelinedMode(bool mode);
+
   /// Method to set Tick timeout for synchronous execution.
   void SetSynchronousModeTimeOutInMiliSecond(double time);
 
@@ -227,8 +260,15 @@ public:
   /// Method to set randomization seed.
   void SetRandomDeviceSeed(const uint64_t _seed);
 
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode.
+  void SetDeterministicStreams(const bool mode_switch);
+
   /// Method to set Open Street Map mode.
   void SetOSMMode(const bool mode_switch);
+
+  /// Method to query per-stage execution statistics of the update cycle.
+  TrafficManagerStats GetStats();
 };
 
 } // namespace traffic_manager
@@ -8,9 +8,137 @@
 
 #include "carla/trafficmanager/TrafficManagerRemote.h"
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace carla {
 namespace traffic_manager {
 
+namespace {
+
+/// Runs one health-check thread per TM endpoint, shared by every remote
+/// talking to that server; remotes subscribe with a callback that fires if
+/// the connection dies. Together with the shared connection inside
+/// TrafficManagerClient this keeps N remotes on one socket and one
+/// keep-alive thread instead of N of each.
+class TMKeepAliveRegistry {
+public:
+
+  using FailureCallback = std::function<void(const std::string &)>;
+
+  static TMKeepAliveRegistry &GetInstance() {
+    static TMKeepAliveRegistry instance;
+    return instance;
+  }
+
+  size_t Subscribe(const std::string &host, uint16_t port, FailureCallback callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &slot = _endpoints[host + ":" + std::to_string(port)];
+    if ((slot == nullptr) || !slot->run) {
+      slot = MakeEntry(host, port);
+    }
+    const auto id = ++_counter;
+    {
+      std::lock_guard<std::mutex> sub_lock(slot->mutex);
+      slot->subscribers.emplace(id, std::move(callback));
+    }
+    _by_id.emplace(id, slot);
+    return id;
+  }
+
+  void Unsubscribe(size_t id) {
+    std::shared_ptr<Entry> last_one_out;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _by_id.find(id);
+      if (it == _by_id.end()) {
+        return;
+      }
+      auto entry = std::move(it->second);
+      _by_id.erase(it);
+      {
+        std::lock_guard<std::mutex> sub_lock(entry->mutex);
+        entry->subscribers.erase(id);
+        if (!entry->subscribers.empty()) {
+          return;
+        }
+      }
+      for (auto eit = _endpoints.begin(); eit != _endpoints.end(); ++eit) {
+        if (eit->second == entry) {
+          _endpoints.erase(eit);
+          break;
+        }
+      }
+      last_one_out = std::move(entry);
+    }
+    /// Destroyed here, outside the registry lock; the destructor joins the
+    /// health-check thread.
+  }
+
+private:
+
+  struct Entry {
+    Entry(const std::string &host, uint16_t port) : client(host, port) {}
+
+    ~Entry() {
+      run = false;
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+
+    TrafficManagerClient client;
+    std::thread thread;
+    std::atomic_bool run{true};
+    std::mutex mutex;
+    std::map<size_t, FailureCallback> subscribers;
+  };
+
+  static std::shared_ptr<Entry> MakeEntry(const std::string &host, uint16_t port) {
+    auto entry = std::make_shared<Entry>(host, port);
+    /// The thread takes a raw pointer on purpose: the entry is guaranteed to
+    /// outlive it because ~Entry joins before the members are destroyed.
+    auto *self = entry.get();
+    entry->thread = std::thread([self, host, port]() {
+      const std::chrono::milliseconds slice(100);
+      std::chrono::milliseconds since_last_check(0);
+      while (self->run) {
+        std::this_thread::sleep_for(slice);
+        since_last_check += slice;
+        if (since_last_check.count() < TM_TIMEOUT) {
+          continue;
+        }
+        since_last_check = std::chrono::milliseconds(0);
+        try {
+          self->client.HealthCheckRemoteTM();
+        } catch (...) {
+          std::string errmsg(
+              "Trying to connect rpc server of traffic manager; "
+              "but the system failed to connect at " +
+              host + ":" + std::to_string(port));
+          std::lock_guard<std::mutex> lock(self->mutex);
+          for (auto &subscriber : self->subscribers) {
+            subscriber.second(errmsg);
+          }
+          self->run = false;
+        }
+      }
+    });
+    return entry;
+  }
+
+  std::mutex _mutex;
+  std::map<std::string, std::shared_ptr<Entry>> _endpoints;
+  std::map<size_t, std::shared_ptr<Entry>> _by_id;
+  size_t _counter = 0u;
+};
+
+} // namespace
+
 TrafficManagerRemote::TrafficManagerRemote(
     const std::pair<std::string, uint16_t> &_serverTM,
     carla::client::detail::EpisodeProxy &episodeProxy)
@@ -29,48 +157,28 @@ TrafficManagerRemote::~TrafficManagerRemote() {
 void TrafficManagerRemote::Start() {
   _keep_alive = true;
 
-  std::thread _thread = std::thread([this] () {
-    std::chrono::milliseconds wait_time(TM_TIMEOUT);
-    try {
-      do {
-        std::this_thread::sleep_for(wait_time);
-
-        client.HealthCheckRemoteTM();
-
-        /// Until connection active
-      } while (_keep_alive);
-    } catch (...) {
-
-      std::string rhost("");
-      uint16_t rport = 0;
-
-      client.getServerDetails(rhost, rport);
-
-      std::string strtmserver(rhost + ":" + std::to_string(rport));
-
-      /// Create error msg
-      std::string errmsg(
-          "Trying to connect rpc server of traffic manager; "
-          "but the system failed to connect at " + strtmserver);
-
-      /// TSet the error message
-      if(_keep_alive) {
-        this->episodeProxyTM.Lock()->AddPendingException(errmsg);
-      }
-    }
-    _keep_alive = false;
-    _cv.notify_one();
-  });
-
-  _thread.detach();
+  std::string rhost("");
+  uint16_t rport = 0;
+  client.getServerDetails(rhost, rport);
+
+  /// Health checks are shared between every remote on the same endpoint; we
+  /// only subscribe to be told when the connection dies.
+  _health_check_id = TMKeepAliveRegistry::GetInstance().Subscribe(
+      rhost, rport,
+      [this](const std::string &errmsg) {
+        /// Set the error message
+        if (_keep_alive) {
+          this->episodeProxyTM.Lock()->AddPendingException(errmsg);
+        }
+        _keep_alive = false;
+      });
 }
 
 void TrafficManagerRemote::Stop() {
-  if(_keep_alive) {
-    _keep_alive = false;
-    std::unique_lock<std::mutex> lock(_mutex);
-    std::chrono::milliseconds wait_time(TM_TIMEOUT + 1000);
-    _cv.wait_for(lock, wait_time);
+  _keep_alive = false;
+  if (_health_check_id != 0u) {
+    TMKeepAliveRegistry::GetInstance().Unsubscribe(_health_check_id);
+    _health_check_id = 0u;
   }
 }
 
@@ -193,6 +301,10 @@ void TrafficManagerRemote::SetSynchronousMode(bool mode) {
   client.SetSynchronousMode(mode);
 }
 
+void TrafficManagerRemote::SetPipelinedMode(bool mode) {
+  client.SetPipelinedMode(mode);
+}
+
 void TrafficManagerRemote::SetSynchronousModeTimeOutInMiliSecond(double time) {
   client.SetSynchronousModeTimeOutInMiliSecond(time);
 }
@@ -213,5 +325,13 @@ void TrafficManagerRemote::SetRandomDeviceSeed(const uint64_t seed) {
   client.SetRandomDeviceSeed(seed);
 }
 
+void TrafficManagerRemote::SetDeterministicStreams(const bool mode_switch) {
+  client.SetDeterministicStreams(mode_switch);
+}
+
+TrafficManagerStats TrafficManagerRemote::GetStats() {
+  return client.GetStats();
+}
+
 } // namespace traffic_manager
 } // namespace carla
@@ -6,8 +6,6 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
 #include <vector>
 
 #include "carla/client/Actor.h"
@@ -90,6 +88,9 @@ public:
   /// Method to switch traffic manager into synchronous execution.
   void SetSynchronousMode(bool mode);
 
+  /// Method to switch traffic manager into pipelined synchronous execution.
+  void SetPipelinedMode(bool mode);
+
   /// Method to set Tick timeout for synchronous execution.
   void SetSynchronousModeTimeOutInMiliSecond(double time);
 
@@ -120,6 +121,13 @@ public:
   /// Method to set randomization seed.
   void SetRandomDeviceSeed(const uint64_t seed);
 
+  /// Method to switch the per-actor random streams to the counter-based
+  /// deterministic mode.
+  void SetDeterministicStreams(const bool mode_switch);
+
+  /// Method to query per-stage execution statistics of the update cycle.
+  TrafficManagerStats GetStats();
+
 private:
 
   /// Remote client using the IP and port information it connects to
@@ -129,11 +137,10 @@ private:
   /// CARLA client connection object.
   carla::client::detail::EpisodeProxy episodeProxyTM;
 
-  std::condition_variable _cv;
-
-  std::mutex _mutex;
-
   bool _keep_alive = true;
+
+  /// Subscription to the shared per-endpoint health-check thread.
+  size_t _health_check_id = 0u;
 };
 
 } // namespace traffic_manager
@@ -173,6 +173,11 @@ public:
         tm->SetSynchronousMode(mode);
       });
 
+      /// Method to set pipelined synchronous execution.
+      server->bind("set_pipelined_mode", [=](const bool mode) {
+        tm->SetPipelinedMode(mode);
+      });
+
       /// Method to set tick timeout for synchronous execution.
       server->bind("set_synchronous_mode_timeout_in_milisecond", [=](const double time) {
         tm->SetSynchronousModeTimeOutInMiliSecond(time);
@@ -183,6 +188,11 @@ public:
         tm->SetRandomDeviceSeed(seed);
       });
 
+      /// Method to switch to counter-based deterministic random streams.
+      server->bind("set_deterministic_streams", [=](const bool mode_switch) {
+        tm->SetDeterministicStreams(mode_switch);
+      });
+
       /// Method to provide synchronous tick.
       server->bind("synchronous_tick", [=]() -> bool {
         return tm->SynchronousTick();
@@ -196,6 +206,11 @@ public:
       /// Method to check server is alive or not.
       server->bind("health_check_remote_TM", [=](){});
 
+      /// Method to query per-stage execution statistics of the update cycle.
+      server->bind("get_stats", [=]() -> TrafficManagerStats {
+        return tm->GetStats();
+      });
+
       /// Run traffic manager server to respond of any
       /// user client in asynchronous mode.
       server->async_run();
@@ -14,6 +14,7 @@
 #include <carla/geom/Math.h>
 #include <carla/opendrive/OpenDriveParser.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/RoutePlanner.h>
 #include <carla/road/element/RoadInfoElevation.h>
 #include <carla/road/element/RoadInfoGeometry.h>
 #include <carla/road/element/RoadInfoMarkRecord.h>
@@ -378,6 +379,49 @@ TEST(road, iterate_waypoints) {
   }
 }
 
+TEST(road, route_planner) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    carla::logging::log("Parsing", file);
+    carla::StopWatch stop_watch;
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    const carla::road::RoutePlanner planner(map);
+    ASSERT_GT(planner.GetNodeCount(), 0u);
+    auto waypoints = map.GenerateWaypoints(2.0);
+    ASSERT_FALSE(waypoints.empty());
+    Random::Shuffle(waypoints);
+    constexpr double resolution = 2.0;
+    auto routes_found = 0u;
+    const auto number_of_routes_to_trace =
+        std::min<size_t>(50u, waypoints.size() / 2u);
+    for (auto i = 0u; i < number_of_routes_to_trace; ++i) {
+      const auto origin = waypoints[2u * i];
+      const auto destination = waypoints[2u * i + 1u];
+      const auto route = planner.TraceRoute(origin, destination, resolution);
+      if (route.empty()) {
+        // Not every pair is connected, e.g. opposite driving directions on
+        // a one-way stretch.
+        continue;
+      }
+      ++routes_found;
+      ASSERT_EQ(route.front(), origin);
+      ASSERT_EQ(route.back(), destination);
+      auto previous = map.ComputeTransform(route.front()).location;
+      for (auto j = 1u; j < route.size(); ++j) {
+        const auto current = map.ComputeTransform(route[j]).location;
+        // Consecutive waypoints stay close: a sampling step, a lane change,
+        // or the hop from the end of a lane to its successor's entrance.
+        ASSERT_LT(current.Distance(previous), 5.0f * resolution);
+        previous = current;
+      }
+    }
+    ASSERT_GT(routes_found, 0u);
+    float seconds = 1e-3f * stop_watch.GetElapsedTime();
+    carla::logging::log(file, "done in", seconds, "seconds.");
+  }
+}
+
 TEST(road, get_waypoint) {
   carla::ThreadPool pool;
   pool.AsyncRun();
@@ -0,0 +1,74 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/AsyncFileIO.h>
+#include <carla/pointcloud/PointCloudIO.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using carla::AsyncFileIO;
+using carla::pointcloud::PointCloudIO;
+
+TEST(async_file_io, write_round_trip) {
+  const std::string path = "/tmp/carla_test_async_file_io.bin";
+  const std::string contents("some sensor data\0with a null byte", 33u);
+  auto result = AsyncFileIO::GetInstance().Write(path, contents).get();
+  ASSERT_EQ(path, result);
+  std::ifstream in(path, std::ios_base::binary);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  ASSERT_EQ(contents, buffer.str());
+  std::remove(path.c_str());
+}
+
+TEST(async_file_io, post_rethrows_through_future) {
+  auto future = AsyncFileIO::GetInstance().Post([]() -> int {
+    throw std::runtime_error("disk on fire");
+  });
+  ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+namespace {
+
+  struct TestDetection {
+    float x, y, z;
+
+    void WritePlyHeaderInfo(std::ostream &out) const {
+      out << "property float32 x\n"
+             "property float32 y\n"
+             "property float32 z";
+    }
+
+    void WriteDetection(std::ostream &out) const {
+      out << x << ' ' << y << ' ' << z;
+    }
+  };
+
+} // namespace
+
+TEST(async_file_io, save_point_cloud_async) {
+  const std::vector<TestDetection> points = {{0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}};
+  auto path = PointCloudIO::SaveToDiskAsync(
+      "/tmp/carla_test_async_file_io_cloud", points.begin(), points.end()).get();
+  ASSERT_EQ("/tmp/carla_test_async_file_io_cloud.ply", path);
+  std::ifstream in(path);
+  std::string first_line;
+  std::getline(in, first_line);
+  ASSERT_EQ("ply", first_line);
+  // All the points made it.
+  size_t lines = 1u;
+  std::string line;
+  while (std::getline(in, line)) {
+    ++lines;
+  }
+  ASSERT_EQ(9u, lines) << "7 header lines plus 2 points";
+  std::remove(path.c_str());
+}
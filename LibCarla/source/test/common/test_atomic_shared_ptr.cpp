@@ -0,0 +1,44 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/AtomicSharedPtr.h>
+#include <carla/ThreadGroup.h>
+
+#include <atomic>
+#include <memory>
+
+TEST(atomic_shared_ptr, reentrant_retire) {
+  // Dropping the last reference to a node destroys its inner pointer, whose
+  // destructor retires again from inside the reclaimer; this must not
+  // deadlock on the reclaimer's mutex.
+  struct Node {
+    carla::AtomicSharedPtr<int> inner{std::make_shared<int>(42)};
+  };
+  carla::AtomicSharedPtr<Node> ptr{std::make_shared<Node>()};
+  for (auto i = 0u; i < 100u; ++i) {
+    ptr.store(std::make_shared<Node>());
+  }
+  ptr.reset();
+}
+
+TEST(atomic_shared_ptr, concurrent_load_and_store) {
+  carla::AtomicSharedPtr<size_t> ptr{std::make_shared<size_t>(0u)};
+  std::atomic_bool done{false};
+  carla::ThreadGroup threads;
+  threads.CreateThreads(4u, [&]() {
+    while (!done) {
+      auto value = ptr.load();
+      ASSERT_NE(value, nullptr);
+      ASSERT_LE(*value, 10000u);
+    }
+  });
+  for (auto i = 1u; i <= 10000u; ++i) {
+    ptr.store(std::make_shared<size_t>(i));
+  }
+  done = true;
+}
@@ -120,6 +120,38 @@ TEST(buffer, message_too_big) {
 }
 #endif // LIBCARLA_NO_EXCEPTIONS
 
+static size_t counted_allocations = 0u;
+static size_t counted_deallocations = 0u;
+
+static unsigned char *CountingAllocate(Buffer::size_type size) {
+  ++counted_allocations;
+  return static_cast<unsigned char *>(std::malloc(size));
+}
+
+static void CountingDeallocate(unsigned char *data) {
+  ++counted_deallocations;
+  std::free(data);
+}
+
+TEST(buffer, reset_to_inline_releases_small_heap_block) {
+  // resize on an empty buffer heap-allocates at exact size, so blocks
+  // smaller than the inline storage exist; a later reset that switches to
+  // inline storage must release them.
+  constexpr auto inline_capacity = carla::Buffer::inline_capacity;
+  counted_allocations = 0u;
+  counted_deallocations = 0u;
+  Buffer::SetPinnedMemoryAllocator(CountingAllocate, CountingDeallocate);
+  {
+    Buffer buffer;
+    buffer.resize(16u);
+    ASSERT_EQ(counted_allocations, 1u);
+    buffer.reset(static_cast<Buffer::size_type>(inline_capacity));
+    ASSERT_EQ(counted_deallocations, 1u);
+  }
+  Buffer::SetPinnedMemoryAllocator(nullptr, nullptr);
+  ASSERT_EQ(counted_allocations, counted_deallocations);
+}
+
 TEST(buffer, buffer_pool) {
   const std::string str = "Hello buffer!";
   auto pool = std::make_shared<carla::BufferPool>();
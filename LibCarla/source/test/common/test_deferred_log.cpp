@@ -0,0 +1,152 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/DeferredLog.h>
+#include <carla/Logging.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using carla::logging::DeferredLog;
+using carla::logging::Level;
+using carla::logging::Record;
+
+namespace {
+
+  struct ParsedRecord {
+    Level level;
+    std::vector<uint8_t> payload;
+  };
+
+  static std::vector<ParsedRecord> ParseStream(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    EXPECT_TRUE(file.good());
+    char magic[5u];
+    file.read(magic, sizeof(magic));
+    EXPECT_EQ(0, std::memcmp(magic, "CLOG\x01", sizeof(magic)));
+    std::vector<ParsedRecord> result;
+    for (;;) {
+      uint8_t level;
+      uint64_t nanos;
+      uint16_t size;
+      file.read(reinterpret_cast<char *>(&level), sizeof(level));
+      if (!file.good()) {
+        break;
+      }
+      file.read(reinterpret_cast<char *>(&nanos), sizeof(nanos));
+      file.read(reinterpret_cast<char *>(&size), sizeof(size));
+      ParsedRecord record;
+      record.level = static_cast<Level>(level);
+      record.payload.resize(size);
+      file.read(reinterpret_cast<char *>(record.payload.data()), size);
+      result.push_back(std::move(record));
+    }
+    return result;
+  }
+
+} // namespace
+
+TEST(deferred_log, record_encodes_typed_fields) {
+  Record record;
+  record.Reset(Level::info, 42u);
+  record.Append(-7);
+  record.Append(3.5);
+  record.Append(true);
+  record.Append("hello");
+  ASSERT_EQ(Level::info, record.GetLevel());
+  ASSERT_EQ(42u, record.GetTimestampNanos());
+  const uint8_t *payload = record.GetPayload();
+  size_t offset = 0u;
+  ASSERT_EQ(Record::field_int, payload[offset]);
+  int64_t integer;
+  std::memcpy(&integer, payload + offset + 1u, sizeof(integer));
+  ASSERT_EQ(-7, integer);
+  offset += 1u + sizeof(int64_t);
+  ASSERT_EQ(Record::field_float, payload[offset]);
+  double real;
+  std::memcpy(&real, payload + offset + 1u, sizeof(real));
+  ASSERT_DOUBLE_EQ(3.5, real);
+  offset += 1u + sizeof(double);
+  ASSERT_EQ(Record::field_bool, payload[offset]);
+  ASSERT_EQ(1u, payload[offset + 1u]);
+  offset += 2u;
+  ASSERT_EQ(Record::field_text, payload[offset]);
+  uint16_t length;
+  std::memcpy(&length, payload + offset + 1u, sizeof(length));
+  ASSERT_EQ(5u, length);
+  ASSERT_EQ(0, std::memcmp("hello", payload + offset + 3u, 5u));
+  offset += 1u + sizeof(uint16_t) + 5u;
+  ASSERT_EQ(offset, record.GetPayloadSize());
+}
+
+TEST(deferred_log, record_truncates_instead_of_growing) {
+  Record record;
+  record.Reset(Level::debug, 0u);
+  const std::string big(Record::PayloadCapacity, 'x');
+  record.Append(big);
+  ASSERT_EQ(1u, record.GetPayloadSize());
+  ASSERT_EQ(Record::field_truncated, record.GetPayload()[0u]);
+  // Appending more keeps the single marker.
+  record.Append(big);
+  ASSERT_EQ(1u, record.GetPayloadSize());
+}
+
+TEST(deferred_log, ring_hands_records_to_writer) {
+  const std::string path = "test_deferred_log_ring.clog";
+  std::remove(path.c_str());
+  auto &log = DeferredLog::Get();
+  log.Enable(path, 64u);
+  ASSERT_TRUE(log.IsEnabled());
+  ASSERT_TRUE(DeferredLog::TryLog(Level::warning, "queue", 1, 2.0));
+  ASSERT_TRUE(DeferredLog::TryLog(Level::error, "depth", 3u));
+  log.Disable();
+  ASSERT_FALSE(log.IsEnabled());
+  const auto records = ParseStream(path);
+  ASSERT_EQ(2u, records.size());
+  ASSERT_EQ(Level::warning, records[0u].level);
+  ASSERT_EQ(Record::field_text, records[0u].payload[0u]);
+  ASSERT_EQ(Level::error, records[1u].level);
+  // Disabled again, calls fall back to the eager path.
+  ASSERT_FALSE(DeferredLog::TryLog(Level::error, "eager"));
+  std::remove(path.c_str());
+}
+
+TEST(deferred_log, minimum_level_discards_before_encoding) {
+  const std::string path = "test_deferred_log_level.clog";
+  std::remove(path.c_str());
+  auto &log = DeferredLog::Get();
+  log.Enable(path, 64u);
+  DeferredLog::SetMinimumLevel(Level::error);
+  ASSERT_FALSE(DeferredLog::IsLevelEnabled(Level::warning));
+  // Handled (discarded), the caller must not fall back to the eager path.
+  ASSERT_TRUE(DeferredLog::TryLog(Level::warning, "dropped"));
+  ASSERT_TRUE(DeferredLog::TryLog(Level::critical, "kept"));
+  DeferredLog::SetMinimumLevel(Level::debug);
+  log.Disable();
+  const auto records = ParseStream(path);
+  ASSERT_EQ(1u, records.size());
+  ASSERT_EQ(Level::critical, records[0u].level);
+  std::remove(path.c_str());
+}
+
+TEST(deferred_log, checked_macro_skips_argument_evaluation) {
+  int evaluations = 0;
+  auto count = [&evaluations]() {
+    ++evaluations;
+    return "counted";
+  };
+  DeferredLog::SetMinimumLevel(Level::critical);
+  LIBCARLA_LOG_WARNING(count());
+  ASSERT_EQ(0, evaluations);
+  DeferredLog::SetMinimumLevel(Level::debug);
+  LIBCARLA_LOG_ERROR(count());
+  ASSERT_EQ(1, evaluations);
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/federation/Region.h>
+
+using namespace carla::federation;
+using carla::geom::Location;
+
+TEST(federation, region_contains) {
+  const Region region{Location(0.0f, 0.0f, 0.0f), Location(100.0f, 50.0f, 0.0f)};
+  ASSERT_TRUE(region.Contains(Location(50.0f, 25.0f, 0.0f)));
+  ASSERT_TRUE(region.Contains(Location(0.0f, 0.0f, 0.0f)));
+  // Height never matters, bridges stay with the region underneath.
+  ASSERT_TRUE(region.Contains(Location(50.0f, 25.0f, 200.0f)));
+  // Maximum edges are exclusive so adjacent regions stay disjoint.
+  ASSERT_FALSE(region.Contains(Location(100.0f, 25.0f, 0.0f)));
+  ASSERT_FALSE(region.Contains(Location(-1.0f, 25.0f, 0.0f)));
+  ASSERT_FALSE(region.Contains(Location(50.0f, 60.0f, 0.0f)));
+}
+
+TEST(federation, region_overlaps) {
+  const Region region{Location(0.0f, 0.0f, 0.0f), Location(100.0f, 100.0f, 0.0f)};
+  const Region adjacent{Location(100.0f, 0.0f, 0.0f), Location(200.0f, 100.0f, 0.0f)};
+  const Region overlapping{Location(50.0f, 50.0f, 0.0f), Location(150.0f, 150.0f, 0.0f)};
+  ASSERT_FALSE(region.Overlaps(adjacent));
+  ASSERT_FALSE(adjacent.Overlaps(region));
+  ASSERT_TRUE(region.Overlaps(overlapping));
+  ASSERT_TRUE(overlapping.Overlaps(region));
+  ASSERT_TRUE(region.Overlaps(region));
+}
+
+TEST(federation, region_boundary_margin) {
+  const Region region{Location(0.0f, 0.0f, 0.0f), Location(100.0f, 100.0f, 0.0f)};
+  ASSERT_NEAR(region.DistanceToBoundary(Location(50.0f, 50.0f, 0.0f)), 50.0f, 1e-5f);
+  ASSERT_NEAR(region.DistanceToBoundary(Location(10.0f, 50.0f, 0.0f)), 10.0f, 1e-5f);
+  ASSERT_LT(region.DistanceToBoundary(Location(-10.0f, 50.0f, 0.0f)), 0.0f);
+
+  // A neighbouring region inflated by the ghost margin picks up actors
+  // approaching the shared boundary from outside.
+  const Region neighbour{Location(100.0f, 0.0f, 0.0f), Location(200.0f, 100.0f, 0.0f)};
+  const auto margin_zone = neighbour.Inflate(5.0f);
+  ASSERT_FALSE(neighbour.Contains(Location(97.0f, 50.0f, 0.0f)));
+  ASSERT_TRUE(margin_zone.Contains(Location(97.0f, 50.0f, 0.0f)));
+  ASSERT_FALSE(margin_zone.Contains(Location(90.0f, 50.0f, 0.0f)));
+}
@@ -0,0 +1,121 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/trafficmanager/FlatContainers.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using carla::traffic_manager::FlatHashMap;
+using carla::traffic_manager::SmallIdSet;
+
+TEST(flat_containers, small_set_sorted_unique) {
+  SmallIdSet<uint32_t> ids;
+  ASSERT_TRUE(ids.empty());
+  ASSERT_TRUE(ids.insert(7u));
+  ASSERT_TRUE(ids.insert(3u));
+  ASSERT_FALSE(ids.insert(7u));
+  ASSERT_TRUE(ids.insert(5u));
+  ASSERT_EQ(3u, ids.size());
+  ASSERT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+  ASSERT_TRUE(ids.contains(5u));
+  ASSERT_FALSE(ids.contains(4u));
+  ASSERT_TRUE(ids.erase(3u));
+  ASSERT_FALSE(ids.erase(3u));
+  ASSERT_EQ(2u, ids.size());
+}
+
+TEST(flat_containers, small_set_spills_past_inline_capacity) {
+  SmallIdSet<uint32_t, 4u> ids;
+  std::set<uint32_t> reference;
+  // Insert in descending order so every insert shifts the buffer.
+  for (uint32_t i = 100u; i > 0u; --i) {
+    ASSERT_TRUE(ids.insert(i));
+    reference.insert(i);
+  }
+  ASSERT_EQ(reference.size(), ids.size());
+  ASSERT_TRUE(std::equal(ids.begin(), ids.end(), reference.begin()));
+  for (uint32_t i = 1u; i <= 100u; i += 2u) {
+    ASSERT_TRUE(ids.erase(i));
+  }
+  ASSERT_EQ(50u, ids.size());
+  ASSERT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+  ids.clear();
+  ASSERT_TRUE(ids.empty());
+  ASSERT_TRUE(ids.insert(42u));
+  ASSERT_TRUE(ids.contains(42u));
+}
+
+TEST(flat_containers, map_insert_find_erase) {
+  FlatHashMap<uint64_t, SmallIdSet<uint32_t>> map;
+  ASSERT_TRUE(map.empty());
+  map[10u].insert(1u);
+  map[10u].insert(2u);
+  map[20u].insert(3u);
+  ASSERT_EQ(2u, map.size());
+  auto *entry = map.Find(10u);
+  ASSERT_NE(nullptr, entry);
+  ASSERT_EQ(2u, entry->size());
+  ASSERT_EQ(nullptr, map.Find(30u));
+  ASSERT_TRUE(map.Erase(10u));
+  ASSERT_FALSE(map.Erase(10u));
+  ASSERT_EQ(nullptr, map.Find(10u));
+  ASSERT_NE(nullptr, map.Find(20u));
+  ASSERT_EQ(1u, map.size());
+}
+
+TEST(flat_containers, map_survives_rehash) {
+  FlatHashMap<uint64_t, SmallIdSet<uint32_t>> map;
+  // Push well past the initial capacity so the table rehashes repeatedly.
+  for (uint64_t key = 0u; key < 1000u; ++key) {
+    map[key].insert(static_cast<uint32_t>(key));
+  }
+  ASSERT_EQ(1000u, map.size());
+  for (uint64_t key = 0u; key < 1000u; ++key) {
+    auto *entry = map.Find(key);
+    ASSERT_NE(nullptr, entry);
+    ASSERT_TRUE(entry->contains(static_cast<uint32_t>(key)));
+  }
+}
+
+TEST(flat_containers, map_generational_clear) {
+  FlatHashMap<uint64_t, SmallIdSet<uint32_t>> map;
+  for (uint64_t key = 0u; key < 100u; ++key) {
+    map[key].insert(static_cast<uint32_t>(key));
+  }
+  map.Clear();
+  ASSERT_TRUE(map.empty());
+  for (uint64_t key = 0u; key < 100u; ++key) {
+    ASSERT_EQ(nullptr, map.Find(key));
+  }
+  // Reusing a slot after Clear must hand back an empty value, not the
+  // retired generation's contents.
+  map[5u].insert(99u);
+  auto *entry = map.Find(5u);
+  ASSERT_NE(nullptr, entry);
+  ASSERT_EQ(1u, entry->size());
+  ASSERT_TRUE(entry->contains(99u));
+}
+
+TEST(flat_containers, map_erase_heavy_churn) {
+  FlatHashMap<uint64_t, SmallIdSet<uint32_t>> map;
+  // Insert and erase in waves so tombstones pile up and force in-place
+  // rehashes without the live count ever growing.
+  for (uint64_t wave = 0u; wave < 100u; ++wave) {
+    for (uint64_t key = 0u; key < 16u; ++key) {
+      map[wave * 16u + key].insert(1u);
+    }
+    for (uint64_t key = 0u; key < 16u; ++key) {
+      ASSERT_TRUE(map.Erase(wave * 16u + key));
+    }
+  }
+  ASSERT_TRUE(map.empty());
+  map[7u].insert(2u);
+  ASSERT_NE(nullptr, map.Find(7u));
+}
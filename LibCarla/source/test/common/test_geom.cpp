@@ -11,6 +11,7 @@
 #include <carla/geom/BoundingBox.h>
 #include <carla/geom/Transform.h>
 #include <limits>
+#include <random>
 
 namespace carla {
 namespace geom {
@@ -196,6 +197,47 @@ TEST(geom, nearest_point_segment) {
   }
 }
 
+TEST(geom, nearest_point_segment_batch) {
+  std::mt19937 rng(42u);
+  std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+  std::vector<std::pair<Vector3D, Vector3D>> segments(64u);
+  for (auto &segment : segments) {
+    segment = {{coord(rng), coord(rng), 0.0f}, {coord(rng), coord(rng), 0.0f}};
+  }
+  // Degenerate segments must not divide by zero.
+  segments[17u].second = segments[17u].first;
+
+  for (int i = 0; i < 100; ++i) {
+    const Vector3D point(coord(rng), coord(rng), 0.0f);
+
+    size_t naive_id = 0u;
+    float naive_dist = std::numeric_limits<float>::max();
+    for (size_t j = 0u; j < segments.size(); ++j) {
+      const float dist = Math::DistanceSegmentToPoint(
+          point, segments[j].first, segments[j].second).second;
+      if (dist < naive_dist) {
+        naive_dist = dist;
+        naive_id = j;
+      }
+    }
+
+    const auto batch =
+        Math::NearestSegmentToPoint2D(point, segments.data(), segments.size());
+    ASSERT_EQ(batch.first, naive_id) << "Fails point number: " << i;
+    ASSERT_NEAR(std::sqrt(batch.second), naive_dist, 1e-3f);
+
+    const auto &segment = segments[i % segments.size()];
+    ASSERT_NEAR(
+        std::sqrt(Math::SquaredDistanceSegmentToPoint2D(point, segment.first, segment.second)),
+        Math::DistanceSegmentToPoint(point, segment.first, segment.second).second,
+        1e-3f);
+    ASSERT_NEAR(
+        Math::DistanceAlongSegment2D(point, segment.first, segment.second),
+        Math::DistanceSegmentToPoint(point, segment.first, segment.second).first,
+        1e-3f);
+  }
+}
+
 TEST(geom, forward_vector) {
   auto compare = [](Rotation rotation, Vector3D expected) {
     constexpr float eps = 2.0f * std::numeric_limits<float>::epsilon();
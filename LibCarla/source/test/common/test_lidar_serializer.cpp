@@ -0,0 +1,62 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/Buffer.h>
+#include <carla/sensor/data/LidarData.h>
+#include <carla/sensor/s11n/LidarSerializer.h>
+
+#include <vector>
+
+using namespace carla::sensor;
+using namespace carla::sensor::s11n;
+
+TEST(lidar_serializer, quantized_round_trip_centimeters) {
+  // Detections come in meters; the quantized wire format holds centimeters
+  // in 16-bit fixed point, so round-tripping a point may move it by at most
+  // half a centimeter per axis.
+  const std::vector<data::LidarDetection> detections = {
+      {1.234f, -5.678f, 0.005f, 0.25f},
+      {-0.011f, 42.503f, -17.329f, 0.75f},
+      {99.999f, -0.001f, 3.141f, 1.0f}};
+
+  auto writer = LidarSerializer::MakeWriter(carla::Buffer(), 1u, true);
+  writer.Reserve(static_cast<uint32_t>(detections.size()));
+  for (const auto &detection : detections) {
+    writer.WritePoint(0u, detection);
+  }
+  const auto buffer = writer.Finish();
+
+  // Horizontal angle, channel count and one per-channel point count.
+  const auto header_size = 3u * sizeof(uint32_t);
+  ASSERT_EQ(buffer.size(),
+      header_size + detections.size() * sizeof(QuantizedLidarDetection));
+
+  const auto *points = reinterpret_cast<const QuantizedLidarDetection *>(
+      buffer.data() + header_size);
+  for (auto i = 0u; i < detections.size(); ++i) {
+    ASSERT_NEAR(static_cast<float>(points[i].x) / 100.0f, detections[i].point.x, 0.005f);
+    ASSERT_NEAR(static_cast<float>(points[i].y) / 100.0f, detections[i].point.y, 0.005f);
+    ASSERT_NEAR(static_cast<float>(points[i].z) / 100.0f, detections[i].point.z, 0.005f);
+    ASSERT_NEAR(static_cast<float>(points[i].intensity) / 65535.0f,
+        detections[i].intensity, 1.0f / 65535.0f);
+  }
+}
+
+TEST(lidar_serializer, quantized_clamps_to_range) {
+  // Coordinates past +-327.67m saturate instead of wrapping around.
+  auto writer = LidarSerializer::MakeWriter(carla::Buffer(), 1u, true);
+  writer.WritePoint(0u, data::LidarDetection{1000.0f, -1000.0f, 327.67f, 0.0f});
+  const auto buffer = writer.Finish();
+
+  const auto header_size = 3u * sizeof(uint32_t);
+  const auto *point = reinterpret_cast<const QuantizedLidarDetection *>(
+      buffer.data() + header_size);
+  ASSERT_EQ(point->x, 32767);
+  ASSERT_EQ(point->y, -32768);
+  ASSERT_EQ(point->z, 32767);
+}
@@ -6,11 +6,13 @@
 
 #include "test.h"
 
+#include <carla/Iterator.h>
 #include <carla/ListView.h>
 
 #include <array>
 #include <cstring>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -40,6 +42,23 @@ TEST(listview, sequence) {
   TestSequence(MakeListView(set));
 }
 
+TEST(listview, sized_and_append) {
+  std::map<int, std::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+  auto values = carla::iterator::make_map_values_const_view(map);
+  ASSERT_EQ(3u, values.size());
+  std::vector<std::string> collected;
+  values.AppendTo(collected);
+  ASSERT_EQ(3u, collected.capacity()) << "AppendTo reserves the exact size";
+  ASSERT_EQ("one", collected[0u]);
+  auto keys = carla::iterator::make_map_keys_const_view(map);
+  std::vector<int> key_list;
+  keys.AppendTo(key_list);
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), key_list);
+  // Explicitly sized views report without walking the range.
+  auto view = MakeListView(map.begin(), map.end(), map.size());
+  ASSERT_EQ(3u, view.size());
+}
+
 TEST(listview, string) {
   std::string str = "Hello list view!";
   std::string result;
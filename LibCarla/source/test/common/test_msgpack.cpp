@@ -7,8 +7,11 @@
 #include "test.h"
 
 #include <carla/MsgPackAdaptors.h>
+#include <carla/geom/Transform.h>
+#include <carla/geom/Vector2D.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/Response.h>
+#include <carla/rpc/VehicleLightStateList.h>
 
 #include <thread>
 
@@ -105,3 +108,25 @@ TEST(msgpack, optional) {
   ASSERT_TRUE(result.has_value());
   ASSERT_EQ(*result, 42.0f);
 }
+
+TEST(msgpack, bin_vector) {
+  using mp = carla::MsgPack;
+
+  VehicleLightStateList lights;
+  for (auto i = 0u; i < 100u; ++i) {
+    lights.emplace_back(i, i * 3u);
+  }
+  auto lights_copy = mp::UnPack<decltype(lights)>(mp::Pack(lights));
+  ASSERT_TRUE(lights == lights_copy);
+
+  std::vector<carla::geom::Transform> spawn_points(42u);
+  spawn_points[7u].location.x = 1.0f;
+  spawn_points[7u].rotation.yaw = 90.0f;
+  auto points_copy = mp::UnPack<decltype(spawn_points)>(mp::Pack(spawn_points));
+  ASSERT_EQ(spawn_points.size(), points_copy.size());
+  ASSERT_TRUE(spawn_points[7u] == points_copy[7u]);
+
+  // Empty vectors survive the fast path too.
+  std::vector<carla::geom::Vector2D> empty;
+  ASSERT_TRUE(mp::UnPack<decltype(empty)>(mp::Pack(empty)).empty());
+}
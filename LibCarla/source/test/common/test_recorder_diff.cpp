@@ -0,0 +1,206 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/recorder/RecorderDiff.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using carla::recorder::DiffRecorderFiles;
+using carla::recorder::RecorderDiffOptions;
+
+namespace {
+
+#pragma pack(push, 1)
+  struct TestPosition {
+    uint32_t actor_id;
+    float location[3u];
+    float rotation[3u];
+  };
+
+  struct TestPositionDelta {
+    uint32_t actor_id;
+    int16_t location_delta[3u];
+    int16_t rotation_delta[3u];
+  };
+#pragma pack(pop)
+
+  /// Writes the subset of the CarlaRecorder on-disk format the diff reads:
+  /// the info header plus frame start/position/position delta/frame end
+  /// packets.
+  class RecordingBuilder {
+  public:
+
+    explicit RecordingBuilder(const std::string &map) {
+      Write<uint16_t>(1u);
+      WriteString("CARLA_RECORDER");
+      Write<int64_t>(0); // date.
+      WriteString(map);
+    }
+
+    void AddFrame(uint64_t id, double time, const std::vector<TestPosition> &positions) {
+      BeginFrame(id, time);
+      BeginPacket(6u); // position.
+      Write<uint16_t>(static_cast<uint16_t>(positions.size()));
+      for (const auto &position : positions) {
+        Write(position);
+      }
+      EndPacket();
+      EndFrame();
+    }
+
+    void AddDeltaFrame(uint64_t id, double time, const std::vector<TestPositionDelta> &deltas) {
+      BeginFrame(id, time);
+      BeginPacket(19u); // position delta.
+      Write<uint16_t>(static_cast<uint16_t>(deltas.size()));
+      for (const auto &delta : deltas) {
+        Write(delta);
+      }
+      EndPacket();
+      EndFrame();
+    }
+
+    void SaveTo(const std::string &path) const {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(_data.data(), static_cast<std::streamsize>(_data.size()));
+    }
+
+  private:
+
+    void BeginFrame(uint64_t id, double time) {
+      BeginPacket(0u); // frame start.
+      Write<uint64_t>(id);
+      Write<double>(0.1); // duration.
+      Write<double>(time);
+      EndPacket();
+    }
+
+    void EndFrame() {
+      BeginPacket(1u); // frame end.
+      EndPacket();
+    }
+
+    void BeginPacket(char id) {
+      Write<char>(id);
+      Write<uint32_t>(0u); // patched in EndPacket.
+      _packet_begin = _data.size();
+    }
+
+    void EndPacket() {
+      const auto size = static_cast<uint32_t>(_data.size() - _packet_begin);
+      std::memcpy(_data.data() + _packet_begin - sizeof(uint32_t), &size, sizeof(size));
+    }
+
+    template <typename T>
+    void Write(const T &value) {
+      const auto offset = _data.size();
+      _data.resize(offset + sizeof(T));
+      std::memcpy(_data.data() + offset, &value, sizeof(T));
+    }
+
+    void WriteString(const std::string &value) {
+      Write<uint16_t>(static_cast<uint16_t>(value.size()));
+      const auto offset = _data.size();
+      _data.resize(offset + value.size());
+      std::memcpy(_data.data() + offset, value.data(), value.size());
+    }
+
+    std::vector<char> _data;
+
+    size_t _packet_begin = 0u;
+  };
+
+  TestPosition MakePosition(uint32_t actor_id, float x, float yaw) {
+    return TestPosition{actor_id, {x, 0.0f, 0.0f}, {0.0f, yaw, 0.0f}};
+  }
+
+} // namespace
+
+TEST(recorder_diff, identical_recordings_match) {
+  const std::string lhs_path = "/tmp/carla_test_recorder_diff_a.log";
+  const std::string rhs_path = "/tmp/carla_test_recorder_diff_b.log";
+  for (const auto &path : {lhs_path, rhs_path}) {
+    RecordingBuilder builder("Town03");
+    for (auto frame = 1u; frame <= 10u; ++frame) {
+      builder.AddFrame(frame, 0.1 * frame, {
+          MakePosition(1u, 100.0f * frame, 0.0f),
+          MakePosition(2u, -50.0f * frame, 90.0f)});
+    }
+    builder.SaveTo(path);
+  }
+
+  const auto result = DiffRecorderFiles(lhs_path, rhs_path);
+  ASSERT_FALSE(result.HasDiverged()) << result.ToString();
+  ASSERT_EQ(result.frames_compared, 10u);
+  ASSERT_TRUE(result.divergences.empty());
+
+  std::remove(lhs_path.c_str());
+  std::remove(rhs_path.c_str());
+}
+
+TEST(recorder_diff, reports_first_divergent_frame) {
+  const std::string lhs_path = "/tmp/carla_test_recorder_diff_a.log";
+  const std::string rhs_path = "/tmp/carla_test_recorder_diff_b.log";
+  constexpr auto divergent_frame = 7u;
+
+  RecordingBuilder lhs("Town03");
+  RecordingBuilder rhs("Town03");
+  for (auto frame = 1u; frame <= 10u; ++frame) {
+    lhs.AddFrame(frame, 0.1 * frame, {MakePosition(1u, 100.0f * frame, 0.0f)});
+    // actor 1 drifts 25 cm off from frame 7 onwards.
+    const auto drift = (frame >= divergent_frame) ? 25.0f : 0.0f;
+    rhs.AddFrame(frame, 0.1 * frame, {MakePosition(1u, 100.0f * frame + drift, 0.0f)});
+  }
+  lhs.SaveTo(lhs_path);
+  rhs.SaveTo(rhs_path);
+
+  const auto result = DiffRecorderFiles(lhs_path, rhs_path);
+  ASSERT_TRUE(result.HasDiverged());
+  ASSERT_EQ(result.divergence_frame, divergent_frame);
+  ASSERT_FALSE(result.divergences.empty());
+  ASSERT_EQ(result.divergences.front().actor_id, 1u);
+  ASSERT_NEAR(result.divergences.front().location_delta, 25.0f, 0.01f);
+
+  std::remove(lhs_path.c_str());
+  std::remove(rhs_path.c_str());
+}
+
+TEST(recorder_diff, delta_records_compare_against_full_records) {
+  const std::string lhs_path = "/tmp/carla_test_recorder_diff_a.log";
+  const std::string rhs_path = "/tmp/carla_test_recorder_diff_b.log";
+
+  // One recording carries full positions each frame, the other the
+  // equivalent quantized deltas; the reconstruction must line them up
+  // within the delta quantization step.
+  RecordingBuilder lhs("Town03");
+  RecordingBuilder rhs("Town03");
+  lhs.AddFrame(1u, 0.1, {MakePosition(1u, 10.0f, 0.0f)});
+  rhs.AddFrame(1u, 0.1, {MakePosition(1u, 10.0f, 0.0f)});
+  for (auto frame = 2u; frame <= 5u; ++frame) {
+    lhs.AddFrame(frame, 0.1 * frame, {
+        MakePosition(1u, 10.0f + 0.5f * (frame - 1u), 1.0f * (frame - 1u))});
+    // 0.5 cm and 1 degree per frame, in 0.01 quantization steps.
+    rhs.AddDeltaFrame(frame, 0.1 * frame, {
+        TestPositionDelta{1u, {50, 0, 0}, {0, 100, 0}}});
+  }
+  lhs.SaveTo(lhs_path);
+  rhs.SaveTo(rhs_path);
+
+  RecorderDiffOptions options;
+  options.location_epsilon = 0.1f;
+  options.rotation_epsilon = 0.1f;
+  const auto result = DiffRecorderFiles(lhs_path, rhs_path, options);
+  ASSERT_FALSE(result.HasDiverged()) << result.ToString();
+  ASSERT_EQ(result.frames_compared, 5u);
+
+  std::remove(lhs_path.c_str());
+  std::remove(rhs_path.c_str());
+}
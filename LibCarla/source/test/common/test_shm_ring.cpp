@@ -0,0 +1,137 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/streaming/detail/shm/SharedMemoryRing.h>
+
+#ifndef _WIN32
+
+#include <boost/asio/buffer.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include <cstring>
+#include <string>
+
+using namespace carla::streaming::detail;
+using namespace carla::streaming::detail::shm;
+
+static void WriteFrame(RingWriter &writer, const std::string &payload) {
+  const auto size = static_cast<message_size_type>(payload.size());
+  std::array<boost::asio::const_buffer, 2u> buffers = {
+      boost::asio::buffer(&size, sizeof(size)),
+      boost::asio::buffer(payload)};
+  writer.Write(buffers.data(), buffers.size());
+}
+
+TEST(shm_ring, round_trip) {
+  const std::string name = "/carla.test.shm-round-trip";
+  auto writer = RingWriter::Create(name, 64u, 3u);
+  ASSERT_NE(writer, nullptr);
+  auto reader = RingReader::TryOpen(name);
+  ASSERT_NE(reader, nullptr);
+
+  RingReader::Frame frame;
+  ASSERT_FALSE(reader->PollFrame(frame));
+
+  const std::string payload = "hello shm";
+  WriteFrame(*writer, payload);
+
+  ASSERT_TRUE(reader->PollFrame(frame));
+  ASSERT_EQ(frame.size, sizeof(message_size_type) + payload.size());
+  const std::string received(
+      reinterpret_cast<const char *>(frame.data) + sizeof(message_size_type),
+      frame.size - sizeof(message_size_type));
+  ASSERT_EQ(received, payload);
+  ASSERT_TRUE(reader->IsFrameValid(frame));
+  ASSERT_FALSE(reader->PollFrame(frame));
+}
+
+TEST(shm_ring, lapped_frame_is_invalid) {
+  const std::string name = "/carla.test.shm-lapped";
+  constexpr auto slot_count = 3u;
+  auto writer = RingWriter::Create(name, 64u, slot_count);
+  ASSERT_NE(writer, nullptr);
+  auto reader = RingReader::TryOpen(name);
+  ASSERT_NE(reader, nullptr);
+
+  WriteFrame(*writer, "frame 1");
+  RingReader::Frame frame;
+  ASSERT_TRUE(reader->PollFrame(frame));
+  ASSERT_TRUE(reader->IsFrameValid(frame));
+
+  // Lap the ring so the writer reuses the slot the reader is holding: a
+  // consumer that copied the frame out must now discard the copy.
+  for (auto i = 0u; i < slot_count; ++i) {
+    WriteFrame(*writer, "overwritten");
+  }
+  ASSERT_FALSE(reader->IsFrameValid(frame));
+}
+
+TEST(shm_ring, in_progress_overwrite_invalidates_frame) {
+  const std::string name = "/carla.test.shm-in-progress";
+  constexpr auto slot_size = 64u;
+  auto writer = RingWriter::Create(name, slot_size, 3u);
+  ASSERT_NE(writer, nullptr);
+  auto reader = RingReader::TryOpen(name);
+  ASSERT_NE(reader, nullptr);
+
+  WriteFrame(*writer, "frame 1");
+  RingReader::Frame frame;
+  ASSERT_TRUE(reader->PollFrame(frame));
+  ASSERT_TRUE(reader->IsFrameValid(frame));
+
+  // Plant the writer's in-progress sentinel on the slot, as a writer that
+  // lapped the ring and is half-way through overwriting it would; the frame
+  // must read as invalid before the new sequence ever lands.
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  const auto mapped_size = sizeof(RingHeader) + 3u * (sizeof(FrameHeader) + slot_size);
+  auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ASSERT_NE(mapping, MAP_FAILED);
+  auto *header = reinterpret_cast<FrameHeader *>(
+      reinterpret_cast<uint8_t *>(mapping) + sizeof(RingHeader));
+  header->sequence.store(0u, std::memory_order_release);
+
+  ASSERT_FALSE(reader->IsFrameValid(frame));
+
+  ::munmap(mapping, mapped_size);
+  ::close(fd);
+}
+
+TEST(shm_ring, corrupted_size_is_clamped) {
+  const std::string name = "/carla.test.shm-corrupted";
+  constexpr auto slot_size = 64u;
+  auto writer = RingWriter::Create(name, slot_size, 3u);
+  ASSERT_NE(writer, nullptr);
+  auto reader = RingReader::TryOpen(name);
+  ASSERT_NE(reader, nullptr);
+
+  WriteFrame(*writer, "frame 1");
+
+  // Scribble a huge size over the published frame's header, as a racing or
+  // misbehaving writer could; the reader must never expose a size that
+  // would drive a copy past the slot.
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  const auto mapped_size = sizeof(RingHeader) + 3u * (sizeof(FrameHeader) + slot_size);
+  auto *mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ASSERT_NE(mapping, MAP_FAILED);
+  auto *header = reinterpret_cast<FrameHeader *>(
+      reinterpret_cast<uint8_t *>(mapping) + sizeof(RingHeader));
+  header->size.store(0xdeadbeefu, std::memory_order_relaxed);
+
+  RingReader::Frame frame;
+  ASSERT_TRUE(reader->PollFrame(frame));
+  ASSERT_EQ(frame.size, slot_size);
+
+  ::munmap(mapping, mapped_size);
+  ::close(fd);
+}
+
+#endif // _WIN32
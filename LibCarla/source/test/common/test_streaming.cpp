@@ -11,6 +11,7 @@
 #include <carla/streaming/Server.h>
 #include <carla/streaming/detail/Dispatcher.h>
 #include <carla/streaming/detail/tcp/Client.h>
+#include <carla/streaming/detail/tcp/Message.h>
 #include <carla/streaming/detail/tcp/Server.h>
 #include <carla/streaming/low_level/Client.h>
 #include <carla/streaming/low_level/Server.h>
@@ -172,6 +173,41 @@ TEST(streaming, low_level_tcp_small_message) {
   c->Stop();
 }
 
+TEST(streaming, message_views_small_buffers) {
+  using Message = carla::streaming::detail::tcp::Message;
+
+  // Payloads below Buffer::inline_capacity live inside the Buffer object
+  // itself, so moving the Buffer into the message relocates the bytes. The
+  // views a message exposes have to point at its own buffers, not at the
+  // moved-from temporaries.
+  const std::string header(8u, 'h');
+  const std::string payload(64u, 'p');
+  constexpr auto inline_capacity = carla::Buffer::inline_capacity;
+  ASSERT_LT(header.size() + payload.size(), inline_capacity);
+
+  auto message = std::make_shared<Message>(
+      carla::Buffer(header),
+      carla::Buffer(payload));
+  ASSERT_EQ(message->size(), header.size() + payload.size());
+
+  const char *message_begin = reinterpret_cast<const char *>(message.get());
+  const char *message_end = message_begin + sizeof(Message);
+
+  std::string wire;
+  for (auto &view : message->GetBufferSequence()) {
+    // Inline payloads must be viewed where they ended up, inside the
+    // message itself.
+    auto data = static_cast<const char *>(view.data());
+    ASSERT_TRUE((data >= message_begin) && (data + view.size() <= message_end));
+    wire.append(data, view.size());
+  }
+  const auto total_size =
+      static_cast<carla::streaming::detail::message_size_type>(message->size());
+  std::string expected(reinterpret_cast<const char *>(&total_size), sizeof(total_size));
+  expected += header + payload;
+  ASSERT_EQ(wire, expected);
+}
+
 struct DoneGuard {
   ~DoneGuard() { done = true; };
   std::atomic_bool &done;
@@ -0,0 +1,71 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StringIntern.h>
+#include <carla/StringUtil.h>
+
+#include <string>
+#include <vector>
+
+using carla::GlobPattern;
+using carla::InternedString;
+using carla::StringUtil;
+
+TEST(string_util, glob_pattern_matches_like_fnmatch) {
+  const std::vector<std::string> candidates = {
+      "vehicle.tesla.model3",
+      "vehicle.audi.tt",
+      "walker.pedestrian.0001",
+      "sensor.camera.rgb",
+      "vehicle",
+      ""};
+  const std::vector<std::string> patterns = {
+      "vehicle.*",
+      "*",
+      "*.tesla.*",
+      "vehicle.?esla.model3",
+      "sensor.camera.rgb",
+      "*.model[0-9]",
+      "*.model[!0-9]",
+      "vehicle",
+      "[abv]ehicle",
+      "*.t*"};
+  for (const auto &pattern : patterns) {
+    const GlobPattern compiled(pattern);
+    for (const auto &candidate : candidates) {
+      ASSERT_EQ(StringUtil::Match(candidate, pattern), compiled.Match(candidate))
+          << "pattern '" << pattern << "' candidate '" << candidate << "'";
+    }
+  }
+}
+
+TEST(string_util, glob_pattern_edge_cases) {
+  // Runs of stars collapse and still match.
+  ASSERT_TRUE(GlobPattern("veh**le.*").Match("vehicle.tesla.model3"));
+  // Empty pattern matches only the empty string.
+  ASSERT_TRUE(GlobPattern("").Match(""));
+  ASSERT_FALSE(GlobPattern("").Match("x"));
+  // Unclosed bracket falls back to a literal '['.
+  ASSERT_TRUE(GlobPattern("a[b").Match("a[b"));
+  ASSERT_FALSE(GlobPattern("a[b").Match("ab"));
+}
+
+TEST(string_util, interned_strings_share_one_id) {
+  const InternedString first("vehicle.tesla.model3");
+  const InternedString second(std::string("vehicle.tesla.model3"));
+  const InternedString other("vehicle.audi.tt");
+  ASSERT_EQ(first.GetId(), second.GetId());
+  ASSERT_TRUE(first == second);
+  ASSERT_TRUE(first != other);
+  ASSERT_EQ("vehicle.tesla.model3", first.Get());
+  // The stored characters live at one stable address.
+  ASSERT_EQ(&first.Get(), &second.Get());
+  // The default handle is the interned empty string.
+  ASSERT_EQ(0u, InternedString().GetId());
+  ASSERT_EQ("", InternedString().Get());
+}
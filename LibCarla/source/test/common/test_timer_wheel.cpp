@@ -0,0 +1,70 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/streaming/detail/TimerWheel.h>
+
+#include <boost/asio/io_context.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using carla::time_duration;
+using carla::streaming::detail::TimerWheel;
+
+// Generous sleep compared to the wheel resolution so the test is not flaky
+// on loaded machines.
+static void WaitForWheel() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+}
+
+TEST(timer_wheel, fires_once_per_arm) {
+  boost::asio::io_context io_context;
+  auto wheel = std::make_shared<TimerWheel>(io_context);
+  std::atomic<int> fired{0};
+  auto timer = wheel->MakeTimer([&fired]() { ++fired; });
+  wheel->Arm(timer, time_duration::milliseconds(100u));
+  std::thread worker([&io_context]() { io_context.run(); });
+  WaitForWheel();
+  ASSERT_EQ(1, fired) << "timer is one-shot until re-armed";
+  wheel->Arm(timer, time_duration::milliseconds(100u));
+  WaitForWheel();
+  ASSERT_EQ(2, fired);
+  timer.reset();
+  wheel.reset();
+  worker.join();
+}
+
+TEST(timer_wheel, cancel_and_rearm) {
+  boost::asio::io_context io_context;
+  auto wheel = std::make_shared<TimerWheel>(io_context);
+  std::atomic<int> fired{0};
+  auto timer = wheel->MakeTimer([&fired]() { ++fired; });
+  std::thread worker([&io_context]() { io_context.run(); });
+  wheel->Arm(timer, time_duration::milliseconds(100u));
+  wheel->Cancel(timer);
+  WaitForWheel();
+  ASSERT_EQ(0, fired) << "cancelled timer must not fire";
+  // Re-arming repeatedly keeps pushing the deadline, only the last one counts.
+  for (auto i = 0u; i < 5u; ++i) {
+    wheel->Arm(timer, time_duration::milliseconds(100u));
+  }
+  WaitForWheel();
+  ASSERT_EQ(1, fired);
+  timer.reset();
+  wheel.reset();
+  worker.join();
+}
+
+TEST(timer_wheel, one_wheel_per_io_context) {
+  boost::asio::io_context first;
+  boost::asio::io_context second;
+  auto wheel = TimerWheel::SharedForContext(first);
+  ASSERT_EQ(wheel, TimerWheel::SharedForContext(first));
+  ASSERT_NE(wheel, TimerWheel::SharedForContext(second));
+}
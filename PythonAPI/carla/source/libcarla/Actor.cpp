@@ -146,6 +146,8 @@ void export_actor() {
       .add_property("bounding_box", CALL_RETURNING_COPY(cc::Walker, GetBoundingBox))
       .def("apply_control", &ApplyControl<cr::WalkerControl>, (arg("control")))
       .def("apply_control", &ApplyControl<cr::WalkerBoneControl>, (arg("control")))
+      .def("apply_control", &ApplyControl<cr::WalkerBonePose>, (arg("control")))
+      .def("get_bone_names", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Walker, GetBoneNames))
       .def("get_control", &cc::Walker::GetWalkerControl)
       .def(self_ns::str(self_ns::self))
   ;
@@ -8,7 +8,9 @@
 #include "carla/client/Client.h"
 #include "carla/client/World.h"
 #include "carla/Logging.h"
+#include "carla/recorder/RecorderDiff.h"
 #include "carla/rpc/ActorId.h"
+#include "carla/rpc/CommandBuffer.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
 #include <thread>
@@ -17,10 +19,49 @@
 
 namespace ctm = carla::traffic_manager;
 
+static auto ReplayBatch(
+    carla::client::Client &self,
+    const boost::python::object &names,
+    double time_factor) {
+  std::vector<std::string> files{
+    boost::python::stl_input_iterator<std::string>(names),
+    boost::python::stl_input_iterator<std::string>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.ReplayBatch(std::move(files), time_factor);
+}
+
 static void SetTimeout(carla::client::Client &client, double seconds) {
   client.SetTimeout(TimeDurationFromSeconds(seconds));
 }
 
+static auto DiffRecorderFiles(
+    const std::string &file1,
+    const std::string &file2,
+    float location_epsilon,
+    float rotation_epsilon) {
+  carla::recorder::RecorderDiffOptions options;
+  options.location_epsilon = location_epsilon;
+  options.rotation_epsilon = rotation_epsilon;
+  carla::PythonUtil::ReleaseGIL unlock;
+  return carla::recorder::DiffRecorderFiles(file1, file2, options);
+}
+
+static auto GetRecorderDivergences(const carla::recorder::RecorderDiffResult &self) {
+  boost::python::list result;
+  for (const auto &divergence : self.divergences) {
+    result.append(divergence);
+  }
+  return result;
+}
+
+static auto GetRecorderDiffNotes(const carla::recorder::RecorderDiffResult &self) {
+  boost::python::list result;
+  for (const auto &note : self.notes) {
+    result.append(note);
+  }
+  return result;
+}
+
 static auto GetAvailableMaps(const carla::client::Client &self) {
   carla::PythonUtil::ReleaseGIL unlock;
   boost::python::list result;
@@ -52,8 +93,11 @@ static auto ApplyBatchCommandsSync(
     boost::python::stl_input_iterator<CommandType>()
   };
 
+  auto responses = [&]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.ApplyBatchSync(cmds, do_tick);
+  }();
   boost::python::list result;
-  auto responses = self.ApplyBatchSync(cmds, do_tick);
   for (auto &response : responses) {
     result.append(std::move(response));
   }
@@ -157,6 +201,59 @@ static auto ApplyBatchCommandsSync(
   return result;
 }
 
+static void ApplyCommandBuffer(
+    const carla::client::Client &self,
+    const carla::rpc::CommandBuffer &commands,
+    bool do_tick) {
+  carla::PythonUtil::ReleaseGIL unlock;
+  self.ApplyBatch(commands, do_tick);
+}
+
+// Unlike ApplyBatchCommandsSync this does not scan the batch for deprecated
+// SetAutopilot commands; use the traffic manager API to register vehicles.
+static auto ApplyCommandBufferSync(
+    const carla::client::Client &self,
+    const carla::rpc::CommandBuffer &commands,
+    bool do_tick) {
+  auto responses = [&]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.ApplyBatchSync(commands, do_tick);
+  }();
+  boost::python::list result;
+  for (auto &response : responses) {
+    result.append(std::move(response));
+  }
+  return result;
+}
+
+static auto ApplyBatchCommandsAtFrame(
+    const carla::client::Client &self,
+    const boost::python::object &commands,
+    uint64_t target_frame) {
+  using CommandType = carla::rpc::Command;
+  std::vector<CommandType> cmds {
+    boost::python::stl_input_iterator<CommandType>(commands),
+    boost::python::stl_input_iterator<CommandType>()
+  };
+  return self.ApplyBatchAtFrame(std::move(cmds), target_frame);
+}
+
+static auto SpawnActorsBatch(
+    const carla::client::Client &self,
+    const boost::python::object &commands) {
+  using CommandType = carla::rpc::Command::SpawnActor;
+  std::vector<CommandType> cmds {
+    boost::python::stl_input_iterator<CommandType>(commands),
+    boost::python::stl_input_iterator<CommandType>()
+  };
+
+  boost::python::list result;
+  for (auto &response : self.SpawnActors(std::move(cmds))) {
+    result.append(std::move(response));
+  }
+  return result;
+}
+
 void export_client() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -173,11 +270,56 @@ void export_client() {
     .def_readwrite("enable_pedestrian_navigation", &rpc::OpendriveGenerationParameters::enable_pedestrian_navigation)
   ;
 
+  class_<rpc::FrameStats>("FrameStats", no_init)
+    .def_readonly("frame", &rpc::FrameStats::frame)
+    .def_readonly("window_frames", &rpc::FrameStats::window_frames)
+    .def_readonly("fps", &rpc::FrameStats::fps)
+    .def_readonly("game_ms_avg", &rpc::FrameStats::game_ms_avg)
+    .def_readonly("game_ms_max", &rpc::FrameStats::game_ms_max)
+    .def_readonly("render_ms_avg", &rpc::FrameStats::render_ms_avg)
+    .def_readonly("render_ms_max", &rpc::FrameStats::render_ms_max)
+    .def_readonly("gpu_ms_avg", &rpc::FrameStats::gpu_ms_avg)
+    .def_readonly("gpu_ms_max", &rpc::FrameStats::gpu_ms_max)
+    .def_readonly("rhi_ms_avg", &rpc::FrameStats::rhi_ms_avg)
+    .def_readonly("rhi_ms_max", &rpc::FrameStats::rhi_ms_max)
+    .def_readonly("sensor_ms_avg", &rpc::FrameStats::sensor_ms_avg)
+    .def_readonly("sensor_ms_max", &rpc::FrameStats::sensor_ms_max)
+    .def_readonly("physics_substeps_avg", &rpc::FrameStats::physics_substeps_avg)
+    .def_readonly("physics_substeps_max", &rpc::FrameStats::physics_substeps_max)
+  ;
+
+  namespace rec = carla::recorder;
+
+  class_<rec::RecorderDivergence>("RecorderDivergence", no_init)
+    .def_readonly("frame", &rec::RecorderDivergence::frame)
+    .def_readonly("time", &rec::RecorderDivergence::time)
+    .def_readonly("actor_id", &rec::RecorderDivergence::actor_id)
+    .def_readonly("location_delta", &rec::RecorderDivergence::location_delta)
+    .def_readonly("rotation_delta", &rec::RecorderDivergence::rotation_delta)
+  ;
+
+  class_<rec::RecorderDiffResult>("RecorderDiffResult", no_init)
+    .def_readonly("frames_compared", &rec::RecorderDiffResult::frames_compared)
+    .def_readonly("divergence_frame", &rec::RecorderDiffResult::divergence_frame)
+    .def_readonly("divergence_time", &rec::RecorderDiffResult::divergence_time)
+    .add_property("divergences", &GetRecorderDivergences)
+    .add_property("notes", &GetRecorderDiffNotes)
+    .def("has_diverged", &rec::RecorderDiffResult::HasDiverged)
+    .def("__str__", &rec::RecorderDiffResult::ToString)
+  ;
+
+  // Runs locally on the client, no simulator involved: both files are read
+  // from this machine's filesystem.
+  def("diff_recorder_files", &::DiffRecorderFiles,
+      (arg("file1"), arg("file2"),
+       arg("location_epsilon")=1.0f, arg("rotation_epsilon")=1.0f));
+
   class_<cc::Client>("Client",
       init<std::string, uint16_t, size_t>((arg("host"), arg("port"), arg("worker_threads")=0u)))
     .def("set_timeout", &::SetTimeout, (arg("seconds")))
     .def("get_client_version", &cc::Client::GetClientVersion)
     .def("get_server_version", CONST_CALL_WITHOUT_GIL(cc::Client, GetServerVersion))
+    .def("get_frame_stats", CONST_CALL_WITHOUT_GIL(cc::Client, GetFrameStats))
     .def("get_world", &cc::Client::GetWorld)
     .def("get_available_maps", &GetAvailableMaps)
     .def("reload_world", CONST_CALL_WITHOUT_GIL(cc::Client, ReloadWorld))
@@ -190,11 +332,18 @@ void export_client() {
     .def("show_recorder_collisions", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderCollisions, std::string, char, char), (arg("name"), arg("type1"), arg("type2")))
     .def("show_recorder_actors_blocked", CALL_WITHOUT_GIL_3(cc::Client, ShowRecorderActorsBlocked, std::string, double, double), (arg("name"), arg("min_time"), arg("min_distance")))
     .def("replay_file", CALL_WITHOUT_GIL_4(cc::Client, ReplayFile, std::string, double, double, uint32_t), (arg("name"), arg("time_start"), arg("duration"), arg("follow_id")))
+    .def("replay_batch", &ReplayBatch, (arg("names"), arg("time_factor")=1.0))
     .def("stop_replayer", &cc::Client::StopReplayer, (arg("keep_actors")))
     .def("set_replayer_time_factor", &cc::Client::SetReplayerTimeFactor, (arg("time_factor")))
     .def("set_replayer_ignore_hero", &cc::Client::SetReplayerIgnoreHero, (arg("ignore_hero")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
     .def("apply_batch_sync", &ApplyBatchCommandsSync, (arg("commands"), arg("do_tick")=false))
+    // Registered after the list versions so a CommandBuffer matches these
+    // overloads before the generic object one.
+    .def("apply_batch", &ApplyCommandBuffer, (arg("commands"), arg("do_tick")=false))
+    .def("apply_batch_sync", &ApplyCommandBufferSync, (arg("commands"), arg("do_tick")=false))
+    .def("apply_batch_at_frame", &ApplyBatchCommandsAtFrame, (arg("commands"), arg("target_frame")))
+    .def("spawn_actors", &SpawnActorsBatch, (arg("commands")))
     .def("get_trafficmanager", CONST_CALL_WITHOUT_GIL_1(cc::Client, GetInstanceTM, uint16_t), (arg("port")=ctm::TM_DEFAULT_PORT))
   ;
 }
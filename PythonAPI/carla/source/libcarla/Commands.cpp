@@ -6,6 +6,7 @@
 
 #include <carla/PythonUtil.h>
 #include <carla/rpc/Command.h>
+#include <carla/rpc/CommandBuffer.h>
 #include <carla/rpc/CommandResponse.h>
 
 #define TM_DEFAULT_PORT     8000
@@ -194,6 +195,14 @@ void export_commands() {
     .def_readwrite("light_state", &cr::Command::SetVehicleLightState::light_state)
   ;
 
+  class_<cr::CommandBuffer, boost::noncopyable>("CommandBuffer")
+    .def("add", +[](cr::CommandBuffer &self, cr::Command command) {
+      self.Add(command);
+    }, (arg("command")))
+    .def("clear", &cr::CommandBuffer::Clear)
+    .def("__len__", &cr::CommandBuffer::size)
+  ;
+
   implicitly_convertible<cr::Command::SpawnActor, cr::Command>();
   implicitly_convertible<cr::Command::DestroyActor, cr::Command>();
   implicitly_convertible<cr::Command::ApplyVehicleControl, cr::Command>();
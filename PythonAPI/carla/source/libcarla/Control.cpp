@@ -10,6 +10,9 @@
 #include <carla/rpc/WheelPhysicsControl.h>
 #include <carla/rpc/WalkerControl.h>
 #include <carla/rpc/WalkerBoneControl.h>
+#include <carla/rpc/WalkerBonePose.h>
+
+#include <boost/python/stl_iterator.hpp>
 
 #include <ostream>
 
@@ -48,6 +51,11 @@ namespace rpc {
     return out;
   }
 
+  std::ostream &operator<<(std::ostream &out, const WalkerBonePose &pose) {
+    out << "WalkerBonePose(bones=" << std::to_string(pose.bones.size()) << ')';
+    return out;
+  }
+
   std::ostream &operator<<(std::ostream &out, const GearPhysicsControl &control) {
     out << "GearPhysicsControl(ratio=" << std::to_string(control.ratio)
         << ", down_ratio=" << std::to_string(control.down_ratio)
@@ -261,6 +269,65 @@ boost::python::object WalkerBoneControl_init(boost::python::tuple args, boost::p
   return res;
 }
 
+static auto GetBonePoseBones(const carla::rpc::WalkerBonePose &self) {
+  boost::python::list result;
+  for (auto bone : self.bones) {
+    result.append(bone);
+  }
+  return result;
+}
+
+static void SetBonePoseBones(
+    carla::rpc::WalkerBonePose &self,
+    const boost::python::object &bones) {
+  self.bones.assign(
+      boost::python::stl_input_iterator<uint32_t>(bones),
+      boost::python::stl_input_iterator<uint32_t>());
+}
+
+static auto GetBonePosePose(const carla::rpc::WalkerBonePose &self) {
+  boost::python::list result;
+  for (auto value : self.pose) {
+    result.append(value);
+  }
+  return result;
+}
+
+static void SetBonePosePose(
+    carla::rpc::WalkerBonePose &self,
+    const boost::python::object &pose) {
+  self.pose.assign(
+      boost::python::stl_input_iterator<float>(pose),
+      boost::python::stl_input_iterator<float>());
+}
+
+boost::python::object WalkerBonePose_init(boost::python::tuple args, boost::python::dict kwargs) {
+  // Args names
+  const uint32_t NUM_ARGUMENTS = 2;
+  const char *args_names[NUM_ARGUMENTS] = {
+    "bones",
+    "pose"
+  };
+
+  boost::python::object self = args[0];
+  args = boost::python::tuple(args.slice(1, boost::python::_));
+
+  auto res = self.attr("__init__")();
+  if (len(args) > 0) {
+    for (unsigned int i = 0; i < len(args); ++i) {
+      self.attr(args_names[i]) = args[i];
+    }
+  }
+
+  for (unsigned int i = 0; i < NUM_ARGUMENTS; ++i) {
+    if (kwargs.contains(args_names[i])) {
+      self.attr(args_names[i]) = kwargs[args_names[i]];
+    }
+  }
+
+  return res;
+}
+
 void export_control() {
   using namespace boost::python;
   namespace cg = carla::geom;
@@ -307,6 +374,14 @@ void export_control() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<cr::WalkerBonePose>("WalkerBonePose")
+    .def("__init__", raw_function(WalkerBonePose_init))
+    .def(init<>())
+    .add_property("bones", &GetBonePoseBones, &SetBonePoseBones)
+    .add_property("pose", &GetBonePosePose, &SetBonePosePose)
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<std::vector<cr::GearPhysicsControl>>("vector_of_gears")
       .def(boost::python::vector_indexing_suite<std::vector<cr::GearPhysicsControl>>())
       .def(self_ns::str(self_ns::self))
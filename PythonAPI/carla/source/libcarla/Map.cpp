@@ -44,7 +44,10 @@ static void SaveOpenDriveToDisk(const carla::client::Map &self, std::string path
 
 static auto GetTopology(const carla::client::Map &self) {
   namespace py = boost::python;
-  auto topology = self.GetTopology();
+  const auto topology = [&]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.GetTopology();
+  }();
   py::list result;
   for (auto &&pair : topology) {
     result.append(py::make_tuple(pair.first, pair.second));
@@ -62,6 +65,46 @@ static auto GetJunctionWaypoints(const carla::client::Junction &self, const carl
   return result;
 }
 
+static auto GetWaypointBatch(
+    const carla::client::Map &self,
+    const boost::python::object &locations,
+    bool project_to_road,
+    uint32_t lane_type) {
+  namespace py = boost::python;
+  std::vector<carla::geom::Location> locs {
+    py::stl_input_iterator<carla::geom::Location>(locations),
+    py::stl_input_iterator<carla::geom::Location>()
+  };
+  std::vector<carla::SharedPtr<carla::client::Waypoint>> waypoints;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    waypoints = self.GetWaypoints(locs, project_to_road, lane_type);
+  }
+  py::list result;
+  for (auto &waypoint : waypoints) {
+    result.append(waypoint);
+  }
+  return result;
+}
+
+static auto TraceRoute(
+    const carla::client::Map &self,
+    const carla::geom::Location &origin,
+    const carla::geom::Location &destination,
+    double sampling_resolution) {
+  namespace py = boost::python;
+  std::vector<carla::SharedPtr<carla::client::Waypoint>> waypoints;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    waypoints = self.TraceRoute(origin, destination, sampling_resolution);
+  }
+  py::list result;
+  for (auto &waypoint : waypoints) {
+    result.append(waypoint);
+  }
+  return result;
+}
+
 static auto GetLaneValidities(const carla::client::Landmark &self){
   namespace py = boost::python;
   auto &validities = self.GetValidities();
@@ -157,11 +200,13 @@ void export_map() {
   class_<cc::Map, boost::noncopyable, boost::shared_ptr<cc::Map>>("Map", no_init)
     .def(init<std::string, std::string>((arg("name"), arg("xodr_content"))))
     .add_property("name", CALL_RETURNING_COPY(cc::Map, GetName))
-    .def("get_spawn_points", CALL_RETURNING_LIST(cc::Map, GetRecommendedSpawnPoints))
+    .def("get_spawn_points", CALL_RETURNING_LIST_WITHOUT_GIL(cc::Map, GetRecommendedSpawnPoints))
     .def("get_waypoint", &cc::Map::GetWaypoint, (arg("location"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
+    .def("get_waypoints", &GetWaypointBatch, (arg("locations"), arg("project_to_road")=true, arg("lane_type")=cr::Lane::LaneType::Driving))
     .def("get_waypoint_xodr", &cc::Map::GetWaypointXODR, (arg("road_id"), arg("lane_id"), arg("s")))
     .def("get_topology", &GetTopology)
-    .def("generate_waypoints", CALL_RETURNING_LIST_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("generate_waypoints", CALL_RETURNING_LIST_WITHOUT_GIL_1(cc::Map, GenerateWaypoints, double), (args("distance")))
+    .def("trace_route", &TraceRoute, (arg("origin"), arg("destination"), arg("sampling_resolution")=2.0))
     .def("transform_to_geolocation", &ToGeolocation, (arg("location")))
     .def("to_opendrive", CALL_RETURNING_COPY(cc::Map, GetOpenDrive))
     .def("save_to_disk", &SaveOpenDriveToDisk, (arg("path")=""))
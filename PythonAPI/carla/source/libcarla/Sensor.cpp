@@ -9,6 +9,7 @@
 #include <carla/client/LaneInvasionSensor.h>
 #include <carla/client/Sensor.h>
 #include <carla/client/ServerSideSensor.h>
+#include <carla/rpc/SensorTiming.h>
 
 static void SubscribeToStream(carla::client::Sensor &self, boost::python::object callback) {
   self.Listen(MakeCallback(std::move(callback)));
@@ -17,6 +18,15 @@ static void SubscribeToStream(carla::client::Sensor &self, boost::python::object
 void export_sensor() {
   using namespace boost::python;
   namespace cc = carla::client;
+  namespace cr = carla::rpc;
+
+  class_<cr::SensorTiming>("SensorTiming", no_init)
+    .def_readonly("capture_seconds", &cr::SensorTiming::capture_seconds)
+    .def_readonly("serialization_seconds", &cr::SensorTiming::serialization_seconds)
+    .def_readonly("transmission_seconds", &cr::SensorTiming::transmission_seconds)
+    .def_readonly("measurement_count", &cr::SensorTiming::measurement_count)
+    .def_readonly("throttled_count", &cr::SensorTiming::throttled_count)
+  ;
 
   class_<cc::Sensor, bases<cc::Actor>, boost::noncopyable, boost::shared_ptr<cc::Sensor>>("Sensor", no_init)
     .add_property("is_listening", &cc::Sensor::IsListening)
@@ -27,6 +37,7 @@ void export_sensor() {
 
   class_<cc::ServerSideSensor, bases<cc::Sensor>, boost::noncopyable, boost::shared_ptr<cc::ServerSideSensor>>
       ("ServerSideSensor", no_init)
+    .def("get_timing", CONST_CALL_WITHOUT_GIL(cc::ServerSideSensor, GetTiming))
     .def(self_ns::str(self_ns::self))
   ;
 
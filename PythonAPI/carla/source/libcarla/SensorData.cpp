@@ -15,6 +15,7 @@
 #include <carla/sensor/data/ObstacleDetectionEvent.h>
 #include <carla/sensor/data/Image.h>
 #include <carla/sensor/data/LaneInvasionEvent.h>
+#include <carla/sensor/data/MultiImage.h>
 #include <carla/sensor/data/LidarMeasurement.h>
 #include <carla/sensor/data/SemanticLidarMeasurement.h>
 #include <carla/sensor/data/GnssMeasurement.h>
@@ -25,6 +26,7 @@
 
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+#include <cstdint>
 #include <ostream>
 #include <iostream>
 
@@ -40,6 +42,15 @@ namespace data {
     return out;
   }
 
+  std::ostream &operator<<(std::ostream &out, const MultiImage &images) {
+    out << "MultiImage(frame=" << std::to_string(images.GetFrame())
+        << ", timestamp=" << std::to_string(images.GetTimestamp())
+        << ", size=" << std::to_string(images.GetWidth()) << 'x' << std::to_string(images.GetHeight())
+        << ", images=" << std::to_string(images.GetImageCount())
+        << ')';
+    return out;
+  }
+
   std::ostream &operator<<(std::ostream &out, const LidarMeasurement &meas) {
     out << "LidarMeasurement(frame=" << std::to_string(meas.GetFrame())
         << ", timestamp=" << std::to_string(meas.GetTimestamp())
@@ -165,10 +176,7 @@ enum class EColorConverter {
   CityScapesPalette
 };
 
-template <typename T>
-static auto GetRawDataAsBuffer(T &self) {
-  auto *data = reinterpret_cast<unsigned char *>(self.data());
-  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * self.size());
+static boost::python::object MakeRawDataMemoryView(unsigned char *data, Py_ssize_t size) {
 #if PY_MAJOR_VERSION >= 3
   auto *ptr = PyMemoryView_FromMemory(reinterpret_cast<char *>(data), size, PyBUF_READ);
 #else
@@ -177,6 +185,31 @@ static auto GetRawDataAsBuffer(T &self) {
   return boost::python::object(boost::python::handle<>(ptr));
 }
 
+template <typename T>
+static auto GetRawDataAsBuffer(T &self) {
+  auto *data = reinterpret_cast<unsigned char *>(self.data());
+  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * self.size());
+  return MakeRawDataMemoryView(data, size);
+}
+
+/// Describe the memory of a measurement following numpy's array interface
+/// (version 3), so ``np.asarray(measurement)`` wraps the received buffer
+/// without copying it. Numpy keeps the measurement alive through the
+/// resulting array's base object, so the memory remains valid for as long
+/// as the array does.
+static boost::python::dict MakeArrayInterface(
+    const void *data,
+    boost::python::tuple shape,
+    std::string typestr) {
+  boost::python::dict interface;
+  interface["version"] = 3;
+  interface["shape"] = shape;
+  interface["typestr"] = typestr;
+  interface["data"] = boost::python::make_tuple(
+      reinterpret_cast<std::uintptr_t>(data), false);
+  return interface;
+}
+
 template <typename T>
 static void ConvertImage(T &self, EColorConverter cc) {
   carla::PythonUtil::ReleaseGIL unlock;
@@ -245,6 +278,12 @@ void export_sensor_data() {
     .add_property("frame_number", &cs::SensorData::GetFrame) // deprecated.
     .add_property("timestamp", &cs::SensorData::GetTimestamp)
     .add_property("transform", CALL_RETURNING_COPY(cs::SensorData, GetSensorTransform))
+    .add_property("trace_id", &cs::SensorData::GetTraceId)
+    .add_property("capture_time_us", &cs::SensorData::GetCaptureTimeUs)
+    .add_property("serialize_time_us", &cs::SensorData::GetSerializeTimeUs)
+    .add_property("send_time_us", &cs::SensorData::GetSendTimeUs)
+    .add_property("receive_time_us", &cs::SensorData::GetReceiveTimeUs)
+    .add_property("deserialize_time_us", &cs::SensorData::GetDeserializeTimeUs)
   ;
 
   enum_<EColorConverter>("ColorConverter")
@@ -259,6 +298,12 @@ void export_sensor_data() {
     .add_property("height", &csd::Image::GetHeight)
     .add_property("fov", &csd::Image::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::Image>)
+    .add_property("__array_interface__", +[](const csd::Image &self) {
+      return MakeArrayInterface(
+          self.data(),
+          boost::python::make_tuple(self.GetHeight(), self.GetWidth(), 4u),
+          "|u1");
+    })
     .def("convert", &ConvertImage<csd::Image>, (arg("color_converter")))
     .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw))
     .def("__len__", &csd::Image::size)
@@ -272,10 +317,32 @@ void export_sensor_data() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<csd::MultiImage, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::MultiImage>>("MultiImage", no_init)
+    .add_property("width", &csd::MultiImage::GetWidth)
+    .add_property("height", &csd::MultiImage::GetHeight)
+    .add_property("fov", &csd::MultiImage::GetFOVAngle)
+    .add_property("image_count", &csd::MultiImage::GetImageCount)
+    .add_property("raw_data", &GetRawDataAsBuffer<csd::MultiImage>)
+    .add_property("__array_interface__", +[](const csd::MultiImage &self) {
+      return MakeArrayInterface(
+          self.data(),
+          boost::python::make_tuple(self.GetImageCount(), self.GetHeight(), self.GetWidth(), 4u),
+          "|u1");
+    })
+    .def("__len__", &csd::MultiImage::size)
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<csd::LidarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::LidarMeasurement>>("LidarMeasurement", no_init)
     .add_property("horizontal_angle", &csd::LidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::LidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarMeasurement>)
+    .add_property("__array_interface__", +[](const csd::LidarMeasurement &self) {
+      return MakeArrayInterface(
+          self.data(),
+          boost::python::make_tuple(self.size(), 4u),
+          "<f4");
+    })
     .def("get_point_count", &csd::LidarMeasurement::GetPointCount, (arg("channel")))
     .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path")))
     .def("__len__", &csd::LidarMeasurement::size)
@@ -293,6 +360,21 @@ void export_sensor_data() {
     .add_property("horizontal_angle", &csd::SemanticLidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::SemanticLidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::SemanticLidarMeasurement>)
+    .add_property("__array_interface__", +[](const csd::SemanticLidarMeasurement &self) {
+      auto interface = MakeArrayInterface(
+          self.data(),
+          boost::python::make_tuple(self.size()),
+          "|V" + std::to_string(sizeof(csd::SemanticLidarDetection)));
+      boost::python::list descr;
+      descr.append(boost::python::make_tuple("x", "<f4"));
+      descr.append(boost::python::make_tuple("y", "<f4"));
+      descr.append(boost::python::make_tuple("z", "<f4"));
+      descr.append(boost::python::make_tuple("CosAngle", "<f4"));
+      descr.append(boost::python::make_tuple("ObjIdx", "<u4"));
+      descr.append(boost::python::make_tuple("ObjTag", "<u4"));
+      interface["descr"] = descr;
+      return interface;
+    })
     .def("get_point_count", &csd::SemanticLidarMeasurement::GetPointCount, (arg("channel")))
     .def("save_to_disk", &SavePointCloudToDisk<csd::SemanticLidarMeasurement>, (arg("path")))
     .def("__len__", &csd::SemanticLidarMeasurement::size)
@@ -342,6 +424,12 @@ void export_sensor_data() {
 
   class_<csd::RadarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::RadarMeasurement>>("RadarMeasurement", no_init)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::RadarMeasurement>)
+    .add_property("__array_interface__", +[](const csd::RadarMeasurement &self) {
+      return MakeArrayInterface(
+          self.data(),
+          boost::python::make_tuple(self.size(), 4u),
+          "<f4");
+    })
     .def("get_detection_count", &csd::RadarMeasurement::GetDetectionAmount)
     .def("__len__", &csd::RadarMeasurement::size)
     .def("__iter__", iterator<csd::RadarMeasurement>())
@@ -388,14 +476,22 @@ void export_sensor_data() {
     .add_property("width", &csd::DVSEventArray::GetWidth)
     .add_property("height", &csd::DVSEventArray::GetHeight)
     .add_property("fov", &csd::DVSEventArray::GetFOVAngle)
-    .add_property("raw_data", &GetRawDataAsBuffer<csd::DVSEventArray>)
+    .add_property("raw_data", +[](csd::DVSEventArray &self) {
+      return MakeRawDataMemoryView(
+          self.GetRawPayload(),
+          static_cast<Py_ssize_t>(self.GetRawPayloadSize()));
+    })
+    .def("get_events_in_time_window", +[](const csd::DVSEventArray &self, std::int64_t t_begin, std::int64_t t_end) {
+      const auto window = self.GetEventsInTimeWindow(t_begin, t_end);
+      return boost::python::make_tuple(window.first, window.second);
+    }, (arg("t_begin"), arg("t_end")))
     .def("__len__", &csd::DVSEventArray::size)
     .def("__iter__", iterator<csd::DVSEventArray>())
     .def("__getitem__", +[](const csd::DVSEventArray &self, size_t pos) -> csd::DVSEvent {
       return self.at(pos);
     })
     .def("__setitem__", +[](csd::DVSEventArray &self, size_t pos, csd::DVSEvent event) {
-      self.at(pos) = event;
+      self.SetEvent(pos, event);
     })
     .def("to_image", CALL_RETURNING_LIST(csd::DVSEventArray, ToImage))
     .def("to_array", CALL_RETURNING_LIST(csd::DVSEventArray, ToArray))
@@ -27,10 +27,116 @@ namespace client {
 } // namespace client
 } // namespace carla
 
+namespace {
+
+  /// Flat row-major storage for the bulk snapshot accessors below. Exposes
+  /// numpy's array interface (version 3), so ``np.asarray(array)`` wraps the
+  /// memory without copying it; numpy keeps this object alive as the base
+  /// object of the resulting array.
+  template <typename T>
+  class BulkArray {
+  public:
+
+    BulkArray(std::vector<T> data, size_t columns, std::string typestr)
+      : _data(std::move(data)),
+        _columns(columns),
+        _typestr(std::move(typestr)) {}
+
+    boost::python::dict GetArrayInterface() const {
+      boost::python::dict interface;
+      interface["version"] = 3;
+      interface["shape"] = (_columns == 1u)
+          ? boost::python::make_tuple(GetRowCount())
+          : boost::python::make_tuple(GetRowCount(), _columns);
+      interface["typestr"] = _typestr;
+      interface["data"] = boost::python::make_tuple(
+          reinterpret_cast<std::uintptr_t>(_data.data()), false);
+      return interface;
+    }
+
+    size_t GetRowCount() const {
+      return _data.size() / _columns;
+    }
+
+  private:
+
+    std::vector<T> _data;
+
+    size_t _columns;
+
+    std::string _typestr;
+  };
+
+  using ActorIdArray = BulkArray<uint32_t>;
+  using TransformArray = BulkArray<float>;
+
+  /// Ids of every actor in the snapshot; same row order as
+  /// GetSnapshotActorTransforms on the same snapshot.
+  ActorIdArray GetSnapshotActorIds(const carla::client::WorldSnapshot &self) {
+    std::vector<uint32_t> ids;
+    {
+      carla::PythonUtil::ReleaseGIL unlock;
+      ids.reserve(self.size());
+      for (const auto &actor_snapshot : self) {
+        ids.push_back(actor_snapshot.id);
+      }
+    }
+    return ActorIdArray(std::move(ids), 1u, "<u4");
+  }
+
+  /// One row of [x, y, z, pitch, yaw, roll] per actor in the snapshot; same
+  /// row order as GetSnapshotActorIds on the same snapshot.
+  TransformArray GetSnapshotActorTransforms(const carla::client::WorldSnapshot &self) {
+    std::vector<float> rows;
+    {
+      carla::PythonUtil::ReleaseGIL unlock;
+      rows.reserve(6u * self.size());
+      for (const auto &actor_snapshot : self) {
+        const auto &transform = actor_snapshot.transform;
+        rows.push_back(transform.location.x);
+        rows.push_back(transform.location.y);
+        rows.push_back(transform.location.z);
+        rows.push_back(transform.rotation.pitch);
+        rows.push_back(transform.rotation.yaw);
+        rows.push_back(transform.rotation.roll);
+      }
+    }
+    return TransformArray(std::move(rows), 6u, "<f4");
+  }
+
+  /// Ids, transforms and velocities of every actor in one call; the three
+  /// arrays share the same row order. One snapshot of 1000 actors becomes
+  /// three Python objects instead of thousands.
+  boost::python::tuple GetSnapshotPackedState(const carla::client::WorldSnapshot &self) {
+    std::vector<uint32_t> ids;
+    std::vector<float> transforms;
+    std::vector<float> velocities;
+    {
+      carla::PythonUtil::ReleaseGIL unlock;
+      self.CopyPackedActorState(ids, transforms, velocities);
+    }
+    return boost::python::make_tuple(
+        ActorIdArray(std::move(ids), 1u, "<u4"),
+        TransformArray(std::move(transforms), 6u, "<f4"),
+        TransformArray(std::move(velocities), 3u, "<f4"));
+  }
+
+} // namespace
+
 void export_snapshot() {
   using namespace boost::python;
   namespace cc = carla::client;
 
+  class_<ActorIdArray>("ActorIdArray", no_init)
+    .add_property("__array_interface__", &ActorIdArray::GetArrayInterface)
+    .def("__len__", &ActorIdArray::GetRowCount)
+  ;
+
+  class_<TransformArray>("TransformArray", no_init)
+    .add_property("__array_interface__", &TransformArray::GetArrayInterface)
+    .def("__len__", &TransformArray::GetRowCount)
+  ;
+
   class_<cc::ActorSnapshot>("ActorSnapshot", no_init)
     .def_readonly("id", &cc::ActorSnapshot::id)
     .def("get_transform", +[](const cc::ActorSnapshot &self) { return self.transform; })
@@ -51,6 +157,9 @@ void export_snapshot() {
     .add_property("platform_timestamp", +[](const cc::WorldSnapshot &self) { return self.GetTimestamp().platform_timestamp; })
     /// @}
     .def("has_actor", &cc::WorldSnapshot::Contains, (arg("actor_id")))
+    .def("get_actor_ids", &GetSnapshotActorIds)
+    .def("get_actor_transforms", &GetSnapshotActorTransforms)
+    .def("get_packed_state", &GetSnapshotPackedState)
     .def("find", CALL_RETURNING_OPTIONAL_1(cc::WorldSnapshot, Find, carla::ActorId), (arg("actor_id")))
     .def("__len__", &cc::WorldSnapshot::size)
     .def("__iter__", range(&cc::WorldSnapshot::begin, &cc::WorldSnapshot::end))
@@ -33,8 +33,10 @@ void export_trafficmanager() {
     .def("set_global_distance_to_leading_vehicle", &ctm::TrafficManager::SetGlobalDistanceToLeadingVehicle)
     .def("set_percentage_keep_right_rule", &ctm::TrafficManager::SetKeepRightPercentage)
     .def("set_synchronous_mode", &ctm::TrafficManager::SetSynchronousMode)
+    .def("set_pipelined_mode", &ctm::TrafficManager::SetPipelinedMode)
     .def("set_hybrid_physics_mode", &ctm::TrafficManager::SetHybridPhysicsMode)
     .def("set_hybrid_physics_radius", &ctm::TrafficManager::SetHybridPhysicsRadius)
     .def("set_random_device_seed", &ctm::TrafficManager::SetRandomDeviceSeed)
+    .def("set_deterministic_streams", &ctm::TrafficManager::SetDeterministicStreams)
     .def("set_osm_mode", &carla::traffic_manager::TrafficManager::SetOSMMode);
 }
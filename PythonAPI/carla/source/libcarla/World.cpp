@@ -49,11 +49,31 @@ static size_t OnTick(carla::client::World &self, boost::python::object callback)
   return self.OnTick(MakeCallback(std::move(callback)));
 }
 
+static void OnNextTick(carla::client::World &self, boost::python::object callback) {
+  self.OnNextTick(MakeCallback(std::move(callback)));
+}
+
 static auto Tick(carla::client::World &world, double seconds) {
   carla::PythonUtil::ReleaseGIL unlock;
   return world.Tick(TimeDurationFromSeconds(seconds));
 }
 
+static void PrewarmWeatherPresets(carla::client::World &world, boost::python::object presets) {
+  std::vector<carla::rpc::WeatherParameters> params{
+      boost::python::stl_input_iterator<carla::rpc::WeatherParameters>(presets),
+      boost::python::stl_input_iterator<carla::rpc::WeatherParameters>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  world.PrewarmWeatherPresets(params);
+}
+
+static void PrefetchRoute(carla::client::World &world, boost::python::object route, float lookahead) {
+  std::vector<carla::geom::Location> locations{
+      boost::python::stl_input_iterator<carla::geom::Location>(route),
+      boost::python::stl_input_iterator<carla::geom::Location>()};
+  carla::PythonUtil::ReleaseGIL unlock;
+  world.PrefetchRoute(locations, lookahead);
+}
+
 static auto GetActorsById(carla::client::World &self, const boost::python::list &actor_ids) {
   std::vector<carla::ActorId> ids{
       boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
@@ -63,8 +83,11 @@ static auto GetActorsById(carla::client::World &self, const boost::python::list
 }
 
 static auto GetVehiclesLightStates(carla::client::World &self) {
+  const auto list = [&]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.GetVehiclesLightStates();
+  }();
   boost::python::dict dict;
-  auto list = self.GetVehiclesLightStates();
   for (auto &vehicle : list) {
     dict[vehicle.first] = vehicle.second;
   }
@@ -72,9 +95,14 @@ static auto GetVehiclesLightStates(carla::client::World &self) {
 }
 
 static auto GetLevelBBs(const carla::client::World &self, uint8_t queried_tag) {
-  carla::PythonUtil::ReleaseGIL unlock;
+  // The list conversion touches Python objects, only the request itself can
+  // run without the GIL.
+  const auto bbs = [&]() {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.GetLevelBBs(queried_tag);
+  }();
   boost::python::list result;
-  for (const auto &bb : self.GetLevelBBs(queried_tag)) {
+  for (const auto &bb : bbs) {
     result.append(bb);
   }
   return result;
@@ -112,12 +140,20 @@ void export_world() {
   ;
 
   class_<cr::EpisodeSettings>("WorldSettings")
-    .def(init<bool, bool, double>(
+    .def(init<bool, bool, double, bool, double, int, double>(
         (arg("synchronous_mode")=false,
          arg("no_rendering_mode")=false,
-         arg("fixed_delta_seconds")=0.0)))
+         arg("fixed_delta_seconds")=0.0,
+         arg("substepping")=true,
+         arg("max_substep_delta_time")=0.01,
+         arg("max_substeps")=10,
+         arg("sensor_frame_budget_ms")=0.0)))
     .def_readwrite("synchronous_mode", &cr::EpisodeSettings::synchronous_mode)
     .def_readwrite("no_rendering_mode", &cr::EpisodeSettings::no_rendering_mode)
+    .def_readwrite("substepping", &cr::EpisodeSettings::substepping)
+    .def_readwrite("max_substep_delta_time", &cr::EpisodeSettings::max_substep_delta_time)
+    .def_readwrite("max_substeps", &cr::EpisodeSettings::max_substeps)
+    .def_readwrite("sensor_frame_budget_ms", &cr::EpisodeSettings::sensor_frame_budget_ms)
     .add_property("fixed_delta_seconds",
         +[](const cr::EpisodeSettings &self) {
           return OptionalToPythonObject(self.fixed_delta_seconds);
@@ -177,6 +213,12 @@ void export_world() {
       arg("attach_to")=carla::SharedPtr<cc::Actor>(), \
       arg("attachment_type")=cr::AttachmentType::Rigid)
 
+  class_<cc::detail::StateRetentionMetrics>("StateRetentionMetrics", no_init)
+    .def_readonly("live_states", &cc::detail::StateRetentionMetrics::live_states)
+    .def_readonly("live_bytes", &cc::detail::StateRetentionMetrics::live_bytes)
+    .def_readonly("pooled_states", &cc::detail::StateRetentionMetrics::pooled_states)
+  ;
+
   class_<cc::World>("World", no_init)
     .add_property("id", &cc::World::GetId)
     .add_property("debug", &cc::World::MakeDebugHelper)
@@ -188,8 +230,12 @@ void export_world() {
     .def("get_settings", CONST_CALL_WITHOUT_GIL(cc::World, GetSettings))
     .def("apply_settings", CALL_WITHOUT_GIL_1(cc::World, ApplySettings, cr::EpisodeSettings), arg("settings"))
     .def("get_weather", CONST_CALL_WITHOUT_GIL(cc::World, GetWeather))
-    .def("set_weather", &cc::World::SetWeather)
+    .def("set_weather", CALL_WITHOUT_GIL_1(cc::World, SetWeather, const cr::WeatherParameters &), arg("weather"))
+    .def("prewarm_weather_presets", &PrewarmWeatherPresets, (arg("presets")))
+    .def("prefetch_route", &PrefetchRoute, (arg("route"), arg("lookahead")=500.0f))
     .def("get_snapshot", &cc::World::GetSnapshot)
+    .def("get_state_retention_metrics", &cc::World::GetStateRetentionMetrics)
+    .def("set_max_pooled_states", &cc::World::SetMaxPooledStates, (arg("count")))
     .def("get_actor", CONST_CALL_WITHOUT_GIL_1(cc::World, GetActor, carla::ActorId), (arg("actor_id")))
     .def("get_actors", CONST_CALL_WITHOUT_GIL(cc::World, GetActors))
     .def("get_actors", &GetActorsById, (arg("actor_ids")))
@@ -198,13 +244,17 @@ void export_world() {
     .def("wait_for_tick", &WaitForTick, (arg("seconds")=10.0))
     .def("on_tick", &OnTick, (arg("callback")))
     .def("remove_on_tick", &cc::World::RemoveOnTick, (arg("callback_id")))
+    .def("on_next_tick", &OnNextTick, (arg("callback")))
+    .def("fast_reset", CALL_WITHOUT_GIL(cc::World, FastReset))
     .def("tick", &Tick, (arg("seconds")=10.0))
+    .def("fast_forward", CALL_WITHOUT_GIL_2(cc::World, FastForward, double, float), (arg("duration"), arg("relevance_radius")=0.0f))
     .def("set_pedestrians_cross_factor", CALL_WITHOUT_GIL_1(cc::World, SetPedestriansCrossFactor, float), (arg("percentage")))
+    .def("set_pedestrians_seed", CALL_WITHOUT_GIL_1(cc::World, SetPedestriansSeed, unsigned int), (arg("seed")))
     .def("get_traffic_sign", CONST_CALL_WITHOUT_GIL_1(cc::World, GetTrafficSign, cc::Landmark), arg("landmark"))
     .def("get_traffic_light", CONST_CALL_WITHOUT_GIL_1(cc::World, GetTrafficLight, cc::Landmark), arg("landmark"))
-    .def("reset_all_traffic_lights", &cc::World::ResetAllTrafficLights)
+    .def("reset_all_traffic_lights", CALL_WITHOUT_GIL(cc::World, ResetAllTrafficLights))
     .def("get_lightmanager", CONST_CALL_WITHOUT_GIL(cc::World, GetLightManager))
-    .def("freeze_all_traffic_lights", &cc::World::FreezeAllTrafficLights, (arg("frozen")))
+    .def("freeze_all_traffic_lights", CALL_WITHOUT_GIL_1(cc::World, FreezeAllTrafficLights, bool), (arg("frozen")))
     .def("get_level_bbs", &GetLevelBBs, (arg("actor_type")=cr::CityObjectLabel::None))
     .def(self_ns::str(self_ns::self))
   ;
@@ -247,5 +297,46 @@ void export_world() {
          arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
          arg("life_time")=-1.0f,
          arg("persistent_lines")=true))
+    .def("make_batch", &cc::DebugHelper::MakeBatch)
+  ;
+
+  class_<cc::DebugHelper::Batch>("DebugHelperBatch", no_init)
+    .def("draw_point", &cc::DebugHelper::Batch::DrawPoint,
+        (arg("location"),
+         arg("size")=0.1f,
+         arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
+         arg("life_time")=-1.0f,
+         arg("persistent_lines")=true))
+    .def("draw_line", &cc::DebugHelper::Batch::DrawLine,
+        (arg("begin"),
+         arg("end"),
+         arg("thickness")=0.1f,
+         arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
+         arg("life_time")=-1.0f,
+         arg("persistent_lines")=true))
+    .def("draw_arrow", &cc::DebugHelper::Batch::DrawArrow,
+        (arg("begin"),
+         arg("end"),
+         arg("thickness")=0.1f,
+         arg("arrow_size")=0.1f,
+         arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
+         arg("life_time")=-1.0f,
+         arg("persistent_lines")=true))
+    .def("draw_box", &cc::DebugHelper::Batch::DrawBox,
+        (arg("box"),
+         arg("rotation"),
+         arg("thickness")=0.1f,
+         arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
+         arg("life_time")=-1.0f,
+         arg("persistent_lines")=true))
+    .def("draw_string", &cc::DebugHelper::Batch::DrawString,
+        (arg("location"),
+         arg("text"),
+         arg("draw_shadow")=false,
+         arg("color")=cc::DebugHelper::Color(255u, 0u, 0u),
+         arg("life_time")=-1.0f,
+         arg("persistent_lines")=true))
+    .def("flush", CALL_WITHOUT_GIL(cc::DebugHelper::Batch, Flush))
+    .def("__len__", &cc::DebugHelper::Batch::size)
   ;
 }
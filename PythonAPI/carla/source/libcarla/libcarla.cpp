@@ -101,6 +101,33 @@ static boost::python::object OptionalToPythonObject(OptionalT &optional) {
       return result; \
     }
 
+// Same as CALL_RETURNING_LIST, but the C++ call runs with the GIL released;
+// the list conversion needs Python objects, so the GIL is re-acquired first.
+#define CALL_RETURNING_LIST_WITHOUT_GIL(cls, fn) +[](const cls &self) { \
+      auto items = [&]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(); \
+      }(); \
+      boost::python::list result; \
+      for (auto &&item : items) { \
+        result.append(item); \
+      } \
+      return result; \
+    }
+
+// @copydoc CALL_RETURNING_LIST_WITHOUT_GIL
+#define CALL_RETURNING_LIST_WITHOUT_GIL_1(cls, fn, T1_) +[](const cls &self, T1_ t1) { \
+      auto items = [&]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(std::forward<T1_>(t1)); \
+      }(); \
+      boost::python::list result; \
+      for (auto &&item : items) { \
+        result.append(item); \
+      } \
+      return result; \
+    }
+
 #define CALL_RETURNING_OPTIONAL(cls, fn) +[](const cls &self) { \
       auto optional = self.fn(); \
       return OptionalToPythonObject(optional); \
@@ -112,9 +139,11 @@ static boost::python::object OptionalToPythonObject(OptionalT &optional) {
     }
 
 #define CALL_RETURNING_OPTIONAL_WITHOUT_GIL(cls, fn) +[](const cls &self) { \
-      carla::PythonUtil::ReleaseGIL unlock; \
-      auto optional = self.fn(); \
-      return optional.has_value() ? boost::python::object(*optional) : boost::python::object(); \
+      auto optional = [&]() { \
+        carla::PythonUtil::ReleaseGIL unlock; \
+        return self.fn(); \
+      }(); \
+      return OptionalToPythonObject(optional); \
     }
 
 template <typename T>
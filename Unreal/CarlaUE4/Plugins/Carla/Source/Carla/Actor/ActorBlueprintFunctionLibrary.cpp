@@ -234,6 +234,17 @@ static void AddVariationsForSensor(FActorDefinition &Def)
   Tick.bRestrictToRecommended = false;
 
   Def.Variations.Emplace(Tick);
+
+  // Priority used by the sensor frame-budget throttle; when the episode is
+  // over budget, lower priorities stop capturing first.
+  FActorVariation Priority;
+
+  Priority.Id = TEXT("sensor_priority");
+  Priority.Type = EActorAttributeType::Int;
+  Priority.RecommendedValues = { TEXT("0") };
+  Priority.bRestrictToRecommended = false;
+
+  Def.Variations.Emplace(Priority);
 }
 
 static void AddVariationsForTrigger(FActorDefinition &Def)
@@ -323,6 +334,20 @@ void UActorBlueprintFunctionLibrary::MakeCameraDefinition(
   ResY.RecommendedValues = { TEXT("600") };
   ResY.bRestrictToRecommended = false;
 
+  // Temporal interleaving, render only one out of N ticks
+  FActorVariation CaptureInterval;
+  CaptureInterval.Id = TEXT("capture_interval");
+  CaptureInterval.Type = EActorAttributeType::Int;
+  CaptureInterval.RecommendedValues = { TEXT("1") };
+  CaptureInterval.bRestrictToRecommended = false;
+
+  // Explicit multi-GPU, pin the camera's readback to one GPU
+  FActorVariation GpuIndex;
+  GpuIndex.Id = TEXT("gpu_index");
+  GpuIndex.Type = EActorAttributeType::Int;
+  GpuIndex.RecommendedValues = { TEXT("0") };
+  GpuIndex.bRestrictToRecommended = false;
+
   // Lens parameters
   FActorVariation LensCircleFalloff;
   LensCircleFalloff.Id = TEXT("lens_circle_falloff");
@@ -363,6 +388,8 @@ void UActorBlueprintFunctionLibrary::MakeCameraDefinition(
   Definition.Variations.Append({
       ResX,
       ResY,
+      CaptureInterval,
+      GpuIndex,
       FOV,
       LensCircleFalloff,
       LensCircleMultiplier,
@@ -866,12 +893,17 @@ void UActorBlueprintFunctionLibrary::MakeLidarDefinition(
   StdDevLidar.Id = TEXT("noise_stddev");
   StdDevLidar.Type = EActorAttributeType::Float;
   StdDevLidar.RecommendedValues = { TEXT("0.0") };
+  // 16-bit fixed-point transport of the point cloud.
+  FActorVariation QuantizedTransport;
+  QuantizedTransport.Id = TEXT("quantized_transport");
+  QuantizedTransport.Type = EActorAttributeType::Bool;
+  QuantizedTransport.RecommendedValues = { TEXT("false") };
 
   if (Id == "ray_cast") {
     Definition.Variations.Append(
         {Channels, Range, PointsPerSecond, Frequency, UpperFOV, LowerFOV,
             AtmospAttenRate, DropOffGenRate, DropOffIntensityLimit,
-            DropOffAtZeroIntensity, StdDevLidar});
+            DropOffAtZeroIntensity, StdDevLidar, QuantizedTransport});
   }
   else if (Id == "ray_cast_semantic") {
     Definition.Variations.Append(
@@ -1371,6 +1403,10 @@ void UActorBlueprintFunctionLibrary::SetCamera(
       RetrieveActorAttributeToInt("image_size_y", Description.Variations, 600));
   Camera->SetFOVAngle(
       RetrieveActorAttributeToFloat("fov", Description.Variations, 90.0f));
+  Camera->SetCaptureInterval(
+      RetrieveActorAttributeToInt("capture_interval", Description.Variations, 1));
+  Camera->SetGpuIndex(
+      RetrieveActorAttributeToInt("gpu_index", Description.Variations, 0));
   if (Description.Variations.Contains("enable_postprocess_effects"))
   {
     Camera->EnablePostProcessingEffects(
@@ -1498,6 +1534,8 @@ void UActorBlueprintFunctionLibrary::SetLidar(
       RetrieveActorAttributeToFloat("dropoff_zero_intensity", Description.Variations, Lidar.DropOffAtZeroIntensity);
   Lidar.NoiseStdDev =
       RetrieveActorAttributeToFloat("noise_stddev", Description.Variations, Lidar.NoiseStdDev);
+  Lidar.QuantizedTransport =
+      RetrieveActorAttributeToBool("quantized_transport", Description.Variations, Lidar.QuantizedTransport);
 }
 
 void UActorBlueprintFunctionLibrary::SetGnss(
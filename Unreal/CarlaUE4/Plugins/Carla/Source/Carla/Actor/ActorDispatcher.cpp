@@ -22,6 +22,7 @@ void UActorDispatcher::Bind(FActorDefinition Definition, SpawnFunctionType Funct
     Definitions.Emplace(Definition);
     SpawnFunctions.Emplace(Functor);
     Classes.Emplace(Definition.Class);
+    ++DefinitionsVersion;
   }
   else
   {
@@ -71,6 +72,7 @@ TPair<EActorSpawnResultStatus, FActorView> UActorDispatcher::SpawnActor(
   }
   else
   {
+    SpawnedIds.Add(View.GetActorId());
     ATagger::TagActor(*View.GetActor(), true);
   }
 
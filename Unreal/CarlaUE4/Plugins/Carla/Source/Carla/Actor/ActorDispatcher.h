@@ -66,25 +66,51 @@ public:
     return Definitions;
   }
 
+  /// Version counter bumped every time a definition is bound, so clients can
+  /// detect whether a library they already downloaded is still up to date.
+  uint64 GetActorDefinitionsVersion() const
+  {
+    return DefinitionsVersion;
+  }
+
   const FActorRegistry &GetActorRegistry() const
   {
     return Registry;
   }
 
+  FActorRegistry &GetActorRegistry()
+  {
+    return Registry;
+  }
+
+  /// Return true if @a Id was created through SpawnActor, as opposed to a
+  /// level-placed actor registered at episode start.
+  bool IsSpawnedActor(FActorRegistry::IdType Id) const
+  {
+    return SpawnedIds.Contains(Id);
+  }
+
 private:
 
   UFUNCTION()
   void OnActorDestroyed(AActor *Actor)
   {
+    SpawnedIds.Remove(Registry.Find(Actor).GetActorId());
     Registry.Deregister(Actor);
   }
 
   TArray<FActorDefinition> Definitions;
 
+  uint64 DefinitionsVersion = 0u;
+
   TArray<SpawnFunctionType> SpawnFunctions;
 
   TArray<TSubclassOf<AActor>> Classes;
 
+  /// Ids of the actors created through SpawnActor, so a fast reset can tell
+  /// them apart from level-placed actors.
+  TSet<FActorRegistry::IdType> SpawnedIds;
+
   FActorRegistry Registry;
 
 };
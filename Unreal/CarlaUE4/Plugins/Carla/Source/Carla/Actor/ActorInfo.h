@@ -31,4 +31,18 @@ public:
 
   /// @todo To be used solely by the FWorldObserver.
   mutable FVector Velocity = {0.0f, 0.0f, 0.0f};
+
+  /// Transform as of the last time this actor was broadcast; lets the
+  /// observer skip actors that have not moved since.
+  /// @todo To be used solely by the FWorldObserver.
+  mutable FTransform ObservedTransform = FTransform::Identity;
+
+  /// Control stamp as of the last time this actor was broadcast.
+  /// @todo To be used solely by the FWorldObserver.
+  mutable uint32 ObservedControlStamp = 0u;
+
+  /// Traffic-light binding and light state as of the last time this actor
+  /// was broadcast.
+  /// @todo To be used solely by the FWorldObserver.
+  mutable uint32 ObservedTrafficLightStamp = 0u;
 };
@@ -86,6 +86,7 @@ FActorView FActorRegistry::Register(AActor &Actor, FActorDescription Description
   auto Result = ActorDatabase.emplace(Id, View);
   check(Result.second);
   check(static_cast<size_t>(Actors.Num()) == ActorDatabase.size());
+  RecordChange(Id, true);
   return Result.first->second;
 }
 
@@ -98,6 +99,91 @@ void FActorRegistry::Deregister(IdType Id)
   Actors.Remove(Id);
   Ids.Remove(Actor);
   check(static_cast<size_t>(Actors.Num()) == ActorDatabase.size());
+  RecordChange(Id, false);
+}
+
+void FActorRegistry::RecordChange(IdType Id, bool bRegistered)
+{
+  // How many register/deregister events to remember for incremental actor
+  // list diffs; clients further behind are served the full list again.
+  constexpr int32 MaxChangeLogSize = 8192;
+  ChangeLog.Add(FChange{++Version, Id, bRegistered});
+  if (ChangeLog.Num() > MaxChangeLogSize)
+  {
+    const int32 Excess = ChangeLog.Num() - MaxChangeLogSize;
+    PrunedThroughVersion = ChangeLog[Excess - 1].Version;
+    ChangeLog.RemoveAt(0, Excess);
+  }
+  RefreshSnapshot();
+}
+
+static bool FActorRegistry_GetChangesSince(
+    const uint64 Version,
+    const uint64 PrunedThroughVersion,
+    const TArray<FActorRegistry::FChange> &ChangeLog,
+    const uint64 SinceVersion,
+    TArray<FActorRegistry::IdType> &Added,
+    TArray<FActorRegistry::IdType> &Removed)
+{
+  if ((SinceVersion > Version) || (SinceVersion < PrunedThroughVersion))
+  {
+    return false;
+  }
+  // Only the last event per id matters: a register guarantees the actor is
+  // currently present, a deregister that it is gone; a deregister for an id
+  // the client never saw is harmless.
+  TMap<FActorRegistry::IdType, bool> NetChange;
+  for (const auto &Change : ChangeLog)
+  {
+    if (Change.Version > SinceVersion)
+    {
+      NetChange.Add(Change.Id, Change.bRegistered);
+    }
+  }
+  for (const auto &Pair : NetChange)
+  {
+    (Pair.Value ? Added : Removed).Add(Pair.Key);
+  }
+  return true;
+}
+
+bool FActorRegistry::GetChangesSince(
+    uint64 SinceVersion,
+    TArray<IdType> &Added,
+    TArray<IdType> &Removed) const
+{
+  return FActorRegistry_GetChangesSince(
+      Version, PrunedThroughVersion, ChangeLog, SinceVersion, Added, Removed);
+}
+
+bool FActorRegistry::FSnapshot::GetChangesSince(
+    uint64 SinceVersion,
+    TArray<IdType> &Added,
+    TArray<IdType> &Removed) const
+{
+  return FActorRegistry_GetChangesSince(
+      Version, PrunedThroughVersion, ChangeLog, SinceVersion, Added, Removed);
+}
+
+void FActorRegistry::RefreshSnapshot()
+{
+  auto NewSnapshot = std::make_shared<FSnapshot>();
+  NewSnapshot->Version = Version;
+  NewSnapshot->PrunedThroughVersion = PrunedThroughVersion;
+  NewSnapshot->ChangeLog = ChangeLog;
+  NewSnapshot->Actors.reserve(ActorDatabase.size());
+  for (const auto &Pair : ActorDatabase)
+  {
+    const FActorView &View = Pair.second;
+    crp::Actor Actor = View.GetActorInfo()->SerializedData;
+    const AActor *Parent = View.GetActor() != nullptr ? View.GetActor()->GetOwner() : nullptr;
+    if (Parent != nullptr)
+    {
+      Actor.parent_id = Find(Parent).GetActorId();
+    }
+    NewSnapshot->Actors.emplace(Pair.first, std::move(Actor));
+  }
+  Snapshot.store(std::move(NewSnapshot));
 }
 
 void FActorRegistry::Deregister(AActor *Actor)
@@ -11,9 +11,11 @@
 #include "Containers/Map.h"
 
 #include <compiler/disable-ue4-macros.h>
+#include <carla/AtomicSharedPtr.h>
 #include <carla/Iterator.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include <memory>
 #include <unordered_map>
 
 /// A registry of all the Carla actors.
@@ -27,6 +29,11 @@ public:
 
   using IdType = DatabaseType::key_type;
 
+  FActorRegistry()
+  {
+    RefreshSnapshot();
+  }
+
   // ===========================================================================
   /// @name Actor registry functions
   // ===========================================================================
@@ -81,6 +88,70 @@ public:
   /// an invalid id.
   FActorView FindOrFake(AActor *Actor) const;
 
+  /// @}
+  // ===========================================================================
+  /// @name Change tracking
+  // ===========================================================================
+  /// @{
+public:
+
+  struct FChange
+  {
+    uint64 Version;
+    IdType Id;
+    bool bRegistered;
+  };
+
+  /// Immutable copy of the registry, swapped atomically on every change so
+  /// read-only RPCs can be answered from any thread without waiting for the
+  /// game thread.
+  struct FSnapshot
+  {
+    uint64 Version = 0u;
+
+    uint64 PrunedThroughVersion = 0u;
+
+    TArray<FChange> ChangeLog;
+
+    /// Serialized data of every registered actor, with the parent id
+    /// resolved as of the time the snapshot was taken.
+    std::unordered_map<IdType, carla::rpc::Actor> Actors;
+
+    /// Same as FActorRegistry::GetChangesSince, but over the state captured
+    /// in this snapshot.
+    bool GetChangesSince(
+        uint64 SinceVersion,
+        TArray<IdType> &Added,
+        TArray<IdType> &Removed) const;
+  };
+
+  /// Version counter bumped on every register and deregister.
+  uint64 GetVersion() const
+  {
+    return Version;
+  }
+
+  /// Fill @a Added and @a Removed with the net set of ids registered and
+  /// deregistered after @a SinceVersion. Returns false if the change log no
+  /// longer reaches back that far, in which case the full list has to be
+  /// sent instead.
+  bool GetChangesSince(
+      uint64 SinceVersion,
+      TArray<IdType> &Added,
+      TArray<IdType> &Removed) const;
+
+  /// Return the snapshot of the registry as of its last change; never null,
+  /// safe to call from any thread.
+  std::shared_ptr<const FSnapshot> GetSnapshot() const
+  {
+    return Snapshot.load();
+  }
+
+  /// Rebuild and publish the snapshot. Called automatically on register and
+  /// deregister; has to be called explicitly (from the game thread) after a
+  /// change the registry cannot see, e.g. an actor re-parented.
+  void RefreshSnapshot();
+
   /// @}
   // ===========================================================================
   /// @name Range iteration support
@@ -105,9 +176,21 @@ private:
 
   FActorView MakeView(IdType Id, AActor &Actor, FActorDescription Description) const;
 
+  void RecordChange(IdType Id, bool bRegistered);
+
+  TArray<FChange> ChangeLog;
+
+  uint64 Version = 0u;
+
+  /// Version of the most recent entry dropped from ChangeLog; diffs against
+  /// anything older than this cannot be answered.
+  uint64 PrunedThroughVersion = 0u;
+
   TMap<IdType, AActor *> Actors;
 
   TMap<AActor *, IdType> Ids;
 
   DatabaseType ActorDatabase;
+
+  carla::AtomicSharedPtr<const FSnapshot> Snapshot;
 };
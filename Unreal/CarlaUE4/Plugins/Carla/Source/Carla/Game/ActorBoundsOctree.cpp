@@ -0,0 +1,95 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Game/ActorBoundsOctree.h"
+
+#include "GameFramework/Actor.h"
+
+void FActorBoundsOctree::Rebuild(const FActorRegistry &Registry)
+{
+  Octree = MakeUnique<FOctreeType>(FVector::ZeroVector, HALF_WORLD_MAX);
+
+  for (const FActorView &View : Registry)
+  {
+    AActor *Actor = View.GetActor();
+    if ((Actor == nullptr) || Actor->IsPendingKill())
+    {
+      continue;
+    }
+
+    FActorBoundsElement Element;
+    Element.Actor = Actor;
+    Element.Bounds = Actor->GetComponentsBoundingBox();
+    const auto *Root = Actor->GetRootComponent();
+    Element.bIsDynamic = (Root != nullptr) && (Root->Mobility == EComponentMobility::Movable);
+
+    if (Element.Bounds.IsValid)
+    {
+      Octree->AddElement(Element);
+    }
+  }
+
+  FrameRebuilt = GFrameCounter;
+}
+
+void FActorBoundsOctree::QuerySweep(
+    const FVector &Start,
+    const FVector &End,
+    float Radius,
+    bool bOnlyDynamics,
+    TArray<AActor *> &OutActors) const
+{
+  if (!Octree.IsValid())
+  {
+    return;
+  }
+
+  FBox SweepBox(ForceInit);
+  SweepBox += Start;
+  SweepBox += End;
+  SweepBox = SweepBox.ExpandBy(Radius);
+
+  const FVector Direction = End - Start;
+
+  Octree->FindElementsWithBoundsTest(
+      FBoxCenterAndExtent(SweepBox),
+      [&](const FActorBoundsElement &Element)
+      {
+        if (bOnlyDynamics && !Element.bIsDynamic)
+        {
+          return;
+        }
+        // Refine the box overlap to the actual swept segment.
+        const FBox ExpandedBounds = Element.Bounds.ExpandBy(Radius);
+        if (FMath::LineBoxIntersection(ExpandedBounds, Start, End, Direction))
+        {
+          OutActors.Add(Element.Actor);
+        }
+      });
+}
+
+void FActorBoundsOctree::QueryBox(
+    const FBox &Box,
+    bool bOnlyDynamics,
+    TArray<AActor *> &OutActors) const
+{
+  if (!Octree.IsValid())
+  {
+    return;
+  }
+
+  Octree->FindElementsWithBoundsTest(
+      FBoxCenterAndExtent(Box),
+      [&](const FActorBoundsElement &Element)
+      {
+        if (bOnlyDynamics && !Element.bIsDynamic)
+        {
+          return;
+        }
+        OutActors.Add(Element.Actor);
+      });
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Carla/Actor/ActorRegistry.h"
+
+#include "CoreGlobals.h"
+#include "Math/GenericOctree.h"
+
+/// Element of the actor bounds octree: a registered actor and the world
+/// bounds it occupied when the octree was last rebuilt.
+struct FActorBoundsElement
+{
+  AActor *Actor = nullptr;
+
+  FBox Bounds;
+
+  /// Whether the actor's root component is movable.
+  bool bIsDynamic = false;
+};
+
+struct FActorBoundsOctreeSemantics
+{
+  enum { MaxElementsPerLeaf = 16 };
+  enum { MinInclusiveElementsPerNode = 7 };
+  enum { MaxNodeDepth = 12 };
+
+  typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+  FORCEINLINE static FBoxCenterAndExtent GetBoundingBox(const FActorBoundsElement &Element)
+  {
+    return FBoxCenterAndExtent(Element.Bounds);
+  }
+
+  FORCEINLINE static bool AreElementsEqual(const FActorBoundsElement &A, const FActorBoundsElement &B)
+  {
+    return A.Actor == B.Actor;
+  }
+
+  FORCEINLINE static void SetElementId(const FActorBoundsElement &, FOctreeElementId)
+  {
+  }
+};
+
+/// Octree of the bounds of every actor registered in the episode, shared
+/// by the sensors as a broad-phase so each of them does not pay a query
+/// against the whole world. Rebuilt at most once per frame, on first use
+/// (see UCarlaEpisode::GetActorBoundsOctree).
+class FActorBoundsOctree
+{
+public:
+
+  /// Rebuild the octree from the actors currently in @a Registry.
+  void Rebuild(const FActorRegistry &Registry);
+
+  /// Frame counter value of the last rebuild, zero if never rebuilt.
+  uint64 GetFrameRebuilt() const
+  {
+    return FrameRebuilt;
+  }
+
+  /// Append to @a OutActors the actors whose bounds intersect the sphere
+  /// of radius @a Radius swept from @a Start to @a End. If
+  /// @a bOnlyDynamics is set, actors with a static root component are
+  /// skipped.
+  void QuerySweep(
+      const FVector &Start,
+      const FVector &End,
+      float Radius,
+      bool bOnlyDynamics,
+      TArray<AActor *> &OutActors) const;
+
+  /// Append to @a OutActors the actors whose bounds intersect @a Box.
+  void QueryBox(
+      const FBox &Box,
+      bool bOnlyDynamics,
+      TArray<AActor *> &OutActors) const;
+
+private:
+
+  using FOctreeType = TOctree<FActorBoundsElement, FActorBoundsOctreeSemantics>;
+
+  TUniquePtr<FOctreeType> Octree;
+
+  uint64 FrameRebuilt = 0u;
+};
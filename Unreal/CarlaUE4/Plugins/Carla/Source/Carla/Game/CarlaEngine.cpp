@@ -11,11 +11,17 @@
 #include "Carla/Game/CarlaStaticDelegates.h"
 #include "Carla/Lights/CarlaLightSubsystem.h"
 #include "Carla/Recorder/CarlaRecorder.h"
+#include "Carla/Sensor/Sensor.h"
 #include "Carla/Settings/CarlaSettings.h"
 #include "Carla/Settings/EpisodeSettings.h"
+#include "Carla/Vehicle/CarlaWheeledVehicle.h"
 
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "RenderCore.h"
+#include "RHI.h"
 #include "Runtime/Core/Public/Misc/App.h"
 
+#include <algorithm>
 #include <thread>
 
 // =============================================================================
@@ -38,6 +44,50 @@ static void FCarlaEngine_SetFixedDeltaSeconds(TOptional<double> FixedDeltaSecond
   FApp::SetFixedDeltaTime(FixedDeltaSeconds.Get(0.0));
 }
 
+// Strip the render work that bDisableWorldRendering alone does not stop:
+// shadow and reflection captures, occlusion queries, volumetric fog,
+// foliage and texture streaming keep ticking the render pipeline even with
+// the world view disabled. Scene captures owned by camera sensors are
+// deliberately left alone so cameras keep working if one is spawned.
+static void FCarlaEngine_SetNoRenderingCVars(UWorld *World, const bool bEnable)
+{
+  if (GEngine == nullptr)
+  {
+    return;
+  }
+  if (bEnable)
+  {
+    GEngine->Exec(World, TEXT("r.ShadowQuality 0"));
+    GEngine->Exec(World, TEXT("r.ReflectionEnvironment 0"));
+    GEngine->Exec(World, TEXT("r.SSR.Quality 0"));
+    GEngine->Exec(World, TEXT("r.AmbientOcclusionLevels 0"));
+    GEngine->Exec(World, TEXT("r.DistanceFieldShadowing 0"));
+    GEngine->Exec(World, TEXT("r.DistanceFieldAO 0"));
+    GEngine->Exec(World, TEXT("r.VolumetricFog 0"));
+    GEngine->Exec(World, TEXT("r.AllowOcclusionQueries 0"));
+    GEngine->Exec(World, TEXT("r.HZBOcclusion 0"));
+    GEngine->Exec(World, TEXT("r.Streaming.PoolSize 100"));
+    GEngine->Exec(World, TEXT("foliage.DensityScale 0"));
+    GEngine->Exec(World, TEXT("grass.DensityScale 0"));
+  }
+  else
+  {
+    // Back to the engine defaults.
+    GEngine->Exec(World, TEXT("r.ShadowQuality 5"));
+    GEngine->Exec(World, TEXT("r.ReflectionEnvironment 1"));
+    GEngine->Exec(World, TEXT("r.SSR.Quality 3"));
+    GEngine->Exec(World, TEXT("r.AmbientOcclusionLevels -1"));
+    GEngine->Exec(World, TEXT("r.DistanceFieldShadowing 1"));
+    GEngine->Exec(World, TEXT("r.DistanceFieldAO 1"));
+    GEngine->Exec(World, TEXT("r.VolumetricFog 1"));
+    GEngine->Exec(World, TEXT("r.AllowOcclusionQueries 1"));
+    GEngine->Exec(World, TEXT("r.HZBOcclusion 1"));
+    GEngine->Exec(World, TEXT("r.Streaming.PoolSize 1000"));
+    GEngine->Exec(World, TEXT("foliage.DensityScale 1"));
+    GEngine->Exec(World, TEXT("grass.DensityScale 1"));
+  }
+}
+
 // =============================================================================
 // -- FCarlaEngine -------------------------------------------------------------
 // =============================================================================
@@ -116,7 +166,13 @@ void FCarlaEngine::OnPreTick(UWorld *World, ELevelTick TickType, float DeltaSeco
       }
     }
 
+    // Apply control batches scheduled for this frame before actors tick.
+    Server.RunScheduledBatches(GFrameCounter);
+
     CurrentEpisode->TickTimers(DeltaSeconds);
+    CurrentEpisode->TickRoutePrefetch();
+    TickFastForward();
+    TickSensorQoS();
     WorldObserver.BroadcastTick(*CurrentEpisode, DeltaSeconds, bMapChanged, LightUpdatePending);
 
     ResetSimulationState();
@@ -127,17 +183,167 @@ void FCarlaEngine::OnPostTick(UWorld *, ELevelTick, float DeltaSeconds)
 {
   if (GetCurrentEpisode())
   {
+    RecordFrameSample(DeltaSeconds);
     auto* EpisodeRecorder = GetCurrentEpisode()->GetRecorder();
     if (EpisodeRecorder)
     {
       EpisodeRecorder->Ticking(DeltaSeconds);
     }
   }
+  // While fast-forwarding, frames free-run without waiting for tick cues;
+  // the wait resumes once the target time is reached.
   do
   {
     Server.RunSome(10u);
   }
-  while (bSynchronousMode && !Server.TickCueReceived());
+  while (bSynchronousMode && !Server.TickCueReceived() &&
+         !((CurrentEpisode != nullptr) && CurrentEpisode->IsFastForwarding()));
+}
+
+void FCarlaEngine::TickFastForward()
+{
+  const bool bShouldFastForward = CurrentEpisode->IsFastForwarding();
+  if (bShouldFastForward == bFastForwardActive)
+  {
+    return;
+  }
+  bFastForwardActive = bShouldFastForward;
+
+  auto *PhysicsSettings = UPhysicsSettings::Get();
+  if (bShouldFastForward)
+  {
+    // One solver step per frame; the episode substepping settings are
+    // restored on the way out.
+    PhysicsSettings->bSubstepping = false;
+
+    // Scene captures are gated by IsSensorTickDue, the remaining sensors
+    // tick as actors.
+    for (auto &&View : CurrentEpisode->GetActorRegistry())
+    {
+      AActor *Actor = View.GetActor();
+      auto *Sensor = Cast<ASensor>(Actor);
+      if ((Sensor != nullptr) && Sensor->IsActorTickEnabled())
+      {
+        Sensor->SetActorTickEnabled(false);
+        FastForwardSuspendedSensors.Add(Sensor);
+        continue;
+      }
+      auto *Vehicle = Cast<ACarlaWheeledVehicle>(Actor);
+      if ((Vehicle != nullptr) && (CurrentEpisode->FastForwardRelevanceRadius > 0.0f))
+      {
+        auto *Root = Cast<UPrimitiveComponent>(Vehicle->GetRootComponent());
+        const float DistSquared = FVector::DistSquared(
+            Vehicle->GetActorLocation(),
+            CurrentEpisode->GetSpectatorPawn()->GetActorLocation());
+        const float Radius = CurrentEpisode->FastForwardRelevanceRadius;
+        if ((Root != nullptr) && Root->IsSimulatingPhysics() && (DistSquared > Radius * Radius))
+        {
+          Vehicle->SetSimulatePhysics(false);
+          FastForwardFrozenVehicles.Add(Vehicle);
+        }
+      }
+    }
+  }
+  else
+  {
+    PhysicsSettings->bSubstepping = CurrentEpisode->GetSettings().bSubstepping;
+    for (auto &Sensor : FastForwardSuspendedSensors)
+    {
+      if (Sensor.IsValid())
+      {
+        Sensor->SetActorTickEnabled(true);
+      }
+    }
+    FastForwardSuspendedSensors.Empty();
+    for (auto &Actor : FastForwardFrozenVehicles)
+    {
+      auto *Vehicle = Cast<ACarlaWheeledVehicle>(Actor.Get());
+      if (Vehicle != nullptr)
+      {
+        Vehicle->SetSimulatePhysics(true);
+      }
+    }
+    FastForwardFrozenVehicles.Empty();
+  }
+}
+
+void FCarlaEngine::TickSensorQoS()
+{
+  const double BudgetMs = CurrentEpisode->GetSettings().SensorFrameBudgetMs;
+  const int32 Level = CurrentEpisode->GetSensorPriorityThrottle();
+  if (BudgetMs <= 0.0)
+  {
+    if (Level != 0)
+    {
+      CurrentEpisode->SetSensorPriorityThrottle(0);
+    }
+    return;
+  }
+  if (FrameSampleCount == 0u)
+  {
+    return;
+  }
+  const FFrameSample &Last = FrameSamples[(FrameSampleCount - 1u) % FrameSampleCapacity];
+
+  // The distinct priorities in use define the throttle tiers; moving one
+  // tier per frame keeps the reaction deterministic for a given sensor set
+  // and load, and the top tier is never dropped.
+  TArray<int32> Priorities;
+  for (auto &&View : CurrentEpisode->GetActorRegistry())
+  {
+    const auto *Sensor = Cast<ASensor>(View.GetActor());
+    if (Sensor != nullptr)
+    {
+      Priorities.AddUnique(Sensor->GetSensorPriority());
+    }
+  }
+  if (Priorities.Num() == 0)
+  {
+    return;
+  }
+  Priorities.Sort();
+
+  int32 NewLevel = Level;
+  if (Last.SensorMs > BudgetMs)
+  {
+    // Over budget: also throttle the lowest tier still capturing, except
+    // the highest one.
+    for (int32 i = 0; i < Priorities.Num() - 1; ++i)
+    {
+      if (Priorities[i] >= Level)
+      {
+        NewLevel = Priorities[i] + 1;
+        break;
+      }
+    }
+  }
+  else if ((Last.SensorMs < 0.8 * BudgetMs) && (Level > 0))
+  {
+    // Comfortably under budget: resume the highest throttled tier. The
+    // margin keeps the level from flapping right at the budget.
+    NewLevel = 0;
+    for (int32 i = Priorities.Num() - 1; i >= 0; --i)
+    {
+      if (Priorities[i] < Level)
+      {
+        NewLevel = Priorities[i];
+        break;
+      }
+    }
+  }
+
+  if (NewLevel != Level)
+  {
+    UE_LOG(
+        LogCarla,
+        Log,
+        TEXT("sensor QoS: %.1fms of %.1fms budget, throttle level %d -> %d"),
+        Last.SensorMs,
+        BudgetMs,
+        Level,
+        NewLevel);
+    CurrentEpisode->SetSensorPriorityThrottle(NewLevel);
+  }
 }
 
 void FCarlaEngine::OnEpisodeSettingsChanged(const FEpisodeSettings &Settings)
@@ -149,10 +355,116 @@ void FCarlaEngine::OnEpisodeSettingsChanged(const FEpisodeSettings &Settings)
     GEngine->GameViewport->bDisableWorldRendering = Settings.bNoRenderingMode;
   }
 
+  if (Settings.bNoRenderingMode != bNoRenderingMode)
+  {
+    bNoRenderingMode = Settings.bNoRenderingMode;
+    UWorld *World =
+        (GEngine && GEngine->GameViewport) ? GEngine->GameViewport->GetWorld() : nullptr;
+    FCarlaEngine_SetNoRenderingCVars(World, bNoRenderingMode);
+    GAreScreenMessagesEnabled = !bNoRenderingMode;
+  }
+
   FCarlaEngine_SetFixedDeltaSeconds(Settings.FixedDeltaSeconds);
+
+  // With substepping on, the engine solves the substeps on the physics
+  // task threads while the game thread keeps ticking, so a coarse
+  // fixed_delta_seconds no longer forces a coarse physics step.
+  UPhysicsSettings *PhysicsSettings = UPhysicsSettings::Get();
+  if (PhysicsSettings != nullptr)
+  {
+    PhysicsSettings->bSubstepping = Settings.bSubstepping;
+    PhysicsSettings->MaxSubstepDeltaTime = Settings.MaxSubstepDeltaTime;
+    PhysicsSettings->MaxSubsteps = Settings.MaxSubsteps;
+  }
 }
 
 void FCarlaEngine::ResetSimulationState()
 {
   bMapChanged = false;
 }
+
+void FCarlaEngine::RecordFrameSample(float DeltaSeconds)
+{
+  FFrameSample Sample;
+  Sample.DeltaMs = DeltaSeconds * 1e3f;
+  Sample.GameMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+  Sample.RenderMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+  Sample.GpuMs = FPlatformTime::ToMilliseconds(GGPUFrameTime);
+  Sample.RhiMs = FPlatformTime::ToMilliseconds(GRHIThreadTime);
+
+  // per-frame sensor cost as the growth of the per-sensor accumulators
+  // since the previous frame; the sum can drop when a sensor is
+  // destroyed, losing at most one frame of that sensor's cost
+  double SensorSeconds = 0.0;
+  for (const auto &View : CurrentEpisode->GetActorRegistry())
+  {
+    const auto *Sensor = Cast<ASensor>(View.GetActor());
+    if (Sensor != nullptr)
+    {
+      const auto Timing = Sensor->GetTiming();
+      SensorSeconds +=
+          Timing.capture_seconds +
+          Timing.serialization_seconds +
+          Timing.transmission_seconds;
+    }
+  }
+  Sample.SensorMs = 1e3f * static_cast<float>(
+      std::max(0.0, SensorSeconds - PreviousSensorSeconds));
+  PreviousSensorSeconds = SensorSeconds;
+
+  const auto *PhysicsSettings = UPhysicsSettings::Get();
+  if ((PhysicsSettings != nullptr) && PhysicsSettings->bSubstepping)
+  {
+    Sample.PhysicsSubsteps = FMath::Clamp(
+        FMath::CeilToInt(DeltaSeconds / PhysicsSettings->MaxSubstepDeltaTime),
+        1,
+        PhysicsSettings->MaxSubsteps);
+  }
+  else
+  {
+    Sample.PhysicsSubsteps = 1u;
+  }
+
+  FrameSamples[FrameSampleCount % FrameSampleCapacity] = Sample;
+  ++FrameSampleCount;
+}
+
+carla::rpc::FrameStats FCarlaEngine::GetFrameStats() const
+{
+  carla::rpc::FrameStats Stats;
+  Stats.frame = GFrameCounter;
+  const auto Count = std::min(FrameSampleCount, static_cast<uint64>(FrameSampleCapacity));
+  Stats.window_frames = Count;
+  if (Count == 0u)
+  {
+    return Stats;
+  }
+
+  float TotalDeltaMs = 0.0f;
+  float TotalSubsteps = 0.0f;
+  auto Accumulate = [](float &Avg, float &Max, float Value)
+  {
+    Avg += Value;
+    Max = FMath::Max(Max, Value);
+  };
+  for (uint64 i = 0u; i < Count; ++i)
+  {
+    const auto &Sample = FrameSamples[i];
+    TotalDeltaMs += Sample.DeltaMs;
+    Accumulate(Stats.game_ms_avg, Stats.game_ms_max, Sample.GameMs);
+    Accumulate(Stats.render_ms_avg, Stats.render_ms_max, Sample.RenderMs);
+    Accumulate(Stats.gpu_ms_avg, Stats.gpu_ms_max, Sample.GpuMs);
+    Accumulate(Stats.rhi_ms_avg, Stats.rhi_ms_max, Sample.RhiMs);
+    Accumulate(Stats.sensor_ms_avg, Stats.sensor_ms_max, Sample.SensorMs);
+    TotalSubsteps += Sample.PhysicsSubsteps;
+    Stats.physics_substeps_max = std::max(Stats.physics_substeps_max, Sample.PhysicsSubsteps);
+  }
+  Stats.game_ms_avg /= Count;
+  Stats.render_ms_avg /= Count;
+  Stats.gpu_ms_avg /= Count;
+  Stats.rhi_ms_avg /= Count;
+  Stats.sensor_ms_avg /= Count;
+  Stats.physics_substeps_avg = TotalSubsteps / Count;
+  Stats.fps = (TotalDeltaMs > 0.0f) ? (1e3f * Count / TotalDeltaMs) : 0.0f;
+  return Stats;
+}
@@ -13,6 +13,12 @@
 
 #include "Misc/CoreDelegates.h"
 
+#include <compiler/disable-ue4-macros.h>
+#include <carla/rpc/FrameStats.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <array>
+
 class UCarlaSettings;
 struct FEpisodeSettings;
 
@@ -43,6 +49,10 @@ public:
     Recorder = InRecorder;
   }
 
+  /// Aggregate the frame samples of the sliding window into a snapshot;
+  /// cheap enough to poll every second.
+  carla::rpc::FrameStats GetFrameStats() const;
+
 private:
 
   void OnPreTick(UWorld *World, ELevelTick TickType, float DeltaSeconds);
@@ -53,12 +63,52 @@ private:
 
   void ResetSimulationState();
 
+  /// Enter or leave fast-forward depending on the episode state: while
+  /// active, sensors do not tick, substepping is off and vehicles beyond
+  /// the relevance radius have their physics frozen.
+  void TickFastForward();
+
+  /// Frame-budget monitor for the SensorFrameBudgetMs episode setting:
+  /// compare the sensor cost of the previous frame against the budget and
+  /// move the episode throttle level one priority tier at a time, so the
+  /// lowest-priority sensors stop capturing first and the highest tier is
+  /// never dropped.
+  void TickSensorQoS();
+
+  /// Per-frame sample of the engine timing counters, recorded by
+  /// OnPostTick into a ring buffer.
+  struct FFrameSample
+  {
+    float DeltaMs = 0.0f;
+    float GameMs = 0.0f;
+    float RenderMs = 0.0f;
+    float GpuMs = 0.0f;
+    float RhiMs = 0.0f;
+    float SensorMs = 0.0f;
+    uint32 PhysicsSubsteps = 0u;
+  };
+
+  void RecordFrameSample(float DeltaSeconds);
+
   bool bIsRunning = false;
 
   bool bSynchronousMode = false;
 
+  /// Last applied no-rendering state, so the render cvar batch only runs
+  /// when the episode setting actually changes.
+  bool bNoRenderingMode = false;
+
   bool bMapChanged = false;
 
+  /// Whether the coarse fast-forward state is currently applied.
+  bool bFastForwardActive = false;
+
+  /// Sensors whose actor tick was disabled on entering fast-forward.
+  TArray<TWeakObjectPtr<AActor>> FastForwardSuspendedSensors;
+
+  /// Vehicles whose physics was frozen on entering fast-forward.
+  TArray<TWeakObjectPtr<AActor>> FastForwardFrozenVehicles;
+
   FCarlaServer Server;
 
   FWorldObserver WorldObserver;
@@ -72,4 +122,24 @@ private:
   FDelegateHandle OnPostTickHandle;
 
   FDelegateHandle OnEpisodeSettingsChangeHandle;
+
+  /// @name Frame statistics
+  ///
+  /// Ring buffer of recent frame samples; both the recording and the
+  /// aggregation run on the game thread (sync RPCs are serviced from
+  /// OnPostTick), so no locking is needed. Two hundred and fifty-six
+  /// frames cover a one-second polling interval at any sane frame rate.
+  /// @{
+
+  static constexpr uint32 FrameSampleCapacity = 256u;
+
+  std::array<FFrameSample, FrameSampleCapacity> FrameSamples;
+
+  uint64 FrameSampleCount = 0u;
+
+  /// Cumulative sensor seconds at the previous sample, to turn the
+  /// ever-growing per-sensor accumulators into a per-frame cost.
+  double PreviousSensorSeconds = 0.0;
+
+  /// @}
 };
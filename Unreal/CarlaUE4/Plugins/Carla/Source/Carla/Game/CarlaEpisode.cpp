@@ -18,6 +18,7 @@
 #include "Carla/Vehicle/VehicleSpawnPoint.h"
 #include "Carla/Game/CarlaStatics.h"
 
+#include "ContentStreaming.h"
 #include "Engine/StaticMeshActor.h"
 #include "EngineUtils.h"
 #include "GameFramework/SpectatorPawn.h"
@@ -218,6 +219,71 @@ void UCarlaEpisode::ApplySettings(const FEpisodeSettings &Settings)
   EpisodeSettings = Settings;
 }
 
+void UCarlaEpisode::SetRoutePrefetch(TArray<FVector> Route, float LookAhead)
+{
+  PrefetchRoute = MoveTemp(Route);
+  PrefetchLookAhead = LookAhead;
+  PrefetchCursor = 0;
+}
+
+void UCarlaEpisode::RequestFastForward(double Duration, float RelevanceRadius)
+{
+  FastForwardRemainingTime = FMath::Max(0.0, Duration);
+  FastForwardRelevanceRadius = FMath::Max(0.0f, RelevanceRadius);
+}
+
+void UCarlaEpisode::TickRoutePrefetch()
+{
+  if ((PrefetchRoute.Num() < 2) || (PrefetchLookAhead <= 0.0f))
+  {
+    return;
+  }
+
+  // Advance the cursor while the next route point is closer to the
+  // spectator than the current one.
+  const APawn *Reference = GetSpectatorPawn();
+  if (Reference != nullptr)
+  {
+    const FVector Location = Reference->GetActorLocation();
+    while ((PrefetchCursor + 1 < PrefetchRoute.Num()) &&
+           (FVector::DistSquared(PrefetchRoute[PrefetchCursor + 1], Location) <=
+            FVector::DistSquared(PrefetchRoute[PrefetchCursor], Location)))
+    {
+      ++PrefetchCursor;
+    }
+  }
+
+  // Register the window ahead of the cursor as slave streaming views so
+  // meshes and textures are warm before the ego reaches them.
+  float Remaining = PrefetchLookAhead;
+  for (int32 i = PrefetchCursor; (i + 1 < PrefetchRoute.Num()) && (Remaining > 0.0f); ++i)
+  {
+    IStreamingManager::Get().AddViewSlaveLocation(PrefetchRoute[i + 1]);
+    Remaining -= FVector::Dist(PrefetchRoute[i], PrefetchRoute[i + 1]);
+  }
+}
+
+void UCarlaEpisode::FastReset()
+{
+  // Collect first: destroying while iterating would invalidate the registry.
+  TArray<AActor *> SpawnedActors;
+  for (auto &&View : GetActorRegistry())
+  {
+    if (View.IsValid() && ActorDispatcher->IsSpawnedActor(View.GetActorId()))
+    {
+      SpawnedActors.Add(View.GetActor());
+    }
+  }
+  for (AActor *Actor : SpawnedActors)
+  {
+    DestroyActor(Actor);
+  }
+  if (Weather != nullptr)
+  {
+    Weather->ApplyWeather(FWeatherParameters());
+  }
+}
+
 TArray<FTransform> UCarlaEpisode::GetRecommendedSpawnPoints() const
 {
   TArray<FTransform> SpawnPoints;
@@ -254,6 +320,10 @@ void UCarlaEpisode::AttachActors(
 {
   UActorAttacher::AttachActors(Child, Parent, InAttachmentType);
 
+  // the registry snapshot resolves parent ids when it is taken; republish it
+  // now that the child got a new owner
+  ActorDispatcher->GetActorRegistry().RefreshSnapshot();
+
   // recorder event
   if (Recorder->IsEnabled())
   {
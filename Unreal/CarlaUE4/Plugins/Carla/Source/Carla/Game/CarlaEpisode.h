@@ -7,7 +7,10 @@
 #pragma once
 
 #include "Carla/Actor/ActorDispatcher.h"
+#include "Carla/Game/ActorBoundsOctree.h"
 #include "Carla/Recorder/CarlaRecorder.h"
+#include "Carla/Sensor/ActorKinematicsCache.h"
+#include "Carla/Sensor/SemanticTagResolver.h"
 #include "Carla/Sensor/WorldObserver.h"
 #include "Carla/Server/CarlaServer.h"
 #include "Carla/Settings/EpisodeSettings.h"
@@ -78,6 +81,12 @@ public:
   UFUNCTION(BlueprintCallable)
   void ApplySettings(const FEpisodeSettings &Settings);
 
+  /// Reset the episode without reloading the level: destroys every actor
+  /// spawned through the API (level-placed actors, streamed tiles and nav
+  /// data stay resident) and restores the default weather. Settings are left
+  /// untouched so synchronous clients keep their configuration.
+  void FastReset();
+
   // ===========================================================================
   // -- Retrieve info about this episode ---------------------------------------
   // ===========================================================================
@@ -111,6 +120,12 @@ public:
     return ActorDispatcher->GetActorDefinitions();
   }
 
+  /// Return the version counter of the actor definitions list.
+  uint64 GetActorDefinitionsVersion() const
+  {
+    return ActorDispatcher->GetActorDefinitionsVersion();
+  }
+
   /// Return the list of recommended spawn points for vehicles.
   UFUNCTION(BlueprintCallable)
   TArray<FTransform> GetRecommendedSpawnPoints() const;
@@ -144,6 +159,64 @@ public:
     return ActorDispatcher->GetActorRegistry();
   }
 
+  /// Octree of the bounds of every registered actor, shared by the sensors
+  /// so each of them does not pay a full-world query. Rebuilt at most once
+  /// per frame, on first use.
+  const FActorBoundsOctree &GetActorBoundsOctree() const
+  {
+    if (ActorBoundsOctree.GetFrameRebuilt() != GFrameCounter)
+    {
+      ActorBoundsOctree.Rebuild(GetActorRegistry());
+    }
+    return ActorBoundsOctree;
+  }
+
+  /// Replace the route the streaming system prefetches along; locations in
+  /// centimeters, @a LookAhead is the route distance kept warm past the
+  /// route point closest to the spectator. An empty route stops the
+  /// prefetching.
+  void SetRoutePrefetch(TArray<FVector> Route, float LookAhead);
+
+  /// Schedule @a Duration simulated seconds of fast-forward: sensor
+  /// capture is suspended and physics runs coarse until the target time
+  /// is reached. A @a RelevanceRadius (centimeters) above zero
+  /// additionally freezes physics on vehicles farther than that from the
+  /// spectator for the duration.
+  void RequestFastForward(double Duration, float RelevanceRadius);
+
+  /// Whether a fast-forward request is still running.
+  bool IsFastForwarding() const
+  {
+    return FastForwardRemainingTime > 0.0;
+  }
+
+  /// Current sensor throttle level, set by the engine's frame-budget
+  /// monitor; sensors with a sensor_priority below it skip their captures.
+  /// Zero throttles nothing.
+  int32 GetSensorPriorityThrottle() const
+  {
+    return SensorPriorityThrottle;
+  }
+
+  void SetSensorPriorityThrottle(int32 Level)
+  {
+    SensorPriorityThrottle = Level;
+  }
+
+  /// Cache for the lidar semantic ground-truth lookups, shared by every
+  /// lidar in the episode; see FSemanticTagResolver.
+  FSemanticTagResolver &GetSemanticTagResolver() const
+  {
+    return SemanticTagResolver;
+  }
+
+  /// Per-frame physics-state samples shared by the proprioceptive sensors
+  /// attached to the same actor; see FActorKinematicsCache.
+  FActorKinematicsCache &GetActorKinematicsCache() const
+  {
+    return ActorKinematicsCache;
+  }
+
   // ===========================================================================
   // -- Actor look up methods --------------------------------------------------
   // ===========================================================================
@@ -307,8 +380,16 @@ private:
   void TickTimers(float DeltaSeconds)
   {
     ElapsedGameTime += DeltaSeconds;
+    if (FastForwardRemainingTime > 0.0)
+    {
+      FastForwardRemainingTime -= DeltaSeconds;
+    }
   }
 
+  /// Register the prefetch route window ahead of the spectator as
+  /// streaming views; views only last one frame, so this runs every tick.
+  void TickRoutePrefetch();
+
   const uint64 Id = 0u;
 
   double ElapsedGameTime = 0.0;
@@ -331,4 +412,36 @@ private:
   ACarlaRecorder *Recorder = nullptr;
 
   carla::geom::GeoLocation MapGeoReference;
+
+  /// Planned route fed by the client for streaming prefetch, in
+  /// centimeters.
+  TArray<FVector> PrefetchRoute;
+
+  /// Route distance in centimeters kept warm past the cursor.
+  float PrefetchLookAhead = 0.0f;
+
+  /// Route point closest to the spectator so far; only moves forward so
+  /// route loops do not snap it back.
+  int32 PrefetchCursor = 0;
+
+  /// Simulated seconds of fast-forward still pending; counted down by
+  /// TickTimers.
+  double FastForwardRemainingTime = 0.0;
+
+  /// Distance from the spectator (centimeters) past which vehicle physics
+  /// is frozen while fast-forwarding; zero freezes nothing.
+  float FastForwardRelevanceRadius = 0.0f;
+
+  /// See GetSensorPriorityThrottle.
+  int32 SensorPriorityThrottle = 0;
+
+  /// See GetSemanticTagResolver.
+  mutable FSemanticTagResolver SemanticTagResolver;
+
+  /// See GetActorKinematicsCache.
+  mutable FActorKinematicsCache ActorKinematicsCache;
+
+  /// Shared octree of registered actor bounds, rebuilt lazily once per
+  /// frame by GetActorBoundsOctree.
+  mutable FActorBoundsOctree ActorBoundsOctree;
 };
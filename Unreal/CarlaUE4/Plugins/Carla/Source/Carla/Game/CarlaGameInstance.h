@@ -78,6 +78,11 @@ public:
     return CarlaEngine.GetServer();
   }
 
+  const FCarlaEngine &GetCarlaEngine() const
+  {
+    return CarlaEngine;
+  }
+
   void SetOpendriveGenerationParameters(
       const carla::rpc::OpendriveGenerationParameters & Parameters) 
   {
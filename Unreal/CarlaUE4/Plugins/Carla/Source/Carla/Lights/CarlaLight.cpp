@@ -44,6 +44,7 @@ void UCarlaLight::SetLightIntensity(float Intensity)
 {
   LightIntensity = Intensity;
   UpdateLights();
+  NotifyLightChange();
 }
 
 float UCarlaLight::GetLightIntensity() const
@@ -55,6 +56,7 @@ void UCarlaLight::SetLightColor(FLinearColor Color)
 {
   LightColor = Color;
   UpdateLights();
+  NotifyLightChange();
   RecordLightChange();
 }
 
@@ -67,6 +69,7 @@ void UCarlaLight::SetLightOn(bool bOn)
 {
   bLightOn = bOn;
   UpdateLights();
+  NotifyLightChange();
   RecordLightChange();
 }
 
@@ -78,6 +81,7 @@ bool UCarlaLight::GetLightOn() const
 void UCarlaLight::SetLightType(ELightType Type)
 {
   LightType = Type;
+  NotifyLightChange();
 }
 
 ELightType UCarlaLight::GetLightType() const
@@ -107,6 +111,7 @@ void UCarlaLight::SetLightState(carla::rpc::LightState LightState)
   LightType = static_cast<ELightType>(LightState._group);
   bLightOn = LightState._active;
   UpdateLights();
+  NotifyLightChange();
   RecordLightChange();
 }
 
@@ -125,6 +130,16 @@ void UCarlaLight::SetId(int InId)
   Id = InId;
 }
 
+void UCarlaLight::NotifyLightChange() const
+{
+  UWorld *World = GetWorld();
+  if(World)
+  {
+    UCarlaLightSubsystem* CarlaLightSubsystem = World->GetSubsystem<UCarlaLightSubsystem>();
+    CarlaLightSubsystem->OnLightChanged(*this);
+  }
+}
+
 void UCarlaLight::RecordLightChange() const
 {
   auto* Episode = UCarlaStatics::GetCurrentEpisode(GetWorld());
@@ -104,4 +104,6 @@ protected:
   private:
 
   void RecordLightChange() const;
+
+  void NotifyLightChange() const;
 };
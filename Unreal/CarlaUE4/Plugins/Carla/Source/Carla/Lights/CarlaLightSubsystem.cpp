@@ -29,6 +29,7 @@ void UCarlaLightSubsystem::RegisterLight(UCarlaLight* CarlaLight)
       return;
     }
     Lights.Add(LightId, CarlaLight);
+    LightVersions.Add(LightId, ++LightsVersion);
   }
 }
 
@@ -37,14 +38,20 @@ void UCarlaLightSubsystem::UnregisterLight(UCarlaLight* CarlaLight)
   if(CarlaLight)
   {
     Lights.Remove(CarlaLight->GetId());
+    LightVersions.Remove(CarlaLight->GetId());
   }
 }
 
+void UCarlaLightSubsystem::OnLightChanged(const UCarlaLight& CarlaLight)
+{
+  LightVersions.FindOrAdd(CarlaLight.GetId()) = ++LightsVersion;
+}
+
 bool UCarlaLightSubsystem::IsUpdatePending() const
 {
-  for (auto ClientPair : ClientStates)
+  for (auto ClientPair : ClientVersions)
   {
-    if(ClientPair.Value)
+    if(ClientPair.Value < LightsVersion)
     {
       return true;
     }
@@ -56,14 +63,20 @@ std::vector<carla::rpc::LightState> UCarlaLightSubsystem::GetLights(FString Clie
 {
   std::vector<carla::rpc::LightState> result;
 
-  ClientStates.FindOrAdd(Client) = false;
+  uint64& KnownVersion = ClientVersions.FindOrAdd(Client);
 
+  // Only the lights that changed since the client's last query; a client
+  // never seen before starts at version zero and gets the full list.
   for(auto& Light : Lights)
   {
-    UCarlaLight* CarlaLight = Light.Value;
+    if(LightVersions.FindRef(Light.Key) > KnownVersion)
+    {
+      UCarlaLight* CarlaLight = Light.Value;
 
-    result.push_back(CarlaLight->GetLightState());
+      result.push_back(CarlaLight->GetLightState());
+    }
   }
+  KnownVersion = LightsVersion;
   return result;
 }
 
@@ -72,20 +85,19 @@ void UCarlaLightSubsystem::SetLights(
   std::vector<carla::rpc::LightState> LightsToSet,
   bool DiscardClient)
 {
-  bool* ClientState = ClientStates.Find(Client);
-
-  if(ClientState) {
+  if(ClientVersions.Contains(Client)) {
     for(auto& LightState : LightsToSet) {
       UCarlaLight* CarlaLight = Lights.FindRef(LightState._id);
       if(CarlaLight) {
+        // Bumps the light's version through OnLightChanged, so every other
+        // client is served the change on its next query.
         CarlaLight->SetLightState(LightState);
       }
     }
-    *ClientState = true;
 
     if(DiscardClient)
     {
-      ClientStates.Remove(Client);
+      ClientVersions.Remove(Client);
     }
   }
 
@@ -99,15 +111,3 @@ UCarlaLight* UCarlaLightSubsystem::GetLight(int Id)
   }
   return nullptr;
 }
-
-void UCarlaLightSubsystem::SetClientStatesdirty(FString ClientThatUpdate)
-{
-  for(auto& Client : ClientStates)
-  {
-    if(Client.Key != ClientThatUpdate)
-    {
-      Client.Value = true;
-    }
-
-  }
-}
@@ -40,6 +40,10 @@ public:
 
   void UnregisterLight(UCarlaLight* CarlaLight);
 
+  // Called by the lights whenever their state changes, so clients can be
+  // served a diff of only the lights that changed since their last query.
+  void OnLightChanged(const UCarlaLight& CarlaLight);
+
   UFUNCTION(BlueprintCallable)
   bool IsUpdatePending() const;
 
@@ -63,12 +67,17 @@ public:
   }
 private:
 
-  void SetClientStatesdirty(FString ClientThatUpdate);
-
   TMap<int, UCarlaLight* > Lights;
 
-  // Flag for each client to tell if an update needs to be done
-  TMap<FString, bool> ClientStates;
+  // Monotonic counter bumped on every light change.
+  uint64 LightsVersion = 0u;
+
+  // Version of the last change of each light.
+  TMap<int, uint64> LightVersions;
+
+  // Last version each client was served; queries only return the lights
+  // that changed after it.
+  TMap<FString, uint64> ClientVersions;
   // Since the clients doesn't have a proper id on the simulation,
   // I use the host : port pair.
 
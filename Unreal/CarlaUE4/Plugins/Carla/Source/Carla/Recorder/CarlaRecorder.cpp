@@ -6,6 +6,7 @@
 
 #include "Carla.h"
 #include "Carla/Actor/ActorDescription.h"
+#include "Carla/Sensor/Sensor.h"
 #include "Carla/Walker/WalkerControl.h"
 #include "Carla/Walker/WalkerController.h"
 
@@ -23,6 +24,7 @@ ACarlaRecorder::ACarlaRecorder(void)
 {
   PrimaryActorTick.TickGroup = TG_PrePhysics;
   Disable();
+  SensorDataPacketId = RegisterCustomPacketType("sensor.data");
 }
 
 ACarlaRecorder::ACarlaRecorder(const FObjectInitializer &ObjectInitializer)
@@ -30,6 +32,7 @@ ACarlaRecorder::ACarlaRecorder(const FObjectInitializer &ObjectInitializer)
 {
   PrimaryActorTick.TickGroup = TG_PrePhysics;
   Disable();
+  SensorDataPacketId = RegisterCustomPacketType("sensor.data");
 }
 
 std::string ACarlaRecorder::ShowFileInfo(std::string Name, bool bShowAll)
@@ -53,6 +56,12 @@ std::string ACarlaRecorder::ReplayFile(std::string Name, double TimeStart, doubl
   return Replayer.ReplayFile(Name, TimeStart, Duration, FollowId);
 }
 
+std::string ACarlaRecorder::ReplayBatch(std::vector<std::string> Names, double TimeFactor)
+{
+  Stop();
+  return Replayer.ReplayBatch(std::move(Names), TimeFactor);
+}
+
 inline void ACarlaRecorder::SetReplayerTimeFactor(double TimeFactor)
 {
   Replayer.SetTimeFactor(TimeFactor);
@@ -65,6 +74,7 @@ inline void ACarlaRecorder::SetReplayerIgnoreHero(bool IgnoreHero)
 
 inline void ACarlaRecorder::StopReplayer(bool KeepActors)
 {
+  Replayer.ClearBatch();
   Replayer.Stop(KeepActors);
 }
 
@@ -340,6 +350,24 @@ void ACarlaRecorder::AddTrafficLightTime(const ATrafficLightBase& TrafficLight)
   }
 }
 
+uint8_t ACarlaRecorder::RegisterCustomPacketType(FString Name)
+{
+  check(CustomPacketNames.Num() < (256 - static_cast<int32>(CarlaRecorderPacketId::CustomBase)));
+  CustomPacketNames.Add(std::move(Name));
+  return static_cast<uint8_t>(CarlaRecorderPacketId::CustomBase) + CustomPacketNames.Num() - 1;
+}
+
+void ACarlaRecorder::AddCustomPacket(
+    uint8_t PacketId,
+    uint32_t DatabaseId,
+    std::shared_ptr<const carla::streaming::detail::tcp::Message> Payload)
+{
+  if (Enabled)
+  {
+    CustomPackets.Add(CarlaRecorderCustomPacket{PacketId, DatabaseId, std::move(Payload)});
+  }
+}
+
 std::string ACarlaRecorder::Start(std::string Name, FString MapName, bool AdditionalData)
 {
   // stop replayer if any in course
@@ -355,9 +383,8 @@ std::string ACarlaRecorder::Start(std::string Name, FString MapName, bool Additi
   // get the final path + filename
   std::string Filename = GetRecorderFilename(Name);
 
-  // binary file
-  File.open(Filename, std::ios::binary);
-  if (!File.is_open())
+  // binary file, written from a background thread
+  if (!Writer.Open(Filename))
   {
     return "";
   }
@@ -369,9 +396,12 @@ std::string ACarlaRecorder::Start(std::string Name, FString MapName, bool Additi
   Info.Mapfile = MapName;
 
   // write general info
-  Info.Write(File);
+  Info.Write(Writer.GetBuffer());
 
   Frames.Reset();
+  FrameIndex.Clear();
+  Positions.Reset();
+  bNextFrameFullPositions = false;
   PlatformTime.SetStartTime();
 
   Enable();
@@ -388,11 +418,28 @@ void ACarlaRecorder::Stop(void)
 {
   Disable();
 
-  if (File)
+  // stop mirroring sensor streams into the recording
+  if (Episode != nullptr)
   {
-    File.close();
+    const FActorRegistry &Registry = Episode->GetActorRegistry();
+    for (auto It = Registry.begin(); It != Registry.end(); ++It)
+    {
+      ASensor *Sensor = Cast<ASensor>((*It).GetActor());
+      if (Sensor != nullptr)
+      {
+        Sensor->DisableRecorderCapture();
+      }
+    }
   }
 
+  if (Writer.IsOpen())
+  {
+    // append the frame index footer before closing the file
+    FrameIndex.SetTotalTime(Frames.GetElapsedTime());
+    FrameIndex.Write(Writer.GetBuffer(), Writer.GetWrittenOffset());
+  }
+  Writer.Close();
+
   Clear();
 }
 
@@ -413,6 +460,7 @@ void ACarlaRecorder::Clear(void)
   TriggerVolumes.Clear();
   PhysicsControls.Clear();
   TrafficLightTimes.Clear();
+  CustomPackets.Clear();
 }
 
 void ACarlaRecorder::Write(double DeltaSeconds)
@@ -420,8 +468,15 @@ void ACarlaRecorder::Write(double DeltaSeconds)
   // update this frame data
   Frames.SetFrame(DeltaSeconds);
 
+  // the packets of this tick go into an in-memory block, handed to the
+  // background writer at the end
+  std::ostream &File = Writer.GetBuffer();
+
+  // index this frame for fast seeking on replay
+  FrameIndex.AddFrame(Frames.GetElapsedTime(), Writer.GetWrittenOffset());
+
   // start
-  Frames.WriteStart(File);
+  Frames.WriteStart(Writer);
 
   // events
   EventsAdd.Write(File);
@@ -430,7 +485,8 @@ void ACarlaRecorder::Write(double DeltaSeconds)
   Collisions.Write(File);
 
   // positions and states
-  Positions.Write(File);
+  Positions.Write(File, bNextFrameFullPositions);
+  bNextFrameFullPositions = false;
   States.Write(File);
 
   // animations
@@ -450,9 +506,20 @@ void ACarlaRecorder::Write(double DeltaSeconds)
     TrafficLightTimes.Write(File);
   }
 
+  // payloads captured from the sensor streams (or any other registered
+  // custom packet)
+  CustomPackets.Write(File);
+
   // end
   Frames.WriteEnd(File);
 
+  // snapshot a keyframe pointing at the next frame, now that every event
+  // of this one is in the stream; that next frame then gets full position
+  // records, so a replay jumping to it doesn't depend on earlier deltas
+  bNextFrameFullPositions = FrameIndex.MaybeAddKeyframe(Frames.GetElapsedTime(), Writer.GetWrittenOffset());
+
+  Writer.SubmitBlock();
+
   Clear();
 }
 
@@ -468,6 +535,7 @@ void ACarlaRecorder::AddEvent(const CarlaRecorderEventAdd &Event)
 {
   if (Enabled)
   {
+    FrameIndex.OnEventAdd(Event);
     EventsAdd.Add(std::move(Event));
   }
 }
@@ -476,6 +544,7 @@ void ACarlaRecorder::AddEvent(const CarlaRecorderEventDel &Event)
 {
   if (Enabled)
   {
+    FrameIndex.OnEventDel(Event);
     EventsDel.Add(std::move(Event));
   }
 }
@@ -484,6 +553,7 @@ void ACarlaRecorder::AddEvent(const CarlaRecorderEventParent &Event)
 {
   if (Enabled)
   {
+    FrameIndex.OnEventParent(Event);
     EventsParent.Add(std::move(Event));
   }
 }
@@ -680,4 +750,12 @@ void ACarlaRecorder::CreateRecorderEventAdd(
     // Bounding box in local coordinates
     AddActorBoundingBox(ActorView);
   }
+
+  ASensor* Sensor = Cast<ASensor>(ActorView.GetActor());
+  if (Sensor && bAdditionalData)
+  {
+    // mirror the sensor's stream into the recording; the payload buffers
+    // are shared with the network message so nothing is serialized twice
+    Sensor->EnableRecorderCapture(*this, ActorView.GetActorId());
+  }
 }
@@ -21,9 +21,12 @@
 #include "CarlaRecorderAnimVehicle.h"
 #include "CarlaRecorderAnimWalker.h"
 #include "CarlaRecorderCollision.h"
+#include "CarlaRecorderCustomPacket.h"
 #include "CarlaRecorderEventAdd.h"
 #include "CarlaRecorderEventDel.h"
 #include "CarlaRecorderEventParent.h"
+#include "CarlaRecorderFileWriter.h"
+#include "CarlaRecorderFrameIndex.h"
 #include "CarlaRecorderFrames.h"
 #include "CarlaRecorderInfo.h"
 #include "CarlaRecorderPosition.h"
@@ -59,7 +62,13 @@ enum class CarlaRecorderPacketId : uint8_t
   PlatformTime,
   PhysicsControl,
   TrafficLightTime,
-  TriggerVolume
+  TriggerVolume,
+  FrameIndex,
+  PositionDelta,
+
+  // ids from here upwards are assigned at runtime through
+  // ACarlaRecorder::RegisterCustomPacketType; readers skip unknown ids
+  CustomBase = 100
 };
 
 /// Recorder for the simulation
@@ -122,6 +131,25 @@ public:
 
   void AddTrafficLightTime(const ATrafficLightBase& TrafficLight);
 
+  /// Assign a packet id to a new packet type. Packets recorded under it are
+  /// written into the frames they were captured in; readers that don't know
+  /// the id skip it by its size.
+  uint8_t RegisterCustomPacketType(FString Name);
+
+  /// Record a serialized payload under a registered packet id. Thread-safe;
+  /// the payload buffers are shared with the caller, not copied.
+  void AddCustomPacket(
+      uint8_t PacketId,
+      uint32_t DatabaseId,
+      std::shared_ptr<const carla::streaming::detail::tcp::Message> Payload);
+
+  /// Packet id used to capture raw sensor output (see
+  /// ASensor::EnableRecorderCapture).
+  uint8_t GetSensorDataPacketId(void) const
+  {
+    return SensorDataPacketId;
+  }
+
   // set episode
   void SetEpisode(UCarlaEpisode *ThisEpisode)
   {
@@ -148,6 +176,7 @@ public:
 
   // replayer
   std::string ReplayFile(std::string Name, double TimeStart, double Duration, uint32_t FollowId);
+  std::string ReplayBatch(std::vector<std::string> Names, double TimeFactor);
   void SetReplayerTimeFactor(double TimeFactor);
   void SetReplayerIgnoreHero(bool IgnoreHero);
   void StopReplayer(bool KeepActors = false);
@@ -163,8 +192,15 @@ private:
 
   uint32_t NextCollisionId = 0;
 
-  // files
-  std::ofstream File;
+  // force full position records on the next frame (set after a keyframe,
+  // so a replay jumping there doesn't depend on earlier deltas)
+  bool bNextFrameFullPositions = false;
+
+  // background writer of the recording file
+  CarlaRecorderFileWriter Writer;
+
+  // frame index appended as footer when the recording stops
+  CarlaRecorderFrameIndex FrameIndex;
 
   UCarlaEpisode *Episode = nullptr;
 
@@ -187,6 +223,12 @@ private:
   CarlaRecorderPlatformTime PlatformTime;
   CarlaRecorderPhysicsControls PhysicsControls;
   CarlaRecorderTrafficLightTimes TrafficLightTimes;
+  CarlaRecorderCustomPackets CustomPackets;
+
+  // names of the registered custom packet types, indexed by id - CustomBase
+  TArray<FString> CustomPacketNames;
+
+  uint8_t SensorDataPacketId = 0;
 
 
   // replayer
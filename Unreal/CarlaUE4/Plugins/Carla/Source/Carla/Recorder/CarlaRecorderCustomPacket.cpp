@@ -0,0 +1,54 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "CarlaRecorderCustomPacket.h"
+#include "CarlaRecorder.h"
+#include "CarlaRecorderHelpers.h"
+
+void CarlaRecorderCustomPacket::Write(std::ostream &OutFile) const
+{
+  // write the packet id
+  WriteValue<char>(OutFile, static_cast<char>(PacketId));
+
+  // write the packet size
+  uint32_t Total = sizeof(uint32_t) + Payload->size();
+  WriteValue<uint32_t>(OutFile, Total);
+
+  WriteValue<uint32_t>(OutFile, this->DatabaseId);
+
+  // the message segments already hold the serialized payload, write them
+  // out as they are; the first segment is the wire-size prefix, our packet
+  // header replaces it
+  auto Sequence = Payload->GetBufferSequence();
+  auto It = Sequence.begin();
+  for (++It; It != Sequence.end(); ++It)
+  {
+    OutFile.write(reinterpret_cast<const char *>(It->data()), It->size());
+  }
+}
+
+// ---------------------------------------------
+
+void CarlaRecorderCustomPackets::Clear(void)
+{
+  std::lock_guard<std::mutex> Guard(Mutex);
+  Packets.clear();
+}
+
+void CarlaRecorderCustomPackets::Add(CarlaRecorderCustomPacket InObj)
+{
+  std::lock_guard<std::mutex> Guard(Mutex);
+  Packets.push_back(std::move(InObj));
+}
+
+void CarlaRecorderCustomPackets::Write(std::ostream &OutFile)
+{
+  std::lock_guard<std::mutex> Guard(Mutex);
+  for (auto &Packet : Packets)
+  {
+    Packet.Write(OutFile);
+  }
+}
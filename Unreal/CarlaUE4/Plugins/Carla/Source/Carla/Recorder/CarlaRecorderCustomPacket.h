@@ -0,0 +1,50 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/streaming/detail/tcp/Message.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct CarlaRecorderCustomPacket
+{
+  // id handed out by ACarlaRecorder::RegisterCustomPacketType
+  uint8_t PacketId;
+
+  // actor the payload belongs to (0 if none)
+  uint32_t DatabaseId;
+
+  // serialized payload, shared with the network message; the bytes are
+  // written once by the stream serializer and referenced here, never copied
+  std::shared_ptr<const carla::streaming::detail::tcp::Message> Payload;
+
+  void Write(std::ostream &OutFile) const;
+};
+
+class CarlaRecorderCustomPackets
+{
+public:
+
+  void Add(CarlaRecorderCustomPacket InObj);
+
+  void Clear(void);
+
+  void Write(std::ostream &OutFile);
+
+private:
+
+  // payloads are captured from the streaming threads while Write and Clear
+  // run on the game thread
+  std::mutex Mutex;
+
+  std::vector<CarlaRecorderCustomPacket> Packets;
+};
@@ -0,0 +1,173 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Recorder/CarlaRecorderFileWriter.h"
+
+#include "Misc/Compression.h"
+
+#include <cstring>
+
+CarlaRecorderFileWriter::~CarlaRecorderFileWriter()
+{
+  Close();
+}
+
+bool CarlaRecorderFileWriter::Open(const std::string &Filename)
+{
+  Close();
+
+  File.open(Filename, std::ios::binary);
+  if (!File.is_open())
+  {
+    return false;
+  }
+
+  File.write(CompressedRecorderMagic, sizeof(CompressedRecorderMagic));
+
+  Buffer.str(std::string());
+  HeldBlock.clear();
+  SubmittedOffset = 0u;
+  bStopRequested = false;
+  bIsOpen = true;
+  Worker = std::thread(&CarlaRecorderFileWriter::Run, this);
+  return true;
+}
+
+void CarlaRecorderFileWriter::SubmitBlock(void)
+{
+  std::string Block = Buffer.str();
+  Buffer.str(std::string());
+
+  // the previously held block cannot be patched anymore, off it goes
+  if (!HeldBlock.empty())
+  {
+    SubmittedOffset += HeldBlock.size();
+    {
+      std::lock_guard<std::mutex> Guard(Mutex);
+      PendingBlocks.emplace_back(std::move(HeldBlock));
+    }
+    Condition.notify_one();
+  }
+
+  HeldBlock = std::move(Block);
+}
+
+uint64_t CarlaRecorderFileWriter::GetWrittenOffset(void)
+{
+  return SubmittedOffset + HeldBlock.size() + static_cast<uint64_t>(Buffer.tellp());
+}
+
+void CarlaRecorderFileWriter::PatchDouble(uint64_t StreamOffset, double Value)
+{
+  if (StreamOffset < SubmittedOffset)
+  {
+    // too far back, the bytes are already on their way to disk
+    return;
+  }
+
+  uint64_t Offset = StreamOffset - SubmittedOffset;
+  if (Offset < HeldBlock.size())
+  {
+    std::memcpy(&HeldBlock[Offset], &Value, sizeof(Value));
+  }
+  else
+  {
+    Offset -= HeldBlock.size();
+    const std::streampos Pos = Buffer.tellp();
+    Buffer.seekp(Offset, std::ios::beg);
+    Buffer.write(reinterpret_cast<const char *>(&Value), sizeof(Value));
+    Buffer.seekp(Pos, std::ios::beg);
+  }
+}
+
+void CarlaRecorderFileWriter::Close(void)
+{
+  if (!bIsOpen)
+  {
+    return;
+  }
+
+  // whatever is left in the buffer or held back goes out as last blocks
+  SubmitBlock();
+  SubmitBlock();
+
+  {
+    std::lock_guard<std::mutex> Guard(Mutex);
+    bStopRequested = true;
+  }
+  Condition.notify_one();
+  Worker.join();
+
+  File.close();
+  bIsOpen = false;
+}
+
+void CarlaRecorderFileWriter::Run(void)
+{
+  // seconds between flushes of the stream to disk
+  constexpr double FlushPeriod = 2.0;
+  double LastFlush = FPlatformTime::Seconds();
+
+  std::vector<std::string> Blocks;
+  std::vector<uint8_t> Compressed;
+
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      Condition.wait(Lock, [this]() {
+        return bStopRequested || !PendingBlocks.empty();
+      });
+      if (PendingBlocks.empty())
+      {
+        // only stop once every submitted block has been written
+        break;
+      }
+      Blocks.swap(PendingBlocks);
+    }
+
+    for (const std::string &Block : Blocks)
+    {
+      const int32 UncompressedSize = static_cast<int32>(Block.size());
+      int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+      Compressed.resize(CompressedSize);
+
+      const bool bCompressed = FCompression::CompressMemory(
+          NAME_Zlib,
+          Compressed.data(),
+          CompressedSize,
+          Block.data(),
+          UncompressedSize);
+
+      CarlaRecorderBlockHeader Header;
+      Header.UncompressedSize = static_cast<uint32_t>(UncompressedSize);
+      if (bCompressed && (CompressedSize < UncompressedSize))
+      {
+        Header.CompressedSize = static_cast<uint32_t>(CompressedSize);
+        File.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+        File.write(reinterpret_cast<const char *>(Compressed.data()), CompressedSize);
+      }
+      else
+      {
+        // store the block as is
+        Header.CompressedSize = Header.UncompressedSize;
+        File.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+        File.write(Block.data(), UncompressedSize);
+      }
+    }
+    Blocks.clear();
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastFlush >= FlushPeriod)
+    {
+      File.flush();
+      LastFlush = Now;
+    }
+  }
+
+  File.flush();
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// magic bytes at the start of a compressed recorder file; legacy files
+// start directly with the info packet instead
+constexpr char CompressedRecorderMagic[8] = {'C', 'A', 'R', 'L', 'A', 'Z', 'I', 'P'};
+
+#pragma pack(push, 1)
+struct CarlaRecorderBlockHeader
+{
+  uint32_t UncompressedSize;
+
+  // equal to UncompressedSize when the block is stored without compression
+  uint32_t CompressedSize;
+};
+#pragma pack(pop)
+
+/// Writes recorder packets to disk from a background thread.
+///
+/// The game thread serializes each tick into an in-memory block and hands it
+/// over with SubmitBlock; the worker compresses the blocks (zlib, through
+/// FCompression) and appends them to the file, flushing periodically, so the
+/// game thread never waits on the disk.
+class CarlaRecorderFileWriter
+{
+public:
+
+  ~CarlaRecorderFileWriter();
+
+  bool Open(const std::string &Filename);
+
+  bool IsOpen(void) const
+  {
+    return bIsOpen;
+  }
+
+  // in-memory stream the packets of the current block are written to
+  std::ostream &GetBuffer(void)
+  {
+    return Buffer;
+  }
+
+  // hand the current block over; the previous one goes to the background
+  // thread, this one is held in memory until the next submission so its
+  // bytes can still be patched (see PatchDouble)
+  void SubmitBlock(void);
+
+  // offset in the uncompressed stream the next byte will be written at
+  uint64_t GetWrittenOffset(void);
+
+  // overwrite a double at an absolute stream offset; only works while the
+  // bytes are still in memory, i.e. in the held block or the buffer
+  void PatchDouble(uint64_t StreamOffset, double Value);
+
+  // flush the pending blocks and close the file
+  void Close(void);
+
+private:
+
+  void Run(void);
+
+  std::ostringstream Buffer;
+
+  // last submitted block, kept in memory until the next submission so the
+  // previous frame record can still be patched
+  std::string HeldBlock;
+
+  // stream offset where the held block starts
+  uint64_t SubmittedOffset = 0u;
+
+  // blocks ready to be compressed and written, swapped with a worker-local
+  // buffer under the mutex
+  std::vector<std::string> PendingBlocks;
+
+  std::ofstream File;
+
+  std::thread Worker;
+
+  std::mutex Mutex;
+
+  std::condition_variable Condition;
+
+  bool bIsOpen = false;
+
+  bool bStopRequested = false;
+};
@@ -0,0 +1,163 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "CarlaRecorder.h"
+#include "CarlaRecorderFrameIndex.h"
+#include "CarlaRecorderHelpers.h"
+
+#include <sstream>
+
+void CarlaRecorderFrameIndex::Clear(void)
+{
+  TotalTime = 0.0;
+  LastKeyframeTime = 0.0;
+  Frames.clear();
+  Keyframes.clear();
+  AliveActors.clear();
+  ParentLinks.clear();
+  bValid = false;
+}
+
+void CarlaRecorderFrameIndex::AddFrame(double Time, uint64_t Offset)
+{
+  Frames.push_back(CarlaRecorderFrameIndexEntry{Time, Offset});
+}
+
+void CarlaRecorderFrameIndex::OnEventAdd(const CarlaRecorderEventAdd &Event)
+{
+  AliveActors[Event.DatabaseId] = Event;
+}
+
+void CarlaRecorderFrameIndex::OnEventDel(const CarlaRecorderEventDel &Event)
+{
+  AliveActors.erase(Event.DatabaseId);
+  ParentLinks.erase(Event.DatabaseId);
+}
+
+void CarlaRecorderFrameIndex::OnEventParent(const CarlaRecorderEventParent &Event)
+{
+  ParentLinks[Event.DatabaseId] = Event;
+}
+
+bool CarlaRecorderFrameIndex::MaybeAddKeyframe(double Time, uint64_t NextFrameOffset)
+{
+  if (Time - LastKeyframeTime < KeyframePeriod)
+  {
+    return false;
+  }
+  LastKeyframeTime = Time;
+
+  CarlaRecorderFrameIndexKeyframe Keyframe;
+  Keyframe.Time = Time;
+  Keyframe.FrameOffset = NextFrameOffset;
+
+  // same layout the replayer parses for live event packets: a counter
+  // followed by the records, creations first, then parenting
+  std::ostringstream Blob;
+  WriteValue<uint16_t>(Blob, static_cast<uint16_t>(AliveActors.size()));
+  for (const auto &Item : AliveActors)
+  {
+    Item.second.Write(Blob);
+  }
+  WriteValue<uint16_t>(Blob, static_cast<uint16_t>(ParentLinks.size()));
+  for (const auto &Item : ParentLinks)
+  {
+    Item.second.Write(Blob);
+  }
+  Keyframe.Blob = Blob.str();
+
+  Keyframes.push_back(std::move(Keyframe));
+  return true;
+}
+
+void CarlaRecorderFrameIndex::Write(std::ostream &OutFile, uint64_t PacketOffset)
+{
+  // serialize the payload first to know the packet size
+  std::ostringstream Payload;
+  WriteValue<double>(Payload, TotalTime);
+
+  WriteValue<uint32_t>(Payload, static_cast<uint32_t>(Frames.size()));
+  for (const auto &Entry : Frames)
+  {
+    WriteValue<double>(Payload, Entry.Time);
+    WriteValue<uint64_t>(Payload, Entry.Offset);
+  }
+
+  WriteValue<uint32_t>(Payload, static_cast<uint32_t>(Keyframes.size()));
+  for (const auto &Keyframe : Keyframes)
+  {
+    WriteValue<double>(Payload, Keyframe.Time);
+    WriteValue<uint64_t>(Payload, Keyframe.FrameOffset);
+    WriteValue<uint32_t>(Payload, static_cast<uint32_t>(Keyframe.Blob.size()));
+    Payload.write(Keyframe.Blob.data(), Keyframe.Blob.size());
+  }
+
+  std::string Data = Payload.str();
+
+  // write the packet
+  WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::FrameIndex));
+  WriteValue<uint32_t>(OutFile, static_cast<uint32_t>(Data.size()));
+  OutFile.write(Data.data(), Data.size());
+
+  // trailing pointer back to the packet, so the replayer can find it from
+  // the end of the file
+  WriteValue<uint64_t>(OutFile, PacketOffset);
+  OutFile.write(FrameIndexMagic, sizeof(FrameIndexMagic));
+}
+
+bool CarlaRecorderFrameIndex::Read(std::istream &InFile)
+{
+  Clear();
+
+  ReadValue<double>(InFile, TotalTime);
+
+  uint32_t Total;
+  ReadValue<uint32_t>(InFile, Total);
+  Frames.reserve(Total);
+  for (uint32_t i = 0; i < Total && InFile; ++i)
+  {
+    CarlaRecorderFrameIndexEntry Entry;
+    ReadValue<double>(InFile, Entry.Time);
+    ReadValue<uint64_t>(InFile, Entry.Offset);
+    Frames.push_back(Entry);
+  }
+
+  ReadValue<uint32_t>(InFile, Total);
+  Keyframes.reserve(Total);
+  for (uint32_t i = 0; i < Total && InFile; ++i)
+  {
+    CarlaRecorderFrameIndexKeyframe Keyframe;
+    ReadValue<double>(InFile, Keyframe.Time);
+    ReadValue<uint64_t>(InFile, Keyframe.FrameOffset);
+    uint32_t BlobSize;
+    ReadValue<uint32_t>(InFile, BlobSize);
+    // the snapshot stays in the file, keep its offset to seek to it
+    Keyframe.BlobOffset = static_cast<uint64_t>(InFile.tellg());
+    InFile.seekg(BlobSize, std::ios::cur);
+    Keyframes.push_back(std::move(Keyframe));
+  }
+
+  bValid = static_cast<bool>(InFile);
+  return bValid;
+}
+
+const CarlaRecorderFrameIndexKeyframe *CarlaRecorderFrameIndex::FindKeyframe(double Time) const
+{
+  // a keyframe points at the frame following its snapshot, keep a small
+  // guard so the target time is never before the frame we land on
+  constexpr double Guard = 1.0;
+
+  const CarlaRecorderFrameIndexKeyframe *Best = nullptr;
+  for (const auto &Keyframe : Keyframes)
+  {
+    if (Keyframe.Time + Guard > Time)
+    {
+      break;
+    }
+    Best = &Keyframe;
+  }
+  return Best;
+}
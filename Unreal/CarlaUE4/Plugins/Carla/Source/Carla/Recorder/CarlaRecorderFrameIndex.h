@@ -0,0 +1,114 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CarlaRecorderEventAdd.h"
+#include "CarlaRecorderEventDel.h"
+#include "CarlaRecorderEventParent.h"
+
+// magic bytes closing an indexed recording, preceded by the offset of the
+// frame index packet
+constexpr char FrameIndexMagic[8] = {'C', 'A', 'R', 'L', 'A', 'I', 'D', 'X'};
+
+struct CarlaRecorderFrameIndexEntry
+{
+  double Time;
+  uint64_t Offset;
+};
+
+struct CarlaRecorderFrameIndexKeyframe
+{
+  double Time;
+
+  // offset of the first frame packet after the snapshot
+  uint64_t FrameOffset;
+
+  // recorder side: serialized snapshot of the events needed to respawn the
+  // actors alive at this time
+  std::string Blob;
+
+  // replayer side: offset of the snapshot in the file, valid after Read
+  uint64_t BlobOffset = 0u;
+};
+
+/// Index of frame times to file offsets, appended as a footer when a
+/// recording stops, so the replayer can seek into long recordings without
+/// scanning them from the start. Every few seconds a keyframe snapshots
+/// the events needed to respawn the actors alive at that point.
+class CarlaRecorderFrameIndex
+{
+public:
+
+  void Clear(void);
+
+  // -------- recorder side --------
+
+  void AddFrame(double Time, uint64_t Offset);
+
+  // keep track of the actors alive and their parenting
+  void OnEventAdd(const CarlaRecorderEventAdd &Event);
+  void OnEventDel(const CarlaRecorderEventDel &Event);
+  void OnEventParent(const CarlaRecorderEventParent &Event);
+
+  // snapshot a keyframe if enough time has passed since the last one;
+  // NextFrameOffset is the offset the next frame packet will start at, so
+  // it has to be called once every event of the current frame is written;
+  // returns true when a keyframe was added
+  bool MaybeAddKeyframe(double Time, uint64_t NextFrameOffset);
+
+  void SetTotalTime(double Time)
+  {
+    TotalTime = Time;
+  }
+
+  // write the footer: the index packet plus a trailing pointer and magic
+  // tag; PacketOffset is the offset the packet itself starts at
+  void Write(std::ostream &OutFile, uint64_t PacketOffset);
+
+  // -------- replayer side --------
+
+  // read the index packet payload, the stream has to be positioned right
+  // after its header
+  bool Read(std::istream &InFile);
+
+  bool IsValid(void) const
+  {
+    return bValid;
+  }
+
+  double GetTotalTime(void) const
+  {
+    return TotalTime;
+  }
+
+  // latest keyframe safely before Time, nullptr if none helps
+  const CarlaRecorderFrameIndexKeyframe *FindKeyframe(double Time) const;
+
+private:
+
+  // seconds between keyframes
+  static constexpr double KeyframePeriod = 10.0;
+
+  double TotalTime = 0.0;
+
+  double LastKeyframeTime = 0.0;
+
+  std::vector<CarlaRecorderFrameIndexEntry> Frames;
+
+  std::vector<CarlaRecorderFrameIndexKeyframe> Keyframes;
+
+  // running state of the recording, snapshotted into the keyframes
+  std::unordered_map<uint32_t, CarlaRecorderEventAdd> AliveActors;
+  std::unordered_map<uint32_t, CarlaRecorderEventParent> ParentLinks;
+
+  bool bValid = false;
+};
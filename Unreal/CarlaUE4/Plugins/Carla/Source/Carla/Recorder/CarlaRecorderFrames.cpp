@@ -8,12 +8,12 @@
 #include "CarlaRecorderFrames.h"
 #include "CarlaRecorderHelpers.h"
 
-void CarlaRecorderFrame::Read(std::ifstream &InFile)
+void CarlaRecorderFrame::Read(std::istream &InFile)
 {
   ReadValue<CarlaRecorderFrame>(InFile, *this);
 }
 
-void CarlaRecorderFrame::Write(std::ofstream &OutFile)
+void CarlaRecorderFrame::Write(std::ostream &OutFile)
 {
   WriteValue<CarlaRecorderFrame>(OutFile, *this);
 }
@@ -49,9 +49,9 @@ void CarlaRecorderFrames::SetFrame(double DeltaSeconds)
   ++Frame.Id;
 }
 
-void CarlaRecorderFrames::WriteStart(std::ofstream &OutFile)
+void CarlaRecorderFrames::WriteStart(CarlaRecorderFileWriter &Writer)
 {
-  std::streampos Pos, Offset;
+  std::ostream &OutFile = Writer.GetBuffer();
   double Dummy = -1.0f;
 
   // write the packet id
@@ -63,24 +63,22 @@ void CarlaRecorderFrames::WriteStart(std::ofstream &OutFile)
 
   // write frame record
   WriteValue<uint64_t>(OutFile, Frame.Id);
-  Offset = OutFile.tellp();
+  uint64_t Offset = Writer.GetWrittenOffset();
   WriteValue<double>(OutFile, Dummy);
   WriteValue<double>(OutFile, Frame.Elapsed);
 
-  // we need to write this duration to previous frame
+  // we need to write this duration to previous frame; its bytes may not
+  // be in the current buffer anymore, so it goes through the writer
   if (OffsetPreviousFrame > 0)
   {
-    Pos = OutFile.tellp();
-    OutFile.seekp(OffsetPreviousFrame, std::ios::beg);
-    WriteValue<double>(OutFile, Frame.DurationThis);
-    OutFile.seekp(Pos, std::ios::beg);
+    Writer.PatchDouble(OffsetPreviousFrame, Frame.DurationThis);
   }
 
   // save position for next actualization
   OffsetPreviousFrame = Offset;
 }
 
-void CarlaRecorderFrames::WriteEnd(std::ofstream &OutFile)
+void CarlaRecorderFrames::WriteEnd(std::ostream &OutFile)
 {
   // write the packet id
   WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::FrameEnd));
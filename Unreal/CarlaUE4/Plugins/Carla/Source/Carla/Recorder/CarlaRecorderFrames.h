@@ -8,6 +8,8 @@
 
 #include <fstream>
 
+#include "CarlaRecorderFileWriter.h"
+
 #pragma pack(push, 1)
 struct CarlaRecorderFrame
 {
@@ -15,9 +17,9 @@ struct CarlaRecorderFrame
   double DurationThis;
   double Elapsed;
 
-  void Read(std::ifstream &InFile);
+  void Read(std::istream &InFile);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 
 };
 #pragma pack(pop)
@@ -32,11 +34,18 @@ public:
 
   void SetFrame(double DeltaSeconds);
 
-  void WriteStart(std::ofstream &OutFile);
-  void WriteEnd(std::ofstream &OutFile);
+  double GetElapsedTime(void) const
+  {
+    return Frame.Elapsed;
+  }
+
+  // the writer is needed to patch the duration of the previous frame,
+  // whose bytes may already be in a held block
+  void WriteStart(CarlaRecorderFileWriter &Writer);
+  void WriteEnd(std::ostream &OutFile);
 
 private:
 
   CarlaRecorderFrame Frame;
-  std::streampos OffsetPreviousFrame;
+  uint64_t OffsetPreviousFrame;
 };
@@ -4,9 +4,13 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <algorithm>
+#include <fstream>
 #include <vector>
 
 #include "UnrealString.h"
+#include "Misc/Compression.h"
+#include "CarlaRecorderFileWriter.h"
 #include "CarlaRecorderHelpers.h"
 
 // create a temporal buffer to convert from and to FString and bytes
@@ -29,12 +33,62 @@ std::string GetRecorderFilename(std::string Filename)
   return Filename2;
 }
 
+// if the recording is compressed, inflate it to a sidecar file and return
+// its path; plain recordings are returned untouched
+std::string CheckAndInflateRecorderFile(const std::string &Filename)
+{
+  std::ifstream File(Filename, std::ios::binary);
+  char Magic[sizeof(CompressedRecorderMagic)];
+  if (!File.read(Magic, sizeof(Magic)) ||
+      !std::equal(std::begin(Magic), std::end(Magic), std::begin(CompressedRecorderMagic)))
+  {
+    return Filename;
+  }
+
+  std::string InflatedFilename = Filename + ".inflated";
+  std::ofstream Out(InflatedFilename, std::ios::binary);
+  if (!Out.is_open())
+  {
+    return Filename;
+  }
+
+  CarlaRecorderBlockHeader Header;
+  std::vector<char> Compressed;
+  std::vector<char> Uncompressed;
+  while (File.read(reinterpret_cast<char *>(&Header), sizeof(Header)))
+  {
+    Uncompressed.resize(Header.UncompressedSize);
+    if (Header.CompressedSize == Header.UncompressedSize)
+    {
+      // stored block
+      if (!File.read(Uncompressed.data(), Header.UncompressedSize))
+        break;
+    }
+    else
+    {
+      Compressed.resize(Header.CompressedSize);
+      if (!File.read(Compressed.data(), Header.CompressedSize))
+        break;
+      if (!FCompression::UncompressMemory(
+          NAME_Zlib,
+          Uncompressed.data(),
+          static_cast<int32>(Header.UncompressedSize),
+          Compressed.data(),
+          static_cast<int32>(Header.CompressedSize)))
+        break;
+    }
+    Out.write(Uncompressed.data(), Header.UncompressedSize);
+  }
+
+  return InflatedFilename;
+}
+
 // ------
 // write
 // ------
 
 // write binary data from FVector
-void WriteFVector(std::ofstream &OutFile, const FVector &InObj)
+void WriteFVector(std::ostream &OutFile, const FVector &InObj)
 {
   WriteValue<float>(OutFile, InObj.X);
   WriteValue<float>(OutFile, InObj.Y);
@@ -42,13 +96,13 @@ void WriteFVector(std::ofstream &OutFile, const FVector &InObj)
 }
 
 // write binary data from FTransform
-// void WriteFTransform(std::ofstream &OutFile, const FTransform &InObj){
+// void WriteFTransform(std::ostream &OutFile, const FTransform &InObj){
 // WriteFVector(OutFile, InObj.GetTranslation());
 // WriteFVector(OutFile, InObj.GetRotation().Euler());
 // }
 
 // write binary data from FString (length + text)
-void WriteFString(std::ofstream &OutFile, const FString &InObj)
+void WriteFString(std::ostream &OutFile, const FString &InObj)
 {
   // encode the string to UTF8 to know the final length
   FTCHARToUTF8 EncodedString(*InObj);
@@ -63,7 +117,7 @@ void WriteFString(std::ofstream &OutFile, const FString &InObj)
 // -----
 
 // read binary data to FVector
-void ReadFVector(std::ifstream &InFile, FVector &OutObj)
+void ReadFVector(std::istream &InFile, FVector &OutObj)
 {
   ReadValue<float>(InFile, OutObj.X);
   ReadValue<float>(InFile, OutObj.Y);
@@ -71,7 +125,7 @@ void ReadFVector(std::ifstream &InFile, FVector &OutObj)
 }
 
 // read binary data to FTransform
-// void ReadFTransform(std::ifstream &InFile, FTransform &OutObj){
+// void ReadFTransform(std::istream &InFile, FTransform &OutObj){
 // FVector Vec;
 // ReadFVector(InFile, Vec);
 // OutObj.SetTranslation(Vec);
@@ -80,7 +134,7 @@ void ReadFVector(std::ifstream &InFile, FVector &OutObj)
 // }
 
 // read binary data to FString (length + text)
-void ReadFString(std::ifstream &InFile, FString &OutObj)
+void ReadFString(std::istream &InFile, FString &OutObj)
 {
   uint16_t Length;
   ReadValue<uint16_t>(InFile, Length);
@@ -12,19 +12,23 @@
 // get the final path + filename
 std::string GetRecorderFilename(std::string Filename);
 
+// if the recording at Filename is compressed, inflate it to a sidecar file
+// and return its path; plain recordings are returned untouched
+std::string CheckAndInflateRecorderFile(const std::string &Filename);
+
 // ---------
 // recorder
 // ---------
 
 // write binary data (using sizeof())
 template <typename T>
-void WriteValue(std::ofstream &OutFile, const T &InObj)
+void WriteValue(std::ostream &OutFile, const T &InObj)
 {
   OutFile.write(reinterpret_cast<const char *>(&InObj), sizeof(T));
 }
 
 template <typename T>
-void WriteStdVector(std::ofstream &OutFile, const std::vector<T> &InVec)
+void WriteStdVector(std::ostream &OutFile, const std::vector<T> &InVec)
 {
   WriteValue<uint32_t>(OutFile, InVec.size());
   for (const auto& InObj : InVec)
@@ -34,7 +38,7 @@ void WriteStdVector(std::ofstream &OutFile, const std::vector<T> &InVec)
 }
 
 template <typename T>
-void WriteTArray(std::ofstream &OutFile, const TArray<T> &InVec)
+void WriteTArray(std::ostream &OutFile, const TArray<T> &InVec)
 {
   WriteValue<uint32_t>(OutFile, InVec.Num());
   for (const auto& InObj : InVec)
@@ -44,12 +48,12 @@ void WriteTArray(std::ofstream &OutFile, const TArray<T> &InVec)
 }
 
 // write binary data from FVector
-void WriteFVector(std::ofstream &OutFile, const FVector &InObj);
+void WriteFVector(std::ostream &OutFile, const FVector &InObj);
 
 // write binary data from FTransform
-// void WriteFTransform(std::ofstream &OutFile, const FTransform &InObj);
+// void WriteFTransform(std::ostream &OutFile, const FTransform &InObj);
 // write binary data from FString (length + text)
-void WriteFString(std::ofstream &OutFile, const FString &InObj);
+void WriteFString(std::ostream &OutFile, const FString &InObj);
 
 // ---------
 // replayer
@@ -57,13 +61,13 @@ void WriteFString(std::ofstream &OutFile, const FString &InObj);
 
 // read binary data (using sizeof())
 template <typename T>
-void ReadValue(std::ifstream &InFile, T &OutObj)
+void ReadValue(std::istream &InFile, T &OutObj)
 {
   InFile.read(reinterpret_cast<char *>(&OutObj), sizeof(T));
 }
 
 template <typename T>
-void ReadStdVector(std::ifstream &InFile, std::vector<T> &OutVec)
+void ReadStdVector(std::istream &InFile, std::vector<T> &OutVec)
 {
   uint32_t VecSize;
   ReadValue<uint32_t>(InFile, VecSize);
@@ -77,7 +81,7 @@ void ReadStdVector(std::ifstream &InFile, std::vector<T> &OutVec)
 }
 
 template <typename T>
-void ReadTArray(std::ifstream &InFile, TArray<T> &OutVec)
+void ReadTArray(std::istream &InFile, TArray<T> &OutVec)
 {
   uint32_t VecSize;
   ReadValue<uint32_t>(InFile, VecSize);
@@ -91,9 +95,9 @@ void ReadTArray(std::ifstream &InFile, TArray<T> &OutVec)
 }
 
 // read binary data from FVector
-void ReadFVector(std::ifstream &InFile, FVector &OutObj);
+void ReadFVector(std::istream &InFile, FVector &OutObj);
 
 // read binary data from FTransform
-// void ReadTransform(std::ifstream &InFile, FTransform &OutObj);
+// void ReadTransform(std::istream &InFile, FTransform &OutObj);
 // read binary data from FString (length + text)
-void ReadFString(std::ifstream &InFile, FString &OutObj);
+void ReadFString(std::istream &InFile, FString &OutObj);
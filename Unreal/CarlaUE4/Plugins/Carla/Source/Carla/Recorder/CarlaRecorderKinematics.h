@@ -16,9 +16,9 @@ struct CarlaRecorderKinematics
   FVector LinearVelocity;
   FVector AngularVelocity;
 
-  void Read(std::ifstream &InFile);
+  void Read(std::istream &InFile);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 };
 #pragma pack(pop)
 
@@ -30,7 +30,7 @@ class CarlaRecorderActorsKinematics
 
   void Clear(void);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 
 private:
 
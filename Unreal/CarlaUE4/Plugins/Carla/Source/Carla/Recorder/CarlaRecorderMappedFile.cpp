@@ -0,0 +1,75 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "CarlaRecorderMappedFile.h"
+
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+
+#include <fstream>
+
+CarlaRecorderMappedFile::~CarlaRecorderMappedFile()
+{
+  Close();
+}
+
+bool CarlaRecorderMappedFile::Open(const std::string &Filename)
+{
+  Close();
+
+  // try to map the file first
+  IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+  Handle = PlatformFile.OpenMapped(UTF8_TO_TCHAR(Filename.c_str()));
+  if (Handle != nullptr)
+  {
+    Region = Handle->MapRegion(0, Handle->GetFileSize());
+    if (Region != nullptr)
+    {
+      Data = Region->GetMappedPtr();
+      Size = Region->GetMappedSize();
+      return true;
+    }
+    delete Handle;
+    Handle = nullptr;
+  }
+
+  // mapping not supported, read the whole file into memory
+  std::ifstream File(Filename, std::ios::binary);
+  if (!File.is_open())
+  {
+    return false;
+  }
+  File.seekg(0, std::ios::end);
+  Fallback.resize(static_cast<size_t>(File.tellg()));
+  File.seekg(0, std::ios::beg);
+  File.read(reinterpret_cast<char *>(Fallback.data()), Fallback.size());
+  if (!File)
+  {
+    Fallback.clear();
+    return false;
+  }
+
+  Data = Fallback.data();
+  Size = Fallback.size();
+  return true;
+}
+
+void CarlaRecorderMappedFile::Close(void)
+{
+  if (Region != nullptr)
+  {
+    delete Region;
+    Region = nullptr;
+  }
+  if (Handle != nullptr)
+  {
+    delete Handle;
+    Handle = nullptr;
+  }
+  Fallback.clear();
+  Data = nullptr;
+  Size = 0u;
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/// Read-only view of a whole recorder file, memory-mapped when the
+/// platform supports it and loaded into memory otherwise. The queries use
+/// it to scan big recordings without a syscall per field.
+class CarlaRecorderMappedFile
+{
+public:
+
+  ~CarlaRecorderMappedFile();
+
+  bool Open(const std::string &Filename);
+
+  bool IsOpen(void) const
+  {
+    return Data != nullptr;
+  }
+
+  void Close(void);
+
+  const uint8_t *GetData(void) const
+  {
+    return Data;
+  }
+
+  uint64_t GetSize(void) const
+  {
+    return Size;
+  }
+
+private:
+
+  IMappedFileHandle *Handle = nullptr;
+  IMappedFileRegion *Region = nullptr;
+
+  // used when the platform cannot map files
+  std::vector<uint8_t> Fallback;
+
+  const uint8_t *Data = nullptr;
+  uint64_t Size = 0u;
+};
+
+/// std::istream over a slice of a mapped file, so the packet Read
+/// functions work unchanged on mapped memory.
+class CarlaRecorderMappedStream : private std::streambuf, public std::istream
+{
+public:
+
+  CarlaRecorderMappedStream(const uint8_t *InData, uint64_t InSize)
+    : std::istream(this)
+  {
+    char *Begin = const_cast<char *>(reinterpret_cast<const char *>(InData));
+    setg(Begin, Begin, Begin + InSize);
+  }
+
+protected:
+
+  std::streampos seekoff(std::streamoff Off, std::ios_base::seekdir Dir, std::ios_base::openmode) override
+  {
+    std::streamoff Pos;
+    switch (Dir)
+    {
+      case std::ios_base::cur:
+        Pos = (gptr() - eback()) + Off;
+        break;
+      case std::ios_base::end:
+        Pos = (egptr() - eback()) + Off;
+        break;
+      default:
+        Pos = Off;
+        break;
+    }
+    if (Pos < 0 || Pos > (egptr() - eback()))
+    {
+      return std::streampos(std::streamoff(-1));
+    }
+    setg(eback(), eback() + Pos, egptr());
+    return Pos;
+  }
+
+  std::streampos seekpos(std::streampos Pos, std::ios_base::openmode Which) override
+  {
+    return seekoff(std::streamoff(Pos), std::ios_base::beg, Which);
+  }
+};
@@ -21,9 +21,9 @@ struct CarlaRecorderPlatformTime
   void SetStartTime();
   void UpdateTime();
 
-  void Read(std::ifstream &InFile);
+  void Read(std::istream &InFile);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 
 };
 #pragma pack(pop)
@@ -8,7 +8,7 @@
 #include "CarlaRecorderPosition.h"
 #include "CarlaRecorderHelpers.h"
 
-void CarlaRecorderPosition::Write(std::ofstream &OutFile)
+void CarlaRecorderPosition::Write(std::ostream &OutFile)
 {
   // database id
   WriteValue<uint32_t>(OutFile, this->DatabaseId);
@@ -16,7 +16,7 @@ void CarlaRecorderPosition::Write(std::ofstream &OutFile)
   WriteFVector(OutFile, this->Location);
   WriteFVector(OutFile, this->Rotation);
 }
-void CarlaRecorderPosition::Read(std::ifstream &InFile)
+void CarlaRecorderPosition::Read(std::istream &InFile)
 {
   // database id
   ReadValue<uint32_t>(InFile, this->DatabaseId);
@@ -27,33 +27,133 @@ void CarlaRecorderPosition::Read(std::ifstream &InFile)
 
 // ---------------------------------------------
 
+void CarlaRecorderPositionDelta::Write(std::ostream &OutFile)
+{
+  WriteValue<CarlaRecorderPositionDelta>(OutFile, *this);
+}
+
+void CarlaRecorderPositionDelta::Read(std::istream &InFile)
+{
+  ReadValue<CarlaRecorderPositionDelta>(InFile, *this);
+}
+
+CarlaRecorderPosition CarlaRecorderPositionDelta::Expand(const CarlaRecorderPosition &Base) const
+{
+  CarlaRecorderPosition Pos;
+  Pos.DatabaseId = DatabaseId;
+  Pos.Location.X = Base.Location.X + LocationDelta[0] * PositionDeltaLocationScale;
+  Pos.Location.Y = Base.Location.Y + LocationDelta[1] * PositionDeltaLocationScale;
+  Pos.Location.Z = Base.Location.Z + LocationDelta[2] * PositionDeltaLocationScale;
+  Pos.Rotation.X = WrapRecorderAngle(Base.Rotation.X + RotationDelta[0] * PositionDeltaRotationScale);
+  Pos.Rotation.Y = WrapRecorderAngle(Base.Rotation.Y + RotationDelta[1] * PositionDeltaRotationScale);
+  Pos.Rotation.Z = WrapRecorderAngle(Base.Rotation.Z + RotationDelta[2] * PositionDeltaRotationScale);
+  return Pos;
+}
+
+// ---------------------------------------------
+
 void CarlaRecorderPositions::Clear(void)
 {
   Positions.clear();
 }
 
+void CarlaRecorderPositions::Reset(void)
+{
+  Positions.clear();
+  PreviousPositions.clear();
+}
+
 void CarlaRecorderPositions::Add(const CarlaRecorderPosition &Position)
 {
   Positions.push_back(Position);
 }
 
-void CarlaRecorderPositions::Write(std::ofstream &OutFile)
+void CarlaRecorderPositions::Write(std::ostream &OutFile, bool bFullSync)
 {
-  // write the packet id
+  uint32_t Total;
+  std::vector<CarlaRecorderPosition> Full;
+  std::vector<CarlaRecorderPositionDelta> Deltas;
+  Full.reserve(Positions.size());
+  Deltas.reserve(Positions.size());
+
+  for (const auto &Position : Positions)
+  {
+    auto Previous = PreviousPositions.find(Position.DatabaseId);
+
+    // new actors and forced syncs always get a full record
+    if (bFullSync || Previous == PreviousPositions.end())
+    {
+      Full.push_back(Position);
+      PreviousPositions[Position.DatabaseId] = Position;
+      continue;
+    }
+
+    const FVector LocationDelta = Position.Location - Previous->second.Location;
+    const FVector RotationDelta(
+        WrapRecorderAngle(Position.Rotation.X - Previous->second.Rotation.X),
+        WrapRecorderAngle(Position.Rotation.Y - Previous->second.Rotation.Y),
+        WrapRecorderAngle(Position.Rotation.Z - Previous->second.Rotation.Z));
+
+    // dead-band: the actor didn't really move, suppress the record; the
+    // previous position is kept as is, so a slow drift still gets written
+    // once it adds up past the dead-band
+    if (LocationDelta.GetAbsMax() < PositionDeadBandLocation &&
+        RotationDelta.GetAbsMax() < PositionDeadBandRotation)
+    {
+      continue;
+    }
+
+    // too big for the quantized range, fall back to a full record
+    if (LocationDelta.GetAbsMax() >= PositionDeltaLocationScale * 32767.0f ||
+        RotationDelta.GetAbsMax() >= PositionDeltaRotationScale * 32767.0f)
+    {
+      Full.push_back(Position);
+      Previous->second = Position;
+      continue;
+    }
+
+    CarlaRecorderPositionDelta Delta;
+    Delta.DatabaseId = Position.DatabaseId;
+    Delta.LocationDelta[0] = static_cast<int16_t>(std::lround(LocationDelta.X / PositionDeltaLocationScale));
+    Delta.LocationDelta[1] = static_cast<int16_t>(std::lround(LocationDelta.Y / PositionDeltaLocationScale));
+    Delta.LocationDelta[2] = static_cast<int16_t>(std::lround(LocationDelta.Z / PositionDeltaLocationScale));
+    Delta.RotationDelta[0] = static_cast<int16_t>(std::lround(RotationDelta.X / PositionDeltaRotationScale));
+    Delta.RotationDelta[1] = static_cast<int16_t>(std::lround(RotationDelta.Y / PositionDeltaRotationScale));
+    Delta.RotationDelta[2] = static_cast<int16_t>(std::lround(RotationDelta.Z / PositionDeltaRotationScale));
+
+    // keep the value the readers will reconstruct, so the quantization
+    // error doesn't accumulate over frames
+    Previous->second = Delta.Expand(Previous->second);
+    Deltas.push_back(Delta);
+  }
+
+  // write the full records
   WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::Position));
 
-  // write the packet size
-  uint32_t Total = 2 + Positions.size() * sizeof(CarlaRecorderPosition);
+  Total = 2 + Full.size() * sizeof(CarlaRecorderPosition);
+  WriteValue<uint32_t>(OutFile, Total);
+
+  Total = Full.size();
+  WriteValue<uint16_t>(OutFile, Total);
+
+  if (Total > 0)
+  {
+    OutFile.write(reinterpret_cast<const char *>(Full.data()),
+        Full.size() * sizeof(CarlaRecorderPosition));
+  }
+
+  // write the delta records
+  WriteValue<char>(OutFile, static_cast<char>(CarlaRecorderPacketId::PositionDelta));
+
+  Total = 2 + Deltas.size() * sizeof(CarlaRecorderPositionDelta);
   WriteValue<uint32_t>(OutFile, Total);
 
-  // write total records
-  Total = Positions.size();
+  Total = Deltas.size();
   WriteValue<uint16_t>(OutFile, Total);
 
-  // write records
   if (Total > 0)
   {
-    OutFile.write(reinterpret_cast<const char *>(Positions.data()),
-        Positions.size() * sizeof(CarlaRecorderPosition));
+    OutFile.write(reinterpret_cast<const char *>(Deltas.data()),
+        Deltas.size() * sizeof(CarlaRecorderPositionDelta));
   }
 }
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <cmath>
 #include <fstream>
+#include <unordered_map>
 #include <vector>
 
 #pragma pack(push, 1)
@@ -16,13 +18,48 @@ struct CarlaRecorderPosition
   FVector Location;
   FVector Rotation;
 
-  void Read(std::ifstream &InFile);
+  void Read(std::istream &InFile);
 
-  void Write(std::ofstream &OutFile);
+  void Write(std::ostream &OutFile);
 
 };
+
+// position encoded as a quantized delta against the previous position of
+// the same actor, expanded back by the readers
+struct CarlaRecorderPositionDelta
+{
+  uint32_t DatabaseId;
+  int16_t LocationDelta[3];
+  int16_t RotationDelta[3];
+
+  void Read(std::istream &InFile);
+
+  void Write(std::ostream &OutFile);
+
+  // apply this delta on top of a base position
+  CarlaRecorderPosition Expand(const CarlaRecorderPosition &Base) const;
+};
 #pragma pack(pop)
 
+// quantization step of the delta records (cm and degrees per unit)
+constexpr float PositionDeltaLocationScale = 0.01f;
+constexpr float PositionDeltaRotationScale = 0.01f;
+
+// actors that moved less than this since their last written position are
+// not written at all; parked vehicles cost no space this way
+constexpr float PositionDeadBandLocation = 0.1f;
+constexpr float PositionDeadBandRotation = 0.1f;
+
+// wrap an angle to [-180, 180); writer and readers both use it, so the
+// reconstructed rotations stay bit-identical
+inline float WrapRecorderAngle(float Degrees)
+{
+  Degrees = std::fmod(Degrees + 180.0f, 360.0f);
+  if (Degrees < 0.0f)
+    Degrees += 360.0f;
+  return Degrees - 180.0f;
+}
+
 class CarlaRecorderPositions
 {
 public:
@@ -31,9 +68,18 @@ public:
 
   void Clear(void);
 
-  void Write(std::ofstream &OutFile);
+  // forget all previous positions, the next write is full records only
+  void Reset(void);
+
+  // write the positions of this frame: full records for new actors and
+  // large jumps, quantized deltas for the rest, nothing for actors inside
+  // the dead-band; bFullSync forces full records for every actor
+  void Write(std::ostream &OutFile, bool bFullSync = false);
 
 private:
 
   std::vector<CarlaRecorderPosition> Positions;
+
+  // last written position of each actor, as the readers reconstruct it
+  std::unordered_map<uint32_t, CarlaRecorderPosition> PreviousPositions;
 };
@@ -6,6 +6,9 @@
 
 #include "CarlaRecorderHelpers.h"
 
+#include "Async/ParallelFor.h"
+
+#include <algorithm>
 #include <ctime>
 #include <sstream>
 #include <string>
@@ -28,10 +31,49 @@ inline void CarlaRecorderQuery::SkipPacket(void)
   File.seekg(Header.Size, std::ios::cur);
 }
 
-inline bool CarlaRecorderQuery::CheckFileInfo(std::stringstream &Info)
+void CarlaRecorderQuery::BuildPacketDirectory(std::istream &InFile, const PacketFilter &Filter)
+{
+  Directory.clear();
+  Frame.Id = 0;
+  Frame.DurationThis = 0.0f;
+  Frame.Elapsed = 0.0f;
+
+  while (InFile)
+  {
+    char Id;
+    uint32_t Size;
+    ReadValue<char>(InFile, Id);
+    ReadValue<uint32_t>(InFile, Size);
+    if (!InFile)
+    {
+      break;
+    }
+
+    // frames are always parsed, they carry the time of the packets
+    if (Id == static_cast<char>(CarlaRecorderPacketId::FrameStart))
+    {
+      Frame.Read(InFile);
+      continue;
+    }
+
+    const uint64_t Offset = static_cast<uint64_t>(InFile.tellg());
+    const bool bWanted = Filter.PacketIds.empty() ||
+        (std::find(Filter.PacketIds.begin(), Filter.PacketIds.end(), Id) != Filter.PacketIds.end());
+    if (bWanted && Frame.Elapsed >= Filter.MinTime && Frame.Elapsed <= Filter.MaxTime)
+    {
+      Directory.push_back(PacketSpan { Id, Size, Offset, Frame.Id, Frame.Elapsed });
+    }
+
+    // hop to the next header
+    InFile.seekg(Size, std::ios::cur);
+  }
+  InFile.clear();
+}
+
+inline bool CarlaRecorderQuery::CheckFileInfo(std::stringstream &Info, std::istream &InFile)
 {
   // read Info
-  RecInfo.Read(File);
+  RecInfo.Read(InFile);
 
   // check magic string
   if (RecInfo.Magic != "CARLA_RECORDER")
@@ -55,8 +97,8 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
 {
   std::stringstream Info;
 
-  // get the final path + filename
-  std::string Filename2 = GetRecorderFilename(Filename);
+  // get the final path + filename, inflating compressed recordings
+  std::string Filename2 = CheckAndInflateRecorderFile(GetRecorderFilename(Filename));
 
   // try to open
   File.open(Filename2, std::ios::binary);
@@ -75,7 +117,7 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
     Info << "Frame " << Frame.Id << " at " << Frame.Elapsed << " seconds\n";
   };
 
-  if (!CheckFileInfo(Info))
+  if (!CheckFileInfo(Info, File))
     return Info.str();
 
   // parse only frames
@@ -199,6 +241,27 @@ std::string CarlaRecorderQuery::QueryInfo(std::string Filename, bool bShowAll)
           SkipPacket();
         break;
 
+      // delta positions
+      case static_cast<char>(CarlaRecorderPacketId::PositionDelta):
+        if (bShowAll)
+        {
+          ReadValue<uint16_t>(File, Total);
+          if (Total > 0 && !bFramePrinted)
+          {
+            PrintFrame(Info);
+            bFramePrinted = true;
+          }
+          Info << " Delta positions: " << Total << std::endl;
+          for (i = 0; i < Total; ++i)
+          {
+            PositionDelta.Read(File);
+            Info << "  Id: " << PositionDelta.DatabaseId << " Delta location: (" << PositionDelta.LocationDelta[0] * PositionDeltaLocationScale << ", " << PositionDelta.LocationDelta[1] * PositionDeltaLocationScale << ", " << PositionDelta.LocationDelta[2] * PositionDeltaLocationScale << ") rotation (" << PositionDelta.RotationDelta[0] * PositionDeltaRotationScale << ", " << PositionDelta.RotationDelta[1] * PositionDeltaRotationScale << ", " << PositionDelta.RotationDelta[2] * PositionDeltaRotationScale << ")" << std::endl;
+          }
+        }
+        else
+          SkipPacket();
+        break;
+
       // traffic light
       case static_cast<char>(CarlaRecorderPacketId::State):
         if (bShowAll)
@@ -560,19 +623,29 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
 {
   std::stringstream Info;
 
-  // get the final path + filename
-  std::string Filename2 = GetRecorderFilename(Filename);
+  // get the final path + filename, inflating compressed recordings
+  std::string Filename2 = CheckAndInflateRecorderFile(GetRecorderFilename(Filename));
 
-  // try to open
-  File.open(Filename2, std::ios::binary);
-  if (!File.is_open())
+  // map the whole file in memory, this query scans large recordings
+  if (!Mapped.Open(Filename2))
   {
     Info << "File " << Filename2 << " not found on server\n";
     return Info.str();
   }
 
-  if (!CheckFileInfo(Info))
+  CarlaRecorderMappedStream Stream(Mapped.GetData(), Mapped.GetSize());
+  if (!CheckFileInfo(Info, Stream))
+  {
+    Mapped.Close();
     return Info.str();
+  }
+
+  // build the directory of the packets this query needs
+  PacketFilter Filter;
+  Filter.PacketIds = {
+      static_cast<char>(CarlaRecorderPacketId::EventAdd),
+      static_cast<char>(CarlaRecorderPacketId::Collision) };
+  BuildPacketDirectory(Stream, Filter);
 
   // other, vehicle, walkers, trafficLight, hero, any
   char Categories[] = { 'o', 'v', 'w', 't', 'h', 'a' };
@@ -595,6 +668,90 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
   };
   std::unordered_set<std::pair<uint32_t, uint32_t>, PairHash > oldCollisions, newCollisions;
 
+  // collect the actors first (few packets, and database ids are never
+  // reused within a recording)
+  std::vector<const PacketSpan *> CollisionSpans;
+  for (const auto &Span : Directory)
+  {
+    if (Span.Id == static_cast<char>(CarlaRecorderPacketId::Collision))
+    {
+      CollisionSpans.push_back(&Span);
+      continue;
+    }
+    CarlaRecorderMappedStream Packet(Mapped.GetData() + Span.Offset, Span.Size);
+    ReadValue<uint16_t>(Packet, Total);
+    for (i = 0; i < Total; ++i)
+    {
+      EventAdd.Read(Packet);
+      Actors[EventAdd.DatabaseId] = ReplayerActorInfo { EventAdd.Type, EventAdd.Description.Id };
+    }
+  }
+
+  // collision packets are independent of each other, parse and filter
+  // them in parallel; the actors map is read-only from here on
+  struct FilteredCollision
+  {
+    uint32_t DatabaseId1;
+    uint32_t DatabaseId2;
+    char Type1;
+    char Type2;
+  };
+  std::vector<std::vector<FilteredCollision>> Filtered(CollisionSpans.size());
+
+  ParallelFor(static_cast<int32>(CollisionSpans.size()), [&](int32 Index)
+  {
+    CarlaRecorderCollision ThisCollision;
+    CarlaRecorderMappedStream Packet(
+        Mapped.GetData() + CollisionSpans[Index]->Offset,
+        CollisionSpans[Index]->Size);
+    uint16_t Count;
+    ReadValue<uint16_t>(Packet, Count);
+    for (uint16_t j = 0; j < Count; ++j)
+    {
+      ThisCollision.Read(Packet);
+
+      // actor id pushdown
+      if (Filter.DatabaseId != 0 &&
+          ThisCollision.DatabaseId1 != Filter.DatabaseId &&
+          ThisCollision.DatabaseId2 != Filter.DatabaseId)
+        continue;
+
+      int Valid = 0;
+      // get categories for both actors (plain find, the map is shared
+      // between the worker threads)
+      auto Actor1 = Actors.find(ThisCollision.DatabaseId1);
+      auto Actor2 = Actors.find(ThisCollision.DatabaseId2);
+      uint8_t Type1 = Categories[Actor1 != Actors.end() ? Actor1->second.Type : 0];
+      uint8_t Type2 = Categories[Actor2 != Actors.end() ? Actor2->second.Type : 0];
+
+      // filter actor 1
+      if (Category1 == 'a')
+        ++Valid;
+      else if (Category1 == Type1)
+        ++Valid;
+      else if (Category1 == 'h' && ThisCollision.IsActor1Hero)
+        ++Valid;
+
+      // filter actor 2
+      if (Category2 == 'a')
+        ++Valid;
+      else if (Category2 == Type2)
+        ++Valid;
+      else if (Category2 == 'h' && ThisCollision.IsActor2Hero)
+        ++Valid;
+
+      // only keep if both actors passed the filter
+      if (Valid == 2)
+      {
+        Filtered[Index].push_back(FilteredCollision {
+            ThisCollision.DatabaseId1,
+            ThisCollision.DatabaseId2,
+            static_cast<char>(Type1),
+            static_cast<char>(Type2) });
+      }
+    }
+  });
+
   // header
   Info << std::setw(8) << "Time";
   Info << " " << std::setw(6) << "Types";
@@ -604,125 +761,47 @@ std::string CarlaRecorderQuery::QueryCollisions(std::string Filename, char Categ
   Info << " " << std::setw(35) << std::left << "Actor 2";
   Info << std::endl;
 
-  // parse only frames
-  while (File)
+  // emit in file order, using the frame ids to tell new collisions from
+  // continuations of the previous frame
+  uint64_t LastFrameId = 0;
+  for (size_t Index = 0; Index < CollisionSpans.size(); ++Index)
   {
-
-    // get header
-    if (!ReadHeader())
+    const PacketSpan &Span = *CollisionSpans[Index];
+    if (Span.FrameId != LastFrameId)
     {
-      break;
+      // exchange sets of collisions (to know when a collision is new or continue from previous frame)
+      if (Span.FrameId == LastFrameId + 1)
+        oldCollisions = std::move(newCollisions);
+      else
+        oldCollisions.clear();
+      newCollisions.clear();
+      LastFrameId = Span.FrameId;
     }
 
-    // check for a frame packet
-    switch (Header.Id)
+    for (const auto &Collision : Filtered[Index])
     {
-      // frame
-      case static_cast<char>(CarlaRecorderPacketId::FrameStart):
-        Frame.Read(File);
-        // exchange sets of collisions (to know when a collision is new or continue from previous frame)
-        oldCollisions = std::move(newCollisions);
-        newCollisions.clear();
-        break;
-
-      // events add
-      case static_cast<char>(CarlaRecorderPacketId::EventAdd):
-        ReadValue<uint16_t>(File, Total);
-        for (i = 0; i < Total; ++i)
-        {
-          // add
-          EventAdd.Read(File);
-          Actors[EventAdd.DatabaseId] = ReplayerActorInfo { EventAdd.Type, EventAdd.Description.Id };
-        }
-        break;
-
-      // events del
-      case static_cast<char>(CarlaRecorderPacketId::EventDel):
-        ReadValue<uint16_t>(File, Total);
-        for (i = 0; i < Total; ++i)
-        {
-          EventDel.Read(File);
-          Actors.erase(EventAdd.DatabaseId);
-        }
-        break;
-
-      // events parenting
-      case static_cast<char>(CarlaRecorderPacketId::EventParent):
-        SkipPacket();
-        break;
-
-      // collisions
-      case static_cast<char>(CarlaRecorderPacketId::Collision):
-        ReadValue<uint16_t>(File, Total);
-        for (i = 0; i < Total; ++i)
-        {
-          Collision.Read(File);
-
-          int Valid = 0;
-          // get categories for both actors
-          uint8_t Type1 = Categories[Actors[Collision.DatabaseId1].Type];
-          uint8_t Type2 = Categories[Actors[Collision.DatabaseId2].Type];
-
-          // filter actor 1
-          if (Category1 == 'a')
-            ++Valid;
-          else if (Category1 == Type1)
-            ++Valid;
-          else if (Category1 == 'h' && Collision.IsActor1Hero)
-            ++Valid;
-
-          // filter actor 2
-          if (Category2 == 'a')
-            ++Valid;
-          else if (Category2 == Type2)
-            ++Valid;
-          else if (Category2 == 'h' && Collision.IsActor2Hero)
-            ++Valid;
-
-          // only show if both actors has passed the filter
-          if (Valid == 2)
-          {
-            // check if we need to show as a starting collision or it is a continuation one
-            auto collisionPair = std::make_pair(Collision.DatabaseId1, Collision.DatabaseId2);
-            if (oldCollisions.count(collisionPair) == 0)
-            {
-              Info << std::setw(8) << std::setprecision(0) << std::right << std::fixed << Frame.Elapsed;
-              Info << " " << "  " << Type1 << " " << Type2 << " ";
-              Info << " " << std::setw(6) << std::right << Collision.DatabaseId1;
-              Info << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[Collision.DatabaseId1].Id);
-              Info << " " << std::setw(6) << std::right << Collision.DatabaseId2;
-              Info << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[Collision.DatabaseId2].Id);
-              Info << std::endl;
-            }
-            // save current collision
-            newCollisions.insert(collisionPair);
-          }
-        }
-        break;
-
-      case static_cast<char>(CarlaRecorderPacketId::Position):
-        SkipPacket();
-        break;
-
-      case static_cast<char>(CarlaRecorderPacketId::State):
-        SkipPacket();
-        break;
-
-      // frame end
-      case static_cast<char>(CarlaRecorderPacketId::FrameEnd):
-        // do nothing, it is empty
-        break;
-
-      default:
-        SkipPacket();
-        break;
+      // check if we need to show as a starting collision or it is a continuation one
+      auto collisionPair = std::make_pair(Collision.DatabaseId1, Collision.DatabaseId2);
+      if (oldCollisions.count(collisionPair) == 0)
+      {
+        Info << std::setw(8) << std::setprecision(0) << std::right << std::fixed << Span.FrameTime;
+        Info << " " << "  " << Collision.Type1 << " " << Collision.Type2 << " ";
+        Info << " " << std::setw(6) << std::right << Collision.DatabaseId1;
+        Info << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[Collision.DatabaseId1].Id);
+        Info << " " << std::setw(6) << std::right << Collision.DatabaseId2;
+        Info << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[Collision.DatabaseId2].Id);
+        Info << std::endl;
+      }
+      // save current collision
+      newCollisions.insert(collisionPair);
     }
   }
 
   Info << "\nFrames: " << Frame.Id << "\n";
   Info << "Duration: " << Frame.Elapsed << " seconds\n";
 
-  File.close();
+  Directory.clear();
+  Mapped.Close();
 
   return Info.str();
 }
@@ -731,8 +810,8 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
 {
   std::stringstream Info;
 
-  // get the final path + filename
-  std::string Filename2 = GetRecorderFilename(Filename);
+  // get the final path + filename, inflating compressed recordings
+  std::string Filename2 = CheckAndInflateRecorderFile(GetRecorderFilename(Filename));
 
   // try to open
   File.open(Filename2, std::ios::binary);
@@ -742,7 +821,7 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
     return Info.str();
   }
 
-  if (!CheckFileInfo(Info))
+  if (!CheckFileInfo(Info, File))
     return Info.str();
 
   // other, vehicle, walkers, trafficLight, hero, any
@@ -758,6 +837,39 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
   std::unordered_map<uint32_t, ReplayerActorInfo> Actors;
   // to be able to sort the results by the duration of each actor (decreasing order)
   std::multimap<double, std::string, std::greater<double>> Results;
+  // current position of each actor, to expand the delta records and to
+  // account for actors suppressed by the recorder dead-band
+  std::unordered_map<uint32_t, CarlaRecorderPosition> LastPositions;
+  std::unordered_map<uint32_t, bool> SeenThisFrame;
+
+  // check if an actor moved less than a distance since its last anchor
+  auto CheckStopped = [&](uint32_t DatabaseId, const FVector &Location)
+  {
+    if (FVector::Distance(Actors[DatabaseId].LastPosition, Location) < MinDistance)
+    {
+      // actor stopped
+      if (Actors[DatabaseId].Duration == 0)
+        Actors[DatabaseId].Time = Frame.Elapsed;
+      Actors[DatabaseId].Duration += Frame.DurationThis;
+    }
+    else
+    {
+      // check to show info
+      if (Actors[DatabaseId].Duration >= MinTime)
+      {
+        std::stringstream Result;
+        Result << std::setw(8) << std::setprecision(0) << std::fixed << Actors[DatabaseId].Time;
+        Result << " " << std::setw(6) << DatabaseId;
+        Result << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[DatabaseId].Id);
+        Result << " " << std::setw(10) << std::setprecision(0) << std::fixed << std::right << Actors[DatabaseId].Duration;
+        Result << std::endl;
+        Results.insert(std::make_pair(Actors[DatabaseId].Duration, Result.str()));
+      }
+      // actor moving
+      Actors[DatabaseId].Duration = 0;
+      Actors[DatabaseId].LastPosition = Location;
+    }
+  };
 
   // header
   Info << std::setw(8) << "Time";
@@ -782,6 +894,7 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
       // frame
       case static_cast<char>(CarlaRecorderPacketId::FrameStart):
         Frame.Read(File);
+        SeenThisFrame.clear();
         break;
 
       // events add
@@ -801,7 +914,8 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
         for (i = 0; i < Total; ++i)
         {
           EventDel.Read(File);
-          Actors.erase(EventAdd.DatabaseId);
+          Actors.erase(EventDel.DatabaseId);
+          LastPositions.erase(EventDel.DatabaseId);
         }
         break;
 
@@ -822,31 +936,25 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
         for (i=0; i<Total; ++i)
         {
           Position.Read(File);
-          // check if actor moved less than a distance
-          if (FVector::Distance(Actors[Position.DatabaseId].LastPosition, Position.Location) < MinDistance)
-          {
-            // actor stopped
-            if (Actors[Position.DatabaseId].Duration == 0)
-              Actors[Position.DatabaseId].Time = Frame.Elapsed;
-            Actors[Position.DatabaseId].Duration += Frame.DurationThis;
-          }
-          else
-          {
-            // check to show info
-            if (Actors[Position.DatabaseId].Duration >= MinTime)
-            {
-              std::stringstream Result;
-              Result << std::setw(8) << std::setprecision(0) << std::fixed << Actors[Position.DatabaseId].Time;
-              Result << " " << std::setw(6) << Position.DatabaseId;
-              Result << " " << std::setw(35) << std::left << TCHAR_TO_UTF8(*Actors[Position.DatabaseId].Id);
-              Result << " " << std::setw(10) << std::setprecision(0) << std::fixed << std::right << Actors[Position.DatabaseId].Duration;
-              Result << std::endl;
-              Results.insert(std::make_pair(Actors[Position.DatabaseId].Duration, Result.str()));
-            }
-            // actor moving
-            Actors[Position.DatabaseId].Duration = 0;
-            Actors[Position.DatabaseId].LastPosition = Position.Location;
-          }
+          LastPositions[Position.DatabaseId] = Position;
+          SeenThisFrame[Position.DatabaseId] = true;
+          CheckStopped(Position.DatabaseId, Position.Location);
+        }
+        break;
+
+      // delta positions
+      case static_cast<char>(CarlaRecorderPacketId::PositionDelta):
+        // read and expand all delta positions
+        ReadValue<uint16_t>(File, Total);
+        for (i=0; i<Total; ++i)
+        {
+          PositionDelta.Read(File);
+          auto Last = LastPositions.find(PositionDelta.DatabaseId);
+          if (Last == LastPositions.end())
+            continue;
+          Last->second = PositionDelta.Expand(Last->second);
+          SeenThisFrame[PositionDelta.DatabaseId] = true;
+          CheckStopped(PositionDelta.DatabaseId, Last->second.Location);
         }
         break;
 
@@ -857,7 +965,15 @@ std::string CarlaRecorderQuery::QueryBlocked(std::string Filename, double MinTim
 
       // frame end
       case static_cast<char>(CarlaRecorderPacketId::FrameEnd):
-        // do nothing, it is empty
+        // actors without a position this frame were suppressed by the
+        // recorder dead-band, i.e. they didn't move
+        for (auto &Last : LastPositions)
+        {
+          if (SeenThisFrame.find(Last.first) == SeenThisFrame.end())
+          {
+            CheckStopped(Last.first, Last.second.Location);
+          }
+        }
         break;
 
       default:
@@ -7,7 +7,10 @@
 #pragma once
 
 #include <fstream>
+#include <limits>
+#include <vector>
 
+#include "CarlaRecorderMappedFile.h"
 #include "CarlaRecorderTraficLightTime.h"
 #include "CarlaRecorderPhysicsControl.h"
 #include "CarlaRecorderPlatformTime.h"
@@ -55,6 +58,7 @@ private:
   CarlaRecorderEventDel EventDel;
   CarlaRecorderEventParent EventParent;
   CarlaRecorderPosition Position;
+  CarlaRecorderPositionDelta PositionDelta;
   CarlaRecorderCollision Collision;
   CarlaRecorderStateTrafficLight StateTraffic;
   CarlaRecorderAnimVehicle Vehicle;
@@ -67,12 +71,40 @@ private:
   CarlaRecorderPhysicsControl PhysicsControl;
   CarlaRecorderTrafficLightTime TrafficLightTime;
 
+  // filters pushed down to the packet directory scan, so unwanted
+  // packets are hopped over without parsing
+  struct PacketFilter
+  {
+    std::vector<char> PacketIds;  // empty means every packet
+    double MinTime = 0.0;
+    double MaxTime = std::numeric_limits<double>::max();
+    uint32_t DatabaseId = 0;      // 0 means any actor
+  };
+
+  // location of a packet inside the mapped file
+  struct PacketSpan
+  {
+    char Id;
+    uint32_t Size;
+    uint64_t Offset;    // offset of the payload
+    uint64_t FrameId;   // frame the packet belongs to
+    double FrameTime;   // elapsed time of that frame
+  };
+
+  // memory-mapped view of the file, used by the scanning queries
+  CarlaRecorderMappedFile Mapped;
+  std::vector<PacketSpan> Directory;
+
   // read next header packet
   bool ReadHeader(void);
 
   // skip current packet
   void SkipPacket(void);
 
+  // single pass over the packet headers filling Directory with the
+  // packets matching the filter; leaves the last frame read in Frame
+  void BuildPacketDirectory(std::istream &InFile, const PacketFilter &Filter);
+
   // read the start info structure and check the magic string
-  bool CheckFileInfo(std::stringstream &Info);
+  bool CheckFileInfo(std::stringstream &Info, std::istream &InFile);
 };
@@ -7,6 +7,7 @@
 #include "CarlaReplayer.h"
 #include "CarlaRecorder.h"
 
+#include <algorithm>
 #include <ctime>
 #include <sstream>
 
@@ -65,14 +66,54 @@ void CarlaReplayer::Rewind(void)
 
   MappedId.clear();
   IsHeroMap.clear();
+  LastPositions.clear();
 
   // read geneal Info
   RecInfo.Read(File);
 }
 
+void CarlaReplayer::TryLoadFrameIndex(void)
+{
+  FrameIndex.Clear();
+
+  const std::streampos Current = File.tellg();
+
+  // the footer ends with the offset of the index packet plus a magic tag
+  File.seekg(0, std::ios::end);
+  const auto End = static_cast<uint64_t>(File.tellg());
+  constexpr uint64_t TrailerSize = sizeof(uint64_t) + sizeof(FrameIndexMagic);
+  if (End >= TrailerSize)
+  {
+    File.seekg(End - TrailerSize, std::ios::beg);
+    uint64_t Offset = 0u;
+    ReadValue<uint64_t>(File, Offset);
+    char Magic[sizeof(FrameIndexMagic)];
+    File.read(Magic, sizeof(Magic));
+    if (File &&
+        std::equal(std::begin(Magic), std::end(Magic), std::begin(FrameIndexMagic)) &&
+        (Offset < End))
+    {
+      File.seekg(Offset, std::ios::beg);
+      if (ReadHeader() && (Header.Id == static_cast<char>(CarlaRecorderPacketId::FrameIndex)))
+      {
+        FrameIndex.Read(File);
+      }
+    }
+  }
+
+  File.clear();
+  File.seekg(Current, std::ios::beg);
+}
+
 // read last frame in File and return the Total time recorded
 double CarlaReplayer::GetTotalTime(void)
 {
+  // on indexed recordings the total time comes in the footer
+  if (FrameIndex.IsValid())
+  {
+    return FrameIndex.GetTotalTime();
+  }
+
   std::streampos Current = File.tellg();
 
   // parse only frames
@@ -112,8 +153,8 @@ std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, do
     Stop();
   }
 
-  // get the final path + filename
-  std::string Filename2 = GetRecorderFilename(Filename);
+  // get the final path + filename, inflating compressed recordings
+  std::string Filename2 = CheckAndInflateRecorderFile(GetRecorderFilename(Filename));
 
   Info << "Replaying File: " << Filename2 << std::endl;
 
@@ -129,6 +170,9 @@ std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, do
   // from start
   Rewind();
 
+  // load the frame index footer (empty on old recordings)
+  TryLoadFrameIndex();
+
   // check to load map if different
   if (Episode->GetMapName() != RecInfo.Mapfile)
   {
@@ -188,6 +232,47 @@ std::string CarlaReplayer::ReplayFile(std::string Filename, double TimeStart, do
   return Info.str();
 }
 
+std::string CarlaReplayer::ReplayBatch(std::vector<std::string> Filenames, double NewTimeFactor)
+{
+  std::stringstream Info;
+
+  // cancel any previous batch
+  ClearBatch();
+
+  if (Filenames.empty())
+  {
+    Info << "Batch replay: no files given" << std::endl;
+    return Info.str();
+  }
+
+  BatchFiles = std::move(Filenames);
+  NextBatchIndex = 0;
+  TimeFactor = NewTimeFactor;
+
+  Info << "Batch replay of " << BatchFiles.size() << " files" << std::endl;
+
+  // start the first one, the rest chain when each replay reaches its end
+  Info << ReplayFile(BatchFiles[NextBatchIndex++]);
+
+  return Info.str();
+}
+
+void CarlaReplayer::ClearBatch(void)
+{
+  BatchFiles.clear();
+  NextBatchIndex = 0;
+}
+
+void CarlaReplayer::PlayNextInBatch(void)
+{
+  if (NextBatchIndex >= BatchFiles.size())
+  {
+    ClearBatch();
+    return;
+  }
+  ReplayFile(BatchFiles[NextBatchIndex++]);
+}
+
 void CarlaReplayer::CheckPlayAfterMapLoaded(void)
 {
 
@@ -214,6 +299,9 @@ void CarlaReplayer::CheckPlayAfterMapLoaded(void)
   // from start
   Rewind();
 
+  // load the frame index footer (empty on old recordings)
+  TryLoadFrameIndex();
+
   // get Total time of recorder
   TotalTime = GetTotalTime();
 
@@ -263,6 +351,23 @@ void CarlaReplayer::ProcessToTime(double Time, bool IsFirstTime)
     bExitLoop = true;
   }
 
+  // on a fresh start, use the recording's frame index (if any) to jump
+  // close to the target instead of scanning from the beginning
+  if (IsFirstTime && !bExitLoop)
+  {
+    const auto *Keyframe = FrameIndex.FindKeyframe(NewTime);
+    if (Keyframe != nullptr)
+    {
+      // respawn the actors alive at the keyframe from its event snapshot
+      File.clear();
+      File.seekg(Keyframe->BlobOffset, std::ios::beg);
+      ProcessEventsAdd();
+      ProcessEventsParent();
+      // continue with the regular packet scan from the keyframe's frame
+      File.seekg(Keyframe->FrameOffset, std::ios::beg);
+    }
+  }
+
   // process all frames until time we want or end
   while (!File.eof() && !bExitLoop)
   {
@@ -306,10 +411,12 @@ void CarlaReplayer::ProcessToTime(double Time, bool IsFirstTime)
 
       // positions
       case static_cast<char>(CarlaRecorderPacketId::Position):
-        if (bFrameFound)
-          ProcessPositions(IsFirstTime);
-        else
-          SkipPacket();
+        ProcessPositions(bFrameFound, IsFirstTime);
+        break;
+
+      // delta positions
+      case static_cast<char>(CarlaRecorderPacketId::PositionDelta):
+        ProcessPositionsDelta(bFrameFound);
         break;
 
       // states
@@ -381,6 +488,8 @@ void CarlaReplayer::ProcessToTime(double Time, bool IsFirstTime)
   {
     // keep actors in scene and let them continue with autopilot
     Stop(true);
+    // chain the next recording of the batch, if any
+    PlayNextInBatch();
   }
 }
 
@@ -567,21 +676,28 @@ void CarlaReplayer::ProcessLightScene(void)
   }
 }
 
-void CarlaReplayer::ProcessPositions(bool IsFirstTime)
+void CarlaReplayer::ProcessPositions(bool bApply, bool IsFirstTime)
 {
   uint16_t i, Total;
 
-  // save current as previous
-  PrevPos = std::move(CurrPos);
+  if (bApply)
+  {
+    // save current as previous
+    PrevPos = std::move(CurrPos);
+    CurrPos.clear();
+  }
 
   // read all positions
   ReadValue<uint16_t>(File, Total);
-  CurrPos.clear();
   CurrPos.reserve(Total);
   for (i = 0; i < Total; ++i)
   {
     CarlaRecorderPosition Pos;
     Pos.Read(File);
+    // keep the raw position, delta records are expanded against it
+    LastPositions[Pos.DatabaseId] = Pos;
+    if (!bApply)
+      continue;
     // assign mapped Id
     auto NewId = MappedId.find(Pos.DatabaseId);
     if (NewId != MappedId.end())
@@ -594,12 +710,45 @@ void CarlaReplayer::ProcessPositions(bool IsFirstTime)
   }
 
   // check to copy positions the first time
-  if (IsFirstTime)
+  if (bApply && IsFirstTime)
   {
     PrevPos.clear();
   }
 }
 
+void CarlaReplayer::ProcessPositionsDelta(bool bApply)
+{
+  uint16_t i, Total;
+  CarlaRecorderPositionDelta Delta;
+
+  // read all delta positions
+  ReadValue<uint16_t>(File, Total);
+  for (i = 0; i < Total; ++i)
+  {
+    Delta.Read(File);
+    // expand against the last known position of the actor
+    auto Last = LastPositions.find(Delta.DatabaseId);
+    if (Last == LastPositions.end())
+    {
+      // no base yet (e.g. right after a jump), wait for a full record
+      continue;
+    }
+    CarlaRecorderPosition Pos = Delta.Expand(Last->second);
+    Last->second = Pos;
+    if (!bApply)
+      continue;
+    // assign mapped Id
+    auto NewId = MappedId.find(Pos.DatabaseId);
+    if (NewId != MappedId.end())
+    {
+      Pos.DatabaseId = NewId->second;
+    }
+    else
+      UE_LOG(LogCarla, Log, TEXT("Actor not found when trying to move from replayer (id. %d)"), Pos.DatabaseId);
+    CurrPos.push_back(std::move(Pos));
+  }
+}
+
 void CarlaReplayer::UpdatePositions(double Per, double DeltaTime)
 {
   unsigned int i;
@@ -17,6 +17,7 @@
 #include "CarlaRecorderEventDel.h"
 #include "CarlaRecorderEventParent.h"
 #include "CarlaRecorderCollision.h"
+#include "CarlaRecorderFrameIndex.h"
 #include "CarlaRecorderPosition.h"
 #include "CarlaRecorderState.h"
 #include "CarlaRecorderHelpers.h"
@@ -53,6 +54,13 @@ public:
 
   std::string ReplayFile(std::string Filename, double TimeStart = 0.0f, double Duration = 0.0f, uint32_t FollowId = 0);
 
+  // replay a set of recordings back to back, meant for offline sensor
+  // re-rendering (replayed actors have physics disabled already)
+  std::string ReplayBatch(std::vector<std::string> Filenames, double NewTimeFactor = 1.0);
+
+  // cancel the recordings still pending of a batch replay
+  void ClearBatch(void);
+
   // void Start(void);
   void Stop(bool KeepActors = false);
 
@@ -102,6 +110,9 @@ private:
   // positions (to be able to interpolate)
   std::vector<CarlaRecorderPosition> CurrPos;
   std::vector<CarlaRecorderPosition> PrevPos;
+  // last known position of each actor (recorded ids), the base to expand
+  // delta records against
+  std::unordered_map<uint32_t, CarlaRecorderPosition> LastPositions;
   // mapping id
   std::unordered_map<uint32_t, uint32_t> MappedId;
   // times
@@ -118,11 +129,24 @@ private:
   bool IgnoreHero { false };
   std::unordered_map<uint32_t, bool> IsHeroMap;
 
+  // recordings pending of a batch replay
+  std::vector<std::string> BatchFiles;
+  size_t NextBatchIndex { 0 };
+
+  // frame index footer of the recording, empty on old files
+  CarlaRecorderFrameIndex FrameIndex;
+
   // utils
   bool ReadHeader();
 
   void SkipPacket();
 
+  // load the frame index footer, if the recording has one
+  void TryLoadFrameIndex(void);
+
+  // start the next recording of the batch, if any
+  void PlayNextInBatch(void);
+
   double GetTotalTime(void);
 
   void Rewind(void);
@@ -134,7 +158,10 @@ private:
   void ProcessEventsDel(void);
   void ProcessEventsParent(void);
 
-  void ProcessPositions(bool IsFirstTime = false);
+  // positions are parsed even when scanning to keep the delta base up to
+  // date, but only applied (bApply) on the target frame
+  void ProcessPositions(bool bApply, bool IsFirstTime = false);
+  void ProcessPositionsDelta(bool bApply);
 
   void ProcessStates(void);
 
@@ -0,0 +1,64 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Components/PrimitiveComponent.h"
+#include "Containers/Map.h"
+#include "GameFramework/Actor.h"
+
+/// Physics state of an actor's root component, sampled once per frame.
+struct FActorKinematics
+{
+  FQuat Rotation = FQuat::Identity;
+
+  FVector AngularVelocityInRadians = FVector::ZeroVector;
+
+  FVector LinearVelocity = FVector::ZeroVector;
+};
+
+/// Per-frame cache of the physics-state reads shared by the proprioceptive
+/// sensors: every IMU attached to the same vehicle needs the same angular
+/// velocity and body rotation, so the physics body is queried once per
+/// actor per frame and the sample is reused.
+///
+/// The cache is reset when the frame counter advances, so a sample is
+/// never served across frames. Sensors consuming it tick in the
+/// post-physics group, where the state is stable within the frame.
+///
+/// @warning Not thread-safe; sensor ticks run on the game thread.
+class FActorKinematicsCache
+{
+public:
+
+  const FActorKinematics &Get(const AActor &Actor)
+  {
+    if (Frame != GFrameCounter)
+    {
+      Frame = GFrameCounter;
+      Samples.Reset();
+    }
+    if (const FActorKinematics *Found = Samples.Find(&Actor))
+    {
+      return *Found;
+    }
+    FActorKinematics Sample;
+    const auto *RootComponent = Cast<UPrimitiveComponent>(Actor.GetRootComponent());
+    if (RootComponent != nullptr)
+    {
+      Sample.Rotation = RootComponent->GetComponentTransform().GetRotation();
+      Sample.AngularVelocityInRadians = RootComponent->GetPhysicsAngularVelocityInRadians();
+      Sample.LinearVelocity = RootComponent->GetPhysicsLinearVelocity();
+    }
+    return Samples.Add(&Actor, Sample);
+  }
+
+private:
+
+  uint64 Frame = ~0ull;
+
+  TMap<const AActor *, FActorKinematics> Samples;
+};
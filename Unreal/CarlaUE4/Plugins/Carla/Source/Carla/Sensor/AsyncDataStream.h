@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "Async/TaskGraphInterfaces.h"
+
 #include <compiler/disable-ue4-macros.h>
 #include <carla/Buffer.h>
 #include <carla/sensor/SensorRegistry.h>
@@ -13,6 +15,9 @@
 #include <carla/streaming/Stream.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include <tuple>
+#include <utility>
+
 template <typename T>
 class FDataStreamTmpl;
 
@@ -57,6 +62,15 @@ public:
   template <typename SensorT, typename... ArgsT>
   void Send(SensorT &Sensor, ArgsT &&... Args);
 
+  /// Same as Send, but the serializer runs on a background task so the
+  /// calling thread only hands off the data. Deferred sends of the same
+  /// sensor are chained, so messages keep their order on the stream.
+  ///
+  /// @warning The sensor must outlive the task; arguments are moved (or
+  /// copied, when lvalues) into it.
+  template <typename SensorT, typename... ArgsT>
+  void SendDeferred(SensorT &Sensor, ArgsT &&... Args);
+
 private:
 
   friend class FDataStreamTmpl<T>;
@@ -66,11 +80,52 @@ private:
   explicit FAsyncDataStreamTmpl(
       const SensorT &InSensor,
       double Timestamp,
-      StreamType InStream);
+      StreamType InStream,
+      TSharedPtr<FGraphEventRef, ESPMode::ThreadSafe> InSendOrder);
+
+  /// Record serialization and transmission times on stream owners that
+  /// expose the ASensor timing accumulators; no-op for the rest (e.g. the
+  /// world observer).
+  template <typename SensorT>
+  static auto RecordTiming(SensorT &Sensor, double SerializationSec, double TransmissionSec, int)
+    -> decltype(Sensor.RecordSerializationTime(0.0), void())
+  {
+    Sensor.RecordSerializationTime(SerializationSec);
+    Sensor.RecordTransmissionTime(TransmissionSec);
+  }
+
+  template <typename SensorT>
+  static void RecordTiming(SensorT &, double, double, long) {}
+
+  template <typename SensorT, typename TupleT, std::size_t... Is>
+  static void WriteFromTuple(
+      SensorT &Sensor,
+      StreamType Stream,
+      carla::Buffer Header,
+      TupleT &Data,
+      std::index_sequence<Is...>)
+  {
+    using HeaderSerializer = carla::sensor::s11n::SensorHeaderSerializer;
+    const double SerializationStart = FPlatformTime::Seconds();
+    HeaderSerializer::StampSerialize(Header);
+    auto Message =
+        carla::sensor::SensorRegistry::Serialize(Sensor, std::move(std::get<Is>(Data))...);
+    const double TransmissionStart = FPlatformTime::Seconds();
+    HeaderSerializer::StampSend(Header);
+    Stream.Write(std::move(Header), std::move(Message));
+    RecordTiming(
+        Sensor,
+        TransmissionStart - SerializationStart,
+        FPlatformTime::Seconds() - TransmissionStart,
+        0);
+  }
 
   StreamType Stream;
 
   carla::Buffer Header;
+
+  /// Completion event of the last deferred send of this sensor.
+  TSharedPtr<FGraphEventRef, ESPMode::ThreadSafe> SendOrder;
 };
 
 // =============================================================================
@@ -89,9 +144,52 @@ template <typename T>
 template <typename SensorT, typename... ArgsT>
 inline void FAsyncDataStreamTmpl<T>::Send(SensorT &Sensor, ArgsT &&... Args)
 {
-  Stream.Write(
-      std::move(Header),
-      carla::sensor::SensorRegistry::Serialize(Sensor, std::forward<ArgsT>(Args)...));
+  using HeaderSerializer = carla::sensor::s11n::SensorHeaderSerializer;
+  const double SerializationStart = FPlatformTime::Seconds();
+  HeaderSerializer::StampSerialize(Header);
+  auto Message =
+      carla::sensor::SensorRegistry::Serialize(Sensor, std::forward<ArgsT>(Args)...);
+  const double TransmissionStart = FPlatformTime::Seconds();
+  HeaderSerializer::StampSend(Header);
+  Stream.Write(std::move(Header), std::move(Message));
+  RecordTiming(
+      Sensor,
+      TransmissionStart - SerializationStart,
+      FPlatformTime::Seconds() - TransmissionStart,
+      0);
+}
+
+template <typename T>
+template <typename SensorT, typename... ArgsT>
+inline void FAsyncDataStreamTmpl<T>::SendDeferred(SensorT &Sensor, ArgsT &&... Args)
+{
+  FGraphEventArray Prerequisites;
+  if (SendOrder.IsValid() && (*SendOrder).IsValid())
+  {
+    Prerequisites.Add(*SendOrder);
+  }
+
+  FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady(
+      [&Sensor,
+       Stream=std::move(Stream),
+       Header=std::move(Header),
+       Data=std::make_tuple(std::forward<ArgsT>(Args)...)]() mutable
+      {
+        WriteFromTuple(
+            Sensor,
+            std::move(Stream),
+            std::move(Header),
+            Data,
+            std::make_index_sequence<sizeof...(ArgsT)>());
+      },
+      TStatId(),
+      (Prerequisites.Num() > 0 ? &Prerequisites : nullptr),
+      ENamedThreads::AnyBackgroundThreadNormalTask);
+
+  if (SendOrder.IsValid())
+  {
+    *SendOrder = Task;
+  }
 }
 
 template <typename T>
@@ -99,7 +197,8 @@ template <typename SensorT>
 inline FAsyncDataStreamTmpl<T>::FAsyncDataStreamTmpl(
     const SensorT &Sensor,
     double Timestamp,
-    StreamType InStream)
+    StreamType InStream,
+    TSharedPtr<FGraphEventRef, ESPMode::ThreadSafe> InSendOrder)
   : Stream(std::move(InStream)),
     Header([&Sensor, Timestamp]() {
       //check(IsInGameThread());
@@ -109,4 +208,5 @@ inline FAsyncDataStreamTmpl<T>::FAsyncDataStreamTmpl(
           GFrameCounter,
           Timestamp,
           Sensor.GetActorTransform());
-    }()) {}
+    }()),
+    SendOrder(std::move(InSendOrder)) {}
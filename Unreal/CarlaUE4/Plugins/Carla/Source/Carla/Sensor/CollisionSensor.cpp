@@ -16,14 +16,37 @@
 ACollisionSensor::ACollisionSensor(const FObjectInitializer& ObjectInitializer)
   : Super(ObjectInitializer)
 {
-  PrimaryActorTick.bCanEverTick = false;
+  // Ticking only happens while debounce windows are open.
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 FActorDefinition ACollisionSensor::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeGenericSensorDefinition(
+  auto Definition = UActorBlueprintFunctionLibrary::MakeGenericSensorDefinition(
       TEXT("other"),
       TEXT("collision"));
+
+  FActorVariation DebounceWindowVariation;
+  DebounceWindowVariation.Id = TEXT("debounce_window");
+  DebounceWindowVariation.Type = EActorAttributeType::Float;
+  DebounceWindowVariation.RecommendedValues = { TEXT("0.0") };
+  DebounceWindowVariation.bRestrictToRecommended = false;
+  Definition.Variations.Emplace(DebounceWindowVariation);
+
+  return Definition;
+}
+
+void ACollisionSensor::Set(const FActorDescription &ActorDescription)
+{
+  Super::Set(ActorDescription);
+  if (ActorDescription.Variations.Contains("debounce_window"))
+  {
+    DebounceWindow = UActorBlueprintFunctionLibrary::ActorAttributeToFloat(
+        ActorDescription.Variations["debounce_window"],
+        0.0f);
+  }
+  SetActorTickEnabled(DebounceWindow > 0.0f);
 }
 
 void ACollisionSensor::SetOwner(AActor *NewOwner)
@@ -44,18 +67,67 @@ void ACollisionSensor::OnCollisionEvent(
     FVector NormalImpulse,
     const FHitResult &Hit)
 {
-  if ((Actor != nullptr) && (OtherActor != nullptr))
+  if ((Actor == nullptr) || (OtherActor == nullptr))
+  {
+    return;
+  }
+  constexpr float TO_METERS = 1e-2;
+  const FVector Impulse = NormalImpulse * TO_METERS;
+
+  if (DebounceWindow <= 0.0f)
+  {
+    SendCollisionEvent(Actor, OtherActor, Impulse);
+    return;
+  }
+
+  // The first contact of a pair goes out immediately, so the client does
+  // not wait a window to react; the contacts that follow are merged and
+  // flushed by Tick with their impulses accumulated.
+  FPendingCollision *Pending = PendingCollisions.Find(OtherActor);
+  if (Pending == nullptr)
+  {
+    SendCollisionEvent(Actor, OtherActor, Impulse);
+    PendingCollisions.Add(OtherActor, FPendingCollision());
+  }
+  else
+  {
+    Pending->AccumulatedImpulse += Impulse;
+    ++Pending->EventCount;
+  }
+}
+
+void ACollisionSensor::SendCollisionEvent(
+    AActor *Actor,
+    AActor *OtherActor,
+    const FVector &NormalImpulse)
+{
+  const auto &Episode = GetEpisode();
+  GetDataStream(*this).Send(
+      *this,
+      Episode.SerializeActor(Episode.FindOrFakeActor(Actor)),
+      Episode.SerializeActor(Episode.FindOrFakeActor(OtherActor)),
+      carla::geom::Vector3D{NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z});
+  // record the collision event
+  if (Episode.GetRecorder()->IsEnabled())
+    Episode.GetRecorder()->AddCollision(Actor, OtherActor);
+}
+
+void ACollisionSensor::Tick(float DeltaSeconds)
+{
+  Super::Tick(DeltaSeconds);
+
+  for (auto It = PendingCollisions.CreateIterator(); It; ++It)
   {
-    const auto &Episode = GetEpisode();
-    constexpr float TO_METERS = 1e-2;
-    NormalImpulse *= TO_METERS;
-    GetDataStream(*this).Send(
-        *this,
-        Episode.SerializeActor(Episode.FindOrFakeActor(Actor)),
-        Episode.SerializeActor(Episode.FindOrFakeActor(OtherActor)),
-        carla::geom::Vector3D{NormalImpulse.X, NormalImpulse.Y, NormalImpulse.Z});
-    // record the collision event
-    if (Episode.GetRecorder()->IsEnabled())
-      Episode.GetRecorder()->AddCollision(Actor, OtherActor);
+    It->Value.ElapsedTime += DeltaSeconds;
+    if (It->Value.ElapsedTime < DebounceWindow)
+    {
+      continue;
+    }
+    AActor *OtherActor = It->Key.Get();
+    if ((OtherActor != nullptr) && (It->Value.EventCount > 0u))
+    {
+      SendCollisionEvent(GetOwner(), OtherActor, It->Value.AccumulatedImpulse);
+    }
+    It.RemoveCurrent();
   }
 }
@@ -15,6 +15,12 @@ class UCarlaEpisode;
 class UCarlaGameInstance;
 
 /// A sensor to register collisions.
+///
+/// With the debounce_window attribute set, sustained contact against the
+/// same actor (scraping a guardrail, grinding a wall) is merged into one
+/// event per window with the impulses accumulated, instead of one event
+/// per delegate fire; the first contact of a pair is always sent
+/// immediately.
 UCLASS()
 class CARLA_API ACollisionSensor : public ASensor
 {
@@ -26,8 +32,12 @@ public:
 
   ACollisionSensor(const FObjectInitializer& ObjectInitializer);
 
+  void Set(const FActorDescription &ActorDescription) override;
+
   void SetOwner(AActor *NewOwner) override;
 
+  virtual void Tick(float DeltaSeconds) override;
+
 private:
 
   UFUNCTION()
@@ -36,4 +46,24 @@ private:
       AActor *OtherActor,
       FVector NormalImpulse,
       const FHitResult &Hit);
+
+  /// Serialize one collision event down the stream and into the recorder.
+  /// @a NormalImpulse is expected in meters.
+  void SendCollisionEvent(AActor *Actor, AActor *OtherActor, const FVector &NormalImpulse);
+
+  /// Collision events against one actor merged during the current window.
+  struct FPendingCollision
+  {
+    FVector AccumulatedImpulse = FVector::ZeroVector;
+    uint32 EventCount = 0u;
+    float ElapsedTime = 0.0f;
+  };
+
+  /// Seconds over which repeated contacts against the same actor are
+  /// merged; zero keeps the one-event-per-contact behavior.
+  float DebounceWindow = 0.0f;
+
+  /// Open debounce windows, keyed by the other actor of the pair; flushed
+  /// by Tick when their window elapses.
+  TMap<TWeakObjectPtr<AActor>, FPendingCollision> PendingCollisions;
 };
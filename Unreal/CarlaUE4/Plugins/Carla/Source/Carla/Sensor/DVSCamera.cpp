@@ -8,11 +8,14 @@
 #include <random>
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 #include "Carla.h"
 #include "Carla/Util/RandomEngine.h"
 #include "Carla/Sensor/DVSCamera.h"
 
+#include "Async/ParallelFor.h"
+
 ADVSCamera::ADVSCamera(const FObjectInitializer &ObjectInitializer)
   : Super(ObjectInitializer)
 {
@@ -70,7 +73,13 @@ FActorDefinition ADVSCamera::GetSensorDefinition()
   Log_EPS.RecommendedValues = { TEXT("0.001") };
   Log_EPS.bRestrictToRecommended = false;
 
-  Definition.Variations.Append({ Cp, Cm, Sigma_Cp, Sigma_Cm, Refractory_Period, Use_Log, Log_EPS });
+  FActorVariation Max_Events;
+  Max_Events.Id = TEXT("max_events");
+  Max_Events.Type = EActorAttributeType::Int;
+  Max_Events.RecommendedValues = { TEXT("0") };
+  Max_Events.bRestrictToRecommended = false;
+
+  Definition.Variations.Append({ Cp, Cm, Sigma_Cp, Sigma_Cm, Refractory_Period, Use_Log, Log_EPS, Max_Events });
 
   return Definition;
 }
@@ -113,6 +122,11 @@ void ADVSCamera::Set(const FActorDescription &Description)
       "log_eps",
       Description.Variations,
       1e-03);
+
+  this->config.max_events = static_cast<std::uint32_t>(UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "max_events",
+      Description.Variations,
+      0));
 }
 
 void ADVSCamera::Tick(float DeltaTime)
@@ -139,10 +153,10 @@ void ADVSCamera::Tick(float DeltaTime)
 
   if (events.size() > 0)
   {
-    /** Send the events **/
+    /** Send the events; sorting and packing run on a background task **/
     auto Stream = GetDataStream(*this);
     auto Buffer = Stream.PopBufferFromPool();
-    Stream.Send(*this, events, std::move(Buffer));
+    Stream.SendDeferred(*this, std::move(events), std::move(Buffer));
   }
 }
 
@@ -209,12 +223,32 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
   const std::uint64_t delta_t_ns = dvs::secToNanosec(
       this->GetEpisode().GetElapsedGameTime()) - this->current_time;
 
-  /** Loop along the image size **/
-  for (uint32 y = 0; y < this->GetImageHeight(); ++y)
+  const uint32 width = this->GetImageWidth();
+  const uint32 height = this->GetImageHeight();
+
+  /** Rows per parallel tile; each pixel only touches its own per-pixel
+      state so row tiles are independent **/
+  constexpr uint32 rows_per_tile = 16u;
+  const uint32 num_tiles = (height + rows_per_tile - 1u) / rows_per_tile;
+
+  std::vector<DVSEventArray> tile_events(num_tiles);
+
+  /** Loop along the image size, one tile of rows per task **/
+  ParallelFor(num_tiles, [&](int32 tile)
   {
-    for (uint32 x = 0; x < this->GetImageWidth(); ++x)
+    const uint32 row_begin = tile * rows_per_tile;
+    const uint32 row_end = std::min(row_begin + rows_per_tile, height);
+    DVSEventArray &local_events = tile_events[tile];
+
+    /** Per-tile noise generator, URandomEngine is not thread-safe **/
+    std::mt19937 rng(static_cast<std::uint32_t>(this->current_time) + tile);
+    std::normal_distribution<float> noise;
+
+    for (uint32 y = row_begin; y < row_end; ++y)
     {
-      const uint32 i = (this->GetImageWidth() * y) + x;
+    for (uint32 x = 0; x < width; ++x)
+    {
+      const uint32 i = (width * y) + x;
       const float itdt = this->last_image[i];
       const float it = this->prev_image[i];
       const float prev_cross = this->ref_values[i];
@@ -227,7 +261,7 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
 
         if(sigma_C > 0)
         {
-          C += RandomEngine->GetNormalDistribution(0, sigma_C);
+          C += sigma_C * noise(rng);
           constexpr float minimum_contrast_threshold = 0.01;
           C = std::max(minimum_contrast_threshold, C);
         }
@@ -252,7 +286,7 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
               const std::uint64_t dt = t - last_stamp_at_xy;
               if(this->last_event_timestamp[i] == 0 || dt >= this->config.refractory_period_ns)
               {
-                events.push_back(::carla::sensor::data::DVSEvent(x, y, t, pol > 0));
+                local_events.push_back(::carla::sensor::data::DVSEvent(x, y, t, pol > 0));
                 this->last_event_timestamp[i] = dvs::nanosecToSecTrunc(t);
               }
               else
@@ -269,6 +303,52 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
         } while (!all_crossings);
       } // end tolerance
     } // end for each pixel
+    } // end for each row of the tile
+  });
+
+  std::size_t total_events = 0u;
+  for (const auto &tile : tile_events)
+  {
+    total_events += tile.size();
+  }
+
+  if ((this->config.max_events > 0u) && (total_events > this->config.max_events))
+  {
+    /** Over budget: reservoir-sample a uniform subset of the events, so
+        event storms keep a hard bound on sort, serialization and network
+        cost while the survivors stay representative of the whole frame **/
+    events.reserve(this->config.max_events);
+    std::mt19937 rng(static_cast<std::uint32_t>(this->current_time));
+    std::size_t seen = 0u;
+    for (const auto &tile : tile_events)
+    {
+      for (const auto &event : tile)
+      {
+        if (events.size() < this->config.max_events)
+        {
+          events.push_back(event);
+        }
+        else
+        {
+          std::uniform_int_distribution<std::size_t> pick(0u, seen);
+          const auto slot = pick(rng);
+          if (slot < this->config.max_events)
+          {
+            events[slot] = event;
+          }
+        }
+        ++seen;
+      }
+    }
+  }
+  else
+  {
+    /** Merge the tiles **/
+    events.reserve(total_events);
+    for (const auto &tile : tile_events)
+    {
+      events.insert(events.end(), tile.begin(), tile.end());
+    }
   }
 
   /** Update current time **/
@@ -276,9 +356,7 @@ ADVSCamera::DVSEventArray ADVSCamera::simulation (float DeltaTime)
 
   this->prev_image = this->last_image;
 
-  // Sort the events by increasing timestamps, since this is what
-  // most event processing algorithms expect
-  std::sort(events.begin(), events.end(), [](const ::carla::sensor::data::DVSEvent& it1, const ::carla::sensor::data::DVSEvent& it2){return it1.t < it2.t;});
-
+  // The events are sorted by increasing timestamp by the serializer, off
+  // the game thread
   return events;
 }
@@ -23,6 +23,8 @@ namespace dvs
     std::uint64_t refractory_period_ns;
     bool use_log;
     float log_eps;
+    /// Hard per-frame event budget, 0 means unlimited
+    std::uint32_t max_events;
   };
 
   inline constexpr std::int64_t secToNanosec(double seconds)
@@ -40,7 +40,7 @@ public:
   auto MakeAsyncDataStream(const SensorT &Sensor, double Timestamp)
   {
     check(Stream.has_value());
-    return FAsyncDataStreamTmpl<T>{Sensor, Timestamp, *Stream};
+    return FAsyncDataStreamTmpl<T>{Sensor, Timestamp, *Stream, SendOrder};
   }
 
   /// Return the token that allows subscribing to this stream.
@@ -50,9 +50,26 @@ public:
     return (*Stream).token();
   }
 
+  /// Register a listener that receives every message sent down this stream,
+  /// sharing the buffers with the network transport. Pass nullptr to remove
+  /// it.
+  ///
+  /// @warning The listener runs on whatever thread sends the message.
+  void SetMessageListener(
+      std::shared_ptr<const carla::streaming::detail::MultiStreamState::ListenerCallback> Listener)
+  {
+    check(Stream.has_value());
+    (*Stream).SetMessageListener(std::move(Listener));
+  }
+
 private:
 
   boost::optional<StreamType> Stream;
+
+  /// Completion event of the last deferred send of this sensor; deferred
+  /// serializations chain on it so messages keep their order.
+  TSharedPtr<FGraphEventRef, ESPMode::ThreadSafe> SendOrder =
+      MakeShared<FGraphEventRef, ESPMode::ThreadSafe>();
 };
 
 // =============================================================================
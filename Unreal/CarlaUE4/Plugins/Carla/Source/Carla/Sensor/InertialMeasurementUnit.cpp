@@ -50,25 +50,6 @@ void AInertialMeasurementUnit::SetOwner(AActor *Owner)
   Super::SetOwner(Owner);
 }
 
-// Returns the angular velocity of Actor, expressed in the frame of Actor
-static FVector FIMU_GetActorAngularVelocityInRadians(
-    AActor &Actor)
-{
-  const auto RootComponent = Cast<UPrimitiveComponent>(Actor.GetRootComponent());
-
-  FVector AngularVelocity;
-
-  if (RootComponent != nullptr) {
-      const FQuat ActorGlobalRotation = RootComponent->GetComponentTransform().GetRotation();
-      const FVector GlobalAngularVelocity = RootComponent->GetPhysicsAngularVelocityInRadians();
-      AngularVelocity = ActorGlobalRotation.UnrotateVector(GlobalAngularVelocity);
-  } else {
-      AngularVelocity = FVector::ZeroVector;
-  }
-
-  return AngularVelocity;
-}
-
 const carla::geom::Vector3D AInertialMeasurementUnit::ComputeAccelerometerNoise(
     const FVector &Accelerometer)
 {
@@ -145,8 +126,13 @@ carla::geom::Vector3D AInertialMeasurementUnit::ComputeAccelerometer(
 
 carla::geom::Vector3D AInertialMeasurementUnit::ComputeGyroscope()
 {
+  // The owner's physics body is sampled once per frame through the
+  // episode cache; every proprioceptive sensor attached to the same
+  // vehicle reuses the sample instead of querying the body again.
+  const FActorKinematics &Kinematics =
+      GetEpisode().GetActorKinematicsCache().Get(*GetOwner());
   const FVector AngularVelocity =
-      FIMU_GetActorAngularVelocityInRadians(*GetOwner());
+      Kinematics.Rotation.UnrotateVector(Kinematics.AngularVelocityInRadians);
 
   const FQuat SensorLocalRotation =
       RootComponent->GetRelativeTransform().GetRotation();
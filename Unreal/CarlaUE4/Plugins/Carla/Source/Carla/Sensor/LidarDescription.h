@@ -59,6 +59,11 @@ struct CARLA_API FLidarDescription
   UPROPERTY(EditAnywhere)
   bool ShowDebugPoints = false;
 
+  /// Transport points as 16-bit fixed point (centimeter resolution) instead
+  /// of floats, halving the stream bandwidth.
+  UPROPERTY(EditAnywhere)
+  bool QuantizedTransport = false;
+
   UPROPERTY(EditAnywhere)
   float NoiseStdDev = 0.0f;
 };
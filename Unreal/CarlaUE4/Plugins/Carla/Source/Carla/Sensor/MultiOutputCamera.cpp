@@ -0,0 +1,236 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Sensor/MultiOutputCamera.h"
+
+#include "Carla/Sensor/PixelReader.h"
+
+#include "Async/Async.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "ConstructorHelpers.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "RHIGPUReadback.h"
+
+#include <thread>
+
+FActorDefinition AMultiOutputCamera::GetSensorDefinition()
+{
+  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("multi_output"));
+}
+
+AMultiOutputCamera::AMultiOutputCamera(const FObjectInitializer &ObjectInitializer)
+  : Super(ObjectInitializer)
+{
+  // Lens distortion applies to the color output only, same as the RGB camera.
+  AddPostProcessingMaterial(
+      TEXT("Material'/Carla/PostProcessingMaterials/PhysicLensDistortion.PhysicLensDistortion'"));
+
+  auto MakeRenderTarget = [this](const TCHAR *Name)
+  {
+    auto *RenderTarget = CreateDefaultSubobject<UTextureRenderTarget2D>(Name);
+    RenderTarget->CompressionSettings = TextureCompressionSettings::TC_Default;
+    RenderTarget->SRGB = false;
+    RenderTarget->bAutoGenerateMips = false;
+    RenderTarget->bGPUSharedFlag = true;
+    RenderTarget->AddressX = TextureAddress::TA_Clamp;
+    RenderTarget->AddressY = TextureAddress::TA_Clamp;
+    return RenderTarget;
+  };
+
+  auto MakeCaptureComponent = [this](const TCHAR *Name)
+  {
+    auto *Capture = CreateDefaultSubobject<USceneCaptureComponent2D>(Name);
+    Capture->SetupAttachment(RootComponent);
+    Capture->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_RenderScenePrimitives;
+    return Capture;
+  };
+
+  DepthRenderTarget = MakeRenderTarget(TEXT("DepthCaptureRenderTarget"));
+  DepthCaptureComponent2D = MakeCaptureComponent(TEXT("DepthSceneCaptureComponent2D"));
+  SemSegRenderTarget = MakeRenderTarget(TEXT("SemSegCaptureRenderTarget"));
+  SemSegCaptureComponent2D = MakeCaptureComponent(TEXT("SemSegSceneCaptureComponent2D"));
+
+  ConstructorHelpers::FObjectFinder<UMaterial> DepthLoader(
+#if PLATFORM_LINUX
+      TEXT("Material'/Carla/PostProcessingMaterials/DepthEffectMaterial_GLSL.DepthEffectMaterial_GLSL'")
+#else
+      TEXT("Material'/Carla/PostProcessingMaterials/DepthEffectMaterial.DepthEffectMaterial'")
+#endif
+  );
+  if (DepthLoader.Succeeded())
+  {
+    DepthMaterial = DepthLoader.Object;
+  }
+
+  ConstructorHelpers::FObjectFinder<UMaterial> SemSegLoader(
+      TEXT("Material'/Carla/PostProcessingMaterials/GTMaterial.GTMaterial'"));
+  if (SemSegLoader.Succeeded())
+  {
+    SemSegMaterial = SemSegLoader.Object;
+  }
+}
+
+void AMultiOutputCamera::BeginPlay()
+{
+  // The base class sets up the color capture and registers its capture
+  // schedule delegate; registering ours afterwards guarantees it sees the
+  // schedule of the current tick.
+  Super::BeginPlay();
+
+  SetUpExtraCapture(*DepthCaptureComponent2D, *DepthRenderTarget, DepthMaterial);
+  SetUpExtraCapture(*SemSegCaptureComponent2D, *SemSegRenderTarget, SemSegMaterial);
+
+  SyncExtraCapturesDelegate = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+      this, &AMultiOutputCamera::SyncExtraCaptures);
+}
+
+void AMultiOutputCamera::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  Super::EndPlay(EndPlayReason);
+
+  FWorldDelegates::OnWorldPostActorTick.Remove(SyncExtraCapturesDelegate);
+}
+
+void AMultiOutputCamera::SyncExtraCaptures(UWorld *World, ELevelTick TickType, float DeltaSeconds)
+{
+  DepthCaptureComponent2D->bCaptureEveryFrame = CaptureComponent2D->bCaptureEveryFrame;
+  SemSegCaptureComponent2D->bCaptureEveryFrame = CaptureComponent2D->bCaptureEveryFrame;
+}
+
+void AMultiOutputCamera::SetUpExtraCapture(
+    USceneCaptureComponent2D &SceneCapture,
+    UTextureRenderTarget2D &RenderTarget,
+    UMaterial *PostProcessMaterial)
+{
+  // The encoding materials replace the output entirely, force linear gamma
+  // like the stand-alone depth and semantic segmentation cameras.
+  RenderTarget.InitCustomFormat(GetImageWidth(), GetImageHeight(), PF_B8G8R8A8, true);
+
+  SceneCapture.Deactivate();
+  SceneCapture.TextureTarget = &RenderTarget;
+  SceneCapture.FOVAngle = GetFOVAngle();
+  SceneCapture.CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+
+  if (PostProcessMaterial != nullptr)
+  {
+    SceneCapture.PostProcessSettings.AddBlendable(
+        UMaterialInstanceDynamic::Create(PostProcessMaterial, this), 1.0f);
+  }
+
+  SceneCapture.UpdateContent();
+  SceneCapture.Activate();
+}
+
+void AMultiOutputCamera::SendPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds)
+{
+  check(CaptureRenderTarget != nullptr);
+
+  if (!HasActorBegunPlay() || IsPendingKill())
+  {
+    return;
+  }
+
+  // Enqueue a command in the render-thread that assembles the three frames
+  // into a single buffer and sends it down the data stream.
+  ENQUEUE_RENDER_COMMAND(AMultiOutputCamera_SendPixels)
+  (
+    [this, Stream=GetDataStream(*this)](auto &InRHICmdList) mutable
+    {
+      /// @todo Can we make sure the sensor is not going to be destroyed?
+      if (IsPendingKill())
+      {
+        return;
+      }
+
+      constexpr auto Offset =
+          carla::sensor::SensorRegistry::get<AMultiOutputCamera *>::type::header_offset;
+      auto Buffer = Stream.PopBufferFromPool();
+
+      UTextureRenderTarget2D *Targets[] = {
+          CaptureRenderTarget, DepthRenderTarget, SemSegRenderTarget};
+      constexpr auto NumTargets = 3u;
+      const uint32 Size = GetImageWidth() * GetImageHeight() * 4u; // PF_R8G8B8A8
+
+      // Claim the full message up front, so the per-frame copies below
+      // never reallocate the buffer halfway through.
+      Buffer.reset(Offset + NumTargets * Size);
+
+      // Time the capture from the moment the copies are enqueued until all
+      // three outputs are on the CPU; on the async path this is the GPU
+      // readback latency.
+      const double CaptureStart = FPlatformTime::Seconds();
+
+      if (IsVulkanPlatform(GMaxRHIShaderPlatform) || IsD3DPlatform(GMaxRHIShaderPlatform, false))
+      {
+        // fence one staging copy per output and assemble the message from
+        // a task-thread, the render-thread never waits for the GPU
+        TArray<TSharedPtr<FRHIGPUTextureReadback, ESPMode::ThreadSafe>, TFixedAllocator<NumTargets>> Readbacks;
+        for (auto *Target : Targets)
+        {
+          auto RenderResource =
+              static_cast<const FTextureRenderTarget2DResource *>(Target->Resource);
+          FTexture2DRHIRef Texture = RenderResource->GetRenderTargetTexture();
+          if (!Texture)
+          {
+            return;
+          }
+          auto Readback = MakeShared<FRHIGPUTextureReadback, ESPMode::ThreadSafe>(
+              TEXT("AMultiOutputCamera_Readback"));
+          Readback->EnqueueCopy(InRHICmdList, Texture);
+          Readbacks.Add(std::move(Readback));
+        }
+
+        // force the RHI with Vulkan to refresh the fences state in the
+        // middle of the frame, otherwise the copies above are not kicked
+        // until the next one
+        {
+          FRenderQueryRHIRef Query = RHICreateRenderQuery(RQT_AbsoluteTime);
+          InRHICmdList.EndRenderQuery(Query);
+        }
+
+        Async(
+            EAsyncExecution::TaskGraph,
+            [this, Readbacks=std::move(Readbacks), Buffer=std::move(Buffer), Offset, Size, Stream=MoveTemp(Stream), CaptureStart]() mutable
+            {
+              for (auto i = 0; i < Readbacks.Num(); ++i)
+              {
+                while (!Readbacks[i]->IsReady())
+                {
+                  std::this_thread::yield();
+                }
+                const uint8 *Source = reinterpret_cast<const uint8 *>(Readbacks[i]->Lock(Size));
+                if (Source)
+                {
+                  Buffer.copy_from(Offset + i * Size, Source, Size);
+                }
+                Readbacks[i]->Unlock();
+              }
+              RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
+              if (Buffer.data())
+              {
+                SCOPE_CYCLE_COUNTER(STAT_CarlaSensorStreamSend);
+                Stream.Send(*this, std::move(Buffer));
+              }
+            });
+        return;
+      }
+
+      for (auto i = 0u; i < NumTargets; ++i)
+      {
+        FPixelReader::WritePixelsToBuffer(*Targets[i], Buffer, Offset + i * Size, InRHICmdList);
+      }
+      RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
+
+      if (Buffer.data())
+      {
+        SCOPE_CYCLE_COUNTER(STAT_CarlaSensorStreamSend);
+        Stream.Send(*this, std::move(Buffer));
+      }
+    }
+  );
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2017 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Carla/Sensor/ShaderBasedSensor.h"
+
+#include "Carla/Actor/ActorDefinition.h"
+
+#include "MultiOutputCamera.generated.h"
+
+class UMaterial;
+
+/// Sensor that captures RGB, depth and semantic segmentation images from
+/// the same pose and ships the three frames in a single message. It
+/// replaces three camera actors attached at the same transform: the
+/// outputs share one actor, one tick schedule, one readback and one
+/// stream, and are implicitly synchronized.
+///
+/// The depth and semantic outputs still need their own scene capture
+/// passes because their encodings come from post-process materials; only
+/// the per-sensor overhead is shared, not the scene render itself.
+UCLASS()
+class CARLA_API AMultiOutputCamera : public AShaderBasedSensor
+{
+  GENERATED_BODY()
+
+public:
+
+  static FActorDefinition GetSensorDefinition();
+
+  AMultiOutputCamera(const FObjectInitializer &ObjectInitializer);
+
+protected:
+
+  void BeginPlay() override;
+
+  void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+  void SendPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds) override;
+
+private:
+
+  /// Copy the capture-interval schedule of the color capture onto the
+  /// depth and semantic captures, so skipped ticks skip all three renders.
+  void SyncExtraCaptures(UWorld *World, ELevelTick TickType, float DeltaSeconds);
+
+  void SetUpExtraCapture(
+      USceneCaptureComponent2D &SceneCapture,
+      UTextureRenderTarget2D &RenderTarget,
+      UMaterial *PostProcessMaterial);
+
+  /// Render target and capture of the depth output.
+  UPROPERTY(EditAnywhere)
+  UTextureRenderTarget2D *DepthRenderTarget = nullptr;
+
+  UPROPERTY(EditAnywhere)
+  USceneCaptureComponent2D *DepthCaptureComponent2D = nullptr;
+
+  /// Render target and capture of the semantic segmentation output.
+  UPROPERTY(EditAnywhere)
+  UTextureRenderTarget2D *SemSegRenderTarget = nullptr;
+
+  UPROPERTY(EditAnywhere)
+  USceneCaptureComponent2D *SemSegCaptureComponent2D = nullptr;
+
+  UPROPERTY()
+  UMaterial *DepthMaterial = nullptr;
+
+  UPROPERTY()
+  UMaterial *SemSegMaterial = nullptr;
+
+  FDelegateHandle SyncExtraCapturesDelegate;
+};
@@ -58,6 +58,25 @@ void AObstacleDetectionSensor::Tick(float DeltaSeconds)
   const FVector &End = Start + (GetActorForwardVector() * Distance);
   UWorld* CurrentWorld = GetWorld();
 
+  if (bOnlyDynamics)
+  {
+    // Broad-phase against the shared actor bounds octree: when looking only
+    // for dynamic obstacles, every candidate is a registered actor, so if
+    // none overlaps the swept corridor the physics sweep can be skipped.
+    // Most ticks of most sensors end here.
+    TArray<AActor *> Candidates;
+    GetEpisode().GetActorBoundsOctree().QuerySweep(Start, End, HitRadius, true, Candidates);
+    Candidates.Remove(this);
+    if (Super::GetOwner() != nullptr)
+    {
+      Candidates.Remove(Super::GetOwner());
+    }
+    if (Candidates.Num() == 0)
+    {
+      return;
+    }
+  }
+
   // Struct in which the result of the scan will be saved
   FHitResult HitOut = FHitResult();
 
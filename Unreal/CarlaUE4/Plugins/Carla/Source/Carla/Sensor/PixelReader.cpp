@@ -7,10 +7,14 @@
 #include "Carla.h"
 #include "Carla/Sensor/PixelReader.h"
 
+#include "Async/Async.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "HighResScreenshot.h"
+#include "RHIGPUReadback.h"
 #include "Runtime/ImageWriteQueue/Public/ImageWriteQueue.h"
 
+#include <thread>
+
 // =============================================================================
 // -- Local variables and types ------------------------------------------------
 // =============================================================================
@@ -32,41 +36,6 @@ struct LockTexture
   const uint8 *Source;
 };
 
-// =============================================================================
-// -- Static local functions ---------------------------------------------------
-// =============================================================================
-
-// Temporal; this avoid allocating the array each time and also avoids checking
-// for a bigger texture, ReadSurfaceData will allocate the space needed.
-TArray<FColor> gPixels;
-
-static void WritePixelsToBuffer_Vulkan(
-    const UTextureRenderTarget2D &RenderTarget,
-    carla::Buffer &Buffer,
-    uint32 Offset,
-    FRHICommandListImmediate &InRHICmdList)
-{
-  check(IsInRenderingThread());
-  auto RenderResource =
-      static_cast<const FTextureRenderTarget2DResource *>(RenderTarget.Resource);
-  FTexture2DRHIRef Texture = RenderResource->GetRenderTargetTexture();
-  if (!Texture)
-  {
-    return;
-  }
-
-  FIntPoint Rect = RenderResource->GetSizeXY();
-
-  // NS: Extra copy here, don't know how to avoid it.
-  InRHICmdList.ReadSurfaceData(
-      Texture,
-      FIntRect(0, 0, Rect.X, Rect.Y),
-      gPixels,
-      FReadSurfaceDataFlags(RCM_UNorm, CubeFace_MAX));
-
-  Buffer.copy_from(Offset, gPixels);
-}
-
 // =============================================================================
 // -- FPixelReader -------------------------------------------------------------
 // =============================================================================
@@ -123,21 +92,71 @@ TFuture<bool> FPixelReader::SavePixelsToDisk(
   return HighResScreenshotConfig.ImageWriteQueue->Enqueue(MoveTemp(ImageTask));
 }
 
-void FPixelReader::WritePixelsToBuffer(
+void FPixelReader::WritePixelsToBufferAsync(
     UTextureRenderTarget2D &RenderTarget,
-    carla::Buffer &Buffer,
+    carla::Buffer Buffer,
     uint32 Offset,
-    FRHICommandListImmediate &InRHICmdList
-    )
+    FRHICommandListImmediate &InRHICmdList,
+    TUniqueFunction<void(carla::Buffer)> FuncForSending)
 {
   check(IsInRenderingThread());
 
-  if (IsVulkanPlatform(GMaxRHIShaderPlatform) || IsD3DPlatform(GMaxRHIShaderPlatform, false))
+  auto RenderResource =
+      static_cast<const FTextureRenderTarget2DResource *>(RenderTarget.Resource);
+  FTexture2DRHIRef Texture = RenderResource->GetRenderTargetTexture();
+  if (!Texture)
   {
-    WritePixelsToBuffer_Vulkan(RenderTarget, Buffer, Offset, InRHICmdList);
     return;
   }
 
+  const FIntPoint Rect = RenderResource->GetSizeXY();
+  const uint32 BytesPerPixel = 4u; // PF_R8G8B8A8
+  const uint32 Size = Rect.X * Rect.Y * BytesPerPixel;
+
+  // enqueue the copy into the staging texture on the RHI thread, the
+  // render-thread continues without waiting for the GPU
+  auto Readback = MakeShared<FRHIGPUTextureReadback, ESPMode::ThreadSafe>(
+      TEXT("FPixelReader_Readback"));
+  Readback->EnqueueCopy(InRHICmdList, Texture);
+
+  // force the RHI with Vulkan to refresh the fences state in the middle of
+  // the frame, otherwise the copy above is not kicked until the next one
+  {
+    FRenderQueryRHIRef Query = RHICreateRenderQuery(RQT_AbsoluteTime);
+    InRHICmdList.EndRenderQuery(Query);
+  }
+
+  // wait for the fence and send the buffer from a task-thread
+  Async(
+      EAsyncExecution::TaskGraph,
+      [Readback, Buffer=std::move(Buffer), Offset, Size, FuncForSending=MoveTemp(FuncForSending)]() mutable
+      {
+        while (!Readback->IsReady())
+        {
+          std::this_thread::yield();
+        }
+        const uint8 *Source = reinterpret_cast<const uint8 *>(Readback->Lock(Size));
+        if (Source)
+        {
+          Buffer.copy_from(Offset, Source, Size);
+        }
+        Readback->Unlock();
+        if (Buffer.data())
+        {
+          FuncForSending(std::move(Buffer));
+        }
+      });
+}
+
+void FPixelReader::WritePixelsToBuffer(
+    UTextureRenderTarget2D &RenderTarget,
+    carla::Buffer &Buffer,
+    uint32 Offset,
+    FRHICommandListImmediate &InRHICmdList
+    )
+{
+  check(IsInRenderingThread());
+
   FTextureRenderTargetResource* RenderTargetResource = RenderTarget.GetRenderTargetResource();
   if(!RenderTargetResource)
   {
@@ -9,6 +9,7 @@
 #include "CoreGlobals.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Runtime/ImageWriteQueue/Public/ImagePixelData.h"
+#include "Templates/Function.h"
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/Buffer.h>
@@ -64,8 +65,6 @@ public:
   template <typename TSensor>
   static void SendPixelsInRenderThread(TSensor &Sensor);
 
-private:
-
   /// Copy the pixels in @a RenderTarget into @a Buffer.
   ///
   /// @pre To be called from render-thread.
@@ -75,6 +74,21 @@ private:
       uint32 Offset,
       FRHICommandListImmediate &InRHICmdList);
 
+private:
+
+  /// Copy the pixels in @a RenderTarget into @a Buffer through a fenced
+  /// staging texture, without blocking the render-thread on the GPU.
+  /// @a FuncForSending is called from a task-thread once the copy has
+  /// finished; it gets the buffer back only when there is pixel data in it.
+  ///
+  /// @pre To be called from render-thread.
+  static void WritePixelsToBufferAsync(
+      UTextureRenderTarget2D &RenderTarget,
+      carla::Buffer Buffer,
+      uint32 Offset,
+      FRHICommandListImmediate &InRHICmdList,
+      TUniqueFunction<void(carla::Buffer)> FuncForSending);
+
 };
 
 // =============================================================================
@@ -101,12 +115,46 @@ void FPixelReader::SendPixelsInRenderThread(TSensor &Sensor)
       /// @todo Can we make sure the sensor is not going to be destroyed?
       if (!Sensor.IsPendingKill())
       {
+        constexpr auto Offset =
+            carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset;
         auto Buffer = Stream.PopBufferFromPool();
+
+#if WITH_MGPU
+        // Under explicit multi-GPU the default mask only covers the first
+        // GPU; run the copy below on the one this camera was assigned to.
+        SCOPED_GPU_MASK(InRHICmdList, FRHIGPUMask::FromIndex(Sensor.GetGpuIndex()));
+#endif
+
+        // Time the capture from the moment the copy is enqueued until the
+        // pixels are available on the CPU; on the async path this is the
+        // GPU readback latency.
+        const double CaptureStart = FPlatformTime::Seconds();
+
+        if (IsVulkanPlatform(GMaxRHIShaderPlatform) || IsD3DPlatform(GMaxRHIShaderPlatform, false))
+        {
+          // the copy is fenced on the RHI thread and the buffer is sent
+          // from a task-thread once ready, the render-thread never waits
+          // for the GPU
+          WritePixelsToBufferAsync(
+              *Sensor.CaptureRenderTarget,
+              std::move(Buffer),
+              Offset,
+              InRHICmdList,
+              [&Sensor, Stream=MoveTemp(Stream), CaptureStart](carla::Buffer Buffer) mutable
+              {
+                Sensor.RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
+                SCOPE_CYCLE_COUNTER(STAT_CarlaSensorStreamSend);
+                Stream.Send(Sensor, std::move(Buffer));
+              });
+          return;
+        }
+
         WritePixelsToBuffer(
             *Sensor.CaptureRenderTarget,
             Buffer,
-            carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset,
+            Offset,
             InRHICmdList);
+        Sensor.RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
 
         if(Buffer.data())
         {
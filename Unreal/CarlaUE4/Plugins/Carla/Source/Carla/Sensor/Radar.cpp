@@ -72,11 +72,15 @@ void ARadar::Tick(const float DeltaTime)
 {
   Super::Tick(DeltaTime);
 
+  const double CaptureStart = FPlatformTime::Seconds();
+
   CalculateCurrentVelocity(DeltaTime);
 
   RadarData.Reset();
   SendLineTraces(DeltaTime);
 
+  RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
+
   auto DataStream = GetDataStream(*this);
   DataStream.Send(*this, RadarData, DataStream.PopBufferFromPool());
 }
@@ -105,20 +109,28 @@ void ARadar::SendLineTraces(float DeltaTime)
   const float MaxRy = FMath::Tan(FMath::DegreesToRadians(VerticalFOV * 0.5f)) * Range;
   const int NumPoints = (int)(PointsPerSecond * DeltaTime);
 
-  FCriticalSection Mutex;
+  // The sampling pattern comes from the shared random engine, which is not
+  // thread-safe; draw it before going wide. The buffer keeps its capacity
+  // across ticks so after the first tick this does not allocate.
+  Rays.SetNum(NumPoints, false);
+  for (auto& Ray : Rays) {
+    Ray.Radius = RandomEngine->GetUniformFloat();
+    Ray.Angle = RandomEngine->GetUniformFloatInRange(0.0f, carla::geom::Math::Pi2<float>());
+    Ray.Hitted = false;
+  }
+
   GetWorld()->GetPhysicsScene()->GetPxScene()->lockRead();
-  ParallelFor(NumPoints, [&](int32 idxChannel) {
+  ParallelFor(NumPoints, [&](int32 idx) {
     FHitResult OutHit(ForceInit);
-    const float Radius = RandomEngine->GetUniformFloat();
-    const float Angle = RandomEngine->GetUniformFloatInRange(0.0f, carla::geom::Math::Pi2<float>());
+    RayData& Ray = Rays[idx];
 
     float Sin, Cos;
-    FMath::SinCos(&Sin, &Cos, Angle);
+    FMath::SinCos(&Sin, &Cos, Ray.Angle);
 
     const FVector EndLocation = RadarLocation + TransformRotator.RotateVector({
       Range,
-      MaxRx * Radius * Cos,
-      MaxRy * Radius * Sin
+      MaxRx * Ray.Radius * Cos,
+      MaxRy * Ray.Radius * Sin
     });
 
     const bool Hitted = World->LineTraceSingleByChannel(
@@ -132,27 +144,34 @@ void ARadar::SendLineTraces(float DeltaTime)
 
     const TWeakObjectPtr<AActor> HittedActor = OutHit.Actor;
     if (Hitted && HittedActor.Get()) {
+      Ray.Hitted = true;
 
-      const float RelativeVelocity = CalculateRelativeVelocity(OutHit, RadarLocation);
+      Ray.RelativeVelocity = CalculateRelativeVelocity(OutHit, RadarLocation);
 
-      const FVector2D AzimuthAndElevation = FMath::GetAzimuthAndElevation (
+      Ray.AzimuthAndElevation = FMath::GetAzimuthAndElevation (
         (EndLocation - RadarLocation).GetSafeNormal() * Range,
         TransformXAxis,
         TransformYAxis,
         TransformZAxis
       );
 
-      Mutex.Lock();
-      RadarData.WriteDetection({
-        RelativeVelocity,
-        AzimuthAndElevation.X,
-        AzimuthAndElevation.Y,
-        OutHit.Distance * TO_METERS
-      });
-      Mutex.Unlock();
+      Ray.Distance = OutHit.Distance * TO_METERS;
     }
   });
   GetWorld()->GetPhysicsScene()->GetPxScene()->unlockRead();
+
+  // Write the detections in ray order, so the output is deterministic and
+  // no lock is needed around the serializer buffer.
+  for (const auto& Ray : Rays) {
+    if (Ray.Hitted) {
+      RadarData.WriteDetection({
+        Ray.RelativeVelocity,
+        Ray.AzimuthAndElevation.X,
+        Ray.AzimuthAndElevation.Y,
+        Ray.Distance
+      });
+    }
+  }
 }
 
 float ARadar::CalculateRelativeVelocity(const FHitResult& OutHit, const FVector& RadarLocation)
@@ -70,6 +70,18 @@ private:
 
   float CalculateRelativeVelocity(const FHitResult& OutHit, const FVector& RadarLocation);
 
+  struct RayData {
+    float Radius;
+    float Angle;
+    bool Hitted;
+    float RelativeVelocity;
+    FVector2D AzimuthAndElevation;
+    float Distance;
+  };
+
+  /// Scratch buffer of rays, pre-sized once and reused every tick.
+  TArray<RayData> Rays;
+
   FRadarData RadarData;
 
   FCollisionQueryParams TraceParams;
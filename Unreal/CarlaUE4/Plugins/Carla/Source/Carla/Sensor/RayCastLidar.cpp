@@ -6,6 +6,7 @@
 
 #include <PxScene.h>
 #include <cmath>
+#include <numeric>
 #include "Carla.h"
 #include "Carla/Sensor/RayCastLidar.h"
 #include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
@@ -44,7 +45,6 @@ void ARayCastLidar::Set(const FActorDescription &ActorDescription)
 void ARayCastLidar::Set(const FLidarDescription &LidarDescription)
 {
   Description = LidarDescription;
-  LidarData = FLidarData(Description.Channels);
   CreateLasers();
   PointsPerChannel.resize(Description.Channels);
 
@@ -58,10 +58,18 @@ void ARayCastLidar::Tick(const float DeltaTime)
 {
   ASensor::Tick(DeltaTime);
 
+  // The writer serializes detections as they are produced, directly into the
+  // pooled buffer that gets sent down the stream; no intermediate point
+  // vector nor final copy is needed.
+  auto DataStream = GetDataStream(*this);
+  DataWriter = carla::sensor::s11n::LidarSerializer::MakeWriter(
+      DataStream.PopBufferFromPool(), Description.Channels, Description.QuantizedTransport);
+
+  const double CaptureStart = FPlatformTime::Seconds();
   SimulateLidar(DeltaTime);
+  RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
 
-  auto DataStream = GetDataStream(*this);
-  DataStream.Send(*this, LidarData, DataStream.PopBufferFromPool());
+  DataStream.Send(*this, DataWriter.Finish());
 }
 
 float ARayCastLidar::ComputeIntensity(const FSemanticDetection& RawDetection) const
@@ -77,11 +85,11 @@ float ARayCastLidar::ComputeIntensity(const FSemanticDetection& RawDetection) co
   return IntRec;
 }
 
-ARayCastLidar::FDetection ARayCastLidar::ComputeDetection(const FHitResult& HitInfo, const FTransform& SensorTransf) const
+ARayCastLidar::FDetection ARayCastLidar::ComputeDetection(const FHitResult& HitInfo, const FTransform& InverseSensorTransf) const
 {
   FDetection Detection;
   const FVector HitPoint = HitInfo.ImpactPoint;
-  Detection.point = SensorTransf.Inverse().TransformPosition(HitPoint);
+  Detection.point = InverseSensorTransf.TransformPosition(HitPoint);
 
   const float Distance = Detection.point.Length();
 
@@ -104,12 +112,6 @@ ARayCastLidar::FDetection ARayCastLidar::ComputeDetection(const FHitResult& HitI
 
   bool ARayCastLidar::PostprocessDetection(FDetection& Detection) const
   {
-    if (Description.NoiseStdDev > std::numeric_limits<float>::epsilon()) {
-      const auto ForwardVector = Detection.point.MakeUnitVector();
-      const auto Noise = ForwardVector * RandomEngine->GetNormalDistribution(0.0f, Description.NoiseStdDev);
-      Detection.point += Noise;
-    }
-
     const float Intensity = Detection.intensity;
     if(Intensity > Description.DropOffIntensityLimit)
       return true;
@@ -120,13 +122,37 @@ ARayCastLidar::FDetection ARayCastLidar::ComputeDetection(const FHitResult& HitI
   void ARayCastLidar::ComputeAndSaveDetections(const FTransform& SensorTransform) {
     for (auto idxChannel = 0u; idxChannel < Description.Channels; ++idxChannel)
       PointsPerChannel[idxChannel] = RecordedHits[idxChannel].size();
-    LidarData.ResetSerPoints(PointsPerChannel);
+
+    DataWriter.Reserve(static_cast<uint32_t>(
+        std::accumulate(PointsPerChannel.begin(), PointsPerChannel.end(), 0u)));
+
+    const FTransform InverseSensorTransform = SensorTransform.Inverse();
+    const bool bWithNoise = Description.NoiseStdDev > std::numeric_limits<float>::epsilon();
 
     for (auto idxChannel = 0u; idxChannel < Description.Channels; ++idxChannel) {
-      for (auto& hit : RecordedHits[idxChannel]) {
-        FDetection Detection = ComputeDetection(hit, SensorTransform);
+      auto& Hits = RecordedHits[idxChannel];
+
+      ChannelDetections.clear();
+      ChannelDetections.reserve(Hits.size());
+      for (auto& hit : Hits)
+        ChannelDetections.emplace_back(ComputeDetection(hit, InverseSensorTransform));
+
+      // Apply the position noise to the whole channel at once: the samples
+      // come from a single bulk draw and the displacement loop runs over
+      // contiguous detections, instead of paying one distribution set-up
+      // per point.
+      if (bWithNoise) {
+        RandomEngine->FillNormalDistribution(
+            0.0f, Description.NoiseStdDev, NoiseSamples, static_cast<int32>(Hits.size()));
+        for (auto idxPts = 0u; idxPts < ChannelDetections.size(); ++idxPts) {
+          auto& Detection = ChannelDetections[idxPts];
+          Detection.point += Detection.point.MakeUnitVector() * NoiseSamples[idxPts];
+        }
+      }
+
+      for (auto& Detection : ChannelDetections) {
         if (PostprocessDetection(Detection))
-          LidarData.WritePointSync(Detection);
+          DataWriter.WritePoint(idxChannel, Detection);
       }
     }
   }
@@ -15,6 +15,7 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/sensor/data/LidarData.h>
+#include <carla/sensor/s11n/LidarSerializer.h>
 #include <compiler/enable-ue4-macros.h>
 
 #include "RayCastLidar.generated.h"
@@ -27,6 +28,7 @@ class CARLA_API ARayCastLidar : public ARayCastSemanticLidar
 
   using FLidarData = carla::sensor::data::LidarData;
   using FDetection = carla::sensor::data::LidarDetection;
+  using FLidarDataWriter = carla::sensor::s11n::LidarDataWriter;
 
 public:
   static FActorDefinition GetSensorDefinition();
@@ -38,16 +40,21 @@ public:
 private:
   /// Compute the received intensity of the point
   float ComputeIntensity(const FSemanticDetection& RawDetection) const;
-  FDetection ComputeDetection(const FHitResult& HitInfo, const FTransform& SensorTransf) const;
+  FDetection ComputeDetection(const FHitResult& HitInfo, const FTransform& InverseSensorTransf) const;
 
   bool PreprocessRay() const override;
+
+  /// Intensity-based drop-off decision; the position noise is applied in a
+  /// separate batched pass over the whole channel.
   bool PostprocessDetection(FDetection& Detection) const;
 
   void ComputeAndSaveDetections(const FTransform& SensorTransform) override;
 
   virtual void Tick(float DeltaTime) override;
 
-  FLidarData LidarData;
+  /// Serializes detections straight into the stream's pooled buffer; armed
+  /// with a fresh buffer at the beginning of each Tick.
+  FLidarDataWriter DataWriter;
 
   /// Enable/Disable general dropoff of lidar points
   bool DropOffGenActive;
@@ -59,4 +66,10 @@ private:
   /// beta = (1 - dropoff_zero_intensity)
   float DropOffAlpha;
   float DropOffBeta;
+
+  /// Scratch buffers of ComputeAndSaveDetections, kept across frames so
+  /// the batched noise pass runs over contiguous storage without
+  /// reallocating every scan.
+  std::vector<FDetection> ChannelDetections;
+  TArray<float> NoiseSamples;
 };
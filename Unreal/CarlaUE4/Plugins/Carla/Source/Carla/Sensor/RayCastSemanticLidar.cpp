@@ -56,11 +56,16 @@ void ARayCastSemanticLidar::CreateLasers()
     (Description.UpperFovLimit - Description.LowerFovLimit) /
     static_cast<float>(NumberOfLasers - 1);
   LaserAngles.Empty(NumberOfLasers);
+  LaserElevationCos.Empty(NumberOfLasers);
+  LaserElevationSin.Empty(NumberOfLasers);
   for(auto i = 0u; i < NumberOfLasers; ++i)
   {
     const float VerticalAngle =
         Description.UpperFovLimit - static_cast<float>(i) * DeltaAngle;
     LaserAngles.Emplace(VerticalAngle);
+    const float VerticalRad = FMath::DegreesToRadians(VerticalAngle);
+    LaserElevationCos.Emplace(FMath::Cos(VerticalRad));
+    LaserElevationSin.Emplace(FMath::Sin(VerticalRad));
   }
 }
 
@@ -68,7 +73,9 @@ void ARayCastSemanticLidar::Tick(const float DeltaTime)
 {
   Super::Tick(DeltaTime);
 
+  const double CaptureStart = FPlatformTime::Seconds();
   SimulateLidar(DeltaTime);
+  RecordCaptureTime(FPlatformTime::Seconds() - CaptureStart);
 
   auto DataStream = GetDataStream(*this);
   DataStream.Send(*this, SemanticLidarData, DataStream.PopBufferFromPool());
@@ -100,22 +107,49 @@ void ARayCastSemanticLidar::SimulateLidar(const float DeltaTime)
 
   ResetRecordedHits(ChannelCount, PointsToScanWithOneLaser);
 
+  // Everything constant for the whole scan is computed once here; at
+  // millions of traces per second the per-ray setup (actor transform,
+  // rotator conversion, query params) costs as much as the trace itself.
+  FCollisionQueryParams TraceParams = FCollisionQueryParams(FName(TEXT("Laser_Trace")), true, this);
+  TraceParams.bTraceComplex = true;
+  TraceParams.bReturnPhysicalMaterial = false;
+
+  const FTransform ActorTransf = GetTransform();
+  const FVector LidarBodyLoc = ActorTransf.GetLocation();
+  const FQuat LidarBodyQuat = ActorTransf.GetRotation();
+
+  // Azimuth table of the scan, shared by every channel; the elevation
+  // tables only change with the description.
+  AzimuthCos.SetNumUninitialized(PointsToScanWithOneLaser, false);
+  AzimuthSin.SetNumUninitialized(PointsToScanWithOneLaser, false);
+  for (auto idxPts = 0u; idxPts < PointsToScanWithOneLaser; ++idxPts) {
+    const float HorizRad = FMath::DegreesToRadians(
+        CurrentHorizontalAngle + AngleDistanceOfLaserMeasure * idxPts);
+    AzimuthCos[idxPts] = FMath::Cos(HorizRad);
+    AzimuthSin[idxPts] = FMath::Sin(HorizRad);
+  }
+
   GetWorld()->GetPhysicsScene()->GetPxScene()->lockRead();
   ParallelFor(ChannelCount, [&](int32 idxChannel) {
+    const float ElevationCos = LaserElevationCos[idxChannel];
+    const float ElevationSin = LaserElevationSin[idxChannel];
     for (auto idxPtsOneLaser = 0u; idxPtsOneLaser < PointsToScanWithOneLaser; idxPtsOneLaser++) {
       FHitResult HitResult;
-      const float VertAngle = LaserAngles[idxChannel];
-      const float HorizAngle = CurrentHorizontalAngle + AngleDistanceOfLaserMeasure * idxPtsOneLaser;
+      // Unit forward vector of the ray in the lidar frame, assembled from
+      // the tables; no per-ray trigonometry is left.
+      const FVector LaserDir(
+          ElevationCos * AzimuthCos[idxPtsOneLaser],
+          ElevationCos * AzimuthSin[idxPtsOneLaser],
+          ElevationSin);
       const bool PreprocessResult = PreprocessRay();
 
-      if (PreprocessResult && ShootLaser(VertAngle, HorizAngle, HitResult)) {
+      if (PreprocessResult && ShootLaser(LaserDir, LidarBodyQuat, LidarBodyLoc, TraceParams, HitResult)) {
         WritePointAsync(idxChannel, HitResult);
       }
     };
   });
   GetWorld()->GetPhysicsScene()->GetPxScene()->unlockRead();
 
-  FTransform ActorTransf = GetTransform();
   ComputeAndSaveDetections(ActorTransf);
 
   const float HorizontalAngle = carla::geom::Math::ToRadians(
@@ -141,41 +175,37 @@ void ARayCastSemanticLidar::ComputeAndSaveDetections(const FTransform& SensorTra
     PointsPerChannel[idxChannel] = RecordedHits[idxChannel].size();
   SemanticLidarData.ResetSerPoints(PointsPerChannel);
 
+  const FTransform InverseSensorTransform = SensorTransform.Inverse();
   for (auto idxChannel = 0u; idxChannel < Description.Channels; ++idxChannel) {
     for (auto& hit : RecordedHits[idxChannel]) {
       FSemanticDetection detection;
-      ComputeRawDetection(hit, SensorTransform, detection);
+      ComputeRawDetection(hit, SensorTransform, InverseSensorTransform, detection);
       SemanticLidarData.WritePointSync(detection);
     }
   }
 }
 
-void ARayCastSemanticLidar::ComputeRawDetection(const FHitResult& HitInfo, const FTransform& SensorTransf, FSemanticDetection& Detection) const
+void ARayCastSemanticLidar::ComputeRawDetection(const FHitResult& HitInfo, const FTransform& SensorTransf, const FTransform& InverseSensorTransf, FSemanticDetection& Detection) const
 {
     const FVector HitPoint = HitInfo.ImpactPoint;
-    Detection.point = SensorTransf.Inverse().TransformPosition(HitPoint);
+    Detection.point = InverseSensorTransf.TransformPosition(HitPoint);
 
     const FVector VecInc = - (HitPoint - SensorTransf.GetLocation()).GetSafeNormal();
     Detection.cos_inc_angle = FVector::DotProduct(VecInc, HitInfo.ImpactNormal);
 
-    const FActorRegistry &Registry = GetEpisode().GetActorRegistry();
-
     AActor* actor = HitInfo.Actor.Get();
     Detection.object_idx = 0;
     Detection.object_tag = static_cast<uint32_t>(crp::CityObjectLabel::None);
     if (actor != nullptr) {
-
-      FActorView view = Registry.Find(actor);
-
-      if(view.IsValid()) {
-        const FActorInfo* ActorInfo = view.GetActorInfo();
-        Detection.object_idx = ActorInfo->Description.UId;
-
-        Detection.object_tag = static_cast<uint32_t>(HitInfo.Component->CustomDepthStencilValue);
-      }
-      else {
-        Detection.object_tag = static_cast<uint32_t>(HitInfo.Component->CustomDepthStencilValue);
-      }
+      // The registry search and the component dereference go through the
+      // episode's shared cache; most rays of a scan hit objects that were
+      // already resolved.
+      GetEpisode().GetSemanticTagResolver().Resolve(
+          GetEpisode().GetActorRegistry(),
+          actor,
+          HitInfo.Component.Get(),
+          Detection.object_idx,
+          Detection.object_tag);
     }
     else {
       UE_LOG(LogCarla, Warning, TEXT("Actor not valid %p!!!!"), actor);
@@ -183,24 +213,17 @@ void ARayCastSemanticLidar::ComputeRawDetection(const FHitResult& HitInfo, const
 }
 
 
-bool ARayCastSemanticLidar::ShootLaser(const float VerticalAngle, const float HorizontalAngle, FHitResult& HitResult) const
+bool ARayCastSemanticLidar::ShootLaser(
+    const FVector &LaserDir,
+    const FQuat &LidarBodyQuat,
+    const FVector &LidarBodyLoc,
+    const FCollisionQueryParams &TraceParams,
+    FHitResult &HitResult) const
 {
-  FCollisionQueryParams TraceParams = FCollisionQueryParams(FName(TEXT("Laser_Trace")), true, this);
-  TraceParams.bTraceComplex = true;
-  TraceParams.bReturnPhysicalMaterial = false;
-
   FHitResult HitInfo(ForceInit);
 
-  FTransform ActorTransf = GetTransform();
-  FVector LidarBodyLoc = ActorTransf.GetLocation();
-  FRotator LidarBodyRot = ActorTransf.Rotator();
-  FRotator LaserRot (VerticalAngle, HorizontalAngle, 0);  // float InPitch, float InYaw, float InRoll
-  FRotator ResultRot = UKismetMathLibrary::ComposeRotators(
-    LaserRot,
-    LidarBodyRot
-  );
   const auto Range = Description.Range;
-  FVector EndTrace = Range * UKismetMathLibrary::GetForwardVector(ResultRot) + LidarBodyLoc;
+  const FVector EndTrace = Range * LidarBodyQuat.RotateVector(LaserDir) + LidarBodyLoc;
 
   GetWorld()->LineTraceSingleByChannel(
     HitInfo,
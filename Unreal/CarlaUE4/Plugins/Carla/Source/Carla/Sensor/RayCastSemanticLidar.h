@@ -49,7 +49,16 @@ protected:
   void SimulateLidar(float DeltaTime);
 
   /// Shoot a laser ray-trace, return whether the laser hit something.
-  bool ShootLaser(const float VerticalAngle, float HorizontalAngle, FHitResult &HitResult) const;
+  /// @a LaserDir is the unit direction of the ray in the lidar frame,
+  /// assembled from the precomputed elevation and azimuth tables; the body
+  /// location, orientation and trace params are constant for the whole
+  /// scan and get computed once by SimulateLidar.
+  bool ShootLaser(
+      const FVector &LaserDir,
+      const FQuat &LidarBodyQuat,
+      const FVector &LidarBodyLoc,
+      const FCollisionQueryParams &TraceParams,
+      FHitResult &HitResult) const;
 
   /// Method that allow to preprocess the ray before shoot it
   virtual bool PreprocessRay() const {
@@ -58,8 +67,13 @@ protected:
     return true;
   }
 
-  /// Compute all raw detection information
-  void ComputeRawDetection(const FHitResult &HitInfo, const FTransform &SensorTransf, FSemanticDetection &Detection) const;
+  /// Compute all raw detection information. @a InverseSensorTransf is the
+  /// inverse of @a SensorTransf, computed once per scan by the caller.
+  void ComputeRawDetection(
+      const FHitResult &HitInfo,
+      const FTransform &SensorTransf,
+      const FTransform &InverseSensorTransf,
+      FSemanticDetection &Detection) const;
 
   /// Saving the hits the raycast returns per channel
   void WritePointAsync(uint32_t Channel, FHitResult &Detection);
@@ -76,6 +90,19 @@ protected:
 
   TArray<float> LaserAngles;
 
+  /// Sine and cosine of each channel's elevation angle, rebuilt by
+  /// CreateLasers only when the description changes; together with the
+  /// per-scan azimuth tables they replace the rotator composition that was
+  /// run for every ray.
+  TArray<float> LaserElevationCos;
+  TArray<float> LaserElevationSin;
+
+  /// Sine and cosine of the azimuth of each point index of the current
+  /// scan; the horizontal angle of point i is the same on every channel,
+  /// so each entry is computed once instead of once per ray.
+  TArray<float> AzimuthCos;
+  TArray<float> AzimuthSin;
+
   std::vector<std::vector<FHitResult>> RecordedHits;
   std::vector<uint32_t> PointsPerChannel;
 
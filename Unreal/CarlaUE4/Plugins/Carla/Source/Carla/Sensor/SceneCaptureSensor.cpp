@@ -23,6 +23,9 @@
 
 static auto SCENE_CAPTURE_COUNTER = 0u;
 
+// Round-robin counter handing alternating phases to interleaved cameras.
+static auto SCENE_CAPTURE_PHASE_COUNTER = 0;
+
 // =============================================================================
 // -- Local static methods -----------------------------------------------------
 // =============================================================================
@@ -84,6 +87,29 @@ void ASceneCaptureSensor::SetImageSize(uint32 InWidth, uint32 InHeight)
   ImageHeight = InHeight;
 }
 
+void ASceneCaptureSensor::SetGpuIndex(int32 InGpuIndex)
+{
+#if WITH_MGPU
+  if (InGpuIndex >= static_cast<int32>(GNumExplicitGPUsForRendering))
+  {
+    UE_LOG(LogCarla, Warning,
+        TEXT("ASceneCaptureSensor: gpu_index %d out of range, the engine is rendering on %u GPU(s), falling back to GPU 0"),
+        InGpuIndex,
+        GNumExplicitGPUsForRendering);
+    InGpuIndex = 0;
+  }
+#else
+  if (InGpuIndex != 0)
+  {
+    UE_LOG(LogCarla, Warning,
+        TEXT("ASceneCaptureSensor: gpu_index %d requested but the engine was not launched with explicit multi-GPU, using the default GPU"),
+        InGpuIndex);
+    InGpuIndex = 0;
+  }
+#endif
+  GpuIndex = FMath::Max(0, InGpuIndex);
+}
+
 void ASceneCaptureSensor::SetFOVAngle(const float FOVAngle)
 {
   check(CaptureComponent2D != nullptr);
@@ -491,7 +517,33 @@ void ASceneCaptureSensor::BeginPlay()
 
   Super::BeginPlay();
 
-  SendPixelsDelegate = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ASceneCaptureSensor::SendPixels);
+  // Hand this camera its phase inside the capture interval, so cameras
+  // with the same interval render on alternating ticks.
+  CaptureTickOffset = (CaptureInterval > 1) ? (SCENE_CAPTURE_PHASE_COUNTER++ % CaptureInterval) : 0;
+  CaptureTickCounter = 0;
+
+  SendPixelsDelegate = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ASceneCaptureSensor::SendScheduledPixels);
+}
+
+void ASceneCaptureSensor::SendScheduledPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds)
+{
+  // The scene capture bypasses the actor tick, so sensor_tick has to be
+  // honored here; skipped frames keep the capture component off and never
+  // touch the render target.
+  const bool bCaptureThisTick =
+      ((CaptureInterval <= 1) || (CaptureTickCounter % CaptureInterval == CaptureTickOffset)) &&
+      IsSensorTickDue(DeltaSeconds);
+  ++CaptureTickCounter;
+
+  // Keep the scene capture off on the skipped ticks, otherwise the GPU
+  // still renders frames that nobody reads.
+  CaptureComponent2D->bCaptureEveryFrame = bCaptureThisTick;
+  if (!bCaptureThisTick)
+  {
+    return;
+  }
+
+  SendPixels(World, TickType, DeltaSeconds);
 }
 
 void ASceneCaptureSensor::Tick(float DeltaTime)
@@ -511,6 +563,7 @@ void ASceneCaptureSensor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
   Super::EndPlay(EndPlayReason);
   SCENE_CAPTURE_COUNTER = 0u;
+  SCENE_CAPTURE_PHASE_COUNTER = 0;
 
   FWorldDelegates::OnWorldPostActorTick.Remove(SendPixelsDelegate);
 }
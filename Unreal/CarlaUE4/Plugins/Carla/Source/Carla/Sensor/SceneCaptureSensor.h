@@ -62,6 +62,34 @@ public:
     return bEnablePostProcessingEffects;
   }
 
+  /// Render this camera only once every @a Interval ticks. Cameras get
+  /// alternating phases assigned in round-robin, so several interleaved
+  /// cameras spread their GPU cost over consecutive frames.
+  UFUNCTION(BlueprintCallable)
+  void SetCaptureInterval(int32 Interval)
+  {
+    CaptureInterval = FMath::Max(1, Interval);
+  }
+
+  UFUNCTION(BlueprintCallable)
+  int32 GetCaptureInterval() const
+  {
+    return CaptureInterval;
+  }
+
+  /// Pin this camera's readback to the GPU with the given index when the
+  /// engine runs with explicit multi-GPU (-MaxGPUCount=N). Out-of-range
+  /// indices fall back to GPU 0 with a warning; without explicit multi-GPU
+  /// the index is ignored.
+  UFUNCTION(BlueprintCallable)
+  void SetGpuIndex(int32 InGpuIndex);
+
+  UFUNCTION(BlueprintCallable)
+  int32 GetGpuIndex() const
+  {
+    return GpuIndex;
+  }
+
   UFUNCTION(BlueprintCallable)
   void SetFOVAngle(float FOVAngle);
 
@@ -282,6 +310,11 @@ protected:
 
   virtual void SendPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds) {}
 
+  /// Called every tick; skips the ticks this camera is not scheduled on
+  /// and disables the scene capture in between, so the GPU only renders
+  /// frames that get read.
+  void SendScheduledPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds);
+
   FDelegateHandle SendPixelsDelegate;
 
   /// Render target necessary for scene capture.
@@ -307,4 +340,18 @@ protected:
   UPROPERTY(EditAnywhere)
   bool bEnablePostProcessingEffects = true;
 
+  /// Ticks between two captures of this camera, 1 renders every tick.
+  UPROPERTY(EditAnywhere)
+  int32 CaptureInterval = 1;
+
+  /// GPU this camera reads back on under explicit multi-GPU.
+  UPROPERTY(EditAnywhere)
+  int32 GpuIndex = 0;
+
+  /// Phase of this camera inside the capture interval.
+  int32 CaptureTickOffset = 0;
+
+  /// Ticks elapsed since BeginPlay.
+  int32 CaptureTickCounter = 0;
+
 };
@@ -9,9 +9,48 @@
 
 #include "Carla/Sensor/PixelReader.h"
 
+#include "Components/SceneCaptureComponent2D.h"
+
 FActorDefinition ASemanticSegmentationCamera::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("semantic_segmentation"));
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("semantic_segmentation"));
+
+  // Region of interest, in pixels of the full image. A width or height of
+  // zero disables cropping on that axis.
+  FActorVariation RoiX;
+  RoiX.Id = TEXT("roi_x");
+  RoiX.Type = EActorAttributeType::Int;
+  RoiX.RecommendedValues = { TEXT("0") };
+  RoiX.bRestrictToRecommended = false;
+
+  FActorVariation RoiY;
+  RoiY.Id = TEXT("roi_y");
+  RoiY.Type = EActorAttributeType::Int;
+  RoiY.RecommendedValues = { TEXT("0") };
+  RoiY.bRestrictToRecommended = false;
+
+  FActorVariation RoiW;
+  RoiW.Id = TEXT("roi_width");
+  RoiW.Type = EActorAttributeType::Int;
+  RoiW.RecommendedValues = { TEXT("0") };
+  RoiW.bRestrictToRecommended = false;
+
+  FActorVariation RoiH;
+  RoiH.Id = TEXT("roi_height");
+  RoiH.Type = EActorAttributeType::Int;
+  RoiH.RecommendedValues = { TEXT("0") };
+  RoiH.bRestrictToRecommended = false;
+
+  // Ship one pixel out of every NxN block of the (cropped) image.
+  FActorVariation Subsample;
+  Subsample.Id = TEXT("subsample_factor");
+  Subsample.Type = EActorAttributeType::Int;
+  Subsample.RecommendedValues = { TEXT("1") };
+  Subsample.bRestrictToRecommended = false;
+
+  Definition.Variations.Append({ RoiX, RoiY, RoiW, RoiH, Subsample });
+
+  return Definition;
 }
 
 ASemanticSegmentationCamera::ASemanticSegmentationCamera(
@@ -24,6 +63,78 @@ ASemanticSegmentationCamera::ASemanticSegmentationCamera(
       TEXT("Material'/Carla/PostProcessingMaterials/GTMaterial.GTMaterial'"));
 }
 
+void ASemanticSegmentationCamera::Set(const FActorDescription &Description)
+{
+  Super::Set(Description);
+
+  const int32 FullWidth = static_cast<int32>(GetImageWidth());
+  const int32 FullHeight = static_cast<int32>(GetImageHeight());
+
+  int32 RoiX = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "roi_x", Description.Variations, 0);
+  int32 RoiY = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "roi_y", Description.Variations, 0);
+  int32 RoiW = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "roi_width", Description.Variations, 0);
+  int32 RoiH = UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "roi_height", Description.Variations, 0);
+  const int32 Subsample = FMath::Max(1, UActorBlueprintFunctionLibrary::RetrieveActorAttributeToInt(
+      "subsample_factor", Description.Variations, 1));
+
+  RoiX = FMath::Clamp(RoiX, 0, FullWidth - 1);
+  RoiY = FMath::Clamp(RoiY, 0, FullHeight - 1);
+  RoiW = (RoiW <= 0) ? (FullWidth - RoiX) : FMath::Min(RoiW, FullWidth - RoiX);
+  RoiH = (RoiH <= 0) ? (FullHeight - RoiY) : FMath::Min(RoiH, FullHeight - RoiY);
+
+  if ((RoiW == FullWidth) && (RoiH == FullHeight) && (Subsample == 1))
+  {
+    return;
+  }
+
+  RoiMinX = static_cast<float>(RoiX) / static_cast<float>(FullWidth);
+  RoiMinY = static_cast<float>(RoiY) / static_cast<float>(FullHeight);
+  RoiMaxX = static_cast<float>(RoiX + RoiW) / static_cast<float>(FullWidth);
+  RoiMaxY = static_cast<float>(RoiY + RoiH) / static_cast<float>(FullHeight);
+  FullAspectRatio = static_cast<float>(FullHeight) / static_cast<float>(FullWidth);
+
+  // Shrink the render target to the output size; together with the custom
+  // projection set up below this drops the cost of the pixels outside the
+  // region of interest everywhere downstream, render included.
+  SetImageSize(
+      static_cast<uint32>(FMath::Max(1, RoiW / Subsample)),
+      static_cast<uint32>(FMath::Max(1, RoiH / Subsample)));
+}
+
+void ASemanticSegmentationCamera::SetUpSceneCaptureComponent(USceneCaptureComponent2D &SceneCapture)
+{
+  Super::SetUpSceneCaptureComponent(SceneCapture);
+
+  if ((RoiMinX <= 0.0f) && (RoiMinY <= 0.0f) && (RoiMaxX >= 1.0f) && (RoiMaxY >= 1.0f))
+  {
+    return;
+  }
+
+  // Render only the region of interest by offsetting the projection; the
+  // tags come from a post-process material so cropping the frustum does not
+  // change them. The FOV attribute keeps describing the full frame.
+  const float TanHalfFOVX = FMath::Tan(FMath::DegreesToRadians(GetFOVAngle()) * 0.5f);
+  const float TanHalfFOVY = TanHalfFOVX * FullAspectRatio;
+  const float ZNear = GNearClippingPlane;
+
+  const float Left = (RoiMinX * 2.0f - 1.0f) * TanHalfFOVX * ZNear;
+  const float Right = (RoiMaxX * 2.0f - 1.0f) * TanHalfFOVX * ZNear;
+  const float Top = (1.0f - RoiMinY * 2.0f) * TanHalfFOVY * ZNear;
+  const float Bottom = (1.0f - RoiMaxY * 2.0f) * TanHalfFOVY * ZNear;
+
+  // Off-center version of the engine's reversed-Z infinite-far projection.
+  SceneCapture.bUseCustomProjectionMatrix = true;
+  SceneCapture.CustomProjectionMatrix = FMatrix(
+      FPlane(2.0f * ZNear / (Right - Left), 0.0f, 0.0f, 0.0f),
+      FPlane(0.0f, 2.0f * ZNear / (Top - Bottom), 0.0f, 0.0f),
+      FPlane((Left + Right) / (Right - Left), (Top + Bottom) / (Top - Bottom), 0.0f, 1.0f),
+      FPlane(0.0f, 0.0f, ZNear, 0.0f));
+}
+
 void ASemanticSegmentationCamera::SendPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds)
 {
   FPixelReader::SendPixelsInRenderThread(*this);
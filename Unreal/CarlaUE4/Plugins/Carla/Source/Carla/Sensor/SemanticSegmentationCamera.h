@@ -13,6 +13,11 @@
 #include "SemanticSegmentationCamera.generated.h"
 
 /// Sensor that produces "semantic segmentation" images.
+///
+/// Supports cropping to a region of interest and integer subsampling,
+/// both applied at capture time: the render target shrinks to the output
+/// size and the crop becomes an off-center projection, so the render,
+/// the readback and the network all pay only for the shipped pixels.
 UCLASS()
 class CARLA_API ASemanticSegmentationCamera : public AShaderBasedSensor
 {
@@ -24,7 +29,23 @@ public:
 
   ASemanticSegmentationCamera(const FObjectInitializer &ObjectInitializer);
 
+  void Set(const FActorDescription &ActorDescription) override;
+
 protected:
 
+  void SetUpSceneCaptureComponent(USceneCaptureComponent2D &SceneCapture) override;
+
   void SendPixels(UWorld *World, ELevelTick TickType, float DeltaSeconds) override;
+
+private:
+
+  /// Region of interest as fractions of the full frame.
+  float RoiMinX = 0.0f;
+  float RoiMinY = 0.0f;
+  float RoiMaxX = 1.0f;
+  float RoiMaxY = 1.0f;
+
+  /// Height over width of the full frame, used to build the off-center
+  /// projection of the region of interest.
+  float FullAspectRatio = 0.0f;
 };
@@ -0,0 +1,83 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Carla/Actor/ActorRegistry.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Containers/Map.h"
+
+/// Caches the per-hit semantic ground-truth lookups shared by every lidar
+/// in the episode: the registry id of the hit actor and the semantic tag
+/// (custom depth stencil value) of the hit component. At millions of rays
+/// per second most hits land on actors and components already seen this
+/// scan, so both resolve to a map probe instead of a registry search and a
+/// component dereference.
+///
+/// Both tables are dropped when the actor registry version changes, which
+/// covers spawns, destructions and the tagging they trigger. The pointers
+/// are used only as map keys and never dereferenced once cached, so a
+/// stale entry cannot be reached: any reuse of the address goes through a
+/// registry change first.
+///
+/// @warning Not thread-safe: resolution runs on the game thread, after the
+/// parallel trace phase of the lidars.
+class FSemanticTagResolver
+{
+public:
+
+  void Resolve(
+      const FActorRegistry &Registry,
+      const AActor *Actor,
+      const UPrimitiveComponent *Component,
+      uint32 &ObjectId,
+      uint32 &ObjectTag)
+  {
+    if (Registry.GetVersion() != RegistryVersion)
+    {
+      RegistryVersion = Registry.GetVersion();
+      ActorIds.Reset();
+      ComponentTags.Reset();
+    }
+
+    if (const uint32 *CachedId = ActorIds.Find(Actor))
+    {
+      ObjectId = *CachedId;
+    }
+    else
+    {
+      const FActorView View = Registry.Find(Actor);
+      const uint32 Id = View.IsValid() ? View.GetActorInfo()->Description.UId : 0u;
+      ActorIds.Add(Actor, Id);
+      ObjectId = Id;
+    }
+
+    if (Component != nullptr)
+    {
+      if (const uint32 *CachedTag = ComponentTags.Find(Component))
+      {
+        ObjectTag = *CachedTag;
+      }
+      else
+      {
+        const uint32 Tag = static_cast<uint32>(Component->CustomDepthStencilValue);
+        ComponentTags.Add(Component, Tag);
+        ObjectTag = Tag;
+      }
+    }
+  }
+
+private:
+
+  /// Registry version the tables were built against; starts off invalid so
+  /// the first resolution builds them.
+  uint64 RegistryVersion = ~0ull;
+
+  TMap<const AActor *, uint32> ActorIds;
+
+  TMap<const UPrimitiveComponent *, uint32> ComponentTags;
+};
@@ -9,6 +9,7 @@
 
 #include "Carla/Actor/ActorDescription.h"
 #include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
+#include "Carla/Recorder/CarlaRecorder.h"
 
 ASensor::ASensor(const FObjectInitializer &ObjectInitializer)
   : Super(ObjectInitializer)
@@ -25,9 +26,19 @@ void ASensor::Set(const FActorDescription &Description)
   // set the tick interval of the sensor
   if (Description.Variations.Contains("sensor_tick"))
   {
-    SetActorTickInterval(
+    SensorTickInterval =
         UActorBlueprintFunctionLibrary::ActorAttributeToFloat(Description.Variations["sensor_tick"],
-        0.0f));
+        0.0f);
+    SetActorTickInterval(SensorTickInterval);
+    // Make the first measurement due on the first frame, like an actor
+    // tick interval does.
+    SensorTickAccumulator = SensorTickInterval;
+  }
+  if (Description.Variations.Contains("sensor_priority"))
+  {
+    SensorPriority =
+        UActorBlueprintFunctionLibrary::ActorAttributeToInt(Description.Variations["sensor_priority"],
+        0);
   }
 }
 
@@ -38,6 +49,24 @@ void ASensor::SetSeed(const int32 InSeed)
   RandomEngine->Seed(InSeed);
 }
 
+void ASensor::EnableRecorderCapture(ACarlaRecorder &Recorder, uint32 DatabaseId)
+{
+  using ListenerCallback = carla::streaming::detail::MultiStreamState::ListenerCallback;
+  const uint8 PacketId = Recorder.GetSensorDataPacketId();
+  // the callback runs on whatever thread serializes the message; the
+  // recorder outlives the recording and drops the listener when it stops
+  Stream.SetMessageListener(std::make_shared<const ListenerCallback>(
+      [RecorderPtr = &Recorder, PacketId, DatabaseId](auto Message)
+      {
+        RecorderPtr->AddCustomPacket(PacketId, DatabaseId, std::move(Message));
+      }));
+}
+
+void ASensor::DisableRecorderCapture()
+{
+  Stream.SetMessageListener(nullptr);
+}
+
 void ASensor::PostActorCreated()
 {
   Super::PostActorCreated();
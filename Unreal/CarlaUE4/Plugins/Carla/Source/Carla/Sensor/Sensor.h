@@ -12,8 +12,15 @@
 
 #include "GameFramework/Actor.h"
 
+#include <compiler/disable-ue4-macros.h>
+#include <carla/rpc/SensorTiming.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <atomic>
+
 #include "Sensor.generated.h"
 
+class ACarlaRecorder;
 struct FActorDescription;
 
 /// Base class for sensors.
@@ -62,6 +69,59 @@ public:
   UFUNCTION(BlueprintCallable)
   void SetSeed(int32 InSeed);
 
+  /// Mirror every message sent down this sensor's stream into @a Recorder
+  /// as a custom packet. The payload buffers are shared with the network
+  /// message, so the sensor output is serialized only once.
+  void EnableRecorderCapture(ACarlaRecorder &Recorder, uint32 DatabaseId);
+
+  void DisableRecorderCapture();
+
+  /// @name Timing instrumentation
+  ///
+  /// Accumulators splitting the cost of this sensor into capture,
+  /// serialization, and transmission. Atomic because each phase records
+  /// from whichever thread runs it; the stream records serialization and
+  /// transmission on every send, capture is recorded by the sensors that
+  /// implement that phase.
+  /// @{
+
+  void RecordCaptureTime(double Seconds)
+  {
+    CaptureNanos.fetch_add(ToNanoseconds(Seconds), std::memory_order_relaxed);
+  }
+
+  void RecordSerializationTime(double Seconds)
+  {
+    SerializationNanos.fetch_add(ToNanoseconds(Seconds), std::memory_order_relaxed);
+  }
+
+  void RecordTransmissionTime(double Seconds)
+  {
+    TransmissionNanos.fetch_add(ToNanoseconds(Seconds), std::memory_order_relaxed);
+    MeasurementCount.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  /// Snapshot of the times accumulated since the sensor was spawned.
+  carla::rpc::SensorTiming GetTiming() const
+  {
+    carla::rpc::SensorTiming Timing;
+    Timing.capture_seconds = 1e-9 * CaptureNanos.load(std::memory_order_relaxed);
+    Timing.serialization_seconds = 1e-9 * SerializationNanos.load(std::memory_order_relaxed);
+    Timing.transmission_seconds = 1e-9 * TransmissionNanos.load(std::memory_order_relaxed);
+    Timing.measurement_count = MeasurementCount.load(std::memory_order_relaxed);
+    Timing.throttled_count = ThrottledCount.load(std::memory_order_relaxed);
+    return Timing;
+  }
+
+  /// @}
+
+  /// Priority used by the frame-budget throttle; sensors below the episode
+  /// throttle level skip their captures while the episode is over budget.
+  int32 GetSensorPriority() const
+  {
+    return SensorPriority;
+  }
+
 protected:
 
   void PostActorCreated() override;
@@ -84,6 +144,40 @@ protected:
     return Stream.MakeAsyncDataStream(Self, GetEpisode().GetElapsedGameTime());
   }
 
+  /// Fixed-timestep capture scheduler for the sensor_tick attribute:
+  /// accumulate game time and report whether this frame is a capture
+  /// frame, carrying the remainder over so rates that do not divide the
+  /// frame rate evenly do not drift. Always true when no sensor_tick was
+  /// configured.
+  bool IsSensorTickDue(float DeltaSeconds)
+  {
+    // No captures while the episode is fast-forwarding.
+    if ((Episode != nullptr) && Episode->IsFastForwarding())
+    {
+      return false;
+    }
+    // Deterministic degradation under load: while the episode is over its
+    // sensor frame budget, priorities below the throttle level skip their
+    // captures. The skip is counted so the client can see the gap.
+    if ((Episode != nullptr) && (SensorPriority < Episode->GetSensorPriorityThrottle()))
+    {
+      ThrottledCount.fetch_add(1u, std::memory_order_relaxed);
+      return false;
+    }
+    if (SensorTickInterval <= 0.0f)
+    {
+      return true;
+    }
+    SensorTickAccumulator += DeltaSeconds;
+    if (SensorTickAccumulator + KINDA_SMALL_NUMBER < SensorTickInterval)
+    {
+      return false;
+    }
+    SensorTickAccumulator =
+        FMath::Min(SensorTickAccumulator - SensorTickInterval, SensorTickInterval);
+    return true;
+  }
+
   /// Seed of the pseudo-random engine.
   UPROPERTY(Category = "Random Engine", EditAnywhere)
   int32 Seed = 123456789;
@@ -94,7 +188,30 @@ protected:
 
 private:
 
+  static uint64 ToNanoseconds(double Seconds)
+  {
+    return static_cast<uint64>(Seconds * 1e9);
+  }
+
   FDataStream Stream;
 
   const UCarlaEpisode *Episode = nullptr;
+
+  /// Seconds between two measurements, 0 measures every frame.
+  float SensorTickInterval = 0.0f;
+
+  float SensorTickAccumulator = 0.0f;
+
+  /// Higher priorities keep capturing longer under a sensor frame budget.
+  int32 SensorPriority = 0;
+
+  std::atomic<uint64> CaptureNanos{0u};
+
+  std::atomic<uint64> SerializationNanos{0u};
+
+  std::atomic<uint64> TransmissionNanos{0u};
+
+  std::atomic<uint64> MeasurementCount{0u};
+
+  std::atomic<uint64> ThrottledCount{0u};
 };
@@ -15,6 +15,7 @@
 #include "Carla/Traffic/SignComponent.h"
 #include "Carla/Walker/WalkerController.h"
 
+#include "Async/Async.h"
 #include "CoreGlobals.h"
 
 #include <compiler/disable-ue4-macros.h>
@@ -28,6 +29,9 @@ static auto FWorldObserver_GetActorState(const FActorView &View, const FActorReg
   using AType = FActorView::ActorType;
 
   carla::sensor::data::ActorDynamicState::TypeDependentState state;
+  // Delta encoding compares these records bytewise; bytes of the union not
+  // covered by the matching branch below have to be deterministic.
+  std::memset(&state, 0, sizeof(state));
 
   if (AType::Vehicle == View.GetActorType())
   {
@@ -35,6 +39,8 @@ static auto FWorldObserver_GetActorState(const FActorView &View, const FActorReg
     if (Vehicle != nullptr)
     {
       state.vehicle_data.control = carla::rpc::VehicleControl{Vehicle->GetVehicleControl()};
+      state.vehicle_data.light_state =
+          carla::rpc::VehicleLightState{Vehicle->GetVehicleLightState()}.light_state;
       auto Controller = Cast<AWheeledVehicleAIController>(Vehicle->GetController());
       if (Controller != nullptr)
       {
@@ -151,6 +157,56 @@ static auto FWorldObserver_GetActorState(const FActorView &View, const FActorReg
   return state;
 }
 
+static uint32 FWorldObserver_GetControlStamp(const FActorView &View)
+{
+  using AType = FActorView::ActorType;
+
+  if (AType::Vehicle == View.GetActorType())
+  {
+    auto Vehicle = Cast<ACarlaWheeledVehicle>(View.GetActor());
+    if (Vehicle != nullptr)
+    {
+      return Vehicle->GetControlStamp();
+    }
+  }
+  else if (AType::Walker == View.GetActorType())
+  {
+    auto Walker = Cast<APawn>(View.GetActor());
+    auto Controller = Walker != nullptr ? Cast<AWalkerController>(Walker->GetController()) : nullptr;
+    if (Controller != nullptr)
+    {
+      return Controller->GetControlStamp();
+    }
+  }
+  return 0u;
+}
+
+/// Identity of a vehicle's current traffic-light binding and light state,
+/// folded into one word so the dirty check below can compare it cheaply; a
+/// stopped vehicle whose light turns green changes nothing else.
+static uint32 FWorldObserver_GetTrafficLightStamp(
+    const FActorView &View,
+    const FActorRegistry &Registry)
+{
+  if (FActorView::ActorType::Vehicle != View.GetActorType())
+  {
+    return 0u;
+  }
+  auto Vehicle = Cast<ACarlaWheeledVehicle>(View.GetActor());
+  auto Controller = Vehicle != nullptr ?
+      Cast<AWheeledVehicleAIController>(Vehicle->GetController()) :
+      nullptr;
+  if (Controller == nullptr)
+  {
+    return 0u;
+  }
+  auto TrafficLight = Controller->GetTrafficLight();
+  const uint32 LightId = (TrafficLight != nullptr) ?
+      Registry.Find(TrafficLight).GetActorId() :
+      0u;
+  return (LightId << 3u) | (static_cast<uint32>(Controller->GetTrafficLightState()) & 0x7u);
+}
+
 static carla::geom::Vector3D FWorldObserver_GetAngularVelocity(const AActor &Actor)
 {
   const auto RootComponent = Cast<UPrimitiveComponent>(Actor.GetRootComponent());
@@ -172,22 +228,84 @@ static carla::geom::Vector3D FWorldObserver_GetAcceleration(
   return {Acceleration.X, Acceleration.Y, Acceleration.Z};
 }
 
-static carla::Buffer FWorldObserver_Serialize(
-    carla::Buffer &&buffer,
+/// Translation tolerance (in centimetres, matching FTransform units) under
+/// which an actor counts as not having moved since its last broadcast.
+static constexpr float FWorldObserver_TransformEpsilon = 1e-2f;
+
+/// Velocity tolerance in m/s for the same purpose.
+static constexpr float FWorldObserver_VelocityEpsilon = 1e-3f;
+
+static TArray<carla::sensor::data::ActorDynamicState> FWorldObserver_GatherActorStates(
     const UCarlaEpisode &Episode,
-    float DeltaSeconds,
-    bool MapChange,
-    bool PendingLightUpdates)
+    const float DeltaSeconds,
+    const bool KeyFrame)
 {
-
-  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
-  using SimulationState = carla::sensor::s11n::EpisodeStateSerializer::SimulationState;
   using ActorDynamicState = carla::sensor::data::ActorDynamicState;
 
-
   const auto &Registry = Episode.GetActorRegistry();
 
-  auto total_size = sizeof(Serializer::Header) + sizeof(ActorDynamicState) * Registry.Num();
+  TArray<ActorDynamicState> Snapshot;
+  Snapshot.Reserve(Registry.Num());
+
+  for (auto &&View : Registry)
+  {
+    check(View.IsValid());
+    const FActorInfo &ActorInfo = *View.GetActorInfo();
+    constexpr float TO_METERS = 1e-2;
+    const FVector Velocity = TO_METERS * View.GetActor()->GetVelocity();
+    const FTransform Transform = View.GetActor()->GetActorTransform();
+    const uint32 ControlStamp = FWorldObserver_GetControlStamp(View);
+    const uint32 TrafficLightStamp = FWorldObserver_GetTrafficLightStamp(View, Registry);
+
+    if (!KeyFrame)
+    {
+      // An actor that has not moved, has not received any control and kept
+      // its traffic-light binding since its last broadcast cannot produce a
+      // different record, skip gathering its state altogether. Traffic
+      // lights advance their elapsed time every tick and are always
+      // gathered.
+      const bool bDirty =
+          (FActorView::ActorType::TrafficLight == View.GetActorType()) ||
+          (ControlStamp != ActorInfo.ObservedControlStamp) ||
+          (TrafficLightStamp != ActorInfo.ObservedTrafficLightStamp) ||
+          !Velocity.Equals(ActorInfo.Velocity, FWorldObserver_VelocityEpsilon) ||
+          !Transform.Equals(ActorInfo.ObservedTransform, FWorldObserver_TransformEpsilon);
+      if (!bDirty)
+      {
+        continue;
+      }
+    }
+    ActorInfo.ObservedTransform = Transform;
+    ActorInfo.ObservedControlStamp = ControlStamp;
+    ActorInfo.ObservedTrafficLightStamp = TrafficLightStamp;
+
+    Snapshot.Emplace(ActorDynamicState{
+      View.GetActorId(),
+      Transform,
+      carla::geom::Vector3D{Velocity.X, Velocity.Y, Velocity.Z},
+      FWorldObserver_GetAngularVelocity(*View.GetActor()),
+      FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds),
+      FWorldObserver_GetActorState(View, Registry),
+    });
+  }
+  return Snapshot;
+}
+
+static carla::Buffer FWorldObserver_Serialize(
+    carla::Buffer &&buffer,
+    const carla::sensor::s11n::EpisodeStateSerializer::Header &header,
+    const TArray<carla::sensor::data::ActorDynamicState> &Snapshot,
+    const bool KeyFrame,
+    std::unordered_map<carla::rpc::ActorId, carla::sensor::data::ActorDynamicState> &PreviousActorState)
+{
+  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
+
+  if (KeyFrame)
+  {
+    PreviousActorState.clear();
+  }
+
+  auto total_size = sizeof(header) + sizeof(ActorDynamicState) * Snapshot.Num();
   auto current_size = 0;
   // Set up buffer for writing.
   buffer.reset(total_size);
@@ -198,35 +316,26 @@ static carla::Buffer FWorldObserver_Serialize(
     current_size += sizeof(data);
   };
 
-  // Write header.
-  Serializer::Header header;
-  header.episode_id = Episode.GetId();
-  header.platform_timestamp = FPlatformTime::Seconds();
-  header.delta_seconds = DeltaSeconds;
-
-  uint8_t simulation_state = (SimulationState::MapChange * MapChange);
-  simulation_state |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
-
-  header.simulation_state = static_cast<SimulationState>(simulation_state);
-
   write_data(header);
 
-  // Write every actor.
-  for (auto &&View : Registry)
+  // Write every gathered actor; on a delta frame, only the ones whose state
+  // actually changed.
+  for (const auto &info : Snapshot)
   {
-    check(View.IsValid());
-    constexpr float TO_METERS = 1e-2;
-    const auto Velocity = TO_METERS * View.GetActor()->GetVelocity();
-
-    ActorDynamicState info = {
-      View.GetActorId(),
-      View.GetActor()->GetActorTransform(),
-      carla::geom::Vector3D{Velocity.X, Velocity.Y, Velocity.Z},
-      FWorldObserver_GetAngularVelocity(*View.GetActor()),
-      FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds),
-      FWorldObserver_GetActorState(View, Registry),
-    };
-    write_data(info);
+    if (KeyFrame)
+    {
+      write_data(info);
+      PreviousActorState.emplace(info.id, info);
+    }
+    else
+    {
+      auto &Previous = PreviousActorState[info.id];
+      if (std::memcmp(&info, &Previous, sizeof(info)) != 0)
+      {
+        write_data(info);
+        Previous = info;
+      }
+    }
   }
 
   // Shrink buffer
@@ -237,20 +346,72 @@ static carla::Buffer FWorldObserver_Serialize(
   return std::move(buffer);
 }
 
+/// Broadcast a full keyframe every this many ticks; the frames in between
+/// only carry the actors whose state changed.
+static constexpr uint32_t FWorldObserver_KeyframePeriod = 30u;
+
 void FWorldObserver::BroadcastTick(
     const UCarlaEpisode &Episode,
     float DeltaSecond,
     bool MapChange,
     bool PendingLightUpdates)
 {
+  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
+  using SimulationState = Serializer::SimulationState;
+
   auto AsyncStream = Stream.MakeAsyncDataStream(*this, Episode.GetElapsedGameTime());
 
-  auto buffer = FWorldObserver_Serialize(
-      AsyncStream.PopBufferFromPool(),
-      Episode,
-      DeltaSecond,
-      MapChange,
-      PendingLightUpdates);
+  bool KeyFrame = (TicksSinceKeyframe % FWorldObserver_KeyframePeriod) == 0u;
+
+  // Delta frames cannot encode removals; promote to a keyframe whenever the
+  // actor set changed since the previous broadcast.
+  const uint64 RegistryVersion = Episode.GetActorRegistry().GetVersion();
+  if (RegistryVersion != LastRegistryVersion)
+  {
+    KeyFrame = true;
+    LastRegistryVersion = RegistryVersion;
+  }
 
-  AsyncStream.Send(*this, std::move(buffer));
+  TicksSinceKeyframe = KeyFrame ? 1u : TicksSinceKeyframe + 1u;
+
+  Serializer::Header header;
+  header.episode_id = Episode.GetId();
+  header.platform_timestamp = FPlatformTime::Seconds();
+  header.delta_seconds = DeltaSecond;
+
+  uint8_t simulation_state = (SimulationState::MapChange * MapChange);
+  simulation_state |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
+  simulation_state |= (SimulationState::DeltaFrame * !KeyFrame);
+
+  header.simulation_state = static_cast<SimulationState>(simulation_state);
+
+  // Gathering touches the actors and has to stay on the game thread; packing
+  // the buffer and handing it to the network do not.
+  auto Snapshot = FWorldObserver_GatherActorStates(Episode, DeltaSecond, KeyFrame);
+
+  // Normally long finished by now; waiting keeps the frames ordered on the
+  // stream and confines PreviousActorState to one task at a time.
+  if (SerializationFuture.IsValid())
+  {
+    SerializationFuture.Wait();
+  }
+
+  auto Buffer = AsyncStream.PopBufferFromPool();
+
+  SerializationFuture = Async(
+      EAsyncExecution::TaskGraph,
+      [this,
+       DataStream = std::move(AsyncStream),
+       Buffer = std::move(Buffer),
+       header,
+       KeyFrame,
+       Snapshot = MoveTemp(Snapshot)]() mutable
+      {
+        DataStream.Send(*this, FWorldObserver_Serialize(
+            std::move(Buffer),
+            header,
+            Snapshot,
+            KeyFrame,
+            PreviousActorState));
+      });
 }
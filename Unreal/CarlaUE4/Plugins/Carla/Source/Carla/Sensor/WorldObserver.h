@@ -8,6 +8,15 @@
 
 #include "Carla/Sensor/DataStream.h"
 
+#include "Async/Future.h"
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/rpc/ActorId.h>
+#include <carla/sensor/data/ActorDynamicState.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <unordered_map>
+
 class UCarlaEpisode;
 
 /// Serializes and sends all the actors in the current UCarlaEpisode.
@@ -18,6 +27,15 @@ public:
   /// Prevent this sensor to be spawned by users.
   using not_spawnable = void;
 
+  ~FWorldObserver()
+  {
+    // Finish any in-flight serialization task before the stream goes away.
+    if (SerializationFuture.IsValid())
+    {
+      SerializationFuture.Wait();
+    }
+  }
+
   /// Replace the Stream associated with this sensor.
   void SetStream(FDataMultiStream InStream)
   {
@@ -47,4 +65,18 @@ public:
 private:
 
   FDataMultiStream Stream;
+
+  /// Dynamic state of every actor as of the last broadcast, diffed against to
+  /// encode delta frames. Only touched by the serialization task.
+  std::unordered_map<carla::rpc::ActorId, carla::sensor::data::ActorDynamicState> PreviousActorState;
+
+  /// Ticks broadcast since the last keyframe.
+  uint32_t TicksSinceKeyframe = 0u;
+
+  /// Actor registry version as of the last broadcast; a change promotes the
+  /// next frame to a keyframe.
+  uint64 LastRegistryVersion = 0u;
+
+  /// Background task packing and sending the previous broadcast.
+  TFuture<void> SerializationFuture;
 };
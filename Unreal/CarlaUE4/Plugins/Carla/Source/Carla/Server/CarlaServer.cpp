@@ -8,6 +8,7 @@
 #include "Carla/Server/CarlaServer.h"
 
 #include "Carla/OpenDrive/OpenDrive.h"
+#include "Carla/Sensor/Sensor.h"
 #include "Carla/Util/DebugShapeDrawer.h"
 #include "Carla/Util/NavigationMesh.h"
 #include "Carla/Vehicle/CarlaWheeledVehicle.h"
@@ -16,18 +17,23 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/Functional.h>
+#include <carla/MsgPack.h>
 #include <carla/Version.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/ActorDefinition.h>
+#include <carla/rpc/ActorListDiff.h>
 #include <carla/rpc/ActorDescription.h>
+#include <carla/rpc/BulkTransfer.h>
 #include <carla/rpc/Command.h>
 #include <carla/rpc/CommandResponse.h>
 #include <carla/rpc/DebugShape.h>
 #include <carla/rpc/EpisodeInfo.h>
 #include <carla/rpc/EpisodeSettings.h>
+#include <carla/rpc/FrameStats.h>
 #include <carla/rpc/LightState.h>
 #include <carla/rpc/MapInfo.h>
 #include <carla/rpc/Response.h>
+#include <carla/rpc/SensorTiming.h>
 #include <carla/rpc/Server.h>
 #include <carla/rpc/String.h>
 #include <carla/rpc/Transform.h>
@@ -38,11 +44,17 @@
 #include <carla/rpc/VehicleLightState.h>
 #include <carla/rpc/VehicleLightStateList.h>
 #include <carla/rpc/WalkerBoneControl.h>
+#include <carla/rpc/WalkerBonePose.h>
 #include <carla/rpc/WalkerControl.h>
 #include <carla/rpc/WeatherParameters.h>
 #include <carla/streaming/Server.h>
+#include <carla/streaming/detail/Compression.h>
 #include <compiler/enable-ue4-macros.h>
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -72,6 +84,11 @@ public:
       StreamingServer(StreamingPort),
       BroadcastStream(StreamingServer.MakeStream())
   {
+    // Publish the world state also through a shared memory ring; clients on
+    // this same host attach to the ring instead of a TCP session, so their
+    // world-state latency stays flat regardless of actor count. Remote
+    // clients (and platforms without POSIX shared memory) keep the TCP path.
+    BroadcastStream.EnableSharedMemory();
     BindActions();
   }
 
@@ -88,6 +105,62 @@ public:
 
   size_t TickCuesReceived = 0u;
 
+  /// Batches scheduled through "apply_batch_at_frame", applied from the game
+  /// thread at the top of their target frame.
+  struct FScheduledBatch
+  {
+    uint64 Frame;
+    std::vector<carla::rpc::Command> Commands;
+  };
+
+  std::mutex ScheduledBatchesMutex;
+
+  std::vector<FScheduledBatch> ScheduledBatches;
+
+  /// Applies a batch through the command visitor defined in BindActions, so
+  /// scheduled batches can be run outside of the RPC bindings.
+  std::function<void(const std::vector<carla::rpc::Command> &)> ScheduledBatchApplier;
+
+  /// Chunk size of the bulk pull protocol; big enough to amortize the RPC
+  /// round trips, small enough that no single msgpack message stalls the
+  /// handler thread.
+  static constexpr uint32_t BulkChunkSize = 1u << 20;
+
+  std::mutex BulkPayloadsMutex;
+
+  /// Payloads waiting to be pulled with "pull_bulk_chunk", keyed by the id
+  /// handed out in the descriptor.
+  std::unordered_map<uint32_t, std::string> BulkPayloads;
+
+  uint32_t NextBulkId = 1u;
+
+  /// Compress @a Payload (kept uncompressed if deflate does not shrink it)
+  /// and park it for chunked pulling; returns the descriptor for the client.
+  carla::rpc::BulkTransfer StoreBulkPayload(std::string &&Payload)
+  {
+    namespace csd = carla::streaming::detail;
+    const auto View = boost::asio::buffer(Payload.data(), Payload.size());
+    auto Compressed = csd::Compression::Compress(&View, 1u);
+    if (!Compressed.empty())
+    {
+      Payload.assign(
+          reinterpret_cast<const char *>(Compressed.data()),
+          Compressed.size());
+    }
+    carla::rpc::BulkTransfer Descriptor;
+    Descriptor.size = Payload.size();
+    Descriptor.chunk_size = BulkChunkSize;
+    if (Payload.empty())
+    {
+      // Nothing to pull, nothing to park.
+      return Descriptor;
+    }
+    std::lock_guard<std::mutex> Lock(BulkPayloadsMutex);
+    Descriptor.id = NextBulkId++;
+    BulkPayloads.emplace(Descriptor.id, std::move(Payload));
+    return Descriptor;
+  }
+
 private:
 
   void BindActions();
@@ -119,17 +192,22 @@ class ServerBinder
 {
 public:
 
-  constexpr ServerBinder(const char *name, carla::rpc::Server &srv, bool sync)
+  constexpr ServerBinder(
+      const char *name,
+      carla::rpc::Server &srv,
+      bool sync,
+      carla::rpc::CallPriority priority = carla::rpc::CallPriority::Control)
     : _name(name),
       _server(srv),
-      _sync(sync) {}
+      _sync(sync),
+      _priority(priority) {}
 
   template <typename FuncT>
   auto operator<<(FuncT func)
   {
     if (_sync)
     {
-      _server.BindSync(_name, func);
+      _server.BindSync(_name, func, _priority);
     }
     else
     {
@@ -145,10 +223,16 @@ private:
   carla::rpc::Server &_server;
 
   bool _sync;
+
+  carla::rpc::CallPriority _priority;
 };
 
-#define BIND_SYNC(name)   auto name = ServerBinder(# name, Server, true)
-#define BIND_ASYNC(name)  auto name = ServerBinder(# name, Server, false)
+// Within each server tick's RPC window, sync handlers run in priority order:
+// control commands first, then queries, bulk data transfers last.
+#define BIND_SYNC(name)       auto name = ServerBinder(# name, Server, true)
+#define BIND_SYNC_QUERY(name) auto name = ServerBinder(# name, Server, true, carla::rpc::CallPriority::Query)
+#define BIND_SYNC_BULK(name)  auto name = ServerBinder(# name, Server, true, carla::rpc::CallPriority::Bulk)
+#define BIND_ASYNC(name)      auto name = ServerBinder(# name, Server, false)
 
 // =============================================================================
 // -- Bind Actions -------------------------------------------------------------
@@ -160,14 +244,14 @@ void FCarlaServer::FPimpl::BindActions()
   namespace cg = carla::geom;
 
   /// Looks for a Traffic Manager running on port
-  BIND_SYNC(is_traffic_manager_running) << [this] (uint16_t port) ->R<bool>
+  BIND_SYNC_QUERY(is_traffic_manager_running) << [this] (uint16_t port) ->R<bool>
   {
     return (TrafficManagerInfo.find(port) != TrafficManagerInfo.end());
   };
 
   /// Gets a pair filled with the <IP, port> of the Trafic Manager running on port.
   /// If there is no Traffic Manager running the pair will be ("", 0)
-  BIND_SYNC(get_traffic_manager_running) << [this] (uint16_t port) ->R<std::pair<std::string, uint16_t>>
+  BIND_SYNC_QUERY(get_traffic_manager_running) << [this] (uint16_t port) ->R<std::pair<std::string, uint16_t>>
   {
     auto it = TrafficManagerInfo.find(port);
     if(it != TrafficManagerInfo.end()) {
@@ -213,6 +297,18 @@ void FCarlaServer::FPimpl::BindActions()
     return GFrameCounter + 1u;
   };
 
+  BIND_SYNC(fast_forward) << [this](double duration, float relevance_radius) -> R<uint64_t>
+  {
+    REQUIRE_CARLA_EPISODE();
+    if (duration <= 0.0)
+    {
+      RESPOND_ERROR("fast_forward: duration must be positive");
+    }
+    // Radius comes in meters, the simulation works in centimeters.
+    Episode->RequestFastForward(duration, 1e2f * relevance_radius);
+    return GFrameCounter + 1u;
+  };
+
   // ~~ Load new episode ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   BIND_ASYNC(get_available_maps) << [this]() -> R<std::vector<std::string>>
@@ -237,6 +333,13 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(fast_reset_episode) << [this]() -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    Episode->FastReset();
+    return R<void>::Success();
+  };
+
   BIND_SYNC(copy_opendrive_to_file) << [this](const std::string &opendrive, cr::OpendriveGenerationParameters Params) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
@@ -249,24 +352,69 @@ void FCarlaServer::FPimpl::BindActions()
 
   // ~~ Episode settings and info ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
+  BIND_SYNC_QUERY(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
   {
     REQUIRE_CARLA_EPISODE();
     return cr::EpisodeInfo{Episode->GetId(), BroadcastStream.token()};
   };
 
-  BIND_SYNC(get_map_info) << [this]() -> R<cr::MapInfo>
+  BIND_SYNC_QUERY(get_frame_stats) << [this]() -> R<cr::FrameStats>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto GameInstance = UCarlaStatics::GetGameInstance(Episode->GetWorld());
+    if (GameInstance == nullptr)
+    {
+      RESPOND_ERROR("internal error: unable to find the game instance");
+    }
+    return GameInstance->GetCarlaEngine().GetFrameStats();
+  };
+
+  BIND_SYNC_QUERY(get_map_info) << [this]() -> R<cr::MapInfo>
   {
     REQUIRE_CARLA_EPISODE();
-    auto FileContents = UOpenDrive::LoadXODR(Episode->GetMapName());
     const auto &SpawnPoints = Episode->GetRecommendedSpawnPoints();
+    // The OpenDRIVE content travels separately through "get_map_data", it
+    // can be tens of MB on the bigger maps.
     return cr::MapInfo{
       cr::FromFString(Episode->GetMapName()),
-      cr::FromLongFString(FileContents),
+      "",
       MakeVectorFromTArray<cg::Transform>(SpawnPoints)};
   };
 
-  BIND_SYNC(get_navigation_mesh) << [this]() -> R<std::vector<uint8_t>>
+  BIND_SYNC_BULK(get_map_data) << [this]() -> R<cr::BulkTransfer>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto FileContents = UOpenDrive::LoadXODR(Episode->GetMapName());
+    return StoreBulkPayload(cr::FromLongFString(FileContents));
+  };
+
+  BIND_SYNC_BULK(pull_bulk_chunk) << [this](
+      uint32_t id,
+      uint32_t chunk) -> R<std::vector<uint8_t>>
+  {
+    std::lock_guard<std::mutex> Lock(BulkPayloadsMutex);
+    auto It = BulkPayloads.find(id);
+    if (It == BulkPayloads.end())
+    {
+      RESPOND_ERROR("unknown bulk transfer id");
+    }
+    const auto &Payload = It->second;
+    const uint64_t Offset = static_cast<uint64_t>(chunk) * BulkChunkSize;
+    if (Offset >= Payload.size())
+    {
+      RESPOND_ERROR("bulk chunk out of range");
+    }
+    const auto *Begin = reinterpret_cast<const uint8_t *>(Payload.data()) + Offset;
+    const auto Size = std::min<uint64_t>(BulkChunkSize, Payload.size() - Offset);
+    std::vector<uint8_t> Result(Begin, Begin + Size);
+    if (Offset + Size >= Payload.size())
+    {
+      BulkPayloads.erase(It);
+    }
+    return Result;
+  };
+
+  BIND_SYNC_BULK(get_navigation_mesh) << [this]() -> R<std::vector<uint8_t>>
   {
     REQUIRE_CARLA_EPISODE();
     auto FileContents = FNavigationMesh::Load(Episode->GetMapName());
@@ -276,7 +424,7 @@ void FCarlaServer::FPimpl::BindActions()
     return Result;
   };
 
-  BIND_SYNC(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
+  BIND_SYNC_QUERY(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
   {
     REQUIRE_CARLA_EPISODE();
     return cr::EpisodeSettings{Episode->GetSettings()};
@@ -290,13 +438,19 @@ void FCarlaServer::FPimpl::BindActions()
     return GFrameCounter;
   };
 
-  BIND_SYNC(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
+  BIND_SYNC_BULK(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
   {
     REQUIRE_CARLA_EPISODE();
     return MakeVectorFromTArray<cr::ActorDefinition>(Episode->GetActorDefinitions());
   };
 
-  BIND_SYNC(get_spectator) << [this]() -> R<cr::Actor>
+  BIND_SYNC_QUERY(get_blueprint_library_version) << [this]() -> R<uint64_t>
+  {
+    REQUIRE_CARLA_EPISODE();
+    return Episode->GetActorDefinitionsVersion();
+  };
+
+  BIND_SYNC_QUERY(get_spectator) << [this]() -> R<cr::Actor>
   {
     REQUIRE_CARLA_EPISODE();
     auto ActorView = Episode->FindActor(Episode->GetSpectatorPawn());
@@ -307,7 +461,7 @@ void FCarlaServer::FPimpl::BindActions()
     return Episode->SerializeActor(ActorView);
   };
 
-  BIND_SYNC(get_all_level_BBs) << [this](uint8 QueriedTag) -> R<std::vector<cg::BoundingBox>>
+  BIND_SYNC_BULK(get_all_level_BBs) << [this](uint8 QueriedTag) -> R<std::vector<cg::BoundingBox>>
   {
     REQUIRE_CARLA_EPISODE();
     TArray<FBoundingBox> Result;
@@ -322,7 +476,7 @@ void FCarlaServer::FPimpl::BindActions()
 
   // ~~ Weather ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
+  BIND_SYNC_QUERY(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
   {
     REQUIRE_CARLA_EPISODE();
     auto *Weather = Episode->GetWeather();
@@ -346,25 +500,105 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(prewarm_weather_presets) << [this](
+      const std::vector<cr::WeatherParameters> &presets) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto *Weather = Episode->GetWeather();
+    if (Weather == nullptr)
+    {
+      RESPOND_ERROR("internal error: unable to find weather");
+    }
+    TArray<FWeatherParameters> Presets;
+    Presets.Reserve(presets.size());
+    for (const auto &preset : presets)
+    {
+      Presets.Add(preset);
+    }
+    Weather->PrewarmPresets(MoveTemp(Presets));
+    return R<void>::Success();
+  };
+
+  BIND_SYNC(prefetch_route) << [this](
+      const std::vector<cr::Location> &route,
+      float lookahead) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    TArray<FVector> Route;
+    Route.Reserve(route.size());
+    for (const auto &location : route)
+    {
+      Route.Add(location);
+    }
+    // Lookahead comes in meters, the streaming views work in centimeters.
+    Episode->SetRoutePrefetch(MoveTemp(Route), 1e2f * lookahead);
+    return R<void>::Success();
+  };
+
   // ~~ Actor operations ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_actors_by_id) << [this](
+  BIND_ASYNC(get_actors_by_id) << [this](
       const std::vector<FActorView::IdType> &ids) -> R<std::vector<cr::Actor>>
   {
-    REQUIRE_CARLA_EPISODE();
+    // Answered from the registry snapshot entirely on the rpc thread, so
+    // the call never waits for the game thread.
+    auto *CurrentEpisode = Episode;
+    if (CurrentEpisode == nullptr) { RESPOND_ERROR("episode not ready"); }
+    auto Snapshot = CurrentEpisode->GetActorRegistry().GetSnapshot();
     std::vector<cr::Actor> Result;
     Result.reserve(ids.size());
     for (auto &&Id : ids)
     {
-      auto View = Episode->FindActor(Id);
-      if (View.IsValid())
+      auto it = Snapshot->Actors.find(Id);
+      if (it != Snapshot->Actors.end())
       {
-        Result.emplace_back(Episode->SerializeActor(View));
+        Result.emplace_back(it->second);
       }
     }
     return Result;
   };
 
+  BIND_ASYNC(get_actor_list_diff) << [this](
+      uint64_t known_version) -> R<cr::ActorListDiff>
+  {
+    // Answered from the registry snapshot entirely on the rpc thread, so
+    // the call never waits for the game thread.
+    auto *CurrentEpisode = Episode;
+    if (CurrentEpisode == nullptr) { RESPOND_ERROR("episode not ready"); }
+    auto Snapshot = CurrentEpisode->GetActorRegistry().GetSnapshot();
+    cr::ActorListDiff Diff;
+    Diff.version = Snapshot->Version;
+    TArray<FActorView::IdType> Added;
+    TArray<FActorView::IdType> Removed;
+    if (Snapshot->GetChangesSince(known_version, Added, Removed))
+    {
+      Diff.added.reserve(Added.Num());
+      for (auto Id : Added)
+      {
+        auto it = Snapshot->Actors.find(Id);
+        if (it != Snapshot->Actors.end())
+        {
+          Diff.added.emplace_back(it->second);
+        }
+      }
+      Diff.removed.reserve(Removed.Num());
+      for (auto Id : Removed)
+      {
+        Diff.removed.emplace_back(Id);
+      }
+    }
+    else
+    {
+      Diff.is_full_list = true;
+      Diff.added.reserve(Snapshot->Actors.size());
+      for (const auto &Pair : Snapshot->Actors)
+      {
+        Diff.added.emplace_back(Pair.second);
+      }
+    }
+    return Diff;
+  };
+
   BIND_SYNC(spawn_actor) << [this](
       cr::ActorDescription Description,
       const cr::Transform &Transform) -> R<cr::Actor>
@@ -739,7 +973,7 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
-  BIND_SYNC(get_physics_control) << [this](
+  BIND_SYNC_QUERY(get_physics_control) << [this](
       cr::ActorId ActorId) -> R<cr::VehiclePhysicsControl>
   {
     REQUIRE_CARLA_EPISODE();
@@ -757,7 +991,7 @@ void FCarlaServer::FPimpl::BindActions()
     return cr::VehiclePhysicsControl(Vehicle->GetVehiclePhysicsControl());
   };
 
-  BIND_SYNC(get_vehicle_light_state) << [this](
+  BIND_SYNC_QUERY(get_vehicle_light_state) << [this](
       cr::ActorId ActorId) -> R<cr::VehicleLightState>
   {
     REQUIRE_CARLA_EPISODE();
@@ -842,6 +1076,13 @@ void FCarlaServer::FPimpl::BindActions()
         CharacterMovement->DisableMovement();
       }
     }
+    // Wheeled vehicles additionally drop their PhysX vehicle from the
+    // scene's vehicle manager, so demoted traffic pays no per-substep
+    // wheel or suspension cost.
+    else if (auto Vehicle = Cast<ACarlaWheeledVehicle>(ActorView.GetActor()))
+    {
+      Vehicle->SetSimulatePhysics(bEnabled);
+    }
     // In the rest of actors, the physics is controlled with the UPrimitiveComponent, so we use
     // that for disable it.
     else
@@ -853,10 +1094,6 @@ void FCarlaServer::FPimpl::BindActions()
       }
       RootComponent->SetSimulatePhysics(bEnabled);
       RootComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-
-      auto Vehicle = Cast<ACarlaWheeledVehicle>(ActorView.GetActor());
-      if(Vehicle)
-        Vehicle->SetActorEnableCollision(true);
     }
 
     return R<void>::Success();
@@ -903,6 +1140,23 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC_QUERY(get_sensor_timing) << [this](
+      cr::ActorId ActorId) -> R<cr::SensorTiming>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto ActorView = Episode->FindActor(ActorId);
+    if (!ActorView.IsValid())
+    {
+      RESPOND_ERROR("unable to get sensor timing: actor not found");
+    }
+    auto Sensor = Cast<ASensor>(ActorView.GetActor());
+    if (Sensor == nullptr)
+    {
+      RESPOND_ERROR("unable to get sensor timing: actor is not a sensor");
+    }
+    return Sensor->GetTiming();
+  };
+
   // ~~ Apply control ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   BIND_SYNC(apply_control_to_vehicle) << [this](
@@ -972,6 +1226,92 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(get_walker_bone_names) << [this](
+      cr::ActorId ActorId) -> R<std::vector<std::string>>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto ActorView = Episode->FindActor(ActorId);
+    if (!ActorView.IsValid())
+    {
+      RESPOND_ERROR("unable to get bone names: actor not found");
+    }
+    auto Pawn = Cast<APawn>(ActorView.GetActor());
+    if (Pawn == nullptr)
+    {
+      RESPOND_ERROR("unable to get bone names: actor is not a walker");
+    }
+    TArray<USkeletalMeshComponent *> SkeletalMeshes;
+    Pawn->GetComponents<USkeletalMeshComponent>(SkeletalMeshes, false);
+    USkeletalMeshComponent *SkeletalMesh =
+        SkeletalMeshes.IsValidIndex(0) ? SkeletalMeshes[0] : nullptr;
+    if (SkeletalMesh == nullptr)
+    {
+      RESPOND_ERROR("unable to get bone names: walker has no skeletal mesh");
+    }
+    const int32 NumBones = SkeletalMesh->GetNumBones();
+    std::vector<std::string> Result;
+    Result.reserve(NumBones);
+    for (int32 i = 0; i < NumBones; ++i)
+    {
+      Result.emplace_back(cr::FromFString(SkeletalMesh->GetBoneName(i).ToString()));
+    }
+    return Result;
+  };
+
+  BIND_SYNC(apply_bone_pose_to_walker) << [this](
+      cr::ActorId ActorId,
+      const cr::WalkerBonePose &Pose) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    if (Pose.pose.size() != 6u * Pose.bones.size())
+    {
+      RESPOND_ERROR("unable to apply bone pose: expected six floats per bone");
+    }
+    auto ActorView = Episode->FindActor(ActorId);
+    if (!ActorView.IsValid())
+    {
+      RESPOND_ERROR("unable to apply bone pose: actor not found");
+    }
+    auto Pawn = Cast<APawn>(ActorView.GetActor());
+    if (Pawn == nullptr)
+    {
+      RESPOND_ERROR("unable to apply bone pose: actor is not a walker");
+    }
+    auto Controller = Cast<AWalkerController>(Pawn->GetController());
+    if (Controller == nullptr)
+    {
+      RESPOND_ERROR("unable to apply bone pose: walker has an incompatible controller");
+    }
+    TArray<USkeletalMeshComponent *> SkeletalMeshes;
+    Pawn->GetComponents<USkeletalMeshComponent>(SkeletalMeshes, false);
+    USkeletalMeshComponent *SkeletalMesh =
+        SkeletalMeshes.IsValidIndex(0) ? SkeletalMeshes[0] : nullptr;
+    if (SkeletalMesh == nullptr)
+    {
+      RESPOND_ERROR("unable to apply bone pose: walker has no skeletal mesh");
+    }
+    // Resolve the indices against the mesh the names came from, then reuse
+    // the bone control path so manual bone mode is handled in one place.
+    FWalkerBoneControl Control;
+    for (size_t i = 0u; i < Pose.bones.size(); ++i)
+    {
+      const int32 BoneIndex = static_cast<int32>(Pose.bones[i]);
+      if (BoneIndex >= SkeletalMesh->GetNumBones())
+      {
+        RESPOND_ERROR("unable to apply bone pose: bone index out of range");
+      }
+      const float *T = Pose.pose.data() + 6u * i;
+      const carla::geom::Transform Transform(
+          carla::geom::Location(T[0], T[1], T[2]),
+          carla::geom::Rotation(T[3], T[4], T[5]));
+      Control.BoneTransforms.Add(
+          SkeletalMesh->GetBoneName(BoneIndex).ToString(),
+          Transform);
+    }
+    Controller->ApplyWalkerControl(Control);
+    return R<void>::Success();
+  };
+
   BIND_SYNC(set_actor_autopilot) << [this](
       cr::ActorId ActorId,
       bool bEnabled) -> R<void>
@@ -1135,7 +1475,7 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
-  BIND_SYNC(get_vehicle_light_states) << [this]() -> R<cr::VehicleLightStateList>
+  BIND_SYNC_QUERY(get_vehicle_light_states) << [this]() -> R<cr::VehicleLightStateList>
   {
     REQUIRE_CARLA_EPISODE();
     cr::VehicleLightStateList List;
@@ -1156,7 +1496,7 @@ void FCarlaServer::FPimpl::BindActions()
     return List;
   };
 
-  BIND_SYNC(get_group_traffic_lights) << [this](
+  BIND_SYNC_QUERY(get_group_traffic_lights) << [this](
       const cr::ActorId ActorId) -> R<std::vector<cr::ActorId>>
   {
     REQUIRE_CARLA_EPISODE();
@@ -1197,35 +1537,35 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
-  BIND_SYNC(show_recorder_file_info) << [this](
+  BIND_SYNC_BULK(show_recorder_file_info) << [this](
       std::string name,
-      bool show_all) -> R<std::string>
+      bool show_all) -> R<cr::BulkTransfer>
   {
     REQUIRE_CARLA_EPISODE();
-    return R<std::string>(Episode->GetRecorder()->ShowFileInfo(
+    return StoreBulkPayload(Episode->GetRecorder()->ShowFileInfo(
         name,
         show_all));
   };
 
-  BIND_SYNC(show_recorder_collisions) << [this](
+  BIND_SYNC_BULK(show_recorder_collisions) << [this](
       std::string name,
       char type1,
-      char type2) -> R<std::string>
+      char type2) -> R<cr::BulkTransfer>
   {
     REQUIRE_CARLA_EPISODE();
-    return R<std::string>(Episode->GetRecorder()->ShowFileCollisions(
+    return StoreBulkPayload(Episode->GetRecorder()->ShowFileCollisions(
         name,
         type1,
         type2));
   };
 
-  BIND_SYNC(show_recorder_actors_blocked) << [this](
+  BIND_SYNC_BULK(show_recorder_actors_blocked) << [this](
       std::string name,
       double min_time,
-      double min_distance) -> R<std::string>
+      double min_distance) -> R<cr::BulkTransfer>
   {
     REQUIRE_CARLA_EPISODE();
-    return R<std::string>(Episode->GetRecorder()->ShowFileActorsBlocked(
+    return StoreBulkPayload(Episode->GetRecorder()->ShowFileActorsBlocked(
         name,
         min_time,
         min_distance));
@@ -1245,6 +1585,16 @@ void FCarlaServer::FPimpl::BindActions()
         follow_id));
   };
 
+  BIND_SYNC(replay_batch) << [this](
+      std::vector<std::string> names,
+      double time_factor) -> R<std::string>
+  {
+    REQUIRE_CARLA_EPISODE();
+    return R<std::string>(Episode->GetRecorder()->ReplayBatch(
+        std::move(names),
+        time_factor));
+  };
+
   BIND_SYNC(set_replayer_time_factor) << [this](double time_factor) -> R<void>
   {
     REQUIRE_CARLA_EPISODE();
@@ -1278,6 +1628,19 @@ void FCarlaServer::FPimpl::BindActions()
     return R<void>::Success();
   };
 
+  BIND_SYNC(draw_debug_shapes) << [this](const std::vector<cr::DebugShape> &shapes) -> R<void>
+  {
+    REQUIRE_CARLA_EPISODE();
+    auto *World = Episode->GetWorld();
+    check(World != nullptr);
+    FDebugShapeDrawer Drawer(*World);
+    for (const auto &shape : shapes)
+    {
+      Drawer.Draw(shape);
+    }
+    return R<void>::Success();
+  };
+
   // ~~ Apply commands in batch ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   using C = cr::Command;
@@ -1350,9 +1713,74 @@ void FCarlaServer::FPimpl::BindActions()
     return result;
   };
 
+  BIND_SYNC(apply_batch_raw) << [=](
+      const std::vector<uint8_t> &buffer,
+      bool do_tick_cue)
+  {
+    // Same as apply_batch, but the client ships the commands pre-encoded (see
+    // carla::rpc::CommandBuffer) so reused batches skip re-serialization.
+    auto commands = carla::MsgPack::UnPack<std::vector<cr::Command>>(
+        buffer.data(),
+        buffer.size());
+    std::vector<CR> result;
+    result.reserve(commands.size());
+    for (const auto &command : commands)
+    {
+      result.emplace_back(boost::apply_visitor(command_visitor, command.command));
+    }
+    if (do_tick_cue)
+    {
+      tick_cue();
+    }
+    return result;
+  };
+
+  ScheduledBatchApplier = [=](const std::vector<cr::Command> &commands)
+  {
+    for (const auto &command : commands)
+    {
+      boost::apply_visitor(command_visitor, command.command);
+    }
+  };
+
+  BIND_SYNC(apply_batch_at_frame) << [=](
+      const std::vector<cr::Command> &commands,
+      uint64_t target_frame) -> R<uint64_t>
+  {
+    REQUIRE_CARLA_EPISODE();
+    if (target_frame <= GFrameCounter)
+    {
+      // Too late to queue: apply right away and ack the actual frame, so the
+      // client can tell the schedule was missed.
+      for (const auto &command : commands)
+      {
+        boost::apply_visitor(command_visitor, command.command);
+      }
+      return static_cast<uint64_t>(GFrameCounter);
+    }
+    std::lock_guard<std::mutex> Lock(ScheduledBatchesMutex);
+    ScheduledBatches.emplace_back(FScheduledBatch{target_frame, commands});
+    return target_frame;
+  };
+
+  BIND_SYNC(spawn_actors) << [=](
+      const std::vector<C::SpawnActor> &commands)
+  {
+    // Spawning a whole fleet through a single sync call executes every spawn
+    // (and its do_after sub-commands) within one game-thread slice, and
+    // answers with all the ids in a single response.
+    std::vector<CR> result;
+    result.reserve(commands.size());
+    for (const cr::Command command : commands)
+    {
+      result.emplace_back(boost::apply_visitor(command_visitor, command.command));
+    }
+    return result;
+  };
+
   // ~~ Light Subsystem ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
+  BIND_SYNC_QUERY(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
   {
     REQUIRE_CARLA_EPISODE();
     std::vector<cr::LightState> result;
@@ -1422,6 +1850,8 @@ void FCarlaServer::NotifyEndEpisode()
 {
   check(Pimpl != nullptr);
   Pimpl->Episode = nullptr;
+  std::lock_guard<std::mutex> Lock(Pimpl->ScheduledBatchesMutex);
+  Pimpl->ScheduledBatches.clear();
 }
 
 void FCarlaServer::AsyncRun(uint32 NumberOfWorkerThreads)
@@ -1439,6 +1869,35 @@ void FCarlaServer::RunSome(uint32 Milliseconds)
   Pimpl->Server.SyncRunFor(carla::time_duration::milliseconds(Milliseconds));
 }
 
+void FCarlaServer::RunScheduledBatches(uint64 Frame)
+{
+  check(Pimpl != nullptr);
+  std::vector<FPimpl::FScheduledBatch> Due;
+  {
+    std::lock_guard<std::mutex> Lock(Pimpl->ScheduledBatchesMutex);
+    auto &Batches = Pimpl->ScheduledBatches;
+    for (auto It = Batches.begin(); It != Batches.end();)
+    {
+      if (It->Frame <= Frame)
+      {
+        Due.emplace_back(std::move(*It));
+        It = Batches.erase(It);
+      }
+      else
+      {
+        ++It;
+      }
+    }
+  }
+  for (const auto &Batch : Due)
+  {
+    if (Pimpl->ScheduledBatchApplier)
+    {
+      Pimpl->ScheduledBatchApplier(Batch.Commands);
+    }
+  }
+}
+
 bool FCarlaServer::TickCueReceived()
 {
   if (Pimpl->TickCuesReceived > 0u)
@@ -31,6 +31,10 @@ public:
 
   void RunSome(uint32 Milliseconds);
 
+  /// Apply, on the game thread, any command batch scheduled through
+  /// "apply_batch_at_frame" for @a Frame or earlier.
+  void RunScheduledBatches(uint64 Frame);
+
   bool TickCueReceived();
 
   void Stop();
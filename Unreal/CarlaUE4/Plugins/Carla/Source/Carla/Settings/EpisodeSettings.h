@@ -20,4 +20,18 @@ struct CARLA_API FEpisodeSettings
   bool bNoRenderingMode = false;
 
   TOptional<double> FixedDeltaSeconds;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite)
+  bool bSubstepping = true;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite)
+  double MaxSubstepDeltaTime = 0.01;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite)
+  int MaxSubsteps = 10;
+
+  /// Per-frame budget for the aggregate sensor cost in milliseconds;
+  /// zero disables sensor throttling.
+  UPROPERTY(EditAnywhere, BlueprintReadWrite)
+  double SensorFrameBudgetMs = 0.0;
 };
@@ -112,6 +112,19 @@ public:
     return std::normal_distribution<float>(Mean, StandardDeviation)(Engine);
   }
 
+  /// Fill @a Out with @a Count normally distributed samples in one pass.
+  /// One distribution object serves the whole batch, so paired samples are
+  /// not thrown away as they are when drawing one value at a time.
+  void FillNormalDistribution(float Mean, float StandardDeviation, TArray<float> &Out, int32 Count)
+  {
+    std::normal_distribution<float> Distribution(Mean, StandardDeviation);
+    Out.SetNumUninitialized(Count, false);
+    for (int32 i = 0; i < Count; ++i)
+    {
+      Out[i] = Distribution(Engine);
+    }
+  }
+
   /// @}
   // ===========================================================================
   /// @name Sampling distributions
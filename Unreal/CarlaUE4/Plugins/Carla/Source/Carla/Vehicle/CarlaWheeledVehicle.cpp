@@ -199,6 +199,18 @@ void ACarlaWheeledVehicle::FlushVehicleControl()
   }
   InputControl.Control.Gear = MovementComponent->GetCurrentGear();
   InputControl.Control.bReverse = InputControl.Control.Gear < 0;
+  const bool bControlChanged =
+      LastAppliedControl.Throttle != InputControl.Control.Throttle ||
+      LastAppliedControl.Steer != InputControl.Control.Steer ||
+      LastAppliedControl.Brake != InputControl.Control.Brake ||
+      LastAppliedControl.bHandBrake != InputControl.Control.bHandBrake ||
+      LastAppliedControl.bReverse != InputControl.Control.bReverse ||
+      LastAppliedControl.bManualGearShift != InputControl.Control.bManualGearShift ||
+      LastAppliedControl.Gear != InputControl.Control.Gear;
+  if (bControlChanged)
+  {
+    BumpControlStamp();
+  }
   LastAppliedControl = InputControl.Control;
   InputControl.Priority = EVehicleInputPriority::INVALID;
 }
@@ -445,6 +457,31 @@ void ACarlaWheeledVehicle::DeactivateVelocityControl()
   VelocityControl->Deactivate();
 }
 
+void ACarlaWheeledVehicle::SetSimulatePhysics(bool enabled)
+{
+  if (bPhysicsEnabled == enabled)
+  {
+    return;
+  }
+
+  UWheeledVehicleMovementComponent4W *Vehicle4W = Cast<UWheeledVehicleMovementComponent4W>(
+      GetVehicleMovement());
+  check(Vehicle4W != nullptr);
+
+  SetActorEnableCollision(true);
+  auto RootPrimitive = Cast<UPrimitiveComponent>(GetRootComponent());
+  check(RootPrimitive != nullptr);
+  RootPrimitive->SetSimulatePhysics(enabled);
+  RootPrimitive->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+  // Recreating the physics state registers or removes the PxVehicle in the
+  // scene's vehicle manager, which is where the per-substep wheel and
+  // suspension cost lives.
+  Vehicle4W->RecreatePhysicsState();
+
+  bPhysicsEnabled = enabled;
+}
+
 void ACarlaWheeledVehicle::SetVehicleLightState(const FVehicleLightState &LightState)
 {
   InputControl.LightState = LightState;
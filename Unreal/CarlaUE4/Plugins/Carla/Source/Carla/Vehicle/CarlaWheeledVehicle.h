@@ -91,6 +91,19 @@ public:
   UFUNCTION(Category = "CARLA Wheeled Vehicle", BlueprintCallable)
   float GetMaximumSteerAngle() const;
 
+  /// Counter bumped whenever the applied control or the AI controller state
+  /// of this vehicle changes; an unchanged stamp lets the world observer
+  /// skip the vehicle on delta frames.
+  uint32 GetControlStamp() const
+  {
+    return ControlStamp;
+  }
+
+  void BumpControlStamp()
+  {
+    ++ControlStamp;
+  }
+
   /// @}
   // ===========================================================================
   /// @name AI debug state
@@ -143,6 +156,15 @@ public:
   UFUNCTION(Category = "CARLA Wheeled Vehicle", BlueprintCallable)
   void DeactivateVelocityControl();
 
+  /// Enable or disable the full wheeled-vehicle physics simulation. Beyond
+  /// the root body, this recreates the movement component's physics state,
+  /// so a demoted vehicle also drops its PhysX vehicle from the scene's
+  /// vehicle manager and pays no wheel raycasts or suspension updates; the
+  /// traffic manager then drives it kinematically through teleports until
+  /// it is promoted back.
+  UFUNCTION(Category = "CARLA Wheeled Vehicle", BlueprintCallable)
+  void SetSimulatePhysics(bool enabled);
+
   /// @todo This function should be private to AWheeledVehicleAIController.
   void FlushVehicleControl();
 
@@ -227,4 +249,10 @@ private:
   InputControl;
 
   FVehicleControl LastAppliedControl;
+
+  uint32 ControlStamp = 0u;
+
+  /// Tracks SetSimulatePhysics so redundant requests skip the physics
+  /// state recreation.
+  bool bPhysicsEnabled = true;
 };
@@ -172,6 +172,33 @@ void AWheeledVehicleAIController::ConfigureAutopilot(const bool Enable, const bo
 // -- Traffic ------------------------------------------------------------------
 // =============================================================================
 
+void AWheeledVehicleAIController::SetSpeedLimit(const float InSpeedLimit)
+{
+  if ((Vehicle != nullptr) && (SpeedLimit != InSpeedLimit))
+  {
+    Vehicle->BumpControlStamp();
+  }
+  SpeedLimit = InSpeedLimit;
+}
+
+void AWheeledVehicleAIController::SetTrafficLightState(const ETrafficLightState InTrafficLightState)
+{
+  if ((Vehicle != nullptr) && (TrafficLightState != InTrafficLightState))
+  {
+    Vehicle->BumpControlStamp();
+  }
+  TrafficLightState = InTrafficLightState;
+}
+
+void AWheeledVehicleAIController::SetTrafficLight(ATrafficLightBase *InTrafficLight)
+{
+  if ((Vehicle != nullptr) && (TrafficLight != InTrafficLight))
+  {
+    Vehicle->BumpControlStamp();
+  }
+  TrafficLight = InTrafficLight;
+}
+
 void AWheeledVehicleAIController::SetFixedRoute(
     const TArray<FVector> &Locations,
     const bool bOverwriteCurrent)
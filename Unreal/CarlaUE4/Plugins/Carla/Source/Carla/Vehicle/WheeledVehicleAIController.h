@@ -171,10 +171,7 @@ public:
 
   /// Set vehicle's speed limit in km/h.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
-  void SetSpeedLimit(float InSpeedLimit)
-  {
-    SpeedLimit = InSpeedLimit;
-  }
+  void SetSpeedLimit(float InSpeedLimit);
 
   /// Get traffic light state currently affecting this vehicle.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
@@ -185,10 +182,7 @@ public:
 
   /// Set traffic light state currently affecting this vehicle.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
-  void SetTrafficLightState(ETrafficLightState InTrafficLightState)
-  {
-    TrafficLightState = InTrafficLightState;
-  }
+  void SetTrafficLightState(ETrafficLightState InTrafficLightState);
 
   /// Get traffic light currently affecting this vehicle.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
@@ -199,10 +193,7 @@ public:
 
   /// Set traffic light currently affecting this vehicle.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
-  void SetTrafficLight(ATrafficLightBase *InTrafficLight)
-  {
-    TrafficLight = InTrafficLight;
-  }
+  void SetTrafficLight(ATrafficLightBase *InTrafficLight);
 
   /// Set a fixed route to follow if autopilot is enabled.
   UFUNCTION(Category = "Wheeled Vehicle Controller", BlueprintCallable)
@@ -61,6 +61,7 @@ UPoseableMeshComponent *AddNewBoneComponent(AActor *InActor, FVector inLocation,
 void AWalkerController::ApplyWalkerControl(const FWalkerControl &InControl)
 {
   Control = InControl;
+  ++ControlStamp;
   if (bManualBones)
   {
     SetManualBones(false);
@@ -70,6 +71,7 @@ void AWalkerController::ApplyWalkerControl(const FWalkerControl &InControl)
 void AWalkerController::ApplyWalkerControl(const FWalkerBoneControl &InBoneControl)
 {
   Control = InBoneControl;
+  ++ControlStamp;
   if (!bManualBones)
   {
     SetManualBones(true);
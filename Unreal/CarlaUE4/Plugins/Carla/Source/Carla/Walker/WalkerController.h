@@ -76,9 +76,19 @@ public:
   UFUNCTION(BlueprintCallable)
   void SetManualBones(const bool bIsEnabled);
 
+  /// Counter bumped whenever a new control is applied to this walker; an
+  /// unchanged stamp lets the world observer skip the walker on delta
+  /// frames.
+  uint32 GetControlStamp() const
+  {
+    return ControlStamp;
+  }
+
 private:
 
   boost::variant<FWalkerControl, FWalkerBoneControl> Control;
 
   bool bManualBones;
+
+  uint32 ControlStamp = 0u;
 };
@@ -10,7 +10,9 @@
 AWeather::AWeather(const FObjectInitializer& ObjectInitializer)
   : Super(ObjectInitializer)
 {
-  PrimaryActorTick.bCanEverTick = false;
+  // Only ticks while a deferred refresh or a prewarm queue is pending.
+  PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
   RootComponent = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("RootComponent"));
 }
 
@@ -32,8 +34,44 @@ void AWeather::ApplyWeather(const FWeatherParameters &InWeather)
   UE_LOG(LogCarla, Log, TEXT("  - Wetness = %.2f"), Weather.Wetness);
 #endif // CARLA_WEATHER_EXTRA_LOG
 
-  // Call the blueprint that actually changes the weather.
-  RefreshWeather(Weather);
+  // Collapse every change requested during this frame into one refresh at
+  // the next frame boundary; the blueprint updates materials and lighting,
+  // which is the expensive part.
+  bRefreshPending = true;
+  SetActorTickEnabled(true);
+}
+
+void AWeather::PrewarmPresets(TArray<FWeatherParameters> Presets)
+{
+  PrewarmQueue = MoveTemp(Presets);
+  if (PrewarmQueue.Num() > 0)
+  {
+    SetActorTickEnabled(true);
+  }
+}
+
+void AWeather::Tick(float DeltaSeconds)
+{
+  Super::Tick(DeltaSeconds);
+
+  if (PrewarmQueue.Num() > 0)
+  {
+    // One preset per frame keeps the compilation hitches off the frames
+    // that matter; restore the active weather once the queue drains.
+    RefreshWeather(PrewarmQueue[0]);
+    PrewarmQueue.RemoveAt(0);
+    bRefreshPending = true;
+    return;
+  }
+
+  if (bRefreshPending)
+  {
+    bRefreshPending = false;
+    // Call the blueprint that actually changes the weather.
+    RefreshWeather(Weather);
+  }
+
+  SetActorTickEnabled(false);
 }
 
 void AWeather::NotifyWeather()
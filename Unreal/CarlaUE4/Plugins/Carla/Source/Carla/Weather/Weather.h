@@ -21,10 +21,18 @@ public:
 
   AWeather(const FObjectInitializer& ObjectInitializer);
 
-  /// Update the weather parameters and notifies it to the blueprint's event
+  /// Update the weather parameters and notifies it to the blueprint's event.
+  /// The refresh is deferred to the next frame boundary, so several changes
+  /// requested during one frame collapse into a single material and
+  /// lighting update.
   UFUNCTION(BlueprintCallable)
   void ApplyWeather(const FWeatherParameters &WeatherParameters);
 
+  /// Queue @a Presets to be refreshed once, one per frame, so their shader
+  /// and texture variants are warmed up before an episode cycles through
+  /// them; the active weather is restored once the queue drains.
+  void PrewarmPresets(TArray<FWeatherParameters> Presets);
+
   /// Notifing the weather to the blueprint's event
   void NotifyWeather();
 
@@ -44,8 +52,16 @@ protected:
   UFUNCTION(BlueprintImplementableEvent)
   void RefreshWeather(const FWeatherParameters &WeatherParameters);
 
+  virtual void Tick(float DeltaSeconds) override;
+
 private:
 
   UPROPERTY(VisibleAnywhere)
   FWeatherParameters Weather;
+
+  /// Whether a refresh is queued for the next frame boundary.
+  bool bRefreshPending = false;
+
+  /// Presets left to warm up, one per frame.
+  TArray<FWeatherParameters> PrewarmQueue;
 };